@@ -209,6 +209,7 @@ LOCAL_SRC_FILES :=  ../../../../../../lib/ljpeg/jcapimin.c \
 					../../../../../../source/2d/controllers/BuoyancyController.cc \
 					../../../../../../source/2d/controllers/core/GroupedSceneController.cc \
 					../../../../../../source/2d/controllers/core/PickingSceneController.cc \
+					../../../../../../source/2d/controllers/core/ControllerBatch.cc \
 					../../../../../../source/2d/controllers/PointForceController.cc \
 					../../../../../../source/2d/core/BatchRender.cc \
 					../../../../../../source/2d/core/CoreMath.cc \
@@ -222,6 +223,8 @@ LOCAL_SRC_FILES :=  ../../../../../../lib/ljpeg/jcapimin.c \
 					../../../../../../source/2d/core/SpriteBatchQuery.cc \
 					../../../../../../source/2d/core/Utility.cc \
 					../../../../../../source/2d/core/Vector2.cc \
+					../../../../../../source/2d/core/SpriteTileMap.cc \
+					../../../../../../source/2d/core/ImageFrameAnimator.cc \
 					../../../../../../source/2d/experimental/composites/WaveComposite.cc \
 					../../../../../../source/2d/gui/guiImageButtonCtrl.cc \
 					../../../../../../source/2d/gui/guiSceneObjectCtrl.cc \
@@ -238,12 +241,14 @@ LOCAL_SRC_FILES :=  ../../../../../../lib/ljpeg/jcapimin.c \
 					../../../../../../source/2d/sceneobject/Sprite.cc \
 					../../../../../../source/2d/sceneobject/TextSprite.cc \
 					../../../../../../source/2d/sceneobject/Trigger.cc \
+					../../../../../../source/2d/sceneobject/FluidObject.cc \
 					../../../../../../source/2d/scene/ContactFilter.cc \
 					../../../../../../source/2d/scene/DebugDraw.cc \
 					../../../../../../source/2d/scene/Scene.cc \
 					../../../../../../source/2d/scene/SceneRenderFactories.cpp \
 					../../../../../../source/2d/scene/SceneRenderQueue.cpp \
 					../../../../../../source/2d/scene/WorldQuery.cc \
+					../../../../../../source/2d/scene/SceneNavigation.cc \
 					../../../../../../source/algorithm/crc.cc \
 					../../../../../../source/algorithm/hashFunction.cc \
 					../../../../../../source/assets/assetBase.cc \
@@ -351,6 +356,7 @@ LOCAL_SRC_FILES :=  ../../../../../../lib/ljpeg/jcapimin.c \
 					../../../../../../source/graphics/TextureDictionary.cc \
 					../../../../../../source/graphics/TextureHandle.cc \
 					../../../../../../source/graphics/TextureManager.cc \
+					../../../../../../source/graphics/TextureAtlas.cc \
 					../../../../../../source/gui/containers/guiGridCtrl.cc \
 					../../../../../../source/gui/guiArrayCtrl.cc \
 					../../../../../../source/gui/guiBackgroundCtrl.cc \
@@ -608,6 +614,9 @@ LOCAL_SRC_FILES :=  ../../../../../../lib/ljpeg/jcapimin.c \
 #					../../../../../../source/testing/tests/platformFileIoTests.cc \
 #					../../../../../../source/testing/tests/platformMemoryTests.cc \
 #					../../../../../../source/testing/tests/platformStringTests.cc \
+#					../../../../../../source/testing/tests/sceneNavigationTests.cc \
+#					../../../../../../source/testing/tests/stringUnitTests.cc \
+#					../../../../../../source/testing/tests/perlinNoiseTests.cc \
 #					../../../../../../source/testing/unitTesting.cc
 
 ifeq ($(APP_OPTIM),debug)
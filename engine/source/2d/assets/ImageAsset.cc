@@ -168,6 +168,7 @@ const char* ImageAsset::getFilterModeDescription( ImageAsset::TextureFilterMode
 
 ImageAsset::ImageAsset() :  mImageFile(StringTable->EmptyString),
                             mForce16Bit(false),
+                            mAtlas(false),
                             mLocalFilterMode(FILTER_INVALID),
                             mExplicitMode(false),
                             mCellRowOrder(true),
@@ -182,7 +183,10 @@ ImageAsset::ImageAsset() :  mImageFile(StringTable->EmptyString),
 
                             mBlendColor(1.0f, 1.0f, 1.0f),
 
-                            mImageTextureHandle(NULL)
+                            mImageTextureHandle(NULL),
+                            mImageRevision(0),
+                            mpAtlasEntry(NULL),
+                            mAtlasRelocating(false)
 {
     // Set Vector Associations.
     VECTOR_SET_ASSOCIATION( mFrames );
@@ -194,6 +198,8 @@ ImageAsset::ImageAsset() :  mImageFile(StringTable->EmptyString),
 
 ImageAsset::~ImageAsset()
 {
+    // Release any atlas entry.
+    releaseAtlasTexture();
 }
 
 //------------------------------------------------------------------------------
@@ -207,6 +213,7 @@ void ImageAsset::initPersistFields()
     addGroup("Image Fields");
     addProtectedField("ImageFile", TypeAssetLooseFilePath, Offset(mImageFile, ImageAsset), &setImageFile, &getImageFile, &defaultProtectedWriteFn, "");
     addProtectedField("Force16bit", TypeBool, Offset(mForce16Bit, ImageAsset), &setForce16Bit, &defaultProtectedGetFn, &writeForce16Bit, "Forces the image into 16 bit mode.");
+    addProtectedField("Atlas", TypeBool, Offset(mAtlas, ImageAsset), &setAtlas, &defaultProtectedGetFn, &writeAtlas, "Packs the image into a shared texture atlas page.  Images no larger than $pref::T2D::imageAssetAtlasThreshold are packed regardless.");
     addProtectedField("FilterMode", TypeEnum, Offset(mLocalFilterMode, ImageAsset), &setFilterMode, &defaultProtectedGetFn, &writeFilterMode, 1, &textureFilterTable);   
     addProtectedField("ExplicitMode", TypeBool, Offset(mExplicitMode, ImageAsset), &setExplicitMode, &defaultProtectedGetFn, &writeExplicitMode, "");
     addProtectedField("CellRowOrder", TypeBool, Offset(mCellRowOrder, ImageAsset), &setCellRowOrder, &defaultProtectedGetFn, &writeCellRowOrder, "If true, cell number are applied left-to-right, top-to-bottom.");
@@ -284,6 +291,7 @@ void ImageAsset::copyTo(SimObject* object)
     // Copy state.
     pAsset->setImageFile( getImageFile() );
     pAsset->setForce16Bit( getForce16Bit() );
+    pAsset->setAtlas( getAtlas() );
     pAsset->setFilterMode( getFilterMode() );
     pAsset->setExplicitMode( getExplicitMode() );
     pAsset->setCellRowOrder( getCellRowOrder() );
@@ -336,6 +344,21 @@ void ImageAsset::setForce16Bit( const bool force16Bit )
 
 //------------------------------------------------------------------------------
 
+void ImageAsset::setAtlas( const bool atlas )
+{
+    // Ignore no change,
+    if ( atlas == mAtlas )
+        return;
+
+    // Update.
+    mAtlas = atlas;
+
+    // Refresh the asset.
+    refreshAsset();
+}
+
+//------------------------------------------------------------------------------
+
 void ImageAsset::setFilterMode( const ImageAsset::TextureFilterMode filterMode )
 {
     // Ignore no change,
@@ -1040,6 +1063,38 @@ void ImageAsset::setTextureFilter( const TextureFilterMode filterMode )
     if ( mImageTextureHandle.IsNull() )
         return;
 
+    // Set the texture objects filter mode.
+    mImageTextureHandle.setFilter( getGLFilterMode( filterMode ) );
+}
+
+//------------------------------------------------------------------------------
+
+ImageAsset::TextureFilterMode ImageAsset::getTextureFilterMode( void ) const
+{
+    // Use the local filter mode if specified.
+    if ( mLocalFilterMode != FILTER_INVALID )
+        return mLocalFilterMode;
+
+    TextureFilterMode filterMode = FILTER_NEAREST;
+
+    // No, so fetch the global filter.
+    const char* pGlobalFilter = Con::getVariable( "$pref::T2D::imageAssetGlobalFilterMode" );
+
+    // Fetch the global filter mode.
+    if ( pGlobalFilter != NULL && dStrlen(pGlobalFilter) > 0 )
+        filterMode = getFilterModeEnum( pGlobalFilter );
+
+    // If global filter mode is invalid then use local filter mode.
+    if ( filterMode == FILTER_INVALID )
+        filterMode = FILTER_NEAREST;
+
+    return filterMode;
+}
+
+//------------------------------------------------------------------------------
+
+GLint ImageAsset::getGLFilterMode( const TextureFilterMode filterMode )
+{
     // Select Hardware Filter Mode.
     GLint glFilterMode;
 
@@ -1065,8 +1120,97 @@ void ImageAsset::setTextureFilter( const TextureFilterMode filterMode )
             glFilterMode = GL_LINEAR;
     };
 
-    // Set the texture objects filter mode.
-    mImageTextureHandle.setFilter( glFilterMode );
+    return glFilterMode;
+}
+
+//------------------------------------------------------------------------------
+
+bool ImageAsset::acquireAtlasTexture( const TextureFilterMode filterMode )
+{
+    // Keep the atlas entry if it has only been moved within its page.
+    if ( mpAtlasEntry != NULL && mAtlasRelocating )
+        return true;
+
+    // Release any atlas entry.
+    releaseAtlasTexture();
+
+    // Finish if the image cannot be packed.
+    if ( mImageLayers.size() > 0 || mForce16Bit )
+        return false;
+
+    // Fetch the largest image that can be packed.
+    const S32 maximumEntrySize = mAtlas ? TextureAtlas::getMaximumEntrySize() : Con::getIntVariable( "$pref::T2D::imageAssetAtlasThreshold", 0 );
+
+    // Finish if packing is not wanted.
+    if ( maximumEntrySize <= 0 )
+        return false;
+
+    // Release the current texture so that it can be packed.
+    mImageTextureHandle.clear();
+
+    // Acquire the texture from the atlas.
+    TextureHandle textureHandle;
+    if ( !TextureAtlas::acquire( mImageFile, (GLuint)getGLFilterMode( filterMode ), maximumEntrySize, textureHandle, mpAtlasEntry, &onAtlasRelocated, this ) )
+        return false;
+
+    mImageTextureHandle = textureHandle;
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+
+void ImageAsset::releaseAtlasTexture( void )
+{
+    // Finish if not packed.
+    if ( mpAtlasEntry == NULL )
+        return;
+
+    // Release the page texture and the entry.
+    mImageTextureHandle.clear();
+    TextureAtlas::release( mpAtlasEntry );
+    mpAtlasEntry = NULL;
+}
+
+//------------------------------------------------------------------------------
+
+void ImageAsset::offsetAtlasFrames( void )
+{
+    // Fetch the texture object.
+    TextureObject* pTextureObject = ((TextureObject*)mImageTextureHandle);
+
+    // Calculate the texel offset of the packed image.
+    const Point2I& atlasOffset = mpAtlasEntry->getOffset();
+    const Vector2 texelOffset( (F32)atlasOffset.x / (F32)pTextureObject->getTextureWidth(), (F32)atlasOffset.y / (F32)pTextureObject->getTextureHeight() );
+
+    // Calculate the mapping of texels that address the image texture as if it were unpacked.
+    const Point2I& atlasSize = mpAtlasEntry->getSize();
+    mAtlasTexelOffset = texelOffset;
+    mAtlasTexelScale.Set( (F32)getNextPow2( atlasSize.x ) / (F32)pTextureObject->getTextureWidth(), (F32)getNextPow2( atlasSize.y ) / (F32)pTextureObject->getTextureHeight() );
+
+    // Offset the frame texels.
+    for( typeFrameAreaVector::iterator frameItr = mFrames.begin(); frameItr != mFrames.end(); ++frameItr )
+    {
+        frameItr->mTexelArea.mTexelLower += texelOffset;
+        frameItr->mTexelArea.mTexelUpper += texelOffset;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void ImageAsset::onAtlasRelocated( void* pUserData )
+{
+    ImageAsset* pImageAsset = static_cast<ImageAsset*>( pUserData );
+
+    // Recalculate the frames and notify any references.
+    pImageAsset->mAtlasRelocating = true;
+
+    if ( pImageAsset->getOwned() )
+        pImageAsset->refreshAsset();
+    else
+        pImageAsset->calculateImage();
+
+    pImageAsset->mAtlasRelocating = false;
 }
 
 //------------------------------------------------------------------------------
@@ -1143,13 +1287,23 @@ void ImageAsset::calculateImage( void )
     // Clear frames.
     mFrames.clear();
 
-    // If we have an existing texture and we're setting to the same bitmap then force the texture manager
-    // to refresh the texture itself.
-    if ( !mImageTextureHandle.IsNull() && dStricmp(mImageTextureHandle.getTextureKey(), mImageFile) == 0 )
-        TextureManager::refresh( mImageFile );
+    // Flag the frames as changed.
+    mImageRevision++;
+
+    // Fetch the filter mode.
+    const TextureFilterMode filterMode = getTextureFilterMode();
+
+    // Use the texture atlas if the image is suitable.
+    if ( !acquireAtlasTexture( filterMode ) )
+    {
+        // If we have an existing texture and we're setting to the same bitmap then force the texture manager
+        // to refresh the texture itself.
+        if ( !mImageTextureHandle.IsNull() && dStricmp(mImageTextureHandle.getTextureKey(), mImageFile) == 0 )
+            TextureManager::refresh( mImageFile );
 
-    // Get image texture.
-    mImageTextureHandle.set( mImageFile, mImageLayers.size() > 0 ? TextureHandle::BitmapKeepTexture : TextureHandle::BitmapTexture, true, getForce16Bit() );
+        // Get image texture.
+        mImageTextureHandle.set( mImageFile, mImageLayers.size() > 0 ? TextureHandle::BitmapKeepTexture : TextureHandle::BitmapTexture, true, getForce16Bit() );
+    }
 
     // Is the texture valid?
     if ( mImageTextureHandle.IsNull() )
@@ -1159,30 +1313,9 @@ void ImageAsset::calculateImage( void )
         return;
     }
 
-    // Is the local filter mode specified?
-    if ( mLocalFilterMode != FILTER_INVALID )
-    {
-        // Yes, so set filter mode.
-        setTextureFilter( mLocalFilterMode );
-    }
-    else
-    {
-        TextureFilterMode filterMode = FILTER_NEAREST;
-
-        // No, so fetch the global filter.
-        const char* pGlobalFilter = Con::getVariable( "$pref::T2D::imageAssetGlobalFilterMode" );
-
-        // Fetch the global filter mode.
-        if ( pGlobalFilter != NULL && dStrlen(pGlobalFilter) > 0 )
-            filterMode = getFilterModeEnum( pGlobalFilter );
-
-        // If global filter mode is invalid then use local filter mode.
-        if ( filterMode == FILTER_INVALID )
-            filterMode = FILTER_NEAREST;
-
-        // Set filter mode.
+    // Set filter mode.  Atlas pages are already filtered by the mode they were acquired with.
+    if ( !isAtlased() )
         setTextureFilter( filterMode );
-    }
 
     // Calculate according to mode.
     if ( mExplicitMode )
@@ -1193,6 +1326,10 @@ void ImageAsset::calculateImage( void )
     {
         calculateImplicitMode();
     }
+
+    // Offset the frames into the atlas page.
+    if ( isAtlased() )
+        offsetAtlasFrames();
 }
 
 //------------------------------------------------------------------------------
@@ -1417,6 +1554,10 @@ void ImageAsset::redrawImage()
 {
     if (mImageLayers.size() > 0)
     {
+        // Layered images cannot stay in the texture atlas.
+        if (isAtlased())
+            calculateImage();
+
         GBitmap* map = mImageTextureHandle.getBitmap();
         if (map == nullptr)
         {
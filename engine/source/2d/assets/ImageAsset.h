@@ -39,6 +39,10 @@
 #include "graphics/TextureManager.h"
 #endif
 
+#ifndef _TEXTURE_ATLAS_H_
+#include "graphics/TextureAtlas.h"
+#endif
+
 //-----------------------------------------------------------------------------
 
 DefineConsoleType( TypeImageAssetPtr )
@@ -188,6 +192,7 @@ private:
     /// Configuration.
     StringTableEntry            mImageFile;
     bool                        mForce16Bit;
+    bool                        mAtlas;
     TextureFilterMode           mLocalFilterMode;
     bool                        mExplicitMode;
     bool                        mCellRowOrder;
@@ -206,6 +211,13 @@ private:
     TextureHandle               mImageTextureHandle;
     typeImageLayerVector        mImageLayers;
     ColorF                      mBlendColor;
+    U32                         mImageRevision;
+
+    /// Texture atlas.
+    TextureAtlas::AtlasEntry*   mpAtlasEntry;
+    bool                        mAtlasRelocating;
+    Vector2                     mAtlasTexelOffset;
+    Vector2                     mAtlasTexelScale;
 
 public:
     ImageAsset();
@@ -224,6 +236,9 @@ public:
     void                    setForce16Bit( const bool force16Bit );
     inline bool             getForce16Bit( void ) const                     { return mForce16Bit; }
 
+    void                    setAtlas( const bool atlas );
+    inline bool             getAtlas( void ) const                          { return mAtlas; }
+
     void                    setFilterMode( const TextureFilterMode filterMode );
     TextureFilterMode       getFilterMode( void ) const                     { return mLocalFilterMode; }
 
@@ -266,8 +281,9 @@ public:
     bool                    containsNamedRegion(const char* regionName);
 
     inline TextureHandle&   getImageTexture( void )                         { return mImageTextureHandle; }
-    inline S32              getImageWidth( void ) const                     { return mImageTextureHandle.getWidth(); }
-    inline S32              getImageHeight( void ) const                    { return mImageTextureHandle.getHeight(); }
+    inline S32              getImageWidth( void ) const                     { return mpAtlasEntry != NULL ? mpAtlasEntry->getSize().x : mImageTextureHandle.getWidth(); }
+    inline S32              getImageHeight( void ) const                    { return mpAtlasEntry != NULL ? mpAtlasEntry->getSize().y : mImageTextureHandle.getHeight(); }
+    inline U32              getImageRevision( void ) const                  { return mImageRevision; }
     inline U32              getFrameCount( void ) const                     { return (U32)mFrames.size(); };
     inline bool             containsFrame( const char* namedFrame )         { return containsNamedRegion(namedFrame); };
     
@@ -279,6 +295,13 @@ public:
     
     virtual bool            isAssetValid( void ) const                      { return !mImageTextureHandle.IsNull(); }
 
+    /// Texture atlas.
+    /// When packed, the image texture is the atlas page and the frame texels address the packed area.
+    /// Frame pixel areas stay relative to the image so the atlas offset must be added when drawing from the texture by pixel.
+    inline bool             isAtlased( void ) const                         { return mpAtlasEntry != NULL; }
+    inline Point2I          getAtlasOffset( void ) const                    { return mpAtlasEntry != NULL ? mpAtlasEntry->getOffset() : Point2I( 0, 0 ); }
+    inline Vector2          getAtlasTexel( const Vector2& texel ) const     { return mpAtlasEntry != NULL ? Vector2( mAtlasTexelOffset.x + (texel.x * mAtlasTexelScale.x), mAtlasTexelOffset.y + (texel.y * mAtlasTexelScale.y) ) : texel; }
+
     /// Explicit cell control.
     bool                    clearExplicitCells( void );
     bool                    addExplicitCell( const S32 cellOffsetX, const S32 cellOffsetY, const S32 cellWidth, const S32 cellHeight, const char* regionName );
@@ -322,6 +345,13 @@ private:
     void calculateImplicitMode( void );
     void calculateExplicitMode( void );
     void setTextureFilter( const TextureFilterMode filterMode );
+    TextureFilterMode getTextureFilterMode( void ) const;
+    static GLint getGLFilterMode( const TextureFilterMode filterMode );
+
+    bool acquireAtlasTexture( const TextureFilterMode filterMode );
+    void releaseAtlasTexture( void );
+    void offsetAtlasFrames( void );
+    static void onAtlasRelocated( void* pUserData );
 
     void completeLayerChange(const bool doRedraw);
     void redrawImage();
@@ -350,6 +380,9 @@ protected:
     static bool setForce16Bit( void* obj, const char* data )                { static_cast<ImageAsset*>(obj)->setForce16Bit(dAtob(data)); return false; }
     static bool writeForce16Bit( void* obj, StringTableEntry pFieldName )   { return static_cast<ImageAsset*>(obj)->getForce16Bit() == true; }
 
+    static bool setAtlas( void* obj, const char* data )                     { static_cast<ImageAsset*>(obj)->setAtlas(dAtob(data)); return false; }
+    static bool writeAtlas( void* obj, StringTableEntry pFieldName )        { return static_cast<ImageAsset*>(obj)->getAtlas() == true; }
+
     static bool setFilterMode( void* obj, const char* data );
     static bool writeFilterMode( void* obj, StringTableEntry pFieldName )   { return static_cast<ImageAsset*>(obj)->getFilterMode() != FILTER_INVALID; }
 
@@ -105,6 +105,36 @@ ConsoleMethodWithDocs(ImageAsset, getForce16Bit, ConsoleBool, 2, 2, ())
 
 //-----------------------------------------------------------------------------
 
+/*! Sets whether the image is packed into a shared texture atlas page or not.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(ImageAsset, setAtlas, ConsoleVoid, 3, 3, (atlas?))
+{
+    object->setAtlas( dAtob(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets whether the image is packed into a shared texture atlas page or not.
+    @return Whether the image is packed into a shared texture atlas page or not.
+*/
+ConsoleMethodWithDocs(ImageAsset, getAtlas, ConsoleBool, 2, 2, ())
+{
+    return object->getAtlas();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets whether the image is currently packed into a texture atlas page.
+    @return Whether the image is currently packed into a texture atlas page.
+*/
+ConsoleMethodWithDocs(ImageAsset, isAtlased, ConsoleBool, 2, 2, ())
+{
+    return object->isAtlased();
+}
+
+//-----------------------------------------------------------------------------
+
 /*! Sets whether CELL row order should be used or not.
     @return No return value.
 */
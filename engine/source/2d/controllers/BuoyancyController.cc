@@ -110,68 +110,59 @@ void BuoyancyController::integrate( Scene* pScene, const F32 totalTime, const F3
     // Query for candidate objects.
     pWorldQuery->anyQueryAABB( mFluidArea ); 
 
-    // Fetch results.
-    typeWorldQueryResultVector& queryResults = pWorldQuery->getQueryResults();
+    // Gather the awake, non-static bodies with collision shapes.
+    const U32 bodyCount = mBatch.gather( pWorldQuery->getQueryResults(), NULL, true, true );
 
-    // Iterate the results.
-    for ( U32 n = 0; n < (U32)queryResults.size(); n++ )
-    {
-        // Fetch the scene object.
-        SceneObject* pSceneObject = queryResults[n].mpSceneObject;
-
-        // Skip if asleep.
-        if ( !pSceneObject->getAwake() )
-            continue;
+    // Finish if nothing to process.
+    if ( bodyCount == 0 )
+        return;
 
-        // Ignore if it's a static body.
-        if ( pSceneObject->getBodyType() == b2_staticBody )
-            continue;
-
-        // Fetch the shape count.
-        const U32 shapeCount = pSceneObject->getCollisionShapeCount();
+    // Fetch the fluid surface.
+    const F32 surfaceHeight = mFluidArea.upperBound.y;
 
-        // Skip if no collision shapes.
-        if ( shapeCount == 0 )
-            continue;
+    // Calculate the submersion of each body.
+    for ( U32 n = 0; n < bodyCount; n++ )
+    {
+        // Fetch the body.
+        const b2Body* pBody = mBatch.getObject( n )->getBody();
 
         // Fetch the body transform.
-        const b2Transform& bodyTransform = pSceneObject->getBody()->GetTransform();;
+        const b2Transform& bodyTransform = pBody->GetTransform();
+
+        // The fixture bounds are only valid if the body is in the broad-phase.
+        const bool hasBounds = pBody->IsActive();
 
         Vector2 areaCenter(0.0f, 0.0f);
         Vector2 massCenter(0.0f, 0.0f);
         F32 area = 0.0f;
         F32 mass = 0.0f;
 
-        // Yes, so iterate them.
-        for( U32 i = 0; i < shapeCount; ++i )
+        // Iterate the fixtures.
+        for ( const b2Fixture* pFixture = pBody->GetFixtureList(); pFixture != NULL; pFixture = pFixture->GetNext() )
         {
-            // Fetch the fixture definition.
-            const b2FixtureDef fixtureDef = pSceneObject->getCollisionShapeDefinition( i );
-
             // Fetch the shape.
-            const b2Shape* pShape = fixtureDef.shape;
+            const b2Shape* pShape = pFixture->GetShape();
+            const b2Shape::Type shapeType = pShape->GetType();
+
+            // Skip if the shape has no area.
+            if ( shapeType != b2Shape::e_circle && shapeType != b2Shape::e_polygon )
+                continue;
+
+            // Skip if the shape is completely dry.
+            if ( hasBounds && pFixture->GetAABB(0).lowerBound.y >= surfaceHeight )
+                continue;
 
             Vector2 shapeCenter(0.0f, 0.0f);
-            
-            F32 shapeArea = 0.0f;
+            F32 shapeArea;
 
             // Calculate the area for the shape type.
-            if ( pShape->GetType() == b2Shape::e_circle )
-            {
-                shapeArea = ComputeCircleSubmergedArea( bodyTransform, dynamic_cast<const b2CircleShape*>(pShape), shapeCenter );
-            }
-            else if ( pShape->GetType() == b2Shape::e_polygon)
-            {
-                shapeArea = ComputePolygonSubmergedArea( bodyTransform, dynamic_cast<const b2PolygonShape*>(pShape), shapeCenter );
-            }
-            else if ( pShape->GetType() == b2Shape::e_edge || pShape->GetType() == b2Shape::e_chain )
+            if ( shapeType == b2Shape::e_circle )
             {
-                shapeArea = 0.0f;
+                shapeArea = ComputeCircleSubmergedArea( bodyTransform, static_cast<const b2CircleShape*>(pShape), shapeCenter );
             }
             else
             {
-                // Skip if unknown shape type.
-                continue;
+                shapeArea = ComputePolygonSubmergedArea( bodyTransform, static_cast<const b2PolygonShape*>(pShape), shapeCenter );
             }
 
             // Calculate area.
@@ -180,7 +171,7 @@ void BuoyancyController::integrate( Scene* pScene, const F32 totalTime, const F3
             areaCenter.y += shapeArea * shapeCenter.y;
 
             // Calculate mass.
-            const F32 shapeDensity = mUseShapeDensity ? fixtureDef.density : 1.0f;
+            const F32 shapeDensity = mUseShapeDensity ? pFixture->GetDensity() : 1.0f;
             mass += shapeArea*shapeDensity;
             massCenter.x += shapeArea * shapeCenter.x * shapeDensity;
             massCenter.y += shapeArea * shapeCenter.y * shapeDensity;
@@ -188,7 +179,10 @@ void BuoyancyController::integrate( Scene* pScene, const F32 totalTime, const F3
 
         // Skip not in water.
         if( area < b2_epsilon )
+        {
+            mBatch.setSubmersion( n, 0.0f, areaCenter, massCenter );
             continue;
+        }
 
         // Calculate area/mass centers.
         areaCenter.x /= area;
@@ -196,17 +190,14 @@ void BuoyancyController::integrate( Scene* pScene, const F32 totalTime, const F3
         massCenter.x /= mass;
         massCenter.y /= mass;
 
-        // Buoyancy
-        const Vector2 buoyancyForce = -mFluidDensity * area * mFluidGravity;
-        pSceneObject->applyForce(buoyancyForce, massCenter);
+        mBatch.setSubmersion( n, area, areaCenter, massCenter );
+    }
 
-        // Linear drag
-        const Vector2 dragForce = (pSceneObject->getLinearVelocityFromWorldPoint(areaCenter) - mFlowVelocity) * (-mLinearDrag * area);
-        pSceneObject->applyForce(dragForce, areaCenter );
+    // Calculate the buoyancy and drag for all the bodies.
+    mBatch.computeFluidForces( mFluidDensity, mFluidGravity, mFlowVelocity, mLinearDrag, mAngularDrag );
 
-        // Angular drag
-        pSceneObject->applyTorque( -pSceneObject->getInertia() / pSceneObject->getMass() * area * pSceneObject->getAngularVelocity()*mAngularDrag );
-    }
+    // Apply the forces.
+    mBatch.scatter( false );
 }
 
 //------------------------------------------------------------------------------
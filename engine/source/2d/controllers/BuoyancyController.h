@@ -31,6 +31,10 @@
 #include "2d/core/vector2.h"
 #endif
 
+#ifndef _CONTROLLER_BATCH_H_
+#include "2d/controllers/core/ControllerBatch.h"
+#endif
+
 //------------------------------------------------------------------------------
 
 class BuoyancyController : public PickingSceneController
@@ -62,6 +66,9 @@ private:
     /// The outer fluid surface normal.
     Vector2 mSurfaceNormal;
 
+    /// The bodies being integrated.
+    ControllerBatch mBatch;
+
 protected:
     F32 ComputeCircleSubmergedArea( const b2Transform& bodyTransform, const b2CircleShape* pShape, Vector2& center );
     F32 ComputePolygonSubmergedArea( const b2Transform& bodyTransform, const b2PolygonShape* pShape, Vector2& center );
@@ -124,84 +124,27 @@ void PointForceController::integrate( Scene* pScene, const F32 totalTime, const
     if ( resultCount == 0 )
         return;
 
-    // Calculate the radius squared.
-    const F32 radiusSqr = mRadius * mRadius;
+    // Gather the non-static bodies other than the tracked object.
+    if ( mBatch.gather( queryResults, mTrackedObject, false, false ) == 0 )
+        return;
 
-    // Calculate the force squared in-case we need it.
-    const F32 forceSqr = mForce * mForce * (( mForce < 0.0f ) ? -1.0f : 1.0f);
+    // Calculate the forces for all the bodies.
+    mBatch.computePointForces( currentPosition, mRadius, mForce, mNonLinear );
 
     // Calculate drag coefficients (time-integrated).
     const F32 linearDrag = mClampF( mLinearDrag, 0.0f, 1.0f ) * elapsedTime;
     const F32 angularDrag = mClampF( mAngularDrag, 0.0f, 1.0f ) * elapsedTime;
 
-    // Fetch the tracked object.
-    const SceneObject* pTrackedObject = mTrackedObject;
-
-    // Iterate the results.
-    for ( U32 n = 0; n < resultCount; n++ )
+    // Drag?
+    const bool applyDrag = linearDrag > 0.0f || angularDrag > 0.0f;
+    if ( applyDrag )
     {
-        // Fetch the scene object.
-        SceneObject* pSceneObject = queryResults[n].mpSceneObject;
-
-        // Ignore if it's the tracked object.
-        if ( pSceneObject == pTrackedObject )
-            continue;
-
-        // Ignore if it's a static body.
-        if ( pSceneObject->getBodyType() == b2_staticBody )
-            continue;
-
-        // Calculate the force distance to the controllers current position.
-        Vector2 distanceForce = currentPosition - pSceneObject->getPosition();
-
-        // Fetch distance squared.
-        const F32 distanceSqr = distanceForce.LengthSquared();
-
-        // Skip if the position is outside the radius or is centered on the controller.
-        if ( distanceSqr > radiusSqr || distanceSqr < FLT_EPSILON )
-            continue;
-
-        // Non-Linear force?
-        if ( mNonLinear )
-        {
-            // Yes, so use an approximation of the inverse-square law.
-            distanceForce *= (1.0f / distanceSqr) * forceSqr;
-        }
-        else
-        {
-            // No, so normalize to the specified force (linear).
-            distanceForce.Normalize( mForce );
-        }
-
-        // Apply the force.
-        pSceneObject->applyForce( distanceForce, true );
-
-        // Linear drag?
-        if ( linearDrag > 0.0f )
-        {
-            // Yes, so fetch linear velocity.
-            Vector2 linearVelocity = pSceneObject->getLinearVelocity();
-
-            // Calculate linear velocity change.
-            const Vector2 linearVelocityDelta = linearVelocity * linearDrag;
-
-            // Set linear velocity.
-            pSceneObject->setLinearVelocity( linearVelocity - linearVelocityDelta );
-        }
-
-        // Angular drag?
-        if ( angularDrag > 0.0f )
-        {
-            // Yes, so fetch angular velocity.
-            F32 angularVelocity = pSceneObject->getAngularVelocity();
-
-            // Calculate angular velocity change.
-            const F32 angularVelocityDelta = angularVelocity * angularDrag;
-
-            // Set angular velocity.
-            pSceneObject->setAngularVelocity( angularVelocity - angularVelocityDelta );
-        }
+        // Yes, so calculate the drag for all the bodies.
+        mBatch.computeVelocityDrag( linearDrag, angularDrag );
     }
+
+    // Apply the forces and drag.
+    mBatch.scatter( applyDrag );
 }
 
 //------------------------------------------------------------------------------
@@ -31,6 +31,10 @@
 #include "2d/core/vector2.h"
 #endif
 
+#ifndef _CONTROLLER_BATCH_H_
+#include "2d/controllers/core/ControllerBatch.h"
+#endif
+
 //------------------------------------------------------------------------------
 
 class PointForceController : public PickingSceneController
@@ -59,6 +63,9 @@ private:
     /// Tracked object.
     SimObjectPtr<SceneObject> mTrackedObject;
 
+    /// The bodies being integrated.
+    ControllerBatch mBatch;
+
 public:
     PointForceController();
     virtual ~PointForceController();
@@ -0,0 +1,420 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _CONTROLLER_BATCH_H_
+#include "2d/controllers/core/ControllerBatch.h"
+#endif
+
+#ifndef _SCENE_OBJECT_H_
+#include "2d/sceneobject/SceneObject.h"
+#endif
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+#if defined(TORQUE_CONTROLLER_BATCH_SSE)
+#include <emmintrin.h>
+#endif
+
+//------------------------------------------------------------------------------
+
+ControllerBatch::ControllerBatch() :
+    mCount(0),
+    mPaddedCount(0)
+{
+    // Set Vector Associations.
+    VECTOR_SET_ASSOCIATION( mObjects );
+    VECTOR_SET_ASSOCIATION( mPositionX );
+    VECTOR_SET_ASSOCIATION( mPositionY );
+    VECTOR_SET_ASSOCIATION( mCenterX );
+    VECTOR_SET_ASSOCIATION( mCenterY );
+    VECTOR_SET_ASSOCIATION( mOffsetX );
+    VECTOR_SET_ASSOCIATION( mOffsetY );
+    VECTOR_SET_ASSOCIATION( mVelocityX );
+    VECTOR_SET_ASSOCIATION( mVelocityY );
+    VECTOR_SET_ASSOCIATION( mAngularVelocity );
+    VECTOR_SET_ASSOCIATION( mInertiaRatio );
+    VECTOR_SET_ASSOCIATION( mArea );
+    VECTOR_SET_ASSOCIATION( mAreaCenterX );
+    VECTOR_SET_ASSOCIATION( mAreaCenterY );
+    VECTOR_SET_ASSOCIATION( mMassCenterX );
+    VECTOR_SET_ASSOCIATION( mMassCenterY );
+    VECTOR_SET_ASSOCIATION( mForceX );
+    VECTOR_SET_ASSOCIATION( mForceY );
+    VECTOR_SET_ASSOCIATION( mTorque );
+    VECTOR_SET_ASSOCIATION( mActive );
+}
+
+//------------------------------------------------------------------------------
+
+void ControllerBatch::resize( const U32 count )
+{
+    // Pad to a multiple of the kernel width.
+    mCount = count;
+    mPaddedCount = (count + 3) & ~3;
+
+    // Only grow the arrays.
+    if ( (U32)mPositionX.size() >= mPaddedCount )
+        return;
+
+    mObjects.setSize( mPaddedCount );
+    mPositionX.setSize( mPaddedCount );
+    mPositionY.setSize( mPaddedCount );
+    mCenterX.setSize( mPaddedCount );
+    mCenterY.setSize( mPaddedCount );
+    mOffsetX.setSize( mPaddedCount );
+    mOffsetY.setSize( mPaddedCount );
+    mVelocityX.setSize( mPaddedCount );
+    mVelocityY.setSize( mPaddedCount );
+    mAngularVelocity.setSize( mPaddedCount );
+    mInertiaRatio.setSize( mPaddedCount );
+    mArea.setSize( mPaddedCount );
+    mAreaCenterX.setSize( mPaddedCount );
+    mAreaCenterY.setSize( mPaddedCount );
+    mMassCenterX.setSize( mPaddedCount );
+    mMassCenterY.setSize( mPaddedCount );
+    mForceX.setSize( mPaddedCount );
+    mForceY.setSize( mPaddedCount );
+    mTorque.setSize( mPaddedCount );
+    mActive.setSize( mPaddedCount );
+}
+
+//------------------------------------------------------------------------------
+
+U32 ControllerBatch::gather( const typeWorldQueryResultVector& queryResults, const SceneObject* pIgnoreObject, const bool awakeOnly, const bool shapesOnly )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(ControllerBatch_Gather);
+
+    // Size for the worst case.
+    resize( (U32)queryResults.size() );
+
+    U32 count = 0;
+
+    // Iterate the results.
+    for ( typeWorldQueryResultVector::const_iterator itr = queryResults.begin(); itr != queryResults.end(); ++itr )
+    {
+        // Fetch the scene object.
+        SceneObject* pSceneObject = itr->mpSceneObject;
+
+        // Ignore if it's the ignored object.
+        if ( pSceneObject == pIgnoreObject )
+            continue;
+
+        // Fetch the body.
+        const b2Body* pBody = pSceneObject->getBody();
+
+        // Ignore if it's a static body.
+        if ( pBody->GetType() == b2_staticBody )
+            continue;
+
+        // Skip if asleep.
+        if ( awakeOnly && !pBody->IsAwake() )
+            continue;
+
+        // Skip if no collision shapes.
+        if ( shapesOnly && pSceneObject->getCollisionShapeCount() == 0 )
+            continue;
+
+        const b2Vec2& position = pBody->GetPosition();
+        const b2Vec2& worldCenter = pBody->GetWorldCenter();
+        const b2Vec2& localCenter = pBody->GetLocalCenter();
+        const b2Vec2& linearVelocity = pBody->GetLinearVelocity();
+        const F32 mass = pBody->GetMass();
+
+        mObjects[count] = pSceneObject;
+        mPositionX[count] = position.x;
+        mPositionY[count] = position.y;
+        mCenterX[count] = worldCenter.x;
+        mCenterY[count] = worldCenter.y;
+
+        // Forces on the whole body are applied at the position offset by the local center.
+        mOffsetX[count] = position.x + localCenter.x - worldCenter.x;
+        mOffsetY[count] = position.y + localCenter.y - worldCenter.y;
+
+        mVelocityX[count] = linearVelocity.x;
+        mVelocityY[count] = linearVelocity.y;
+        mAngularVelocity[count] = pBody->GetAngularVelocity();
+        mInertiaRatio[count] = mass > 0.0f ? pBody->GetInertia() / mass : 0.0f;
+        count++;
+    }
+
+    // Shrink to the gathered count.
+    mCount = count;
+    mPaddedCount = (count + 3) & ~3;
+
+    // Clear the padding so the kernels only see finite values.
+    for ( U32 n = count; n < mPaddedCount; ++n )
+    {
+        mObjects[n] = NULL;
+        mPositionX[n] = mPositionY[n] = 0.0f;
+        mCenterX[n] = mCenterY[n] = 0.0f;
+        mOffsetX[n] = mOffsetY[n] = 0.0f;
+        mVelocityX[n] = mVelocityY[n] = 0.0f;
+        mAngularVelocity[n] = 0.0f;
+        mInertiaRatio[n] = 0.0f;
+        mArea[n] = 0.0f;
+        mAreaCenterX[n] = mAreaCenterY[n] = 0.0f;
+        mMassCenterX[n] = mMassCenterY[n] = 0.0f;
+    }
+
+    // Clear the results.
+    for ( U32 n = 0; n < mPaddedCount; ++n )
+    {
+        mForceX[n] = mForceY[n] = 0.0f;
+        mTorque[n] = 0.0f;
+        mActive[n] = 0.0f;
+    }
+
+    return count;
+}
+
+//------------------------------------------------------------------------------
+
+void ControllerBatch::computePointForces( const Vector2& position, const F32 radius, const F32 force, const bool nonLinear )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(ControllerBatch_ComputePointForces);
+
+    // Calculate the radius squared.
+    const F32 radiusSqr = radius * radius;
+
+    // Calculate the force squared in-case we need it.
+    const F32 forceSqr = force * force * (( force < 0.0f ) ? -1.0f : 1.0f);
+
+#if defined(TORQUE_CONTROLLER_BATCH_SSE)
+    const __m128 positionX = _mm_set1_ps( position.x );
+    const __m128 positionY = _mm_set1_ps( position.y );
+    const __m128 radiusSqr4 = _mm_set1_ps( radiusSqr );
+    const __m128 epsilon4 = _mm_set1_ps( FLT_EPSILON );
+    const __m128 scale4 = _mm_set1_ps( nonLinear ? forceSqr : force );
+    const __m128 one4 = _mm_set1_ps( 1.0f );
+
+    for ( U32 n = 0; n < mPaddedCount; n += 4 )
+    {
+        // Calculate the force distance to the controllers position.
+        const __m128 distanceX = _mm_sub_ps( positionX, _mm_loadu_ps( &mPositionX[n] ) );
+        const __m128 distanceY = _mm_sub_ps( positionY, _mm_loadu_ps( &mPositionY[n] ) );
+        const __m128 distanceSqr = _mm_add_ps( _mm_mul_ps( distanceX, distanceX ), _mm_mul_ps( distanceY, distanceY ) );
+
+        // Only bodies inside the radius and not centered on the controller are active.
+        const __m128 active = _mm_and_ps( _mm_cmple_ps( distanceSqr, radiusSqr4 ), _mm_cmpge_ps( distanceSqr, epsilon4 ) );
+
+        // Either the inverse-square law or normalized to the force (linear).
+        const __m128 divisor = nonLinear ? distanceSqr : _mm_sqrt_ps( distanceSqr );
+        const __m128 scale = _mm_and_ps( active, _mm_div_ps( scale4, _mm_max_ps( divisor, epsilon4 ) ) );
+
+        const __m128 forceX = _mm_mul_ps( distanceX, scale );
+        const __m128 forceY = _mm_mul_ps( distanceY, scale );
+
+        // Torque from the application offset.
+        const __m128 torque = _mm_sub_ps( _mm_mul_ps( _mm_loadu_ps( &mOffsetX[n] ), forceY ), _mm_mul_ps( _mm_loadu_ps( &mOffsetY[n] ), forceX ) );
+
+        _mm_storeu_ps( &mForceX[n], _mm_add_ps( _mm_loadu_ps( &mForceX[n] ), forceX ) );
+        _mm_storeu_ps( &mForceY[n], _mm_add_ps( _mm_loadu_ps( &mForceY[n] ), forceY ) );
+        _mm_storeu_ps( &mTorque[n], _mm_add_ps( _mm_loadu_ps( &mTorque[n] ), torque ) );
+        _mm_storeu_ps( &mActive[n], _mm_or_ps( _mm_loadu_ps( &mActive[n] ), _mm_and_ps( active, one4 ) ) );
+    }
+#else
+    for ( U32 n = 0; n < mCount; ++n )
+    {
+        // Calculate the force distance to the controllers position.
+        const F32 distanceX = position.x - mPositionX[n];
+        const F32 distanceY = position.y - mPositionY[n];
+        const F32 distanceSqr = distanceX * distanceX + distanceY * distanceY;
+
+        // Skip if the position is outside the radius or is centered on the controller.
+        if ( distanceSqr > radiusSqr || distanceSqr < FLT_EPSILON )
+            continue;
+
+        // Either the inverse-square law or normalized to the force (linear).
+        const F32 scale = nonLinear ? forceSqr / distanceSqr : force / mSqrt( distanceSqr );
+        const F32 forceX = distanceX * scale;
+        const F32 forceY = distanceY * scale;
+
+        mForceX[n] += forceX;
+        mForceY[n] += forceY;
+        mTorque[n] += mOffsetX[n] * forceY - mOffsetY[n] * forceX;
+        mActive[n] = 1.0f;
+    }
+#endif
+}
+
+//------------------------------------------------------------------------------
+
+void ControllerBatch::computeVelocityDrag( const F32 linearDrag, const F32 angularDrag )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(ControllerBatch_ComputeVelocityDrag);
+
+#if defined(TORQUE_CONTROLLER_BATCH_SSE)
+    const __m128 linearDrag4 = _mm_set1_ps( linearDrag );
+    const __m128 angularDrag4 = _mm_set1_ps( angularDrag );
+
+    for ( U32 n = 0; n < mPaddedCount; n += 4 )
+    {
+        // Only drag the active bodies.
+        const __m128 active = _mm_loadu_ps( &mActive[n] );
+        const __m128 linearScale = _mm_mul_ps( active, linearDrag4 );
+        const __m128 angularScale = _mm_mul_ps( active, angularDrag4 );
+
+        const __m128 velocityX = _mm_loadu_ps( &mVelocityX[n] );
+        const __m128 velocityY = _mm_loadu_ps( &mVelocityY[n] );
+        const __m128 angularVelocity = _mm_loadu_ps( &mAngularVelocity[n] );
+
+        _mm_storeu_ps( &mVelocityX[n], _mm_sub_ps( velocityX, _mm_mul_ps( velocityX, linearScale ) ) );
+        _mm_storeu_ps( &mVelocityY[n], _mm_sub_ps( velocityY, _mm_mul_ps( velocityY, linearScale ) ) );
+        _mm_storeu_ps( &mAngularVelocity[n], _mm_sub_ps( angularVelocity, _mm_mul_ps( angularVelocity, angularScale ) ) );
+    }
+#else
+    for ( U32 n = 0; n < mCount; ++n )
+    {
+        // Only drag the active bodies.
+        if ( mActive[n] == 0.0f )
+            continue;
+
+        mVelocityX[n] -= mVelocityX[n] * linearDrag;
+        mVelocityY[n] -= mVelocityY[n] * linearDrag;
+        mAngularVelocity[n] -= mAngularVelocity[n] * angularDrag;
+    }
+#endif
+}
+
+//------------------------------------------------------------------------------
+
+void ControllerBatch::computeFluidForces( const F32 fluidDensity, const Vector2& fluidGravity, const Vector2& flowVelocity, const F32 linearDrag, const F32 angularDrag )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(ControllerBatch_ComputeFluidForces);
+
+#if defined(TORQUE_CONTROLLER_BATCH_SSE)
+    const __m128 buoyancyX4 = _mm_set1_ps( -fluidDensity * fluidGravity.x );
+    const __m128 buoyancyY4 = _mm_set1_ps( -fluidDensity * fluidGravity.y );
+    const __m128 flowX4 = _mm_set1_ps( flowVelocity.x );
+    const __m128 flowY4 = _mm_set1_ps( flowVelocity.y );
+    const __m128 linearDrag4 = _mm_set1_ps( -linearDrag );
+    const __m128 angularDrag4 = _mm_set1_ps( -angularDrag );
+    const __m128 epsilon4 = _mm_set1_ps( b2_epsilon );
+    const __m128 one4 = _mm_set1_ps( 1.0f );
+
+    for ( U32 n = 0; n < mPaddedCount; n += 4 )
+    {
+        // Only bodies that are submerged are active.
+        const __m128 area = _mm_loadu_ps( &mArea[n] );
+        const __m128 active = _mm_cmpge_ps( area, epsilon4 );
+
+        const __m128 centerX = _mm_loadu_ps( &mCenterX[n] );
+        const __m128 centerY = _mm_loadu_ps( &mCenterY[n] );
+        const __m128 angularVelocity = _mm_loadu_ps( &mAngularVelocity[n] );
+
+        // Buoyancy at the mass center.
+        const __m128 buoyancyX = _mm_mul_ps( buoyancyX4, area );
+        const __m128 buoyancyY = _mm_mul_ps( buoyancyY4, area );
+        const __m128 massArmX = _mm_sub_ps( _mm_loadu_ps( &mMassCenterX[n] ), centerX );
+        const __m128 massArmY = _mm_sub_ps( _mm_loadu_ps( &mMassCenterY[n] ), centerY );
+        __m128 torque = _mm_sub_ps( _mm_mul_ps( massArmX, buoyancyY ), _mm_mul_ps( massArmY, buoyancyX ) );
+
+        // Linear drag at the area center.
+        const __m128 areaArmX = _mm_sub_ps( _mm_loadu_ps( &mAreaCenterX[n] ), centerX );
+        const __m128 areaArmY = _mm_sub_ps( _mm_loadu_ps( &mAreaCenterY[n] ), centerY );
+        const __m128 pointVelocityX = _mm_sub_ps( _mm_loadu_ps( &mVelocityX[n] ), _mm_mul_ps( angularVelocity, areaArmY ) );
+        const __m128 pointVelocityY = _mm_add_ps( _mm_loadu_ps( &mVelocityY[n] ), _mm_mul_ps( angularVelocity, areaArmX ) );
+        const __m128 dragScale = _mm_mul_ps( linearDrag4, area );
+        const __m128 dragX = _mm_mul_ps( _mm_sub_ps( pointVelocityX, flowX4 ), dragScale );
+        const __m128 dragY = _mm_mul_ps( _mm_sub_ps( pointVelocityY, flowY4 ), dragScale );
+        torque = _mm_add_ps( torque, _mm_sub_ps( _mm_mul_ps( areaArmX, dragY ), _mm_mul_ps( areaArmY, dragX ) ) );
+
+        // Angular drag.
+        torque = _mm_add_ps( torque, _mm_mul_ps( _mm_mul_ps( _mm_loadu_ps( &mInertiaRatio[n] ), area ), _mm_mul_ps( angularVelocity, angularDrag4 ) ) );
+
+        _mm_storeu_ps( &mForceX[n], _mm_add_ps( _mm_loadu_ps( &mForceX[n] ), _mm_and_ps( active, _mm_add_ps( buoyancyX, dragX ) ) ) );
+        _mm_storeu_ps( &mForceY[n], _mm_add_ps( _mm_loadu_ps( &mForceY[n] ), _mm_and_ps( active, _mm_add_ps( buoyancyY, dragY ) ) ) );
+        _mm_storeu_ps( &mTorque[n], _mm_add_ps( _mm_loadu_ps( &mTorque[n] ), _mm_and_ps( active, torque ) ) );
+        _mm_storeu_ps( &mActive[n], _mm_or_ps( _mm_loadu_ps( &mActive[n] ), _mm_and_ps( active, one4 ) ) );
+    }
+#else
+    for ( U32 n = 0; n < mCount; ++n )
+    {
+        // Skip if not submerged.
+        const F32 area = mArea[n];
+        if ( area < b2_epsilon )
+            continue;
+
+        const F32 angularVelocity = mAngularVelocity[n];
+
+        // Buoyancy at the mass center.
+        const F32 buoyancyX = -fluidDensity * area * fluidGravity.x;
+        const F32 buoyancyY = -fluidDensity * area * fluidGravity.y;
+        const F32 massArmX = mMassCenterX[n] - mCenterX[n];
+        const F32 massArmY = mMassCenterY[n] - mCenterY[n];
+        F32 torque = massArmX * buoyancyY - massArmY * buoyancyX;
+
+        // Linear drag at the area center.
+        const F32 areaArmX = mAreaCenterX[n] - mCenterX[n];
+        const F32 areaArmY = mAreaCenterY[n] - mCenterY[n];
+        const F32 pointVelocityX = mVelocityX[n] - angularVelocity * areaArmY;
+        const F32 pointVelocityY = mVelocityY[n] + angularVelocity * areaArmX;
+        const F32 dragX = (pointVelocityX - flowVelocity.x) * (-linearDrag * area);
+        const F32 dragY = (pointVelocityY - flowVelocity.y) * (-linearDrag * area);
+        torque += areaArmX * dragY - areaArmY * dragX;
+
+        // Angular drag.
+        torque += -mInertiaRatio[n] * area * angularVelocity * angularDrag;
+
+        mForceX[n] += buoyancyX + dragX;
+        mForceY[n] += buoyancyY + dragY;
+        mTorque[n] += torque;
+        mActive[n] = 1.0f;
+    }
+#endif
+}
+
+//------------------------------------------------------------------------------
+
+void ControllerBatch::scatter( const bool applyVelocities )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(ControllerBatch_Scatter);
+
+    for ( U32 n = 0; n < mCount; ++n )
+    {
+        // Skip if not active.
+        if ( mActive[n] == 0.0f )
+            continue;
+
+        b2Body* pBody = mObjects[n]->getBody();
+
+        // Apply the force and torque.
+        pBody->ApplyForceToCenter( b2Vec2( mForceX[n], mForceY[n] ), true );
+
+        if ( mTorque[n] != 0.0f )
+            pBody->ApplyTorque( mTorque[n], true );
+
+        // Apply the velocities.
+        if ( applyVelocities )
+        {
+            pBody->SetLinearVelocity( b2Vec2( mVelocityX[n], mVelocityY[n] ) );
+            pBody->SetAngularVelocity( mAngularVelocity[n] );
+        }
+    }
+}
@@ -0,0 +1,116 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _CONTROLLER_BATCH_H_
+#define _CONTROLLER_BATCH_H_
+
+#ifndef _WORLD_QUERY_RESULT_H_
+#include "2d/scene/WorldQueryResult.h"
+#endif
+
+#ifndef _VECTOR2_H_
+#include "2d/core/Vector2.h"
+#endif
+
+//------------------------------------------------------------------------------
+
+// Use the SSE kernels where the compiler guarantees SSE2.
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TORQUE_CONTROLLER_BATCH_SSE
+#endif
+
+//------------------------------------------------------------------------------
+
+class SceneObject;
+
+//------------------------------------------------------------------------------
+
+/// Gathers the bodies a controller affects into contiguous arrays so that
+/// forces can be calculated for several bodies at once and then applied
+/// in a single pass.  The arrays are padded to a multiple of four so the
+/// kernels never need a remainder loop.
+class ControllerBatch
+{
+public:
+    ControllerBatch();
+    virtual ~ControllerBatch() {}
+
+    /// Gather.
+    U32 gather( const typeWorldQueryResultVector& queryResults, const SceneObject* pIgnoreObject, const bool awakeOnly, const bool shapesOnly );
+    inline U32 getCount( void ) const { return mCount; }
+    inline SceneObject* getObject( const U32 index ) const { return mObjects[index]; }
+
+    /// Kernels.
+    void computePointForces( const Vector2& position, const F32 radius, const F32 force, const bool nonLinear );
+    void computeVelocityDrag( const F32 linearDrag, const F32 angularDrag );
+    void computeFluidForces( const F32 fluidDensity, const Vector2& fluidGravity, const Vector2& flowVelocity, const F32 linearDrag, const F32 angularDrag );
+
+    /// Fluid submersion inputs for computeFluidForces().
+    inline void setSubmersion( const U32 index, const F32 area, const Vector2& areaCenter, const Vector2& massCenter )
+    {
+        mArea[index] = area;
+        mAreaCenterX[index] = areaCenter.x;
+        mAreaCenterY[index] = areaCenter.y;
+        mMassCenterX[index] = massCenter.x;
+        mMassCenterY[index] = massCenter.y;
+    }
+
+    /// Scatter.
+    void scatter( const bool applyVelocities );
+
+private:
+    void resize( const U32 count );
+
+private:
+    U32                     mCount;
+    U32                     mPaddedCount;
+
+    Vector<SceneObject*>    mObjects;
+
+    /// Gathered body state.
+    Vector<F32>             mPositionX;
+    Vector<F32>             mPositionY;
+    Vector<F32>             mCenterX;
+    Vector<F32>             mCenterY;
+    Vector<F32>             mOffsetX;
+    Vector<F32>             mOffsetY;
+    Vector<F32>             mVelocityX;
+    Vector<F32>             mVelocityY;
+    Vector<F32>             mAngularVelocity;
+    Vector<F32>             mInertiaRatio;
+
+    /// Fluid submersion.
+    Vector<F32>             mArea;
+    Vector<F32>             mAreaCenterX;
+    Vector<F32>             mAreaCenterY;
+    Vector<F32>             mMassCenterX;
+    Vector<F32>             mMassCenterY;
+
+    /// Results.
+    Vector<F32>             mForceX;
+    Vector<F32>             mForceY;
+    Vector<F32>             mTorque;
+    Vector<F32>             mActive;
+};
+
+#endif // _CONTROLLER_BATCH_H_
@@ -312,6 +312,130 @@ void BatchRender::SubmitQuad(
 
 //-----------------------------------------------------------------------------
 
+void BatchRender::SubmitQuads(
+        const U32 quadCount,
+        const Vector2* pVertexArray,
+        const Vector2* pTextureArray,
+        const ColorF* pColorArray,
+        TextureHandle& texture )
+{
+    // Sanity!
+    AssertFatal( mpDebugStats != NULL, "Debug stats have not been configured." );
+    AssertFatal( pVertexArray != NULL && pTextureArray != NULL, "BatchRender::SubmitQuads() - Invalid vertex or texture array." );
+
+    // Debug Profiling.
+    PROFILE_SCOPE(BatchRender_SubmitQuads);
+
+    // Fetch whether colors are specified.
+    const bool hasColors = pColorArray != NULL;
+
+    U32 quadsRemaining = quadCount;
+
+    while( quadsRemaining > 0 )
+    {
+        // Is the batch full?
+        if ( (mTriangleCount + 2) > BATCHRENDER_MAXTRIANGLES )
+        {
+            // Yes, so flush.
+            flush( mpDebugStats->batchBufferFullFlush );
+        }
+        // Do we have anything batched with a different color state?
+        else if ( mTriangleCount > 0 && (mColorCount > 0) != hasColors )
+        {
+            // Yes, so flush.
+            flush( mpDebugStats->batchColorStateFlush );
+        }
+
+        // Calculate how many quads we can fit in the batch.
+        const U32 quadRoom = (BATCHRENDER_MAXTRIANGLES - mTriangleCount) / 2;
+        const U32 runCount = quadsRemaining < quadRoom ? quadsRemaining : quadRoom;
+
+        // Strict order mode?
+        if ( mStrictOrderMode )
+        {
+            // Yes, so is there a texture change?
+            if ( texture != mStrictOrderTextureHandle && mTriangleCount > 0 )
+            {
+                // Yes, so flush.
+                flush( mpDebugStats->batchTextureChangeFlush );
+            }
+
+            // Add new indices.
+            U16 vertexIndex = (U16)mVertexCount;
+            for( U32 n = 0; n < runCount; ++n )
+            {
+                mIndexBuffer[mIndexCount++] = vertexIndex++;
+                mIndexBuffer[mIndexCount++] = vertexIndex++;
+                mIndexBuffer[mIndexCount++] = vertexIndex++;
+                mIndexBuffer[mIndexCount++] = vertexIndex--;
+                mIndexBuffer[mIndexCount++] = vertexIndex--;
+                mIndexBuffer[mIndexCount++] = vertexIndex;
+                vertexIndex += 3;
+            }
+
+            // Set strict order mode texture handle.
+            mStrictOrderTextureHandle = texture;
+        }
+        else
+        {
+            // No, so add a single triangle run for all the quads.
+            findTextureBatch( texture )->push_back( TriangleRun( TriangleRun::QUAD, runCount, mVertexCount ) );
+        }
+
+        // Add colors.
+        if ( hasColors )
+        {
+            for( U32 n = 0; n < runCount; ++n )
+            {
+                const ColorF& color = *(pColorArray++);
+                mColorBuffer[mColorCount++] = color;
+                mColorBuffer[mColorCount++] = color;
+                mColorBuffer[mColorCount++] = color;
+                mColorBuffer[mColorCount++] = color;
+            }
+        }
+
+        // Add textured vertices.
+        // NOTE: We swap #2/#3 here.
+        for( U32 n = 0; n < runCount; ++n )
+        {
+            mVertexBuffer[mVertexCount++] = pVertexArray[0];
+            mVertexBuffer[mVertexCount++] = pVertexArray[1];
+            mVertexBuffer[mVertexCount++] = pVertexArray[3];
+            mVertexBuffer[mVertexCount++] = pVertexArray[2];
+            mTextureBuffer[mTextureCoordCount++] = pTextureArray[0];
+            mTextureBuffer[mTextureCoordCount++] = pTextureArray[1];
+            mTextureBuffer[mTextureCoordCount++] = pTextureArray[3];
+            mTextureBuffer[mTextureCoordCount++] = pTextureArray[2];
+            pVertexArray += 4;
+            pTextureArray += 4;
+        }
+
+        // Stats.
+        mpDebugStats->batchTrianglesSubmitted += runCount * 2;
+
+        // Increase triangle count.
+        mTriangleCount += runCount * 2;
+
+        quadsRemaining -= runCount;
+
+        // Have we reached the buffer limit?
+        if ( (mTriangleCount + 2) > BATCHRENDER_MAXTRIANGLES )
+        {
+            // Yes, so flush.
+            flush( mpDebugStats->batchBufferFullFlush );
+        }
+        // Is batching enabled?
+        else if ( !mBatchEnabled )
+        {
+            // No, so flush immediately.
+            flushInternal();
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 void BatchRender::flush( U32& reasonMetric )
 {
     // Finish if no triangles to flush.
@@ -474,6 +598,9 @@ void BatchRender::flushInternal( void )
                         mIndexBuffer[mIndexCount++] = triangleIndex--;
                         mIndexBuffer[mIndexCount++] = triangleIndex--;
                         mIndexBuffer[mIndexCount++] = triangleIndex--;
+
+                        // Move to the next quad.
+                        triangleIndex += 4;
                     }
                 }
                 else if ( primitiveMode == TriangleRun::TRIANGLE )
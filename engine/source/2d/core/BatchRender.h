@@ -252,6 +252,16 @@ public:
             TextureHandle& texture,
             const ColorF& color = ColorF(-1.0f, -1.0f, -1.0f) );
 
+    /// Submit multiple quads for batching in a single call.
+    /// Each quad uses four consecutive vertices and texture coordinates indexed as with "SubmitQuad".
+    /// The color array is optional but if specified, holds a single color per quad.
+    void SubmitQuads(
+            const U32 quadCount,
+            const Vector2* pVertexArray,
+            const Vector2* pTextureArray,
+            const ColorF* pColorArray,
+            TextureHandle& texture );
+
     /// Render a quad immediately without affecting current batch.
     /// All render state should be set beforehand directly.
     /// Vertex and textures are indexed as:
@@ -0,0 +1,304 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _IMAGE_FRAME_ANIMATOR_H_
+#include "2d/core/ImageFrameAnimator.h"
+#endif
+
+#ifndef _IMAGE_FRAME_PROVIDER_CORE_H
+#include "2d/core/ImageFrameProviderCore.h"
+#endif
+
+#ifndef _SCENE_OBJECT_H_
+#include "2d/sceneobject/SceneObject.h"
+#endif
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+//-----------------------------------------------------------------------------
+
+ImageFrameAnimator::ImageFrameAnimator() :
+    mAnimationCount( 0 ),
+    mDispatchingAnimationEnds( false )
+{
+    VECTOR_SET_ASSOCIATION( mGroups );
+    VECTOR_SET_ASSOCIATION( mFreeGroups );
+    VECTOR_SET_ASSOCIATION( mAnimationEnds );
+}
+
+//-----------------------------------------------------------------------------
+
+ImageFrameAnimator::~ImageFrameAnimator()
+{
+    // Detach any remaining animations and delete the groups.
+    for ( typeAnimationGroupVector::iterator groupItr = mGroups.begin(); groupItr != mGroups.end(); ++groupItr )
+    {
+        AnimationGroup* pGroup = *groupItr;
+
+        for ( typeAnimationEntryVector::iterator entryItr = pGroup->mEntries.begin(); entryItr != pGroup->mEntries.end(); ++entryItr )
+        {
+            ImageFrameProviderCore* pProvider = entryItr->mpProvider;
+            pProvider->mAnimatorGroup = -1;
+            pProvider->mAnimatorEntry = -1;
+            pProvider->mpImageFrameAnimator = NULL;
+        }
+
+        delete pGroup;
+    }
+
+    mGroups.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+void ImageFrameAnimator::addAnimation( ImageFrameProviderCore* pProvider, SceneObject* pOwner )
+{
+    // Sanity!
+    AssertFatal( pProvider != NULL, "ImageFrameAnimator::addAnimation() - Cannot add a NULL provider." );
+    AssertFatal( pProvider->mAnimatorGroup == -1, "ImageFrameAnimator::addAnimation() - Provider is already added." );
+    AssertFatal( pProvider->mpAnimationAsset->notNull(), "ImageFrameAnimator::addAnimation() - Provider has no animation." );
+
+    // Fetch the animation asset.
+    const AnimationAsset* pAnimationAsset = *pProvider->mpAnimationAsset;
+
+    // Find the animation group.
+    U32 groupIndex;
+    typeAnimationGroupHash::iterator groupItr = mGroupLookup.find( pAnimationAsset );
+    if ( groupItr != mGroupLookup.end() )
+    {
+        groupIndex = groupItr->value;
+    }
+    else
+    {
+        // Reuse a free group if possible.
+        if ( mFreeGroups.size() > 0 )
+        {
+            groupIndex = mFreeGroups.last();
+            mFreeGroups.pop_back();
+        }
+        else
+        {
+            groupIndex = mGroups.size();
+            mGroups.push_back( new AnimationGroup() );
+        }
+
+        mGroups[groupIndex]->mpAnimationAsset = pAnimationAsset;
+        mGroupLookup.insert( pAnimationAsset, groupIndex );
+    }
+
+    // Add the entry.
+    AnimationGroup* pGroup = mGroups[groupIndex];
+    AnimationEntry entry;
+    entry.mpProvider = pProvider;
+    entry.mpOwner = pOwner;
+    pGroup->mEntries.push_back( entry );
+
+    pProvider->mAnimatorGroup = groupIndex;
+    pProvider->mAnimatorEntry = pGroup->mEntries.size()-1;
+
+    mAnimationCount++;
+}
+
+//-----------------------------------------------------------------------------
+
+void ImageFrameAnimator::removeAnimation( ImageFrameProviderCore* pProvider )
+{
+    // Remove the entry if added.
+    if ( pProvider->mAnimatorGroup != -1 )
+        removeEntry( pProvider->mAnimatorGroup, pProvider->mAnimatorEntry );
+
+    // Drop any queued animation end.
+    if ( mDispatchingAnimationEnds )
+    {
+        for ( S32 index = 0; index < mAnimationEnds.size(); ++index )
+        {
+            if ( mAnimationEnds[index] == pProvider )
+                mAnimationEnds[index] = NULL;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void ImageFrameAnimator::removeEntry( const U32 groupIndex, const U32 entryIndex )
+{
+    AnimationGroup* pGroup = mGroups[groupIndex];
+    typeAnimationEntryVector& entries = pGroup->mEntries;
+
+    // Sanity!
+    AssertFatal( entryIndex < (U32)entries.size(), "ImageFrameAnimator::removeEntry() - Invalid entry index." );
+
+    // Flag the provider as removed.
+    ImageFrameProviderCore* pProvider = entries[entryIndex].mpProvider;
+    pProvider->mAnimatorGroup = -1;
+    pProvider->mAnimatorEntry = -1;
+
+    // Move the last entry into the removed slot.
+    const U32 lastIndex = entries.size()-1;
+    if ( entryIndex != lastIndex )
+    {
+        entries[entryIndex] = entries[lastIndex];
+        entries[entryIndex].mpProvider->mAnimatorEntry = entryIndex;
+    }
+    entries.pop_back();
+
+    mAnimationCount--;
+
+    // Free the group if it's empty.
+    if ( entries.size() == 0 )
+    {
+        mGroupLookup.erase( pGroup->mpAnimationAsset );
+        pGroup->mpAnimationAsset = NULL;
+        mFreeGroups.push_back( groupIndex );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void ImageFrameAnimator::integrate( const F32 elapsedTime, const bool normalScene )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(ImageFrameAnimator_Integrate);
+
+    // Finish if nothing is playing.
+    if ( mAnimationCount == 0 )
+        return;
+
+    const U32 groupCount = mGroups.size();
+
+    for ( U32 groupIndex = 0; groupIndex < groupCount; ++groupIndex )
+    {
+        AnimationGroup* pGroup = mGroups[groupIndex];
+        const AnimationAsset* pAnimationAsset = pGroup->mpAnimationAsset;
+
+        // Skip free groups.
+        if ( pAnimationAsset == NULL )
+            continue;
+
+        // Skip if the animation cannot play.
+        if ( pAnimationAsset->getImage().isNull() )
+            continue;
+
+        const U32 frameCount = pAnimationAsset->getNamedCellsMode() ? pAnimationAsset->getValidatedNamedAnimationFrames().size() : pAnimationAsset->getValidatedAnimationFrames().size();
+        if ( frameCount == 0 )
+            continue;
+
+        const bool animationCycle = pAnimationAsset->getAnimationCycle();
+
+        typeAnimationEntryVector& entries = pGroup->mEntries;
+
+        U32 entryIndex = 0;
+        while ( entryIndex < (U32)entries.size() )
+        {
+            const AnimationEntry& entry = entries[entryIndex];
+            ImageFrameProviderCore* pProvider = entry.mpProvider;
+
+            // Drop animations that have stopped.
+            if ( pProvider->mAnimationFinished || pProvider->mStaticProvider )
+            {
+                removeEntry( groupIndex, entryIndex );
+                continue;
+            }
+
+            // Skip paused animations.
+            if ( pProvider->mAnimationPaused )
+            {
+                entryIndex++;
+                continue;
+            }
+
+            // Skip animations whose owner is not being ticked.
+            SceneObject* pOwner = entry.mpOwner;
+            if ( pOwner != NULL && (!pOwner->isEnabled() || pOwner->isBeingDeleted() || (!normalScene && !pOwner->getIsEditorTickAllowed())) )
+            {
+                entryIndex++;
+                continue;
+            }
+
+            // Update current time.
+            F32 currentTime = pProvider->mCurrentTime + elapsedTime * pProvider->mAnimationTimeScale;
+            const F32 totalIntegrationTime = pProvider->mTotalIntegrationTime;
+            const F32 frameIntegrationTime = pProvider->mFrameIntegrationTime;
+
+            // Check if the animation has finished.
+            const bool animationFinished = !animationCycle && mGreaterThanOrEqual( currentTime, totalIntegrationTime );
+            if ( animationFinished )
+            {
+                // Fix animation at end of frames.
+                currentTime = totalIntegrationTime - (frameIntegrationTime * 0.5f);
+            }
+
+            // Publish the frame.
+            pProvider->mCurrentTime = currentTime;
+            pProvider->mCurrentModTime = mFmod( currentTime, totalIntegrationTime );
+            pProvider->mCurrentFrameIndex = (S32)(pProvider->mCurrentModTime / frameIntegrationTime);
+            pProvider->mLastFrameIndex = pProvider->mCurrentFrameIndex;
+
+            // Queue the animation end.
+            if ( animationFinished )
+            {
+                pProvider->mAnimationFinished = true;
+                mAnimationEnds.push_back( pProvider );
+                removeEntry( groupIndex, entryIndex );
+                continue;
+            }
+
+            entryIndex++;
+        }
+    }
+
+    // Dispatch any animation ends.
+    if ( mAnimationEnds.size() > 0 )
+        dispatchAnimationEnds();
+}
+
+//-----------------------------------------------------------------------------
+
+void ImageFrameAnimator::dispatchAnimationEnds( void )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(ImageFrameAnimator_DispatchAnimationEnds);
+
+    mDispatchingAnimationEnds = true;
+
+    // NOTE: Callbacks may remove animations which clears their queued entry.
+    for ( S32 index = 0; index < mAnimationEnds.size(); ++index )
+    {
+        ImageFrameProviderCore* pProvider = mAnimationEnds[index];
+
+        // Skip if removed by an earlier callback.
+        if ( pProvider == NULL )
+            continue;
+
+        // Turn-off tick processing.
+        pProvider->setProcessTicks( false );
+
+        // Perform callback.
+        pProvider->onAnimationEnd();
+    }
+
+    mAnimationEnds.clear();
+
+    mDispatchingAnimationEnds = false;
+}
@@ -0,0 +1,93 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _IMAGE_FRAME_ANIMATOR_H_
+#define _IMAGE_FRAME_ANIMATOR_H_
+
+#ifndef _HASHTABLE_H_
+#include "collection/hashTable.h"
+#endif
+
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+class ImageFrameProviderCore;
+class AnimationAsset;
+class SceneObject;
+
+//-----------------------------------------------------------------------------
+
+/// Steps playing animations in bulk.
+/// Playing animations are held in a contiguous table grouped by their animation asset so that
+/// the asset data is fetched once per group.  Animation end callbacks are queued and only
+/// fired once all the animations have been stepped.
+class ImageFrameAnimator
+{
+public:
+    struct AnimationEntry
+    {
+        ImageFrameProviderCore* mpProvider;
+        SceneObject*            mpOwner;
+    };
+
+    typedef Vector<AnimationEntry> typeAnimationEntryVector;
+
+    struct AnimationGroup
+    {
+        const AnimationAsset*       mpAnimationAsset;
+        typeAnimationEntryVector    mEntries;
+    };
+
+private:
+    typedef Vector<AnimationGroup*> typeAnimationGroupVector;
+    typedef HashMap<const AnimationAsset*, U32> typeAnimationGroupHash;
+
+    typeAnimationGroupVector    mGroups;
+    typeAnimationGroupHash      mGroupLookup;
+    Vector<U32>                 mFreeGroups;
+    U32                         mAnimationCount;
+
+    Vector<ImageFrameProviderCore*> mAnimationEnds;
+    bool                        mDispatchingAnimationEnds;
+
+public:
+    ImageFrameAnimator();
+    virtual ~ImageFrameAnimator();
+
+    /// Registration.
+    void addAnimation( ImageFrameProviderCore* pProvider, SceneObject* pOwner );
+    void removeAnimation( ImageFrameProviderCore* pProvider );
+    inline U32 getAnimationCount( void ) const { return mAnimationCount; }
+
+    /// Integration.
+    void integrate( const F32 elapsedTime, const bool normalScene );
+
+private:
+    void removeEntry( const U32 groupIndex, const U32 entryIndex );
+    void dispatchAnimationEnds( void );
+};
+
+#endif // _IMAGE_FRAME_ANIMATOR_H_
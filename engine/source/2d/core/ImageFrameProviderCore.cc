@@ -47,7 +47,13 @@
 
 //-----------------------------------------------------------------------------
 
-ImageFrameProviderCore::ImageFrameProviderCore() : mpImageAsset(NULL), mpAnimationAsset(NULL)
+ImageFrameProviderCore::ImageFrameProviderCore() :
+    mpImageAsset(NULL),
+    mpAnimationAsset(NULL),
+    mpImageFrameAnimator(NULL),
+    mpAnimatorOwner(NULL),
+    mAnimatorGroup(-1),
+    mAnimatorEntry(-1)
 {
 }
 
@@ -83,6 +89,9 @@ void ImageFrameProviderCore::allocateAssets( AssetPtr<ImageAsset>* pImageAssetPt
 
 void ImageFrameProviderCore::resetState( void )
 {
+    // Detach from any animator.
+    detachImageFrameAnimator();
+
     mSelfTick = false;
 
     mCurrentFrameIndex = 0;
@@ -151,6 +160,10 @@ bool ImageFrameProviderCore::update( const F32 elapsedTime )
     if ( isAnimationPaused() )
         return true;
 
+    // Finish if the animator is stepping the animation.
+    if ( hasImageFrameAnimator() )
+        return false;
+
     // Update the animation.
     updateAnimation( Tickable::smTickSec );
 
@@ -272,16 +285,19 @@ void ImageFrameProviderCore::render(
 	if (!validRender())
 		return;
 
+	// Fetch the image.
+	const ImageAsset* pImageAsset = getProviderImage();
+
 	// Submit batched quad.
 	pBatchRenderer->SubmitQuad(
 		vertexPos0,
 		vertexPos1,
 		vertexPos2,
 		vertexPos3,
-		uvPos0,
-		uvPos1,
-		uvPos2,
-		uvPos3,
+		pImageAsset->getAtlasTexel(uvPos0),
+		pImageAsset->getAtlasTexel(uvPos1),
+		pImageAsset->getAtlasTexel(uvPos2),
+		pImageAsset->getAtlasTexel(uvPos3),
 		getProviderTexture());
 }
 
@@ -298,6 +314,18 @@ void ImageFrameProviderCore::render(
 	if (!validRender() || !vertexCount)
 		return;
 
+	// Map the texture coordinates into the atlas page if the image is packed.
+	const ImageAsset* pImageAsset = getProviderImage();
+	if (pImageAsset->isAtlased() && textureArray != NULL)
+	{
+		static Vector<Vector2> atlasTextureArray;
+		atlasTextureArray.setSize(vertexCount);
+		for (U32 index = 0; index < vertexCount; ++index)
+			atlasTextureArray[index] = pImageAsset->getAtlasTexel(textureArray[index]);
+
+		textureArray = atlasTextureArray.address();
+	}
+
 	// Submit mesh list
 	pBatchRenderer->SubmitTriangles(
 		vertexCount,
@@ -331,7 +359,7 @@ void ImageFrameProviderCore::renderGui( GuiControl& owner, Point2I offset, const
     {
         // Valid, so calculate source region.
         const ImageAsset::FrameArea& frameArea = getProviderImageFrameArea();
-        RectI sourceRegion( frameArea.mPixelArea.mPixelOffset, Point2I(frameArea.mPixelArea.mPixelWidth, frameArea.mPixelArea.mPixelHeight) );
+        RectI sourceRegion( frameArea.mPixelArea.mPixelOffset + getProviderImage()->getAtlasOffset(), Point2I(frameArea.mPixelArea.mPixelWidth, frameArea.mPixelArea.mPixelHeight) );
 
         // Calculate destination region.
         RectI destinationRegion(offset, owner.mBounds.extent);
@@ -633,6 +661,9 @@ bool ImageFrameProviderCore::playAnimation( const AssetPtr<AnimationAsset>& anim
     // Do an initial animation update.
     updateAnimation(0.0f);
 
+    // Register with the animator.
+    registerAnimation();
+
     // Return Okay.
     return true;
 }
@@ -736,6 +767,10 @@ void ImageFrameProviderCore::setAnimationFrame( const U32 frameIndex )
 
 void ImageFrameProviderCore::clearAssets( void )
 {
+    // Remove from the animator.
+    if ( mpImageFrameAnimator != NULL )
+        mpImageFrameAnimator->removeAnimation( this );
+
     // Clear assets.
     if ( mpAnimationAsset != NULL )
         mpAnimationAsset->clear();
@@ -761,3 +796,46 @@ void ImageFrameProviderCore::onAssetRefreshed( AssetPtrBase* pAssetPtrBase )
     // Attempt to restart the animation.
     playAnimation( *mpAnimationAsset );
 }
+
+//-----------------------------------------------------------------------------
+
+void ImageFrameProviderCore::attachImageFrameAnimator( ImageFrameAnimator* pImageFrameAnimator, SceneObject* pOwner )
+{
+    // Detach from any current animator.
+    detachImageFrameAnimator();
+
+    mpImageFrameAnimator = pImageFrameAnimator;
+    mpAnimatorOwner = pOwner;
+
+    // Register any playing animation.
+    registerAnimation();
+}
+
+//-----------------------------------------------------------------------------
+
+void ImageFrameProviderCore::detachImageFrameAnimator( void )
+{
+    // Finish if not attached.
+    if ( mpImageFrameAnimator == NULL )
+        return;
+
+    mpImageFrameAnimator->removeAnimation( this );
+    mpImageFrameAnimator = NULL;
+    mpAnimatorOwner = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+void ImageFrameProviderCore::registerAnimation( void )
+{
+    // Finish if not attached.
+    if ( mpImageFrameAnimator == NULL )
+        return;
+
+    // Remove any previous animation.
+    mpImageFrameAnimator->removeAnimation( this );
+
+    // Add the animation if it's playing.
+    if ( !isStaticFrameProvider() && !isAnimationFinished() && mpAnimationAsset != NULL && mpAnimationAsset->notNull() )
+        mpImageFrameAnimator->addAnimation( this, mpAnimatorOwner );
+}
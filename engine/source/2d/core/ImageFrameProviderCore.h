@@ -51,6 +51,10 @@
 #include "gui/guiControl.h"
 #endif
 
+#ifndef _IMAGE_FRAME_ANIMATOR_H_
+#include "2d/core/ImageFrameAnimator.h"
+#endif
+
 ///-----------------------------------------------------------------------------
 
 class ImageFrameProviderCore :
@@ -58,6 +62,8 @@ class ImageFrameProviderCore :
     public IFactoryObjectReset,
     protected AssetPtrCallback
 {
+    friend class ImageFrameAnimator;
+
 protected:
     bool                                    mSelfTick;
 
@@ -82,6 +88,11 @@ protected:
     bool                                    mAnimationPaused;
     bool                                    mAnimationFinished;
 
+    ImageFrameAnimator*                     mpImageFrameAnimator;
+    SceneObject*                            mpAnimatorOwner;
+    S32                                     mAnimatorGroup;
+    S32                                     mAnimatorEntry;
+
 public:
     ImageFrameProviderCore();
     virtual ~ImageFrameProviderCore();
@@ -159,9 +170,15 @@ public:
     inline bool isAnimationFinished( void ) const { return mAnimationFinished; };
     bool isAnimationValid( void ) const;
 
+    /// Animator.
+    void attachImageFrameAnimator( ImageFrameAnimator* pImageFrameAnimator, SceneObject* pOwner );
+    void detachImageFrameAnimator( void );
+    inline bool hasImageFrameAnimator( void ) const { return mpImageFrameAnimator != NULL; }
+
     /// Frame provision.
     inline bool isStaticFrameProvider( void ) const { return mStaticProvider; }
     inline bool isUsingNamedImageFrame( void ) const { return mUsingNamedFrame; }
+    inline ImageAsset* getProviderImage( void ) const { return !validRender() ? NULL : isStaticFrameProvider() ? (ImageAsset*)(*mpImageAsset) : (ImageAsset*)(*mpAnimationAsset)->getImage(); };
     inline TextureHandle& getProviderTexture( void ) const { return !validRender() ? BadTextureHandle : isStaticFrameProvider() ? (*mpImageAsset)->getImageTexture() : (*mpAnimationAsset)->getImage()->getImageTexture(); };
     const ImageAsset::FrameArea& getProviderImageFrameArea( void ) const;
     inline const AnimationAsset* getCurrentAnimation( void ) const { return mpAnimationAsset->notNull() ? *mpAnimationAsset : NULL; };
@@ -175,6 +192,7 @@ public:
     virtual void resetState( void );
 
 protected:
+    void registerAnimation( void );
     virtual void onAnimationEnd( void ) {}
     virtual void onAssetRefreshed( AssetPtrBase* pAssetPtrBase );
 };
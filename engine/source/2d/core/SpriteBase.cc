@@ -71,6 +71,28 @@ void SpriteBase::integrateObject( const F32 totalTime, const F32 elapsedTime, De
     ImageFrameProvider::update( elapsedTime );
 }
 
+//-----------------------------------------------------------------------------
+
+void SpriteBase::OnRegisterScene( Scene* pScene )
+{
+    // Call Parent.
+    Parent::OnRegisterScene( pScene );
+
+    // Step the animation with the scene animator.
+    ImageFrameProvider::attachImageFrameAnimator( &pScene->getImageFrameAnimator(), this );
+}
+
+//-----------------------------------------------------------------------------
+
+void SpriteBase::OnUnregisterScene( Scene* pScene )
+{
+    // Stop stepping the animation with the scene animator.
+    ImageFrameProvider::detachImageFrameAnimator();
+
+    // Call Parent.
+    Parent::OnUnregisterScene( pScene );
+}
+
 //------------------------------------------------------------------------------
 
 bool SpriteBase::validRender( void ) const
@@ -45,6 +45,9 @@ public:
 
     virtual void integrateObject( const F32 totalTime, const F32 elapsedTime, DebugStats* pDebugStats );
 
+    virtual void OnRegisterScene( Scene* pScene );
+    virtual void OnUnregisterScene( Scene* pScene );
+
     virtual bool validRender( void ) const;
     virtual bool shouldRender( void ) const { return true; }
 
@@ -32,6 +32,15 @@
 #include "2d/scene/SceneRenderObject.h"
 #endif
 
+// Use the SIMD transform kernel where the compiler guarantees support.
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TORQUE_SPRITE_BATCH_SSE
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define TORQUE_SPRITE_BATCH_NEON
+#include <arm_neon.h>
+#endif
+
 //------------------------------------------------------------------------------
 
 static StringTableEntry spritesNodeName = StringTable->insert( "Sprites" );
@@ -46,7 +55,9 @@ SpriteBatch::SpriteBatch() :
     mDefaultSpriteSize( 1.0f, 1.0f ),
     mDefaultSpriteAngle( 0.0f ),
     mpSpriteBatchQuery( NULL ),
-    mBatchCulling( true )
+    mBatchCulling( true ),
+    mpImageFrameAnimator( NULL ),
+    mpAnimatorOwner( NULL )
 {
     // Reset batch transform.
     mBatchTransform.SetIdentity();
@@ -58,6 +69,13 @@ SpriteBatch::SpriteBatch() :
 	mLocalAABB.upperBound.SetZero();
 	mLocalExtents.SetZero();
     mLocalExtentsDirty = true;
+
+    // Set Vector Associations.
+    VECTOR_SET_ASSOCIATION( mRenderItems );
+    VECTOR_SET_ASSOCIATION( mTransformItems );
+    VECTOR_SET_ASSOCIATION( mTransformX );
+    VECTOR_SET_ASSOCIATION( mTransformY );
+    VECTOR_SET_ASSOCIATION( mTransformBounds );
 }
 
 //------------------------------------------------------------------------------
@@ -98,6 +116,9 @@ void SpriteBatch::prepareRender( SceneRenderObject* pSceneRenderObject, const Sc
     // Set the sort mode.
     pSceneRenderQueue->setSortMode( getBatchSortMode() );
 
+    // Clear the render items.
+    mRenderItems.clear();
+
     // Do we have a sprite batch query?
     if ( mpSpriteBatchQuery != NULL )
     {
@@ -126,7 +147,8 @@ void SpriteBatch::prepareRender( SceneRenderObject* pSceneRenderObject, const Sc
         // Fetch results.
         typeSpriteBatchQueryResultVector& queryResults = pSpriteBatchQuery->getQueryResults();
 
-        // Add picked sprites.
+        // Add visible picked sprites.
+        mRenderItems.reserve( resultCount );
         for ( U32 n = 0; n < resultCount; n++ )
         {
             // Fetch sprite batch Item.
@@ -136,17 +158,7 @@ void SpriteBatch::prepareRender( SceneRenderObject* pSceneRenderObject, const Sc
             if ( !pSpriteBatchItem->getVisible() )
                 continue;
 
-            // Create a render request.
-            SceneRenderRequest* pSceneRenderRequest = pSceneRenderQueue->createRenderRequest();
-
-            // Prepare batch item.
-            pSpriteBatchItem->prepareRender( pSceneRenderRequest, mBatchTransformId );
-
-            // Set identity.
-            pSceneRenderRequest->mpSceneRenderObject = pSceneRenderObject;
-
-            // Set custom data.
-            pSceneRenderRequest->mpCustomData1 = pSpriteBatchItem;
+            mRenderItems.push_back( pSpriteBatchItem );
         }
 
         // Clear sprite batch query.
@@ -154,7 +166,8 @@ void SpriteBatch::prepareRender( SceneRenderObject* pSceneRenderObject, const Sc
     }
     else
     {
-        // No, so perform a render request for all the sprites.
+        // No, so add all the visible sprites.
+        mRenderItems.reserve( (U32)mSprites.size() );
         for( typeSpriteBatchHash::iterator spriteItr = mSprites.begin(); spriteItr != mSprites.end(); ++spriteItr )
         {
             // Fetch sprite batch Item.
@@ -164,19 +177,199 @@ void SpriteBatch::prepareRender( SceneRenderObject* pSceneRenderObject, const Sc
             if ( !pSpriteBatchItem->getVisible() )
                 continue;
 
-            // Create a render request.
-            SceneRenderRequest* pSceneRenderRequest = pSceneRenderQueue->createRenderRequest();
+            mRenderItems.push_back( pSpriteBatchItem );
+        }
+    }
+
+    // Update the render transforms of the sprites together.
+    updateRenderTransforms();
+
+    // Create render requests for the sprites.
+    const U32 renderCount = (U32)mRenderItems.size();
+    for ( U32 n = 0; n < renderCount; n++ )
+    {
+        // Fetch sprite batch Item.
+        SpriteBatchItem* pSpriteBatchItem = mRenderItems[n];
+
+        // Create a render request.
+        SceneRenderRequest* pSceneRenderRequest = pSceneRenderQueue->createRenderRequest();
+
+        // Prepare batch item.
+        pSpriteBatchItem->prepareRender( pSceneRenderRequest, mBatchTransformId );
+
+        // Set identity.
+        pSceneRenderRequest->mpSceneRenderObject = pSceneRenderObject;
+
+        // Set custom data.
+        pSceneRenderRequest->mpCustomData1 = pSpriteBatchItem;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void SpriteBatch::updateRenderTransforms( void )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SpriteBatch_UpdateRenderTransforms);
+
+    // Gather the sprites whose render transform is stale.
+    // Sprites with a clean local transform only need the batch transform applied.
+    mTransformItems.clear();
+    mTransformX.clear();
+    mTransformY.clear();
+
+    const U32 renderCount = (U32)mRenderItems.size();
+    for ( U32 n = 0; n < renderCount; n++ )
+    {
+        SpriteBatchItem* pSpriteBatchItem = mRenderItems[n];
+
+        // Skip if the render transform is up-to-date.
+        if ( !pSpriteBatchItem->mLocalTransformDirty && pSpriteBatchItem->mLastBatchTransformId == mBatchTransformId )
+            continue;
+
+        // Update the local transform if needed.
+        if ( pSpriteBatchItem->mLocalTransformDirty )
+            pSpriteBatchItem->updateLocalTransform();
+
+        mTransformItems.push_back( pSpriteBatchItem );
+
+        const Vector2* pLocalOOBB = pSpriteBatchItem->mLocalOOBB;
+        for ( U32 vertex = 0; vertex < 4; ++vertex )
+        {
+            mTransformX.push_back( pLocalOOBB[vertex].x );
+            mTransformY.push_back( pLocalOOBB[vertex].y );
+        }
+    }
+
+    // Finish if nothing to transform.
+    const U32 transformCount = (U32)mTransformItems.size();
+    if ( transformCount == 0 )
+        return;
+
+    // Transform all the vertices.
+    transformRenderVertices( transformCount );
+
+    // Scatter the results.
+    const F32* pTransformX = mTransformX.address();
+    const F32* pTransformY = mTransformY.address();
+    const F32* pBounds = mTransformBounds.address();
+    for ( U32 n = 0; n < transformCount; n++, pTransformX += 4, pTransformY += 4, pBounds += 4 )
+    {
+        SpriteBatchItem* pSpriteBatchItem = mTransformItems[n];
+
+        for ( U32 vertex = 0; vertex < 4; ++vertex )
+            pSpriteBatchItem->mRenderOOBB[vertex].Set( pTransformX[vertex], pTransformY[vertex] );
+
+        pSpriteBatchItem->mRenderAABB.lowerBound.Set( pBounds[0], pBounds[1] );
+        pSpriteBatchItem->mRenderAABB.upperBound.Set( pBounds[2], pBounds[3] );
+        pSpriteBatchItem->mRenderPosition = pSpriteBatchItem->mRenderAABB.GetCenter();
+        pSpriteBatchItem->mLastBatchTransformId = mBatchTransformId;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void SpriteBatch::transformRenderVertices( const U32 count )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SpriteBatch_TransformRenderVertices);
+
+    // Each sprite is four vertices so a single SIMD register holds a whole quad.
+    mTransformBounds.setSize( count * 4 );
+
+    F32* pTransformX = mTransformX.address();
+    F32* pTransformY = mTransformY.address();
+    F32* pBounds = mTransformBounds.address();
 
-            // Prepare batch item.
-            pSpriteBatchItem->prepareRender( pSceneRenderRequest, mBatchTransformId );
+    const F32 cosine = mBatchTransform.q.c;
+    const F32 sine = mBatchTransform.q.s;
+    const F32 positionX = mBatchTransform.p.x;
+    const F32 positionY = mBatchTransform.p.y;
+
+#if defined(TORQUE_SPRITE_BATCH_SSE)
+    const __m128 c = _mm_set1_ps( cosine );
+    const __m128 s = _mm_set1_ps( sine );
+    const __m128 px = _mm_set1_ps( positionX );
+    const __m128 py = _mm_set1_ps( positionY );
+
+    for ( U32 n = 0; n < count; n++, pTransformX += 4, pTransformY += 4, pBounds += 4 )
+    {
+        const __m128 x = _mm_loadu_ps( pTransformX );
+        const __m128 y = _mm_loadu_ps( pTransformY );
+
+        const __m128 worldX = _mm_add_ps( _mm_sub_ps( _mm_mul_ps( c, x ), _mm_mul_ps( s, y ) ), px );
+        const __m128 worldY = _mm_add_ps( _mm_add_ps( _mm_mul_ps( s, x ), _mm_mul_ps( c, y ) ), py );
+
+        _mm_storeu_ps( pTransformX, worldX );
+        _mm_storeu_ps( pTransformY, worldY );
+
+        // Reduce to the bounds.
+        __m128 minX = _mm_min_ps( worldX, _mm_shuffle_ps( worldX, worldX, _MM_SHUFFLE(1,0,3,2) ) );
+        __m128 minY = _mm_min_ps( worldY, _mm_shuffle_ps( worldY, worldY, _MM_SHUFFLE(1,0,3,2) ) );
+        __m128 maxX = _mm_max_ps( worldX, _mm_shuffle_ps( worldX, worldX, _MM_SHUFFLE(1,0,3,2) ) );
+        __m128 maxY = _mm_max_ps( worldY, _mm_shuffle_ps( worldY, worldY, _MM_SHUFFLE(1,0,3,2) ) );
+        minX = _mm_min_ss( minX, _mm_shuffle_ps( minX, minX, _MM_SHUFFLE(2,3,0,1) ) );
+        minY = _mm_min_ss( minY, _mm_shuffle_ps( minY, minY, _MM_SHUFFLE(2,3,0,1) ) );
+        maxX = _mm_max_ss( maxX, _mm_shuffle_ps( maxX, maxX, _MM_SHUFFLE(2,3,0,1) ) );
+        maxY = _mm_max_ss( maxY, _mm_shuffle_ps( maxY, maxY, _MM_SHUFFLE(2,3,0,1) ) );
+        _mm_store_ss( pBounds + 0, minX );
+        _mm_store_ss( pBounds + 1, minY );
+        _mm_store_ss( pBounds + 2, maxX );
+        _mm_store_ss( pBounds + 3, maxY );
+    }
+#elif defined(TORQUE_SPRITE_BATCH_NEON)
+    const float32x4_t px = vdupq_n_f32( positionX );
+    const float32x4_t py = vdupq_n_f32( positionY );
 
-            // Set identity.
-            pSceneRenderRequest->mpSceneRenderObject = pSceneRenderObject;
+    for ( U32 n = 0; n < count; n++, pTransformX += 4, pTransformY += 4, pBounds += 4 )
+    {
+        const float32x4_t x = vld1q_f32( pTransformX );
+        const float32x4_t y = vld1q_f32( pTransformY );
+
+        const float32x4_t worldX = vmlsq_n_f32( vmlaq_n_f32( px, x, cosine ), y, sine );
+        const float32x4_t worldY = vmlaq_n_f32( vmlaq_n_f32( py, x, sine ), y, cosine );
+
+        vst1q_f32( pTransformX, worldX );
+        vst1q_f32( pTransformY, worldY );
+
+        // Reduce to the bounds.
+        float32x2_t minX = vpmin_f32( vget_low_f32( worldX ), vget_high_f32( worldX ) );
+        float32x2_t minY = vpmin_f32( vget_low_f32( worldY ), vget_high_f32( worldY ) );
+        float32x2_t maxX = vpmax_f32( vget_low_f32( worldX ), vget_high_f32( worldX ) );
+        float32x2_t maxY = vpmax_f32( vget_low_f32( worldY ), vget_high_f32( worldY ) );
+        pBounds[0] = vget_lane_f32( vpmin_f32( minX, minX ), 0 );
+        pBounds[1] = vget_lane_f32( vpmin_f32( minY, minY ), 0 );
+        pBounds[2] = vget_lane_f32( vpmax_f32( maxX, maxX ), 0 );
+        pBounds[3] = vget_lane_f32( vpmax_f32( maxY, maxY ), 0 );
+    }
+#else
+    for ( U32 n = 0; n < count; n++, pTransformX += 4, pTransformY += 4, pBounds += 4 )
+    {
+        F32 lowerX = F32_MAX, lowerY = F32_MAX;
+        F32 upperX = -F32_MAX, upperY = -F32_MAX;
 
-            // Set custom data.
-            pSceneRenderRequest->mpCustomData1 = pSpriteBatchItem;
+        for ( U32 vertex = 0; vertex < 4; ++vertex )
+        {
+            const F32 x = pTransformX[vertex];
+            const F32 y = pTransformY[vertex];
+            const F32 worldX = (cosine * x - sine * y) + positionX;
+            const F32 worldY = (sine * x + cosine * y) + positionY;
+
+            pTransformX[vertex] = worldX;
+            pTransformY[vertex] = worldY;
+
+            lowerX = getMin( lowerX, worldX );
+            lowerY = getMin( lowerY, worldY );
+            upperX = getMax( upperX, worldX );
+            upperY = getMax( upperY, worldY );
         }
+
+        pBounds[0] = lowerX;
+        pBounds[1] = lowerY;
+        pBounds[2] = upperX;
+        pBounds[3] = upperY;
     }
+#endif
 }
 
 //------------------------------------------------------------------------------
@@ -1107,6 +1300,10 @@ SpriteBatchItem* SpriteBatch::createSprite( void )
     // Set batch parent.
     pSpriteBatchItem->setBatchParent( this, batchId );
 
+    // Step the animation with the batch animator.
+    if ( mpImageFrameAnimator != NULL )
+        pSpriteBatchItem->attachImageFrameAnimator( mpImageFrameAnimator, mpAnimatorOwner );
+
     // Create sprite batch item,
     mSprites.insert( batchId, pSpriteBatchItem );
 
@@ -1129,6 +1326,10 @@ SpriteBatchItem* SpriteBatch::createSprite( const Vector2* explicitVertices  )
     // Set batch parent.
     pSpriteBatchItem->setBatchParent( this, batchId );
 
+    // Step the animation with the batch animator.
+    if ( mpImageFrameAnimator != NULL )
+        pSpriteBatchItem->attachImageFrameAnimator( mpImageFrameAnimator, mpAnimatorOwner );
+
     // Set explicit mode.
     pSpriteBatchItem->setExplicitMode( true );
 
@@ -1243,6 +1444,10 @@ SpriteBatchItem* SpriteBatch::createSprite( const SpriteBatchItem::LogicalPositi
 
 void SpriteBatch::integrateSprites(const F32 totalTime, const F32 elapsedTime, DebugStats* pDebugStats)
 {
+   // Finish if the animator is stepping the sprites.
+   if (mpImageFrameAnimator != NULL)
+      return;
+
    //process the elapsed time for all sprites
    for (typeSpriteBatchHash::iterator spriteItr = mSprites.begin(); spriteItr != mSprites.end(); ++spriteItr)
    {
@@ -1253,6 +1458,23 @@ void SpriteBatch::integrateSprites(const F32 totalTime, const F32 elapsedTime, D
 
 //------------------------------------------------------------------------------
 
+void SpriteBatch::setImageFrameAnimator( ImageFrameAnimator* pImageFrameAnimator, SceneObject* pOwner )
+{
+    mpImageFrameAnimator = pImageFrameAnimator;
+    mpAnimatorOwner = pOwner;
+
+    // Attach or detach all the sprites.
+    for( typeSpriteBatchHash::iterator spriteItr = mSprites.begin(); spriteItr != mSprites.end(); ++spriteItr )
+    {
+        if ( mpImageFrameAnimator != NULL )
+            spriteItr->value->attachImageFrameAnimator( mpImageFrameAnimator, mpAnimatorOwner );
+        else
+            spriteItr->value->detachImageFrameAnimator();
+    }
+}
+
+//------------------------------------------------------------------------------
+
 void SpriteBatch::setBatchTransform( const b2Transform& batchTransform )
 {
     // Update world transform.
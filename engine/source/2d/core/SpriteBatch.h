@@ -61,6 +61,9 @@ private:
     SpriteBatchQuery*               mpSpriteBatchQuery;
     U32                             mMasterBatchId;
 
+    ImageFrameAnimator*             mpImageFrameAnimator;
+    SceneObject*                    mpAnimatorOwner;
+
     b2Transform                     mBatchTransform;
     bool                            mBatchTransformDirty;
     U32                             mBatchTransformId;
@@ -69,6 +72,14 @@ private:
     Vector2                         mLocalExtents;
     bool                            mLocalExtentsDirty;
 
+    /// Render transform store.
+    typedef Vector<SpriteBatchItem*> typeSpriteItemVector;
+    typeSpriteItemVector            mRenderItems;
+    typeSpriteItemVector            mTransformItems;
+    Vector<F32>                     mTransformX;
+    Vector<F32>                     mTransformY;
+    Vector<F32>                     mTransformBounds;
+
 public:
     SpriteBatch();
     virtual ~SpriteBatch();
@@ -201,6 +212,7 @@ protected:
     virtual SpriteBatchItem* createSprite( const SpriteBatchItem::LogicalPosition& logicalPosition );
 
     void integrateSprites(const F32 totalTime, const F32 elapsedTime, DebugStats* pDebugStats);
+    void setImageFrameAnimator( ImageFrameAnimator* pImageFrameAnimator, SceneObject* pOwner );
 
     void setBatchTransform( const b2Transform& batchTransform );
     void updateLocalExtents(const b2AABB *precalculatedLocalAABB = NULL);
@@ -208,6 +220,8 @@ protected:
     void createSpriteBatchQuery( void );
     void destroySpriteBatchQuery( void );
 
+    b2AABB calculateLocalAABB( const b2AABB& renderAABB );
+
     void onTamlCustomWrite( TamlCustomNodes& customNodes  );
     void onTamlCustomRead( const TamlCustomNodes& customNodes );
 
@@ -215,7 +229,8 @@ private:
     bool destroySprite( const U32 batchId );
     bool checkSpriteSelected( void ) const;
 
-    b2AABB calculateLocalAABB( const b2AABB& renderAABB );
+    void updateRenderTransforms( void );
+    void transformRenderVertices( const U32 count );
 };
 
 #endif // _SPRITE_BATCH_H_
@@ -0,0 +1,749 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _SPRITE_TILE_MAP_H_
+#include "2d/core/SpriteTileMap.h"
+#endif
+
+#ifndef _BATCH_RENDER_H_
+#include "2d/core/BatchRender.h"
+#endif
+
+#ifndef _CORE_MATH_H_
+#include "2d/core/CoreMath.h"
+#endif
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+//------------------------------------------------------------------------------
+
+static StringTableEntry tilesNodeName       = StringTable->insert( "Tiles" );
+static StringTableEntry tileRowNodeName     = StringTable->insert( "Row" );
+static StringTableEntry tileRowPositionName = StringTable->insert( "Position" );
+static StringTableEntry tileRowFramesName   = StringTable->insert( "Frames" );
+
+//------------------------------------------------------------------------------
+
+SpriteTileMap::SpriteTileMap() :
+    mTileCount( 0 ),
+    mIsometric( false ),
+    mTileStride( 1.0f, 1.0f ),
+    mTileSize( 1.0f, 1.0f ),
+    mTileAngle( 0.0f ),
+    mLocalAABBDirty( true ),
+    mRenderFrame( 0 ),
+    mpQueryResults( NULL )
+{
+    // Set Vector Associations.
+    VECTOR_SET_ASSOCIATION( mCachedChunks );
+
+    // Reset the local bounds.
+    mLocalAABB.lowerBound.SetZero();
+    mLocalAABB.upperBound.SetZero();
+
+    // Calculate the tile bounds.
+    mTileLocalOOBB[0].Set( -0.5f, -0.5f );
+    mTileLocalOOBB[1].Set( +0.5f, -0.5f );
+    mTileLocalOOBB[2].Set( +0.5f, +0.5f );
+    mTileLocalOOBB[3].Set( -0.5f, +0.5f );
+    CoreMath::mOOBBtoAABB( mTileLocalOOBB, mTileLocalAABB );
+}
+
+//------------------------------------------------------------------------------
+
+SpriteTileMap::~SpriteTileMap()
+{
+    clearTiles();
+}
+
+//------------------------------------------------------------------------------
+
+void SpriteTileMap::setImage( const char* pAssetId )
+{
+    // Set asset.
+    mImageAsset = pAssetId;
+
+    // Flag all the chunk quads as dirty.
+    for( typeChunkHash::iterator chunkItr = mChunks.begin(); chunkItr != mChunks.end(); ++chunkItr )
+        chunkItr->value->mQuadsDirty = true;
+}
+
+//------------------------------------------------------------------------------
+
+void SpriteTileMap::setLayout( const bool isometric, const Vector2& tileStride, const Vector2& tileSize, const F32 tileAngle )
+{
+    // Finish if no change.
+    if ( isometric == mIsometric && tileStride.isEqual( mTileStride ) && tileSize.isEqual( mTileSize ) && mIsEqual( tileAngle, mTileAngle ) )
+        return;
+
+    // Debug Profiling.
+    PROFILE_SCOPE(SpriteTileMap_SetLayout);
+
+    mIsometric = isometric;
+    mTileStride = tileStride;
+    mTileSize = tileSize;
+    mTileAngle = tileAngle;
+
+    // Calculate the tile bounds.
+    const F32 halfWidth = mTileSize.x * 0.5f;
+    const F32 halfHeight = mTileSize.y * 0.5f;
+    mTileLocalOOBB[0].Set( -halfWidth, -halfHeight );
+    mTileLocalOOBB[1].Set( +halfWidth, -halfHeight );
+    mTileLocalOOBB[2].Set( +halfWidth, +halfHeight );
+    mTileLocalOOBB[3].Set( -halfWidth, +halfHeight );
+    CoreMath::mCalculateOOBB( mTileLocalOOBB, b2Transform( b2Vec2(0.0f, 0.0f), b2Rot(mTileAngle) ), mTileLocalOOBB );
+    CoreMath::mOOBBtoAABB( mTileLocalOOBB, mTileLocalAABB );
+
+    // Update all the chunks.
+    for( typeChunkHash::iterator chunkItr = mChunks.begin(); chunkItr != mChunks.end(); ++chunkItr )
+    {
+        Chunk* pChunk = chunkItr->value;
+        mChunkTree.DestroyProxy( pChunk->mProxyId );
+        updateChunkAABB( pChunk );
+        pChunk->mProxyId = mChunkTree.CreateProxy( pChunk->mLocalAABB, pChunk );
+        pChunk->mQuadsDirty = true;
+    }
+
+    mLocalAABBDirty = true;
+}
+
+//------------------------------------------------------------------------------
+
+bool SpriteTileMap::setTile( const S32 tileX, const S32 tileY, const U32 frame, const U16 flags )
+{
+    // Sanity!
+    if ( frame >= EMPTY_TILE )
+    {
+        // Warn.
+        Con::warnf( "SpriteTileMap::setTile() - Invalid tile frame of '%d'.", frame );
+        return false;
+    }
+
+    // Fetch the chunk, creating it if required.
+    Chunk* pChunk = findChunk( tileX, tileY );
+    if ( pChunk == NULL )
+        pChunk = createChunk( getChunkCoordinate( tileX ), getChunkCoordinate( tileY ) );
+
+    // Fetch the tile.
+    Tile& tile = pChunk->mTiles[((tileY - (pChunk->mChunkY * CHUNK_SIZE)) * CHUNK_SIZE) + (tileX - (pChunk->mChunkX * CHUNK_SIZE))];
+
+    // Count the tile if it's new.
+    if ( tile.mFrame == EMPTY_TILE )
+    {
+        pChunk->mTileCount++;
+        mTileCount++;
+        mLocalAABBDirty = true;
+    }
+
+    tile.mFrame = (U16)frame;
+    tile.mFlags = flags;
+
+    pChunk->mQuadsDirty = true;
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+
+bool SpriteTileMap::getTile( const S32 tileX, const S32 tileY, Tile& tile ) const
+{
+    // Fetch the chunk.
+    const Chunk* pChunk = findChunk( tileX, tileY );
+    if ( pChunk == NULL )
+        return false;
+
+    tile = pChunk->mTiles[((tileY - (pChunk->mChunkY * CHUNK_SIZE)) * CHUNK_SIZE) + (tileX - (pChunk->mChunkX * CHUNK_SIZE))];
+
+    return tile.mFrame != EMPTY_TILE;
+}
+
+//------------------------------------------------------------------------------
+
+bool SpriteTileMap::clearTile( const S32 tileX, const S32 tileY )
+{
+    // Fetch the chunk.
+    Chunk* pChunk = findChunk( tileX, tileY );
+    if ( pChunk == NULL )
+        return false;
+
+    // Fetch the tile.
+    Tile& tile = pChunk->mTiles[((tileY - (pChunk->mChunkY * CHUNK_SIZE)) * CHUNK_SIZE) + (tileX - (pChunk->mChunkX * CHUNK_SIZE))];
+
+    // Finish if the tile is already empty.
+    if ( tile.mFrame == EMPTY_TILE )
+        return false;
+
+    tile.mFrame = EMPTY_TILE;
+    tile.mFlags = 0;
+
+    pChunk->mTileCount--;
+    mTileCount--;
+    mLocalAABBDirty = true;
+
+    // Destroy the chunk if it's empty.
+    if ( pChunk->mTileCount == 0 )
+        destroyChunk( pChunk );
+    else
+        pChunk->mQuadsDirty = true;
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+
+void SpriteTileMap::clearTiles( void )
+{
+    // Destroy all the chunks.
+    while( mChunks.size() > 0 )
+        destroyChunk( mChunks.begin()->value );
+
+    mCachedChunks.clear();
+    mTileCount = 0;
+    mLocalAABBDirty = true;
+}
+
+//------------------------------------------------------------------------------
+
+const b2AABB& SpriteTileMap::getLocalAABB( void )
+{
+    // Finish if the local bounds are up-to-date.
+    if ( !mLocalAABBDirty )
+        return mLocalAABB;
+
+    // Debug Profiling.
+    PROFILE_SCOPE(SpriteTileMap_UpdateLocalAABB);
+
+    mLocalAABBDirty = false;
+
+    // Reset the local bounds.
+    mLocalAABB.lowerBound.SetZero();
+    mLocalAABB.upperBound.SetZero();
+
+    bool firstTile = true;
+    for( typeChunkHash::iterator chunkItr = mChunks.begin(); chunkItr != mChunks.end(); ++chunkItr )
+    {
+        const Chunk* pChunk = chunkItr->value;
+
+        // Find the occupied tile range in the chunk.
+        S32 lowerX = CHUNK_SIZE, lowerY = CHUNK_SIZE, upperX = -1, upperY = -1;
+        for ( S32 y = 0; y < CHUNK_SIZE; ++y )
+        {
+            for ( S32 x = 0; x < CHUNK_SIZE; ++x )
+            {
+                if ( pChunk->mTiles[(y * CHUNK_SIZE) + x].mFrame == EMPTY_TILE )
+                    continue;
+
+                lowerX = getMin( lowerX, x );
+                lowerY = getMin( lowerY, y );
+                upperX = getMax( upperX, x );
+                upperY = getMax( upperY, y );
+            }
+        }
+
+        // Combine the corner tile positions.
+        const S32 originX = pChunk->mChunkX * CHUNK_SIZE;
+        const S32 originY = pChunk->mChunkY * CHUNK_SIZE;
+        Vector2 corners[4];
+        corners[0] = getTilePosition( originX + lowerX, originY + lowerY );
+        corners[1] = getTilePosition( originX + upperX, originY + lowerY );
+        corners[2] = getTilePosition( originX + upperX, originY + upperY );
+        corners[3] = getTilePosition( originX + lowerX, originY + upperY );
+
+        for ( U32 n = 0; n < 4; ++n )
+        {
+            b2AABB tileAABB;
+            tileAABB.lowerBound = corners[n] + Vector2( mTileLocalAABB.lowerBound );
+            tileAABB.upperBound = corners[n] + Vector2( mTileLocalAABB.upperBound );
+
+            if ( firstTile )
+            {
+                mLocalAABB = tileAABB;
+                firstTile = false;
+            }
+            else
+            {
+                mLocalAABB.Combine( tileAABB );
+            }
+        }
+    }
+
+    return mLocalAABB;
+}
+
+//------------------------------------------------------------------------------
+
+void SpriteTileMap::queryChunks( const b2AABB& localAABB, typeChunkVector& chunks )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SpriteTileMap_QueryChunks);
+
+    // Next render frame.
+    mRenderFrame++;
+
+    // Query the chunks.
+    mpQueryResults = &chunks;
+    mChunkTree.Query( this, localAABB );
+    mpQueryResults = NULL;
+
+    // Release the quads of chunks that have not been seen recently.
+    trimCachedChunks();
+}
+
+//------------------------------------------------------------------------------
+
+bool SpriteTileMap::QueryCallback( S32 proxyId )
+{
+    // Fetch the chunk.
+    Chunk* pChunk = static_cast<Chunk*>( mChunkTree.GetUserData( proxyId ) );
+
+    // Note it as rendered this frame.
+    pChunk->mLastRenderFrame = mRenderFrame;
+
+    mpQueryResults->push_back( pChunk );
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+
+void SpriteTileMap::renderChunk( Chunk* pChunk, const b2Transform& batchTransform, const U32 batchTransformId, BatchRender* pBatchRenderer )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SpriteTileMap_RenderChunk);
+
+    // Finish if no image.
+    if ( mImageAsset.isNull() || !mImageAsset->isAssetValid() )
+        return;
+
+    // Build the quads if the tiles or the image frames have changed.
+    if ( pChunk->mQuadsDirty || pChunk->mImageRevision != mImageAsset->getImageRevision() )
+        buildChunkQuads( pChunk );
+
+    // Finish if nothing to render.
+    if ( pChunk->mQuadCount == 0 )
+        return;
+
+    // Transform the quads if the batch has moved.
+    if ( pChunk->mLastBatchTransformId != batchTransformId )
+    {
+        const U32 vertexCount = pChunk->mQuadCount * 4;
+        const Vector2* pLocalVertex = pChunk->mLocalVertices.address();
+        Vector2* pRenderVertex = pChunk->mRenderVertices.address();
+        for ( U32 n = 0; n < vertexCount; ++n )
+            pRenderVertex[n] = b2Mul( batchTransform, pLocalVertex[n] );
+
+        pChunk->mLastBatchTransformId = batchTransformId;
+    }
+
+    // Submit all the chunk quads in a single batch.
+    pBatchRenderer->SubmitQuads( pChunk->mQuadCount, pChunk->mRenderVertices.address(), pChunk->mTexels.address(), NULL, mImageAsset->getImageTexture() );
+}
+
+//------------------------------------------------------------------------------
+
+void SpriteTileMap::copyTo( SpriteTileMap* pSpriteTileMap ) const
+{
+    // Sanity!
+    AssertFatal( pSpriteTileMap != NULL, "SpriteTileMap::copyTo() - Cannot copy to a NULL tile map." );
+
+    pSpriteTileMap->clearTiles();
+    pSpriteTileMap->setImage( getImage() );
+    pSpriteTileMap->setLayout( mIsometric, mTileStride, mTileSize, mTileAngle );
+
+    // Copy the chunks.
+    for( typeChunkHash::const_iterator chunkItr = mChunks.begin(); chunkItr != mChunks.end(); ++chunkItr )
+    {
+        const Chunk* pChunk = chunkItr->value;
+        Chunk* pCopyChunk = pSpriteTileMap->createChunk( pChunk->mChunkX, pChunk->mChunkY );
+        dMemcpy( pCopyChunk->mTiles, pChunk->mTiles, sizeof(pChunk->mTiles) );
+        pCopyChunk->mTileCount = pChunk->mTileCount;
+    }
+
+    pSpriteTileMap->mTileCount = mTileCount;
+    pSpriteTileMap->mLocalAABBDirty = true;
+}
+
+//------------------------------------------------------------------------------
+
+void SpriteTileMap::onTamlCustomWrite( TamlCustomNodes& customNodes )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SpriteTileMap_TamlCustomWrite);
+
+    // Finish if no tiles.
+    if ( mTileCount == 0 )
+        return;
+
+    // Add tiles node.
+    TamlCustomNode* pTilesNode = customNodes.addNode( tilesNodeName );
+
+    // Write each occupied chunk row.
+    char frameBuffer[32];
+    char rowBuffer[CHUNK_SIZE * 16];
+    for( typeChunkHash::iterator chunkItr = mChunks.begin(); chunkItr != mChunks.end(); ++chunkItr )
+    {
+        const Chunk* pChunk = chunkItr->value;
+
+        for ( S32 y = 0; y < CHUNK_SIZE; ++y )
+        {
+            const Tile* pRow = pChunk->mTiles + (y * CHUNK_SIZE);
+
+            // Format the row frames with flags as a suffix.
+            bool occupied = false;
+            rowBuffer[0] = 0;
+            for ( S32 x = 0; x < CHUNK_SIZE; ++x )
+            {
+                const Tile& tile = pRow[x];
+
+                if ( tile.mFrame == EMPTY_TILE )
+                {
+                    dStrcpy( frameBuffer, "-1" );
+                }
+                else
+                {
+                    occupied = true;
+
+                    if ( tile.mFlags != 0 )
+                        dSprintf( frameBuffer, sizeof(frameBuffer), "%d:%d", tile.mFrame, tile.mFlags );
+                    else
+                        dSprintf( frameBuffer, sizeof(frameBuffer), "%d", tile.mFrame );
+                }
+
+                if ( x > 0 )
+                    dStrcat( rowBuffer, " " );
+                dStrcat( rowBuffer, frameBuffer );
+            }
+
+            // Skip empty rows.
+            if ( !occupied )
+                continue;
+
+            TamlCustomNode* pRowNode = pTilesNode->addNode( tileRowNodeName );
+            pRowNode->addField( tileRowPositionName, Point2I( pChunk->mChunkX * CHUNK_SIZE, (pChunk->mChunkY * CHUNK_SIZE) + y ) );
+            pRowNode->addField( tileRowFramesName, rowBuffer );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void SpriteTileMap::onTamlCustomRead( const TamlCustomNodes& customNodes )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SpriteTileMap_TamlCustomRead);
+
+    // Find tiles custom node.
+    const TamlCustomNode* pTilesNode = customNodes.findNode( tilesNodeName );
+
+    // Finish if we don't have the node.
+    if ( pTilesNode == NULL )
+        return;
+
+    // Fetch children nodes.
+    const TamlCustomNodeVector& rowNodes = pTilesNode->getChildren();
+
+    // Iterate rows.
+    for( TamlCustomNodeVector::const_iterator rowItr = rowNodes.begin(); rowItr != rowNodes.end(); ++rowItr )
+    {
+        // Fetch row node.
+        TamlCustomNode* pRowNode = *rowItr;
+
+        // Is this a known node name?
+        if ( pRowNode->getNodeName() != tileRowNodeName )
+        {
+            // No, so warn.
+            Con::warnf( "SpriteTileMap - Unknown custom type '%s'.", pRowNode->getNodeName() );
+            continue;
+        }
+
+        // Fetch the row fields.
+        const TamlCustomField* pPositionField = pRowNode->findField( tileRowPositionName );
+        const TamlCustomField* pFramesField = pRowNode->findField( tileRowFramesName );
+        if ( pPositionField == NULL || pFramesField == NULL )
+        {
+            // Warn.
+            Con::warnf( "SpriteTileMap - Tile row is missing its position or frames." );
+            continue;
+        }
+
+        Point2I position;
+        pPositionField->getFieldValue( position );
+
+        // Parse the frames.
+        const char* pFrames = pFramesField->getFieldValue();
+        S32 tileX = position.x;
+        while( *pFrames != 0 )
+        {
+            // Skip separators.
+            if ( *pFrames == ' ' )
+            {
+                pFrames++;
+                continue;
+            }
+
+            // Fetch the frame and optional flags.
+            const S32 frame = dAtoi( pFrames );
+            while( *pFrames != 0 && *pFrames != ' ' && *pFrames != ':' )
+                pFrames++;
+
+            S32 flags = 0;
+            if ( *pFrames == ':' )
+            {
+                flags = dAtoi( ++pFrames );
+                while( *pFrames != 0 && *pFrames != ' ' )
+                    pFrames++;
+            }
+
+            if ( frame >= 0 )
+                setTile( tileX, position.y, (U32)frame, (U16)flags );
+
+            tileX++;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+
+SpriteTileMap::Chunk* SpriteTileMap::findChunk( const S32 tileX, const S32 tileY ) const
+{
+    // Fetch the chunk coordinates.
+    const S32 chunkX = getChunkCoordinate( tileX );
+    const S32 chunkY = getChunkCoordinate( tileY );
+
+    // Find the chunk.
+    typeChunkHash::const_iterator chunkItr = mChunks.find( getChunkKey( chunkX, chunkY ) );
+    if ( chunkItr == mChunks.end() )
+        return NULL;
+
+    // Sanity!
+    Chunk* pChunk = chunkItr->value;
+    AssertFatal( pChunk->mChunkX == chunkX && pChunk->mChunkY == chunkY, "SpriteTileMap::findChunk() - Chunk key does not match the chunk." );
+
+    // Never return a chunk that does not contain the tile.
+    return pChunk->mChunkX == chunkX && pChunk->mChunkY == chunkY ? pChunk : NULL;
+}
+
+//------------------------------------------------------------------------------
+
+SpriteTileMap::Chunk* SpriteTileMap::createChunk( const S32 chunkX, const S32 chunkY )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SpriteTileMap_CreateChunk);
+
+    // Create an empty chunk.
+    Chunk* pChunk = new Chunk();
+    pChunk->mChunkX = chunkX;
+    pChunk->mChunkY = chunkY;
+    for ( U32 n = 0; n < CHUNK_TILES; ++n )
+    {
+        pChunk->mTiles[n].mFrame = EMPTY_TILE;
+        pChunk->mTiles[n].mFlags = 0;
+    }
+    pChunk->mTileCount = 0;
+    pChunk->mQuadsDirty = true;
+    pChunk->mQuadCount = 0;
+    pChunk->mImageRevision = 0;
+    pChunk->mLastBatchTransformId = U32_MAX;
+    pChunk->mLastRenderFrame = 0;
+
+    // Create a single proxy for the whole chunk.
+    updateChunkAABB( pChunk );
+    pChunk->mProxyId = mChunkTree.CreateProxy( pChunk->mLocalAABB, pChunk );
+
+    mChunks.insert( getChunkKey( chunkX, chunkY ), pChunk );
+
+    return pChunk;
+}
+
+//------------------------------------------------------------------------------
+
+void SpriteTileMap::destroyChunk( Chunk* pChunk )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SpriteTileMap_DestroyChunk);
+
+    // Remove from the cached chunks.
+    for ( U32 n = 0; n < (U32)mCachedChunks.size(); ++n )
+    {
+        if ( mCachedChunks[n] == pChunk )
+        {
+            mCachedChunks.erase_fast( n );
+            break;
+        }
+    }
+
+    mChunkTree.DestroyProxy( pChunk->mProxyId );
+    mChunks.erase( getChunkKey( pChunk->mChunkX, pChunk->mChunkY ) );
+
+    delete pChunk;
+}
+
+//------------------------------------------------------------------------------
+
+Vector2 SpriteTileMap::getTilePosition( const S32 tileX, const S32 tileY ) const
+{
+    // Isometric layout?
+    if ( mIsometric )
+        return Vector2( (tileX * mTileStride.x) + (tileY * mTileStride.x), (tileX * mTileStride.y) + (tileY * -mTileStride.y) );
+
+    // No, so rectilinear layout.
+    return Vector2( tileX * mTileStride.x, tileY * mTileStride.y );
+}
+
+//------------------------------------------------------------------------------
+
+void SpriteTileMap::updateChunkAABB( Chunk* pChunk )
+{
+    // Fetch the chunk corner tiles.
+    const S32 lowerX = pChunk->mChunkX * CHUNK_SIZE;
+    const S32 lowerY = pChunk->mChunkY * CHUNK_SIZE;
+    const S32 upperX = lowerX + CHUNK_SIZE - 1;
+    const S32 upperY = lowerY + CHUNK_SIZE - 1;
+
+    Vector2 corners[4];
+    corners[0] = getTilePosition( lowerX, lowerY );
+    corners[1] = getTilePosition( upperX, lowerY );
+    corners[2] = getTilePosition( upperX, upperY );
+    corners[3] = getTilePosition( lowerX, upperY );
+
+    // Calculate the chunk bounds including the tile extents.
+    b2AABB chunkAABB;
+    CoreMath::mOOBBtoAABB( corners, chunkAABB );
+    chunkAABB.lowerBound += mTileLocalAABB.lowerBound;
+    chunkAABB.upperBound += mTileLocalAABB.upperBound;
+
+    pChunk->mLocalAABB = chunkAABB;
+}
+
+//------------------------------------------------------------------------------
+
+void SpriteTileMap::buildChunkQuads( Chunk* pChunk )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SpriteTileMap_BuildChunkQuads);
+
+    // Add to the cached chunks if not already.
+    if ( pChunk->mLocalVertices.size() == 0 )
+        mCachedChunks.push_back( pChunk );
+
+    pChunk->mLocalVertices.setSize( pChunk->mTileCount * 4 );
+    pChunk->mRenderVertices.setSize( pChunk->mTileCount * 4 );
+    pChunk->mTexels.setSize( pChunk->mTileCount * 4 );
+
+    Vector2* pLocalVertex = pChunk->mLocalVertices.address();
+    Vector2* pTexel = pChunk->mTexels.address();
+    U32 quadCount = 0;
+
+    const S32 originX = pChunk->mChunkX * CHUNK_SIZE;
+    const S32 originY = pChunk->mChunkY * CHUNK_SIZE;
+    for ( S32 y = 0; y < CHUNK_SIZE; ++y )
+    {
+        for ( S32 x = 0; x < CHUNK_SIZE; ++x )
+        {
+            const Tile& tile = pChunk->mTiles[(y * CHUNK_SIZE) + x];
+
+            // Skip empty tiles.
+            if ( tile.mFrame == EMPTY_TILE )
+                continue;
+
+            // Calculate the tile vertices.
+            const Vector2 position = getTilePosition( originX + x, originY + y );
+            pLocalVertex[0] = position + mTileLocalOOBB[0];
+            pLocalVertex[1] = position + mTileLocalOOBB[1];
+            pLocalVertex[2] = position + mTileLocalOOBB[2];
+            pLocalVertex[3] = position + mTileLocalOOBB[3];
+
+            // Fetch the texel area.
+            ImageAsset::FrameArea::TexelArea texelArea = mImageAsset->getImageFrameArea( tile.mFrame ).mTexelArea;
+            texelArea.setFlip( (tile.mFlags & TILE_FLIP_X) != 0, (tile.mFlags & TILE_FLIP_Y) != 0 );
+            const Vector2& texLower = texelArea.mTexelLower;
+            const Vector2& texUpper = texelArea.mTexelUpper;
+            pTexel[0].Set( texLower.x, texUpper.y );
+            pTexel[1].Set( texUpper.x, texUpper.y );
+            pTexel[2].Set( texUpper.x, texLower.y );
+            pTexel[3].Set( texLower.x, texLower.y );
+
+            pLocalVertex += 4;
+            pTexel += 4;
+            quadCount++;
+        }
+    }
+
+    pChunk->mQuadCount = quadCount;
+    pChunk->mQuadsDirty = false;
+    pChunk->mImageRevision = mImageAsset->getImageRevision();
+
+    // Force the render vertices to be transformed.
+    pChunk->mLastBatchTransformId = U32_MAX;
+}
+
+//------------------------------------------------------------------------------
+
+void SpriteTileMap::releaseChunkQuads( Chunk* pChunk )
+{
+    pChunk->mLocalVertices.clear();
+    pChunk->mLocalVertices.compact();
+    pChunk->mRenderVertices.clear();
+    pChunk->mRenderVertices.compact();
+    pChunk->mTexels.clear();
+    pChunk->mTexels.compact();
+    pChunk->mQuadCount = 0;
+    pChunk->mQuadsDirty = true;
+}
+
+//------------------------------------------------------------------------------
+
+static S32 QSORT_CALLBACK cachedChunkSort( const void* a, const void* b )
+{
+    // Most recently rendered first.
+    const U32 frameA = (*((SpriteTileMap::Chunk**)a))->mLastRenderFrame;
+    const U32 frameB = (*((SpriteTileMap::Chunk**)b))->mLastRenderFrame;
+    return frameA < frameB ? 1 : frameA > frameB ? -1 : 0;
+}
+
+//------------------------------------------------------------------------------
+
+void SpriteTileMap::trimCachedChunks( void )
+{
+    // Finish if within the cache limit.
+    if ( (U32)mCachedChunks.size() <= MAX_CACHED_CHUNKS )
+        return;
+
+    // Debug Profiling.
+    PROFILE_SCOPE(SpriteTileMap_TrimCachedChunks);
+
+    // Sort the cached chunks by when they were last rendered.
+    dQsort( mCachedChunks.address(), mCachedChunks.size(), sizeof(Chunk*), cachedChunkSort );
+
+    // Release the oldest chunks but never the ones about to be rendered.
+    while( (U32)mCachedChunks.size() > MAX_CACHED_CHUNKS )
+    {
+        Chunk* pChunk = mCachedChunks.last();
+        if ( pChunk->mLastRenderFrame == mRenderFrame )
+            break;
+
+        releaseChunkQuads( pChunk );
+        mCachedChunks.pop_back();
+    }
+}
@@ -0,0 +1,174 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _SPRITE_TILE_MAP_H_
+#define _SPRITE_TILE_MAP_H_
+
+#ifndef _IMAGE_ASSET_H_
+#include "2d/assets/ImageAsset.h"
+#endif
+
+#ifndef _ASSET_PTR_H_
+#include "assets/assetPtr.h"
+#endif
+
+#ifndef _HASHTABLE_H_
+#include "collection/hashTable.h"
+#endif
+
+#ifndef _TAML_CUSTOM_H_
+#include "persistence/taml/tamlCustom.h"
+#endif
+
+#ifndef BOX2D_H
+#include "Box2D/Box2D.h"
+#endif
+
+//------------------------------------------------------------------------------
+
+class BatchRender;
+
+//------------------------------------------------------------------------------
+
+/// A chunked tile store used by composite sprites for large tile worlds.
+/// Tiles are compact records grouped into fixed-size chunks.  Each chunk
+/// has a single query proxy and caches its quads, which are only rebuilt
+/// when one of its tiles changes.
+class SpriteTileMap
+{
+public:
+    /// Tiles along each side of a chunk.
+    static const S32 CHUNK_SIZE = 32;
+    static const U32 CHUNK_TILES = CHUNK_SIZE * CHUNK_SIZE;
+
+    /// Maximum chunks whose quads stay cached.
+    static const U32 MAX_CACHED_CHUNKS = 256;
+
+    static const U16 EMPTY_TILE = 0xFFFF;
+
+    enum TileFlags
+    {
+        TILE_FLIP_X = BIT(0),
+        TILE_FLIP_Y = BIT(1),
+    };
+
+    struct Tile
+    {
+        U16 mFrame;
+        U16 mFlags;
+    };
+
+    struct Chunk
+    {
+        S32             mChunkX;
+        S32             mChunkY;
+        Tile            mTiles[CHUNK_TILES];
+        U32             mTileCount;
+        S32             mProxyId;
+        b2AABB          mLocalAABB;
+
+        /// Cached quads.
+        bool            mQuadsDirty;
+        U32             mImageRevision;
+        U32             mQuadCount;
+        U32             mLastBatchTransformId;
+        U32             mLastRenderFrame;
+        Vector<Vector2> mLocalVertices;
+        Vector<Vector2> mRenderVertices;
+        Vector<Vector2> mTexels;
+    };
+
+    typedef Vector<Chunk*> typeChunkVector;
+
+private:
+    typedef HashMap<U64, Chunk*> typeChunkHash;
+
+    AssetPtr<ImageAsset>    mImageAsset;
+    typeChunkHash           mChunks;
+    b2DynamicTree           mChunkTree;
+    U32                     mTileCount;
+
+    /// Layout.
+    bool                    mIsometric;
+    Vector2                 mTileStride;
+    Vector2                 mTileSize;
+    F32                     mTileAngle;
+    Vector2                 mTileLocalOOBB[4];
+    b2AABB                  mTileLocalAABB;
+
+    b2AABB                  mLocalAABB;
+    bool                    mLocalAABBDirty;
+
+    U32                     mRenderFrame;
+    typeChunkVector         mCachedChunks;
+    typeChunkVector*        mpQueryResults;
+
+public:
+    SpriteTileMap();
+    virtual ~SpriteTileMap();
+
+    void setImage( const char* pAssetId );
+    inline StringTableEntry getImage( void ) const { return mImageAsset.getAssetId(); }
+
+    void setLayout( const bool isometric, const Vector2& tileStride, const Vector2& tileSize, const F32 tileAngle );
+
+    bool setTile( const S32 tileX, const S32 tileY, const U32 frame, const U16 flags );
+    bool getTile( const S32 tileX, const S32 tileY, Tile& tile ) const;
+    bool clearTile( const S32 tileX, const S32 tileY );
+    void clearTiles( void );
+    inline U32 getTileCount( void ) const { return mTileCount; }
+    inline U32 getChunkCount( void ) const { return (U32)mChunks.size(); }
+
+    const b2AABB& getLocalAABB( void );
+    inline bool getLocalAABBDirty( void ) const { return mLocalAABBDirty; }
+
+    /// Rendering.
+    void queryChunks( const b2AABB& localAABB, typeChunkVector& chunks );
+    void renderChunk( Chunk* pChunk, const b2Transform& batchTransform, const U32 batchTransformId, BatchRender* pBatchRenderer );
+    Vector2 getChunkCenter( const Chunk* pChunk ) const { return pChunk->mLocalAABB.GetCenter(); }
+
+    /// Tree callback.
+    bool QueryCallback( S32 proxyId );
+
+    void copyTo( SpriteTileMap* pSpriteTileMap ) const;
+
+    void onTamlCustomWrite( TamlCustomNodes& customNodes );
+    void onTamlCustomRead( const TamlCustomNodes& customNodes );
+
+private:
+    /// Unique key for a chunk.  The low word mixes both coordinates as only it is hashed.
+    static inline U64 getChunkKey( const S32 chunkX, const S32 chunkY ) { return ((U64)(U32)chunkX << 32) | (U64)((U32)chunkY ^ ((U32)chunkX * 0x9E3779B9)); }
+    static inline S32 getChunkCoordinate( const S32 tileCoordinate ) { return tileCoordinate >= 0 ? tileCoordinate / CHUNK_SIZE : ((tileCoordinate + 1) / CHUNK_SIZE) - 1; }
+
+    Chunk* findChunk( const S32 tileX, const S32 tileY ) const;
+    Chunk* createChunk( const S32 chunkX, const S32 chunkY );
+    void destroyChunk( Chunk* pChunk );
+
+    Vector2 getTilePosition( const S32 tileX, const S32 tileY ) const;
+    void updateChunkAABB( Chunk* pChunk );
+    void buildChunkQuads( Chunk* pChunk );
+    void releaseChunkQuads( Chunk* pChunk );
+    void trimCachedChunks( void );
+};
+
+#endif // _SPRITE_TILE_MAP_H_
@@ -115,6 +115,9 @@ SceneWindow::SceneWindow() :    mpScene(NULL),
                                 mInputEventGroupMaskFilter(MASK_ALL),
                                 mInputEventLayerMaskFilter(MASK_ALL),
                                 mInputEventInvisibleFilter( true ),
+                                mInputPickGridSize(0),
+                                mInputPickIndexValid(false),
+                                mInputPickResultsValid(false),
                                 mProcessAudioListener(false),
 								mShowScrollBar(false),
 								mMouseWheelScrolls(false)
@@ -124,6 +127,11 @@ SceneWindow::SceneWindow() :    mpScene(NULL),
     VECTOR_SET_ASSOCIATION( mInputEventQuery );
     VECTOR_SET_ASSOCIATION( mInputEventEntering );
     VECTOR_SET_ASSOCIATION( mInputEventLeaving );    
+    VECTOR_SET_ASSOCIATION( mInputPickRenderResults );
+    VECTOR_SET_ASSOCIATION( mInputPickCandidates );
+    VECTOR_SET_ASSOCIATION( mInputPickCellStart );
+    VECTOR_SET_ASSOCIATION( mInputPickCellItems );
+    VECTOR_SET_ASSOCIATION( mInputPickResults );
 
     // Turn-on Tick Processing.
     setProcessTicks( true );
@@ -368,6 +376,9 @@ void SceneWindow::resetScene( void )
     // Clear input event watched objects.
     mInputEventWatching.clear();
 
+    // Invalidate the input picking cache.
+    invalidateInputPick();
+
     // Reset scene.
     mpScene = NULL;
 }
@@ -1264,24 +1275,13 @@ void SceneWindow::sendObjectInputEvent( StringTableEntry name, const GuiEvent& e
     // Fetch old pick count.
     const U32 oldPickCount = (U32)mInputEventWatching.size();
 
-    // Fetch world query and clear results.
-    WorldQuery* pWorldQuery = getScene()->getWorldQuery( true );
-
-    // Set filter.
-    WorldQueryFilter queryFilter( mInputEventLayerMaskFilter, mInputEventGroupMaskFilter, true, mInputEventInvisibleFilter, true, true );
-    pWorldQuery->setQueryFilter( queryFilter );
-
-    // Perform world query.
-    const U32 newPickCount = pWorldQuery->anyQueryPoint( worldMousePoint );
+    // Pick objects.
+    const U32 newPickCount = pickInputEventObjects( worldMousePoint );
 
     // Early-out if nothing to do.
     if ( newPickCount == 0 && oldPickCount == 0 )
         return;
 
-    // Fetch results.
-    mInputEventQuery = pWorldQuery->getQueryResults();
-    pWorldQuery->clearQuery();
-
     // Determine "enter" events.
     for( U32 newIndex = 0; newIndex < newPickCount; ++newIndex )
     {
@@ -1391,6 +1391,276 @@ void SceneWindow::sendObjectInputEvent( StringTableEntry name, const GuiEvent& e
 
 //-----------------------------------------------------------------------------
 
+static inline bool getInputPickCellRange( const b2AABB& aabb, const b2AABB& bounds, const Vector2& cellScale, const S32 gridSize, S32& minX, S32& minY, S32& maxX, S32& maxY )
+{
+    // Finish if outside the bounds.
+    if ( aabb.upperBound.x < bounds.lowerBound.x || aabb.upperBound.y < bounds.lowerBound.y ||
+         aabb.lowerBound.x > bounds.upperBound.x || aabb.lowerBound.y > bounds.upperBound.y )
+        return false;
+
+    // Calculate the covered cells.
+    minX = mClamp( (S32)mFloor( (aabb.lowerBound.x - bounds.lowerBound.x) * cellScale.x ), 0, gridSize-1 );
+    minY = mClamp( (S32)mFloor( (aabb.lowerBound.y - bounds.lowerBound.y) * cellScale.y ), 0, gridSize-1 );
+    maxX = mClamp( (S32)mFloor( (aabb.upperBound.x - bounds.lowerBound.x) * cellScale.x ), 0, gridSize-1 );
+    maxY = mClamp( (S32)mFloor( (aabb.upperBound.y - bounds.lowerBound.y) * cellScale.y ), 0, gridSize-1 );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneWindow::buildInputPickIndex( const b2AABB& renderAABB )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneWindow_BuildInputPickIndex);
+
+    // Invalidate the index.
+    mInputPickIndexValid = false;
+    mInputPickCandidates.clear();
+    mInputPickCellItems.clear();
+
+    // Finish if we're not bound to a scene.
+    if ( !getScene() )
+    {
+        mInputPickRenderResults.clear();
+        return;
+    }
+
+    // Fetch the render area extent.
+    const Vector2 extent = renderAABB.upperBound - renderAABB.lowerBound;
+
+    // Finish if the render area is empty.
+    if ( extent.x <= 0.0f || extent.y <= 0.0f )
+    {
+        mInputPickRenderResults.clear();
+        return;
+    }
+
+    // Fetch the candidates from the render query results.
+    const U32 resultCount = mInputPickRenderResults.size();
+    mInputPickCandidates.reserve( resultCount );
+    for ( U32 index = 0; index < resultCount; ++index )
+    {
+        mInputPickCandidates.push_back( mInputPickRenderResults[index].mpSceneObject );
+    }
+    mInputPickRenderResults.clear();
+
+    // Size the grid for roughly four candidates per cell.
+    const S32 gridSize = mClamp( (S32)mSqrt( (F32)resultCount * 0.25f ), 1, 64 );
+    const U32 cellCount = (U32)(gridSize * gridSize);
+    mInputPickGridSize = (U32)gridSize;
+    mInputPickBounds = renderAABB;
+    mInputPickCellScale.Set( (F32)gridSize / extent.x, (F32)gridSize / extent.y );
+
+    // Count the candidates in each cell.
+    mInputPickCellStart.setSize( cellCount + 1 );
+    dMemset( mInputPickCellStart.address(), 0, mInputPickCellStart.memSize() );
+    U32 itemCount = 0;
+    S32 minX, minY, maxX, maxY;
+    for ( U32 index = 0; index < resultCount; ++index )
+    {
+        if ( !getInputPickCellRange( mInputPickCandidates[index]->getAABB(), mInputPickBounds, mInputPickCellScale, gridSize, minX, minY, maxX, maxY ) )
+            continue;
+
+        for ( S32 y = minY; y <= maxY; ++y )
+        {
+            for ( S32 x = minX; x <= maxX; ++x )
+            {
+                mInputPickCellStart[y * gridSize + x]++;
+                itemCount++;
+            }
+        }
+    }
+
+    // Convert the counts into cell offsets.
+    U32 offset = 0;
+    for ( U32 cell = 0; cell < cellCount; ++cell )
+    {
+        const U32 count = mInputPickCellStart[cell];
+        mInputPickCellStart[cell] = offset;
+        offset += count;
+    }
+    mInputPickCellStart[cellCount] = offset;
+
+    // Fill the cells, keeping the render query order within each cell.
+    mInputPickCellItems.setSize( itemCount );
+    for ( U32 index = 0; index < resultCount; ++index )
+    {
+        if ( !getInputPickCellRange( mInputPickCandidates[index]->getAABB(), mInputPickBounds, mInputPickCellScale, gridSize, minX, minY, maxX, maxY ) )
+            continue;
+
+        for ( S32 y = minY; y <= maxY; ++y )
+        {
+            for ( S32 x = minX; x <= maxX; ++x )
+            {
+                mInputPickCellItems[mInputPickCellStart[y * gridSize + x]++] = index;
+            }
+        }
+    }
+
+    // Restore the cell offsets.
+    for ( U32 cell = cellCount; cell > 0; --cell )
+    {
+        mInputPickCellStart[cell] = mInputPickCellStart[cell-1];
+    }
+    mInputPickCellStart[0] = 0;
+
+    // Flag the index as valid for the current proxies and render masks.
+    mInputPickIndexLayerMask = mRenderLayerMask;
+    mInputPickIndexGroupMask = mRenderGroupMask;
+    mInputPickIndexRevision = getScene()->getWorldQuery()->getProxyRevision();
+    mInputPickIndexValid = true;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 SceneWindow::pickInputEventObjects( const Vector2& worldPoint )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneWindow_PickInputEventObjects);
+
+    // Fetch world query and clear results.
+    WorldQuery* pWorldQuery = getScene()->getWorldQuery( true );
+
+    // Fetch the proxy revision.
+    const U32 proxyRevision = pWorldQuery->getProxyRevision();
+
+    // Reuse the last pick if nothing has moved since and the pick is identical.
+    if (    mInputPickResultsValid &&
+            mInputPickRevision == proxyRevision &&
+            mInputPickPoint.x == worldPoint.x &&
+            mInputPickPoint.y == worldPoint.y &&
+            mInputPickLayerMask == mInputEventLayerMaskFilter &&
+            mInputPickGroupMask == mInputEventGroupMaskFilter &&
+            mInputPickInvisible == mInputEventInvisibleFilter )
+    {
+        // Debug Profiling.
+        PROFILE_SCOPE(SceneWindow_PickInputEventObjectsCached);
+
+        mInputEventQuery.clear();
+
+        for ( U32 index = 0; index < (U32)mInputPickResults.size(); ++index )
+        {
+            // Fetch scene object.
+            SceneObject* pSceneObject = mInputPickResults[index].mpSceneObject;
+
+            // Skip if the object is no longer pickable.
+            if ( !pSceneObject->isEnabled() ||
+                 ( mInputEventInvisibleFilter && !pSceneObject->getVisible() ) ||
+                 !pSceneObject->getPickingAllowed() ||
+                 (mInputEventLayerMaskFilter & pSceneObject->getSceneLayerMask()) == 0 ||
+                 (mInputEventGroupMaskFilter & pSceneObject->getSceneGroupMask()) == 0 )
+                continue;
+
+            mInputEventQuery.push_back( mInputPickResults[index] );
+        }
+
+        return mInputEventQuery.size();
+    }
+
+    // Set filter.
+    WorldQueryFilter queryFilter( mInputEventLayerMaskFilter, mInputEventGroupMaskFilter, true, mInputEventInvisibleFilter, true, true );
+    pWorldQuery->setQueryFilter( queryFilter );
+
+    // Can we use the render index?
+    // NOTE:-   The render query only found visible objects within the render masks so the
+    //          index can only stand in for the OOBB query when the input filter is no wider.
+    if (    mInputPickIndexValid &&
+            mInputPickIndexRevision == proxyRevision &&
+            mInputEventInvisibleFilter &&
+            (mInputEventLayerMaskFilter & ~mInputPickIndexLayerMask) == 0 &&
+            (mInputEventGroupMaskFilter & ~mInputPickIndexGroupMask) == 0 &&
+            worldPoint.x >= mInputPickBounds.lowerBound.x && worldPoint.x <= mInputPickBounds.upperBound.x &&
+            worldPoint.y >= mInputPickBounds.lowerBound.y && worldPoint.y <= mInputPickBounds.upperBound.y )
+    {
+        // Debug Profiling.
+        PROFILE_SCOPE(SceneWindow_PickInputEventObjectsIndexed);
+
+        mInputEventQuery.clear();
+
+        // Fetch the cell.
+        const S32 gridSize = (S32)mInputPickGridSize;
+        const S32 cellX = mClamp( (S32)mFloor( (worldPoint.x - mInputPickBounds.lowerBound.x) * mInputPickCellScale.x ), 0, gridSize-1 );
+        const S32 cellY = mClamp( (S32)mFloor( (worldPoint.y - mInputPickBounds.lowerBound.y) * mInputPickCellScale.y ), 0, gridSize-1 );
+        const U32 cell = (U32)(cellY * gridSize + cellX);
+
+        b2Transform identityTransform;
+        identityTransform.SetIdentity();
+
+        // Check the candidates OOBB.
+        for ( U32 item = mInputPickCellStart[cell]; item < mInputPickCellStart[cell+1]; ++item )
+        {
+            // Fetch scene object.
+            SceneObject* pSceneObject = mInputPickCandidates[mInputPickCellItems[item]];
+
+            // Skip if not pickable.
+            if ( !pSceneObject->isEnabled() ||
+                 !pSceneObject->getVisible() ||
+                 pSceneObject->getSize().isXZero() ||
+                 pSceneObject->getSize().isYZero() ||
+                 !pSceneObject->getPickingAllowed() ||
+                 (mInputEventLayerMaskFilter & pSceneObject->getSceneLayerMask()) == 0 ||
+                 (mInputEventGroupMaskFilter & pSceneObject->getSceneGroupMask()) == 0 )
+                continue;
+
+            // Check point.
+            b2PolygonShape oobb;
+            oobb.Set( pSceneObject->getRenderOOBB(), 4 );
+            if ( !oobb.TestPoint( identityTransform, worldPoint ) )
+                continue;
+
+            mInputEventQuery.push_back( WorldQueryResult( pSceneObject ) );
+        }
+
+        // Check the collision shapes.
+        pWorldQuery->collisionQueryPoint( worldPoint );
+        typeWorldQueryResultVector& collisionResults = pWorldQuery->getQueryResults();
+        const U32 oobbPickCount = mInputEventQuery.size();
+        for ( U32 index = 0; index < (U32)collisionResults.size(); ++index )
+        {
+            // Fetch scene object.
+            SceneObject* pSceneObject = collisionResults[index].mpSceneObject;
+
+            // Skip if already picked.
+            bool alreadyPicked = false;
+            for ( U32 pickIndex = 0; pickIndex < oobbPickCount; ++pickIndex )
+            {
+                if ( mInputEventQuery[pickIndex].mpSceneObject != pSceneObject )
+                    continue;
+
+                alreadyPicked = true;
+                break;
+            }
+
+            if ( !alreadyPicked )
+                mInputEventQuery.push_back( collisionResults[index] );
+        }
+    }
+    else
+    {
+        // Perform world query.
+        pWorldQuery->anyQueryPoint( worldPoint );
+
+        // Fetch results.
+        mInputEventQuery = pWorldQuery->getQueryResults();
+    }
+
+    pWorldQuery->clearQuery();
+
+    // Cache the pick.
+    mInputPickResults = mInputEventQuery;
+    mInputPickPoint = worldPoint;
+    mInputPickLayerMask = mInputEventLayerMaskFilter;
+    mInputPickGroupMask = mInputEventGroupMaskFilter;
+    mInputPickInvisible = mInputEventInvisibleFilter;
+    mInputPickRevision = proxyRevision;
+    mInputPickResultsValid = true;
+
+    return mInputEventQuery.size();
+}
+
+//-----------------------------------------------------------------------------
+
 void SceneWindow::onTouchEnter( const GuiEvent& event )
 {
     // Dispatch input event.
@@ -1943,6 +2213,9 @@ void SceneWindow::onRender( Point2I offset, const RectI& updateRect )
         sceneMax += mCameraShakeOffset;
     }
 
+    // The scene renders in world coordinates so draw any batched gui first.
+    dglSuspendBatch();
+
     // Setup new logical coordinate system.
     glMatrixMode(GL_PROJECTION);
     glPushMatrix();
@@ -1974,6 +2247,10 @@ void SceneWindow::onRender( Point2I offset, const RectI& updateRect )
         &debugStats,
         this );
 
+    // Capture the render query results for input picking.
+    if ( mUseObjectInputEvents )
+        sceneRenderState.mpRenderResults = &mInputPickRenderResults;
+
     // Clear the background color if requested.
     if ( mUseBackgroundColor )
     {
@@ -1993,6 +2270,14 @@ void SceneWindow::onRender( Point2I offset, const RectI& updateRect )
     // Render View.
     pScene->sceneRender( &sceneRenderState );
 
+    // Build the input picking index from the render query results.
+    if ( mUseObjectInputEvents )
+    {
+        b2AABB cameraAABB;
+        CoreMath::mRotateAABB( sceneRenderState.mRenderAABB, sceneRenderState.mRenderAngle, cameraAABB );
+        buildInputPickIndex( cameraAABB );
+    }
+
     // Restore Matrices.
     glMatrixMode(GL_MODELVIEW);
     glPopMatrix();
@@ -2000,6 +2285,8 @@ void SceneWindow::onRender( Point2I offset, const RectI& updateRect )
     glPopMatrix();
     glMatrixMode(GL_MODELVIEW);
 
+    dglResumeBatch();
+
     // Render the metrics.
     renderMetricsOverlay( offset, updateRect );
 
@@ -2047,6 +2334,9 @@ void SceneWindow::renderMetricsOverlay( Point2I offset, const RectI& updateRect
     // Fetch the font.
     GFont* font = mProfile->getFont(mFontSizeAdjust);
 
+    // Draw any batched gui before the banner.
+    dglFlushBatch();
+
     // Blending for banner background.
     glEnable        ( GL_BLEND );
     glBlendFunc     ( GL_SRC_ALPHA , GL_ONE_MINUS_SRC_ALPHA );
@@ -2066,7 +2356,7 @@ void SceneWindow::renderMetricsOverlay( Point2I offset, const RectI& updateRect
     const S32 metricsOffset = (S32)font->getStrWidth( "WWWWWWWWWWWW" );
 
     // Set Banner Height.
-    F32 bannerLineHeight = fullMetrics ? 17.0f : 1.0f;
+    F32 bannerLineHeight = fullMetrics ? 19.0f : 1.0f;
 
     // Add an extra line if we're monitoring a scene object.
     if ( pDebugSceneObject != NULL )
@@ -2190,6 +2480,16 @@ void SceneWindow::renderMetricsOverlay( Point2I offset, const RectI& updateRect
         dglDrawText( font, bannerOffset + Point2I(metricsOffset,(S32)linePositionY), mDebugText, NULL );
         linePositionY += linePositionOffsetY;
 
+        // Debug Draw.
+        dSprintf( mDebugText, sizeof( mDebugText ), "- DebugDraw: Lines=%d<%d>, Tris=%d<%d>, DrawCalls=%d<%d>, Time=%0.2f<%0.2f>",
+            debugStats.debugDrawLines, debugStats.maxDebugDrawLines,
+            debugStats.debugDrawTriangles, debugStats.maxDebugDrawTriangles,
+            debugStats.debugDrawCalls, debugStats.maxDebugDrawCalls,
+            debugStats.debugDrawTime, debugStats.maxDebugDrawTime
+            );
+        dglDrawText( font, bannerOffset + Point2I(metricsOffset,(S32)linePositionY), mDebugText, NULL );
+        linePositionY += linePositionOffsetY;
+
         // Textures.
         dglDrawText( font, bannerOffset + Point2I(0,(S32)linePositionY), "Textures", NULL );
         dSprintf( mDebugText, sizeof( mDebugText ), "- TextureCount=%d, TextureSize=%d, TextureWaste=%d, BitmapSize=%d",
@@ -2233,25 +2533,42 @@ void SceneWindow::renderMetricsOverlay( Point2I offset, const RectI& updateRect
         dglDrawText( font, bannerOffset + Point2I(metricsOffset,(S32)linePositionY), mDebugText, NULL );
         linePositionY += linePositionOffsetY;
 
-        // Physics spatial tree.
+        // Tick stages.
+        dSprintf( mDebugText, sizeof( mDebugText ), "- Tick=%0.2f<%0.2f>, PreInt=%0.2f, Ctrl=%0.2f, Phys=%0.2f(x%d), Int=%0.2f, PostInt=%0.2f, Script=%0.2f, Deferred=%d, Dropped=%d",
+            debugStats.tickTotal, debugStats.maxTickTotal,
+            debugStats.tickPreIntegrate,
+            debugStats.tickControllers,
+            debugStats.tickPhysics, pScene->getPhysicsSubSteps(),
+            debugStats.tickIntegrate,
+            debugStats.tickPostIntegrate,
+            debugStats.tickCallbacks,
+            debugStats.tickLODDeferred,
+            debugStats.ticksDropped );
+        dglDrawText( font, bannerOffset + Point2I(metricsOffset,(S32)linePositionY), mDebugText, NULL );
+        linePositionY += linePositionOffsetY;
+
+        // Scene and physics spatial trees.
         dglDrawText( font, bannerOffset + Point2I(0,(S32)linePositionY), "Partition", NULL );
-        const b2World* pWorld = pScene->getWorld();
-        const S32 treeBalance = pWorld->GetTreeBalance();
-        const S32 treeHeight = pWorld->GetTreeHeight();
-        const F32 treeQuality = pWorld->GetTreeQuality();
-        dSprintf( mDebugText, sizeof( mDebugText ), "- Balance=%d, Height=%d, Quality=%0.2f",
-            treeBalance,
-            treeHeight,
-            treeQuality );
+        dSprintf( mDebugText, sizeof( mDebugText ), "- Scene: Balance=%d, Height=%d, Quality=%0.2f, Rebuilds=%d - World: Balance=%d, Height=%d, Quality=%0.2f, Rebuilds=%d",
+            debugStats.sceneTreeBalance,
+            debugStats.sceneTreeHeight,
+            debugStats.sceneTreeQuality,
+            debugStats.sceneTreeRebuilds,
+            debugStats.worldTreeBalance,
+            debugStats.worldTreeHeight,
+            debugStats.worldTreeQuality,
+            debugStats.worldTreeRebuilds );
         dglDrawText( font, bannerOffset + Point2I(metricsOffset,(S32)linePositionY), mDebugText, NULL );
         linePositionY += linePositionOffsetY;
 
         // Particles.
         dglDrawText( font, bannerOffset + Point2I(0,(S32)linePositionY), "Particles", NULL );
-        dSprintf( mDebugText, sizeof( mDebugText ), "- Allocated=%d, Used=%d<%d>, Free=%d",
+        dSprintf( mDebugText, sizeof( mDebugText ), "- Allocated=%d, Used=%d<%d>, Free=%d, Fluid=%d<%d>, FluidGroups=%d",
             debugStats.particlesAlloc,
             debugStats.particlesUsed, debugStats.maxParticlesUsed,
-            debugStats.particlesFree );
+            debugStats.particlesFree,
+            debugStats.fluidParticles, debugStats.maxFluidParticles,
+            debugStats.fluidGroups );
         dglDrawText( font, bannerOffset + Point2I(metricsOffset,(S32)linePositionY), mDebugText, NULL );
         linePositionY += linePositionOffsetY;
 
@@ -148,6 +148,26 @@ private:
     SimSet              mInputEventWatching;
     SimSet              mInputListeners;
 
+    /// Input picking cache.
+    typeWorldQueryResultVector mInputPickRenderResults;
+    typeSceneObjectVector mInputPickCandidates;
+    Vector<U32>         mInputPickCellStart;
+    Vector<U32>         mInputPickCellItems;
+    b2AABB              mInputPickBounds;
+    Vector2             mInputPickCellScale;
+    U32                 mInputPickGridSize;
+    U32                 mInputPickIndexLayerMask;
+    U32                 mInputPickIndexGroupMask;
+    U32                 mInputPickIndexRevision;
+    bool                mInputPickIndexValid;
+    typeWorldQueryResultVector mInputPickResults;
+    Vector2             mInputPickPoint;
+    U32                 mInputPickLayerMask;
+    U32                 mInputPickGroupMask;
+    bool                mInputPickInvisible;
+    U32                 mInputPickRevision;
+    bool                mInputPickResultsValid;
+
     /// Render Masks.
     U32                 mRenderLayerMask;
     U32                 mRenderGroupMask;
@@ -162,6 +182,11 @@ private:
     void sendWindowInputEvent( StringTableEntry name, const GuiEvent& event );
     void sendObjectInputEvent( StringTableEntry, const GuiEvent& event );
 
+    /// Input picking.
+    void buildInputPickIndex( const b2AABB& renderAABB );
+    U32 pickInputEventObjects( const Vector2& worldPoint );
+    inline void invalidateInputPick( void ) { mInputPickIndexValid = false; mInputPickResultsValid = false; }
+
     void calculateCameraView( CameraView* pCameraView );
 
 	//Standard Scrolling settings
@@ -222,8 +247,8 @@ public:
     inline void setUseObjectInputEvents( const bool inputStatus ) { mUseObjectInputEvents = inputStatus; };
     inline bool getUseWindowInputEvents( void ) const { return mUseWindowInputEvents; };
     inline bool getUseObjectInputEvents( void ) const { return mUseObjectInputEvents; };
-    inline void clearWatchedInputEvents( void ) { mInputEventWatching.clear(); }
-    inline void removeFromInputEventPick(SceneObject* pSceneObject ) { mInputEventWatching.removeObject((SimObject*)pSceneObject); }
+    inline void clearWatchedInputEvents( void ) { mInputEventWatching.clear(); mInputPickResultsValid = false; }
+    inline void removeFromInputEventPick(SceneObject* pSceneObject ) { mInputEventWatching.removeObject((SimObject*)pSceneObject); invalidateInputPick(); }
 
     void addInputListener( SimObject* pSimObject );
     void removeInputListener( SimObject* pSimObject );
@@ -378,6 +378,9 @@ void GuiSceneObjectCtrl::onRender(Point2I offset, const RectI& updateRect)
       y1 *= -1;
       y2 *= -1;
 
+      // The object renders in world coordinates so draw any batched gui first.
+      dglSuspendBatch();
+
       // Setup new logical coordinate system.
       glMatrixMode(GL_PROJECTION);
       glPushMatrix();
@@ -449,6 +452,8 @@ void GuiSceneObjectCtrl::onRender(Point2I offset, const RectI& updateRect)
       glPopMatrix();
       glMatrixMode(GL_PROJECTION);
       glPopMatrix();
+
+      dglResumeBatch();
    }
    else
    {
@@ -666,6 +666,11 @@ RectI GuiSpriteCtrl::getSourceRect(TextureObject* texture)
 	{
 		const ImageAsset::FrameArea& frameArea = getProviderImageFrameArea();
 		srcRegion = RectI(frameArea.mPixelArea.mPixelOffset, Point2I(frameArea.mPixelArea.mPixelWidth, frameArea.mPixelArea.mPixelHeight));
+
+		// Address the atlas page if the image is packed.
+		const ImageAsset* pImageAsset = getProviderImage();
+		if (pImageAsset != NULL)
+			srcRegion.point += pImageAsset->getAtlasOffset();
 	}
 	else if (!hasAsset && mSingleFrameBitmap)
 	{
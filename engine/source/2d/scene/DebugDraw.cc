@@ -22,12 +22,103 @@
 
 #include "graphics/dgl.h"
 #include "2d/scene/DebugDraw.h"
+#include "2d/scene/DebugStats.h"
 
 // Debug Profiling.
 #include "debug/profiler.h"
 
 //-----------------------------------------------------------------------------
 
+static const U32 k_circleSegments = 16;
+static const U32 k_solidCircleSegments = 12;
+
+//-----------------------------------------------------------------------------
+
+DebugDraw::DebugDraw()
+{
+    VECTOR_SET_ASSOCIATION( mLineVertices );
+    VECTOR_SET_ASSOCIATION( mLineColors );
+    VECTOR_SET_ASSOCIATION( mTriangleVertices );
+    VECTOR_SET_ASSOCIATION( mTriangleColors );
+    VECTOR_SET_ASSOCIATION( mPointBatches );
+    VECTOR_SET_ASSOCIATION( mCircleVertices );
+}
+
+//-----------------------------------------------------------------------------
+
+void DebugDraw::Flush( DebugStats* pDebugStats )
+{
+    // Finish if nothing to draw.
+    if ( mLineVertices.size() == 0 && mTriangleVertices.size() == 0 && mPointBatches.size() == 0 )
+        return;
+
+    // Debug Profiling.
+    PROFILE_SCOPE(DebugDraw_Flush);
+
+    glDisable( GL_TEXTURE_2D );
+    glEnableClientState( GL_VERTEX_ARRAY );
+    glEnableClientState( GL_COLOR_ARRAY );
+
+    U32 drawCalls = 0;
+
+    // Fills first so that outlines stay on top.
+    if ( mTriangleVertices.size() > 0 )
+    {
+        glEnable( GL_BLEND );
+        glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
+        glVertexPointer( 2, GL_FLOAT, 0, mTriangleVertices.address() );
+        glColorPointer( 4, GL_FLOAT, 0, mTriangleColors.address() );
+        glDrawArrays( GL_TRIANGLES, 0, mTriangleVertices.size() );
+        glDisable( GL_BLEND );
+        drawCalls++;
+    }
+
+    // Lines.
+    if ( mLineVertices.size() > 0 )
+    {
+        glVertexPointer( 2, GL_FLOAT, 0, mLineVertices.address() );
+        glColorPointer( 4, GL_FLOAT, 0, mLineColors.address() );
+        glDrawArrays( GL_LINES, 0, mLineVertices.size() );
+        drawCalls++;
+    }
+
+    // Points, one draw per point size.
+    for ( S32 i = 0; i < mPointBatches.size(); ++i )
+    {
+        PointBatch& pointBatch = mPointBatches[i];
+        glPointSize( pointBatch.mSize );
+        glVertexPointer( 2, GL_FLOAT, 0, pointBatch.mVertices.address() );
+        glColorPointer( 4, GL_FLOAT, 0, pointBatch.mColors.address() );
+        glDrawArrays( GL_POINTS, 0, pointBatch.mVertices.size() );
+        drawCalls++;
+    }
+    glPointSize( 1.0f );
+
+    glDisableClientState( GL_COLOR_ARRAY );
+    glDisableClientState( GL_VERTEX_ARRAY );
+
+    // Update debug stats.
+    if ( pDebugStats != NULL )
+    {
+        pDebugStats->debugDrawLines += mLineVertices.size() / 2;
+        pDebugStats->debugDrawTriangles += mTriangleVertices.size() / 3;
+        pDebugStats->debugDrawCalls += drawCalls;
+    }
+
+    // Reset the buffers, keeping their storage for the next frame.
+    mLineVertices.clear();
+    mLineColors.clear();
+    mTriangleVertices.clear();
+    mTriangleColors.clear();
+    for ( S32 i = 0; i < mPointBatches.size(); ++i )
+    {
+        mPointBatches[i].mVertices.clear();
+        mPointBatches[i].mColors.clear();
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 void DebugDraw::DrawAABB( const b2AABB& aabb, const ColorF& color )
 {
     // Debug Profiling.
@@ -264,13 +355,7 @@ void DebugDraw::DrawPolygon( const b2Vec2* vertices, int32 vertexCount, const Co
     // Debug Profiling.
     PROFILE_SCOPE(DebugDraw_DrawPolygon);
 
-    glColor3f(color.red, color.green, color.blue);
-    glBegin(GL_LINE_LOOP);
-    for (int32 i = 0; i < vertexCount; ++i)
-    {
-        glVertex2f(vertices[i].x, vertices[i].y);
-    }
-    glEnd();
+    submitLineLoop( vertices, vertexCount, ColorF( color.red, color.green, color.blue, 1.0f ) );
 }
 
 //-----------------------------------------------------------------------------
@@ -280,24 +365,8 @@ void DebugDraw::DrawSolidPolygon( const b2Vec2* vertices, int32 vertexCount, con
     // Debug Profiling.
     PROFILE_SCOPE(DebugDraw_DrawSolidPolygon);
 
-    glEnable(GL_BLEND);
-    glBlendFunc (GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glColor4f(0.5f * color.red, 0.5f * color.green, 0.5f * color.blue, 0.15f);
-    glBegin(GL_TRIANGLE_FAN);
-    for (int32 i = 0; i < vertexCount; ++i)
-    {
-        glVertex2f(vertices[i].x, vertices[i].y);
-    }
-    glEnd();
-    glDisable(GL_BLEND);
-
-    glColor4f(color.red, color.green, color.blue, 1.0f);
-    glBegin(GL_LINE_LOOP);
-    for (int32 i = 0; i < vertexCount; ++i)
-    {
-        glVertex2f(vertices[i].x, vertices[i].y);
-    }
-    glEnd();
+    submitTriangleFan( vertices, vertexCount, ColorF( 0.5f * color.red, 0.5f * color.green, 0.5f * color.blue, 0.15f ) );
+    submitLineLoop( vertices, vertexCount, ColorF( color.red, color.green, color.blue, 1.0f ) );
 }
 
 //-----------------------------------------------------------------------------
@@ -307,18 +376,7 @@ void DebugDraw::DrawCircle( const b2Vec2& center, float32 radius, const ColorF&
     // Debug Profiling.
     PROFILE_SCOPE(DebugDraw_DrawCircle);
 
-    const float32 k_segments = 16.0f;
-    const float32 k_increment = 2.0f * b2_pi / k_segments;
-    float32 theta = 0.0f;
-    glColor3f(color.red, color.green, color.blue);
-    glBegin(GL_LINE_LOOP);
-    for (int32 i = 0; i < k_segments; ++i)
-    {
-        b2Vec2 v = center + radius * b2Vec2(cosf(theta), sinf(theta));
-        glVertex2f(v.x, v.y);
-        theta += k_increment;
-    }
-    glEnd();
+    submitCircle( center, radius, k_circleSegments, color, false );
 }
     
 //-----------------------------------------------------------------------------
@@ -328,81 +386,160 @@ void DebugDraw::DrawSolidCircle( const b2Vec2& center, float32 radius, const b2V
     // Debug Profiling.
     PROFILE_SCOPE(DebugDraw_DrawSolidCircle);
 
-    const float32 k_segments = 12.0f;
-    const float32 k_increment = 2.0f * b2_pi / k_segments;
-    float32 theta = 0.0f;
-    glEnable(GL_BLEND);
-    glBlendFunc (GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glColor4f(0.5f * color.red, 0.5f * color.green, 0.5f * color.blue, 0.15f);
-    glBegin(GL_TRIANGLE_FAN);
-    for (int32 i = 0; i < k_segments; ++i)
-    {
-        b2Vec2 v = center + radius * b2Vec2(cosf(theta), sinf(theta));
-        glVertex2f(v.x, v.y);
-        theta += k_increment;
-    }
-    glEnd();
-    glDisable(GL_BLEND);
-
-    theta = 0.0f;
-    glColor4f(color.red, color.green, color.blue, 1.0f);
-    glBegin(GL_LINE_LOOP);
-    for (int32 i = 0; i < k_segments; ++i)
-    {
-        b2Vec2 v = center + radius * b2Vec2(cosf(theta), sinf(theta));
-        glVertex2f(v.x, v.y);
-        theta += k_increment;
-    }
-    glEnd();
+    submitCircle( center, radius, k_solidCircleSegments, color, true );
 
     b2Vec2 p = center + radius * axis;
-    glBegin(GL_LINES);
-    glVertex2f(center.x, center.y);
-    glVertex2f(p.x, p.y);
-    glEnd();
+    submitLine( center, p, ColorF( color.red, color.green, color.blue, 1.0f ) );
 }
     
 //-----------------------------------------------------------------------------
 
 void DebugDraw::DrawSegment( const b2Vec2& p1, const b2Vec2& p2, const ColorF& color )
 {
-    glColor3f(color.red, color.green, color.blue);
-    glBegin(GL_LINES);
-    glVertex2f(p1.x, p1.y);
-    glVertex2f(p2.x, p2.y);
-    glEnd();
+    submitLine( p1, p2, ColorF( color.red, color.green, color.blue, 1.0f ) );
 }
 
 //-----------------------------------------------------------------------------
 
 void DebugDraw::DrawTransform( const b2Transform& xf )
 {
-    b2Vec2 p1 = xf.p, p2;
+    b2Vec2 p1 = xf.p;
     const float32 k_axisScale = 0.4f;
-    glBegin(GL_LINES);
-    
-    glColor3f(1.0f, 0.0f, 0.0f);
-    glVertex2f(p1.x, p1.y);
-    p2 = p1 + k_axisScale * xf.q.GetXAxis();
-    glVertex2f(p2.x, p2.y);
 
-    glColor3f(0.0f, 1.0f, 0.0f);
-    glVertex2f(p1.x, p1.y);
-    p2 = p1 + k_axisScale * xf.q.GetYAxis();
-    glVertex2f(p2.x, p2.y);
-
-    glEnd();
+    submitLine( p1, p1 + k_axisScale * xf.q.GetXAxis(), ColorF( 1.0f, 0.0f, 0.0f ) );
+    submitLine( p1, p1 + k_axisScale * xf.q.GetYAxis(), ColorF( 0.0f, 1.0f, 0.0f ) );
 }
 
 //-----------------------------------------------------------------------------
 
 void DebugDraw::DrawPoint( const b2Vec2& p, float32 size, const ColorF& color )
 {
-    glPointSize(size);
-    glBegin(GL_POINTS);
-    glColor3f(color.red, color.green, color.blue);
-    glVertex2f(p.x, p.y);
-    glEnd();
-    glPointSize(1.0f);
+    // Find the batch for this point size.
+    PointBatch* pPointBatch = NULL;
+    for ( S32 i = 0; i < mPointBatches.size(); ++i )
+    {
+        if ( mPointBatches[i].mSize == size )
+        {
+            pPointBatch = &mPointBatches[i];
+            break;
+        }
+    }
+
+    if ( pPointBatch == NULL )
+    {
+        mPointBatches.increment();
+        pPointBatch = &mPointBatches.last();
+        pPointBatch->mSize = size;
+    }
+
+    pPointBatch->mVertices.push_back( p );
+    pPointBatch->mColors.push_back( ColorF( color.red, color.green, color.blue, 1.0f ) );
+}
+
+//-----------------------------------------------------------------------------
+
+void DebugDraw::submitLine( const b2Vec2& p1, const b2Vec2& p2, const ColorF& color )
+{
+    mLineVertices.push_back( p1 );
+    mLineVertices.push_back( p2 );
+    mLineColors.push_back( color );
+    mLineColors.push_back( color );
+}
+
+//-----------------------------------------------------------------------------
+
+void DebugDraw::submitLineLoop( const b2Vec2* vertices, int32 vertexCount, const ColorF& color )
+{
+    if ( vertexCount < 2 )
+        return;
+
+    // Each edge becomes a line pair.
+    const U32 start = mLineVertices.size();
+    mLineVertices.setSize( start + vertexCount * 2 );
+    mLineColors.setSize( start + vertexCount * 2 );
+
+    b2Vec2* pVertex = mLineVertices.address() + start;
+    ColorF* pColor = mLineColors.address() + start;
+    for ( int32 i = 0; i < vertexCount; ++i )
+    {
+        *pVertex++ = vertices[i];
+        *pVertex++ = vertices[ (i + 1) % vertexCount ];
+        *pColor++ = color;
+        *pColor++ = color;
+    }
 }
 
+//-----------------------------------------------------------------------------
+
+void DebugDraw::submitTriangleFan( const b2Vec2* vertices, int32 vertexCount, const ColorF& color )
+{
+    if ( vertexCount < 3 )
+        return;
+
+    // Fans become plain triangles so every fill shares one draw.
+    const U32 start = mTriangleVertices.size();
+    const U32 count = (vertexCount - 2) * 3;
+    mTriangleVertices.setSize( start + count );
+    mTriangleColors.setSize( start + count );
+
+    b2Vec2* pVertex = mTriangleVertices.address() + start;
+    ColorF* pColor = mTriangleColors.address() + start;
+    for ( int32 i = 1; i < vertexCount - 1; ++i )
+    {
+        *pVertex++ = vertices[0];
+        *pVertex++ = vertices[i];
+        *pVertex++ = vertices[i + 1];
+        *pColor++ = color;
+        *pColor++ = color;
+        *pColor++ = color;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void DebugDraw::submitCircle( const b2Vec2& center, float32 radius, const U32 segments, const ColorF& color, const bool solid )
+{
+    // Place the cached unit circle.
+    const b2Vec2* pUnitCircle = getUnitCircle( segments );
+    mCircleVertices.setSize( segments );
+    for ( U32 i = 0; i < segments; ++i )
+    {
+        mCircleVertices[i] = center + radius * pUnitCircle[i];
+    }
+
+    if ( solid )
+        submitTriangleFan( mCircleVertices.address(), segments, ColorF( 0.5f * color.red, 0.5f * color.green, 0.5f * color.blue, 0.15f ) );
+
+    submitLineLoop( mCircleVertices.address(), segments, ColorF( color.red, color.green, color.blue, 1.0f ) );
+}
+
+//-----------------------------------------------------------------------------
+
+const b2Vec2* DebugDraw::getUnitCircle( const U32 segments )
+{
+    static b2Vec2 circle[k_circleSegments];
+    static b2Vec2 solidCircle[k_solidCircleSegments];
+    static bool initialized = false;
+
+    // Tessellate once.
+    if ( !initialized )
+    {
+        for ( U32 i = 0; i < k_circleSegments; ++i )
+        {
+            const F32 theta = 2.0f * b2_pi * i / k_circleSegments;
+            circle[i].Set( cosf(theta), sinf(theta) );
+        }
+
+        for ( U32 i = 0; i < k_solidCircleSegments; ++i )
+        {
+            const F32 theta = 2.0f * b2_pi * i / k_solidCircleSegments;
+            solidCircle[i].Set( cosf(theta), sinf(theta) );
+        }
+
+        initialized = true;
+    }
+
+    AssertFatal( segments == k_circleSegments || segments == k_solidCircleSegments, "DebugDraw::getUnitCircle() - Unsupported segment count." );
+
+    return segments == k_solidCircleSegments ? solidCircle : circle;
+}
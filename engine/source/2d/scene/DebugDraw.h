@@ -35,14 +35,25 @@
 #include "graphics/gColor.h"
 #endif
 
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+class DebugStats;
+
 //-----------------------------------------------------------------------------
 
 class DebugDraw
 {
 public:
-    DebugDraw() {}
+    DebugDraw();
     virtual ~DebugDraw() {}
 
+    /// Primitives are accumulated and only drawn when flushed.
+    void Flush( DebugStats* pDebugStats );
+
     void DrawAABB( const b2AABB& aabb, const ColorF& color );
     void DrawOOBB( const b2Vec2* pOOBB, const ColorF& color );
     void DrawAsleep( const b2Vec2* pOOBB, const ColorF& color );
@@ -59,6 +70,29 @@ public:
     void DrawSegment( const b2Vec2& p1, const b2Vec2& p2, const ColorF& color);
     void DrawTransform(const b2Transform& xf);
     void DrawPoint(const b2Vec2& p, float32 size, const ColorF& color);
+
+private:
+    /// Points of one size.
+    struct PointBatch
+    {
+        F32             mSize;
+        Vector<b2Vec2>  mVertices;
+        Vector<ColorF>  mColors;
+    };
+
+    void submitLine( const b2Vec2& p1, const b2Vec2& p2, const ColorF& color );
+    void submitLineLoop( const b2Vec2* vertices, int32 vertexCount, const ColorF& color );
+    void submitTriangleFan( const b2Vec2* vertices, int32 vertexCount, const ColorF& color );
+    void submitCircle( const b2Vec2& center, float32 radius, const U32 segments, const ColorF& color, const bool solid );
+
+    static const b2Vec2* getUnitCircle( const U32 segments );
+
+    Vector<b2Vec2>      mLineVertices;
+    Vector<ColorF>      mLineColors;
+    Vector<b2Vec2>      mTriangleVertices;
+    Vector<ColorF>      mTriangleColors;
+    Vector<PointBatch>  mPointBatches;
+    Vector<b2Vec2>      mCircleVertices;
 };
 
 #endif // _DEBUG_DRAW_H_
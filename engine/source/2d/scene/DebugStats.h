@@ -94,8 +94,18 @@ public:
         if ( batchNoBatchFlush > maxBatchNoBatchFlush ) maxBatchNoBatchFlush = batchNoBatchFlush;
         if ( batchAnonymousFlush > maxBatchAnonymousFlush ) maxBatchAnonymousFlush = batchAnonymousFlush;
 
+        // Debug draw.
+        if ( debugDrawLines > maxDebugDrawLines ) maxDebugDrawLines = debugDrawLines;
+        if ( debugDrawTriangles > maxDebugDrawTriangles ) maxDebugDrawTriangles = debugDrawTriangles;
+        if ( debugDrawCalls > maxDebugDrawCalls ) maxDebugDrawCalls = debugDrawCalls;
+        if ( debugDrawTime > maxDebugDrawTime ) maxDebugDrawTime = debugDrawTime;
+
         // Particles.
         if ( particlesUsed > maxParticlesUsed ) maxParticlesUsed = particlesUsed;
+        if ( fluidParticles > maxFluidParticles ) maxFluidParticles = fluidParticles;
+
+        // Ticks.
+        if ( tickTotal > maxTickTotal ) maxTickTotal = tickTotal;
 
         // World profile.
         if ( worldProfile.step > maxWorldProfile.step ) maxWorldProfile.step = worldProfile.step;
@@ -186,11 +196,48 @@ public:
         batchAnonymousFlush = 0;
         maxBatchAnonymousFlush = 0;
 
+        debugDrawLines = 0;
+        maxDebugDrawLines = 0;
+
+        debugDrawTriangles = 0;
+        maxDebugDrawTriangles = 0;
+
+        debugDrawCalls = 0;
+        maxDebugDrawCalls = 0;
+
+        debugDrawTime = 0.0f;
+        maxDebugDrawTime = 0.0f;
+
         particlesAlloc = 0;
         particlesFree = 0;
         particlesUsed = 0;
         maxParticlesUsed = 0;
 
+        fluidParticles = 0;
+        maxFluidParticles = 0;
+        fluidGroups = 0;
+
+        sceneTreeHeight = 0;
+        sceneTreeBalance = 0;
+        sceneTreeQuality = 0.0f;
+        sceneTreeRebuilds = 0;
+
+        worldTreeHeight = 0;
+        worldTreeBalance = 0;
+        worldTreeQuality = 0.0f;
+        worldTreeRebuilds = 0;
+
+        tickPreIntegrate = 0.0f;
+        tickControllers = 0.0f;
+        tickPhysics = 0.0f;
+        tickIntegrate = 0.0f;
+        tickPostIntegrate = 0.0f;
+        tickCallbacks = 0.0f;
+        tickTotal = 0.0f;
+        maxTickTotal = 0.0f;
+        tickLODDeferred = 0;
+        ticksDropped = 0;
+
         fps = 0.0f;
         minFPS = 10000.0f;
         maxFPS = 0.0f;
@@ -276,11 +323,48 @@ public:
     U32     batchAnonymousFlush;
     U32     maxBatchAnonymousFlush;
 
+    U32     debugDrawLines;
+    U32     maxDebugDrawLines;
+
+    U32     debugDrawTriangles;
+    U32     maxDebugDrawTriangles;
+
+    U32     debugDrawCalls;
+    U32     maxDebugDrawCalls;
+
+    F32     debugDrawTime;
+    F32     maxDebugDrawTime;
+
     U32     particlesAlloc;
     U32     particlesFree;
     U32     particlesUsed;
     U32     maxParticlesUsed;
 
+    U32     fluidParticles;
+    U32     maxFluidParticles;
+    U32     fluidGroups;
+
+    U32     sceneTreeHeight;
+    U32     sceneTreeBalance;
+    F32     sceneTreeQuality;
+    U32     sceneTreeRebuilds;
+
+    U32     worldTreeHeight;
+    U32     worldTreeBalance;
+    F32     worldTreeQuality;
+    U32     worldTreeRebuilds;
+
+    F32     tickPreIntegrate;
+    F32     tickControllers;
+    F32     tickPhysics;
+    F32     tickIntegrate;
+    F32     tickPostIntegrate;
+    F32     tickCallbacks;
+    F32     tickTotal;
+    F32     maxTickTotal;
+    U32     tickLODDeferred;
+    U32     ticksDropped;
+
     F32     fps;
     F32     minFPS;
     F32     maxFPS;
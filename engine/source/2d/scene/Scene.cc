@@ -56,6 +56,10 @@
 #include "2d/core/ParticleSystem.h"
 #endif
 
+#ifndef _FLUID_OBJECT_H_
+#include "2d/sceneobject/FluidObject.h"
+#endif
+
 // Script bindings.
 #include "Scene_ScriptBinding.h"
 
@@ -149,10 +153,18 @@ static StringTableEntry assetNodeName                     = StringTable->insert(
 Scene::Scene() :
     /// World.
     mpWorld(NULL),
+    mpNavigation(NULL),
     mWorldGravity(0.0f, 0.0f),
     mVelocityIterations(8),
     mPositionIterations(3),
 
+    /// Fluid particles.
+    mParticleSystem(NULL),
+    mParticleRadius(1.0f),
+
+    /// Scene occupancy.
+    mTamlBulkAdd(false),
+
     /// Joint access.
     mJointMasterId(1),
 
@@ -160,6 +172,17 @@ Scene::Scene() :
     mSceneTime(0.0f),
     mScenePause(false),
 
+    /// Tick scheduling.
+    mPhysicsSubSteps(1),
+    mScriptTickInterval(1),
+    mTickLODInterval(1),
+    mTickLODMargin(0.0f),
+    mTickBudget(0.0f),
+    mTickCount(0),
+    mFrameTickCount(0),
+    mFrameTickCost(0.0f),
+    mIsStepping(false),
+
     /// Debug and metrics.
     mDebugMask(0X00000000),
     mpDebugSceneObject(NULL),
@@ -222,7 +245,9 @@ bool Scene::onAdd()
     // Set contact filter.
     mpWorld->SetContactFilter( &mContactFilter );
 
-    const b2ParticleSystemDef particleSystemDef;
+    // Create fluid particle system.
+    b2ParticleSystemDef particleSystemDef;
+    particleSystemDef.radius = mParticleRadius;
     mParticleSystem = mpWorld->CreateParticleSystem(&particleSystemDef);
 
     // Set contact listener.
@@ -240,6 +265,9 @@ bool Scene::onAdd()
     // Create world query.
     mpWorldQuery = new WorldQuery(this);
 
+    // Create navigation.
+    mpNavigation = new SceneNavigation(this);
+
     // Set loading scene.
     Scene::LoadingScene = this;
 
@@ -263,6 +291,10 @@ void Scene::onRemove()
     // Process Delete Requests.
     processDeleteRequests(true);
 
+    // Delete navigation.
+    delete mpNavigation;
+    mpNavigation = NULL;
+
     // Delete ground body.
     mpWorld->DestroyBody( mpGroundBody );
     mpGroundBody = NULL;
@@ -272,6 +304,7 @@ void Scene::onRemove()
     delete mpWorld;
     mpWorldQuery = NULL;
     mpWorld = NULL;
+    mParticleSystem = NULL;
 
     // Detach All Scene Windows.
     detachAllSceneWindows();
@@ -309,6 +342,14 @@ void Scene::initPersistFields()
     addProtectedField("Gravity", TypeVector2, Offset(mWorldGravity, Scene), &setGravity, &getGravity, &writeGravity, "" );
     addField("VelocityIterations", TypeS32, Offset(mVelocityIterations, Scene), &writeVelocityIterations, "" );
     addField("PositionIterations", TypeS32, Offset(mPositionIterations, Scene), &writePositionIterations, "" );
+    addProtectedField("ParticleRadius", TypeF32, Offset(mParticleRadius, Scene), &setParticleRadius, &defaultProtectedGetFn, &writeParticleRadius, "The radius of fluid particles used by FluidObjects." );
+
+    // Tick scheduling.
+    addProtectedField("PhysicsSubSteps", TypeS32, Offset(mPhysicsSubSteps, Scene), &setPhysicsSubSteps, &defaultProtectedGetFn, &writePhysicsSubSteps, "The number of physics steps taken each tick (1-8)." );
+    addProtectedField("ScriptTickInterval", TypeS32, Offset(mScriptTickInterval, Scene), &setScriptTickInterval, &defaultProtectedGetFn, &writeScriptTickInterval, "The number of ticks between 'onSceneUpdate' callbacks." );
+    addProtectedField("TickLODInterval", TypeS32, Offset(mTickLODInterval, Scene), &setTickLODInterval, &defaultProtectedGetFn, &writeTickLODInterval, "The number of ticks between updates of objects outside all scene window views.  A value of one disables tick level-of-detail." );
+    addProtectedField("TickLODMargin", TypeF32, Offset(mTickLODMargin, Scene), &setTickLODMargin, &defaultProtectedGetFn, &writeTickLODMargin, "The distance beyond the scene window views within which objects still update every tick." );
+    addProtectedField("TickBudget", TypeF32, Offset(mTickBudget, Scene), &setTickBudget, &defaultProtectedGetFn, &writeTickBudget, "The milliseconds of catch-up ticks allowed per frame before ticks are dropped.  A value of zero is unlimited." );
 
     // Layer sort modes.
     char buffer[64];
@@ -368,6 +409,19 @@ void Scene::EndContact( b2Contact* pContact )
 {
     PROFILE_SCOPE(Scene_EndContact);
 
+    // Did the contact begin within this tick?
+    // NOTE:-   With physics sub-steps, a contact can begin and end within the same tick.  The
+    //          contact is destroyed afterwards so it is discarded rather than reported.
+    if ( mIsStepping )
+    {
+        typeContactHash::iterator contactItr = mBeginContacts.find( pContact );
+        if ( contactItr != mBeginContacts.end() )
+        {
+            mBeginContacts.erase( contactItr );
+            return;
+        }
+    }
+
     // Fetch fixtures.
     b2Fixture* pFixtureA = pContact->GetFixtureA();
     b2Fixture* pFixtureB = pContact->GetFixtureB();
@@ -761,10 +815,25 @@ void Scene::processTick( void )
     mDebugStats.particlesAlloc = ParticleSystem::Instance->getAllocatedParticleCount();
     mDebugStats.particlesUsed = ParticleSystem::Instance->getActiveParticleCount();
     mDebugStats.particlesFree = mDebugStats.particlesAlloc - mDebugStats.particlesUsed;
+    mDebugStats.fluidParticles = (U32)mParticleSystem->GetParticleCount();
+    mDebugStats.fluidGroups = (U32)mParticleSystem->GetParticleGroupCount();
 
     // Finish if scene is paused.
     if ( !getScenePause() )
     {
+        // Has this frame already spent its tick budget?
+        if ( mTickBudget > 0.0f && mFrameTickCount > 0 && mFrameTickCost >= mTickBudget )
+        {
+            // Yes, so drop the tick rather than falling further behind.
+            mDebugStats.ticksDropped++;
+            mDebugStats.updateRanges();
+            return;
+        }
+
+        // Start timing the tick.
+        b2Timer tickTimer;
+        b2Timer stageTimer;
+
         // Reset object stats.
         U32 objectsEnabled = 0;
         U32 objectsVisible = 0;
@@ -776,6 +845,9 @@ void Scene::processTick( void )
         // Update scene time.
         mSceneTime += Tickable::smTickSec;
 
+        // Update tick count.
+        mTickCount++;
+
         // Clear ticked scene objects.
         mTickedSceneObjects.clear();
 
@@ -817,6 +889,9 @@ void Scene::processTick( void )
         // Fetch ticked scene object count.
         const S32 tickedSceneObjectCount = mTickedSceneObjects.size();
 
+        // Flag the objects in view if using tick level-of-detail.
+        const bool useTickLOD = updateTickLOD();
+
         // ****************************************************
         // Pre-integrate objects.
         // ****************************************************
@@ -831,53 +906,83 @@ void Scene::processTick( void )
             mTickedSceneObjects[i]->preIntegrate( mSceneTime, Tickable::smTickSec, pDebugStats );
         }
 
-        // ****************************************************
-        // Integrate controllers.
-        // ****************************************************
+        mDebugStats.tickPreIntegrate = stageTimer.GetMilliseconds();
+        mDebugStats.tickControllers = 0.0f;
+        mDebugStats.tickPhysics = 0.0f;
+
+        // Reset contacts.
+        mBeginContacts.clear();
+        mEndContacts.clear();
 
         // Fetch the controller set.
         SimSet* pControllerSet = getControllers();
 
-        // Do we have any scene controllers?
-        if ( pControllerSet != NULL )
+        // Calculate the physics sub-step.
+        const S32 subStepCount = isNormalScene ? mPhysicsSubSteps : 1;
+        const F32 subStepTime = Tickable::smTickSec / (F32)subStepCount;
+
+        // Forces applied this tick must act across every sub-step so stop the world clearing them after each step.
+        if ( isNormalScene )
+            mpWorld->SetAutoClearForces( false );
+
+        // Iterate the physics sub-steps.
+        for ( S32 subStep = 0; subStep < subStepCount; ++subStep )
         {
-            // Debug Profiling.
-            PROFILE_SCOPE(Scene_IntegrateSceneControllers);
+            // ****************************************************
+            // Integrate controllers.
+            // ****************************************************
 
-            // Yes, so fetch scene controller count.
-            const S32 sceneControllerCount = (S32)pControllerSet->size();
+            stageTimer.Reset();
 
-            // Iterate scene controllers.
-            for( S32 i = 0; i < sceneControllerCount; i++ )
+            // Do we have any scene controllers?
+            // NOTE: Controllers apply forces which now persist across the sub-steps so they only integrate once per tick.
+            if ( pControllerSet != NULL && subStep == 0 )
             {
-                // Fetch the scene controller.
-                SceneController* pController = dynamic_cast<SceneController*>((*pControllerSet)[i]);
+                // Debug Profiling.
+                PROFILE_SCOPE(Scene_IntegrateSceneControllers);
 
-                // Skip if not a controller.
-                if ( pController == NULL )
-                    continue;
+                // Yes, so fetch scene controller count.
+                const S32 sceneControllerCount = (S32)pControllerSet->size();
+
+                // Iterate scene controllers.
+                for( S32 i = 0; i < sceneControllerCount; i++ )
+                {
+                    // Fetch the scene controller.
+                    SceneController* pController = dynamic_cast<SceneController*>((*pControllerSet)[i]);
 
-                // Integrate.
-                pController->integrate( this, mSceneTime, Tickable::smTickSec, pDebugStats );
+                    // Skip if not a controller.
+                    if ( pController == NULL )
+                        continue;
+
+                    // Integrate.
+                    pController->integrate( this, mSceneTime, Tickable::smTickSec, pDebugStats );
+                }
             }
-        }
 
-        // Debug Profiling.
-        PROFILE_START(Scene_IntegratePhysicsSystem);
+            mDebugStats.tickControllers += stageTimer.GetMilliseconds();
+            stageTimer.Reset();
 
-        // Reset contacts.
-        mBeginContacts.clear();
-        mEndContacts.clear();
+            // Debug Profiling.
+            PROFILE_START(Scene_IntegratePhysicsSystem);
 
-        // Only step the physics if a "normal" scene.
-        if ( isNormalScene )
-        {
-            // Step the physics.
-            mpWorld->Step( Tickable::smTickSec, mVelocityIterations, mPositionIterations );
+            // Only step the physics if a "normal" scene.
+            if ( isNormalScene )
+            {
+                // Step the physics.
+                mIsStepping = true;
+                mpWorld->Step( subStepTime, mVelocityIterations, mPositionIterations );
+                mIsStepping = false;
+            }
+
+            // Debug Profiling.
+            PROFILE_END();   // Scene_IntegratePhysicsSystem
+
+            mDebugStats.tickPhysics += stageTimer.GetMilliseconds();
         }
 
-        // Debug Profiling.
-        PROFILE_END();   // Scene_IntegratePhysicsSystem
+        // Clear the forces now the tick has been fully stepped.
+        if ( isNormalScene )
+            mpWorld->ClearForces();
 
         // Forward the contacts.
         forwardContacts();
@@ -886,16 +991,41 @@ void Scene::processTick( void )
         // Integrate objects.
         // ****************************************************
 
+        stageTimer.Reset();
+
+        // Reset the deferred object count.
+        U32 tickLODDeferred = 0;
+
         // Iterate ticked scene objects.
         for ( S32 i = 0; i < tickedSceneObjectCount; ++i )
         {
             // Debug Profiling.
             PROFILE_SCOPE(Scene_IntegrateObject);
 
+            // Fetch scene object.
+            SceneObject* pSceneObject = mTickedSceneObjects[i];
+
+            // Is the object out of view and not due a tick?
+            if ( useTickLOD && !getTickLODDue( pSceneObject ) )
+            {
+                // Yes, so only keep its spatials up-to-date and defer the elapsed time.
+                pSceneObject->integrateSpatial();
+                pSceneObject->deferTickLODElapsed( Tickable::smTickSec );
+                tickLODDeferred++;
+                continue;
+            }
+
             // Integrate.
-            mTickedSceneObjects[i]->integrateObject( mSceneTime, Tickable::smTickSec, pDebugStats );
+            pSceneObject->integrateObject( mSceneTime, pSceneObject->takeTickLODElapsed( Tickable::smTickSec ), pDebugStats );
         }
 
+        // Step the playing animations.
+        mImageFrameAnimator.integrate( Tickable::smTickSec, isNormalScene );
+
+        mDebugStats.tickLODDeferred = tickLODDeferred;
+        mDebugStats.tickIntegrate = stageTimer.GetMilliseconds();
+        stageTimer.Reset();
+
         // ****************************************************
         // Post-Integrate Stage.
         // ****************************************************
@@ -906,12 +1036,25 @@ void Scene::processTick( void )
             // Debug Profiling.
             PROFILE_SCOPE(Scene_PostIntegrate);
 
+            // Fetch scene object.
+            SceneObject* pSceneObject = mTickedSceneObjects[i];
+
+            // Skip if the object is out of view and not due a tick.
+            if ( useTickLOD && !getTickLODDue( pSceneObject ) )
+                continue;
+
             // Post-integrate.
-            mTickedSceneObjects[i]->postIntegrate( mSceneTime, Tickable::smTickSec, pDebugStats );
+            pSceneObject->postIntegrate( mSceneTime, Tickable::smTickSec, pDebugStats );
         }
 
+        // Maintain the spatial trees.
+        mpWorldQuery->maintainTrees( &mDebugStats );
+
+        mDebugStats.tickPostIntegrate = stageTimer.GetMilliseconds();
+        stageTimer.Reset();
+
         // Scene update callback.
-        if( mUpdateCallback )
+        if( mUpdateCallback && (mTickCount % (U32)mScriptTickInterval) == 0 )
         {
             // Debug Profiling.
             PROFILE_SCOPE(Scene_OnSceneUpdatetCallback);
@@ -927,8 +1070,18 @@ void Scene::processTick( void )
             dispatchBeginContactCallbacks();
         }
 
+        // Rebake navigation and dispatch its completed requests.
+        mpNavigation->update();
+
         // Clear ticked scene objects.
         mTickedSceneObjects.clear();
+
+        mDebugStats.tickCallbacks = stageTimer.GetMilliseconds();
+        mDebugStats.tickTotal = tickTimer.GetMilliseconds();
+
+        // Update the frame tick cost.
+        mFrameTickCount++;
+        mFrameTickCost += mDebugStats.tickTotal;
     }
 
     // Update debug stat ranges.
@@ -937,8 +1090,66 @@ void Scene::processTick( void )
 
 //-----------------------------------------------------------------------------
 
+bool Scene::updateTickLOD( void )
+{
+    // Finish if not using tick level-of-detail or there are no views to use.
+    if ( mTickLODInterval <= 1 || mAttachedSceneWindows.size() == 0 || getIsEditorScene() )
+        return false;
+
+    // Debug Profiling.
+    PROFILE_SCOPE(Scene_UpdateTickLOD);
+
+    // Set filter.
+    WorldQueryFilter queryFilter( MASK_ALL, MASK_ALL, false, false, false, false );
+    mpWorldQuery->setQueryFilter( queryFilter );
+
+    // Iterate the attached scene windows.
+    for( SimSet::iterator itr = mAttachedSceneWindows.begin(); itr != mAttachedSceneWindows.end(); ++itr )
+    {
+        // Fetch the scene window camera.
+        const SceneWindow::CameraView& cameraView = static_cast<SceneWindow*>(*itr)->getCamera();
+
+        // Calculate the view AABB.
+        b2AABB viewAABB;
+        CoreMath::mRotateAABB( CoreMath::mRectFtoAABB( cameraView.mDestinationArea ), cameraView.mCameraAngle, viewAABB );
+        viewAABB.lowerBound -= b2Vec2( mTickLODMargin, mTickLODMargin );
+        viewAABB.upperBound += b2Vec2( mTickLODMargin, mTickLODMargin );
+
+        // Query the view.
+        mpWorldQuery->clearQuery();
+        mpWorldQuery->aabbQueryAABB( viewAABB );
+
+        // Flag the objects in view.
+        typeWorldQueryResultVector& queryResults = mpWorldQuery->getQueryResults();
+        const U32 queryResultCount = queryResults.size();
+        for ( U32 n = 0; n < queryResultCount; ++n )
+        {
+            queryResults[n].mpSceneObject->setTickLODStamp( mTickCount );
+        }
+    }
+
+    // Clear the query.
+    mpWorldQuery->clearQuery();
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool Scene::getTickLODDue( const SceneObject* pSceneObject ) const
+{
+    // Objects in view are always due whereas others are staggered across the interval.
+    return pSceneObject->getTickLODStamp() == mTickCount || ((mTickCount + pSceneObject->getSerialId()) % (U32)mTickLODInterval) == 0;
+}
+
+//-----------------------------------------------------------------------------
+
 void Scene::interpolateTick( F32 timeDelta )
 {
+    // Reset the frame tick cost.
+    mFrameTickCount = 0;
+    mFrameTickCost = 0.0f;
+
     // Finish if scene is paused.
     if ( getScenePause() ) return;
 
@@ -993,6 +1204,13 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
     pDebugStats->batchLayerFlush                = 0;
     pDebugStats->batchNoBatchFlush              = 0;
     pDebugStats->batchAnonymousFlush            = 0;
+    pDebugStats->debugDrawLines                 = 0;
+    pDebugStats->debugDrawTriangles             = 0;
+    pDebugStats->debugDrawCalls                 = 0;
+    pDebugStats->debugDrawTime                  = 0.0f;
+
+    // Timer for the debug draw overlays.
+    b2Timer debugDrawTimer;
 
     // Set batch renderer wireframe mode.
     mBatchRenderer.setWireframeMode( getDebugMask() & SCENE_DEBUG_WIREFRAME_RENDER );
@@ -1020,6 +1238,10 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
     // Query render AABB.
     mpWorldQuery->aabbQueryAABB( cameraAABB );
 
+    // Copy the render query results if requested.
+    if ( pSceneRenderState->mpRenderResults != NULL )
+        *pSceneRenderState->mpRenderResults = mpWorldQuery->getQueryResults();
+
     // Debug Profiling.
     PROFILE_END();  //Scene_RenderSceneVisibleQuery
 
@@ -1219,6 +1441,8 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
                 // NOTE:    We cannot batch between layers as we adhere to a strict layer render order.
                 mBatchRenderer.flush( pDebugStats->batchLayerFlush );
 
+                debugDrawTimer.Reset();
+
                 // Iterate query results.
                 for( typeWorldQueryResultVector::iterator worldQueryItr = layerResults.begin(); worldQueryItr != layerResults.end(); ++worldQueryItr )
                 {
@@ -1231,6 +1455,12 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
                     // Render object overlay.
                     pSceneObject->sceneRenderOverlay( pSceneRenderState );
                 }
+
+                // Flush the layer overlays.
+                // NOTE:    Overlays are flushed per-layer so they keep the strict layer render order.
+                mDebugDraw.Flush( pDebugStats );
+
+                pDebugStats->debugDrawTime += debugDrawTimer.GetMilliseconds();
             }
 
             // Reset render queue.
@@ -1253,6 +1483,8 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
             // Debug Profiling.
             PROFILE_SCOPE(Scene_RenderControllers);
 
+            debugDrawTimer.Reset();
+
             // Yes, so fetch scene controller count.
             const S32 sceneControllerCount = (S32)pControllerSet->size();
 
@@ -1272,6 +1504,11 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
 
             // Flush isolated batch.
             mBatchRenderer.flush( pDebugStats->batchIsolatedFlush );
+
+            // Flush the controller overlays.
+            mDebugDraw.Flush( pDebugStats );
+
+            pDebugStats->debugDrawTime += debugDrawTimer.GetMilliseconds();
         }
     }
 
@@ -1281,7 +1518,12 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
         // Debug Profiling.
         PROFILE_SCOPE(Scene_RenderSceneJointOverlays);
 
+        debugDrawTimer.Reset();
+
         mDebugDraw.DrawJoints( mpWorld );
+        mDebugDraw.Flush( pDebugStats );
+
+        pDebugStats->debugDrawTime += debugDrawTimer.GetMilliseconds();
     }
 
     // Update debug stat ranges.
@@ -1300,6 +1542,24 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
 
 //-----------------------------------------------------------------------------
 
+void Scene::setParticleRadius( const F32 radius )
+{
+    // Sanity!
+    if ( radius <= 0.0f )
+    {
+        Con::warnf( "Scene::setParticleRadius() - Invalid particle radius of %g.", radius );
+        return;
+    }
+
+    mParticleRadius = radius;
+
+    // Update the particle system if we have one.
+    if ( mParticleSystem != NULL )
+        mParticleSystem->SetRadius( radius );
+}
+
+//-----------------------------------------------------------------------------
+
 void Scene::clearScene( bool deleteObjects )
 {
     while( mSceneObjects.size() > 0 )
@@ -1379,6 +1639,24 @@ void Scene::addToScene( SceneObject* pSceneObject )
 
 //-----------------------------------------------------------------------------
 
+void Scene::addToScene( const typeSceneObjectVector& sceneObjects )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(Scene_AddToSceneBulk);
+
+    // Insert the objects into the spatial tree together.
+    mpWorldQuery->beginBulkAdd();
+
+    for( typeSceneObjectVector::const_iterator itr = sceneObjects.begin(); itr != sceneObjects.end(); ++itr )
+    {
+        addToScene( *itr );
+    }
+
+    mpWorldQuery->endBulkAdd();
+}
+
+//-----------------------------------------------------------------------------
+
 void Scene::removeFromScene( SceneObject* pSceneObject )
 {
     if ( pSceneObject == NULL )
@@ -1576,15 +1854,17 @@ void Scene::mergeScene( const Scene* pScene )
     if ( count == 0 )
         return;
 
+    typeSceneObjectVector clones;
+    clones.reserve( count );
 
     for( U32 index = 0; index < count; ++index )
     {
         // Fetch a clone of the scene object.
-        SceneObject* pSceneObject = (SceneObject*)pScene->getSceneObject( index )->clone( true );
-
-        // Add the clone.
-        addToScene( pSceneObject );
+        clones.push_back( (SceneObject*)pScene->getSceneObject( index )->clone( true ) );
     }
+
+    // Add the clones.
+    addToScene( clones );
 }
 
 //-----------------------------------------------------------------------------
@@ -3808,6 +4088,21 @@ void Scene::SayGoodbye( b2Joint* pJoint )
 
 //-----------------------------------------------------------------------------
 
+void Scene::SayGoodbye( b2ParticleGroup* pParticleGroup )
+{
+    // Fetch the owning fluid object.
+    FluidObject* pFluidObject = static_cast<FluidObject*>( pParticleGroup->GetUserData() );
+
+    // Ignore an unowned group.
+    if ( pFluidObject == NULL )
+        return;
+
+    // Let the owner forget the group.
+    pFluidObject->onParticleGroupDestroyed( pParticleGroup );
+}
+
+//-----------------------------------------------------------------------------
+
 SceneObject* Scene::create( const char* pType )
 {
     // Sanity!
@@ -3874,6 +4169,13 @@ void Scene::onTamlPostRead( const TamlCustomNodes& customNodes )
     // Call parent.
     Parent::onTamlPostRead( customNodes );
 
+    // Finish adding the children to the spatial tree.
+    if ( mTamlBulkAdd )
+    {
+        mpWorldQuery->endBulkAdd();
+        mTamlBulkAdd = false;
+    }
+
     // Reset the loading scene.
     Scene::LoadingScene = NULL;
 
@@ -5286,6 +5588,13 @@ void Scene::addTamlChild( SimObject* pSimObject )
         return;
     }
 
+    // Insert the children into the spatial tree together.
+    if ( !mTamlBulkAdd )
+    {
+        mpWorldQuery->beginBulkAdd();
+        mTamlBulkAdd = true;
+    }
+
     // Add the scene object.
     addToScene( pSceneObject );
 }
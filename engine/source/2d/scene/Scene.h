@@ -75,6 +75,14 @@
 #include "assets/assetPtr.h"
 #endif
 
+#ifndef _IMAGE_FRAME_ANIMATOR_H_
+#include "2d/core/ImageFrameAnimator.h"
+#endif
+
+#ifndef _SCENE_NAVIGATION_H_
+#include "2d/scene/SceneNavigation.h"
+#endif
+
 //-----------------------------------------------------------------------------
 
 extern EnumTable jointTypeTable;
@@ -214,15 +222,21 @@ private:
     /// World.
     b2World*                    mpWorld;
     WorldQuery*                 mpWorldQuery;
+    SceneNavigation*            mpNavigation;
     b2Vec2                      mWorldGravity;
     S32                         mVelocityIterations;
     S32                         mPositionIterations;
     b2BlockAllocator            mBlockAllocator;
     b2Body*                     mpGroundBody;
 
+    /// Fluid particles.
+    b2ParticleSystem*           mParticleSystem;
+    F32                         mParticleRadius;
+
     /// Scene occupancy.
     typeSceneObjectVector       mSceneObjects;
     typeSceneObjectVector       mTickedSceneObjects;
+    bool                        mTamlBulkAdd;
 
     /// Joint access.
     typeJointHash               mJoints;
@@ -235,10 +249,24 @@ private:
     /// Asset pre-loads.
     typeAssetPtrVector          mAssetPreloads;
 
+    /// Animation.
+    ImageFrameAnimator          mImageFrameAnimator;
+
     /// Scene time.
     F32                         mSceneTime;
     bool                        mScenePause;
 
+    /// Tick scheduling.
+    S32                         mPhysicsSubSteps;
+    S32                         mScriptTickInterval;
+    S32                         mTickLODInterval;
+    F32                         mTickLODMargin;
+    F32                         mTickBudget;
+    U32                         mTickCount;
+    U32                         mFrameTickCount;
+    F32                         mFrameTickCost;
+    bool                        mIsStepping;
+
     /// Debug and metrics.
     DebugStats                  mDebugStats;
     U32                         mDebugMask;
@@ -269,6 +297,10 @@ private:
     U32                         mSceneIndex;
 
 private:   
+    /// Tick level-of-detail.
+    bool                        updateTickLOD( void );
+    bool                        getTickLODDue( const SceneObject* pSceneObject ) const;
+
     /// Contacts.
     void                        forwardContacts( void );
     void                        dispatchBeginContactCallbacks( void );
@@ -333,6 +365,8 @@ public:
     inline WorldQuery*      getWorldQuery( const bool clearQuery = false ) { if ( clearQuery ) mpWorldQuery->clearQuery(); return mpWorldQuery; }
     b2BlockAllocator*       getBlockAllocator( void )                   { return &mBlockAllocator; }
     inline b2Body*          getGroundBody( void ) const                 { return mpGroundBody; }
+    inline ImageFrameAnimator& getImageFrameAnimator( void )            { return mImageFrameAnimator; }
+    inline SceneNavigation* getNavigation( void ) const                 { return mpNavigation; }
     virtual ePhysicsProxyType getPhysicsProxyType( void ) const         { return PhysicsProxy::PHYSIC_PROXY_GROUNDBODY; }
     void                    setGravity( const b2Vec2& gravity )         { mWorldGravity = gravity; if (mpWorld) mpWorld->SetGravity( gravity ); }
     inline b2Vec2           getGravity( void )                          { if (mpWorld) mWorldGravity = mpWorld->GetGravity(); return mWorldGravity; }
@@ -340,10 +374,14 @@ public:
     inline S32              getVelocityIterations( void ) const         { return mVelocityIterations; }
     inline void             setPositionIterations( const S32 iterations ) { mPositionIterations = iterations; }
     inline S32              getPositionIterations( void ) const         { return mPositionIterations; }
+    inline b2ParticleSystem* getParticleSystem( void ) const            { return mParticleSystem; }
+    void                    setParticleRadius( const F32 radius );
+    inline F32              getParticleRadius( void ) const             { return mParticleRadius; }
 
     /// Scene occupancy.
     void                    clearScene( bool deleteObjects = true );
     void                    addToScene( SceneObject* pSceneObject );
+    void                    addToScene( const typeSceneObjectVector& sceneObjects );
     void                    removeFromScene( SceneObject* pSceneObject );
 
     inline typeSceneObjectVectorConstRef getSceneObjects( void ) const  { return mSceneObjects; }
@@ -367,6 +405,18 @@ public:
     inline void             setScenePause( bool status )                { mScenePause = status; }
     inline bool             getScenePause( void ) const                 { return mScenePause; };
 
+    /// Tick scheduling.
+    inline void             setPhysicsSubSteps( const S32 subSteps )    { mPhysicsSubSteps = mClamp( subSteps, 1, 8 ); }
+    inline S32              getPhysicsSubSteps( void ) const            { return mPhysicsSubSteps; }
+    inline void             setScriptTickInterval( const S32 ticks )    { mScriptTickInterval = getMax( ticks, 1 ); }
+    inline S32              getScriptTickInterval( void ) const         { return mScriptTickInterval; }
+    inline void             setTickLODInterval( const S32 ticks )       { mTickLODInterval = getMax( ticks, 1 ); }
+    inline S32              getTickLODInterval( void ) const            { return mTickLODInterval; }
+    inline void             setTickLODMargin( const F32 margin )        { mTickLODMargin = getMax( margin, 0.0f ); }
+    inline F32              getTickLODMargin( void ) const              { return mTickLODMargin; }
+    inline void             setTickBudget( const F32 budget )           { mTickBudget = getMax( budget, 0.0f ); }
+    inline F32              getTickBudget( void ) const                 { return mTickBudget; }
+
     /// Joint access.
     inline U32              getJointCount( void ) const                 { return mJoints.size(); }
     b2JointType             getJointType( const S32 jointId );
@@ -651,6 +701,8 @@ public:
     /// Destruction listeners.
     virtual                 void SayGoodbye( b2Joint* pJoint );
     virtual                 void SayGoodbye( b2Fixture* pFixture )      {}
+    virtual                 void SayGoodbye( b2ParticleGroup* pParticleGroup );
+    virtual                 void SayGoodbye( b2ParticleSystem* pParticleSystem, int32 index ) {}
 
     virtual SceneObject*    create( const char* pType );
 
@@ -678,7 +730,7 @@ public:
     static const char* getPickModeDescription( PickMode pickMode );
     static DebugOption getDebugOptionEnum(const char* label);
     static const char* getDebugOptionDescription( DebugOption debugOption );
-    b2ParticleSystem*			mParticleSystem;
+
     /// Declare Console Object.
     DECLARE_CONOBJECT(Scene);
 
@@ -689,6 +741,20 @@ protected:
     static bool writeGravity( void* obj, StringTableEntry pFieldName )              { return Vector2(static_cast<Scene*>(obj)->getGravity()).notEqual( Vector2::getZero() ); }
     static bool writeVelocityIterations( void* obj, StringTableEntry pFieldName )   { return static_cast<Scene*>(obj)->getVelocityIterations() != 8; }
     static bool writePositionIterations( void* obj, StringTableEntry pFieldName )   { return static_cast<Scene*>(obj)->getPositionIterations() != 3; }
+    static bool setParticleRadius( void* obj, const char* data )                    { static_cast<Scene*>(obj)->setParticleRadius( dAtof(data) ); return false; }
+    static bool writeParticleRadius( void* obj, StringTableEntry pFieldName )       { return mNotEqual( static_cast<Scene*>(obj)->getParticleRadius(), 1.0f ); }
+
+    /// Tick scheduling.
+    static bool setPhysicsSubSteps( void* obj, const char* data )                   { static_cast<Scene*>(obj)->setPhysicsSubSteps( dAtoi(data) ); return false; }
+    static bool writePhysicsSubSteps( void* obj, StringTableEntry pFieldName )      { return static_cast<Scene*>(obj)->getPhysicsSubSteps() != 1; }
+    static bool setScriptTickInterval( void* obj, const char* data )                { static_cast<Scene*>(obj)->setScriptTickInterval( dAtoi(data) ); return false; }
+    static bool writeScriptTickInterval( void* obj, StringTableEntry pFieldName )   { return static_cast<Scene*>(obj)->getScriptTickInterval() != 1; }
+    static bool setTickLODInterval( void* obj, const char* data )                   { static_cast<Scene*>(obj)->setTickLODInterval( dAtoi(data) ); return false; }
+    static bool writeTickLODInterval( void* obj, StringTableEntry pFieldName )      { return static_cast<Scene*>(obj)->getTickLODInterval() != 1; }
+    static bool setTickLODMargin( void* obj, const char* data )                     { static_cast<Scene*>(obj)->setTickLODMargin( dAtof(data) ); return false; }
+    static bool writeTickLODMargin( void* obj, StringTableEntry pFieldName )        { return mNotZero( static_cast<Scene*>(obj)->getTickLODMargin() ); }
+    static bool setTickBudget( void* obj, const char* data )                        { static_cast<Scene*>(obj)->setTickBudget( dAtof(data) ); return false; }
+    static bool writeTickBudget( void* obj, StringTableEntry pFieldName )           { return mNotZero( static_cast<Scene*>(obj)->getTickBudget() ); }
 
     static bool writeLayerSortMode( void* obj, StringTableEntry pFieldName )
     {
@@ -0,0 +1,1202 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _SCENE_NAVIGATION_H_
+#include "2d/scene/SceneNavigation.h"
+#endif
+
+#ifndef _SCENE_H_
+#include "2d/scene/Scene.h"
+#endif
+
+#ifndef _SCENE_OBJECT_H_
+#include "2d/sceneobject/SceneObject.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+#ifndef _FRAMEALLOCATOR_H_
+#include "memory/frameAllocator.h"
+#endif
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+//-----------------------------------------------------------------------------
+
+// Neighbor offsets.  Even indices are orthogonal, odd indices are diagonal.
+static const S32 sNeighborX[8] = { 1, 1, 0, -1, -1, -1,  0,  1 };
+static const S32 sNeighborY[8] = { 0, 1, 1,  1,  0, -1, -1, -1 };
+static const F32 sNeighborCost[8] = { 1.0f, M_SQRT2_F, 1.0f, M_SQRT2_F, 1.0f, M_SQRT2_F, 1.0f, M_SQRT2_F };
+
+// Neighbor index for an offset, indexed by (dy+1)*3 + (dx+1).
+static const U8 sNeighborCode[9] = { 5, 6, 7, 4, SceneNavigation::FLOW_GOAL, 0, 3, 2, 1 };
+
+// Limit on the dirty regions held before they are merged.
+static const S32 sMaximumDirtyRegions = 64;
+
+// Limit on the grid cell count.
+static const U32 sMaximumGridCells = 4096 * 4096;
+
+//-----------------------------------------------------------------------------
+
+static inline F32 getOctileDistance( const S32 x0, const S32 y0, const S32 x1, const S32 y1 )
+{
+    const S32 dx = mAbs( x1 - x0 );
+    const S32 dy = mAbs( y1 - y0 );
+    return (F32)(dx + dy) + (M_SQRT2_F - 2.0f) * (F32)getMin( dx, dy );
+}
+
+//-----------------------------------------------------------------------------
+
+static S32 QSORT_CALLBACK compareFixtures( b2Fixture* const* a, b2Fixture* const* b )
+{
+    return *a < *b ? -1 : (*a > *b ? 1 : 0);
+}
+
+//-----------------------------------------------------------------------------
+
+class SceneNavigationWorker : public Thread
+{
+public:
+    SceneNavigationWorker( SceneNavigation* pNavigation ) :
+        Thread( 0, NULL, false ),
+        mpNavigation( pNavigation )
+    {
+    }
+
+    virtual void run( void* arg = 0 )
+    {
+        while ( !checkForStop() )
+        {
+            // Wait for a request.
+            mpNavigation->mRequestSemaphore.acquire();
+
+            if ( checkForStop() )
+                break;
+
+            // Fetch the request.  The queue may already have been drained by another worker.
+            SceneNavigation::Request* pRequest = mpNavigation->popRequest();
+            if ( pRequest == NULL )
+                continue;
+
+            SceneNavigation::processRequest( pRequest, mScratch );
+            mpNavigation->completeRequest( pRequest );
+        }
+    }
+
+private:
+    SceneNavigation*                mpNavigation;
+    SceneNavigation::SearchScratch  mScratch;
+};
+
+//-----------------------------------------------------------------------------
+
+void SceneNavigation::SearchScratch::prepare( const Grid& grid )
+{
+    const U32 cellCount = (U32)(grid.mWidth * grid.mHeight);
+
+    // Resize for the grid.
+    if ( (U32)mVisited.size() != cellCount )
+    {
+        mCost.setSize( cellCount );
+        mParent.setSize( cellCount );
+        mVisited.setSize( cellCount );
+        mClosed.setSize( cellCount );
+        dMemset( mVisited.address(), 0, mVisited.memSize() );
+        dMemset( mClosed.address(), 0, mClosed.memSize() );
+        mVisitKey = 0;
+    }
+
+    // Advance the visit key so no per-cell state needs clearing.
+    if ( ++mVisitKey == 0 )
+    {
+        dMemset( mVisited.address(), 0, mVisited.memSize() );
+        dMemset( mClosed.address(), 0, mClosed.memSize() );
+        mVisitKey = 1;
+    }
+
+    mOpen.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneNavigation::SearchScratch::pushOpen( const F32 cost, const S32 cell )
+{
+    mOpen.increment();
+
+    // Sift up.
+    S32 index = mOpen.size() - 1;
+    while ( index > 0 )
+    {
+        const S32 parent = (index - 1) >> 1;
+        if ( mOpen[parent].mCost <= cost )
+            break;
+
+        mOpen[index] = mOpen[parent];
+        index = parent;
+    }
+
+    mOpen[index].mCost = cost;
+    mOpen[index].mCell = cell;
+}
+
+//-----------------------------------------------------------------------------
+
+S32 SceneNavigation::SearchScratch::popOpen( void )
+{
+    const S32 cell = mOpen[0].mCell;
+    const OpenNode last = mOpen.last();
+    mOpen.decrement();
+
+    const S32 count = mOpen.size();
+    if ( count == 0 )
+        return cell;
+
+    // Sift down.
+    S32 index = 0;
+    while ( true )
+    {
+        S32 child = (index << 1) + 1;
+        if ( child >= count )
+            break;
+
+        if ( child + 1 < count && mOpen[child + 1].mCost < mOpen[child].mCost )
+            child++;
+
+        if ( last.mCost <= mOpen[child].mCost )
+            break;
+
+        mOpen[index] = mOpen[child];
+        index = child;
+    }
+
+    mOpen[index] = last;
+
+    return cell;
+}
+
+//-----------------------------------------------------------------------------
+
+SceneNavigation::SceneNavigation( Scene* pScene ) :
+    mpScene( pScene ),
+    mpGrid( NULL ),
+    mAgentRadius( 0.0f ),
+    mSceneGroupMask( MASK_ALL ),
+    mSceneLayerMask( MASK_ALL ),
+    mMasterRequestId( 0 ),
+    mRequestSemaphore( 0 )
+{
+    // Set Vector Associations.
+    VECTOR_SET_ASSOCIATION( mDirtyRegions );
+    VECTOR_SET_ASSOCIATION( mBakeFixtures );
+    VECTOR_SET_ASSOCIATION( mFlowFields );
+    VECTOR_SET_ASSOCIATION( mPendingRequests );
+    VECTOR_SET_ASSOCIATION( mCompletedRequests );
+    VECTOR_SET_ASSOCIATION( mWorkers );
+}
+
+//-----------------------------------------------------------------------------
+
+SceneNavigation::~SceneNavigation()
+{
+    clear();
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneNavigation::configure( const b2AABB& area, const F32 cellSize, const F32 agentRadius, const U32 sceneGroupMask, const U32 sceneLayerMask )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneNavigation_Configure);
+
+    // Sanity!
+    if ( cellSize <= 0.0f )
+    {
+        Con::warnf( "SceneNavigation::configure() - Invalid cell size of %g.", cellSize );
+        return false;
+    }
+
+    const F32 areaWidth = area.upperBound.x - area.lowerBound.x;
+    const F32 areaHeight = area.upperBound.y - area.lowerBound.y;
+    if ( areaWidth <= 0.0f || areaHeight <= 0.0f )
+    {
+        Con::warnf( "SceneNavigation::configure() - Invalid area of %g x %g.", areaWidth, areaHeight );
+        return false;
+    }
+
+    const S32 width = (S32)mCeil( areaWidth / cellSize );
+    const S32 height = (S32)mCeil( areaHeight / cellSize );
+    if ( (F32)width * (F32)height > (F32)sMaximumGridCells )
+    {
+        Con::warnf( "SceneNavigation::configure() - A grid of %d x %d cells is too large.", width, height );
+        return false;
+    }
+
+    // Discard any current grid.
+    clear();
+
+    mAgentRadius = getMax( agentRadius, 0.0f );
+    mSceneGroupMask = sceneGroupMask;
+    mSceneLayerMask = sceneLayerMask;
+
+    // Create the grid.
+    mpGrid = new Grid();
+    mpGrid->mReferenceCount = 1;
+    mpGrid->mOrigin = area.lowerBound;
+    mpGrid->mCellSize = cellSize;
+    mpGrid->mWidth = width;
+    mpGrid->mHeight = height;
+    mpGrid->mBlocked.setSize( (U32)(width * height) );
+
+    // Bake the whole area.
+    bakeRegion( mpGrid, 0, 0, width - 1, height - 1 );
+
+    startWorkers();
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneNavigation::clear( void )
+{
+    // Stop the workers before touching the queues.
+    stopWorkers();
+
+    for ( S32 i = 0; i < mPendingRequests.size(); ++i )
+        deleteRequest( mPendingRequests[i] );
+
+    for ( S32 i = 0; i < mCompletedRequests.size(); ++i )
+        deleteRequest( mCompletedRequests[i] );
+
+    for ( S32 i = 0; i < mFlowFields.size(); ++i )
+        delete mFlowFields[i];
+
+    mPendingRequests.clear();
+    mCompletedRequests.clear();
+    mFlowFields.clear();
+    mDirtyRegions.clear();
+
+    releaseGrid( mpGrid );
+    mpGrid = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneNavigation::markDirty( const b2AABB& aabb )
+{
+    if ( !getConfigured() )
+        return;
+
+    // Merge into a single region if too many are pending.
+    if ( mDirtyRegions.size() >= sMaximumDirtyRegions )
+    {
+        for ( S32 i = 1; i < mDirtyRegions.size(); ++i )
+            mDirtyRegions[0].Combine( mDirtyRegions[i] );
+
+        mDirtyRegions.setSize( 1 );
+        mDirtyRegions[0].Combine( aabb );
+        return;
+    }
+
+    mDirtyRegions.push_back( aabb );
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneNavigation::update( void )
+{
+    if ( !getConfigured() )
+        return;
+
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneNavigation_Update);
+
+    // Rebake any changed static shapes.
+    rebakeDirtyRegions();
+
+    // Rebuild flow fields against the current grid.
+    for ( S32 i = 0; i < mFlowFields.size(); ++i )
+    {
+        FlowField* pFlowField = mFlowFields[i];
+
+        if ( !pFlowField->mRefresh || pFlowField->mPending )
+            continue;
+
+        Request* pRequest = new Request();
+        pRequest->mId = pFlowField->mId;
+        pRequest->mType = Request::REQUEST_FLOW_FIELD;
+        pRequest->mpGrid = mpGrid;
+        pRequest->mStart = pFlowField->mGoal;
+        pRequest->mGoal = pFlowField->mGoal;
+        pRequest->mCallbackId = pFlowField->mCallbackId;
+        pRequest->mFound = false;
+        mpGrid->mReferenceCount++;
+
+        pFlowField->mRefresh = false;
+        pFlowField->mPending = true;
+
+        submitRequest( pRequest );
+    }
+
+    // Serve the requests here if there are no workers.
+    if ( mWorkers.size() == 0 )
+    {
+        Request* pRequest;
+        while ( (pRequest = popRequest()) != NULL )
+        {
+            processRequest( pRequest, mScratch );
+            completeRequest( pRequest );
+        }
+    }
+
+    dispatchCompletedRequests();
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneNavigation::getWalkable( const Vector2& position ) const
+{
+    if ( !getConfigured() )
+        return true;
+
+    S32 x, y;
+    if ( !mpGrid->getCell( position, x, y ) )
+        return false;
+
+    return mpGrid->getWalkable( x, y );
+}
+
+//-----------------------------------------------------------------------------
+
+U32 SceneNavigation::findPath( const Vector2& start, const Vector2& goal, const SimObjectId callbackId )
+{
+    if ( !getConfigured() )
+    {
+        Con::warnf( "SceneNavigation::findPath() - The navigation grid has not been configured." );
+        return 0;
+    }
+
+    Request* pRequest = new Request();
+    pRequest->mId = ++mMasterRequestId;
+    pRequest->mType = Request::REQUEST_PATH;
+    pRequest->mpGrid = mpGrid;
+    pRequest->mStart = start;
+    pRequest->mGoal = goal;
+    pRequest->mCallbackId = callbackId;
+    pRequest->mFound = false;
+    mpGrid->mReferenceCount++;
+
+    submitRequest( pRequest );
+
+    return pRequest->mId;
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneNavigation::findPathImmediate( const Vector2& start, const Vector2& goal, Vector<Vector2>& path )
+{
+    if ( !getConfigured() )
+    {
+        Con::warnf( "SceneNavigation::findPathImmediate() - The navigation grid has not been configured." );
+        return false;
+    }
+
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneNavigation_FindPathImmediate);
+
+    // Search the latest static shapes.
+    rebakeDirtyRegions();
+
+    return searchPath( *mpGrid, start, goal, mScratch, path );
+}
+
+//-----------------------------------------------------------------------------
+
+U32 SceneNavigation::createFlowField( const Vector2& goal, const SimObjectId callbackId )
+{
+    if ( !getConfigured() )
+    {
+        Con::warnf( "SceneNavigation::createFlowField() - The navigation grid has not been configured." );
+        return 0;
+    }
+
+    FlowField* pFlowField = new FlowField();
+    pFlowField->mId = ++mMasterRequestId;
+    pFlowField->mGoal = goal;
+    pFlowField->mCallbackId = callbackId;
+    pFlowField->mReady = false;
+    pFlowField->mPending = false;
+    pFlowField->mRefresh = true;
+    mFlowFields.push_back( pFlowField );
+
+    return pFlowField->mId;
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneNavigation::getFlowDirection( const U32 fieldId, const Vector2& position, Vector2& direction ) const
+{
+    direction.SetZero();
+
+    const S32 fieldIndex = findFlowField( fieldId );
+    if ( fieldIndex == -1 || !mFlowFields[fieldIndex]->mReady )
+        return false;
+
+    const FlowField* pFlowField = mFlowFields[fieldIndex];
+
+    S32 x, y;
+    if ( !mpGrid->getCell( position, x, y ) )
+        return false;
+
+    const U8 flowCode = pFlowField->mFlowCodes[ mpGrid->getCellIndex( x, y ) ];
+
+    if ( flowCode == FLOW_UNREACHABLE )
+        return false;
+
+    // Head straight for the goal once in its cell.
+    if ( flowCode == FLOW_GOAL )
+    {
+        direction = pFlowField->mGoal - position;
+        if ( direction.Normalize() < b2_epsilon )
+            direction.SetZero();
+        return true;
+    }
+
+    direction.Set( (F32)sNeighborX[flowCode], (F32)sNeighborY[flowCode] );
+    if ( (flowCode & 1) != 0 )
+        direction *= M_SQRTHALF_F;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneNavigation::deleteFlowField( const U32 fieldId )
+{
+    const S32 fieldIndex = findFlowField( fieldId );
+    if ( fieldIndex == -1 )
+        return false;
+
+    // Any request in flight for the field is discarded when it completes.
+    delete mFlowFields[fieldIndex];
+    mFlowFields.erase_fast( fieldIndex );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 SceneNavigation::getPendingRequestCount( void )
+{
+    MutexHandle mutexHandle;
+    mutexHandle.lock( &mRequestMutex, true );
+
+    return (U32)(mPendingRequests.size() + mCompletedRequests.size());
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneNavigation::ReportFixture( b2Fixture* fixture )
+{
+    // Only solid static shapes block navigation.
+    b2Body* pBody = fixture->GetBody();
+    if ( fixture->IsSensor() || pBody->GetType() != b2_staticBody )
+        return true;
+
+    // If not the correct proxy then ignore.
+    PhysicsProxy* pPhysicsProxy = static_cast<PhysicsProxy*>(pBody->GetUserData());
+    if ( pPhysicsProxy->getPhysicsProxyType() != PhysicsProxy::PHYSIC_PROXY_SCENEOBJECT )
+        return true;
+
+    // Check the layer and group masks.
+    SceneObject* pSceneObject = static_cast<SceneObject*>(pPhysicsProxy);
+    if ( (pSceneObject->getSceneLayerMask() & mSceneLayerMask) == 0 || (pSceneObject->getSceneGroupMask() & mSceneGroupMask) == 0 )
+        return true;
+
+    mBakeFixtures.push_back( fixture );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneNavigation::formatPath( const Vector<Vector2>& path, char* pBuffer, const U32 bufferSize )
+{
+    U32 bufferOffset = 0;
+    pBuffer[0] = 0;
+
+    for ( S32 i = 0; i < path.size(); ++i )
+    {
+        bufferOffset += dSprintf( pBuffer + bufferOffset, bufferSize - bufferOffset, i == 0 ? "%g %g" : " %g %g", path[i].x, path[i].y );
+
+        if ( bufferOffset >= bufferSize - 1 )
+            break;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+static U32 getPrunedNeighbors( const SceneNavigation::Grid& grid, const S32 x, const S32 y, const S32 parentCell, S32* pNeighborX, S32* pNeighborY )
+{
+    U32 count = 0;
+
+    // The start node expands in every direction without cutting corners.
+    if ( parentCell < 0 )
+    {
+        for ( U32 n = 0; n < 8; ++n )
+        {
+            const S32 dx = sNeighborX[n];
+            const S32 dy = sNeighborY[n];
+
+            if ( (n & 1) != 0 && (!grid.getWalkable( x + dx, y ) || !grid.getWalkable( x, y + dy )) )
+                continue;
+
+            pNeighborX[count] = x + dx;
+            pNeighborY[count] = y + dy;
+            count++;
+        }
+
+        return count;
+    }
+
+    // Direction of travel.
+    const S32 dx = mClamp( x - (parentCell % grid.mWidth), -1, 1 );
+    const S32 dy = mClamp( y - (parentCell / grid.mWidth), -1, 1 );
+
+    if ( dx != 0 && dy != 0 )
+    {
+        const bool walkableY = grid.getWalkable( x, y + dy );
+        const bool walkableX = grid.getWalkable( x + dx, y );
+
+        if ( walkableY ) { pNeighborX[count] = x; pNeighborY[count] = y + dy; count++; }
+        if ( walkableX ) { pNeighborX[count] = x + dx; pNeighborY[count] = y; count++; }
+        if ( walkableX && walkableY ) { pNeighborX[count] = x + dx; pNeighborY[count] = y + dy; count++; }
+    }
+    else if ( dx != 0 )
+    {
+        const bool walkableNext = grid.getWalkable( x + dx, y );
+        const bool walkableUp = grid.getWalkable( x, y + 1 );
+        const bool walkableDown = grid.getWalkable( x, y - 1 );
+
+        if ( walkableNext )
+        {
+            pNeighborX[count] = x + dx; pNeighborY[count] = y; count++;
+            if ( walkableUp ) { pNeighborX[count] = x + dx; pNeighborY[count] = y + 1; count++; }
+            if ( walkableDown ) { pNeighborX[count] = x + dx; pNeighborY[count] = y - 1; count++; }
+        }
+        if ( walkableUp ) { pNeighborX[count] = x; pNeighborY[count] = y + 1; count++; }
+        if ( walkableDown ) { pNeighborX[count] = x; pNeighborY[count] = y - 1; count++; }
+    }
+    else
+    {
+        const bool walkableNext = grid.getWalkable( x, y + dy );
+        const bool walkableRight = grid.getWalkable( x + 1, y );
+        const bool walkableLeft = grid.getWalkable( x - 1, y );
+
+        if ( walkableNext )
+        {
+            pNeighborX[count] = x; pNeighborY[count] = y + dy; count++;
+            if ( walkableRight ) { pNeighborX[count] = x + 1; pNeighborY[count] = y + dy; count++; }
+            if ( walkableLeft ) { pNeighborX[count] = x - 1; pNeighborY[count] = y + dy; count++; }
+        }
+        if ( walkableRight ) { pNeighborX[count] = x + 1; pNeighborY[count] = y; count++; }
+        if ( walkableLeft ) { pNeighborX[count] = x - 1; pNeighborY[count] = y; count++; }
+    }
+
+    return count;
+}
+
+//-----------------------------------------------------------------------------
+
+static S32 jump( const SceneNavigation::Grid& grid, S32 x, S32 y, const S32 dx, const S32 dy, const S32 goalX, const S32 goalY )
+{
+    while ( true )
+    {
+        if ( !grid.getWalkable( x, y ) )
+            return -1;
+
+        if ( x == goalX && y == goalY )
+            return grid.getCellIndex( x, y );
+
+        if ( dx != 0 && dy != 0 )
+        {
+            // A diagonal stops where either straight scan finds a jump point.
+            if ( jump( grid, x + dx, y, dx, 0, goalX, goalY ) != -1 || jump( grid, x, y + dy, 0, dy, goalX, goalY ) != -1 )
+                return grid.getCellIndex( x, y );
+
+            // Corners are never cut.
+            if ( !grid.getWalkable( x + dx, y ) || !grid.getWalkable( x, y + dy ) )
+                return -1;
+        }
+        else if ( dx != 0 )
+        {
+            // Forced neighbors.
+            if ( (grid.getWalkable( x, y - 1 ) && !grid.getWalkable( x - dx, y - 1 )) || (grid.getWalkable( x, y + 1 ) && !grid.getWalkable( x - dx, y + 1 )) )
+                return grid.getCellIndex( x, y );
+        }
+        else
+        {
+            // Forced neighbors.
+            if ( (grid.getWalkable( x - 1, y ) && !grid.getWalkable( x - 1, y - dy )) || (grid.getWalkable( x + 1, y ) && !grid.getWalkable( x + 1, y - dy )) )
+                return grid.getCellIndex( x, y );
+        }
+
+        x += dx;
+        y += dy;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+static bool getLineOfSight( const SceneNavigation::Grid& grid, const Vector2& from, const Vector2& to )
+{
+    // Grid-space end points.
+    const F32 fromX = (from.x - grid.mOrigin.x) / grid.mCellSize;
+    const F32 fromY = (from.y - grid.mOrigin.y) / grid.mCellSize;
+    const F32 toX = (to.x - grid.mOrigin.x) / grid.mCellSize;
+    const F32 toY = (to.y - grid.mOrigin.y) / grid.mCellSize;
+
+    S32 x = (S32)mFloor( fromX );
+    S32 y = (S32)mFloor( fromY );
+    const S32 endX = (S32)mFloor( toX );
+    const S32 endY = (S32)mFloor( toY );
+
+    const F32 deltaX = toX - fromX;
+    const F32 deltaY = toY - fromY;
+    const S32 stepX = deltaX > 0.0f ? 1 : (deltaX < 0.0f ? -1 : 0);
+    const S32 stepY = deltaY > 0.0f ? 1 : (deltaY < 0.0f ? -1 : 0);
+    const F32 tDeltaX = stepX != 0 ? mFabs( 1.0f / deltaX ) : F32_MAX;
+    const F32 tDeltaY = stepY != 0 ? mFabs( 1.0f / deltaY ) : F32_MAX;
+    F32 tMaxX = stepX > 0 ? ((F32)(x + 1) - fromX) * tDeltaX : (stepX < 0 ? (fromX - (F32)x) * tDeltaX : F32_MAX);
+    F32 tMaxY = stepY > 0 ? ((F32)(y + 1) - fromY) * tDeltaY : (stepY < 0 ? (fromY - (F32)y) * tDeltaY : F32_MAX);
+
+    // Walk the cells crossed by the segment.  The first cell is where the agent already stands.
+    S32 steps = mAbs( endX - x ) + mAbs( endY - y );
+    while ( steps > 0 )
+    {
+        if ( tMaxX < tMaxY )
+        {
+            x += stepX;
+            tMaxX += tDeltaX;
+            steps--;
+        }
+        else if ( tMaxY < tMaxX )
+        {
+            y += stepY;
+            tMaxY += tDeltaY;
+            steps--;
+        }
+        else
+        {
+            // Passing exactly through a corner needs both sides open.
+            if ( !grid.getWalkable( x + stepX, y ) || !grid.getWalkable( x, y + stepY ) )
+                return false;
+
+            x += stepX;
+            y += stepY;
+            tMaxX += tDeltaX;
+            tMaxY += tDeltaY;
+            steps -= 2;
+        }
+
+        if ( !grid.getWalkable( x, y ) )
+            return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneNavigation::searchPath( const Grid& grid, const Vector2& start, const Vector2& goal, SearchScratch& scratch, Vector<Vector2>& path )
+{
+    path.clear();
+
+    // Fetch the end cells.
+    S32 startX, startY, goalX, goalY;
+    if ( !grid.getCell( start, startX, startY ) || !grid.getCell( goal, goalX, goalY ) || !grid.getWalkable( goalX, goalY ) )
+        return false;
+
+    const S32 startCell = grid.getCellIndex( startX, startY );
+    const S32 goalCell = grid.getCellIndex( goalX, goalY );
+
+    if ( startCell == goalCell )
+    {
+        path.push_back( start );
+        path.push_back( goal );
+        return true;
+    }
+
+    scratch.prepare( grid );
+    const U32 visitKey = scratch.mVisitKey;
+
+    scratch.mCost[startCell] = 0.0f;
+    scratch.mParent[startCell] = -1;
+    scratch.mVisited[startCell] = visitKey;
+    scratch.pushOpen( getOctileDistance( startX, startY, goalX, goalY ), startCell );
+
+    S32 neighborX[8];
+    S32 neighborY[8];
+
+    // Jump point search.
+    bool found = false;
+    while ( scratch.mOpen.size() > 0 )
+    {
+        const S32 cell = scratch.popOpen();
+
+        if ( scratch.mClosed[cell] == visitKey )
+            continue;
+
+        scratch.mClosed[cell] = visitKey;
+
+        if ( cell == goalCell )
+        {
+            found = true;
+            break;
+        }
+
+        const S32 x = cell % grid.mWidth;
+        const S32 y = cell / grid.mWidth;
+        const U32 neighborCount = getPrunedNeighbors( grid, x, y, scratch.mParent[cell], neighborX, neighborY );
+
+        for ( U32 n = 0; n < neighborCount; ++n )
+        {
+            const S32 jumpCell = jump( grid, neighborX[n], neighborY[n], neighborX[n] - x, neighborY[n] - y, goalX, goalY );
+
+            if ( jumpCell == -1 || scratch.mClosed[jumpCell] == visitKey )
+                continue;
+
+            const S32 jumpX = jumpCell % grid.mWidth;
+            const S32 jumpY = jumpCell / grid.mWidth;
+            const F32 cost = scratch.mCost[cell] + getOctileDistance( x, y, jumpX, jumpY );
+
+            if ( scratch.mVisited[jumpCell] != visitKey || cost < scratch.mCost[jumpCell] )
+            {
+                scratch.mVisited[jumpCell] = visitKey;
+                scratch.mCost[jumpCell] = cost;
+                scratch.mParent[jumpCell] = cell;
+                scratch.pushOpen( cost + getOctileDistance( jumpX, jumpY, goalX, goalY ), jumpCell );
+            }
+        }
+    }
+
+    if ( !found )
+        return false;
+
+    // Gather the jump points from the goal back to the start.
+    Vector<Vector2> jumpPoints;
+    for ( S32 cell = goalCell; cell != -1; cell = scratch.mParent[cell] )
+        jumpPoints.push_back( grid.getCellCenter( cell % grid.mWidth, cell / grid.mWidth ) );
+
+    jumpPoints.first() = goal;
+    jumpPoints.last() = start;
+
+    // Pull the path taut where there is line-of-sight.
+    path.push_back( start );
+    S32 anchor = jumpPoints.size() - 1;
+    for ( S32 i = anchor - 2; i >= 0; --i )
+    {
+        if ( getLineOfSight( grid, jumpPoints[anchor], jumpPoints[i] ) )
+            continue;
+
+        anchor = i + 1;
+        path.push_back( jumpPoints[anchor] );
+    }
+    path.push_back( goal );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneNavigation::buildFlowField( const Grid& grid, const Vector2& goal, SearchScratch& scratch, Vector<U8>& flowCodes )
+{
+    const U32 cellCount = (U32)(grid.mWidth * grid.mHeight);
+
+    flowCodes.setSize( cellCount );
+    dMemset( flowCodes.address(), FLOW_UNREACHABLE, flowCodes.memSize() );
+
+    S32 goalX, goalY;
+    if ( !grid.getCell( goal, goalX, goalY ) || !grid.getWalkable( goalX, goalY ) )
+        return;
+
+    const S32 goalCell = grid.getCellIndex( goalX, goalY );
+
+    scratch.prepare( grid );
+    const U32 visitKey = scratch.mVisitKey;
+
+    scratch.mCost[goalCell] = 0.0f;
+    scratch.mParent[goalCell] = -1;
+    scratch.mVisited[goalCell] = visitKey;
+    scratch.pushOpen( 0.0f, goalCell );
+
+    // Integrate the cost outward from the goal.
+    while ( scratch.mOpen.size() > 0 )
+    {
+        const S32 cell = scratch.popOpen();
+
+        if ( scratch.mClosed[cell] == visitKey )
+            continue;
+
+        scratch.mClosed[cell] = visitKey;
+
+        const S32 x = cell % grid.mWidth;
+        const S32 y = cell / grid.mWidth;
+
+        // Point back along the cheapest route.
+        const S32 parentCell = scratch.mParent[cell];
+        if ( parentCell == -1 )
+        {
+            flowCodes[cell] = FLOW_GOAL;
+        }
+        else
+        {
+            const S32 dx = (parentCell % grid.mWidth) - x;
+            const S32 dy = (parentCell / grid.mWidth) - y;
+            flowCodes[cell] = sNeighborCode[ (dy + 1) * 3 + (dx + 1) ];
+        }
+
+        for ( U32 n = 0; n < 8; ++n )
+        {
+            const S32 neighborX = x + sNeighborX[n];
+            const S32 neighborY = y + sNeighborY[n];
+
+            if ( !grid.getWalkable( neighborX, neighborY ) )
+                continue;
+
+            // Corners are never cut.
+            if ( (n & 1) != 0 && (!grid.getWalkable( neighborX, y ) || !grid.getWalkable( x, neighborY )) )
+                continue;
+
+            const S32 neighborCell = grid.getCellIndex( neighborX, neighborY );
+            if ( scratch.mClosed[neighborCell] == visitKey )
+                continue;
+
+            const F32 cost = scratch.mCost[cell] + sNeighborCost[n];
+            if ( scratch.mVisited[neighborCell] != visitKey || cost < scratch.mCost[neighborCell] )
+            {
+                scratch.mVisited[neighborCell] = visitKey;
+                scratch.mCost[neighborCell] = cost;
+                scratch.mParent[neighborCell] = cell;
+                scratch.pushOpen( cost, neighborCell );
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneNavigation::startWorkers( void )
+{
+#if defined(TORQUE_OS_EMSCRIPTEN)
+    // No threads so requests are served during the scene update.
+    const S32 workerCount = 0;
+#else
+    const S32 workerCount = mClamp( Con::getIntVariable( "$pref::T2D::navigationWorkerThreads", 2 ), 0, 8 );
+#endif
+
+    for ( S32 i = 0; i < workerCount; ++i )
+    {
+        SceneNavigationWorker* pWorker = new SceneNavigationWorker( this );
+        pWorker->start();
+        mWorkers.push_back( pWorker );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneNavigation::stopWorkers( void )
+{
+    if ( mWorkers.size() == 0 )
+        return;
+
+    // Flag the workers then wake them all.
+    for ( S32 i = 0; i < mWorkers.size(); ++i )
+        mWorkers[i]->stop();
+
+    for ( S32 i = 0; i < mWorkers.size(); ++i )
+        mRequestSemaphore.release();
+
+    for ( S32 i = 0; i < mWorkers.size(); ++i )
+    {
+        mWorkers[i]->join();
+        delete mWorkers[i];
+    }
+
+    mWorkers.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneNavigation::bakeRegion( Grid* pGrid, const S32 minX, const S32 minY, const S32 maxX, const S32 maxY )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneNavigation_BakeRegion);
+
+    const S32 width = pGrid->mWidth;
+    const F32 cellSize = pGrid->mCellSize;
+    const Vector2& origin = pGrid->mOrigin;
+
+    // Clear the region.
+    for ( S32 y = minY; y <= maxY; ++y )
+        dMemset( pGrid->mBlocked.address() + y * width + minX, 0, maxX - minX + 1 );
+
+    // Gather the static fixtures that can reach the region.
+    b2AABB queryAABB;
+    queryAABB.lowerBound.Set( origin.x + (F32)minX * cellSize - mAgentRadius, origin.y + (F32)minY * cellSize - mAgentRadius );
+    queryAABB.upperBound.Set( origin.x + (F32)(maxX + 1) * cellSize + mAgentRadius, origin.y + (F32)(maxY + 1) * cellSize + mAgentRadius );
+
+    mBakeFixtures.clear();
+    mpScene->getWorld()->QueryAABB( this, queryAABB );
+
+    // Fixtures with several children are reported once per child.
+    mBakeFixtures.sort( compareFixtures );
+
+    // Block the cells whose agent-sized box overlaps a shape.
+    const F32 halfExtent = cellSize * 0.5f + mAgentRadius;
+    b2PolygonShape cellShape;
+    b2Transform identityTransform;
+    identityTransform.SetIdentity();
+
+    for ( S32 i = 0; i < mBakeFixtures.size(); ++i )
+    {
+        b2Fixture* pFixture = mBakeFixtures[i];
+
+        if ( i > 0 && pFixture == mBakeFixtures[i - 1] )
+            continue;
+
+        const b2Shape* pShape = pFixture->GetShape();
+        const b2Transform& transform = pFixture->GetBody()->GetTransform();
+        const S32 childCount = pShape->GetChildCount();
+
+        for ( S32 childIndex = 0; childIndex < childCount; ++childIndex )
+        {
+            b2AABB shapeAABB;
+            pShape->ComputeAABB( &shapeAABB, transform, childIndex );
+
+            const S32 cellMinX = getMax( minX, (S32)mFloor( (shapeAABB.lowerBound.x - mAgentRadius - origin.x) / cellSize ) );
+            const S32 cellMinY = getMax( minY, (S32)mFloor( (shapeAABB.lowerBound.y - mAgentRadius - origin.y) / cellSize ) );
+            const S32 cellMaxX = getMin( maxX, (S32)mFloor( (shapeAABB.upperBound.x + mAgentRadius - origin.x) / cellSize ) );
+            const S32 cellMaxY = getMin( maxY, (S32)mFloor( (shapeAABB.upperBound.y + mAgentRadius - origin.y) / cellSize ) );
+
+            for ( S32 y = cellMinY; y <= cellMaxY; ++y )
+            {
+                for ( S32 x = cellMinX; x <= cellMaxX; ++x )
+                {
+                    U8& blocked = pGrid->mBlocked[ y * width + x ];
+                    if ( blocked != 0 )
+                        continue;
+
+                    cellShape.SetAsBox( halfExtent, halfExtent, pGrid->getCellCenter( x, y ), 0.0f );
+
+                    if ( b2TestOverlap( &cellShape, 0, pShape, childIndex, identityTransform, transform ) )
+                        blocked = 1;
+                }
+            }
+        }
+    }
+
+    mBakeFixtures.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneNavigation::rebakeDirtyRegions( void )
+{
+    if ( mDirtyRegions.size() == 0 )
+        return;
+
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneNavigation_RebakeDirtyRegions);
+
+    // Copy the grid if queued requests are still searching it.
+    if ( mpGrid->mReferenceCount > 1 )
+    {
+        Grid* pGrid = new Grid( *mpGrid );
+        pGrid->mReferenceCount = 1;
+        releaseGrid( mpGrid );
+        mpGrid = pGrid;
+    }
+
+    const F32 cellSize = mpGrid->mCellSize;
+    const Vector2& origin = mpGrid->mOrigin;
+
+    for ( S32 i = 0; i < mDirtyRegions.size(); ++i )
+    {
+        const b2AABB& region = mDirtyRegions[i];
+
+        // Cells whose agent-sized box can reach the region.
+        const S32 minX = getMax( 0, (S32)mFloor( (region.lowerBound.x - mAgentRadius - origin.x) / cellSize ) );
+        const S32 minY = getMax( 0, (S32)mFloor( (region.lowerBound.y - mAgentRadius - origin.y) / cellSize ) );
+        const S32 maxX = getMin( mpGrid->mWidth - 1, (S32)mFloor( (region.upperBound.x + mAgentRadius - origin.x) / cellSize ) );
+        const S32 maxY = getMin( mpGrid->mHeight - 1, (S32)mFloor( (region.upperBound.y + mAgentRadius - origin.y) / cellSize ) );
+
+        if ( minX > maxX || minY > maxY )
+            continue;
+
+        bakeRegion( mpGrid, minX, minY, maxX, maxY );
+    }
+
+    mDirtyRegions.clear();
+
+    // Flow fields need rebuilding against the new grid.
+    for ( S32 i = 0; i < mFlowFields.size(); ++i )
+        mFlowFields[i]->mRefresh = true;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneNavigation::submitRequest( Request* pRequest )
+{
+    mRequestMutex.lock();
+    mPendingRequests.push_back( pRequest );
+    mRequestMutex.unlock();
+
+    // Wake a worker.
+    if ( mWorkers.size() > 0 )
+        mRequestSemaphore.release();
+}
+
+//-----------------------------------------------------------------------------
+
+SceneNavigation::Request* SceneNavigation::popRequest( void )
+{
+    MutexHandle mutexHandle;
+    mutexHandle.lock( &mRequestMutex, true );
+
+    if ( mPendingRequests.size() == 0 )
+        return NULL;
+
+    Request* pRequest = mPendingRequests.front();
+    mPendingRequests.pop_front();
+
+    return pRequest;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneNavigation::completeRequest( Request* pRequest )
+{
+    mRequestMutex.lock();
+    mCompletedRequests.push_back( pRequest );
+    mRequestMutex.unlock();
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneNavigation::dispatchCompletedRequests( void )
+{
+    // Take the completed requests.
+    Vector<Request*> completedRequests;
+    mRequestMutex.lock();
+    completedRequests = mCompletedRequests;
+    mCompletedRequests.clear();
+    mRequestMutex.unlock();
+
+    for ( S32 i = 0; i < completedRequests.size(); ++i )
+    {
+        Request* pRequest = completedRequests[i];
+
+        if ( pRequest->mType == Request::REQUEST_FLOW_FIELD )
+        {
+            // Ignore if the field was deleted while in flight.
+            const S32 fieldIndex = findFlowField( pRequest->mId );
+            if ( fieldIndex != -1 )
+            {
+                FlowField* pFlowField = mFlowFields[fieldIndex];
+                pFlowField->mFlowCodes = pRequest->mFlowCodes;
+                pFlowField->mReady = true;
+                pFlowField->mPending = false;
+
+                SimObject* pCallbackObject = pRequest->mCallbackId == 0 ? mpScene : Sim::findObject( pRequest->mCallbackId );
+                if ( pCallbackObject != NULL )
+                    Con::executef( pCallbackObject, 2, "onNavigationFlowField", Con::getIntArg( pRequest->mId ) );
+            }
+        }
+        else
+        {
+            SimObject* pCallbackObject = pRequest->mCallbackId == 0 ? mpScene : Sim::findObject( pRequest->mCallbackId );
+            if ( pCallbackObject != NULL )
+            {
+                // Format the path.
+                const U32 bufferSize = pRequest->mPath.size() * 32 + 1;
+                FrameTemp<char> pathBuffer( bufferSize );
+                formatPath( pRequest->mPath, ~pathBuffer, bufferSize );
+
+                Con::executef( pCallbackObject, 3, "onNavigationPath", Con::getIntArg( pRequest->mId ), ~pathBuffer );
+            }
+        }
+
+        deleteRequest( pRequest );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneNavigation::deleteRequest( Request* pRequest )
+{
+    releaseGrid( pRequest->mpGrid );
+    delete pRequest;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneNavigation::releaseGrid( Grid* pGrid )
+{
+    if ( pGrid == NULL )
+        return;
+
+    if ( --pGrid->mReferenceCount == 0 )
+        delete pGrid;
+}
+
+//-----------------------------------------------------------------------------
+
+S32 SceneNavigation::findFlowField( const U32 fieldId ) const
+{
+    for ( S32 i = 0; i < mFlowFields.size(); ++i )
+    {
+        if ( mFlowFields[i]->mId == fieldId )
+            return i;
+    }
+
+    return -1;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneNavigation::processRequest( Request* pRequest, SearchScratch& scratch )
+{
+    if ( pRequest->mType == Request::REQUEST_FLOW_FIELD )
+    {
+        buildFlowField( *pRequest->mpGrid, pRequest->mGoal, scratch, pRequest->mFlowCodes );
+        pRequest->mFound = true;
+        return;
+    }
+
+    pRequest->mFound = searchPath( *pRequest->mpGrid, pRequest->mStart, pRequest->mGoal, scratch, pRequest->mPath );
+}
@@ -0,0 +1,229 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _SCENE_NAVIGATION_H_
+#define _SCENE_NAVIGATION_H_
+
+#ifndef _VECTOR2_H_
+#include "2d/core/Vector2.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+#include "platform/threads/mutex.h"
+#endif
+
+#ifndef _PLATFORM_THREAD_SEMAPHORE_H_
+#include "platform/threads/semaphore.h"
+#endif
+
+#ifndef _SIMBASE_H_
+#include "sim/simBase.h"
+#endif
+
+#ifndef BOX2D_H
+#include "Box2D/Box2D.h"
+#endif
+
+///-----------------------------------------------------------------------------
+
+class Scene;
+class SceneObject;
+class SceneNavigationWorker;
+
+///-----------------------------------------------------------------------------
+
+class SceneNavigation : public b2QueryCallback
+{
+    friend class SceneNavigationWorker;
+
+public:
+    /// Flow-field cell codes.  Codes below FLOW_GOAL index the neighbor to move toward.
+    enum FlowCode
+    {
+        FLOW_GOAL           = 8,
+        FLOW_UNREACHABLE    = 0xFF,
+    };
+
+    /// Baked walkability grid.
+    /// The grid is copied-on-write so queued requests keep searching the snapshot they were issued against.
+    struct Grid
+    {
+        Grid() :
+            mReferenceCount( 0 ),
+            mOrigin( 0.0f, 0.0f ),
+            mCellSize( 1.0f ),
+            mWidth( 0 ),
+            mHeight( 0 )
+        {
+        }
+
+        inline bool getWalkable( const S32 x, const S32 y ) const { return x >= 0 && y >= 0 && x < mWidth && y < mHeight && mBlocked[ y * mWidth + x ] == 0; }
+        inline S32 getCellIndex( const S32 x, const S32 y ) const { return y * mWidth + x; }
+        inline Vector2 getCellCenter( const S32 x, const S32 y ) const { return Vector2( mOrigin.x + ((F32)x + 0.5f) * mCellSize, mOrigin.y + ((F32)y + 0.5f) * mCellSize ); }
+        inline bool getCell( const Vector2& position, S32& x, S32& y ) const
+        {
+            x = (S32)mFloor( (position.x - mOrigin.x) / mCellSize );
+            y = (S32)mFloor( (position.y - mOrigin.y) / mCellSize );
+            return x >= 0 && y >= 0 && x < mWidth && y < mHeight;
+        }
+
+        U32         mReferenceCount;
+        Vector2     mOrigin;
+        F32         mCellSize;
+        S32         mWidth;
+        S32         mHeight;
+        Vector<U8>  mBlocked;
+    };
+
+    /// Queued path or flow-field request.
+    struct Request
+    {
+        enum RequestType
+        {
+            REQUEST_PATH,
+            REQUEST_FLOW_FIELD,
+        };
+
+        U32             mId;
+        RequestType     mType;
+        Grid*           mpGrid;
+        Vector2         mStart;
+        Vector2         mGoal;
+        SimObjectId     mCallbackId;
+        bool            mFound;
+        Vector<Vector2> mPath;
+        Vector<U8>      mFlowCodes;
+    };
+
+    /// Flow field toward a goal.  Any number of agents can sample the same field.
+    struct FlowField
+    {
+        U32             mId;
+        Vector2         mGoal;
+        SimObjectId     mCallbackId;
+        bool            mReady;
+        bool            mPending;
+        bool            mRefresh;
+        Vector<U8>      mFlowCodes;
+    };
+
+    /// Search scratch.  Each worker owns one so searches never share state.
+    struct SearchScratch
+    {
+        struct OpenNode
+        {
+            F32 mCost;
+            S32 mCell;
+        };
+
+        SearchScratch() : mVisitKey( 0 ) {}
+
+        void prepare( const Grid& grid );
+        void pushOpen( const F32 cost, const S32 cell );
+        S32 popOpen( void );
+
+        Vector<F32>         mCost;
+        Vector<S32>         mParent;
+        Vector<U32>         mVisited;
+        Vector<U32>         mClosed;
+        Vector<OpenNode>    mOpen;
+        U32                 mVisitKey;
+    };
+
+public:
+    SceneNavigation( Scene* pScene );
+    virtual ~SceneNavigation();
+
+    /// Grid configuration.
+    bool            configure( const b2AABB& area, const F32 cellSize, const F32 agentRadius, const U32 sceneGroupMask, const U32 sceneLayerMask );
+    void            clear( void );
+    inline bool     getConfigured( void ) const                 { return mpGrid != NULL; }
+    inline F32      getCellSize( void ) const                   { return mpGrid == NULL ? 0.0f : mpGrid->mCellSize; }
+    inline F32      getAgentRadius( void ) const                { return mAgentRadius; }
+    inline U32      getWorkerCount( void ) const                { return (U32)mWorkers.size(); }
+
+    /// Incremental baking.
+    void            markDirty( const b2AABB& aabb );
+    void            update( void );
+
+    /// Queries.
+    bool            getWalkable( const Vector2& position ) const;
+    U32             findPath( const Vector2& start, const Vector2& goal, const SimObjectId callbackId );
+    bool            findPathImmediate( const Vector2& start, const Vector2& goal, Vector<Vector2>& path );
+    U32             createFlowField( const Vector2& goal, const SimObjectId callbackId );
+    bool            getFlowDirection( const U32 fieldId, const Vector2& position, Vector2& direction ) const;
+    bool            deleteFlowField( const U32 fieldId );
+    U32             getPendingRequestCount( void );
+
+    /// Static-shape gathering.
+    virtual bool    ReportFixture( b2Fixture* fixture );
+
+    /// Searches.
+    static bool     searchPath( const Grid& grid, const Vector2& start, const Vector2& goal, SearchScratch& scratch, Vector<Vector2>& path );
+    static void     buildFlowField( const Grid& grid, const Vector2& goal, SearchScratch& scratch, Vector<U8>& flowCodes );
+    static void     formatPath( const Vector<Vector2>& path, char* pBuffer, const U32 bufferSize );
+
+private:
+    void            startWorkers( void );
+    void            stopWorkers( void );
+    void            bakeRegion( Grid* pGrid, const S32 minX, const S32 minY, const S32 maxX, const S32 maxY );
+    void            rebakeDirtyRegions( void );
+    void            submitRequest( Request* pRequest );
+    Request*        popRequest( void );
+    void            completeRequest( Request* pRequest );
+    void            dispatchCompletedRequests( void );
+    void            deleteRequest( Request* pRequest );
+    void            releaseGrid( Grid* pGrid );
+    S32             findFlowField( const U32 fieldId ) const;
+
+    static void     processRequest( Request* pRequest, SearchScratch& scratch );
+
+private:
+    Scene*                          mpScene;
+    Grid*                           mpGrid;
+    F32                             mAgentRadius;
+    U32                             mSceneGroupMask;
+    U32                             mSceneLayerMask;
+    U32                             mMasterRequestId;
+
+    /// Dirty regions awaiting a rebake.
+    Vector<b2AABB>                  mDirtyRegions;
+
+    /// Static fixtures gathered while baking.
+    Vector<b2Fixture*>              mBakeFixtures;
+
+    /// Flow fields.
+    Vector<FlowField*>              mFlowFields;
+
+    /// Request queues shared with the workers.
+    Mutex                           mRequestMutex;
+    Semaphore                       mRequestSemaphore;
+    Vector<Request*>                mPendingRequests;
+    Vector<Request*>                mCompletedRequests;
+    Vector<SceneNavigationWorker*>  mWorkers;
+
+    /// Main-thread scratch for immediate searches.
+    SearchScratch                   mScratch;
+};
+
+#endif // _SCENE_NAVIGATION_H_
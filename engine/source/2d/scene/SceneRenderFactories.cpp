@@ -30,5 +30,4 @@
 
 //-----------------------------------------------------------------------------
 
-FactoryCache<SceneRenderRequest> SceneRenderRequestFactory;
 FactoryCache<SceneRenderQueue> SceneRenderQueueFactory;   
@@ -34,7 +34,6 @@ class SceneRenderQueue;
 
 //-----------------------------------------------------------------------------
 
-extern FactoryCache<SceneRenderRequest> SceneRenderRequestFactory;
 extern FactoryCache<SceneRenderQueue> SceneRenderQueueFactory;
 
 #endif // _SCENE_RENDER_FACTORIES_H_
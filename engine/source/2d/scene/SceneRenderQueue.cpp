@@ -81,168 +81,297 @@ const char* SceneRenderQueue::getRenderSortDescription( const RenderSort& sortMo
 
 //-----------------------------------------------------------------------------
 
-S32 QSORT_CALLBACK SceneRenderQueue::layeredNewFrontSort(const void* a, const void* b)
+// Maps a float onto an unsigned key with the same ordering.
+static inline U32 getFloatSortKey( F32 value )
 {
-    // Fetch scene render requests.
-    SceneRenderRequest* pSceneRenderRequestA  = *((SceneRenderRequest**)a);
-    SceneRenderRequest* pSceneRenderRequestB  = *((SceneRenderRequest**)b);
+    // Fold negative zero onto zero so they compare equal.
+    if ( value == 0.0f )
+        value = 0.0f;
 
-    // Use serial Id,
-    return pSceneRenderRequestA->mSerialId - pSceneRenderRequestB->mSerialId;
+    U32 bits;
+    dMemcpy( &bits, &value, sizeof(bits) );
+
+    return (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
 }
-    
+
 //-----------------------------------------------------------------------------
 
-S32 QSORT_CALLBACK SceneRenderQueue::layeredOldFrontSort(const void* a, const void* b)
+// Maps a serial Id onto an unsigned key with the same ordering.
+static inline U32 getSerialSortKey( const S32 serialId )
 {
-    // Fetch scene render requests.
-    SceneRenderRequest* pSceneRenderRequestA  = *((SceneRenderRequest**)a);
-    SceneRenderRequest* pSceneRenderRequestB  = *((SceneRenderRequest**)b);
-
-    // Use reverse serial Id,
-    return pSceneRenderRequestB->mSerialId - pSceneRenderRequestA->mSerialId;
+    return (U32)serialId ^ 0x80000000;
 }
 
 //-----------------------------------------------------------------------------
 
-S32 QSORT_CALLBACK SceneRenderQueue::layeredDepthSort(const void* a, const void* b)
+static S32 QSORT_CALLBACK renderGroupAddressSort(const void* a, const void* b)
 {
-    // Fetch scene render requests.
-    SceneRenderRequest* pSceneRenderRequestA  = *((SceneRenderRequest**)a);
-    SceneRenderRequest* pSceneRenderRequestB  = *((SceneRenderRequest**)b);
-
-    // Fetch depths.
-    const F32 depthA = pSceneRenderRequestA->mDepth;
-    const F32 depthB = pSceneRenderRequestB->mDepth;
+    const uintptr_t renderGroupA = (uintptr_t)*((StringTableEntry*)a);
+    const uintptr_t renderGroupB = (uintptr_t)*((StringTableEntry*)b);
 
-    return depthA < depthB ? 1 : depthA > depthB ? -1 : pSceneRenderRequestA->mSerialId - pSceneRenderRequestB->mSerialId;
+    return renderGroupA < renderGroupB ? -1 : renderGroupA > renderGroupB ? 1 : 0;
 }
 
 //-----------------------------------------------------------------------------
 
-S32 QSORT_CALLBACK SceneRenderQueue::layeredInverseDepthSort(const void* a, const void* b)
+void SceneRenderQueue::sort( void )
 {
-    // Fetch scene render requests.
-    SceneRenderRequest* pSceneRenderRequestA  = *((SceneRenderRequest**)a);
-    SceneRenderRequest* pSceneRenderRequestB  = *((SceneRenderRequest**)b);
+    // Finish if not sorting.
+    if ( mSortMode == RENDER_SORT_OFF || mSortMode == RENDER_SORT_INVALID )
+        return;
 
-    // Fetch depths.
-    const F32 depthA = pSceneRenderRequestA->mDepth;
-    const F32 depthB = pSceneRenderRequestB->mDepth;
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneRenderQueue_Sort);
 
-    return depthA < depthB ? -1 : depthA > depthB ? 1 : pSceneRenderRequestA->mSerialId - pSceneRenderRequestB->mSerialId;
+    // Pack a sort key for each request.
+    calculateSortKeys();
+
+    // Sort the keys.
+    if ( mSortEntries.size() < RADIX_SORT_THRESHOLD )
+        insertionSortEntries();
+    else
+        radixSortEntries();
+
+    // Batching means we don't need strict order.
+    if ( mSortMode == RENDER_SORT_BATCH )
+        mStrictOrderMode = false;
 }
 
 //-----------------------------------------------------------------------------
 
-S32 QSORT_CALLBACK SceneRenderQueue::layerBatchOrderSort(const void* a, const void* b)
+void SceneRenderQueue::calculateSortKeys( void )
 {
-    // Fetch scene render requests.
-    SceneRenderRequest* pSceneRenderRequestA  = *((SceneRenderRequest**)a);
-    SceneRenderRequest* pSceneRenderRequestB  = *((SceneRenderRequest**)b);
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneRenderQueue_CalculateSortKeys);
 
-    // Fetch scene render objects.
-    SceneRenderObject* pSceneRenderObjectA = pSceneRenderRequestA->mpSceneRenderObject;
-    SceneRenderObject* pSceneRenderObjectB = pSceneRenderRequestB->mpSceneRenderObject;
+    const U32 requestCount = (U32)mRenderRequests.size();
 
-    // Fetch batch render isolation.
-    const bool renderIsolatedA = pSceneRenderObjectA->getBatchIsolated();
-    const bool renderIsolatedB = pSceneRenderObjectB->getBatchIsolated();
+    // Fetch the requests.
+    SceneRenderRequest** pRenderRequests = mRenderRequests.address();
 
-    // A not render isolated?
-    if ( !renderIsolatedA )
+    // The high 32-bits hold the primary key and the low 32-bits the serial Id so that ties resolve by age.
+    switch( mSortMode )
     {
-        // Use the serial Id if neither are render isolated.
-        if ( !renderIsolatedB )
-            return pSceneRenderRequestA->mSerialId - pSceneRenderRequestB->mSerialId;
+        case RENDER_SORT_NEWEST:
+            {
+                for ( U32 index = 0; index < requestCount; ++index )
+                    pRenderRequests[index]->mSortKey = getSerialSortKey( pRenderRequests[index]->mSerialId );
+                break;
+            }
+
+        case RENDER_SORT_OLDEST:
+            {
+                for ( U32 index = 0; index < requestCount; ++index )
+                    pRenderRequests[index]->mSortKey = (U32)~getSerialSortKey( pRenderRequests[index]->mSerialId );
+                break;
+            }
+
+        case RENDER_SORT_BATCH:
+            {
+                // Render isolated requests come first.
+                for ( U32 index = 0; index < requestCount; ++index )
+                {
+                    SceneRenderRequest* pRenderRequest = pRenderRequests[index];
+                    const U64 batchKey = pRenderRequest->mpSceneRenderObject->getBatchIsolated() ? 0 : 1;
+                    pRenderRequest->mSortKey = (batchKey << 32) | getSerialSortKey( pRenderRequest->mSerialId );
+                }
+                break;
+            }
+
+        case RENDER_SORT_GROUP:
+            {
+                // Gather the distinct render groups.
+                mSortGroups.clear();
+                StringTableEntry lastRenderGroup = NULL;
+                for ( U32 index = 0; index < requestCount; ++index )
+                {
+                    StringTableEntry renderGroup = pRenderRequests[index]->mRenderGroup;
 
-        // A not render isolated but B is.
-        return 1;
+                    if ( renderGroup == lastRenderGroup )
+                        continue;
+
+                    lastRenderGroup = renderGroup;
+
+                    if ( mSortGroups.find_next( renderGroup ) == -1 )
+                        mSortGroups.push_back( renderGroup );
+                }
+
+                // Order the render groups by address (arbitrary but static).
+                dQsort( mSortGroups.address(), mSortGroups.size(), sizeof(StringTableEntry), renderGroupAddressSort );
+
+                for ( U32 index = 0; index < requestCount; ++index )
+                {
+                    SceneRenderRequest* pRenderRequest = pRenderRequests[index];
+                    const U64 groupKey = getRenderGroupRank( pRenderRequest->mRenderGroup );
+                    pRenderRequest->mSortKey = (groupKey << 32) | getSerialSortKey( pRenderRequest->mSerialId );
+                }
+                break;
+            }
+
+        case RENDER_SORT_XAXIS:
+        case RENDER_SORT_INVERSE_XAXIS:
+            {
+                // Higher x values come first when inverted.
+                const U32 invertMask = mSortMode == RENDER_SORT_INVERSE_XAXIS ? 0xFFFFFFFF : 0;
+                for ( U32 index = 0; index < requestCount; ++index )
+                {
+                    SceneRenderRequest* pRenderRequest = pRenderRequests[index];
+                    const U64 axisKey = getFloatSortKey( pRenderRequest->mWorldPosition.x + pRenderRequest->mSortPoint.x ) ^ invertMask;
+                    pRenderRequest->mSortKey = (axisKey << 32) | getSerialSortKey( pRenderRequest->mSerialId );
+                }
+                break;
+            }
+
+        case RENDER_SORT_YAXIS:
+        case RENDER_SORT_INVERSE_YAXIS:
+            {
+                // Higher y values come first when inverted.
+                const U32 invertMask = mSortMode == RENDER_SORT_INVERSE_YAXIS ? 0xFFFFFFFF : 0;
+                for ( U32 index = 0; index < requestCount; ++index )
+                {
+                    SceneRenderRequest* pRenderRequest = pRenderRequests[index];
+                    const U64 axisKey = getFloatSortKey( pRenderRequest->mWorldPosition.y + pRenderRequest->mSortPoint.y ) ^ invertMask;
+                    pRenderRequest->mSortKey = (axisKey << 32) | getSerialSortKey( pRenderRequest->mSerialId );
+                }
+                break;
+            }
+
+        case RENDER_SORT_ZAXIS:
+        case RENDER_SORT_INVERSE_ZAXIS:
+            {
+                // Higher depths come first unless inverted.
+                const U32 invertMask = mSortMode == RENDER_SORT_ZAXIS ? 0xFFFFFFFF : 0;
+                for ( U32 index = 0; index < requestCount; ++index )
+                {
+                    SceneRenderRequest* pRenderRequest = pRenderRequests[index];
+                    const U64 depthKey = getFloatSortKey( pRenderRequest->mDepth ) ^ invertMask;
+                    pRenderRequest->mSortKey = (depthKey << 32) | getSerialSortKey( pRenderRequest->mSerialId );
+                }
+                break;
+            }
+
+        default:
+            break;
     }
 
-    // B not render isolated?
-    if ( !renderIsolatedB )
+    // Gather the keys into a contiguous array.
+    mSortEntries.setSize( requestCount );
+    SortEntry* pSortEntries = mSortEntries.address();
+    for ( U32 index = 0; index < requestCount; ++index )
     {
-        // A is render isolated.
-        return -1;
+        pSortEntries[index].mSortKey = pRenderRequests[index]->mSortKey;
+        pSortEntries[index].mpRenderRequest = pRenderRequests[index];
     }
-
-    // A and B are render isolated so use serial Id,
-    return pSceneRenderRequestA->mSerialId - pSceneRenderRequestB->mSerialId;
 }
 
 //-----------------------------------------------------------------------------
 
-S32 QSORT_CALLBACK SceneRenderQueue::layerGroupOrderSort(const void* a, const void* b)
+void SceneRenderQueue::radixSortEntries( void )
 {
-    // Fetch scene render requests.
-    SceneRenderRequest* pSceneRenderRequestA  = *((SceneRenderRequest**)a);
-    SceneRenderRequest* pSceneRenderRequestB  = *((SceneRenderRequest**)b);
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneRenderQueue_RadixSort);
 
-    // Fetch the groups.
-    StringTableEntry renderGroupA = pSceneRenderRequestA->mRenderGroup;
-    StringTableEntry renderGroupB = pSceneRenderRequestB->mRenderGroup;
+    const U32 entryCount = (U32)mSortEntries.size();
 
-    // Sort by render group (address, arbitrary but static) and use age if render groups are identical.
-    return renderGroupA == renderGroupB ? pSceneRenderRequestA->mSerialId - pSceneRenderRequestB->mSerialId : renderGroupA < renderGroupB ? -1 : 1;
-}
+    mSortScratch.setSize( entryCount );
 
-//-----------------------------------------------------------------------------
+    SortEntry* pSource = mSortEntries.address();
+    SortEntry* pDestination = mSortScratch.address();
 
-S32 QSORT_CALLBACK SceneRenderQueue::layeredXSortPointSort(const void* a, const void* b)
-{
-    // Fetch scene render requests.
-    SceneRenderRequest* pSceneRenderRequestA  = *((SceneRenderRequest**)a);
-    SceneRenderRequest* pSceneRenderRequestB  = *((SceneRenderRequest**)b);
+    // Build the histograms for all the byte digits in a single pass.
+    U32 histograms[sizeof(U64)][256];
+    dMemset( histograms, 0, sizeof(histograms) );
+    for ( U32 index = 0; index < entryCount; ++index )
+    {
+        const U64 sortKey = pSource[index].mSortKey;
+        for ( U32 digit = 0; digit < sizeof(U64); ++digit )
+            histograms[digit][(sortKey >> (digit * 8)) & 0xFF]++;
+    }
 
-    const F32 x1 = pSceneRenderRequestA->mWorldPosition.x + pSceneRenderRequestA->mSortPoint.x;
-    const F32 x2 = pSceneRenderRequestB->mWorldPosition.x + pSceneRenderRequestB->mSortPoint.x;
+    // Stable least-significant digit passes.
+    for ( U32 digit = 0; digit < sizeof(U64); ++digit )
+    {
+        U32* pHistogram = histograms[digit];
+        const U32 shift = digit * 8;
+
+        // Skip the pass if every key shares this digit.
+        if ( pHistogram[(pSource[0].mSortKey >> shift) & 0xFF] == entryCount )
+            continue;
+
+        // Convert the counts to offsets.
+        U32 offset = 0;
+        for ( U32 bucket = 0; bucket < 256; ++bucket )
+        {
+            const U32 count = pHistogram[bucket];
+            pHistogram[bucket] = offset;
+            offset += count;
+        }
+
+        // Scatter.
+        for ( U32 index = 0; index < entryCount; ++index )
+        {
+            const SortEntry& entry = pSource[index];
+            pDestination[pHistogram[(entry.mSortKey >> shift) & 0xFF]++] = entry;
+        }
+
+        // Swap buffers.
+        SortEntry* pSwap = pSource;
+        pSource = pDestination;
+        pDestination = pSwap;
+    }
 
-    // We sort lower x values before higher values.
-    return x1 < x2 ? -1 : x1 > x2 ? 1 : pSceneRenderRequestA->mSerialId - pSceneRenderRequestB->mSerialId;
+    // Write back the sorted requests.
+    SceneRenderRequest** pRenderRequests = mRenderRequests.address();
+    for ( U32 index = 0; index < entryCount; ++index )
+        pRenderRequests[index] = pSource[index].mpRenderRequest;
 }
 
 //-----------------------------------------------------------------------------
 
-S32 QSORT_CALLBACK SceneRenderQueue::layeredYSortPointSort(const void* a, const void* b)
+void SceneRenderQueue::insertionSortEntries( void )
 {
-    // Fetch scene render requests.
-    SceneRenderRequest* pSceneRenderRequestA  = *((SceneRenderRequest**)a);
-    SceneRenderRequest* pSceneRenderRequestB  = *((SceneRenderRequest**)b);
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneRenderQueue_InsertionSort);
 
-    const F32 y1 = pSceneRenderRequestA->mWorldPosition.y + pSceneRenderRequestA->mSortPoint.y;
-    const F32 y2 = pSceneRenderRequestB->mWorldPosition.y + pSceneRenderRequestB->mSortPoint.y;
+    const U32 entryCount = (U32)mSortEntries.size();
+    SortEntry* pSortEntries = mSortEntries.address();
 
-    // We sort lower y values before higher values.
-    return y1 < y2 ? -1 : y1 > y2 ? 1 : pSceneRenderRequestA->mSerialId - pSceneRenderRequestB->mSerialId;
-}
-
-//-----------------------------------------------------------------------------
+    for ( U32 index = 1; index < entryCount; ++index )
+    {
+        const SortEntry entry = pSortEntries[index];
 
-S32 QSORT_CALLBACK SceneRenderQueue::layeredInverseXSortPointSort(const void* a, const void* b)
-{
-    // Fetch scene render requests.
-    SceneRenderRequest* pSceneRenderRequestA  = *((SceneRenderRequest**)a);
-    SceneRenderRequest* pSceneRenderRequestB  = *((SceneRenderRequest**)b);
+        U32 insertIndex = index;
+        while( insertIndex > 0 && pSortEntries[insertIndex-1].mSortKey > entry.mSortKey )
+        {
+            pSortEntries[insertIndex] = pSortEntries[insertIndex-1];
+            --insertIndex;
+        }
 
-    const F32 x1 = pSceneRenderRequestA->mWorldPosition.x + pSceneRenderRequestA->mSortPoint.x;
-    const F32 x2 = pSceneRenderRequestB->mWorldPosition.x + pSceneRenderRequestB->mSortPoint.x;
+        pSortEntries[insertIndex] = entry;
+    }
 
-    // We sort higher x values before lower values.
-    return x1 < x2 ? 1 : x1 > x2 ? -1 : pSceneRenderRequestA->mSerialId - pSceneRenderRequestB->mSerialId;
+    // Write back the sorted requests.
+    SceneRenderRequest** pRenderRequests = mRenderRequests.address();
+    for ( U32 index = 0; index < entryCount; ++index )
+        pRenderRequests[index] = pSortEntries[index].mpRenderRequest;
 }
 
 //-----------------------------------------------------------------------------
 
-S32 QSORT_CALLBACK SceneRenderQueue::layeredInverseYSortPointSort(const void* a, const void* b)
+U32 SceneRenderQueue::getRenderGroupRank( StringTableEntry renderGroup ) const
 {
-    // Fetch scene render requests.
-    SceneRenderRequest* pSceneRenderRequestA  = *((SceneRenderRequest**)a);
-    SceneRenderRequest* pSceneRenderRequestB  = *((SceneRenderRequest**)b);
+    // Binary search the ordered render groups.
+    U32 low = 0;
+    U32 high = (U32)mSortGroups.size();
+    while( low < high )
+    {
+        const U32 middle = (low + high) >> 1;
 
-    const F32 y1 = pSceneRenderRequestA->mWorldPosition.y + pSceneRenderRequestA->mSortPoint.y;
-    const F32 y2 = pSceneRenderRequestB->mWorldPosition.y + pSceneRenderRequestB->mSortPoint.y;
+        if ( (uintptr_t)mSortGroups[middle] < (uintptr_t)renderGroup )
+            low = middle + 1;
+        else
+            high = middle;
+    }
 
-    // We sort higher y values before lower values.
-    return y1 < y2 ? 1 : y1 > y2 ? -1 : pSceneRenderRequestA->mSerialId - pSceneRenderRequestB->mSerialId;
+    return low;
 }
@@ -55,31 +55,58 @@ public:
         RENDER_SORT_INVERSE_ZAXIS,
     };
 
-private: 
+    // Render requests are allocated in blocks of this size.
+    enum { RENDER_REQUEST_BLOCK_SIZE = 256 };
+
+    // Below this count an insertion sort beats the radix passes.
+    enum { RADIX_SORT_THRESHOLD = 32 };
+
+private:
+    struct SortEntry
+    {
+        U64                 mSortKey;
+        SceneRenderRequest* mpRenderRequest;
+    };
+
+    typedef Vector<SortEntry> typeSortEntryVector;
+    typedef Vector<SceneRenderRequest*> typeRequestBlockVector;
+
     typeRenderRequestVector mRenderRequests;
     RenderSort              mSortMode;
     bool                    mStrictOrderMode;
 
+    typeRequestBlockVector  mRequestBlocks;
+    typeSortEntryVector     mSortEntries;
+    typeSortEntryVector     mSortScratch;
+    Vector<StringTableEntry> mSortGroups;
+
 private:
-    static S32 QSORT_CALLBACK layeredNewFrontSort(const void* a, const void* b);
-    static S32 QSORT_CALLBACK layeredOldFrontSort(const void* a, const void* b);
-    static S32 QSORT_CALLBACK layeredDepthSort(const void* a, const void* b);
-    static S32 QSORT_CALLBACK layeredInverseDepthSort(const void* a, const void* b);
-    static S32 QSORT_CALLBACK layerBatchOrderSort(const void* a, const void* b);
-    static S32 QSORT_CALLBACK layerGroupOrderSort(const void* a, const void* b);
-    static S32 QSORT_CALLBACK layeredXSortPointSort(const void* a, const void* b);
-    static S32 QSORT_CALLBACK layeredYSortPointSort(const void* a, const void* b);
-    static S32 QSORT_CALLBACK layeredInverseXSortPointSort(const void* a, const void* b);
-    static S32 QSORT_CALLBACK layeredInverseYSortPointSort(const void* a, const void* b);
+    void calculateSortKeys( void );
+    void radixSortEntries( void );
+    void insertionSortEntries( void );
+    U32 getRenderGroupRank( StringTableEntry renderGroup ) const;
 
 public:
     SceneRenderQueue()
     {
+        VECTOR_SET_ASSOCIATION( mRenderRequests );
+        VECTOR_SET_ASSOCIATION( mRequestBlocks );
+        VECTOR_SET_ASSOCIATION( mSortEntries );
+        VECTOR_SET_ASSOCIATION( mSortScratch );
+        VECTOR_SET_ASSOCIATION( mSortGroups );
+
         resetState();
     }
     virtual ~SceneRenderQueue()
     {
         resetState();
+
+        // Free the request blocks.
+        for( typeRequestBlockVector::iterator itr = mRequestBlocks.begin(); itr != mRequestBlocks.end(); ++itr )
+        {
+            delete [] (*itr);
+        }
+        mRequestBlocks.clear();
     }
 
     virtual void resetState( void )
@@ -87,10 +114,10 @@ public:
         // Debug Profiling.
         PROFILE_SCOPE(SceneRenderQueue_ResetState);
 
-        // Cache request.
+        // Reset the requests but keep their blocks for the next frame.
         for( typeRenderRequestVector::iterator itr = mRenderRequests.begin(); itr != mRenderRequests.end(); ++itr )
         {
-            SceneRenderRequestFactory.cacheObject( *itr );
+            (*itr)->resetState();
         }
         mRenderRequests.clear();
 
@@ -106,8 +133,15 @@ public:
         // Debug Profiling.
         PROFILE_SCOPE(SceneRenderQueue_CreateRenderRequest);
 
-        // Create scene render request.
-        SceneRenderRequest* pSceneRenderRequest = SceneRenderRequestFactory.createObject();
+        // Fetch the next free slot in the request blocks.
+        const U32 requestIndex = (U32)mRenderRequests.size();
+        const U32 blockIndex = requestIndex / RENDER_REQUEST_BLOCK_SIZE;
+
+        // Allocate a new block if all the current ones are in use.
+        if ( blockIndex == (U32)mRequestBlocks.size() )
+            mRequestBlocks.push_back( new SceneRenderRequest[RENDER_REQUEST_BLOCK_SIZE] );
+
+        SceneRenderRequest* pSceneRenderRequest = mRequestBlocks[blockIndex] + (requestIndex % RENDER_REQUEST_BLOCK_SIZE);
 
         // Queue render request.
         mRenderRequests.push_back( pSceneRenderRequest );
@@ -123,113 +157,7 @@ public:
     inline void setStrictOrderMode( const bool strictOrderMode ) { mStrictOrderMode = strictOrderMode; }
     inline bool getStrictOrderMode( void ) const { return mStrictOrderMode; }
 
-    void sort( void )
-    {
-        // Sort layer appropriately.
-        switch( mSortMode )
-        {
-            case RENDER_SORT_NEWEST:
-                {
-                    // Debug Profiling.
-                    PROFILE_SCOPE(SceneRenderQueue_SortNewest);
-
-                    dQsort( mRenderRequests.address(), mRenderRequests.size(), sizeof(SceneRenderRequest*), layeredNewFrontSort );
-                    return;
-                }
-
-            case RENDER_SORT_OLDEST:
-                {
-                    // Debug Profiling.
-                    PROFILE_SCOPE(SceneRenderQueue_SortOldest);
-
-                    dQsort( mRenderRequests.address(), mRenderRequests.size(), sizeof(SceneRenderRequest*), layeredOldFrontSort );
-                    return;
-                }
-
-            case RENDER_SORT_BATCH:
-                {
-                    // Debug Profiling.
-                    PROFILE_SCOPE(SceneRenderQueue_SortBatch);
-
-                    dQsort( mRenderRequests.address(), mRenderRequests.size(), sizeof(SceneRenderRequest*), layerBatchOrderSort );
-
-                    // Batching means we don't need strict order.
-                    mStrictOrderMode = false;
-                    return;
-                }
-
-            case RENDER_SORT_GROUP:
-                {
-                    // Debug Profiling.
-                    PROFILE_SCOPE(SceneRenderQueue_SortGroup);
-
-                    dQsort( mRenderRequests.address(), mRenderRequests.size(), sizeof(SceneRenderRequest*), layerGroupOrderSort );
-                    return;
-                }
-
-            case RENDER_SORT_XAXIS:
-                {
-                    // Debug Profiling.
-                    PROFILE_SCOPE(SceneRenderQueue_SortXAxis);
-
-                    dQsort( mRenderRequests.address(), mRenderRequests.size(), sizeof(SceneRenderRequest*), layeredXSortPointSort);
-                    return;
-                }
-
-            case RENDER_SORT_YAXIS:
-                {
-                    // Debug Profiling.
-                    PROFILE_SCOPE(SceneRenderQueue_SortYAxis);
-
-                    dQsort( mRenderRequests.address(), mRenderRequests.size(), sizeof(SceneRenderRequest*), layeredYSortPointSort );
-                    return;
-                }
-
-            case RENDER_SORT_ZAXIS:
-                {
-                    // Debug Profiling.
-                    PROFILE_SCOPE(SceneRenderQueue_SortZAxis);
-
-                    dQsort( mRenderRequests.address(), mRenderRequests.size(), sizeof(SceneRenderRequest*), layeredDepthSort );
-                    return;
-                }
-
-            case RENDER_SORT_INVERSE_XAXIS:
-                {
-                    // Debug Profiling.
-                    PROFILE_SCOPE(SceneRenderQueue_SortInverseXAxis);
-
-                    dQsort( mRenderRequests.address(), mRenderRequests.size(), sizeof(SceneRenderRequest*), layeredInverseXSortPointSort );
-                    return;
-                }
-
-            case RENDER_SORT_INVERSE_YAXIS:
-                {
-                    // Debug Profiling.
-                    PROFILE_SCOPE(SceneRenderQueue_SortInverseYAxis);
-
-                    dQsort( mRenderRequests.address(), mRenderRequests.size(), sizeof(SceneRenderRequest*), layeredInverseYSortPointSort );
-                    return;
-                }
-
-            case RENDER_SORT_INVERSE_ZAXIS:
-                {
-                    // Debug Profiling.
-                    PROFILE_SCOPE(SceneRenderQueue_SortInverseZAxis);
-
-                    dQsort( mRenderRequests.address(), mRenderRequests.size(), sizeof(SceneRenderRequest*), layeredInverseDepthSort );
-                    return;
-                }
-
-            case RENDER_SORT_OFF:
-                {
-                    return;
-                }
-
-            default:
-                break;
-        };
-    }
+    void sort( void );
 
     static RenderSort getRenderSortEnum(const char* label);
     static const char* getRenderSortDescription( const RenderSort& sortMode );
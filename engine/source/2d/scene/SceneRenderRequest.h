@@ -97,6 +97,7 @@ public:
         mSortPoint.SetZero();
         mSerialId = 0;
         mRenderGroup = StringTable->EmptyString;
+        mSortKey = 0;
 
         mBlendMode = true;
         mSrcBlendFactor = GL_SRC_ALPHA;
@@ -124,6 +125,9 @@ public:
     S32                 mSerialId;
     StringTableEntry    mRenderGroup;
 
+    /// Packed key calculated by the render queue for its current sort mode.
+    U64                 mSortKey;
+
     bool                mBlendMode;
     GLenum              mSrcBlendFactor;
     GLenum              mDstBlendFactor;
@@ -27,6 +27,10 @@
 #include "2d/core/vector2.h"
 #endif
 
+#ifndef _WORLD_QUERY_RESULT_H_
+#include "2d/scene/WorldQueryResult.h"
+#endif
+
 //-----------------------------------------------------------------------------
 
 class GuiControl;
@@ -57,6 +61,7 @@ struct SceneRenderState
         mRenderGroupMask  = renderGroupMask;
         mpDebugStats      = pDebugStats;
         mpRenderHost      = pRenderHost;
+        mpRenderResults   = NULL;
     }
 
     RectF           mRenderArea;
@@ -69,6 +74,9 @@ struct SceneRenderState
     DebugStats*     mpDebugStats;
     SimObject*      mpRenderHost;
 
+    /// Optional destination for a copy of the render query results.
+    typeWorldQueryResultVector* mpRenderResults;
+
 
 };
 
@@ -116,6 +116,259 @@ ConsoleMethodWithDocs(Scene, getPositionIterations, ConsoleInt, 2, 2, ())
 
 //-----------------------------------------------------------------------------
 
+/*! Sets the radius of the fluid particles used by FluidObjects in the scene.
+    @param radius The particle radius.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(Scene, setParticleRadius, ConsoleVoid, 3, 3, (float radius))
+{
+    object->setParticleRadius( dAtof(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the radius of the fluid particles used by FluidObjects in the scene.
+    @return The particle radius.
+*/
+ConsoleMethodWithDocs(Scene, getParticleRadius, ConsoleFloat, 2, 2, ())
+{
+    return object->getParticleRadius();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets how many physics steps are taken each tick.
+    Controllers are integrated with every physics step whereas objects and script update once per tick.
+    @param subSteps The number of physics steps per tick (1-8, defaults to 1).
+    @return No return value.
+*/
+ConsoleMethodWithDocs(Scene, setPhysicsSubSteps, ConsoleVoid, 3, 3, (int subSteps))
+{
+    object->setPhysicsSubSteps( dAtoi(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets how many physics steps are taken each tick.
+    @return The number of physics steps per tick.
+*/
+ConsoleMethodWithDocs(Scene, getPhysicsSubSteps, ConsoleInt, 2, 2, ())
+{
+    return object->getPhysicsSubSteps();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets how many ticks there are between 'onSceneUpdate' callbacks.
+    @param ticks The number of ticks between callbacks (defaults to 1).
+    @return No return value.
+*/
+ConsoleMethodWithDocs(Scene, setScriptTickInterval, ConsoleVoid, 3, 3, (int ticks))
+{
+    object->setScriptTickInterval( dAtoi(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets how many ticks there are between 'onSceneUpdate' callbacks.
+    @return The number of ticks between callbacks.
+*/
+ConsoleMethodWithDocs(Scene, getScriptTickInterval, ConsoleInt, 2, 2, ())
+{
+    return object->getScriptTickInterval();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets how many ticks there are between updates of objects outside all the attached scene window views.
+    Physics still steps every tick but the object integration and 'onUpdate' callbacks are deferred and receive the accumulated time.
+    @param ticks The number of ticks between updates.  A value of one (the default) disables tick level-of-detail.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(Scene, setTickLODInterval, ConsoleVoid, 3, 3, (int ticks))
+{
+    object->setTickLODInterval( dAtoi(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets how many ticks there are between updates of objects outside all the attached scene window views.
+    @return The number of ticks between updates.
+*/
+ConsoleMethodWithDocs(Scene, getTickLODInterval, ConsoleInt, 2, 2, ())
+{
+    return object->getTickLODInterval();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets the distance beyond the scene window views within which objects still update every tick.
+    @param margin The margin in world units (defaults to zero).
+    @return No return value.
+*/
+ConsoleMethodWithDocs(Scene, setTickLODMargin, ConsoleVoid, 3, 3, (float margin))
+{
+    object->setTickLODMargin( dAtof(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the distance beyond the scene window views within which objects still update every tick.
+    @return The margin in world units.
+*/
+ConsoleMethodWithDocs(Scene, getTickLODMargin, ConsoleFloat, 2, 2, ())
+{
+    return object->getTickLODMargin();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets how long the scene can spend catching up on ticks in a single frame.
+    Once the budget is spent, any remaining ticks that frame are dropped so the scene slows down rather than falling further behind.
+    @param budget The budget in milliseconds.  A value of zero (the default) is unlimited.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(Scene, setTickBudget, ConsoleVoid, 3, 3, (float budget))
+{
+    object->setTickBudget( dAtof(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets how long the scene can spend catching up on ticks in a single frame.
+    @return The budget in milliseconds.
+*/
+ConsoleMethodWithDocs(Scene, getTickBudget, ConsoleFloat, 2, 2, ())
+{
+    return object->getTickBudget();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets how the scene and physics spatial trees are maintained as they degrade.
+    @param mode The maintenance mode of either "None", "Incremental" or "Rebuild".  "Incremental" (the default) spreads a rebuild across several ticks whereas "Rebuild" performs it immediately.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(Scene, setTreeMaintenanceMode, ConsoleVoid, 3, 3, (mode))
+{
+    // Fetch the maintenance mode.
+    const WorldQuery::TreeMaintenanceMode mode = WorldQuery::getTreeMaintenanceModeEnum( argv[2] );
+
+    // Sanity!
+    if ( mode == WorldQuery::TREE_MAINTENANCE_INVALID )
+        return;
+
+    object->getWorldQuery()->setTreeMaintenanceMode( mode );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets how the scene and physics spatial trees are maintained as they degrade.
+    @return The maintenance mode.
+*/
+ConsoleMethodWithDocs(Scene, getTreeMaintenanceMode, ConsoleString, 2, 2, ())
+{
+    return WorldQuery::getTreeMaintenanceModeDescription( object->getWorldQuery()->getTreeMaintenanceMode() );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets how often the spatial tree metrics are measured.
+    @param ticks The number of ticks between measurements (defaults to 30).
+    @return No return value.
+*/
+ConsoleMethodWithDocs(Scene, setTreeMaintenanceInterval, ConsoleVoid, 3, 3, (int ticks))
+{
+    object->getWorldQuery()->setTreeMaintenanceInterval( (U32)getMax( dAtoi(argv[2]), 1 ) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets how often the spatial tree metrics are measured.
+    @return The number of ticks between measurements.
+*/
+ConsoleMethodWithDocs(Scene, getTreeMaintenanceInterval, ConsoleInt, 2, 2, ())
+{
+    return (S32)object->getWorldQuery()->getTreeMaintenanceInterval();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets how much a spatial tree may degrade before it is rebuilt.
+    A tree is rebuilt when its quality (area ratio) or proxy count changes by more than this fraction since it was last rebuilt.
+    @param tolerance The fractional tolerance (defaults to 0.5).
+    @return No return value.
+*/
+ConsoleMethodWithDocs(Scene, setTreeQualityTolerance, ConsoleVoid, 3, 3, (float tolerance))
+{
+    object->getWorldQuery()->setTreeQualityTolerance( dAtof(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets how much a spatial tree may degrade before it is rebuilt.
+    @return The fractional tolerance.
+*/
+ConsoleMethodWithDocs(Scene, getTreeQualityTolerance, ConsoleFloat, 2, 2, ())
+{
+    return object->getWorldQuery()->getTreeQualityTolerance();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets how much the balance of a spatial tree may grow before it is rebuilt.
+    @param tolerance The balance increase allowed since the last rebuild (defaults to 4).
+    @return No return value.
+*/
+ConsoleMethodWithDocs(Scene, setTreeBalanceTolerance, ConsoleVoid, 3, 3, (int tolerance))
+{
+    object->getWorldQuery()->setTreeBalanceTolerance( dAtoi(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets how much the balance of a spatial tree may grow before it is rebuilt.
+    @return The balance increase allowed since the last rebuild.
+*/
+ConsoleMethodWithDocs(Scene, getTreeBalanceTolerance, ConsoleInt, 2, 2, ())
+{
+    return object->getWorldQuery()->getTreeBalanceTolerance();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets how many proxies an incremental rebuild processes each tick.
+    @param budget The number of proxies processed per tick (defaults to 1024).
+    @return No return value.
+*/
+ConsoleMethodWithDocs(Scene, setTreeRebuildBudget, ConsoleVoid, 3, 3, (int budget))
+{
+    object->getWorldQuery()->setTreeRebuildBudget( dAtoi(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets how many proxies an incremental rebuild processes each tick.
+    @return The number of proxies processed per tick.
+*/
+ConsoleMethodWithDocs(Scene, getTreeRebuildBudget, ConsoleInt, 2, 2, ())
+{
+    return object->getWorldQuery()->getTreeRebuildBudget();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Immediately rebuilds the scene and physics spatial trees.
+    This is useful after teleporting or spawning a large number of objects.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(Scene, rebuildTrees, ConsoleVoid, 2, 2, ())
+{
+    object->getWorldQuery()->rebuildTrees();
+}
+
+//-----------------------------------------------------------------------------
+
 /*! Add the SceneObject to the scene.
     @param sceneObject The SceneObject to add to the scene.
     @return No return value.
@@ -3578,6 +3831,207 @@ ConsoleMethodWithDocs(Scene, setIsEditorScene, ConsoleVoid, 3, 3, ())
 
 //-----------------------------------------------------------------------------
 
+/*! Bakes a navigation grid over an area from the static collision shapes in the scene.
+    The grid is rebaked incrementally as static bodies are added, removed or moved.
+    @param lower The lower-left corner of the area as "x y".
+    @param upper The upper-right corner of the area as "x y".
+    @param cellSize The size of each grid cell.
+    @param agentRadius The clearance kept from static shapes.  Optional: Defaults to zero.
+    @param sceneGroupMask The scene groups that block navigation.  Optional: Defaults to all.
+    @param sceneLayerMask The scene layers that block navigation.  Optional: Defaults to all.
+    @return Whether the grid was baked or not.
+*/
+ConsoleMethodWithDocs(Scene, setNavigationGrid, ConsoleBool, 5, 8, (lower, upper, cellSize, [agentRadius], [sceneGroupMask], [sceneLayerMask]))
+{
+    // Fetch the area.
+    if ( Utility::mGetStringElementCount(argv[2]) != 2 || Utility::mGetStringElementCount(argv[3]) != 2 )
+    {
+        Con::warnf("Scene::setNavigationGrid() - Invalid area!");
+        return false;
+    }
+
+    const Vector2 lower = Utility::mGetStringElementVector(argv[2]);
+    const Vector2 upper = Utility::mGetStringElementVector(argv[3]);
+
+    b2AABB area;
+    area.lowerBound.Set( getMin(lower.x, upper.x), getMin(lower.y, upper.y) );
+    area.upperBound.Set( getMax(lower.x, upper.x), getMax(lower.y, upper.y) );
+
+    // Fetch the optional arguments.
+    const F32 agentRadius = argc > 5 ? dAtof(argv[5]) : 0.0f;
+    const U32 sceneGroupMask = (argc > 6 && *argv[6] != 0) ? dAtoi(argv[6]) : MASK_ALL;
+    const U32 sceneLayerMask = (argc > 7 && *argv[7] != 0) ? dAtoi(argv[7]) : MASK_ALL;
+
+    return object->getNavigation()->configure( area, dAtof(argv[4]), agentRadius, sceneGroupMask, sceneLayerMask );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Discards the navigation grid along with any pending requests and flow fields.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(Scene, clearNavigationGrid, ConsoleVoid, 2, 2, ())
+{
+    object->getNavigation()->clear();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets whether a navigation grid has been baked or not.
+    @return Whether a navigation grid has been baked or not.
+*/
+ConsoleMethodWithDocs(Scene, getNavigationGrid, ConsoleBool, 2, 2, ())
+{
+    return object->getNavigation()->getConfigured();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Marks an area of the navigation grid for rebaking.
+    Static bodies are tracked automatically so this is only needed if blocking shapes change by other means.
+    @param lower The lower-left corner of the area as "x y".
+    @param upper The upper-right corner of the area as "x y".
+    @return No return value.
+*/
+ConsoleMethodWithDocs(Scene, invalidateNavigation, ConsoleVoid, 4, 4, (lower, upper))
+{
+    const Vector2 lower = Utility::mGetStringElementVector(argv[2]);
+    const Vector2 upper = Utility::mGetStringElementVector(argv[3]);
+
+    b2AABB area;
+    area.lowerBound.Set( getMin(lower.x, upper.x), getMin(lower.y, upper.y) );
+    area.upperBound.Set( getMax(lower.x, upper.x), getMax(lower.y, upper.y) );
+
+    object->getNavigation()->markDirty( area );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets whether a position is walkable on the navigation grid.
+    @param position The position as "x y".
+    @return Whether the position is walkable or not.  Positions outside the grid are not walkable.
+*/
+ConsoleMethodWithDocs(Scene, getNavigationWalkable, ConsoleBool, 3, 3, (position))
+{
+    return object->getNavigation()->getWalkable( Utility::mGetStringElementVector(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Requests a path across the navigation grid.  The search runs on a worker thread.
+    When complete, 'onNavigationPath(requestId, path)' is called on the callback object where path is a list of "x y" points, empty if no path exists.
+    @param start The start position as "x y".
+    @param goal The goal position as "x y".
+    @param callbackObject The object to call back.  Optional: Defaults to the scene.
+    @return The request Id or zero if the request failed.
+*/
+ConsoleMethodWithDocs(Scene, findNavigationPath, ConsoleInt, 4, 5, (start, goal, [callbackObject]))
+{
+    // Fetch the callback object.
+    SimObjectId callbackId = 0;
+    if ( argc > 4 && *argv[4] != 0 )
+    {
+        SimObject* pCallbackObject = Sim::findObject( argv[4] );
+        if ( pCallbackObject == NULL )
+        {
+            Con::warnf("Scene::findNavigationPath() - Could not find callback object '%s'.", argv[4]);
+            return 0;
+        }
+
+        callbackId = pCallbackObject->getId();
+    }
+
+    return (S32)object->getNavigation()->findPath( Utility::mGetStringElementVector(argv[2]), Utility::mGetStringElementVector(argv[3]), callbackId );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Finds a path across the navigation grid immediately.
+    @param start The start position as "x y".
+    @param goal The goal position as "x y".
+    @return A list of "x y" points or nothing if no path exists.
+*/
+ConsoleMethodWithDocs(Scene, findNavigationPathImmediate, ConsoleString, 4, 4, (start, goal))
+{
+    Vector<Vector2> path;
+    if ( !object->getNavigation()->findPathImmediate( Utility::mGetStringElementVector(argv[2]), Utility::mGetStringElementVector(argv[3]), path ) )
+        return StringTable->EmptyString;
+
+    // Format the path.
+    const U32 bufferSize = path.size() * 32 + 1;
+    char* pBuffer = Con::getReturnBuffer( bufferSize );
+    SceneNavigation::formatPath( path, pBuffer, bufferSize );
+
+    return pBuffer;
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Creates a flow field toward a goal.  Any number of agents can steer using the same field.
+    The field is built on a worker thread and rebuilt whenever the navigation grid changes.
+    Each time it is built, 'onNavigationFlowField(fieldId)' is called on the callback object.
+    @param goal The goal position as "x y".
+    @param callbackObject The object to call back.  Optional: Defaults to the scene.
+    @return The flow field Id or zero if it could not be created.
+*/
+ConsoleMethodWithDocs(Scene, createNavigationFlowField, ConsoleInt, 3, 4, (goal, [callbackObject]))
+{
+    // Fetch the callback object.
+    SimObjectId callbackId = 0;
+    if ( argc > 3 && *argv[3] != 0 )
+    {
+        SimObject* pCallbackObject = Sim::findObject( argv[3] );
+        if ( pCallbackObject == NULL )
+        {
+            Con::warnf("Scene::createNavigationFlowField() - Could not find callback object '%s'.", argv[3]);
+            return 0;
+        }
+
+        callbackId = pCallbackObject->getId();
+    }
+
+    return (S32)object->getNavigation()->createFlowField( Utility::mGetStringElementVector(argv[2]), callbackId );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the direction to move from a position to follow a flow field.
+    @param fieldId The flow field Id.
+    @param position The position as "x y".
+    @return The unit direction as "x y" or nothing if the field is not built or the goal is unreachable from the position.
+*/
+ConsoleMethodWithDocs(Scene, getNavigationFlowDirection, ConsoleString, 4, 4, (fieldId, position))
+{
+    Vector2 direction;
+    if ( !object->getNavigation()->getFlowDirection( dAtoi(argv[2]), Utility::mGetStringElementVector(argv[3]), direction ) )
+        return StringTable->EmptyString;
+
+    return direction.scriptThis();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Deletes a flow field.
+    @param fieldId The flow field Id.
+    @return Whether the flow field was deleted or not.
+*/
+ConsoleMethodWithDocs(Scene, deleteNavigationFlowField, ConsoleBool, 3, 3, (fieldId))
+{
+    return object->getNavigation()->deleteFlowField( dAtoi(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the number of navigation requests that have not yet been dispatched.
+    @return The number of navigation requests that have not yet been dispatched.
+*/
+ConsoleMethodWithDocs(Scene, getNavigationPendingCount, ConsoleInt, 2, 2, ())
+{
+    return (S32)object->getNavigation()->getPendingRequestCount();
+}
+
+//-----------------------------------------------------------------------------
+
 /*! Creates the specified scene-object derived type and adds it to the scene.
     @return The scene-object or NULL if not created.
 */
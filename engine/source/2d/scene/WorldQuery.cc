@@ -30,6 +30,10 @@
 #include "2d/sceneobject/SceneObject.h"
 #endif
 
+#ifndef _DEBUG_STATS_H_
+#include "2d/scene/DebugStats.h"
+#endif
+
 // Debug Profiling.
 #include "debug/profiler.h"
 
@@ -42,7 +46,15 @@ WorldQuery::WorldQuery( Scene* pScene ) :
         mCheckPoint(false),
         mCheckAABB(false),
         mCheckOOBB(false),
-        mCheckCircle(false)
+        mCheckCircle(false),
+        mBulkAddDepth(0),
+        mProxyRevision(0),
+        mTreeMaintenanceMode(TREE_MAINTENANCE_INCREMENTAL),
+        mTreeMaintenanceInterval(30),
+        mTreeQualityTolerance(0.5f),
+        mTreeBalanceTolerance(4),
+        mTreeRebuildBudget(1024),
+        mTreeMaintenanceTicks(0)
 {
     // Set debug associations.
     for ( U32 n = 0; n < MAX_LAYERS_SUPPORTED; n++ )
@@ -50,6 +62,7 @@ WorldQuery::WorldQuery( Scene* pScene ) :
         VECTOR_SET_ASSOCIATION( mLayeredQueryResults[n] );
     }
     VECTOR_SET_ASSOCIATION( mQueryResults );
+    VECTOR_SET_ASSOCIATION( mPendingProxies );
 
     // Clear the query.
     clearQuery();
@@ -62,6 +75,17 @@ S32 WorldQuery::add( SceneObject* pSceneObject )
     // Debug Profiling.
     PROFILE_SCOPE(WorldQuery_Add);
 
+    // Flag the proxies as changed.
+    mProxyRevision++;
+
+    // Defer linking the proxy if bulk adding.
+    if ( mBulkAddDepth > 0 )
+    {
+        const S32 proxyId = CreateDetachedProxy( pSceneObject->getAABB(), static_cast<PhysicsProxy*>(pSceneObject) );
+        mPendingProxies.push_back( proxyId );
+        return proxyId;
+    }
+
     return CreateProxy( pSceneObject->getAABB(), static_cast<PhysicsProxy*>(pSceneObject) );
 }
 
@@ -72,6 +96,12 @@ void WorldQuery::remove( SceneObject* pSceneObject )
     // Debug Profiling.
     PROFILE_SCOPE(WorldQuery_Remove);
 
+    // Flag the proxies as changed.
+    mProxyRevision++;
+
+    // Link any pending proxies.
+    flushPendingProxies();
+
     DestroyProxy( pSceneObject->getWorldProxy() );
 }
 
@@ -82,11 +112,178 @@ bool WorldQuery::update( SceneObject* pSceneObject, const b2AABB& aabb, const b2
     // Debug Profiling.
     PROFILE_SCOPE(WorldQuery_Update);
 
+    // Flag the proxies as changed.
+    mProxyRevision++;
+
+    // Link any pending proxies.
+    flushPendingProxies();
+
     return MoveProxy( pSceneObject->getWorldProxy(), aabb, displacement );
 }
 
 //-----------------------------------------------------------------------------
 
+void WorldQuery::beginBulkAdd( void )
+{
+    mBulkAddDepth++;
+}
+
+//-----------------------------------------------------------------------------
+
+void WorldQuery::endBulkAdd( void )
+{
+    // Sanity!
+    AssertFatal( mBulkAddDepth > 0, "WorldQuery::endBulkAdd() - Bulk add was not started." );
+
+    // Finish if still nested.
+    if ( --mBulkAddDepth > 0 )
+        return;
+
+    // Link the pending proxies.
+    flushPendingProxies();
+}
+
+//-----------------------------------------------------------------------------
+
+void WorldQuery::flushBulkAdd( void )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(WorldQuery_FlushBulkAdd);
+
+    // Insert the pending proxies as a single subtree.
+    InsertProxies( mPendingProxies.address(), mPendingProxies.size() );
+    mPendingProxies.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+void WorldQuery::maintainTrees( DebugStats* pDebugStats )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(WorldQuery_MaintainTrees);
+
+    // Link any pending proxies.
+    flushPendingProxies();
+
+    // Fetch the world.
+    b2World* pWorld = mpScene->getWorld();
+
+    // Continue any incremental rebuilds.
+    if ( mSceneTreeState.mRebuilding && RebuildIncremental( mTreeRebuildBudget ) )
+        mSceneTreeState.rebuilt( GetProxyCount(), GetAreaRatio(), GetMaxBalance() );
+
+    if ( mWorldTreeState.mRebuilding && pWorld->RebuildTreeIncremental( mTreeRebuildBudget ) )
+        mWorldTreeState.rebuilt( pWorld->GetProxyCount(), pWorld->GetTreeQuality(), pWorld->GetTreeBalance() );
+
+    // Finish if not time to measure the trees.
+    // The metrics are linear in the proxy count so they are not measured every tick.
+    if ( ++mTreeMaintenanceTicks < mTreeMaintenanceInterval )
+        return;
+
+    mTreeMaintenanceTicks = 0;
+
+    // Measure the trees.
+    const S32 sceneProxyCount = GetProxyCount();
+    const F32 sceneQuality = GetAreaRatio();
+    const S32 sceneBalance = GetMaxBalance();
+    const S32 worldProxyCount = pWorld->GetProxyCount();
+    const F32 worldQuality = pWorld->GetTreeQuality();
+    const S32 worldBalance = pWorld->GetTreeBalance();
+
+    // Update debug stats.
+    if ( pDebugStats != NULL )
+    {
+        pDebugStats->sceneTreeHeight = (U32)GetHeight();
+        pDebugStats->sceneTreeBalance = (U32)sceneBalance;
+        pDebugStats->sceneTreeQuality = sceneQuality;
+        pDebugStats->sceneTreeRebuilds = mSceneTreeState.mRebuildCount;
+        pDebugStats->worldTreeHeight = (U32)pWorld->GetTreeHeight();
+        pDebugStats->worldTreeBalance = (U32)worldBalance;
+        pDebugStats->worldTreeQuality = worldQuality;
+        pDebugStats->worldTreeRebuilds = mWorldTreeState.mRebuildCount;
+    }
+
+    // Finish if no maintenance.
+    if ( mTreeMaintenanceMode == TREE_MAINTENANCE_NONE )
+        return;
+
+    const bool rebuildNow = mTreeMaintenanceMode == TREE_MAINTENANCE_REBUILD;
+
+    // Rebuild the scene tree if it has degraded.
+    if ( !mSceneTreeState.mRebuilding && getTreeNeedsRebuild( mSceneTreeState, sceneProxyCount, sceneQuality, sceneBalance ) )
+    {
+        if ( rebuildNow )
+        {
+            RebuildTopDown();
+            mSceneTreeState.rebuilt( GetProxyCount(), GetAreaRatio(), GetMaxBalance() );
+        }
+        else
+        {
+            mSceneTreeState.mRebuilding = true;
+        }
+    }
+
+    // Rebuild the world tree if it has degraded.
+    if ( !mWorldTreeState.mRebuilding && getTreeNeedsRebuild( mWorldTreeState, worldProxyCount, worldQuality, worldBalance ) )
+    {
+        if ( rebuildNow )
+        {
+            pWorld->RebuildTree();
+            mWorldTreeState.rebuilt( pWorld->GetProxyCount(), pWorld->GetTreeQuality(), pWorld->GetTreeBalance() );
+        }
+        else
+        {
+            mWorldTreeState.mRebuilding = true;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void WorldQuery::rebuildTrees( void )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(WorldQuery_RebuildTrees);
+
+    // Link any pending proxies.
+    flushPendingProxies();
+
+    // Rebuild the scene tree.
+    RebuildTopDown();
+    mSceneTreeState.rebuilt( GetProxyCount(), GetAreaRatio(), GetMaxBalance() );
+
+    // Rebuild the world tree.
+    b2World* pWorld = mpScene->getWorld();
+    pWorld->RebuildTree();
+    mWorldTreeState.rebuilt( pWorld->GetProxyCount(), pWorld->GetTreeQuality(), pWorld->GetTreeBalance() );
+}
+
+//-----------------------------------------------------------------------------
+
+bool WorldQuery::getTreeNeedsRebuild( const TreeState& treeState, const S32 proxyCount, const F32 quality, const S32 balance ) const
+{
+    // Small trees are not worth maintaining.
+    if ( proxyCount < 32 )
+        return false;
+
+    // Rebuild if no baseline has been established yet.
+    if ( treeState.mBaselineProxyCount == 0 )
+        return true;
+
+    // Rebuild if the proxy count has changed significantly i.e. a spawn wave or mass removal.
+    if ( mAbs( (F32)(proxyCount - treeState.mBaselineProxyCount) ) > treeState.mBaselineProxyCount * mTreeQualityTolerance )
+        return true;
+
+    // Rebuild if the quality has degraded since the last rebuild.
+    if ( quality > treeState.mBaselineQuality * (1.0f + mTreeQualityTolerance) )
+        return true;
+
+    // Rebuild if the balance has degraded since the last rebuild.
+    return balance > treeState.mBaselineBalance + mTreeBalanceTolerance;
+}
+
+//-----------------------------------------------------------------------------
+
 void WorldQuery::addAlwaysInScope( SceneObject* pSceneObject )
 {
     // Debug Profiling.
@@ -243,6 +440,9 @@ U32 WorldQuery::aabbQueryAABB( const b2AABB& aabb )
     // Debug Profiling.
     PROFILE_SCOPE(WorldQuery_aabbQueryAABB);
 
+    // Link any pending proxies.
+    flushPendingProxies();
+
     mMasterQueryKey++;
 
     // Flag as not a ray-cast query result.
@@ -264,6 +464,9 @@ U32 WorldQuery::aabbQueryRay( const Vector2& point1, const Vector2& point2 )
     // Debug Profiling.
     PROFILE_SCOPE(WorldQuery_AABBQueryRay);
 
+    // Link any pending proxies.
+    flushPendingProxies();
+
     mMasterQueryKey++;
 
     // Flag as a ray-cast query result.
@@ -289,6 +492,9 @@ U32 WorldQuery::aabbQueryPoint( const Vector2& point )
     // Debug Profiling.
     PROFILE_SCOPE(WorldQuery_AABBQueryPoint);
 
+    // Link any pending proxies.
+    flushPendingProxies();
+
     mMasterQueryKey++;
 
     // Flag as not a ray-cast query result.
@@ -313,6 +519,9 @@ U32 WorldQuery::aabbQueryCircle( const Vector2& centroid, const F32 radius )
     // Debug Profiling.
     PROFILE_SCOPE(WorldQuery_AABBQueryCircle);
 
+    // Link any pending proxies.
+    flushPendingProxies();
+
     mMasterQueryKey++;
 
     // Flag as not a ray-cast query result.
@@ -341,6 +550,9 @@ U32 WorldQuery::oobbQueryAABB( const b2AABB& aabb )
     // Debug Profiling.
     PROFILE_SCOPE(WorldQuery_aabbQueryAABB);
 
+    // Link any pending proxies.
+    flushPendingProxies();
+
     mMasterQueryKey++;
 
     // Flag as not a ray-cast query result.
@@ -373,6 +585,9 @@ U32 WorldQuery::oobbQueryRay( const Vector2& point1, const Vector2& point2 )
     // Debug Profiling.
     PROFILE_SCOPE(WorldQuery_AABBQueryRay);
 
+    // Link any pending proxies.
+    flushPendingProxies();
+
     mMasterQueryKey++;
 
     // Flag as a ray-cast query result.
@@ -400,6 +615,9 @@ U32 WorldQuery::oobbQueryPoint( const Vector2& point )
     // Debug Profiling.
     PROFILE_SCOPE(WorldQuery_AABBQueryPoint);
 
+    // Link any pending proxies.
+    flushPendingProxies();
+
     mMasterQueryKey++;
 
     // Flag as not a ray-cast query result.
@@ -430,6 +648,9 @@ U32 WorldQuery::oobbQueryCircle( const Vector2& centroid, const F32 radius )
     // Debug Profiling.
     PROFILE_SCOPE(WorldQuery_OOBBQueryCircle);
 
+    // Link any pending proxies.
+    flushPendingProxies();
+
     mMasterQueryKey++;
 
     // Flag as not a ray-cast query result.
@@ -932,3 +1153,43 @@ S32 QSORT_CALLBACK WorldQuery::rayCastFractionSort(const void* a, const void* b)
     return 0;
 }
 
+//-----------------------------------------------------------------------------
+
+static EnumTable::Enums treeMaintenanceModeLookup[] =
+                {
+                { WorldQuery::TREE_MAINTENANCE_NONE,        "None" },
+                { WorldQuery::TREE_MAINTENANCE_INCREMENTAL, "Incremental" },
+                { WorldQuery::TREE_MAINTENANCE_REBUILD,     "Rebuild" },
+                };
+
+//-----------------------------------------------------------------------------
+
+WorldQuery::TreeMaintenanceMode WorldQuery::getTreeMaintenanceModeEnum( const char* label )
+{
+    // Search for Mnemonic.
+    for(U32 i = 0; i < (sizeof(treeMaintenanceModeLookup) / sizeof(EnumTable::Enums)); i++)
+        if( dStricmp(treeMaintenanceModeLookup[i].label, label) == 0)
+            return((WorldQuery::TreeMaintenanceMode)treeMaintenanceModeLookup[i].index);
+
+    // Warn.
+    Con::warnf( "WorldQuery::getTreeMaintenanceModeEnum() - Invalid tree maintenance mode '%s'.", label );
+
+    return WorldQuery::TREE_MAINTENANCE_INVALID;
+}
+
+//-----------------------------------------------------------------------------
+
+const char* WorldQuery::getTreeMaintenanceModeDescription( const WorldQuery::TreeMaintenanceMode mode )
+{
+    // Search for Mnemonic.
+    for (U32 i = 0; i < (sizeof(treeMaintenanceModeLookup) / sizeof(EnumTable::Enums)); i++)
+    {
+        if( treeMaintenanceModeLookup[i].index == mode )
+            return treeMaintenanceModeLookup[i].label;
+    }
+
+    // Warn.
+    Con::warnf( "WorldQuery::getTreeMaintenanceModeDescription() - Invalid tree maintenance mode.");
+
+    return StringTable->EmptyString;
+}
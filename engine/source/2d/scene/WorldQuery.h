@@ -34,6 +34,7 @@
 ///-----------------------------------------------------------------------------
 
 class Scene;
+class DebugStats;
 
 ///-----------------------------------------------------------------------------
 
@@ -43,6 +44,17 @@ class WorldQuery :
     public b2RayCastCallback,
     public SimObject
 {
+public:
+    /// Tree maintenance mode.
+    enum TreeMaintenanceMode
+    {
+        TREE_MAINTENANCE_INVALID,
+        ///---
+        TREE_MAINTENANCE_NONE,
+        TREE_MAINTENANCE_INCREMENTAL,
+        TREE_MAINTENANCE_REBUILD,
+    };
+
 public:
     WorldQuery( Scene* pScene );
     virtual         ~WorldQuery() {}
@@ -52,6 +64,28 @@ public:
     void            remove( SceneObject* pSceneObject );
     bool            update( SceneObject* pSceneObject, const b2AABB& aabb, const b2Vec2& displacement );
 
+    /// Bulk insertion.
+    void            beginBulkAdd( void );
+    void            endBulkAdd( void );
+    inline bool     getIsBulkAdding( void ) const { return mBulkAddDepth > 0; }
+
+    /// Proxy revision (changes whenever a proxy is added, removed or moved).
+    inline U32      getProxyRevision( void ) const { return mProxyRevision; }
+
+    /// Tree maintenance.
+    void            maintainTrees( DebugStats* pDebugStats );
+    void            rebuildTrees( void );
+    inline void     setTreeMaintenanceMode( const TreeMaintenanceMode mode ) { mTreeMaintenanceMode = mode; }
+    inline TreeMaintenanceMode getTreeMaintenanceMode( void ) const { return mTreeMaintenanceMode; }
+    inline void     setTreeMaintenanceInterval( const U32 ticks ) { mTreeMaintenanceInterval = getMax( ticks, (U32)1 ); }
+    inline U32      getTreeMaintenanceInterval( void ) const { return mTreeMaintenanceInterval; }
+    inline void     setTreeQualityTolerance( const F32 tolerance ) { mTreeQualityTolerance = getMax( tolerance, 0.0f ); }
+    inline F32      getTreeQualityTolerance( void ) const { return mTreeQualityTolerance; }
+    inline void     setTreeBalanceTolerance( const S32 tolerance ) { mTreeBalanceTolerance = getMax( tolerance, 1 ); }
+    inline S32      getTreeBalanceTolerance( void ) const { return mTreeBalanceTolerance; }
+    inline void     setTreeRebuildBudget( const S32 leafBudget ) { mTreeRebuildBudget = getMax( leafBudget, 1 ); }
+    inline S32      getTreeRebuildBudget( void ) const { return mTreeRebuildBudget; }
+
     /// Always in scope.
     void            addAlwaysInScope( SceneObject* pSceneObject );
     void            removeAlwaysInScope( SceneObject* pSceneObject );
@@ -98,7 +132,34 @@ public:
     bool            QueryCallback( S32 proxyId );
     F32             RayCastCallback( const b2RayCastInput& input, S32 proxyId );
 
+    static TreeMaintenanceMode getTreeMaintenanceModeEnum( const char* label );
+    static const char* getTreeMaintenanceModeDescription( const TreeMaintenanceMode mode );
+
 private:
+    /// Maintenance state for a single broad-phase tree.
+    struct TreeState
+    {
+        TreeState() : mBaselineQuality(0.0f), mBaselineBalance(0), mBaselineProxyCount(0), mRebuilding(false), mRebuildCount(0) {}
+
+        inline void rebuilt( const S32 proxyCount, const F32 quality, const S32 balance )
+        {
+            mBaselineProxyCount = proxyCount;
+            mBaselineQuality = quality;
+            mBaselineBalance = balance;
+            mRebuilding = false;
+            mRebuildCount++;
+        }
+
+        F32     mBaselineQuality;
+        S32     mBaselineBalance;
+        S32     mBaselineProxyCount;
+        bool    mRebuilding;
+        U32     mRebuildCount;
+    };
+
+    void            flushBulkAdd( void );
+    inline void     flushPendingProxies( void ) { if ( mPendingProxies.size() > 0 ) flushBulkAdd(); }
+    bool            getTreeNeedsRebuild( const TreeState& treeState, const S32 proxyCount, const F32 quality, const S32 balance ) const;
     void            injectAlwaysInScope( void );
     static S32      QSORT_CALLBACK rayCastFractionSort(const void* a, const void* b);
 
@@ -119,6 +180,19 @@ private:
     bool                        mIsRaycastQueryResult;
     typeSceneObjectVector       mAlwaysInScopeSet;
     U32                         mMasterQueryKey;
+
+    U32                         mBulkAddDepth;
+    Vector<S32>                 mPendingProxies;
+    U32                         mProxyRevision;
+
+    TreeMaintenanceMode         mTreeMaintenanceMode;
+    U32                         mTreeMaintenanceInterval;
+    F32                         mTreeQualityTolerance;
+    S32                         mTreeBalanceTolerance;
+    S32                         mTreeRebuildBudget;
+    U32                         mTreeMaintenanceTicks;
+    TreeState                   mSceneTreeState;
+    TreeState                   mWorldTreeState;
 };
 
 #endif // _WORLD_QUERY_H_
\ No newline at end of file
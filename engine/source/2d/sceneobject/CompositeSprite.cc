@@ -111,6 +111,7 @@ void CompositeSprite::initPersistFields()
     addProtectedField( "BatchCulling", TypeBool, Offset(mBatchCulling, CompositeSprite), &setBatchCulling, &defaultProtectedGetFn, &writeBatchCulling, "");
     addField( "BatchIsolated", TypeBool, Offset(mBatchIsolated, CompositeSprite), &writeBatchIsolated, "");
     addField( "BatchSortMode", TypeEnum, Offset(mBatchSortMode, CompositeSprite), &writeBatchSortMode, 1, &SceneRenderQueue::renderSortTable, "");
+    addProtectedField( "TileImage", TypeString, 0, &setTileImage, &getTileImage, &writeTileImage, "The image used by the tiles.");
 }
 
 //-----------------------------------------------------------------------------
@@ -138,6 +139,28 @@ void CompositeSprite::onRemove()
 
 //-----------------------------------------------------------------------------
 
+void CompositeSprite::OnRegisterScene( Scene* pScene )
+{
+    // Call parent.
+    Parent::OnRegisterScene( pScene );
+
+    // Step the sprite animations with the scene animator.
+    SpriteBatch::setImageFrameAnimator( &pScene->getImageFrameAnimator(), this );
+}
+
+//-----------------------------------------------------------------------------
+
+void CompositeSprite::OnUnregisterScene( Scene* pScene )
+{
+    // Stop stepping the sprite animations with the scene animator.
+    SpriteBatch::setImageFrameAnimator( NULL, NULL );
+
+    // Call parent.
+    Parent::OnUnregisterScene( pScene );
+}
+
+//-----------------------------------------------------------------------------
+
 void CompositeSprite::preIntegrate( const F32 totalTime, const F32 elapsedTime, DebugStats* pDebugStats )
 {
     // Are the spatials dirty?
@@ -147,10 +170,20 @@ void CompositeSprite::preIntegrate( const F32 totalTime, const F32 elapsedTime,
         setBatchTransform( getRenderTransform() );
     }
 
+    // Are the tile extents dirty?
+    if ( mTileMap.getLocalAABBDirty() )
+    {
+        // Yes, so flag the local extents as dirty.
+        setLocalExtentsDirty();
+    }
+
     // Are the render extents dirty?
     if ( getLocalExtentsDirty() )
     {
-        // Yes, so set size as local extents.
+        // Yes, so include the tiles.
+        updateTileExtents();
+
+        // Set size as local extents.
         setSize( getLocalExtents() );
     }
 
@@ -196,12 +229,56 @@ void CompositeSprite::scenePrepareRender( const SceneRenderState* pSceneRenderSt
 {
     // Prepare render.
     SpriteBatch::prepareRender( this, pSceneRenderState, pSceneRenderQueue );
+
+    // Finish if there are no tiles.
+    if ( mTileMap.getTileCount() == 0 )
+        return;
+
+    // Update the tile layout.
+    updateTileLayout();
+
+    // Query the visible tile chunks.
+    mTileChunks.clear();
+    mTileMap.queryChunks( calculateLocalAABB( pSceneRenderState->mRenderAABB ), mTileChunks );
+
+    // Fetch the batch transform.
+    const b2Transform& batchTransform = getBatchTransform();
+
+    // Create a render request for each chunk.
+    for ( U32 n = 0; n < (U32)mTileChunks.size(); ++n )
+    {
+        SpriteTileMap::Chunk* pChunk = mTileChunks[n];
+
+        // Create a render request.
+        SceneRenderRequest* pSceneRenderRequest = Scene::createDefaultRenderRequest( pSceneRenderQueue, this );
+
+        // Position at the chunk for sorting.
+        pSceneRenderRequest->mWorldPosition = b2Mul( batchTransform, mTileMap.getChunkCenter( pChunk ) );
+
+        // Set custom data.
+        pSceneRenderRequest->mpCustomData1 = pChunk;
+        pSceneRenderRequest->mpCustomData2 = &mTileMap;
+    }
 }
 
 //-----------------------------------------------------------------------------
 
 void CompositeSprite::sceneRender( const SceneRenderState* pSceneRenderState, const SceneRenderRequest* pSceneRenderRequest, BatchRender* pBatchRenderer )
 {
+    // Is this a tile chunk?
+    if ( pSceneRenderRequest->mpCustomData2 == &mTileMap )
+    {
+        // Yes, so set the blend mode.
+        pBatchRenderer->setBlendMode( pSceneRenderRequest );
+
+        // Set the alpha test mode.
+        pBatchRenderer->setAlphaTestMode( pSceneRenderRequest );
+
+        // Render the chunk.
+        mTileMap.renderChunk( (SpriteTileMap::Chunk*)pSceneRenderRequest->mpCustomData1, getBatchTransform(), getBatchTransformId(), pBatchRenderer );
+        return;
+    }
+
     // Render.
     SpriteBatch::render( pSceneRenderState, pSceneRenderRequest, pBatchRenderer );
 }
@@ -224,6 +301,9 @@ void CompositeSprite::copyTo(SimObject* object)
 
     // Call sprite batch.
     SpriteBatch::copyTo( dynamic_cast<SpriteBatch*>(object) );
+
+    // Copy tiles.
+    mTileMap.copyTo( &pCompositeSprite->mTileMap );
 }
 
 //------------------------------------------------------------------------------
@@ -248,6 +328,39 @@ void CompositeSprite::setBatchLayout( const BatchLayoutType& batchLayoutType )
 
 //------------------------------------------------------------------------------
 
+void CompositeSprite::updateTileLayout( void )
+{
+    // Tiles use the isometric or rectilinear layout with the sprite defaults.
+    mTileMap.setLayout( mBatchLayoutType == ISOMETRIC_LAYOUT, getDefaultSpriteStride(), getDefaultSpriteSize(), SpriteBatch::getDefaultSpriteAngle() );
+}
+
+//------------------------------------------------------------------------------
+
+void CompositeSprite::updateTileExtents( void )
+{
+    // Update the tile layout.
+    updateTileLayout();
+
+    // Fetch the tile bounds.
+    b2AABB localAABB = mTileMap.getLocalAABB();
+
+    // Finish if there are no tiles.
+    if ( mTileMap.getTileCount() == 0 )
+        return;
+
+    // Combine with the sprites.
+    if ( getSpriteCount() > 0 )
+    {
+        updateLocalExtents();
+        localAABB.Combine( SpriteBatch::getLocalAABB() );
+    }
+
+    // Set the combined local extents.
+    updateLocalExtents( &localAABB );
+}
+
+//------------------------------------------------------------------------------
+
 SpriteBatchItem* CompositeSprite::createSprite( const SpriteBatchItem::LogicalPosition& logicalPosition )
 {
     // Handle layout type appropriately.
@@ -409,6 +522,9 @@ void CompositeSprite::onTamlCustomWrite( TamlCustomNodes& customNodes )
 
     // Write node with sprite batch.
     SpriteBatch::onTamlCustomWrite( customNodes );
+
+    // Write node with tiles.
+    mTileMap.onTamlCustomWrite( customNodes );
 }
 
 //-----------------------------------------------------------------------------
@@ -420,6 +536,9 @@ void CompositeSprite::onTamlCustomRead( const TamlCustomNodes& customNodes )
 
     // Read node with sprite batch.
     SpriteBatch::onTamlCustomRead( customNodes );
+
+    // Read node with tiles.
+    mTileMap.onTamlCustomRead( customNodes );
 }
 
 //-----------------------------------------------------------------------------
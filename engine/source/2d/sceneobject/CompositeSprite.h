@@ -31,6 +31,10 @@
 #include "2d/sceneobject/SceneObject.h"
 #endif
 
+#ifndef _SPRITE_TILE_MAP_H_
+#include "2d/core/SpriteTileMap.h"
+#endif
+
 //------------------------------------------------------------------------------  
 
 class CompositeSprite : public SceneObject, public SpriteBatch
@@ -53,6 +57,9 @@ public:
 private:
     BatchLayoutType mBatchLayoutType;
 
+    SpriteTileMap                   mTileMap;
+    SpriteTileMap::typeChunkVector  mTileChunks;
+
 public:
     CompositeSprite();
     virtual ~CompositeSprite();
@@ -66,6 +73,9 @@ public:
     virtual void integrateObject( const F32 totalTime, const F32 elapsedTime, DebugStats* pDebugStats );
     virtual void interpolateObject( const F32 timeDelta );
 
+    virtual void OnRegisterScene( Scene* pScene );
+    virtual void OnUnregisterScene( Scene* pScene );
+
     virtual inline void setSpatialDirty(void) { mSpatialDirty = true; }
 
     virtual bool canPrepareRender( void ) const { return true; }
@@ -81,6 +91,11 @@ public:
     static BatchLayoutType getBatchLayoutTypeEnum( const char* label );
     static const char* getBatchLayoutTypeDescription( const BatchLayoutType batchLayoutType );
 
+    /// Tiles.
+    inline SpriteTileMap& getTileMap( void ) { return mTileMap; }
+    inline void setTileImage( const char* pAssetId ) { mTileMap.setImage( pAssetId ); }
+    inline StringTableEntry getTileImage( void ) const { return mTileMap.getImage(); }
+
     /// Declare Console Object.
     DECLARE_CONOBJECT( CompositeSprite );
 
@@ -93,6 +108,10 @@ protected:
     virtual void onTamlCustomWrite( TamlCustomNodes& customNodes );
     virtual void onTamlCustomRead( const TamlCustomNodes& customNodes );
 
+private:
+    void updateTileLayout( void );
+    void updateTileExtents( void );
+
 protected:
     static bool         writeDefaultSpriteStride( void* obj, StringTableEntry pFieldName )  { return !STATIC_VOID_CAST_TO(CompositeSprite, SpriteBatch, obj)->getDefaultSpriteStride().isEqual( Vector2::getOne() ); }
     static bool         writeDefaultSpriteSize( void* obj, StringTableEntry pFieldName )    { return !STATIC_VOID_CAST_TO(CompositeSprite, SpriteBatch, obj)->getDefaultSpriteSize().isEqual( Vector2::getOne() ); }
@@ -106,6 +125,9 @@ protected:
     static bool         writeBatchLayout( void* obj, StringTableEntry pFieldName )          { return static_cast<CompositeSprite*>(obj)->getBatchLayout() != CompositeSprite::NO_LAYOUT; }
     static bool         setBatchCulling(void* obj, const char* data)                        { STATIC_VOID_CAST_TO(CompositeSprite, SpriteBatch, obj)->setBatchCulling(dAtob(data)); return false; }
     static bool         writeBatchCulling( void* obj, StringTableEntry pFieldName )         { return !static_cast<CompositeSprite*>(obj)->getBatchCulling(); }
+    static bool         setTileImage(void* obj, const char* data)                           { static_cast<CompositeSprite*>(obj)->setTileImage( data ); return false; }
+    static const char*  getTileImage(void* obj, const char* data)                           { return static_cast<CompositeSprite*>(obj)->getTileImage(); }
+    static bool         writeTileImage( void* obj, StringTableEntry pFieldName )            { return static_cast<CompositeSprite*>(obj)->getTileImage() != StringTable->EmptyString; }
 };
 
 #endif // _COMPOSITE_SPRITE_H_
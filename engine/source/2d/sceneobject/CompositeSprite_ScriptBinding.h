@@ -1449,4 +1449,131 @@ ConsoleMethodWithDocs(CompositeSprite, pickRay, ConsoleString, 4, 6, (startx/y,
     return pBuffer;
 }
 
+//-----------------------------------------------------------------------------
+
+/*! Sets the image used by the tiles.
+    Tiles are laid out using the batch layout and the default sprite stride, size and angle.
+    @param imageAssetId The image to use for the tiles.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(CompositeSprite, setTileImage, ConsoleVoid, 3, 3, (imageAssetId))
+{
+    object->setTileImage( argv[2] );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the image used by the tiles.
+    @return The image used by the tiles.
+*/
+ConsoleMethodWithDocs(CompositeSprite, getTileImage, ConsoleString, 2, 2, ())
+{
+    return object->getTileImage();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets the tile at the specified tile position.
+    Tiles are stored in chunks and are much cheaper than sprites for large tile worlds.
+    @param tileX tileY The tile position.
+    @param imageFrame The image frame of the tile image to use.
+    @param flipX Whether the tile is flipped along its local X axis or not.
+    @param flipY Whether the tile is flipped along its local Y axis or not.
+    @return Whether the tile was set or not.
+*/
+ConsoleMethodWithDocs(CompositeSprite, setTile, ConsoleBool, 4, 6, (tileX tileY, imageFrame, [flipX], [flipY]))
+{
+    // Fetch the tile position.
+    S32 tileX = 0, tileY = 0;
+    if ( dSscanf( argv[2], "%d %d", &tileX, &tileY ) != 2 )
+    {
+        // Warn.
+        Con::warnf( "CompositeSprite::setTile() - Invalid tile position of '%s'.", argv[2] );
+        return false;
+    }
+
+    // Fetch the flags.
+    U16 flags = 0;
+    if ( argc >= 5 && dAtob(argv[4]) )
+        flags |= SpriteTileMap::TILE_FLIP_X;
+    if ( argc >= 6 && dAtob(argv[5]) )
+        flags |= SpriteTileMap::TILE_FLIP_Y;
+
+    return object->getTileMap().setTile( tileX, tileY, dAtoi(argv[3]), flags );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the image frame of the tile at the specified tile position.
+    @param tileX tileY The tile position.
+    @return The image frame of the tile or -1 if there is no tile.
+*/
+ConsoleMethodWithDocs(CompositeSprite, getTile, ConsoleInt, 3, 3, (tileX tileY))
+{
+    // Fetch the tile position.
+    S32 tileX = 0, tileY = 0;
+    if ( dSscanf( argv[2], "%d %d", &tileX, &tileY ) != 2 )
+    {
+        // Warn.
+        Con::warnf( "CompositeSprite::getTile() - Invalid tile position of '%s'.", argv[2] );
+        return -1;
+    }
+
+    SpriteTileMap::Tile tile;
+    if ( !object->getTileMap().getTile( tileX, tileY, tile ) )
+        return -1;
+
+    return tile.mFrame;
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Clears the tile at the specified tile position.
+    @param tileX tileY The tile position.
+    @return Whether the tile was cleared or not.
+*/
+ConsoleMethodWithDocs(CompositeSprite, clearTile, ConsoleBool, 3, 3, (tileX tileY))
+{
+    // Fetch the tile position.
+    S32 tileX = 0, tileY = 0;
+    if ( dSscanf( argv[2], "%d %d", &tileX, &tileY ) != 2 )
+    {
+        // Warn.
+        Con::warnf( "CompositeSprite::clearTile() - Invalid tile position of '%s'.", argv[2] );
+        return false;
+    }
+
+    return object->getTileMap().clearTile( tileX, tileY );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Clears all the tiles.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(CompositeSprite, clearTiles, ConsoleVoid, 2, 2, ())
+{
+    object->getTileMap().clearTiles();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets a count of tiles in the composite.
+    @return The count of tiles in the composite.
+*/
+ConsoleMethodWithDocs(CompositeSprite, getTileCount, ConsoleInt, 2, 2, ())
+{
+    return object->getTileMap().getTileCount();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets a count of tile chunks in the composite.
+    @return The count of tile chunks in the composite.
+*/
+ConsoleMethodWithDocs(CompositeSprite, getTileChunkCount, ConsoleInt, 2, 2, ())
+{
+    return object->getTileMap().getChunkCount();
+}
+
 ConsoleMethodGroupEndWithDocs(CompositeSprite)
@@ -0,0 +1,491 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _FLUID_OBJECT_H_
+#include "2d/sceneobject/FluidObject.h"
+#endif
+
+#ifndef _SCENE_H_
+#include "2d/scene/Scene.h"
+#endif
+
+// Script bindings.
+#include "FluidObject_ScriptBinding.h"
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+//------------------------------------------------------------------------------
+
+IMPLEMENT_CONOBJECT(FluidObject);
+
+//------------------------------------------------------------------------------
+
+struct FluidFlagLookup
+{
+    U32         mFlag;
+    const char* mLabel;
+};
+
+static FluidFlagLookup particleFlagLookup[] =
+{
+    { b2_wallParticle,          "wall" },
+    { b2_springParticle,        "spring" },
+    { b2_elasticParticle,       "elastic" },
+    { b2_viscousParticle,       "viscous" },
+    { b2_powderParticle,        "powder" },
+    { b2_tensileParticle,       "tensile" },
+    { b2_colorMixingParticle,   "colorMixing" },
+    { b2_barrierParticle,       "barrier" },
+    { b2_staticPressureParticle,"staticPressure" },
+    { b2_reactiveParticle,      "reactive" },
+    { b2_repulsiveParticle,     "repulsive" },
+};
+
+static FluidFlagLookup groupFlagLookup[] =
+{
+    { b2_solidParticleGroup,        "solid" },
+    { b2_rigidParticleGroup,        "rigid" },
+};
+
+//------------------------------------------------------------------------------
+
+static U32 getFlagsEnum( const char* pLabels, const FluidFlagLookup* pLookup, const U32 lookupCount, const char* pErrorContext )
+{
+    U32 flags = 0;
+
+    // Fetch label count.
+    const U32 labelCount = Utility::mGetStringElementCount( pLabels );
+
+    // Iterate labels.
+    for ( U32 labelIndex = 0; labelIndex < labelCount; ++labelIndex )
+    {
+        // Fetch label.
+        const char* pLabel = Utility::mGetStringElement( pLabels, labelIndex );
+
+        // The default "water" behaviour has no flag.
+        if ( dStricmp( pLabel, "water" ) == 0 || dStricmp( pLabel, "none" ) == 0 )
+            continue;
+
+        U32 lookupIndex = 0;
+        for ( ; lookupIndex < lookupCount; ++lookupIndex )
+        {
+            if ( dStricmp( pLookup[lookupIndex].mLabel, pLabel ) == 0 )
+            {
+                flags |= pLookup[lookupIndex].mFlag;
+                break;
+            }
+        }
+
+        // Warn if not found.
+        if ( lookupIndex == lookupCount )
+            Con::warnf( "%s - Unknown flag '%s'.", pErrorContext, pLabel );
+    }
+
+    return flags;
+}
+
+//------------------------------------------------------------------------------
+
+static const char* getFlagsDescription( const U32 flags, const FluidFlagLookup* pLookup, const U32 lookupCount, const char* pNoFlags )
+{
+    // Fetch a return buffer.
+    const U32 bufferSize = 256;
+    char* pBuffer = Con::getReturnBuffer( bufferSize );
+    pBuffer[0] = 0;
+
+    for ( U32 lookupIndex = 0; lookupIndex < lookupCount; ++lookupIndex )
+    {
+        if ( (flags & pLookup[lookupIndex].mFlag) == 0 )
+            continue;
+
+        if ( pBuffer[0] != 0 )
+            dStrcat( pBuffer, " " );
+
+        dStrcat( pBuffer, pLookup[lookupIndex].mLabel );
+    }
+
+    return pBuffer[0] == 0 ? pNoFlags : pBuffer;
+}
+
+//------------------------------------------------------------------------------
+
+U32 FluidObject::getParticleFlagsEnum( const char* pLabels )
+{
+    return getFlagsEnum( pLabels, particleFlagLookup, sizeof(particleFlagLookup) / sizeof(FluidFlagLookup), "FluidObject::getParticleFlagsEnum()" );
+}
+
+//------------------------------------------------------------------------------
+
+const char* FluidObject::getParticleFlagsDescription( const U32 flags )
+{
+    return getFlagsDescription( flags, particleFlagLookup, sizeof(particleFlagLookup) / sizeof(FluidFlagLookup), "water" );
+}
+
+//------------------------------------------------------------------------------
+
+U32 FluidObject::getGroupFlagsEnum( const char* pLabels )
+{
+    return getFlagsEnum( pLabels, groupFlagLookup, sizeof(groupFlagLookup) / sizeof(FluidFlagLookup), "FluidObject::getGroupFlagsEnum()" );
+}
+
+//------------------------------------------------------------------------------
+
+const char* FluidObject::getGroupFlagsDescription( const U32 flags )
+{
+    return getFlagsDescription( flags, groupFlagLookup, sizeof(groupFlagLookup) / sizeof(FluidFlagLookup), "none" );
+}
+
+//------------------------------------------------------------------------------
+
+FluidObject::FluidObject() :
+    mParticleFlags( b2_waterParticle ),
+    mGroupFlags( 0 ),
+    mParticleColor( 1.0f, 1.0f, 1.0f, 1.0f ),
+    mParticleStrength( 1.0f ),
+    mParticleLifetime( 0.0f ),
+    mParticleStride( 0.0f ),
+    mParticleRenderScale( 1.0f ),
+    mpParticleGroup( NULL )
+{
+    // Set Vector Associations.
+    VECTOR_SET_ASSOCIATION( mRenderVertices );
+    VECTOR_SET_ASSOCIATION( mRenderTexels );
+    VECTOR_SET_ASSOCIATION( mRenderColors );
+
+    // Use a static body by default.
+    mBodyDefinition.type = b2_staticBody;
+}
+
+//------------------------------------------------------------------------------
+
+FluidObject::~FluidObject()
+{
+}
+
+//------------------------------------------------------------------------------
+
+void FluidObject::initPersistFields()
+{
+    // Call parent.
+    Parent::initPersistFields();
+
+    addProtectedField("ParticleFlags", TypeString, 0, &setParticleFlags, &getParticleFlags, &writeParticleFlags, "The behaviour flags of the particles e.g. 'viscous tensile'.");
+    addProtectedField("GroupFlags", TypeString, 0, &setGroupFlags, &getGroupFlags, &writeGroupFlags, "The particle group flags e.g. 'solid rigid'.");
+    addField("ParticleColor", TypeColorF, Offset(mParticleColor, FluidObject), &writeParticleColor, "The color of the particles.");
+    addField("ParticleStrength", TypeF32, Offset(mParticleStrength, FluidObject), &writeParticleStrength, "The cohesion strength of elastic or spring particles.");
+    addField("ParticleLifetime", TypeF32, Offset(mParticleLifetime, FluidObject), &writeParticleLifetime, "The lifetime of the particles in seconds (zero is infinite).");
+    addField("ParticleStride", TypeF32, Offset(mParticleStride, FluidObject), &writeParticleStride, "The spacing of the particles when filling the object area (zero uses the particle diameter).");
+    addField("ParticleRenderScale", TypeF32, Offset(mParticleRenderScale, FluidObject), &writeParticleRenderScale, "The scale of the rendered particle relative to its physical diameter.");
+}
+
+//------------------------------------------------------------------------------
+
+void FluidObject::copyTo( SimObject* object )
+{
+    // Call to parent.
+    Parent::copyTo(object);
+
+    // Cast to fluid object.
+    FluidObject* pFluidObject = static_cast<FluidObject*>(object);
+
+    // Sanity!
+    AssertFatal(pFluidObject != NULL, "FluidObject::copyTo() - Object is not the correct type.");
+
+    pFluidObject->setParticleFlags( getParticleFlags() );
+    pFluidObject->setGroupFlags( getGroupFlags() );
+    pFluidObject->setParticleColor( getParticleColor() );
+    pFluidObject->setParticleStrength( getParticleStrength() );
+    pFluidObject->setParticleLifetime( getParticleLifetime() );
+    pFluidObject->setParticleStride( getParticleStride() );
+    pFluidObject->setParticleRenderScale( getParticleRenderScale() );
+}
+
+//------------------------------------------------------------------------------
+
+void FluidObject::OnRegisterScene( Scene* pScene )
+{
+    // Call parent.
+    Parent::OnRegisterScene( pScene );
+
+    // Create the particles.
+    createParticles();
+}
+
+//------------------------------------------------------------------------------
+
+void FluidObject::OnUnregisterScene( Scene* pScene )
+{
+    // Destroy the particles.
+    destroyParticles();
+
+    // Call parent.
+    Parent::OnUnregisterScene( pScene );
+}
+
+//------------------------------------------------------------------------------
+
+void FluidObject::setParticleFlags( const U32 flags )
+{
+    mParticleFlags = flags;
+
+    // Update any existing particles.
+    if ( mpParticleGroup != NULL )
+    {
+        b2ParticleSystem* pParticleSystem = mpParticleGroup->GetParticleSystem();
+        const S32 firstIndex = mpParticleGroup->GetBufferIndex();
+        const S32 lastIndex = firstIndex + mpParticleGroup->GetParticleCount();
+        for ( S32 index = firstIndex; index < lastIndex; ++index )
+        {
+            pParticleSystem->SetParticleFlags( index, flags );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void FluidObject::setGroupFlags( const U32 flags )
+{
+    mGroupFlags = flags;
+
+    // Update any existing group.
+    if ( mpParticleGroup != NULL )
+        mpParticleGroup->SetGroupFlags( flags );
+}
+
+//------------------------------------------------------------------------------
+
+void FluidObject::createParticles( void )
+{
+    // Finish if not in a scene.
+    if ( getScene() == NULL )
+        return;
+
+    // Remove any existing particles.
+    destroyParticles();
+
+    // Fetch the half-size.
+    const Vector2 halfSize = getHalfSize();
+
+    // Finish if there's no area to fill.
+    if ( halfSize.x <= 0.0f || halfSize.y <= 0.0f )
+        return;
+
+    // Configure the group shape to the object area.
+    b2PolygonShape groupShape;
+    groupShape.SetAsBox( halfSize.x, halfSize.y );
+
+    // Configure the group.
+    b2ParticleGroupDef groupDef;
+    groupDef.flags = mParticleFlags;
+    groupDef.groupFlags = mGroupFlags;
+    groupDef.position = getPosition();
+    groupDef.angle = getAngle();
+    groupDef.linearVelocity = getLinearVelocity();
+    groupDef.color.Set(
+        (uint8)(mClampF( mParticleColor.red, 0.0f, 1.0f ) * 255.0f),
+        (uint8)(mClampF( mParticleColor.green, 0.0f, 1.0f ) * 255.0f),
+        (uint8)(mClampF( mParticleColor.blue, 0.0f, 1.0f ) * 255.0f),
+        (uint8)(mClampF( mParticleColor.alpha, 0.0f, 1.0f ) * 255.0f) );
+    groupDef.strength = mParticleStrength;
+    groupDef.stride = mParticleStride;
+    groupDef.lifetime = mParticleLifetime;
+    groupDef.shape = &groupShape;
+    groupDef.userData = this;
+
+    // Create the group.
+    mpParticleGroup = getScene()->getParticleSystem()->CreateParticleGroup( groupDef );
+}
+
+//------------------------------------------------------------------------------
+
+void FluidObject::destroyParticles( void )
+{
+    // Finish if no particles.
+    if ( mpParticleGroup == NULL )
+        return;
+
+    // Destroy the particles.
+    // NOTE: The particle system destroys the empty group during the next step so disown it now.
+    mpParticleGroup->SetUserData( NULL );
+    mpParticleGroup->DestroyParticles();
+    mpParticleGroup = NULL;
+}
+
+//------------------------------------------------------------------------------
+
+U32 FluidObject::getParticleCount( void ) const
+{
+    return mpParticleGroup == NULL ? 0 : (U32)mpParticleGroup->GetParticleCount();
+}
+
+//------------------------------------------------------------------------------
+
+void FluidObject::applyLinearImpulse( const Vector2& impulse )
+{
+    if ( mpParticleGroup != NULL && mpParticleGroup->GetParticleCount() > 0 )
+        mpParticleGroup->ApplyLinearImpulse( impulse );
+}
+
+//------------------------------------------------------------------------------
+
+void FluidObject::applyForce( const Vector2& force )
+{
+    if ( mpParticleGroup != NULL && mpParticleGroup->GetParticleCount() > 0 )
+        mpParticleGroup->ApplyForce( force );
+}
+
+//------------------------------------------------------------------------------
+
+void FluidObject::integrateObject( const F32 totalTime, const F32 elapsedTime, DebugStats* pDebugStats )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(FluidObject_IntegrateObject);
+
+    // Call Parent.
+    Parent::integrateObject( totalTime, elapsedTime, pDebugStats );
+
+    // Finish if no particles.
+    if ( mpParticleGroup == NULL )
+        return;
+
+    // Fetch the particle count.
+    const S32 particleCount = mpParticleGroup->GetParticleCount();
+
+    // Has the group been emptied?
+    if ( particleCount == 0 )
+    {
+        // Yes, so disown it as the particle system will destroy it.
+        mpParticleGroup->SetUserData( NULL );
+        mpParticleGroup = NULL;
+        return;
+    }
+
+    // Fetch the particle positions.
+    const b2ParticleSystem* pParticleSystem = mpParticleGroup->GetParticleSystem();
+    const b2Vec2* pPositions = pParticleSystem->GetPositionBuffer() + mpParticleGroup->GetBufferIndex();
+
+    // Calculate the particle bounds.
+    b2AABB particleAABB;
+    particleAABB.lowerBound = particleAABB.upperBound = pPositions[0];
+    for ( S32 index = 1; index < particleCount; ++index )
+    {
+        particleAABB.lowerBound = b2Min( particleAABB.lowerBound, pPositions[index] );
+        particleAABB.upperBound = b2Max( particleAABB.upperBound, pPositions[index] );
+    }
+
+    // Expand by the rendered particle extent.
+    const F32 renderExtent = pParticleSystem->GetRadius() * mParticleRenderScale;
+    particleAABB.lowerBound -= b2Vec2( renderExtent, renderExtent );
+    particleAABB.upperBound += b2Vec2( renderExtent, renderExtent );
+
+    // The particles move independently of the object so the render proxy covers both.
+    mCurrentAABB.Combine( particleAABB );
+
+    // Calculate tick AABB.
+    b2AABB tickAABB;
+    tickAABB.Combine( mPreTickAABB, mCurrentAABB );
+
+    // Update world proxy.
+    getScene()->getWorldQuery()->update( this, tickAABB, b2Vec2( 0.0f, 0.0f ) );
+
+    // Flag spatial dirty so the pre-tick AABB follows the particles.
+    mSpatialDirty = true;
+}
+
+//------------------------------------------------------------------------------
+
+void FluidObject::sceneRender( const SceneRenderState* pSceneRenderState, const SceneRenderRequest* pSceneRenderRequest, BatchRender* pBatchRenderer )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(FluidObject_SceneRender);
+
+    // Finish if we can't render.
+    if ( mpParticleGroup == NULL || !ImageFrameProvider::validRender() )
+        return;
+
+    // Fetch the particle count.
+    const S32 particleCount = mpParticleGroup->GetParticleCount();
+
+    // Finish if no particles.
+    if ( particleCount == 0 )
+        return;
+
+    // Fetch the particle buffers.
+    b2ParticleSystem* pParticleSystem = mpParticleGroup->GetParticleSystem();
+    const S32 bufferIndex = mpParticleGroup->GetBufferIndex();
+    const b2Vec2* pPositions = pParticleSystem->GetPositionBuffer() + bufferIndex;
+    const b2ParticleColor* pColors = pParticleSystem->GetColorBuffer() + bufferIndex;
+
+    // Fetch texture and texture area.
+    const ImageAsset::FrameArea::TexelArea& frameTexelArea = getProviderImageFrameArea().mTexelArea;
+    const Vector2& texLower = frameTexelArea.mTexelLower;
+    const Vector2& texUpper = frameTexelArea.mTexelUpper;
+    TextureHandle& texture = getProviderTexture();
+
+    // Fetch the particle render extent.
+    const F32 renderExtent = pParticleSystem->GetRadius() * mParticleRenderScale;
+
+    // Fetch the blend color.
+    const ColorF& blendColor = getBlendColor();
+    const F32 colorScale = 1.0f / 255.0f;
+
+    // Size the scratch buffers.
+    const U32 vertexCount = (U32)particleCount * 4;
+    mRenderVertices.setSize( vertexCount );
+    mRenderTexels.setSize( vertexCount );
+    mRenderColors.setSize( (U32)particleCount );
+
+    Vector2* pVertex = mRenderVertices.address();
+    Vector2* pTexel = mRenderTexels.address();
+    ColorF* pColor = mRenderColors.address();
+
+    // Generate a quad per particle.
+    for ( S32 index = 0; index < particleCount; ++index )
+    {
+        const b2Vec2& position = pPositions[index];
+        const b2ParticleColor& particleColor = pColors[index];
+
+        pVertex[0].Set( position.x - renderExtent, position.y - renderExtent );
+        pVertex[1].Set( position.x + renderExtent, position.y - renderExtent );
+        pVertex[2].Set( position.x + renderExtent, position.y + renderExtent );
+        pVertex[3].Set( position.x - renderExtent, position.y + renderExtent );
+        pVertex += 4;
+
+        pTexel[0].Set( texLower.x, texUpper.y );
+        pTexel[1].Set( texUpper.x, texUpper.y );
+        pTexel[2].Set( texUpper.x, texLower.y );
+        pTexel[3].Set( texLower.x, texLower.y );
+        pTexel += 4;
+
+        pColor->set(
+            particleColor.r * colorScale * blendColor.red,
+            particleColor.g * colorScale * blendColor.green,
+            particleColor.b * colorScale * blendColor.blue,
+            particleColor.a * colorScale * blendColor.alpha );
+        pColor++;
+    }
+
+    // Submit all the particles in a single batch.
+    pBatchRenderer->SubmitQuads( (U32)particleCount, mRenderVertices.address(), mRenderTexels.address(), mRenderColors.address(), texture );
+}
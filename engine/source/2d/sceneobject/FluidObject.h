@@ -0,0 +1,116 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _FLUID_OBJECT_H_
+#define _FLUID_OBJECT_H_
+
+#ifndef _SPRITE_BASE_H_
+#include "2d/core/SpriteBase.h"
+#endif
+
+//------------------------------------------------------------------------------
+
+class FluidObject : public SpriteBase
+{
+    typedef SpriteBase Parent;
+
+private:
+    /// Particle group configuration.
+    U32                 mParticleFlags;
+    U32                 mGroupFlags;
+    ColorF              mParticleColor;
+    F32                 mParticleStrength;
+    F32                 mParticleLifetime;
+    F32                 mParticleStride;
+    F32                 mParticleRenderScale;
+
+    /// The particle group (owned by the scenes particle system).
+    b2ParticleGroup*    mpParticleGroup;
+
+    /// Render scratch buffers.
+    Vector<Vector2>     mRenderVertices;
+    Vector<Vector2>     mRenderTexels;
+    Vector<ColorF>      mRenderColors;
+
+public:
+    FluidObject();
+    virtual ~FluidObject();
+
+    static void initPersistFields();
+
+    virtual void OnRegisterScene( Scene* pScene );
+    virtual void OnUnregisterScene( Scene* pScene );
+
+    virtual void integrateObject( const F32 totalTime, const F32 elapsedTime, DebugStats* pDebugStats );
+    virtual void sceneRender( const SceneRenderState* pSceneRenderState, const SceneRenderRequest* pSceneRenderRequest, BatchRender* pBatchRenderer );
+
+    virtual void copyTo( SimObject* object );
+
+    /// Particle group configuration.
+    void setParticleFlags( const U32 flags );
+    inline U32 getParticleFlags( void ) const                       { return mParticleFlags; }
+    void setGroupFlags( const U32 flags );
+    inline U32 getGroupFlags( void ) const                          { return mGroupFlags; }
+    inline void setParticleColor( const ColorF& color )             { mParticleColor = color; }
+    inline const ColorF& getParticleColor( void ) const             { return mParticleColor; }
+    inline void setParticleStrength( const F32 strength )           { mParticleStrength = strength; }
+    inline F32 getParticleStrength( void ) const                    { return mParticleStrength; }
+    inline void setParticleLifetime( const F32 lifetime )           { mParticleLifetime = lifetime; }
+    inline F32 getParticleLifetime( void ) const                    { return mParticleLifetime; }
+    inline void setParticleStride( const F32 stride )               { mParticleStride = stride; }
+    inline F32 getParticleStride( void ) const                      { return mParticleStride; }
+    inline void setParticleRenderScale( const F32 scale )           { mParticleRenderScale = scale; }
+    inline F32 getParticleRenderScale( void ) const                 { return mParticleRenderScale; }
+
+    /// Particle group.
+    void createParticles( void );
+    void destroyParticles( void );
+    U32 getParticleCount( void ) const;
+    inline void onParticleGroupDestroyed( b2ParticleGroup* pParticleGroup ) { if ( mpParticleGroup == pParticleGroup ) mpParticleGroup = NULL; }
+    void applyLinearImpulse( const Vector2& impulse );
+    void applyForce( const Vector2& force );
+
+    /// Flag descriptions.
+    static U32 getParticleFlagsEnum( const char* pLabels );
+    static const char* getParticleFlagsDescription( const U32 flags );
+    static U32 getGroupFlagsEnum( const char* pLabels );
+    static const char* getGroupFlagsDescription( const U32 flags );
+
+    /// Declare Console Object.
+    DECLARE_CONOBJECT( FluidObject );
+
+protected:
+    static bool setParticleFlags(void* obj, const char* data)                   { static_cast<FluidObject*>(obj)->setParticleFlags( getParticleFlagsEnum(data) ); return false; }
+    static const char* getParticleFlags(void* obj, const char* data)            { return getParticleFlagsDescription( static_cast<FluidObject*>(obj)->getParticleFlags() ); }
+    static bool writeParticleFlags( void* obj, StringTableEntry pFieldName )    { return static_cast<FluidObject*>(obj)->getParticleFlags() != b2_waterParticle; }
+    static bool setGroupFlags(void* obj, const char* data)                      { static_cast<FluidObject*>(obj)->setGroupFlags( getGroupFlagsEnum(data) ); return false; }
+    static const char* getGroupFlags(void* obj, const char* data)               { return getGroupFlagsDescription( static_cast<FluidObject*>(obj)->getGroupFlags() ); }
+    static bool writeGroupFlags( void* obj, StringTableEntry pFieldName )       { return static_cast<FluidObject*>(obj)->getGroupFlags() != 0; }
+    static bool writeParticleColor( void* obj, StringTableEntry pFieldName )    { return static_cast<FluidObject*>(obj)->getParticleColor() != ColorF(1.0f, 1.0f, 1.0f, 1.0f); }
+    static bool writeParticleStrength( void* obj, StringTableEntry pFieldName ) { return mNotEqual( static_cast<FluidObject*>(obj)->getParticleStrength(), 1.0f ); }
+    static bool writeParticleLifetime( void* obj, StringTableEntry pFieldName ) { return mNotZero( static_cast<FluidObject*>(obj)->getParticleLifetime() ); }
+    static bool writeParticleStride( void* obj, StringTableEntry pFieldName )   { return mNotZero( static_cast<FluidObject*>(obj)->getParticleStride() ); }
+    static bool writeParticleRenderScale( void* obj, StringTableEntry pFieldName ) { return mNotEqual( static_cast<FluidObject*>(obj)->getParticleRenderScale(), 1.0f ); }
+};
+
+#endif // _FLUID_OBJECT_H_
@@ -0,0 +1,165 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+ConsoleMethodGroupBeginWithDocs(FluidObject, SpriteBase)
+
+/*! Creates the fluid particles filling the objects area, replacing any existing particles.
+    The particles are created automatically when the object is added to a scene.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(FluidObject, createParticles, ConsoleVoid, 2, 2, ())
+{
+    object->createParticles();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Destroys all the fluid particles.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(FluidObject, destroyParticles, ConsoleVoid, 2, 2, ())
+{
+    object->destroyParticles();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the number of fluid particles.
+    @return The number of fluid particles.
+*/
+ConsoleMethodWithDocs(FluidObject, getParticleCount, ConsoleInt, 2, 2, ())
+{
+    return (S32)object->getParticleCount();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets the particle behaviour flags.
+    @param flags A space separated list of flags from: water wall spring elastic viscous powder tensile colorMixing barrier staticPressure reactive repulsive.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(FluidObject, setParticleFlags, ConsoleVoid, 3, 3, (flags))
+{
+    object->setParticleFlags( FluidObject::getParticleFlagsEnum(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the particle behaviour flags.
+    @return A space separated list of the particle behaviour flags.
+*/
+ConsoleMethodWithDocs(FluidObject, getParticleFlags, ConsoleString, 2, 2, ())
+{
+    return FluidObject::getParticleFlagsDescription( object->getParticleFlags() );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets the particle group flags.
+    @param flags A space separated list of flags from: none solid rigid.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(FluidObject, setGroupFlags, ConsoleVoid, 3, 3, (flags))
+{
+    object->setGroupFlags( FluidObject::getGroupFlagsEnum(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the particle group flags.
+    @return A space separated list of the particle group flags.
+*/
+ConsoleMethodWithDocs(FluidObject, getGroupFlags, ConsoleString, 2, 2, ())
+{
+    return FluidObject::getGroupFlagsDescription( object->getGroupFlags() );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets the color used when creating particles.
+    @param color The color as "R G B [A]" or a stock color name.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(FluidObject, setParticleColor, ConsoleVoid, 3, 3, (color))
+{
+    ColorF color;
+    Con::setData( TypeColorF, &color, 0, 1, &(argv[2]) );
+    object->setParticleColor( color );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the color used when creating particles.
+    @return The color as "R G B A".
+*/
+ConsoleMethodWithDocs(FluidObject, getParticleColor, ConsoleString, 2, 2, ())
+{
+    return Con::getData( TypeColorF, &const_cast<ColorF&>(object->getParticleColor()), 0 );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets the scale of the rendered particles relative to their physical diameter.
+    @param scale The render scale.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(FluidObject, setParticleRenderScale, ConsoleVoid, 3, 3, (float scale))
+{
+    object->setParticleRenderScale( dAtof(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the scale of the rendered particles relative to their physical diameter.
+    @return The render scale.
+*/
+ConsoleMethodWithDocs(FluidObject, getParticleRenderScale, ConsoleFloat, 2, 2, ())
+{
+    return object->getParticleRenderScale();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Applies a linear impulse distributed across all the particles.
+    @param impulse The impulse as "x y" or separate x and y values.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(FluidObject, applyParticleImpulse, ConsoleVoid, 3, 4, (float impulseX, float impulseY))
+{
+    const Vector2 impulse = argc == 3 ? Utility::mGetStringElementVector(argv[2]) : Vector2( dAtof(argv[2]), dAtof(argv[3]) );
+    object->applyLinearImpulse( impulse );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Applies a force distributed across all the particles.
+    @param force The force as "x y" or separate x and y values.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(FluidObject, applyParticleForce, ConsoleVoid, 3, 4, (float forceX, float forceY))
+{
+    const Vector2 force = argc == 3 ? Utility::mGetStringElementVector(argv[2]) : Vector2( dAtof(argv[2]), dAtof(argv[3]) );
+    object->applyForce( force );
+}
+
+ConsoleMethodGroupEndWithDocs(FluidObject)
@@ -10,7 +10,11 @@ IMPLEMENT_CONOBJECT(LightObject);
 
 LightObject::LightObject():
    mLightRadius(10.0f),
-   mLightSegments(15)
+   mLightSegments(15),
+   mLightBatched(false),
+   mVisibilityValid(false),
+   mVisibilityRadius(0.0f),
+   mVisibilitySegments(0)
 {
    mSrcBlendFactor = GL_SRC_ALPHA;
    mDstBlendFactor = GL_ONE;
@@ -48,6 +52,7 @@ void LightObject::initPersistFields()
    /// Light settings.
    addProtectedField("LightRadius", TypeF32, Offset(mLightRadius, LightObject), &setLightRadius, &defaultProtectedGetFn, &writeLightRadius, "");
    addProtectedField("LightSegments", TypeS32, Offset(mLightSegments, LightObject), &setLightSegments, &defaultProtectedGetFn, &writeLightSegments, "");
+   addProtectedField("LightBatched", TypeBool, Offset(mLightBatched, LightObject), &setLightBatched, &defaultProtectedGetFn, &writeLightBatched, "Whether the light is composited through the batch renderer in a single pass with other lights sharing its blend mode.");
 
 }
 
@@ -56,157 +61,438 @@ void LightObject::safeDelete(void)
    Parent::safeDelete();
 }
 
+static S32 QSORT_CALLBACK sortOccluders(const void* a, const void* b)
+{
+   const LightObject::LightOccluder* pOccluderA = (const LightObject::LightOccluder*)a;
+   const LightObject::LightOccluder* pOccluderB = (const LightObject::LightOccluder*)b;
+
+   return pOccluderA->mpFixture < pOccluderB->mpFixture ? -1 : pOccluderA->mpFixture > pOccluderB->mpFixture ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+
+static S32 QSORT_CALLBACK sortSweepEvents(const void* a, const void* b)
+{
+   const LightObject::LightSweepEvent* pEventA = (const LightObject::LightSweepEvent*)a;
+   const LightObject::LightSweepEvent* pEventB = (const LightObject::LightSweepEvent*)b;
+
+   return pEventA->mAngle < pEventB->mAngle ? -1 : pEventA->mAngle > pEventB->mAngle ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+
+class LightOccluderQueryCallback : public b2QueryCallback
+{
+public:
+   LightOccluderQueryCallback(Vector<LightObject::LightOccluder>& occluders, const b2Body* pLightBody) :
+      mOccluders(occluders),
+      mpLightBody(pLightBody)
+   {
+   }
+
+   virtual bool ReportFixture(b2Fixture* fixture)
+   {
+      // Ignore the light itself and sensors.
+      if (fixture->GetBody() == mpLightBody || fixture->IsSensor())
+         return true;
+
+      LightObject::LightOccluder occluder;
+      occluder.mpFixture = fixture;
+      occluder.mTransform = fixture->GetBody()->GetTransform();
+      mOccluders.push_back(occluder);
+
+      return true;
+   }
+
+private:
+   Vector<LightObject::LightOccluder>& mOccluders;
+   const b2Body* mpLightBody;
+};
+
+//----------------------------------------------------------------------------
+
 void LightObject::sceneRender(const SceneRenderState * sceneRenderState, const SceneRenderRequest * sceneRenderRequest, BatchRender * batchRender)
 {
-   Vector2 worldPos = getPosition();
-   Vector<Vector2> verts;
-   Vector<RayList> bList;
-   S32 mSrcLightBlend = getSrcBlendFactor();
-   S32 mDstLightBlend = getDstBlendFactor();
-   ColorF mLightColor = getBlendColor();
+   // Debug Profiling.
+   PROFILE_SCOPE(LightObject_SceneRender);
+
+   const F32 radius = getLightRadius();
+
+   // Finish if the light has no area.
+   if (radius <= 0.0f)
+      return;
+
+   // Update the visibility polygon.
+   const Vector<Vector2>& visibilityPoints = updateVisibility();
+
+   // Finish if nothing is visible.
+   if (visibilityPoints.size() < 3)
+      return;
+
+   if (mLightBatched)
+      renderBatched(mVisibilityPosition, radius, batchRender);
+   else
+      renderImmediate(mVisibilityPosition, radius);
+}
+
+//----------------------------------------------------------------------------
+
+const Vector<Vector2>& LightObject::updateVisibility(void)
+{
+   // Debug Profiling.
+   PROFILE_SCOPE(LightObject_UpdateVisibility);
+
+   const Vector2 lightPosition = getPosition();
+   const F32 radius = getLightRadius();
+   const U32 segments = getLightSegments() < 3 ? 3 : getLightSegments();
+
+   // Gather the occluders within the light radius.
+   gatherOccluders(lightPosition, radius);
+
+   // Reuse the visibility if neither the light nor its occluders have changed.
+   if (mVisibilityValid &&
+      mVisibilityPosition == lightPosition &&
+      mVisibilityRadius == radius &&
+      mVisibilitySegments == segments &&
+      mVisibilityOccluders.size() == mOccluders.size() &&
+      (mOccluders.size() == 0 || dMemcmp(mVisibilityOccluders.address(), mOccluders.address(), mOccluders.size() * sizeof(LightOccluder)) == 0))
+   {
+      return mVisibilityPoints;
+   }
+
+   mVisibilityPosition = lightPosition;
+   mVisibilityRadius = radius;
+   mVisibilitySegments = segments;
+   mVisibilityOccluders = mOccluders;
+
+   // Build the occluder edges relative to the light.
+   mEdges.clear();
+   for (S32 i = 0; i < mOccluders.size(); i++)
+   {
+      addOccluderEdges(mOccluders[i].mpFixture, mOccluders[i].mTransform, lightPosition, radius);
+   }
+
+   // The light boundary always closes the polygon.
+   const F32 segmentAngle = M_2PI_F / segments;
+   Vector2 boundaryStart(radius, 0.0f);
+   for (U32 i = 1; i <= segments; i++)
+   {
+      const F32 angle = i == segments ? 0.0f : segmentAngle * i;
+      const Vector2 boundaryEnd(radius * mCos(angle), radius * mSin(angle));
+      addOccluderEdge(boundaryStart, boundaryEnd, radius);
+      boundaryStart = boundaryEnd;
+   }
+
+   // Sweep the edges.
+   sweepVisibility(radius);
+
+   mVisibilityValid = true;
+
+   return mVisibilityPoints;
+}
+
+//----------------------------------------------------------------------------
+
+void LightObject::gatherOccluders(const Vector2& lightPosition, const F32 radius)
+{
+   // Debug Profiling.
+   PROFILE_SCOPE(LightObject_GatherOccluders);
+
+   mOccluders.clear();
 
-   F32 radius = getLightRadius();
    Scene* scene = getScene();
-   b2World* mWorld = scene->getWorld();
+   if (scene == NULL)
+      return;
 
+   b2AABB lightAABB;
+   lightAABB.lowerBound.Set(lightPosition.x - radius, lightPosition.y - radius);
+   lightAABB.upperBound.Set(lightPosition.x + radius, lightPosition.y + radius);
 
-   
+   LightOccluderQueryCallback callback(mOccluders, getBody());
+   scene->getWorld()->QueryAABB(&callback, lightAABB);
 
-   glEnable(GL_BLEND);
-   glDisable(GL_TEXTURE_2D);
-   glPushMatrix();
- 
-   glTranslatef(worldPos.x, worldPos.y, 0);
-   glPolygonMode(GL_FRONT, GL_FILL);
+   // Order the occluders so they can be compared against the cached set.
+   if (mOccluders.size() > 1)
+   {
+      dQsort(mOccluders.address(), mOccluders.size(), sizeof(LightOccluder), sortOccluders);
+   }
+}
 
-   //additive blending
-   //glBlendFunc(GL_ONE,GL_ONE);
-   
-   glBlendFunc(mSrcLightBlend, mDstLightBlend);
-   // Creates the fading dark region.
-   glBegin(GL_TRIANGLE_FAN);
-   glColor4f(mLightColor.red,mLightColor.green,mLightColor.blue,mLightColor.alpha);
-   glVertex2f(0, 0);
-   //check scene objects
-   U32 objCount = scene->getSceneObjectCount();
-   for (U32 i = 0; i < objCount; i++)
+//----------------------------------------------------------------------------
+
+void LightObject::addOccluderEdge(const Vector2& start, const Vector2& end, const F32 radius)
+{
+   // Wind the edge counter-clockwise around the light, ignoring edges pointing at it.
+   const F32 winding = start.x * end.y - start.y * end.x;
+   if (mFabs(winding) < FLT_EPSILON)
+      return;
+
+   const Vector2& edgeStart = winding > 0.0f ? start : end;
+   const Vector2& edgeEnd = winding > 0.0f ? end : start;
+
+   // Ignore edges outside of the light.
+   const Vector2 edge = edgeEnd - edgeStart;
+   const F32 edgeLengthSqr = edge.LengthSquared();
+   const F32 closest = edgeLengthSqr > 0.0f ? mClampF(-(edgeStart.x * edge.x + edgeStart.y * edge.y) / edgeLengthSqr, 0.0f, 1.0f) : 0.0f;
+   const Vector2 closestPoint = edgeStart + edge * closest;
+   if (closestPoint.LengthSquared() > radius * radius)
+      return;
+
+   LightEdge lightEdge;
+   lightEdge.mStart = edgeStart;
+   lightEdge.mEnd = edgeEnd;
+   lightEdge.mStartAngle = mAtan(edgeStart.x, edgeStart.y);
+   lightEdge.mEndAngle = mAtan(edgeEnd.x, edgeEnd.y);
+   mEdges.push_back(lightEdge);
+}
+
+//----------------------------------------------------------------------------
+
+void LightObject::addOccluderEdges(const b2Fixture* pFixture, const b2Transform& transform, const Vector2& lightPosition, const F32 radius)
+{
+   const b2Shape* pShape = pFixture->GetShape();
+
+   switch (pShape->GetType())
    {
-      SceneObject *tObj = scene->getSceneObject(i);
-      Vector2 dist = worldPos - tObj->getPosition();
-      const F32 distSqr = dist.LengthSquared();
-      const F32 radSqr = radius * radius;
-      //within radius?
-      if (distSqr < radSqr || distSqr == radSqr)
+   case b2Shape::e_polygon:
       {
-         U32 shapeCount = tObj->getCollisionShapeCount();
-         for (U32 j = 0; j < shapeCount; j++)
+         const b2PolygonShape* pPolygonShape = static_cast<const b2PolygonShape*>(pShape);
+         const S32 vertexCount = pPolygonShape->m_count;
+         Vector2 previous = Vector2(b2Mul(transform, pPolygonShape->m_vertices[vertexCount - 1])) - lightPosition;
+         for (S32 i = 0; i < vertexCount; i++)
          {
-            //All vertices from polygon collision shape
-            if (tObj->getCollisionShapeType(j) == b2Shape::e_polygon)
-            {
-               U32 pCount = tObj->getPolygonCollisionShapePointCount(j);
+            const Vector2 current = Vector2(b2Mul(transform, pPolygonShape->m_vertices[i])) - lightPosition;
+            addOccluderEdge(previous, current, radius);
+            previous = current;
+         }
+         break;
+      }
 
-               for (U32 k = 0; k < pCount; k++)
-               {
-                  Vector2 locPoint = tObj->getPolygonCollisionShapeLocalPoint(j, k);
-                  Vector2 wPoint = tObj->getWorldPoint(locPoint);
-                  verts.push_back(wPoint);
-               }
-            }
+   case b2Shape::e_edge:
+      {
+         const b2EdgeShape* pEdgeShape = static_cast<const b2EdgeShape*>(pShape);
+         addOccluderEdge(Vector2(b2Mul(transform, pEdgeShape->m_vertex1)) - lightPosition, Vector2(b2Mul(transform, pEdgeShape->m_vertex2)) - lightPosition, radius);
+         break;
+      }
+
+   case b2Shape::e_chain:
+      {
+         const b2ChainShape* pChainShape = static_cast<const b2ChainShape*>(pShape);
+         for (S32 i = 1; i < pChainShape->m_count; i++)
+         {
+            addOccluderEdge(Vector2(b2Mul(transform, pChainShape->m_vertices[i - 1])) - lightPosition, Vector2(b2Mul(transform, pChainShape->m_vertices[i])) - lightPosition, radius);
          }
+         break;
       }
+
+   case b2Shape::e_circle:
+      {
+         const b2CircleShape* pCircleShape = static_cast<const b2CircleShape*>(pShape);
+         const Vector2 center = Vector2(b2Mul(transform, pCircleShape->m_p)) - lightPosition;
+         const F32 circleRadius = pCircleShape->m_radius;
+         const F32 segmentAngle = M_2PI_F / CIRCLE_OCCLUDER_SEGMENTS;
+         Vector2 previous = center + Vector2(circleRadius, 0.0f);
+         for (U32 i = 1; i <= CIRCLE_OCCLUDER_SEGMENTS; i++)
+         {
+            const F32 angle = i == CIRCLE_OCCLUDER_SEGMENTS ? 0.0f : segmentAngle * i;
+            const Vector2 current = center + Vector2(circleRadius * mCos(angle), circleRadius * mSin(angle));
+            addOccluderEdge(previous, current, radius);
+            previous = current;
+         }
+         break;
+      }
+
+   default:
+      break;
    }
-   ///  \ | /
-   /// -  +  -
-   ///  / | \
+}
 
-   U32 lightSeg = getLightSegments();
-   F32 segAng = 360.0f / lightSeg;
+//----------------------------------------------------------------------------
 
-   for (U32 i = 0; i <= lightSeg; i++)
+F32 LightObject::getNearestEdgeDistance(const Vector2& direction, const F32 radius) const
+{
+   F32 nearest = radius;
+
+   for (S32 i = 0; i < mActiveEdges.size(); i++)
    {
-      b2Vec2 segStrt = worldPos;
-      b2Vec2 segEnd = segStrt + radius * b2Vec2(mCos(mDegToRad((F32)segAng * i)), mSin(mDegToRad((F32)segAng * i)));
-      verts.push_back(segEnd);
+      const LightEdge& lightEdge = mEdges[mActiveEdges[i]];
+      const Vector2 edge = lightEdge.mEnd - lightEdge.mStart;
+      const F32 denominator = direction.x * edge.y - direction.y * edge.x;
+
+      // Use the nearest end-point if the ray runs along the edge.
+      const F32 distance = mFabs(denominator) < FLT_EPSILON ?
+         getMin(lightEdge.mStart.Length(), lightEdge.mEnd.Length()) :
+         (lightEdge.mStart.x * edge.y - lightEdge.mStart.y * edge.x) / denominator;
+
+      if (distance >= 0.0f && distance < nearest)
+         nearest = distance;
    }
 
-   //cast ray to vertices
-   for (S32 l = 0; l < verts.size(); l++)
+   return nearest;
+}
+
+//----------------------------------------------------------------------------
+
+void LightObject::sweepVisibility(const F32 radius)
+{
+   // Debug Profiling.
+   PROFILE_SCOPE(LightObject_SweepVisibility);
+
+   mVisibilityPoints.clear();
+   mSweepEvents.clear();
+   mActiveEdges.clear();
+
+   // Build the sweep events.
+   for (S32 i = 0; i < mEdges.size(); i++)
    {
-      F32 rayLength = radius;
-      Vector2 p1 = worldPos;
-      Vector2 p2 = verts[l];
-      F32 baseAng = mAtan(p2.x, p2.y);
-      F32 cAng = 0;
-      for (int m = 0; m < 2; m++)
-      {
-         if (m == 0)cAng = baseAng - 0.0001f;
-         //if (m == 1)cAng = baseAng;
-         if (m == 1)cAng = baseAng + 0.0001f;
+      const LightEdge& lightEdge = mEdges[i];
 
-         p2.x = rayLength * mCos(cAng);
-         p2.y = rayLength * mSin(cAng);
+      LightSweepEvent sweepEvent;
+      sweepEvent.mEdgeIndex = i;
 
-         RaysCastCallback callback;
-         mWorld->RayCast(&callback, p1, p2);
-         if (callback.m_fixture)
-         {
+      sweepEvent.mAngle = lightEdge.mStartAngle;
+      sweepEvent.mEdgeStart = true;
+      mSweepEvents.push_back(sweepEvent);
 
-            F32 ang = mAtan(callback.m_point.x - p1.x, callback.m_point.y - p1.y);
-            Vector2 intersection = p1 + callback.m_fraction * (p2 - p1);
-            
-            RayList intersectionPoint;
-            intersectionPoint.ang = ang;
-            intersectionPoint.x = intersection.x;
-            intersectionPoint.y = intersection.y;
-            intersectionPoint.l = callback.m_fraction;
+      sweepEvent.mAngle = lightEdge.mEndAngle;
+      sweepEvent.mEdgeStart = false;
+      mSweepEvents.push_back(sweepEvent);
 
+      // Edges crossing the start of the sweep are already active.
+      if (lightEdge.mStartAngle > lightEdge.mEndAngle)
+         mActiveEdges.push_back(i);
+   }
+
+   dQsort(mSweepEvents.address(), mSweepEvents.size(), sizeof(LightSweepEvent), sortSweepEvents);
+
+   // Sweep counter-clockwise, emitting the nearest hit either side of each event angle.
+   const F32 pointToleranceSqr = 1.0e-6f * radius * radius;
+   S32 eventIndex = 0;
+   while (eventIndex < mSweepEvents.size())
+   {
+      const F32 angle = mSweepEvents[eventIndex].mAngle;
+      const Vector2 direction(mCos(angle), mSin(angle));
+
+      const Vector2 pointBefore = direction * getNearestEdgeDistance(direction, radius);
 
-            bList.push_back_unique(intersectionPoint);
+      // Update the active edges for all events at this angle.
+      for (; eventIndex < mSweepEvents.size() && mSweepEvents[eventIndex].mAngle == angle; eventIndex++)
+      {
+         const LightSweepEvent& sweepEvent = mSweepEvents[eventIndex];
 
+         if (sweepEvent.mEdgeStart)
+         {
+            mActiveEdges.push_back(sweepEvent.mEdgeIndex);
          }
          else
          {
-            F32 ang = mAtan(p2.x - p1.x, p2.y - p1.y);
-
-            RayList intersectionPoint;
-            intersectionPoint.ang = ang;
-            intersectionPoint.x = p2.x;
-            intersectionPoint.y = p2.y;
-            intersectionPoint.l = 1.0;
-
-            bList.push_back_unique(intersectionPoint);
+            for (S32 i = 0; i < mActiveEdges.size(); i++)
+            {
+               if (mActiveEdges[i] == sweepEvent.mEdgeIndex)
+               {
+                  mActiveEdges.erase_fast(i);
+                  break;
+               }
+            }
          }
       }
+
+      const Vector2 pointAfter = direction * getNearestEdgeDistance(direction, radius);
+
+      if (mVisibilityPoints.size() == 0 || (mVisibilityPoints.last() - pointBefore).LengthSquared() > pointToleranceSqr)
+         mVisibilityPoints.push_back(pointBefore);
+
+      if ((pointAfter - pointBefore).LengthSquared() > pointToleranceSqr)
+         mVisibilityPoints.push_back(pointAfter);
    }
+}
+
+//----------------------------------------------------------------------------
+
+void LightObject::renderImmediate(const Vector2& worldPosition, const F32 radius)
+{
+   const ColorF lightColor = getBlendColor();
+
+   glEnable(GL_BLEND);
+   glDisable(GL_TEXTURE_2D);
+   glPushMatrix();
 
-   //Con::printf("Rays cast: %i", bList.size());
-   //sort the list
-   if (bList.size() > 1)
+   glTranslatef(worldPosition.x, worldPosition.y, 0);
+   glPolygonMode(GL_FRONT, GL_FILL);
+
+   glBlendFunc(getSrcBlendFactor(), getDstBlendFactor());
+
+   // Creates the fading dark region.
+   glBegin(GL_TRIANGLE_FAN);
+   glColor4f(lightColor.red, lightColor.green, lightColor.blue, lightColor.alpha);
+   glVertex2f(0, 0);
+
+   const S32 pointCount = mVisibilityPoints.size();
+   for (S32 i = 0; i <= pointCount; i++)
    {
-      dQsort(bList.address(), bList.size(), sizeof(RayList), sortRays);
+      // Close off the fan with the first point.
+      const Vector2& point = mVisibilityPoints[i == pointCount ? 0 : i];
+      const F32 intensity = 1.0f - getMin(point.Length() / radius, 1.0f);
+      glColor4f(lightColor.red * intensity, lightColor.green * intensity, lightColor.blue * intensity, lightColor.alpha * intensity);
+      glVertex2f(point.x, point.y);
    }
 
-   
+   glEnd();
 
-   //triangle fan
-   for (S32 m = 0; m < bList.size(); m++)
-   {
-      glColor4f(mLightColor.red - (mLightColor.red * bList[m].l), mLightColor.green - (mLightColor.green * bList[m].l), mLightColor.blue - (mLightColor.blue * bList[m].l), mLightColor.alpha - (mLightColor.alpha * bList[m].l));
-      glVertex2f(bList[m].x, bList[m].y);
+   glDisable(GL_BLEND);
+
+   glPopMatrix();
+}
 
+//----------------------------------------------------------------------------
+
+void LightObject::renderBatched(const Vector2& worldPosition, const F32 radius, BatchRender* pBatchRenderer)
+{
+   const ColorF lightColor = getBlendColor();
+   const S32 pointCount = mVisibilityPoints.size();
+
+   // Triangulate the fan.
+   mRenderVertices.setSize(pointCount * 3);
+   mRenderColors.setSize(pointCount * 3);
+   for (S32 i = 0; i < pointCount; i++)
+   {
+      const Vector2& point0 = mVisibilityPoints[i];
+      const Vector2& point1 = mVisibilityPoints[i + 1 == pointCount ? 0 : i + 1];
+      const F32 intensity0 = 1.0f - getMin(point0.Length() / radius, 1.0f);
+      const F32 intensity1 = 1.0f - getMin(point1.Length() / radius, 1.0f);
+
+      mRenderVertices[i * 3 + 0] = worldPosition;
+      mRenderVertices[i * 3 + 1] = worldPosition + point0;
+      mRenderVertices[i * 3 + 2] = worldPosition + point1;
+
+      mRenderColors[i * 3 + 0] = lightColor;
+      mRenderColors[i * 3 + 1] = lightColor * intensity0;
+      mRenderColors[i * 3 + 2] = lightColor * intensity1;
    }
-   //close off the circle
-   glColor4f(mLightColor.red - (mLightColor.red * bList[0].l), mLightColor.green - (mLightColor.green * bList[0].l), mLightColor.blue - (mLightColor.blue * bList[0].l), mLightColor.alpha - (mLightColor.alpha * bList[0].l));
-   glVertex2f(bList[0].x, bList[0].y);
 
-   glDisable(GL_BLEND);
+   // Lights are untextured.
+   if (mRenderTexels.size() < mRenderVertices.size())
+   {
+      const S32 texelCount = mRenderTexels.size();
+      mRenderTexels.setSize(mRenderVertices.size());
+      for (S32 i = texelCount; i < mRenderTexels.size(); i++)
+         mRenderTexels[i].SetZero();
+   }
 
-   glEnd();
+   TextureHandle noTexture;
 
-   glPopMatrix();
+   // Submit in runs that fit the batch buffer.
+   const U32 vertexCount = mRenderVertices.size();
+   const U32 maxRunVertexCount = (BATCHRENDER_MAXTRIANGLES / 2) * 3;
+   for (U32 vertexIndex = 0; vertexIndex < vertexCount; vertexIndex += maxRunVertexCount)
+   {
+      const U32 runVertexCount = getMin(vertexCount - vertexIndex, maxRunVertexCount);
+      pBatchRenderer->SubmitTriangles(runVertexCount, mRenderVertices.address() + vertexIndex, mRenderTexels.address(), mRenderColors.address() + vertexIndex, noTexture);
+   }
 }
 
+//----------------------------------------------------------------------------
+
 void LightObject::OnRegisterScene(Scene* mScene)
 {
    Parent::OnRegisterScene(mScene);
@@ -219,21 +505,3 @@ void LightObject::OnUnregisterScene(Scene* mScene)
    mScene->getWorldQuery()->removeAlwaysInScope(this);
    Parent::OnUnregisterScene(mScene);
 }
-
-S32 QSORT_CALLBACK sortRays(const void* a, const void* b)
-{
-   RayList* ray_a = (RayList*) a;
-   RayList* ray_b = (RayList*) b;
-
-   if (ray_a->ang < ray_b->ang)
-   {
-      return -1;
-   }
-   else if (ray_a->ang > ray_b->ang)
-   {
-      return 1;
-   }
-  
-   return 0;
-
-}
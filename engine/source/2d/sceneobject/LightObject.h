@@ -5,48 +5,61 @@
 #include "2d/sceneobject/SceneObject.h"
 #endif
 
-class RayList
-{
-public:
-
-   F32 x;
-   F32 y;
-   F32 l;
-   F32 ang;
-   bool operator == (const RayList& t) const { return ((mFabs(t.x - x) < 0.01) && (mFabs(t.y - y) < 0.01)); }
-
-};
-
-class RaysCastCallback : public b2RayCastCallback
-{
-public:
-
-   RaysCastCallback() : m_fixture(NULL) {}
-
-   float32 ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float32 fraction) {
-      m_fixture = fixture;
-      m_point = point;
-      m_normal = normal;
-      m_fraction = fraction;
-      return fraction;
-   }
-
-   b2Fixture* m_fixture;
-   b2Vec2 m_point;
-   b2Vec2 m_normal;
-   float32 m_fraction;
-
-};
-
 class LightObject : public SceneObject
 
 {
    typedef SceneObject Parent;
 
+public:
+   /// Segments used to approximate circle occluders.
+   static const U32 CIRCLE_OCCLUDER_SEGMENTS = 12;
+
+   /// Occluder edge, wound counter-clockwise around the light.
+   struct LightEdge
+   {
+      Vector2  mStart;
+      Vector2  mEnd;
+      F32      mStartAngle;
+      F32      mEndAngle;
+   };
+
+   /// Occluder fixture and its transform when the visibility was built.
+   struct LightOccluder
+   {
+      b2Fixture*  mpFixture;
+      b2Transform mTransform;
+   };
+
+   /// Sweep event where an edge starts or ends.
+   struct LightSweepEvent
+   {
+      F32   mAngle;
+      U32   mEdgeIndex;
+      bool  mEdgeStart;
+   };
+
 protected:
 
    F32                     mLightRadius;
    U32                     mLightSegments;
+   bool                    mLightBatched;
+
+   /// Visibility cache.
+   bool                    mVisibilityValid;
+   Vector2                 mVisibilityPosition;
+   F32                     mVisibilityRadius;
+   U32                     mVisibilitySegments;
+   Vector<Vector2>         mVisibilityPoints;
+
+   /// Scratch reused between frames.
+   Vector<LightOccluder>   mOccluders;
+   Vector<LightOccluder>   mVisibilityOccluders;
+   Vector<LightEdge>       mEdges;
+   Vector<LightSweepEvent> mSweepEvents;
+   Vector<U32>             mActiveEdges;
+   Vector<Vector2>         mRenderVertices;
+   Vector<Vector2>         mRenderTexels;
+   Vector<ColorF>          mRenderColors;
 
 public:
 
@@ -55,7 +68,7 @@ public:
 
    static void initPersistFields();
 
-   
+
 
    virtual bool onAdd();
    virtual void onRemove();
@@ -64,15 +77,24 @@ public:
    virtual void sceneRender(const SceneRenderState* sceneRenderState, const SceneRenderRequest* sceneRenderRequest, BatchRender* batchRender);
    //virtual bool validRender(void) const {}
    virtual bool shouldRender(void) const { return true; }
+   virtual bool isBatchRendered(void) { return mLightBatched; }
 
    /// Light segments.
-   inline void setLightSegments(const U32 lightSegments) { mLightSegments = lightSegments; };
+   inline void setLightSegments(const U32 lightSegments) { mLightSegments = lightSegments; mVisibilityValid = false; };
    inline U32 getLightSegments(void) const { return mLightSegments; }
 
    /// Light Radius.
-   inline void setLightRadius(const F32 lightRadius) { mLightRadius = lightRadius; }
+   inline void setLightRadius(const F32 lightRadius) { mLightRadius = lightRadius; mVisibilityValid = false; }
    inline F32 getLightRadius(void) const { return mLightRadius; }
 
+   /// Light batching.
+   /// When batched, lights sharing a blend mode are composited in a single batch render pass.
+   inline void setLightBatched(const bool lightBatched) { mLightBatched = lightBatched; }
+   inline bool getLightBatched(void) const { return mLightBatched; }
+
+   /// Visibility.
+   const Vector<Vector2>& updateVisibility(void);
+
    DECLARE_CONOBJECT(LightObject);
 
 
@@ -81,6 +103,15 @@ protected:
    virtual void OnRegisterScene(Scene* mScene);
    virtual void OnUnregisterScene(Scene* mScene);
 
+   void gatherOccluders(const Vector2& lightPosition, const F32 radius);
+   void addOccluderEdge(const Vector2& start, const Vector2& end, const F32 radius);
+   void addOccluderEdges(const b2Fixture* pFixture, const b2Transform& transform, const Vector2& lightPosition, const F32 radius);
+   void sweepVisibility(const F32 radius);
+   F32 getNearestEdgeDistance(const Vector2& direction, const F32 radius) const;
+
+   void renderImmediate(const Vector2& worldPosition, const F32 radius);
+   void renderBatched(const Vector2& worldPosition, const F32 radius, BatchRender* pBatchRenderer);
+
 protected:
 
    static bool setLightRadius(void* obj, const char* data) { static_cast<LightObject*>(obj)->setLightRadius(dAtof(data)); return false; }
@@ -89,8 +120,9 @@ protected:
    static bool setLightSegments(void* obj, const char* data) { static_cast<LightObject*>(obj)->setLightSegments(dAtoi(data)); return false; }
    static bool writeLightSegments(void* obj, StringTableEntry pFieldName) { return static_cast<LightObject*>(obj)->getLightSegments() > 0; }
 
+   static bool setLightBatched(void* obj, const char* data) { static_cast<LightObject*>(obj)->setLightBatched(dAtob(data)); return false; }
+   static bool writeLightBatched(void* obj, StringTableEntry pFieldName) { return static_cast<LightObject*>(obj)->getLightBatched(); }
+
 };
 
 #endif //_LIGHTOBJECT_H_
-
-S32 QSORT_CALLBACK sortRays(const void * a, const void * b);
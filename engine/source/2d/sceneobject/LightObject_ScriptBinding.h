@@ -49,4 +49,22 @@ ConsoleMethodWithDocs(LightObject, getLightSegments, ConsoleInt, 2, 2, ())
 {
    // Return Layer.
    return object->getLightSegments();
-}
\ No newline at end of file
+}
+
+/*! Sets whether the light is composited through the batch renderer.
+    Batched lights sharing a blend mode are rendered together in a single pass.
+    @param lightBatched Whether the light is batched or not.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(LightObject, setLightBatched, ConsoleVoid, 3, 3, (bool lightBatched))
+{
+   object->setLightBatched(dAtob(argv[2]));
+}
+
+/*! Gets whether the light is composited through the batch renderer.
+    @return Whether the light is batched or not.
+*/
+ConsoleMethodWithDocs(LightObject, getLightBatched, ConsoleBool, 2, 2, ())
+{
+   return object->getLightBatched();
+}
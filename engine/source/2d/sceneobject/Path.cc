@@ -3,46 +3,53 @@
 
 #include "2d/sceneobject/Path_ScriptBinding.h"
 
-IMPLEMENT_CONOBJECT(Path);
-
-PathObject::PathObject():
-   mObj(NULL),
-   mPath(NULL)
-{
-   mCurrNode = 0;
-   mPrevNode = 0;
-
-   mMaxSpeed = 1.0f;
-   mMaxForce = 3.0f;
-   mOrient = false;
-   mAngOff = 0.0f;
-   mSnapToNode = false;
-   mLoop = true;
-   mMaxLoop = -1;
-   mLoopCount = 0;
-}
-
-void PathObject::setCurrNode(S32 node)
-{
-}
-
-void PathObject::setNextNode(S32 node)
-{
-}
-
-void PathObject::setPrevNode(S32 node)
-{
-}
+// Use the SIMD steering kernel where the compiler guarantees support.
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TORQUE_PATH_SSE
+#include <emmintrin.h>
+#elif defined(__aarch64__) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define TORQUE_PATH_NEON
+#include <arm_neon.h>
+#endif
 
+IMPLEMENT_CONOBJECT(Path);
 
-Path::Path()
+Path::Path() :
+   mPathLength(0.0f),
+   mSegmentsDirty(true),
+   mSeparationRadius(0.0f),
+   mSeparationForce(1.0f)
 {
 
    // Use a static body by default.
    mBodyDefinition.type = b2_staticBody;
 
-   VECTOR_SET_ASSOCIATION(mObjs);
    VECTOR_SET_ASSOCIATION(mNodes);
+   VECTOR_SET_ASSOCIATION(mSegments);
+   VECTOR_SET_ASSOCIATION(mFollowerObjects);
+   VECTOR_SET_ASSOCIATION(mFollowerIds);
+   VECTOR_SET_ASSOCIATION(mFollowerMaxSpeed);
+   VECTOR_SET_ASSOCIATION(mFollowerMaxForce);
+   VECTOR_SET_ASSOCIATION(mFollowerAngleOffset);
+   VECTOR_SET_ASSOCIATION(mFollowerNode);
+   VECTOR_SET_ASSOCIATION(mFollowerLoopCount);
+   VECTOR_SET_ASSOCIATION(mFollowerMaxLoop);
+   VECTOR_SET_ASSOCIATION(mFollowerFlags);
+   VECTOR_SET_ASSOCIATION(mActiveFollowers);
+   VECTOR_SET_ASSOCIATION(mPositionX);
+   VECTOR_SET_ASSOCIATION(mPositionY);
+   VECTOR_SET_ASSOCIATION(mVelocityX);
+   VECTOR_SET_ASSOCIATION(mVelocityY);
+   VECTOR_SET_ASSOCIATION(mTargetX);
+   VECTOR_SET_ASSOCIATION(mTargetY);
+   VECTOR_SET_ASSOCIATION(mSlowRadius);
+   VECTOR_SET_ASSOCIATION(mMaxSpeed);
+   VECTOR_SET_ASSOCIATION(mMaxForce);
+   VECTOR_SET_ASSOCIATION(mForceX);
+   VECTOR_SET_ASSOCIATION(mForceY);
+   VECTOR_SET_ASSOCIATION(mCellStart);
+   VECTOR_SET_ASSOCIATION(mCellFollowers);
+   VECTOR_SET_ASSOCIATION(mFollowerCells);
 }
 
 Path::~Path()
@@ -53,80 +60,58 @@ Path::~Path()
 void Path::initPersistFields()
 {
    Parent::initPersistFields();
+
+   addProtectedField("SeparationRadius", TypeF32, Offset(mSeparationRadius, Path), &setSeparationRadius, &defaultProtectedGetFn, &writeSeparationRadius, "The distance within which attached objects push each other apart.  Zero disables separation.");
+   addProtectedField("SeparationForce", TypeF32, Offset(mSeparationForce, Path), &setSeparationForce, &defaultProtectedGetFn, &writeSeparationForce, "The scale applied to the separation between attached objects.");
 }
 
 void Path::preIntegrate(const F32 totalTime, const F32 elapsedTime, DebugStats * pDebugStats)
 {
    Parent::preIntegrate(totalTime, elapsedTime, pDebugStats);
 
-   Vector<PathObject*>::iterator i;
-   for (i = mObjs.begin(); i != mObjs.end(); i++)
-   {
-      bool stop = false;
-      PathObject &pObj = *(*i);
+   // Debug Profiling.
+   PROFILE_SCOPE(Path_PreIntegrate);
 
-      Vector2 cPos = pObj.mObj->getPosition();
-      Node &cNode = mNodes[pObj.mCurrNode];
-      Vector2 cDst = mNodes[pObj.mCurrNode].position;
-      F32 distance = (cDst - cPos).Length();
+   // Finish if nothing to follow.
+   if (mFollowerObjects.size() == 0 || mNodes.size() == 0)
+      return;
 
-      if (distance < (pObj.mMaxSpeed * elapsedTime) || distance < cNode.distance )
-      {
-         S32 nCount = mNodes.size();
-         S32 end = nCount - 1;
-         if (pObj.mCurrNode == end)
-         {
-            if (pObj.mLoop)
-            {
-               pObj.mLoopCount++;
-               if ((pObj.mMaxLoop > 0) && (pObj.mLoopCount >= pObj.mMaxLoop))
-               {
-                  stop = true;
-               }
-               else
-               {
-                  pObj.mPrevNode = pObj.mCurrNode;
-                  pObj.mCurrNode = 0;
-                  pObj.mNextNode = pObj.mCurrNode;
-               }
-            }
-            else
-            {
-               stop = true;
-            }
-         }
-         else
-         {
-            pObj.mPrevNode = pObj.mCurrNode;
-            pObj.mCurrNode = pObj.mCurrNode + 1;
-            pObj.mNextNode = pObj.mCurrNode;
-         }
+   updateSegments();
 
-         if (pObj.mCurrNode >= nCount)
-         {
-            pObj.mCurrNode = 0;
-            pObj.mNextNode = pObj.mCurrNode;
-         }
-         else if (pObj.mCurrNode < 0)
-         {
-            pObj.mCurrNode = 0;
-            pObj.mNextNode = pObj.mCurrNode;
-         }
+   // Advance the followers and gather the ones still moving.
+   advanceFollowers(elapsedTime);
 
-      }
+   const U32 count = mActiveFollowers.size();
+   if (count == 0)
+      return;
 
-      if (!stop)
-      {
-         moveObject(pObj);
-      }
+   // Steer all the moving followers together.
+   steerFollowers(count);
+
+   // Push followers apart.
+   if (mSeparationRadius > 0.0f && count > 1)
+      separateFollowers(count);
+
+   // Apply the steering.
+   for (U32 i = 0; i < count; i++)
+   {
+      const U32 index = mActiveFollowers[i];
+      SceneObject* pObj = mFollowerObjects[index];
+
+      //Steering Behavior
+      pObj->applyForce(Vector2(mForceX[i], mForceY[i]), pObj->getWorldCenter());
 
-      else
+      if (mFollowerFlags[index] & FOLLOWER_ORIENT)
       {
-         pObj.mObj->setLinearVelocity(Vector2(0.0f, 0.0f));
-      }
+         // Followers that do not loop never travel the closing segment, so face along the first one.
+         S32 node = mFollowerNode[index];
+         if (node == 0 && !(mFollowerFlags[index] & FOLLOWER_LOOP) && mSegments.size() > 1)
+            node = 1;
 
+         const F32 ang = mSegments[node].mAngle - mFollowerAngleOffset[index];
+         pObj->rotateTo(ang, mFollowerMaxSpeed[index]);
+      }
    }
-
 }
 
 void Path::integrateObject(const F32 totalTime, const F32 elapsedTime, DebugStats * pDebugStats)
@@ -140,6 +125,8 @@ S32 Path::addNode(Vector2 pos, F32 distance, F32 weight)
 
    mNodes.push_back(Node(pos, distance, weight));
 
+   mSegmentsDirty = true;
+
    return nodeCount;
 }
 
@@ -153,23 +140,35 @@ void Path::attachObject(SceneObject * object, F32 speed, F32 force, bool orientT
 
    object->setLinearVelocity(Vector2::getZero());
 
+   // Keep the start node on the path.
+   if ((startNode < 0) || (startNode >= mNodes.size()))
+      startNode = 0;
+
+   // Reattach if already attached.
+   const S32 existing = findAttachedObject(object);
+   if (existing != -1)
+   {
+      clearNotify(object);
+      removeFollower(existing);
+   }
+
    deleteNotify(object);
 
-   PathObject *pObj  = new PathObject();
-   pObj->mPath       = this;
-   pObj->mObj        = object;
-   pObj->mMaxForce   = force;
-   pObj->mObjId      = object->getId();
-   pObj->mOrient     = orientToPath;
-   pObj->mAngOff     = angleOff;
-   pObj->mLoop       = loop;
-   pObj->mMaxLoop    = maxLoop;
-   pObj->mMaxSpeed   = speed;
-   pObj->mCurrNode   = startNode;
-   pObj->mNextNode   = startNode;
-   
-
-   mObjs.push_back(pObj);
+   U32 flags = 0;
+   if (orientToPath)
+      flags |= FOLLOWER_ORIENT;
+   if (loop)
+      flags |= FOLLOWER_LOOP;
+
+   mFollowerObjects.push_back(object);
+   mFollowerIds.push_back(object->getId());
+   mFollowerMaxSpeed.push_back(speed);
+   mFollowerMaxForce.push_back(force);
+   mFollowerAngleOffset.push_back(mDegToRad(angleOff));
+   mFollowerNode.push_back(startNode);
+   mFollowerLoopCount.push_back(0);
+   mFollowerMaxLoop.push_back(maxLoop);
+   mFollowerFlags.push_back(flags);
 }
 
 void Path::detachObject(SceneObject * object)
@@ -177,108 +176,396 @@ void Path::detachObject(SceneObject * object)
    if (!object)
       return;
 
-   Vector<PathObject*>::iterator i;
+   const S32 index = findAttachedObject(object);
+   if (index == -1)
+      return;
+
+   object->setLinearVelocity(Vector2(0, 0));
+   clearNotify(object);
 
-   for (i = mObjs.begin(); i != mObjs.end(); i++)
+   removeFollower(index);
+}
+
+S32 Path::findAttachedObject(const SceneObject* obj) const
+{
+   if (obj == NULL)
+      return -1;
+
+   const SimObjectId objId = obj->getId();
+   for (S32 i = 0; i < mFollowerIds.size(); i++)
    {
-      PathObject *pObj = (*i);
-      if(object == pObj->mObj)
+      if (mFollowerIds[i] == objId)
+         return i;
+   }
+
+   return -1;
+}
+
+F32 Path::getPathLength(void)
+{
+   updateSegments();
+
+   return mPathLength;
+}
+
+F32 Path::getAttachedObjectProgress(const SceneObject* obj)
+{
+   const S32 index = findAttachedObject(obj);
+   if (index == -1 || mNodes.size() == 0)
+      return 0.0f;
+
+   updateSegments();
+
+   // Project onto the segment leading into the current node.
+   const Segment& seg = mSegments[mFollowerNode[index]];
+   const Vector2 offset = obj->getPosition() - seg.mStart;
+   const F32 along = mClampF((offset.x * seg.mDirection.x) + (offset.y * seg.mDirection.y), 0.0f, seg.mLength);
+
+   return seg.mArcStart + along;
+}
+
+void Path::updateSegments(void)
+{
+   if (!mSegmentsDirty)
+      return;
+
+   mSegmentsDirty = false;
+
+   const S32 nCount = mNodes.size();
+   mSegments.setSize(nCount);
+   mPathLength = 0.0f;
+
+   if (nCount == 0)
+      return;
+
+   // Each segment leads into its node.  The first segment closes the loop from the last node.
+   for (S32 i = 0; i < nCount; i++)
+   {
+      const S32 n = (i + 1) % nCount;
+      const S32 prev = (n + nCount - 1) % nCount;
+
+      Segment& seg = mSegments[n];
+      const Vector2 delta = mNodes[n].position - mNodes[prev].position;
+
+      seg.mStart = mNodes[prev].position;
+      seg.mLength = delta.Length();
+      seg.mDirection = seg.mLength > b2_epsilon ? Vector2(delta.x / seg.mLength, delta.y / seg.mLength) : Vector2::getZero();
+      seg.mArcStart = mPathLength;
+      seg.mAngle = seg.mLength > b2_epsilon ? mAtan(delta.x, delta.y) : 0.0f;
+
+      // The closing segment does not contribute to the path length.
+      if (n != 0)
+         mPathLength += seg.mLength;
+   }
+
+   // Degenerate segments face the same way as the segment before them.
+   for (S32 i = 1; i <= nCount; i++)
+   {
+      Segment& seg = mSegments[i % nCount];
+      if (seg.mLength <= b2_epsilon)
+         seg.mAngle = mSegments[i - 1].mAngle;
+   }
+}
+
+void Path::advanceFollowers(const F32 elapsedTime)
+{
+   // Debug Profiling.
+   PROFILE_SCOPE(Path_AdvanceFollowers);
+
+   const S32 nCount = mNodes.size();
+   const S32 end = nCount - 1;
+   const S32 followerCount = mFollowerObjects.size();
+
+   mActiveFollowers.clear();
+   mPositionX.setSize(followerCount);
+   mPositionY.setSize(followerCount);
+   mVelocityX.setSize(followerCount);
+   mVelocityY.setSize(followerCount);
+   mTargetX.setSize(followerCount);
+   mTargetY.setSize(followerCount);
+   mSlowRadius.setSize(followerCount);
+   mMaxSpeed.setSize(followerCount);
+   mMaxForce.setSize(followerCount);
+   mForceX.setSize(followerCount);
+   mForceY.setSize(followerCount);
+
+   for (S32 index = 0; index < followerCount; index++)
+   {
+      SceneObject* pObj = mFollowerObjects[index];
+      if (pObj == NULL)
+         continue;
+
+      bool stop = false;
+      S32 node = mFollowerNode[index];
+      const Vector2 cPos = pObj->getPosition();
+      const Node& cNode = mNodes[node];
+      const F32 maxSpeed = mFollowerMaxSpeed[index];
+      const F32 distanceSq = (cNode.position - cPos).LengthSquared();
+      const F32 step = maxSpeed * elapsedTime;
+
+      if ((step > 0.0f && distanceSq < step * step) || (cNode.distance > 0.0f && distanceSq < cNode.distance * cNode.distance))
       {
-         if (!pObj->mObj.isNull())
+         if (node == end)
+         {
+            if (mFollowerFlags[index] & FOLLOWER_LOOP)
+            {
+               const S32 loopCount = ++mFollowerLoopCount[index];
+               const S32 maxLoop = mFollowerMaxLoop[index];
+               if ((maxLoop > 0) && (loopCount >= maxLoop))
+                  stop = true;
+               else
+                  node = 0;
+            }
+            else
+            {
+               stop = true;
+            }
+         }
+         else
          {
-            pObj->mObj->setLinearVelocity(Vector2(0, 0));
-            clearNotify(pObj->mObj);
+            node = node + 1;
          }
 
-         delete pObj;
+         if (node >= nCount || node < 0)
+            node = 0;
 
-         mObjs.erase_fast(i);
-         
-         break;
+         mFollowerNode[index] = node;
+      }
+
+      if (stop)
+      {
+         pObj->setLinearVelocity(Vector2(0.0f, 0.0f));
+         continue;
       }
+
+      // Gather the steering inputs.
+      const U32 i = mActiveFollowers.size();
+      const Vector2 currVel = pObj->getLinearVelocity();
+      const Node& target = mNodes[node];
+      mActiveFollowers.push_back(index);
+      mPositionX[i] = cPos.x;
+      mPositionY[i] = cPos.y;
+      mVelocityX[i] = currVel.x;
+      mVelocityY[i] = currVel.y;
+      mTargetX[i] = target.position.x;
+      mTargetY[i] = target.position.y;
+      mSlowRadius[i] = target.distance > 0.0f ? 1.0f / target.distance : F32_MAX;
+      mMaxSpeed[i] = maxSpeed;
+      mMaxForce[i] = mFollowerMaxForce[index];
    }
 }
 
-void Path::moveObject(PathObject& obj)
+void Path::steerFollowers(const U32 count)
 {
-   Vector2 cDest = mNodes[obj.mNextNode].position;
-   F32 slowRad = mNodes[obj.mNextNode].distance;
-   Vector2 oPos = obj.mObj->getPosition();
-   Vector2 dir = cDest - oPos;
-   Vector2 currVel = obj.mObj->getLinearVelocity();
-   dir.Normalize();
-
-   F32 maxSpeed = obj.mMaxSpeed;
-   F32 maxForce = obj.mMaxForce;
-
-   Vector2 steer = seek(cDest, oPos, maxSpeed, currVel, slowRad);
-   steer = truncate(steer, maxForce);
-   steer = steer.scale(0.5f);
-   currVel = currVel.add(steer);
-   currVel = truncate(currVel.add(steer), maxSpeed);
-   Vector2 pos = oPos.add(currVel);
-
-   //Steering Behavior
-   obj.mObj->applyForce(pos, obj.mObj->getWorldCenter());
-
-   //Simple direct move.
-   //obj.mObj->setLinearVelocity(dir * obj.mMaxSpeed);
-
-   if (obj.mOrient)
+   // Debug Profiling.
+   PROFILE_SCOPE(Path_SteerFollowers);
+
+   // Seek the target, slowing inside its radius, then scale by the force and speed.
+   // The slow radius is stored inverted so that a zero radius never slows.
+   const F32* pPosX = mPositionX.address();
+   const F32* pPosY = mPositionY.address();
+   const F32* pVelX = mVelocityX.address();
+   const F32* pVelY = mVelocityY.address();
+   const F32* pTargetX = mTargetX.address();
+   const F32* pTargetY = mTargetY.address();
+   const F32* pInvSlow = mSlowRadius.address();
+   const F32* pMaxSpeed = mMaxSpeed.address();
+   const F32* pMaxForce = mMaxForce.address();
+   F32* pForceX = mForceX.address();
+   F32* pForceY = mForceY.address();
+
+   U32 i = 0;
+
+#if defined(TORQUE_PATH_SSE)
+   const __m128 one = _mm_set1_ps(1.0f);
+   const __m128 epsilon = _mm_set1_ps(b2_epsilon);
+   for (; i + 4 <= count; i += 4)
+   {
+      const __m128 px = _mm_loadu_ps(pPosX + i);
+      const __m128 py = _mm_loadu_ps(pPosY + i);
+      const __m128 vx = _mm_loadu_ps(pVelX + i);
+      const __m128 vy = _mm_loadu_ps(pVelY + i);
+      const __m128 dx = _mm_sub_ps(_mm_loadu_ps(pTargetX + i), px);
+      const __m128 dy = _mm_sub_ps(_mm_loadu_ps(pTargetY + i), py);
+      const __m128 maxSpeed = _mm_loadu_ps(pMaxSpeed + i);
+
+      const __m128 dist = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+      const __m128 invDist = _mm_and_ps(_mm_cmpgt_ps(dist, epsilon), _mm_div_ps(one, _mm_max_ps(dist, epsilon)));
+      const __m128 speed = _mm_mul_ps(maxSpeed, _mm_min_ps(_mm_mul_ps(dist, _mm_loadu_ps(pInvSlow + i)), one));
+      const __m128 scale = _mm_mul_ps(invDist, speed);
+      const __m128 maxForce = _mm_loadu_ps(pMaxForce + i);
+
+      const __m128 steerX = _mm_sub_ps(_mm_mul_ps(dx, scale), vx);
+      const __m128 steerY = _mm_sub_ps(_mm_mul_ps(dy, scale), vy);
+
+      _mm_storeu_ps(pForceX + i, _mm_add_ps(px, _mm_mul_ps(_mm_add_ps(vx, _mm_mul_ps(steerX, maxForce)), maxSpeed)));
+      _mm_storeu_ps(pForceY + i, _mm_add_ps(py, _mm_mul_ps(_mm_add_ps(vy, _mm_mul_ps(steerY, maxForce)), maxSpeed)));
+   }
+#elif defined(TORQUE_PATH_NEON)
+   const float32x4_t one = vdupq_n_f32(1.0f);
+   const float32x4_t epsilon = vdupq_n_f32(b2_epsilon);
+   for (; i + 4 <= count; i += 4)
    {
-      F32 rot = mRadToDeg(mAtan(dir.x, dir.y));
-      rot = rot - obj.mAngOff;
-      F32 ang = mDegToRad(rot);
-      F32 speed = obj.mMaxSpeed;
-      obj.mObj->rotateTo(ang, speed);
+      const float32x4_t px = vld1q_f32(pPosX + i);
+      const float32x4_t py = vld1q_f32(pPosY + i);
+      const float32x4_t vx = vld1q_f32(pVelX + i);
+      const float32x4_t vy = vld1q_f32(pVelY + i);
+      const float32x4_t dx = vsubq_f32(vld1q_f32(pTargetX + i), px);
+      const float32x4_t dy = vsubq_f32(vld1q_f32(pTargetY + i), py);
+      const float32x4_t maxSpeed = vld1q_f32(pMaxSpeed + i);
+
+      const float32x4_t dist = vsqrtq_f32(vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy)));
+      const uint32x4_t valid = vcgtq_f32(dist, epsilon);
+      const float32x4_t invDist = vreinterpretq_f32_u32(vandq_u32(valid, vreinterpretq_u32_f32(vdivq_f32(one, vmaxq_f32(dist, epsilon)))));
+      const float32x4_t speed = vmulq_f32(maxSpeed, vminq_f32(vmulq_f32(dist, vld1q_f32(pInvSlow + i)), one));
+      const float32x4_t scale = vmulq_f32(invDist, speed);
+      const float32x4_t maxForce = vld1q_f32(pMaxForce + i);
+
+      const float32x4_t steerX = vsubq_f32(vmulq_f32(dx, scale), vx);
+      const float32x4_t steerY = vsubq_f32(vmulq_f32(dy, scale), vy);
+
+      vst1q_f32(pForceX + i, vaddq_f32(px, vmulq_f32(vaddq_f32(vx, vmulq_f32(steerX, maxForce)), maxSpeed)));
+      vst1q_f32(pForceY + i, vaddq_f32(py, vmulq_f32(vaddq_f32(vy, vmulq_f32(steerY, maxForce)), maxSpeed)));
    }
+#endif
 
+   for (; i < count; i++)
+   {
+      const F32 dx = pTargetX[i] - pPosX[i];
+      const F32 dy = pTargetY[i] - pPosY[i];
+      const F32 dist = mSqrt((dx * dx) + (dy * dy));
+      const F32 invDist = dist > b2_epsilon ? 1.0f / dist : 0.0f;
+      const F32 speed = pMaxSpeed[i] * getMin(dist * pInvSlow[i], 1.0f);
+      const F32 scale = invDist * speed;
+
+      const F32 steerX = (dx * scale) - pVelX[i];
+      const F32 steerY = (dy * scale) - pVelY[i];
+
+      pForceX[i] = pPosX[i] + ((pVelX[i] + (steerX * pMaxForce[i])) * pMaxSpeed[i]);
+      pForceY[i] = pPosY[i] + ((pVelY[i] + (steerY * pMaxForce[i])) * pMaxSpeed[i]);
+   }
 }
 
-Vector2 Path::truncate(Vector2 vec, F32 max)
+static inline U32 getSeparationCell(const S32 cellX, const S32 cellY, const U32 cellMask)
 {
-   F32 i = max;
-   i = i < 1.0f ? 1.0f : i;
-   vec = vec.scale(max);
-   return vec;
+   return (((U32)cellX * 73856093u) ^ ((U32)cellY * 19349663u)) & cellMask;
 }
 
-Vector2 Path::seek(Vector2 target, Vector2 objPos, F32 max, Vector2 curr, F32 slowRad)
+void Path::separateFollowers(const U32 count)
 {
-   Vector2 des = target.sub(objPos);
-   F32 dist = des.Length();
-   des.Normalize();
+   // Debug Profiling.
+   PROFILE_SCOPE(Path_SeparateFollowers);
+
+   const F32 radius = mSeparationRadius;
+   const F32 radiusSq = radius * radius;
+   const F32 invRadius = 1.0f / radius;
+
+   // Size the cell table to at least twice the follower count.
+   const U32 cellCount = getNextPow2(count * 2);
+   const U32 cellMask = cellCount - 1;
+
+   // Bucket the followers into a uniform grid of the separation radius.
+   mCellStart.setSize(cellCount + 1);
+   mCellFollowers.setSize(count);
+   mFollowerCells.setSize(count);
+   dMemset(mCellStart.address(), 0, mCellStart.memSize());
 
-   if (dist < slowRad)
+   for (U32 i = 0; i < count; i++)
    {
-      des = des.scale(max * dist / slowRad);
+      const U32 cell = getSeparationCell((S32)mFloor(mPositionX[i] * invRadius), (S32)mFloor(mPositionY[i] * invRadius), cellMask);
+      mFollowerCells[i] = cell;
+      mCellStart[cell + 1]++;
    }
-   else
+
+   for (U32 cell = 0; cell < cellCount; cell++)
+      mCellStart[cell + 1] += mCellStart[cell];
+
+   for (U32 i = 0; i < count; i++)
    {
-      des = des.scale(max);
+      const U32 cell = mFollowerCells[i];
+      mCellFollowers[mCellStart[cell]++] = i;
    }
 
-   Vector2 force = des.sub(curr);
+   // Restore the cell starts.
+   for (U32 cell = cellCount; cell > 0; cell--)
+      mCellStart[cell] = mCellStart[cell - 1];
+   mCellStart[0] = 0;
 
-   return force;
-}
+   // Push each follower away from its neighbours.
+   for (U32 i = 0; i < count; i++)
+   {
+      const F32 px = mPositionX[i];
+      const F32 py = mPositionY[i];
+      const S32 cellX = (S32)mFloor(px * invRadius);
+      const S32 cellY = (S32)mFloor(py * invRadius);
 
+      U32 visited[9];
+      U32 visitedCount = 0;
+      F32 pushX = 0.0f;
+      F32 pushY = 0.0f;
 
+      for (S32 offsetY = -1; offsetY <= 1; offsetY++)
+      {
+         for (S32 offsetX = -1; offsetX <= 1; offsetX++)
+         {
+            const U32 cell = getSeparationCell(cellX + offsetX, cellY + offsetY, cellMask);
 
-void Path::onDeleteNotify(SimObject* object)
+            // Skip cells that hash to a bucket already visited.
+            bool seen = false;
+            for (U32 v = 0; v < visitedCount && !seen; v++)
+               seen = visited[v] == cell;
+            if (seen)
+               continue;
+            visited[visitedCount++] = cell;
+
+            for (U32 c = mCellStart[cell]; c < mCellStart[cell + 1]; c++)
+            {
+               const U32 j = mCellFollowers[c];
+               if (j == i)
+                  continue;
+
+               const F32 dx = px - mPositionX[j];
+               const F32 dy = py - mPositionY[j];
+               const F32 distSq = (dx * dx) + (dy * dy);
+               if (distSq >= radiusSq || distSq <= b2_epsilon)
+                  continue;
+
+               // Push harder the closer the neighbour.
+               const F32 dist = mSqrt(distSq);
+               const F32 strength = (1.0f - (dist * invRadius)) / dist;
+               pushX += dx * strength;
+               pushY += dy * strength;
+            }
+         }
+      }
+
+      mForceX[i] += pushX * mSeparationForce;
+      mForceY[i] += pushY * mSeparationForce;
+   }
+}
+
+void Path::removeFollower(const S32 index)
 {
-   Vector<PathObject*>::iterator i;
+   mFollowerObjects.erase_fast(index);
+   mFollowerIds.erase_fast(index);
+   mFollowerMaxSpeed.erase_fast(index);
+   mFollowerMaxForce.erase_fast(index);
+   mFollowerAngleOffset.erase_fast(index);
+   mFollowerNode.erase_fast(index);
+   mFollowerLoopCount.erase_fast(index);
+   mFollowerMaxLoop.erase_fast(index);
+   mFollowerFlags.erase_fast(index);
+}
 
-   SimObjectId objId = object->getId();
+void Path::onDeleteNotify(SimObject* object)
+{
+   const SimObjectId objId = object->getId();
 
-   for (i = mObjs.begin(); i != mObjs.end(); i++)
+   for (S32 i = 0; i < mFollowerIds.size(); i++)
    {
-      if ((*i)->mObjId == objId)
+      if (mFollowerIds[i] == objId)
       {
-         delete (*i);
-
-         mObjs.erase_fast(i);
-
+         removeFollower(i);
          break;
       }
    }
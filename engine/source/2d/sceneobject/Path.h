@@ -3,39 +3,6 @@
 
 #include "2d/sceneobject/SceneObject.h"
 
-class Path;
-
-class PathObject
-{
-private:
-   friend class Path;
-   void setCurrNode(S32 node);
-   void setNextNode(S32 node);
-   void setPrevNode(S32 node);
-
-   Path* mPath;
-   SimObjectPtr<SceneObject> mObj;
-   SimObjectId mObjId;
-   F32 mMaxSpeed;
-   bool mOrient;
-   F32 mMaxForce;
-   F32 mAngOff;
-   
-   S32 mCurrNode;
-   S32 mPrevNode;
-   S32 mNextNode;
-   bool mLoop; 
-   
-   bool mSnapToNode;
-   S32 mLoopCount;
-   S32 mMaxLoop;
-
-public:
-   PathObject();
-   ~PathObject() {};
-
-};
-
 class Path : public SceneObject
 {
    typedef SceneObject Parent;
@@ -55,6 +22,23 @@ public:
       F32 weight;
    };
 
+   /// Arc-length parameterised segment leading into a node.
+   struct Segment
+   {
+      Vector2 mStart;
+      Vector2 mDirection;
+      F32 mLength;
+      F32 mArcStart;
+      F32 mAngle;
+   };
+
+   /// Follower flags.
+   enum FollowerFlags
+   {
+      FOLLOWER_ORIENT = BIT(0),
+      FOLLOWER_LOOP   = BIT(1),
+   };
+
    Path();
    ~Path();
    virtual void onDeleteNotify(SimObject* object);
@@ -84,33 +68,75 @@ public:
 
    void detachObject(SceneObject* object);
 
-   S32 getAttachedObjectCount() { return mObjs.size(); }
+   S32 getAttachedObjectCount() { return mFollowerObjects.size(); }
 
-   SceneObject* getPathObject(U32 index) { if (index < mObjs.size()) return mObjs[index]->mObj; return NULL; }
-   
-   inline PathObject* getAttachedObject(const SceneObject* obj)
-   {
-      if (obj == NULL)
-         return NULL;
-
-      Vector<PathObject*>::iterator i;
-      for (i = mObjs.begin(); i != mObjs.end(); i++)
-         if ((*i)->mObj == obj) return *i;
-      
-      return NULL;
-   }
+   SceneObject* getPathObject(U32 index) { if (index < (U32)mFollowerObjects.size()) return mFollowerObjects[index]; return NULL; }
+
+   S32 findAttachedObject(const SceneObject* obj) const;
+
+   /// Arc-length.
+   F32 getPathLength(void);
+   F32 getAttachedObjectProgress(const SceneObject* obj);
+
+   /// Separation between followers.
+   inline void setSeparationRadius(const F32 radius) { mSeparationRadius = getMax(radius, 0.0f); }
+   inline F32 getSeparationRadius(void) const { return mSeparationRadius; }
+   inline void setSeparationForce(const F32 force) { mSeparationForce = force; }
+   inline F32 getSeparationForce(void) const { return mSeparationForce; }
 
    DECLARE_CONOBJECT(Path);
 
+protected:
+   static bool setSeparationRadius(void* obj, const char* data) { static_cast<Path*>(obj)->setSeparationRadius(dAtof(data)); return false; }
+   static bool writeSeparationRadius(void* obj, StringTableEntry pFieldName) { return static_cast<Path*>(obj)->getSeparationRadius() > 0.0f; }
+   static bool setSeparationForce(void* obj, const char* data) { static_cast<Path*>(obj)->setSeparationForce(dAtof(data)); return false; }
+   static bool writeSeparationForce(void* obj, StringTableEntry pFieldName) { return static_cast<Path*>(obj)->getSeparationForce() != 1.0f; }
+
 private:
 
-   void moveObject(PathObject& obj);
-   Vector2 truncate(Vector2 vec, F32 max);
-   Vector2 seek(Vector2 target, Vector2 objPos, F32 max, Vector2 curr, F32 slowRad);
+   void updateSegments(void);
+   void advanceFollowers(const F32 elapsedTime);
+   void steerFollowers(const U32 count);
+   void separateFollowers(const U32 count);
+   void removeFollower(const S32 index);
 
-   Vector<PathObject*> mObjs;
+   /// Nodes and their segments.
    Vector<Node> mNodes;
-
+   Vector<Segment> mSegments;
+   F32 mPathLength;
+   bool mSegmentsDirty;
+
+   /// Follower state.  Objects are removed through delete notification.
+   Vector<SceneObject*> mFollowerObjects;
+   Vector<SimObjectId> mFollowerIds;
+   Vector<F32> mFollowerMaxSpeed;
+   Vector<F32> mFollowerMaxForce;
+   Vector<F32> mFollowerAngleOffset;
+   Vector<S32> mFollowerNode;
+   Vector<S32> mFollowerLoopCount;
+   Vector<S32> mFollowerMaxLoop;
+   Vector<U32> mFollowerFlags;
+
+   /// Separation.
+   F32 mSeparationRadius;
+   F32 mSeparationForce;
+
+   /// Steering scratch for the active followers.
+   Vector<U32> mActiveFollowers;
+   Vector<F32> mPositionX;
+   Vector<F32> mPositionY;
+   Vector<F32> mVelocityX;
+   Vector<F32> mVelocityY;
+   Vector<F32> mTargetX;
+   Vector<F32> mTargetY;
+   Vector<F32> mSlowRadius;
+   Vector<F32> mMaxSpeed;
+   Vector<F32> mMaxForce;
+   Vector<F32> mForceX;
+   Vector<F32> mForceY;
+   Vector<U32> mCellStart;
+   Vector<U32> mCellFollowers;
+   Vector<U32> mFollowerCells;
 };
 
 #endif
@@ -132,3 +132,28 @@ ConsoleMethodWithDocs(Path, addNode, ConsoleVoid, 3, 6, (float x, float y, [floa
 
    object->addNode(position, distance, weight);
 }
+
+/*! Gets the length of the path from the first node to the last node.
+@return The length of the path in world units.
+*/
+ConsoleMethodWithDocs(Path, getPathLength, ConsoleFloat, 2, 2, ())
+{
+   return object->getPathLength();
+}
+
+/*! Gets how far along the path an attached sceneObject has travelled.
+@param SceneObject The attached object.
+@return The distance along the path in world units.
+*/
+ConsoleMethodWithDocs(Path, getAttachedObjectProgress, ConsoleFloat, 3, 3, (sceneObject))
+{
+   SceneObject* pSceneObject = dynamic_cast<SceneObject*>(Sim::findObject(argv[2]));
+
+   if (!pSceneObject)
+   {
+      Con::warnf("Path::getAttachedObjectProgress() - Could not find the specified object '%s'.", argv[2]);
+      return 0.0f;
+   }
+
+   return object->getAttachedObjectProgress(pSceneObject);
+}
@@ -140,6 +140,10 @@ SceneObject::SceneObject() :
     mpBody(NULL),
     mWorldQueryKey(0),
 
+    /// Tick level-of-detail.
+    mTickLODStamp(0),
+    mTickLODElapsed(0.0f),
+
     /// Collision control.
     mCollisionLayerMask(MASK_ALL),
     mCollisionGroupMask(MASK_ALL),
@@ -444,6 +448,9 @@ void SceneObject::OnRegisterScene( Scene* pScene )
     // Reset the spatials.
     resetTickSpatials();
 
+    // Update navigation.
+    markNavigationDirty();
+
     // Notify components.
     notifyComponentsAddToScene();
 }
@@ -456,6 +463,9 @@ void SceneObject::OnUnregisterScene( Scene* pScene )
     AssertFatal( mpScene == pScene, "Cannot unregister from a scene that is not registered." );
     AssertFatal( mpBody != NULL, "Cannot unregister physics body as it does not exist." );
 
+    // Update navigation.
+    markNavigationDirty();
+
     // Notify components.
     notifyComponentsRemoveFromScene();
 
@@ -595,10 +605,10 @@ void SceneObject::preIntegrate( const F32 totalTime, const F32 elapsedTime, Debu
 
 //-----------------------------------------------------------------------------
 
-void SceneObject::integrateObject( const F32 totalTime, const F32 elapsedTime, DebugStats* pDebugStats )
+void SceneObject::integrateSpatial( void )
 {
     // Debug Profiling.
-    PROFILE_SCOPE(SceneObject_IntegrateObject);
+    PROFILE_SCOPE(SceneObject_IntegrateSpatial);
 
     // Fetch position.
     const b2Vec2 position = getPosition();
@@ -630,6 +640,17 @@ void SceneObject::integrateObject( const F32 totalTime, const F32 elapsedTime, D
            updateTargetPosition();
         }
     }
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneObject::integrateObject( const F32 totalTime, const F32 elapsedTime, DebugStats* pDebugStats )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneObject_IntegrateObject);
+
+    // Integrate spatials.
+    integrateSpatial();
 
     // Update Lifetime.
     if ( mLifetimeActive && !getScene()->getIsEditorScene() )
@@ -658,6 +679,7 @@ void SceneObject::integrateObject( const F32 totalTime, const F32 elapsedTime, D
 
     if (mAudioHandles.size())
     {
+        const b2Vec2 position = getPosition();
         for (typeAudioHandleVector::iterator itr = mAudioHandles.begin(); itr != mAudioHandles.end(); ++itr)
         {
             U32 handle = *itr;
@@ -931,6 +953,9 @@ void SceneObject::setEnabled( const bool enabled )
     if ( mpScene )
     {
         mpBody->SetActive( enabled );
+
+        // Update navigation.
+        markNavigationDirty();
     }
 }
 
@@ -1283,7 +1308,9 @@ void SceneObject::setPosition( const Vector2& position )
 
     if ( mpScene )
     {
+        markNavigationDirty();
         mpBody->SetTransform( position, mpBody->GetAngle() );
+        markNavigationDirty();
 
         // Reset tick spatials.
         resetTickSpatials();
@@ -1303,7 +1330,9 @@ void SceneObject::setAngle( const F32 radians )
 
     if ( mpScene )
     {
+        markNavigationDirty();
         mpBody->SetTransform( mpBody->GetPosition(), radians );
+        markNavigationDirty();
 
         // Reset tick spatials.
         resetTickSpatials();
@@ -1423,7 +1452,9 @@ void SceneObject::setBodyType( const b2BodyType type )
 
     if ( mpScene )
     {
+        markNavigationDirty();
         mpBody->SetType( type );
+        markNavigationDirty();
         return;
     }
     else
@@ -1633,6 +1664,49 @@ void SceneObject::initializeContactGathering( void )
 
 //-----------------------------------------------------------------------------
 
+void SceneObject::markNavigationDirty( void ) const
+{
+    // Only static collision shapes affect navigation.
+    if ( mpScene == NULL || mpBody->GetType() != b2_staticBody || mpBody->GetFixtureList() == NULL )
+        return;
+
+    // Finish if the scene has no navigation grid.
+    SceneNavigation* pNavigation = mpScene->getNavigation();
+    if ( pNavigation == NULL || !pNavigation->getConfigured() )
+        return;
+
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneObject_MarkNavigationDirty);
+
+    // Combine the collision shape bounds.
+    const b2Transform& transform = mpBody->GetTransform();
+    b2AABB dirtyAABB;
+    bool firstShape = true;
+
+    for ( const b2Fixture* pFixture = mpBody->GetFixtureList(); pFixture != NULL; pFixture = pFixture->GetNext() )
+    {
+        const b2Shape* pShape = pFixture->GetShape();
+        const S32 childCount = pShape->GetChildCount();
+
+        for ( S32 childIndex = 0; childIndex < childCount; ++childIndex )
+        {
+            b2AABB shapeAABB;
+            pShape->ComputeAABB( &shapeAABB, transform, childIndex );
+
+            if ( firstShape )
+                dirtyAABB = shapeAABB;
+            else
+                dirtyAABB.Combine( shapeAABB );
+
+            firstShape = false;
+        }
+    }
+
+    pNavigation->markDirty( dirtyAABB );
+}
+
+//-----------------------------------------------------------------------------
+
 void SceneObject::onBeginCollision( const TickContact& tickContact )
 {
     // Finish if we're not gathering contacts.
@@ -2154,6 +2228,9 @@ void SceneObject::setCollisionShapeIsSensor( const U32 shapeIndex, const bool is
         // Update live fixture.
         pFixture->SetSensor( isSensor );
 
+        // Update navigation.
+        markNavigationDirty();
+
         // Re-filter fixture.
         pFixture->Refilter();
 
@@ -2190,6 +2267,9 @@ void SceneObject::deleteCollisionShape( const U32 shapeIndex )
 
     if ( mpScene )
     {
+        // Update navigation.
+        markNavigationDirty();
+
         mpBody->DestroyFixture( mCollisionFixtures[ shapeIndex ] );
         mCollisionFixtures.erase_fast( shapeIndex );
         return;
@@ -2242,6 +2322,9 @@ S32 SceneObject::createCircleCollisionShape( const F32 radius, const b2Vec2& loc
         // Create and push fixture.
         mCollisionFixtures.push_back( mpBody->CreateFixture( pFixtureDef ) );
 
+        // Update navigation.
+        markNavigationDirty();
+
         // Destroy shape and fixture.
         delete pShape;
         delete pFixtureDef;
@@ -2300,6 +2383,9 @@ S32 SceneObject::createPolygonCollisionShape( const U32 pointCount, const b2Vec2
         // Create and push fixture.
         mCollisionFixtures.push_back( mpBody->CreateFixture( pFixtureDef ) );
 
+        // Update navigation.
+        markNavigationDirty();
+
         // Destroy shape and fixture.
         delete pShape;
         delete pFixtureDef;
@@ -2343,6 +2429,9 @@ S32 SceneObject::createPolygonBoxCollisionShape( const F32 width, const F32 heig
         // Create and push fixture.
         mCollisionFixtures.push_back( mpBody->CreateFixture( pFixtureDef ) );
 
+        // Update navigation.
+        markNavigationDirty();
+
         // Destroy shape and fixture.
         delete pShape;
         delete pFixtureDef;
@@ -2386,6 +2475,9 @@ S32 SceneObject::createPolygonBoxCollisionShape( const F32 width, const F32 heig
         // Create and push fixture.
         mCollisionFixtures.push_back( mpBody->CreateFixture( pFixtureDef ) );
 
+        // Update navigation.
+        markNavigationDirty();
+
         // Destroy shape and fixture.
         delete pShape;
         delete pFixtureDef;
@@ -2429,6 +2521,9 @@ S32 SceneObject::createPolygonBoxCollisionShape( const F32 width, const F32 heig
         // Create and push fixture.
         mCollisionFixtures.push_back( mpBody->CreateFixture( pFixtureDef ) );
 
+        // Update navigation.
+        markNavigationDirty();
+
         // Destroy shape and fixture.
         delete pShape;
         delete pFixtureDef;
@@ -2490,6 +2585,9 @@ S32 SceneObject::createChainCollisionShape( const U32 pointCount, const b2Vec2*
         // Create and push fixture.
         mCollisionFixtures.push_back( mpBody->CreateFixture( pFixtureDef ) );
 
+        // Update navigation.
+        markNavigationDirty();
+
         // Destroy shape and fixture.
         delete pShape;
         delete pFixtureDef;
@@ -2537,6 +2635,9 @@ S32 SceneObject::createChainCollisionShape(  const U32 pointCount, const b2Vec2*
         // Create and push fixture.
         mCollisionFixtures.push_back( mpBody->CreateFixture( pFixtureDef ) );
 
+        // Update navigation.
+        markNavigationDirty();
+
         // Destroy shape and fixture.
         delete pShape;
         delete pFixtureDef;
@@ -2631,6 +2732,9 @@ S32 SceneObject::createEdgeCollisionShape( const b2Vec2& localPositionStart, con
         // Create and push fixture.
         mCollisionFixtures.push_back( mpBody->CreateFixture( pFixtureDef ) );
 
+        // Update navigation.
+        markNavigationDirty();
+
         // Destroy shape and fixture.
         delete pShape;
         delete pFixtureDef;
@@ -2668,6 +2772,9 @@ S32 SceneObject::createEdgeCollisionShape(   const b2Vec2& localPositionStart, c
         // Create and push fixture.
         mCollisionFixtures.push_back( mpBody->CreateFixture( pFixtureDef ) );
 
+        // Update navigation.
+        markNavigationDirty();
+
         // Destroy shape and fixture.
         delete pShape;
         delete pFixtureDef;
@@ -178,6 +178,10 @@ protected:
     b2BodyDef               mBodyDefinition;
     U32                     mWorldQueryKey;
 
+    /// Tick level-of-detail.
+    U32                     mTickLODStamp;
+    F32                     mTickLODElapsed;
+
     /// Collision control.
     U32                     mCollisionLayerMask;
     U32                     mCollisionGroupMask;
@@ -264,6 +268,9 @@ protected:
     /// Contact processing.
     void                    initializeContactGathering( void );
 
+    /// Navigation.
+    void                    markNavigationDirty( void ) const;
+
     /// Taml callbacks.
     virtual void            onTamlCustomWrite( TamlCustomNodes& customNodes );
     virtual void            onTamlCustomRead( const TamlCustomNodes& customNodes );
@@ -284,6 +291,7 @@ public:
     /// Integration.
     virtual void            preIntegrate( const F32 totalTime, const F32 elapsedTime, DebugStats* pDebugStats );
     virtual void            integrateObject( const F32 totalTime, const F32 elapsedTime, DebugStats* pDebugStats );
+    void                    integrateSpatial( void );
     virtual void            postIntegrate(const F32 totalTime, const F32 elapsedTime, DebugStats *pDebugStats);
     virtual void            interpolateObject( const F32 timeDelta );
     inline bool             getIsEditorTickAllowed( void ) const { return mEditorTickAllowed; }
@@ -607,6 +615,10 @@ public:
     inline bool             getIsAlwaysInScope(void) const              { return mAlwaysInScope; }
     inline void             setWorldQueryKey( const U32 key )           { mWorldQueryKey = key; }
     inline U32              getWorldQueryKey( void ) const              { return mWorldQueryKey; }
+    inline void             setTickLODStamp( const U32 stamp )          { mTickLODStamp = stamp; }
+    inline U32              getTickLODStamp( void ) const               { return mTickLODStamp; }
+    inline void             deferTickLODElapsed( const F32 elapsedTime ) { mTickLODElapsed += elapsedTime; }
+    inline F32              takeTickLODElapsed( const F32 elapsedTime ) { const F32 totalElapsed = mTickLODElapsed + elapsedTime; mTickLODElapsed = 0.0f; return totalElapsed; }
     static U32              getGlobalSceneObjectCount( void );
     inline U32              getSerialId( void ) const                   { return mSerialId; }
 
@@ -25,6 +25,9 @@
 #include "2d/core/Utility.h"
 #include "ShapeVector.h"
 
+// Debug Profiling.
+#include "debug/profiler.h"
+
 // Script bindings.
 #include "ShapeVector_ScriptBinding.h"
 
@@ -41,11 +44,24 @@ ShapeVector::ShapeVector() :
     mIsCircle(false),
     mCircleRadius(1.0f),
     mFlipX(false),
-    mFlipY(false)
+    mFlipY(false),
+    mFillIndicesDirty(true),
+    mRenderCacheDirty(true),
+    mRenderCacheAngle(0.0f),
+    mRenderCacheLineWidth(0.0f),
+    mRenderCacheFill(false),
+    mRenderCacheOutline(false),
+    mRenderCacheIsCircle(false),
+    mRenderCacheCircleRadius(0.0f)
 {
     // Set Vector Associations.
     VECTOR_SET_ASSOCIATION( mPolygonBasisList );
     VECTOR_SET_ASSOCIATION( mPolygonLocalList );
+    VECTOR_SET_ASSOCIATION( mFillIndices );
+    VECTOR_SET_ASSOCIATION( mRenderPoints );
+    VECTOR_SET_ASSOCIATION( mRenderVertices );
+    VECTOR_SET_ASSOCIATION( mRenderTexels );
+    VECTOR_SET_ASSOCIATION( mRenderColors );
 
    // Use a static body by default.
    mBodyDefinition.type = b2_staticBody;
@@ -117,168 +133,256 @@ void ShapeVector::onRemove()
 
 void ShapeVector::sceneRender( const SceneRenderState* pSceneRenderState, const SceneRenderRequest* pSceneRenderRequest, BatchRender* pBatchRenderer )
 {
-    // Fetch Vertex Count.
-    const U32 vertexCount = mPolygonLocalList.size();
+    // Debug Profiling.
+    PROFILE_SCOPE(ShapeVector_SceneRender);
 
     // Finish if not vertices.
-    if ( vertexCount == 0  && !mIsCircle)
+    if ( mPolygonLocalList.size() == 0 && !mIsCircle )
         return;
 
-    // Disable Texturing.
-    glDisable       ( GL_TEXTURE_2D );
-
-    // Save Model-view.
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-
     // Fetch Position/Rotation.
     const Vector2 position = getRenderPosition();
-
-    // Set Blend Options.
-    setBlendOptions();
-    
-    if (mIsCircle)
+    const F32 angle = getRenderAngle();
+
+    // Outlines are a pixel wide.
+    const F32 lineWidth = pSceneRenderState->mRenderScale.x;
+
+    // If fill mode is enabled, draw the filled shape with an outline overlay in wireframe mode, otherwise just draw the outline.
+    const bool wireFrame = (pBatchRenderer->getWireframeMode() || this->getDebugMask() & Scene::SCENE_DEBUG_WIREFRAME_RENDER) ? true : false;
+    const bool drawFill = mFillMode;
+    const bool drawOutline = !mFillMode || wireFrame;
+
+    // Rebuild the world-space vertices if anything changed.
+    if (    mRenderCacheDirty ||
+            mRenderCachePosition != position ||
+            mRenderCacheAngle != angle ||
+            mRenderCacheLineWidth != lineWidth ||
+            mRenderCacheFill != drawFill ||
+            mRenderCacheOutline != drawOutline ||
+            mRenderCacheIsCircle != mIsCircle ||
+            mRenderCacheCircleRadius != mCircleRadius ||
+            mRenderCacheFillColor != mFillColor ||
+            mRenderCacheLineColor != mLineColor )
     {
-        glRotatef( mRadToDeg(getRenderAngle()), 0.0f, 0.0f, 1.0f );
-
-        // Render the shape.
-        bool wireFrame = (pBatchRenderer->getWireframeMode() || this->getDebugMask() & Scene::SCENE_DEBUG_WIREFRAME_RENDER) ? true : false;
-        renderCircleShape(position, mCircleRadius, wireFrame);
-    }
-    else
-    {
-        // Move into Vector-Space.
-        glTranslatef( position.x, position.y, 0.0f );
-        glRotatef( mRadToDeg(getRenderAngle()), 0.0f, 0.0f, 1.0f );
-
-        // Render the shape.
-        bool wireFrame = (pBatchRenderer->getWireframeMode() || this->getDebugMask() & Scene::SCENE_DEBUG_WIREFRAME_RENDER) ? true : false;
-        renderPolygonShape(vertexCount, wireFrame);
+        updateRenderVertices( position, angle, lineWidth, drawFill, drawOutline );
     }
 
-    // Restore color.
-    glColor4f( 1,1,1,1 );
+    // Shapes are untextured.
+    TextureHandle noTexture;
 
-    // Restore Matrix.
-    glPopMatrix();
+    // Submit in runs that fit the batch buffer.
+    const U32 vertexCount = mRenderVertices.size();
+    const U32 maxRunVertexCount = (BATCHRENDER_MAXTRIANGLES / 2) * 3;
+    for ( U32 vertexIndex = 0; vertexIndex < vertexCount; vertexIndex += maxRunVertexCount )
+    {
+        const U32 runVertexCount = getMin( vertexCount - vertexIndex, maxRunVertexCount );
+        pBatchRenderer->SubmitTriangles( runVertexCount, mRenderVertices.address() + vertexIndex, mRenderTexels.address(), mRenderColors.address() + vertexIndex, noTexture );
+    }
 }
 
-void ShapeVector::renderCircleShape(Vector2 position, F32 radius, const bool wireFrame)
+//----------------------------------------------------------------------------
+
+void ShapeVector::updateRenderVertices( const Vector2& position, const F32 angle, const F32 lineWidth, const bool drawFill, const bool drawOutline )
 {
-    if (mFillMode)
-    {
-        // Set the fill color.
-        glColor4f((GLfloat)mFillColor.red, (GLfloat)mFillColor.green, (GLfloat)mFillColor.blue, (GLfloat)mFillColor.alpha);
+    // Debug Profiling.
+    PROFILE_SCOPE(ShapeVector_UpdateRenderVertices);
+
+    // Transform the outline into world-space.
+    mRenderPoints.clear();
 
-        // Draw the shape.
+    if ( mIsCircle )
+    {
         const U32 k_segments = 32;
         const F32 k_increment = 2.0f * M_PI_F / k_segments;
-        F32 theta = 0.0f;
+        F32 theta = angle;
 
-        Vector<GLfloat> verts;
-        for (U32 n = 0; n < k_segments; n++)
+        for ( U32 n = 0; n < k_segments; n++ )
         {
-            Vector2 v = position + radius * Vector2(mCos(theta), mSin(theta));
-
-            verts.push_back((GLfloat)v.x);
-            verts.push_back((GLfloat)v.y);
-
+            mRenderPoints.push_back( position + mCircleRadius * Vector2(mCos(theta), mSin(theta)) );
             theta += k_increment;
         }
+    }
+    else
+    {
+        const b2Rot rotation( angle );
 
-        glVertexPointer(2, GL_FLOAT, 0, verts.address());
-        glEnableClientState(GL_VERTEX_ARRAY);
-        glDrawArrays(GL_TRIANGLE_FAN, 0, k_segments);
-
-        // If mFillMode is enabled wireframe is also enabled, we'll draw a filled shape with a wire overlay.
-        // Set the line color.
-        if (wireFrame)
+        for ( S32 n = 0; n < mPolygonLocalList.size(); n++ )
         {
-            glColor4f((GLfloat)mLineColor.red, (GLfloat)mLineColor.green, (GLfloat)mLineColor.blue, (GLfloat)mLineColor.alpha);
-            glDrawArrays(GL_LINE_LOOP, 0, k_segments);
+            mRenderPoints.push_back( position + Vector2( b2Mul( rotation, mPolygonLocalList[n] ) ) );
         }
-
-        glDisableClientState(GL_VERTEX_ARRAY);
     }
-    else
-    {
-        // We emulate wireframe mode here by drawing lines between the verts.
-        // Set the line color.
-        glColor4f((GLfloat)mLineColor.red, (GLfloat)mLineColor.green, (GLfloat)mLineColor.blue, (GLfloat)mLineColor.alpha);
 
-        // Draw the shape.
-        const U32 k_segments = 32;
-        const F32 k_increment = 2.0f * M_PI_F / k_segments;
-        F32 theta = 0.0f;
+    const S32 pointCount = mRenderPoints.size();
+
+    mRenderVertices.clear();
+    mRenderColors.clear();
 
-        Vector<GLfloat> verts;
-        for (U32 n = 0; n < k_segments; n++)
+    // Fill.
+    if ( drawFill && pointCount >= 3 )
+    {
+        if ( mIsCircle )
+        {
+            // Circles are convex so fan out from the centre.
+            for ( S32 n = 0; n < pointCount; n++ )
+            {
+                mRenderVertices.push_back( position );
+                mRenderVertices.push_back( mRenderPoints[n] );
+                mRenderVertices.push_back( mRenderPoints[(n + 1) % pointCount] );
+            }
+        }
+        else
         {
-            Vector2 v = position + radius * Vector2(mCos(theta), mSin(theta));
+            // Polygons may be concave so use the cached triangulation.
+            if ( mFillIndicesDirty )
+                triangulatePolygon();
+
+            for ( S32 n = 0; n < mFillIndices.size(); n++ )
+            {
+                mRenderVertices.push_back( mRenderPoints[mFillIndices[n]] );
+            }
+        }
 
-            verts.push_back((GLfloat)v.x);
-            verts.push_back((GLfloat)v.y);
+        for ( S32 n = mRenderColors.size(); n < mRenderVertices.size(); n++ )
+            mRenderColors.push_back( mFillColor );
+    }
 
-            theta += k_increment;
+    // Outline.
+    if ( drawOutline && pointCount >= 2 )
+    {
+        const F32 halfWidth = lineWidth * 0.5f;
+        const S32 edgeCount = pointCount == 2 ? 1 : pointCount;
+
+        for ( S32 n = 0; n < edgeCount; n++ )
+        {
+            const Vector2& start = mRenderPoints[n];
+            const Vector2& end = mRenderPoints[(n + 1) % pointCount];
+
+            // Skip degenerate edges.
+            Vector2 direction = end - start;
+            if ( direction.Normalize() < b2_epsilon )
+                continue;
+
+            // Extend each edge by half the width so the corners close.
+            const Vector2 along = direction * halfWidth;
+            const Vector2 across( -along.y, along.x );
+            const Vector2 vertex0 = start - along - across;
+            const Vector2 vertex1 = end + along - across;
+            const Vector2 vertex2 = end + along + across;
+            const Vector2 vertex3 = start - along + across;
+
+            mRenderVertices.push_back( vertex0 );
+            mRenderVertices.push_back( vertex1 );
+            mRenderVertices.push_back( vertex2 );
+            mRenderVertices.push_back( vertex0 );
+            mRenderVertices.push_back( vertex2 );
+            mRenderVertices.push_back( vertex3 );
         }
 
-        glVertexPointer(2, GL_FLOAT, 0, verts.address());
-        glEnableClientState(GL_VERTEX_ARRAY);
-        glDrawArrays(GL_LINE_LOOP, 0, k_segments);
-        glDisableClientState(GL_VERTEX_ARRAY);
+        for ( S32 n = mRenderColors.size(); n < mRenderVertices.size(); n++ )
+            mRenderColors.push_back( mLineColor );
+    }
+
+    // Shapes are untextured but the batch still takes texture coordinates.
+    const S32 texelCount = getMin( mRenderVertices.size(), (S32)((BATCHRENDER_MAXTRIANGLES / 2) * 3) );
+    if ( mRenderTexels.size() < texelCount )
+    {
+        const S32 currentTexelCount = mRenderTexels.size();
+        mRenderTexels.setSize( texelCount );
+        for ( S32 n = currentTexelCount; n < texelCount; n++ )
+            mRenderTexels[n].SetZero();
     }
+
+    // Update the cache key.
+    mRenderCacheDirty = false;
+    mRenderCachePosition = position;
+    mRenderCacheAngle = angle;
+    mRenderCacheLineWidth = lineWidth;
+    mRenderCacheFill = drawFill;
+    mRenderCacheOutline = drawOutline;
+    mRenderCacheIsCircle = mIsCircle;
+    mRenderCacheCircleRadius = mCircleRadius;
+    mRenderCacheFillColor = mFillColor;
+    mRenderCacheLineColor = mLineColor;
 }
 
-void ShapeVector::renderPolygonShape(U32 vertexCount, const bool wireFrame)
+//----------------------------------------------------------------------------
+
+void ShapeVector::triangulatePolygon( void )
 {
-    // If fill mode is enabled, draw the polygon using GL_TRIANGLE_FAN, otherwise we draw with GL_LINE_LOOP.
-    // We also draw with GL_LINE_LOOP if the scene/object is being rendered with wireframe enabled.
-    if (mFillMode)
+    // Debug Profiling.
+    PROFILE_SCOPE(ShapeVector_TriangulatePolygon);
+
+    mFillIndices.clear();
+    mFillIndicesDirty = false;
+
+    const S32 vertexCount = mPolygonLocalList.size();
+    if ( vertexCount < 3 )
+        return;
+
+    // Calculate the winding.
+    F32 area = 0.0f;
+    for ( S32 n = 0; n < vertexCount; n++ )
     {
-        // Set the fill color.
-        glColor4f((GLfloat)mFillColor.red, (GLfloat)mFillColor.green, (GLfloat)mFillColor.blue, (GLfloat)mFillColor.alpha);
+        const Vector2& vertex0 = mPolygonLocalList[n];
+        const Vector2& vertex1 = mPolygonLocalList[(n + 1) % vertexCount];
+        area += vertex0.x * vertex1.y - vertex1.x * vertex0.y;
+    }
 
-        // Draw the shape.
-        Vector<GLfloat> verts;
-        for (U32 n = 0; n < vertexCount; n++)
-        {
-            verts.push_back((GLfloat)mPolygonLocalList[n].x);
-            verts.push_back((GLfloat)mPolygonLocalList[n].y);
-        }
+    // Gather the vertices counter-clockwise.
+    Vector<U16> remaining;
+    remaining.setSize( vertexCount );
+    for ( S32 n = 0; n < vertexCount; n++ )
+        remaining[n] = (U16)(area >= 0.0f ? n : vertexCount - 1 - n);
+
+    // Clip ears until a single triangle remains.
+    S32 remainingCount = vertexCount;
+    S32 index = 0;
+    S32 attempts = 0;
+    while ( remainingCount > 3 )
+    {
+        const U16 previous = remaining[(index + remainingCount - 1) % remainingCount];
+        const U16 current = remaining[index];
+        const U16 next = remaining[(index + 1) % remainingCount];
 
-        glVertexPointer(2, GL_FLOAT, 0, verts.address());
-        glEnableClientState(GL_VERTEX_ARRAY);
-        glDrawArrays(GL_TRIANGLE_FAN, 0, vertexCount);
+        const Vector2& vertexA = mPolygonLocalList[previous];
+        const Vector2& vertexB = mPolygonLocalList[current];
+        const Vector2& vertexC = mPolygonLocalList[next];
 
-        // If mFillMode is enabled wireframe is also enabled, we'll draw a filled shape with a wire overlay.
-        // Set the line color.
-        if (wireFrame)
+        // An ear is convex with no other vertex inside it.
+        bool isEar = b2Cross( vertexB - vertexA, vertexC - vertexB ) > 0.0f;
+        for ( S32 n = 0; isEar && n < remainingCount; n++ )
         {
-            glColor4f((GLfloat)mLineColor.red, (GLfloat)mLineColor.green, (GLfloat)mLineColor.blue, (GLfloat)mLineColor.alpha);
-            glDrawArrays(GL_LINE_LOOP, 0, vertexCount);
+            const U16 other = remaining[n];
+            if ( other == previous || other == current || other == next )
+                continue;
+
+            const Vector2& point = mPolygonLocalList[other];
+            if ( b2Cross( vertexB - vertexA, point - vertexA ) >= 0.0f &&
+                 b2Cross( vertexC - vertexB, point - vertexB ) >= 0.0f &&
+                 b2Cross( vertexA - vertexC, point - vertexC ) >= 0.0f )
+                isEar = false;
         }
 
-        glDisableClientState(GL_VERTEX_ARRAY);
-    }
-    else
-    {
-        // We emulate wireframe mode here by drawing lines between the verts.
-        // Set the line color.
-        glColor4f((GLfloat)mLineColor.red, (GLfloat)mLineColor.green, (GLfloat)mLineColor.blue, (GLfloat)mLineColor.alpha);
-
-        // Draw the shape.
-        Vector<GLfloat> verts;
-        for (U32 n = 0; n < vertexCount; n++)
+        // Clip anyway if no ear can be found so self-intersecting polygons still fill.
+        if ( !isEar && ++attempts <= remainingCount )
         {
-            verts.push_back((GLfloat)mPolygonLocalList[n].x);
-            verts.push_back((GLfloat)mPolygonLocalList[n].y);
+            index = (index + 1) % remainingCount;
+            continue;
         }
 
-        glVertexPointer(2, GL_FLOAT, 0, verts.address());
-        glEnableClientState(GL_VERTEX_ARRAY);
-        glDrawArrays(GL_LINE_LOOP, 0, vertexCount);
-        glDisableClientState(GL_VERTEX_ARRAY);
+        mFillIndices.push_back( previous );
+        mFillIndices.push_back( current );
+        mFillIndices.push_back( next );
+
+        remaining.erase( index );
+        remainingCount--;
+        index %= remainingCount;
+        attempts = 0;
     }
+
+    mFillIndices.push_back( remaining[0] );
+    mFillIndices.push_back( remaining[1] );
+    mFillIndices.push_back( remaining[2] );
 }
 
 //----------------------------------------------------------------------------
@@ -511,6 +615,10 @@ void ShapeVector::generateLocalPoly( void )
     // Fetch Polygon Vertex Count.
     const U32 polyVertexCount = mPolygonBasisList.size();
 
+    // The fill and render vertices need rebuilding.
+    mFillIndicesDirty = true;
+    mRenderCacheDirty = true;
+
     // Process Collision Polygon (if we've got one).
     if ( polyVertexCount > 0 )
     {
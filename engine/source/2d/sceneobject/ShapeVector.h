@@ -44,6 +44,24 @@ protected:
     bool                    mFlipX;
     bool                    mFlipY;
 
+    /// Render cache.
+    Vector<U16>             mFillIndices;           ///< Triangulated fill as indices into the local polygon.
+    bool                    mFillIndicesDirty;
+    Vector<Vector2>         mRenderPoints;          ///< World-space outline points.
+    Vector<Vector2>         mRenderVertices;
+    Vector<Vector2>         mRenderTexels;
+    Vector<ColorF>          mRenderColors;
+    bool                    mRenderCacheDirty;
+    Vector2                 mRenderCachePosition;
+    F32                     mRenderCacheAngle;
+    F32                     mRenderCacheLineWidth;
+    bool                    mRenderCacheFill;
+    bool                    mRenderCacheOutline;
+    bool                    mRenderCacheIsCircle;
+    F32                     mRenderCacheCircleRadius;
+    ColorF                  mRenderCacheFillColor;
+    ColorF                  mRenderCacheLineColor;
+
 public:
     ShapeVector();
     ~ShapeVector();
@@ -76,8 +94,8 @@ public:
     /// Internal Crunchers.
     void generateLocalPoly( void );
 
-    void renderCircleShape(Vector2 position, F32 radius, const bool wireFrame);
-    void renderPolygonShape(U32 vertexCount, const bool wireFrame);
+    void triangulatePolygon( void );
+    void updateRenderVertices( const Vector2& position, const F32 angle, const F32 lineWidth, const bool drawFill, const bool drawOutline );
 
     /// Render flipping.
     inline void setFlip( const bool flipX, const bool flipY )   { mFlipX = flipX; mFlipY = flipY; generateLocalPoly(); }
@@ -95,7 +113,7 @@ public:
     virtual bool shouldRender( void ) const { return true; }
 
     /// Render batching.
-    virtual bool isBatchRendered( void ) { return false; }
+    virtual bool isBatchRendered( void ) { return true; }
 
     /// Clone support
     void copyTo(SimObject* obj);
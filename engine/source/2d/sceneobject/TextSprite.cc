@@ -271,7 +271,8 @@ TextSprite::TextSprite() :
    mCustomLineHeight(1.0f),
    mKerning(0.0f),
    mFontSpatialsDirty(true),
-   mCalculatedSize(1.0f, 1.0f)
+   mCalculatedSize(1.0f, 1.0f),
+   mGlyphQuadsDirty(true)
 {
 }
 
@@ -297,7 +298,7 @@ void TextSprite::initPersistFields()
     addProtectedField("textVAlignment", TypeEnum, Offset(mTextVAlign, TextSprite), &setTextVAlignment, &defaultProtectedGetFn, &writeTextVAlignment, 1, &gTextVAlignmentTable, "");
     addProtectedField("overflowModeX", TypeEnum, Offset(mOverflowX, TextSprite), &setOverflowModeX, &defaultProtectedGetFn, &writeOverflowModeX, 1, &gOverflowModeXTable, "");
     addProtectedField("overflowModeY", TypeEnum, Offset(mOverflowY, TextSprite), &setOverflowModeY, &defaultProtectedGetFn, &writeOverflowModeY, 1, &gOverflowModeYTable, "");
-    addField("autoLineHeight", TypeBool, Offset(mAutoLineHeight, TextSprite), &writeAutoLineHeight, "");
+    addProtectedField("autoLineHeight", TypeBool, Offset(mAutoLineHeight, TextSprite), &setAutoLineHeight, &defaultProtectedGetFn, &writeAutoLineHeight, "");
     addProtectedField("customLineHeight", TypeF32, Offset(mCustomLineHeight, TextSprite), &setCustomLineHeight, &defaultProtectedGetFn, &writeCustomLineHeight, "");
     addProtectedField("kerning", TypeF32, Offset(mKerning, TextSprite), &setKerning, &defaultProtectedGetFn, &writeKerning, "");
 }
@@ -349,6 +350,7 @@ void TextSprite::copyTo(SimObject* object)
     pFontObject->setCustomLineHeight(getCustomLineHeight());
     pFontObject->setKerning(getKerning());
     pFontObject->mCharInfo = mCharInfo;
+    pFontObject->mGlyphQuadsDirty = true;
 }
 
 //------------------------------------------------------------------------------
@@ -398,9 +400,6 @@ void TextSprite::sceneRender( const SceneRenderState* pSceneRenderState, const S
     // Get a size ratio
     const F32 ratio = mFontAsset->mBitmapFont.getSizeRatio(mFontSize);
 
-    //get the line height
-    const F32 lineHeight = GetLineHeight();
-
     //prep for justify
     if (mTextAlign == ALIGN_JUSTIFY)
     {
@@ -411,8 +410,90 @@ void TextSprite::sceneRender( const SceneRenderState* pSceneRenderState, const S
     if (mFontSpatialsDirty || mSize != mCalculatedSize)
     {
        CalculateSpatials(ratio);
+       mGlyphQuadsDirty = true;
     }
 
+    // Lay out the glyphs if needed.
+    if (mGlyphQuadsDirty)
+    {
+       BuildGlyphQuads(ratio);
+    }
+
+    // Finish if there's nothing visible.
+    const U32 quadCount = (U32)mGlyphQuads.size();
+    if (quadCount == 0)
+        return;
+
+    // Debug Profiling.
+    PROFILE_SCOPE(TextSprite_RenderGlyphs);
+
+    // Fetch the render axes.
+    const Vector2 unitX = (mRenderOOBB[1] - mRenderOOBB[0]).getUnitDirection();
+    const Vector2 unitY = (-(mRenderOOBB[3] - mRenderOOBB[0])).getUnitDirection();
+    const Vector2& origin = mRenderOOBB[3];
+
+    // Transform the glyphs.
+    mGlyphVertices.resize(quadCount * 4);
+    mGlyphColors.resize(quadCount);
+    Vector2* pVertex = &mGlyphVertices[0];
+    for (U32 index = 0; index < quadCount; ++index, pVertex += 4)
+    {
+        const GlyphQuad& quad = mGlyphQuads[index];
+
+        const Vector2 left = origin + (unitX * quad.mLeft);
+        const Vector2 right = left + (unitX * quad.mWidth);
+        const Vector2 top = unitY * quad.mTop;
+        const Vector2 bottom = unitY * (quad.mTop + quad.mHeight);
+
+        pVertex[0] = left + bottom;
+        pVertex[1] = right + bottom;
+        pVertex[2] = right + top;
+        pVertex[3] = left + top;
+
+        mGlyphColors[index] = quad.mHasCharInfo ? quad.mColor : mBlendColor;
+    }
+
+    // Submit runs of glyphs that share a page and color state.
+    U32 runStart = 0;
+    while (runStart < quadCount)
+    {
+        const U16 page = mGlyphQuads[runStart].mPage;
+        const bool colored = mGlyphColors[runStart] != mBlendColor;
+
+        U32 runEnd = runStart + 1;
+        while (runEnd < quadCount && mGlyphQuads[runEnd].mPage == page && (mGlyphColors[runEnd] != mBlendColor) == colored)
+            ++runEnd;
+
+        // Submit batched quads.
+        pBatchRenderer->SubmitQuads(
+            runEnd - runStart,
+            &mGlyphVertices[runStart * 4],
+            &mGlyphTexels[runStart * 4],
+            colored ? &mGlyphColors[runStart] : NULL,
+            mFontAsset->getImageTexture(page));
+
+        runStart = runEnd;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void TextSprite::BuildGlyphQuads(F32 ratio)
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TextSprite_BuildGlyphQuads);
+
+    mGlyphQuads.clear();
+    mGlyphTexels.clear();
+    mGlyphQuadsDirty = false;
+
+    // Finish if there are no lines.
+    if (mLine.empty())
+        return;
+
+    //get the line height
+    const F32 lineHeight = GetLineHeight();
+
     // If we're shrinking the set the scale
     bool shrinkX = false;
     bool shrinkY = false;
@@ -438,7 +519,8 @@ void TextSprite::sceneRender( const SceneRenderState* pSceneRenderState, const S
 
     ApplyAlignment(cursor, mLine.size(), 0, mLine.front().mLength, mLine.front().mEnd - mLine.front().mStart + 1, ratio);
 
-    // Render all the characters.  
+    // Lay out all the characters.
+    const U32 renderCharacters = mText.length();
     U32 row = 0;
     S32 prevCharID = -1;
     for (U32 characterIndex = mLine.front().mStart; characterIndex < renderCharacters; ++characterIndex)
@@ -448,7 +530,7 @@ void TextSprite::sceneRender( const SceneRenderState* pSceneRenderState, const S
 
         if (characterIndex >= mLine[row].mStart)
         {
-           RenderLetter(pBatchRenderer, cursor, charID, ratio, characterIndex);
+           AddGlyphQuad(cursor, charID, ratio, characterIndex);
         }
         
         if ((row + 1) < mLine.size() && mLine[row + 1].mStart == (characterIndex + 1))
@@ -485,14 +567,19 @@ void TextSprite::sceneRender( const SceneRenderState* pSceneRenderState, const S
 
 //-----------------------------------------------------------------------------
 
-
-void TextSprite::RenderLetter(BatchRender* pBatchRenderer, Vector2& cursor, U32 charID, F32 ratio, U32 charNum)
+void TextSprite::AddGlyphQuad(const Vector2& cursor, U32 charID, F32 ratio, U32 charNum)
 {
    const BitmapFontCharacter& bmChar = mFontAsset->mBitmapFont.getCharacter(charID);
 
-   Vector2 charScale = getCharacterScale(charNum);
-   Vector2 charOffset = getCharacterOffset(charNum);
-   ColorF charColor = getCharacterBlendColor(charNum);
+   // Skip empty glyphs such as spaces.
+   if (bmChar.mWidth == 0 || bmChar.mHeight == 0)
+      return;
+
+   CharInfoMap::const_iterator charInfoItr = mCharInfo.find(charNum);
+   const bool hasCharInfo = charInfoItr != mCharInfo.end();
+
+   Vector2 charScale = hasCharInfo ? Vector2(charInfoItr->second.mScaleX, charInfoItr->second.mScaleY) : Vector2(1.0f, 1.0f);
+   Vector2 charOffset = hasCharInfo ? Vector2(charInfoItr->second.mOffsetX, charInfoItr->second.mOffsetY) : Vector2(0.0f, 0.0f);
 
    F32 fontScaleX = mFontScaleX * charScale.x;
    F32 fontScaleY = mFontScaleY * charScale.y;
@@ -556,54 +643,21 @@ void TextSprite::RenderLetter(BatchRender* pBatchRenderer, Vector2& cursor, U32
    sourceOOBB[2].Set(bmChar.mOOBB[2].x - ((insetRight * (F32)bmChar.mWidth) / (F32)bmChar.mPageWidth), bmChar.mOOBB[2].y + ((insetTop * (F32)bmChar.mHeight) / (F32)bmChar.mPageHeight));
    sourceOOBB[3].Set(bmChar.mOOBB[3].x + ((insetLeft * (F32)bmChar.mWidth) / (F32)bmChar.mPageWidth), bmChar.mOOBB[3].y + ((insetTop * (F32)bmChar.mHeight) / (F32)bmChar.mPageHeight));
 
-   //create the destination rect
-   Vector2 destLeft = (mRenderOOBB[1] - mRenderOOBB[0]);
-   destLeft.Normalize((F32)cursorX + (insetLeft * bmChar.mWidth * ratio * fontScaleX));
-
-   Vector2 destWidth = (mRenderOOBB[1] - mRenderOOBB[0]);
-   destWidth.Normalize(((bmChar.mWidth * ratio) - (insetLeft * (bmChar.mWidth * ratio)) - (insetRight * (bmChar.mWidth * ratio))) * fontScaleX);
-
-   Vector2 destTop = -(mRenderOOBB[3] - mRenderOOBB[0]);
-   destTop.Normalize((F32)cursorY - (((mFontAsset->mBitmapFont.mBaseline * ratio) - (bmChar.mYOffset * ratio) - (insetTop * bmChar.mHeight * ratio)) * fontScaleY));
-
-   Vector2 destHeight = -(mRenderOOBB[3] - mRenderOOBB[0]);
-   destHeight.Normalize(((bmChar.mHeight * ratio) - (insetBottom * bmChar.mHeight * ratio) - (insetTop * bmChar.mHeight * ratio)) * fontScaleY);
+   //create the destination distances
+   GlyphQuad quad;
+   quad.mLeft = cursorX + (insetLeft * bmChar.mWidth * ratio * fontScaleX);
+   quad.mWidth = ((bmChar.mWidth * ratio) - (insetLeft * (bmChar.mWidth * ratio)) - (insetRight * (bmChar.mWidth * ratio))) * fontScaleX;
+   quad.mTop = cursorY - (((mFontAsset->mBitmapFont.mBaseline * ratio) - (bmChar.mYOffset * ratio) - (insetTop * bmChar.mHeight * ratio)) * fontScaleY);
+   quad.mHeight = ((bmChar.mHeight * ratio) - (insetBottom * bmChar.mHeight * ratio) - (insetTop * bmChar.mHeight * ratio)) * fontScaleY;
+   quad.mPage = bmChar.mPage;
+   quad.mHasCharInfo = hasCharInfo;
+   quad.mColor = hasCharInfo ? charInfoItr->second.mColor : ColorF(1.0f, 1.0f, 1.0f, 1.0f);
 
-   Vector2 destOOBB[4];
-   destOOBB[0] = (mRenderOOBB[3] + destLeft + destTop + destHeight);
-   destOOBB[1] = (mRenderOOBB[3] + destLeft + destWidth + destTop + destHeight);
-   destOOBB[2] = (mRenderOOBB[3] + destLeft + destWidth + destTop);
-   destOOBB[3] = (mRenderOOBB[3] + destLeft + destTop);
-
-   if (charColor != mBlendColor)
-   {
-      // Submit batched quad.
-      pBatchRenderer->SubmitQuad(
-         destOOBB[0],
-         destOOBB[1],
-         destOOBB[2],
-         destOOBB[3],
-         sourceOOBB[0],
-         sourceOOBB[1],
-         sourceOOBB[2],
-         sourceOOBB[3],
-         mFontAsset->getImageTexture(bmChar.mPage),
-         charColor);
-   }
-   else
-   {
-      // Submit batched quad.
-      pBatchRenderer->SubmitQuad(
-         destOOBB[0],
-         destOOBB[1],
-         destOOBB[2],
-         destOOBB[3],
-         sourceOOBB[0],
-         sourceOOBB[1],
-         sourceOOBB[2],
-         sourceOOBB[3],
-         mFontAsset->getImageTexture(bmChar.mPage));
-   }
+   mGlyphQuads.push_back(quad);
+   mGlyphTexels.push_back(sourceOOBB[0]);
+   mGlyphTexels.push_back(sourceOOBB[1]);
+   mGlyphTexels.push_back(sourceOOBB[2]);
+   mGlyphTexels.push_back(sourceOOBB[3]);
 }
 
 //-----------------------------------------------------------------------------
@@ -773,6 +827,8 @@ bool TextSprite::setFont( const char* pFontAssetId )
 
 void TextSprite::setCharacterBlendColor(const U32 charNum, const ColorF color)
 {
+   mGlyphQuadsDirty = true;
+
    if (mCharInfo.find(charNum) != mCharInfo.end())
    {
       mCharInfo[charNum].mColor = color;
@@ -809,6 +865,8 @@ bool TextSprite::getCharacterHasBlendColor(const U32 charNum)
 
 void TextSprite::resetCharacterBlendColor(const U32 charNum)
 {
+   mGlyphQuadsDirty = true;
+
    if (mCharInfo.find(charNum) != mCharInfo.end())
    {
       mCharInfo[charNum].mUseColor = false;
@@ -824,6 +882,8 @@ void TextSprite::resetCharacterBlendColor(const U32 charNum)
 
 void TextSprite::setCharacterScale(const U32 charNum, const F32 scaleX, const F32 scaleY)
 {
+   mGlyphQuadsDirty = true;
+
    if (mCharInfo.find(charNum) == mCharInfo.end())
    {
       mCharInfo[charNum] = BitmapFontCharacterInfo();
@@ -855,6 +915,8 @@ Vector2 TextSprite::getCharacterScale(const U32 charNum)
 
 void TextSprite::resetCharacterScale(const U32 charNum)
 {
+   mGlyphQuadsDirty = true;
+
    if (mCharInfo.find(charNum) != mCharInfo.end())
    {
       mCharInfo[charNum].mScaleX = 1.0f;
@@ -871,6 +933,8 @@ void TextSprite::resetCharacterScale(const U32 charNum)
 
 void TextSprite::setCharacterOffset(const U32 charNum, const F32 offsetX, const F32 offsetY)
 {
+   mGlyphQuadsDirty = true;
+
    if (mCharInfo.find(charNum) == mCharInfo.end())
    {
       mCharInfo[charNum] = BitmapFontCharacterInfo();
@@ -902,6 +966,8 @@ Vector2 TextSprite::getCharacterOffset(const U32 charNum)
 
 void TextSprite::resetCharacterOffset(const U32 charNum)
 {
+   mGlyphQuadsDirty = true;
+
    if (mCharInfo.find(charNum) != mCharInfo.end())
    {
       mCharInfo[charNum].mOffsetX = 0.0f;
@@ -99,6 +99,18 @@ public:
     };
 
 private:
+    /// A laid out glyph in distances along the render OOBB.
+    struct GlyphQuad
+    {
+        F32                 mLeft;
+        F32                 mWidth;
+        F32                 mTop;
+        F32                 mHeight;
+        U16                 mPage;
+        bool                mHasCharInfo;
+        ColorF              mColor;
+    };
+
     AssetPtr<FontAsset>     mFontAsset;
     StringBuffer            mText;
     F32                     mFontSize;
@@ -117,6 +129,11 @@ private:
     Vector2                 mCalculatedSize;
     CharInfoMap             mCharInfo;
 
+    std::vector<GlyphQuad>  mGlyphQuads;
+    std::vector<Vector2>    mGlyphTexels;
+    std::vector<Vector2>    mGlyphVertices;
+    std::vector<ColorF>     mGlyphColors;
+    bool                    mGlyphQuadsDirty;
 
 public:
     TextSprite();
@@ -173,7 +190,7 @@ public:
     inline void setKerning(const F32 kern)                                  { mKerning = kern; mFontSpatialsDirty = true; }
     inline F32 getKerning(void) const                                       { return mKerning; }
 
-    void resetCharacterSettings(void)                                       { mCharInfo.clear(); }
+    void resetCharacterSettings(void)                                       { mCharInfo.clear(); mGlyphQuadsDirty = true; }
 
     void setCharacterBlendColor(const U32 charNum, const ColorF color);
     ColorF getCharacterBlendColor(const U32 charNum);
@@ -221,6 +238,7 @@ protected:
     static bool setOverflowModeY(void* obj, const char* data);
     static bool writeOverflowModeY(void* obj, StringTableEntry pFieldName){ return static_cast<TextSprite*>(obj)->getOverflowModeY() != TextSprite::OVERFLOW_Y_HIDDEN; }
 
+    static bool setAutoLineHeight(void* obj, const char* data)                      { static_cast<TextSprite*>(obj)->setAutoLineHeight(dAtob(data)); return false; }
     static bool writeAutoLineHeight(void* obj, StringTableEntry pFieldName)       { return static_cast<TextSprite*>(obj)->getAutoLineHeight() != true; }
 
     static bool setCustomLineHeight(void* obj, const char* data)                    { static_cast<TextSprite*>(obj)->setCustomLineHeight(dAtof(data)); return false; }
@@ -230,7 +248,8 @@ protected:
     static bool writeKerning(void* obj, StringTableEntry pFieldName)       { return static_cast<TextSprite*>(obj)->getKerning() != 0.0f; }
 
 private:
-   void RenderLetter(BatchRender* pBatchRenderer, Vector2& cursor, U32 charID, F32 ratio, U32 charNum);
+   void BuildGlyphQuads(F32 ratio);
+   void AddGlyphQuad(const Vector2& cursor, U32 charID, F32 ratio, U32 charNum);
    void ApplyAlignment(Vector2& cursor, U32 totalRows, U32 row, F32 length, U32 charCount, F32 ratio);
    F32 getCursorAdvance(U32 charID, S32 prevCharID, F32 ratio);
    F32 getCursorAdvance(const BitmapFontCharacter& bmChar, S32 prevCharID, F32 ratio);
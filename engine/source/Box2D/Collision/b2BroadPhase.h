@@ -99,6 +99,13 @@ public:
 	/// Get the quality metric of the embedded tree.
 	float32 GetTreeQuality() const;
 
+	/// Rebuild the embedded tree using the surface area heuristic.
+	void RebuildTree();
+
+	/// Rebuild part of the embedded tree. See b2DynamicTree::RebuildIncremental.
+	/// @return true if this call completed a full pass over the tree.
+	bool RebuildTreeIncremental(int32 leafBudget);
+
 	/// Shift the world origin. Useful for large worlds.
 	/// The shift formula is: position -= newOrigin
 	/// @param newOrigin the new origin with respect to the old origin
@@ -181,6 +188,16 @@ inline float32 b2BroadPhase::GetTreeQuality() const
 	return m_tree.GetAreaRatio();
 }
 
+inline void b2BroadPhase::RebuildTree()
+{
+	m_tree.RebuildTopDown();
+}
+
+inline bool b2BroadPhase::RebuildTreeIncremental(int32 leafBudget)
+{
+	return m_tree.RebuildIncremental(leafBudget);
+}
+
 template <typename T>
 void b2BroadPhase::UpdatePairs(T* callback)
 {
@@ -43,6 +43,10 @@ b2DynamicTree::b2DynamicTree()
 	m_path = 0;
 
 	m_insertionCount = 0;
+
+	m_proxyCount = 0;
+
+	m_rebuildLeafCount = 0;
 }
 
 b2DynamicTree::~b2DynamicTree()
@@ -105,6 +109,16 @@ void b2DynamicTree::FreeNode(int32 nodeId)
 // of the node instead of a pointer so that we can grow
 // the node pool.
 int32 b2DynamicTree::CreateProxy(const b2AABB& aabb, void* userData)
+{
+	int32 proxyId = CreateDetachedProxy(aabb, userData);
+
+	InsertLeaf(proxyId);
+
+	return proxyId;
+}
+
+// Create a leaf node without linking it into the tree.
+int32 b2DynamicTree::CreateDetachedProxy(const b2AABB& aabb, void* userData)
 {
 	int32 proxyId = AllocateNode();
 
@@ -115,7 +129,7 @@ int32 b2DynamicTree::CreateProxy(const b2AABB& aabb, void* userData)
 	m_nodes[proxyId].userData = userData;
 	m_nodes[proxyId].height = 0;
 
-	InsertLeaf(proxyId);
+	++m_proxyCount;
 
 	return proxyId;
 }
@@ -127,6 +141,7 @@ void b2DynamicTree::DestroyProxy(int32 proxyId)
 
 	RemoveLeaf(proxyId);
 	FreeNode(proxyId);
+	--m_proxyCount;
 }
 
 bool b2DynamicTree::MoveProxy(int32 proxyId, const b2AABB& aabb, const b2Vec2& displacement)
@@ -265,7 +280,8 @@ void b2DynamicTree::InsertLeaf(int32 leaf)
 	m_nodes[newParent].parent = oldParent;
 	m_nodes[newParent].userData = NULL;
 	m_nodes[newParent].aabb.Combine(leafAABB, m_nodes[sibling].aabb);
-	m_nodes[newParent].height = m_nodes[sibling].height + 1;
+	// The inserted node may be a whole subtree (see InsertProxies).
+	m_nodes[newParent].height = 1 + b2Max(m_nodes[sibling].height, m_nodes[leaf].height);
 
 	if (oldParent != b2_nullNode)
 	{
@@ -773,6 +789,445 @@ void b2DynamicTree::RebuildBottomUp()
 	B2_DEBUG_STATEMENT(Validate());
 }
 
+// Split the items of a build range using a binned surface area heuristic.
+// Returns the number of items placed in the first half.
+static int32 b2PartitionItems(const b2TreeNode* nodes, int32* items, int32 count)
+{
+	b2Assert(count > 1);
+
+	if (count == 2)
+	{
+		return 1;
+	}
+
+	// Bound the centroids and split along the longest axis.
+	b2Vec2 centroidLower = nodes[items[0]].aabb.GetCenter();
+	b2Vec2 centroidUpper = centroidLower;
+	for (int32 i = 1; i < count; ++i)
+	{
+		b2Vec2 c = nodes[items[i]].aabb.GetCenter();
+		centroidLower = b2Min(centroidLower, c);
+		centroidUpper = b2Max(centroidUpper, c);
+	}
+
+	b2Vec2 extent = centroidUpper - centroidLower;
+	int32 axis = extent.x >= extent.y ? 0 : 1;
+	if (extent(axis) <= b2_epsilon)
+	{
+		// Every centroid is coincident so any split is as good as another.
+		return count / 2;
+	}
+
+	const int32 binCount = 16;
+	b2AABB binAABBs[binCount];
+	int32 binCounts[binCount];
+	for (int32 i = 0; i < binCount; ++i)
+	{
+		binCounts[i] = 0;
+	}
+
+	const float32 origin = centroidLower(axis);
+	const float32 scale = (binCount * (1.0f - b2_epsilon)) / extent(axis);
+	for (int32 i = 0; i < count; ++i)
+	{
+		const b2AABB& aabb = nodes[items[i]].aabb;
+		int32 bin = b2Clamp((int32)((aabb.GetCenter()(axis) - origin) * scale), 0, binCount - 1);
+		if (binCounts[bin] == 0)
+		{
+			binAABBs[bin] = aabb;
+		}
+		else
+		{
+			binAABBs[bin].Combine(aabb);
+		}
+		++binCounts[bin];
+	}
+
+	// Sweep from the right to accumulate the cost of each right half.
+	float32 rightCosts[binCount];
+	b2AABB rightAABB;
+	int32 rightCount = 0;
+	for (int32 i = binCount - 1; i > 0; --i)
+	{
+		if (binCounts[i] > 0)
+		{
+			if (rightCount == 0)
+			{
+				rightAABB = binAABBs[i];
+			}
+			else
+			{
+				rightAABB.Combine(binAABBs[i]);
+			}
+			rightCount += binCounts[i];
+		}
+		rightCosts[i] = rightCount > 0 ? rightAABB.GetPerimeter() * rightCount : 0.0f;
+	}
+
+	// Sweep from the left and pick the cheapest split plane.
+	float32 bestCost = b2_maxFloat;
+	int32 bestSplit = -1;
+	b2AABB leftAABB;
+	int32 leftCount = 0;
+	for (int32 i = 0; i < binCount - 1; ++i)
+	{
+		if (binCounts[i] > 0)
+		{
+			if (leftCount == 0)
+			{
+				leftAABB = binAABBs[i];
+			}
+			else
+			{
+				leftAABB.Combine(binAABBs[i]);
+			}
+			leftCount += binCounts[i];
+		}
+
+		if (leftCount == 0 || leftCount == count)
+		{
+			continue;
+		}
+
+		float32 cost = leftAABB.GetPerimeter() * leftCount + rightCosts[i + 1];
+		if (cost < bestCost)
+		{
+			bestCost = cost;
+			bestSplit = i;
+		}
+	}
+
+	if (bestSplit < 0)
+	{
+		return count / 2;
+	}
+
+	// Partition the items about the chosen plane.
+	int32 left = 0;
+	int32 right = count - 1;
+	while (left <= right)
+	{
+		int32 bin = b2Clamp((int32)((nodes[items[left]].aabb.GetCenter()(axis) - origin) * scale), 0, binCount - 1);
+		if (bin <= bestSplit)
+		{
+			++left;
+		}
+		else
+		{
+			b2Swap(items[left], items[right]);
+			--right;
+		}
+	}
+
+	if (left == 0 || left == count)
+	{
+		return count / 2;
+	}
+
+	return left;
+}
+
+struct b2TreeBuildTask
+{
+	int32 start;
+	int32 count;
+	int32 parent;
+	int32 childSlot;
+};
+
+// Build a hierarchy over the items, which may be leaves or the roots of
+// existing subtrees. Internal nodes are taken from the back of the pool
+// first, so the last pool entry becomes the new root. Unused pool nodes
+// are freed.
+int32 b2DynamicTree::BuildTopDown(int32* items, int32 count, int32* pool, int32 poolCount)
+{
+	int32 root = b2_nullNode;
+	int32* internals = NULL;
+	int32 internalCount = 0;
+
+	if (count > 1)
+	{
+		internals = (int32*)b2Alloc((count - 1) * sizeof(int32));
+	}
+
+	b2GrowableStack<b2TreeBuildTask, 64> stack;
+	b2TreeBuildTask rootTask = { 0, count, b2_nullNode, 0 };
+	if (count > 0)
+	{
+		stack.Push(rootTask);
+	}
+
+	while (stack.GetCount() > 0)
+	{
+		b2TreeBuildTask task = stack.Pop();
+
+		int32 nodeId;
+		if (task.count == 1)
+		{
+			nodeId = items[task.start];
+		}
+		else
+		{
+			// Internal nodes are fitted after the build so
+			// only the links are assigned here.
+			nodeId = poolCount > 0 ? pool[--poolCount] : AllocateNode();
+			m_nodes[nodeId].userData = NULL;
+			internals[internalCount++] = nodeId;
+
+			int32 split = b2PartitionItems(m_nodes, items + task.start, task.count);
+			b2TreeBuildTask task1 = { task.start, split, nodeId, 1 };
+			b2TreeBuildTask task2 = { task.start + split, task.count - split, nodeId, 2 };
+			stack.Push(task1);
+			stack.Push(task2);
+		}
+
+		m_nodes[nodeId].parent = task.parent;
+		if (task.parent == b2_nullNode)
+		{
+			root = nodeId;
+		}
+		else if (task.childSlot == 1)
+		{
+			m_nodes[task.parent].child1 = nodeId;
+		}
+		else
+		{
+			m_nodes[task.parent].child2 = nodeId;
+		}
+	}
+
+	// Children are always created after their parent so walking
+	// the internal nodes backwards fits them bottom-up.
+	for (int32 i = internalCount - 1; i >= 0; --i)
+	{
+		b2TreeNode* node = m_nodes + internals[i];
+		const b2TreeNode* child1 = m_nodes + node->child1;
+		const b2TreeNode* child2 = m_nodes + node->child2;
+		node->aabb.Combine(child1->aabb, child2->aabb);
+		node->height = 1 + b2Max(child1->height, child2->height);
+	}
+
+	while (poolCount > 0)
+	{
+		FreeNode(pool[--poolCount]);
+	}
+
+	if (internals != NULL)
+	{
+		b2Free(internals);
+	}
+
+	return root;
+}
+
+// Gather the nodes of a subtree down to the given height. Nodes at or
+// below the height are returned as items, the nodes above it are
+// returned as the pool of internal nodes.
+void b2DynamicTree::CollectSubtree(int32 index, int32 maxHeight, int32* items, int32* itemCount, int32* pool, int32* poolCount) const
+{
+	b2GrowableStack<int32, 256> stack;
+	stack.Push(index);
+
+	while (stack.GetCount() > 0)
+	{
+		int32 nodeId = stack.Pop();
+		const b2TreeNode* node = m_nodes + nodeId;
+
+		if (node->height <= maxHeight)
+		{
+			items[(*itemCount)++] = nodeId;
+		}
+		else
+		{
+			pool[(*poolCount)++] = nodeId;
+			stack.Push(node->child1);
+			stack.Push(node->child2);
+		}
+	}
+}
+
+// Refit the heights and AABBs from a node to the root.
+void b2DynamicTree::RefitAncestors(int32 index)
+{
+	while (index != b2_nullNode)
+	{
+		int32 child1 = m_nodes[index].child1;
+		int32 child2 = m_nodes[index].child2;
+
+		m_nodes[index].height = 1 + b2Max(m_nodes[child1].height, m_nodes[child2].height);
+		m_nodes[index].aabb.Combine(m_nodes[child1].aabb, m_nodes[child2].aabb);
+
+		index = m_nodes[index].parent;
+	}
+}
+
+void b2DynamicTree::RebuildTopDown()
+{
+	m_rebuildLeafCount = 0;
+
+	if (m_root == b2_nullNode)
+	{
+		return;
+	}
+
+	int32* items = (int32*)b2Alloc(m_nodeCount * sizeof(int32));
+	int32* pool = (int32*)b2Alloc(m_nodeCount * sizeof(int32));
+	int32 itemCount = 0;
+	int32 poolCount = 0;
+
+	CollectSubtree(m_root, 0, items, &itemCount, pool, &poolCount);
+	m_root = BuildTopDown(items, itemCount, pool, poolCount);
+
+	b2Free(pool);
+	b2Free(items);
+
+	B2_DEBUG_STATEMENT(Validate());
+}
+
+bool b2DynamicTree::RebuildIncremental(int32 leafBudget, int32 maxSubtreeHeight)
+{
+	if (m_root == b2_nullNode)
+	{
+		return false;
+	}
+
+	maxSubtreeHeight = b2Clamp(maxSubtreeHeight, 1, 10);
+
+	// Small trees are cheaper to rebuild in one go.
+	if (m_nodes[m_root].height <= maxSubtreeHeight)
+	{
+		RebuildTopDown();
+		return true;
+	}
+
+	// A subtree no taller than the limit has at most this many leaves.
+	const int32 subtreeCapacity = 1 << maxSubtreeHeight;
+	int32* items = (int32*)b2Alloc(subtreeCapacity * sizeof(int32));
+	int32* pool = (int32*)b2Alloc(subtreeCapacity * sizeof(int32));
+
+	int32 processed = 0;
+	while (processed < leafBudget && m_rebuildLeafCount < m_proxyCount)
+	{
+		// Use the path bits to pick the next subtree, as the
+		// original incremental re-balancing did.
+		int32 index = m_root;
+		uint32 bit = 0;
+		while (m_nodes[index].height > maxSubtreeHeight)
+		{
+			if (((m_path >> bit) & 1) == 0)
+			{
+				index = m_nodes[index].child1;
+			}
+			else
+			{
+				index = m_nodes[index].child2;
+			}
+
+			bit = (bit + 1) & 31;
+		}
+		++m_path;
+
+		int32 itemCount = 0;
+		int32 poolCount = 0;
+		CollectSubtree(index, 0, items, &itemCount, pool, &poolCount);
+
+		if (itemCount > 2)
+		{
+			// Keep the subtree root node so its parent link stays valid.
+			b2Assert(pool[0] == index);
+			b2Swap(pool[0], pool[poolCount - 1]);
+
+			int32 parent = m_nodes[index].parent;
+			int32 subtree = BuildTopDown(items, itemCount, pool, poolCount);
+			b2Assert(subtree == index);
+			m_nodes[subtree].parent = parent;
+
+			RefitAncestors(parent);
+		}
+
+		processed += itemCount;
+		m_rebuildLeafCount += itemCount;
+	}
+
+	b2Free(pool);
+	b2Free(items);
+
+	if (m_rebuildLeafCount < m_proxyCount)
+	{
+		return false;
+	}
+
+	// Every leaf has been visited so finish the pass by
+	// rebuilding the levels above the rebuilt subtrees.
+	items = (int32*)b2Alloc(m_nodeCount * sizeof(int32));
+	pool = (int32*)b2Alloc(m_nodeCount * sizeof(int32));
+	int32 itemCount = 0;
+	int32 poolCount = 0;
+
+	CollectSubtree(m_root, maxSubtreeHeight, items, &itemCount, pool, &poolCount);
+	m_root = BuildTopDown(items, itemCount, pool, poolCount);
+
+	b2Free(pool);
+	b2Free(items);
+
+	m_rebuildLeafCount = 0;
+
+	B2_DEBUG_STATEMENT(Validate());
+
+	return true;
+}
+
+void b2DynamicTree::InsertProxies(const int32* proxyIds, int32 count)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+
+	if (count == 1)
+	{
+		InsertLeaf(proxyIds[0]);
+		return;
+	}
+
+	// When the batch dominates the tree rebuild everything
+	// together, otherwise insert the batch as one subtree.
+	const int32 linkedCount = m_proxyCount - count;
+	if (linkedCount <= count)
+	{
+		int32* items = (int32*)b2Alloc(m_nodeCount * sizeof(int32));
+		int32* pool = (int32*)b2Alloc(m_nodeCount * sizeof(int32));
+		int32 itemCount = 0;
+		int32 poolCount = 0;
+
+		if (m_root != b2_nullNode)
+		{
+			CollectSubtree(m_root, 0, items, &itemCount, pool, &poolCount);
+		}
+
+		memcpy(items + itemCount, proxyIds, count * sizeof(int32));
+		itemCount += count;
+
+		m_root = BuildTopDown(items, itemCount, pool, poolCount);
+		m_rebuildLeafCount = 0;
+
+		b2Free(pool);
+		b2Free(items);
+	}
+	else
+	{
+		int32* items = (int32*)b2Alloc(count * sizeof(int32));
+		memcpy(items, proxyIds, count * sizeof(int32));
+
+		int32 subtree = BuildTopDown(items, count, NULL, 0);
+		InsertLeaf(subtree);
+
+		b2Free(items);
+	}
+
+	B2_DEBUG_STATEMENT(Validate());
+}
+
 void b2DynamicTree::ShiftOrigin(const b2Vec2& newOrigin)
 {
 	// Build array of leaves. Free the rest.
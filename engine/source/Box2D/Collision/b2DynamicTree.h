@@ -118,6 +118,29 @@ public:
 	/// Build an optimal tree. Very expensive. For testing.
 	void RebuildBottomUp();
 
+	/// Build a tree top-down using a binned surface area heuristic.
+	/// This is O(n log n) and produces a tree close to RebuildBottomUp.
+	void RebuildTopDown();
+
+	/// Rebuild part of the tree using the surface area heuristic. Subtrees
+	/// of at most maxSubtreeHeight are rebuilt in place until roughly
+	/// leafBudget leaves have been processed. Once every leaf has been
+	/// visited the levels above those subtrees are rebuilt as well.
+	/// @return true if this call completed a full pass over the tree.
+	bool RebuildIncremental(int32 leafBudget, int32 maxSubtreeHeight = 6);
+
+	/// Create a proxy that is not yet linked into the tree. Detached proxies
+	/// must be linked with InsertProxies before they are queried, moved or destroyed.
+	int32 CreateDetachedProxy(const b2AABB& aabb, void* userData);
+
+	/// Link detached proxies into the tree. The proxies are first built into a
+	/// single subtree which is then inserted, so this is much cheaper than
+	/// inserting each proxy on its own.
+	void InsertProxies(const int32* proxyIds, int32 count);
+
+	/// Get the number of proxies (leaves) in the tree.
+	int32 GetProxyCount() const;
+
 	/// Shift the world origin. Useful for large worlds.
 	/// The shift formula is: position -= newOrigin
 	/// @param newOrigin the new origin with respect to the old origin
@@ -133,6 +156,10 @@ private:
 
 	int32 Balance(int32 index);
 
+	int32 BuildTopDown(int32* items, int32 count, int32* pool, int32 poolCount);
+	void CollectSubtree(int32 index, int32 maxHeight, int32* items, int32* itemCount, int32* pool, int32* poolCount) const;
+	void RefitAncestors(int32 index);
+
 	int32 ComputeHeight() const;
 	int32 ComputeHeight(int32 nodeId) const;
 
@@ -151,8 +178,18 @@ private:
 	uint32 m_path;
 
 	int32 m_insertionCount;
+
+	int32 m_proxyCount;
+
+	/// Leaves processed by RebuildIncremental in the current pass.
+	int32 m_rebuildLeafCount;
 };
 
+inline int32 b2DynamicTree::GetProxyCount() const
+{
+	return m_proxyCount;
+}
+
 inline void* b2DynamicTree::GetUserData(int32 proxyId) const
 {
 	b2Assert(0 <= proxyId && proxyId < m_nodeCapacity);
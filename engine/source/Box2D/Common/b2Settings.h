@@ -159,6 +159,15 @@ typedef unsigned long long uint64;
 
 // Particle
 
+/// SSE2 equivalents of the NEON particle assembly routines are used on x86
+/// unless LIQUIDFUN_SIMD_DISABLE is defined.
+#if !defined(LIQUIDFUN_SIMD_NEON) && !defined(LIQUIDFUN_SIMD_SSE) && \
+	!defined(LIQUIDFUN_SIMD_DISABLE) && \
+	(defined(__SSE2__) || defined(_M_X64) || \
+	 (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define LIQUIDFUN_SIMD_SSE
+#endif
+
 /// NEON SIMD requires 16-bit particle indices
 #if !defined(B2_USE_16_BIT_PARTICLE_INDICES) && defined(LIQUIDFUN_SIMD_NEON)
 #define B2_USE_16_BIT_PARTICLE_INDICES
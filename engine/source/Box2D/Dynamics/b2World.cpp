@@ -1417,6 +1417,18 @@ float32 b2World::GetTreeQuality() const
 	return m_contactManager.m_broadPhase.GetTreeQuality();
 }
 
+void b2World::RebuildTree()
+{
+	b2Assert(IsLocked() == false);
+	m_contactManager.m_broadPhase.RebuildTree();
+}
+
+bool b2World::RebuildTreeIncremental(int32 leafBudget)
+{
+	b2Assert(IsLocked() == false);
+	return m_contactManager.m_broadPhase.RebuildTreeIncremental(leafBudget);
+}
+
 void b2World::ShiftOrigin(const b2Vec2& newOrigin)
 {
 	b2Assert((m_flags & e_locked) == 0);
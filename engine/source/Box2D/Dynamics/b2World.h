@@ -233,6 +233,14 @@ public:
 	/// The minimum is 1.
 	float32 GetTreeQuality() const;
 
+	/// Rebuild the dynamic tree. This is much cheaper than letting a
+	/// degraded tree slow down every step, but should not be called often.
+	void RebuildTree();
+
+	/// Rebuild part of the dynamic tree, processing roughly leafBudget proxies.
+	/// @return true if this call completed a full pass over the tree.
+	bool RebuildTreeIncremental(int32 leafBudget);
+
 	/// Change the global gravity vector.
 	void SetGravity(const b2Vec2& gravity);
 
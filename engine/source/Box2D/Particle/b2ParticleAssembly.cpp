@@ -35,3 +35,129 @@ void GrowParticleContactBuffer(
 
 } // extern "C"
 
+
+#if defined(LIQUIDFUN_SIMD_SSE)
+
+#include <emmintrin.h>
+
+// SSE2 equivalents of the routines in b2ParticleAssembly.neon.s. They follow
+// the same structure as the NEON versions: tags are computed four positions
+// at a time, and each contact check compares one particle against the four
+// consecutive proxy-ordered particles starting at its comparator index.
+
+extern "C" {
+
+int CalculateTags_Simd(const b2Vec2* positions,
+                       int count,
+                       const float& inverseDiameter,
+                       uint32* outTags)
+{
+	// Must match the constants used by computeTag() in b2ParticleSystem.cpp.
+	const __m128 inverse = _mm_set1_ps(inverseDiameter);
+	const __m128 xScale = _mm_set1_ps((float)(1u << 8));
+	const __m128 xOffset = _mm_set1_ps((float)(1u << 19));
+	const __m128 yOffset = _mm_set1_ps((float)(1u << 11));
+
+	int i = 0;
+	for (; i + NUM_V32_SLOTS <= count; i += NUM_V32_SLOTS)
+	{
+		// De-interleave (x0,y0,x1,y1) (x2,y2,x3,y3) into x and y lanes.
+		const __m128 p01 = _mm_loadu_ps(&positions[i].x);
+		const __m128 p23 = _mm_loadu_ps(&positions[i + 2].x);
+		const __m128 x = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(2, 0, 2, 0));
+		const __m128 y = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(3, 1, 3, 1));
+
+		const __m128 tx = _mm_add_ps(
+			_mm_mul_ps(_mm_mul_ps(x, inverse), xScale), xOffset);
+		const __m128 ty = _mm_add_ps(_mm_mul_ps(y, inverse), yOffset);
+		const __m128i tag = _mm_add_epi32(
+			_mm_slli_epi32(_mm_cvttps_epi32(ty), 20), _mm_cvttps_epi32(tx));
+		_mm_storeu_si128((__m128i*)(outTags + i), tag);
+	}
+
+	// Remainder.
+	for (; i < count; ++i)
+	{
+		const float x = positions[i].x * inverseDiameter;
+		const float y = positions[i].y * inverseDiameter;
+		outTags[i] = ((uint32)(int32)(y + (float)(1u << 11)) << 20) +
+			(uint32)(int32)((float)(1u << 8) * x + (float)(1u << 19));
+	}
+
+	return count;
+}
+
+void FindContactsFromChecks_Simd(
+	const FindContactInput* reordered,
+	const FindContactCheck* checks,
+	int numChecks,
+	const float& particleDiameterSq,
+	const float& particleDiameterInv,
+	const uint32* flags,
+	b2GrowableBuffer<b2ParticleContact>& contacts)
+{
+	const __m128 diameterSq = _mm_set1_ps(particleDiameterSq);
+	const __m128 diameterInv = _mm_set1_ps(particleDiameterInv);
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 zero = _mm_setzero_ps();
+
+	for (int c = 0; c < numChecks; ++c)
+	{
+		const FindContactCheck& check = checks[c];
+		const FindContactInput& particle = reordered[check.particleIndex];
+		const FindContactInput* comparators =
+			reordered + check.comparatorIndex;
+
+		// The reordered array is padded by NUM_V32_SLOTS entries positioned
+		// at b2_maxFloat, so reading four comparators never runs off the end
+		// and the padding never produces a contact.
+		const __m128 cx = _mm_set_ps(
+			comparators[3].position.x, comparators[2].position.x,
+			comparators[1].position.x, comparators[0].position.x);
+		const __m128 cy = _mm_set_ps(
+			comparators[3].position.y, comparators[2].position.y,
+			comparators[1].position.y, comparators[0].position.y);
+		const __m128 diffX = _mm_sub_ps(cx, _mm_set1_ps(particle.position.x));
+		const __m128 diffY = _mm_sub_ps(cy, _mm_set1_ps(particle.position.y));
+		const __m128 distSq = _mm_add_ps(
+			_mm_mul_ps(diffX, diffX), _mm_mul_ps(diffY, diffY));
+
+		const int hitMask = _mm_movemask_ps(_mm_cmplt_ps(distSq, diameterSq));
+		if (hitMask == 0)
+			continue;
+
+		// 1 / dist, or zero for coincident particles (as the NEON version).
+		const __m128 dist = _mm_sqrt_ps(distSq);
+		const __m128 invDist = _mm_and_ps(
+			_mm_div_ps(one, dist), _mm_cmpgt_ps(dist, zero));
+		const __m128 weight = _mm_sub_ps(
+			one, _mm_mul_ps(dist, diameterInv));
+		const __m128 normX = _mm_mul_ps(diffX, invDist);
+		const __m128 normY = _mm_mul_ps(diffY, invDist);
+
+		float weights[NUM_V32_SLOTS];
+		float normalsX[NUM_V32_SLOTS];
+		float normalsY[NUM_V32_SLOTS];
+		_mm_storeu_ps(weights, weight);
+		_mm_storeu_ps(normalsX, normX);
+		_mm_storeu_ps(normalsY, normY);
+
+		for (int lane = 0; lane < NUM_V32_SLOTS; ++lane)
+		{
+			if ((hitMask & (1 << lane)) == 0)
+				continue;
+
+			const uint32 indexA = particle.proxyIndex;
+			const uint32 indexB = comparators[lane].proxyIndex;
+			b2ParticleContact& contact = contacts.Append();
+			contact.SetIndices(indexA, indexB);
+			contact.SetFlags(flags[indexA] | flags[indexB]);
+			contact.SetWeight(weights[lane]);
+			contact.SetNormal(b2Vec2(normalsX[lane], normalsY[lane]));
+		}
+	}
+}
+
+} // extern "C"
+
+#endif // defined(LIQUIDFUN_SIMD_SSE)
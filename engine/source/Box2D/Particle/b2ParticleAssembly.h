@@ -24,10 +24,18 @@
 
 struct b2ParticleContact;
 
+// The NEON assembly relies on 16-bit check indices. The SSE routines are
+// written with intrinsics and so can address the full particle range.
+#if defined(LIQUIDFUN_SIMD_NEON)
+typedef uint16 FindContactCheckIndex;
+#else
+typedef uint32 FindContactCheckIndex;
+#endif
+
 struct FindContactCheck
 {
-    uint16 particleIndex;
-    uint16 comparatorIndex;
+    FindContactCheckIndex particleIndex;
+    FindContactCheckIndex comparatorIndex;
 };
 
 struct FindContactInput
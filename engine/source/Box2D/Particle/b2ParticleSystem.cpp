@@ -1900,8 +1900,8 @@ inline void b2ParticleSystem::GatherChecksOneParticle(
 			break;
 
 		FindContactCheck& out = checks.Append();
-		out.particleIndex = (uint16)particleIndex;
-		out.comparatorIndex = (uint16)comparatorIndex;
+		out.particleIndex = (FindContactCheckIndex)particleIndex;
+		out.comparatorIndex = (FindContactCheckIndex)comparatorIndex;
 
 		// This is faster inside the 'for' since there are so few iterations.
 		if (nextUncheckedIndex != NULL)
@@ -1947,7 +1947,7 @@ void b2ParticleSystem::GatherChecks(
 	}
 }
 
-#if defined(LIQUIDFUN_SIMD_NEON)
+#if defined(LIQUIDFUN_SIMD_NEON) || defined(LIQUIDFUN_SIMD_SSE)
 void b2ParticleSystem::FindContacts_Simd(
 	b2GrowableBuffer<b2ParticleContact>& contacts) const
 {
@@ -1979,13 +1979,13 @@ void b2ParticleSystem::FindContacts_Simd(
 
 	m_world->m_stackAllocator.Free(reordered);
 }
-#endif // defined(LIQUIDFUN_SIMD_NEON)
+#endif // defined(LIQUIDFUN_SIMD_NEON) || defined(LIQUIDFUN_SIMD_SSE)
 
 LIQUIDFUN_SIMD_INLINE
 void b2ParticleSystem::FindContacts(
 	b2GrowableBuffer<b2ParticleContact>& contacts) const
 {
-	#if defined(LIQUIDFUN_SIMD_NEON)
+	#if defined(LIQUIDFUN_SIMD_NEON) || defined(LIQUIDFUN_SIMD_SSE)
 		FindContacts_Simd(contacts);
 	#else
 		FindContacts_Reference(contacts);
@@ -2040,7 +2040,7 @@ void b2ParticleSystem::UpdateProxies_Reference(
 	}
 }
 
-#if defined(LIQUIDFUN_SIMD_NEON)
+#if defined(LIQUIDFUN_SIMD_NEON) || defined(LIQUIDFUN_SIMD_SSE)
 // static
 void b2ParticleSystem::UpdateProxyTags(
 	const uint32* const tags,
@@ -2069,7 +2069,7 @@ void b2ParticleSystem::UpdateProxies_Simd(
 
 	m_world->m_stackAllocator.Free(tags);
 }
-#endif // defined(LIQUIDFUN_SIMD_NEON)
+#endif // defined(LIQUIDFUN_SIMD_NEON) || defined(LIQUIDFUN_SIMD_SSE)
 
 // static
 bool b2ParticleSystem::ProxyBufferHasIndex(
@@ -2135,7 +2135,7 @@ void b2ParticleSystem::UpdateProxies(
 		b2GrowableBuffer<Proxy> reference(proxies);
 	#endif
 
-	#if defined(LIQUIDFUN_SIMD_NEON)
+	#if defined(LIQUIDFUN_SIMD_NEON) || defined(LIQUIDFUN_SIMD_SSE)
 		UpdateProxies_Simd(proxies);
 	#else
 		UpdateProxies_Reference(proxies);
@@ -26,6 +26,14 @@
 #include <algorithm>
 #include <numeric>
 
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TORQUE_PERLIN_SSE
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define TORQUE_PERLIN_NEON
+#include <arm_neon.h>
+#endif
+
 // THIS IS A DIRECT TRANSLATION TO C++11 FROM THE REFERENCE
 // JAVA IMPLEMENTATION OF THE IMPROVED PERLIN FUNCTION (see http://mrl.nyu.edu/~perlin/noise/)
 // THE ORIGINAL JAVA IMPLEMENTATION IS COPYRIGHT 2002 KEN PERLIN
@@ -113,4 +121,128 @@ F64 PerlinNoise::grad(S32 hash, F64 x, F64 y, F64 z) {
 	F64 u = h < 8 ? x : y,
 		v = h < 4 ? y : h == 12 || h == 14 ? x : z;
 	return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
-}
\ No newline at end of file
+}
+
+// Gradient directions selected by grad() for each hash, so grad(h, x, y, z) == x*gx[h] + y*gy[h] + z*gz[h]
+static const F32 sGradX[16] = { 1, -1,  1, -1,  1, -1,  1, -1,  0,  0,  0,  0,  1,  0, -1,  0 };
+static const F32 sGradY[16] = { 1,  1, -1, -1,  0,  0,  0,  0,  1, -1,  1, -1,  1, -1,  1, -1 };
+static const F32 sGradZ[16] = { 0,  0,  0,  0,  1,  1, -1, -1,  1,  1, -1, -1,  0,  1,  0, -1 };
+
+// Four sample lanes
+#if defined(TORQUE_PERLIN_SSE)
+typedef __m128 NoiseLanes;
+static inline NoiseLanes lanesLoad(const F32* p) { return _mm_loadu_ps(p); }
+static inline void lanesStore(F32* p, NoiseLanes a) { _mm_storeu_ps(p, a); }
+static inline NoiseLanes lanesSet(F32 a) { return _mm_set1_ps(a); }
+static inline NoiseLanes lanesAdd(NoiseLanes a, NoiseLanes b) { return _mm_add_ps(a, b); }
+static inline NoiseLanes lanesSub(NoiseLanes a, NoiseLanes b) { return _mm_sub_ps(a, b); }
+static inline NoiseLanes lanesMul(NoiseLanes a, NoiseLanes b) { return _mm_mul_ps(a, b); }
+#elif defined(TORQUE_PERLIN_NEON)
+typedef float32x4_t NoiseLanes;
+static inline NoiseLanes lanesLoad(const F32* p) { return vld1q_f32(p); }
+static inline void lanesStore(F32* p, NoiseLanes a) { vst1q_f32(p, a); }
+static inline NoiseLanes lanesSet(F32 a) { return vdupq_n_f32(a); }
+static inline NoiseLanes lanesAdd(NoiseLanes a, NoiseLanes b) { return vaddq_f32(a, b); }
+static inline NoiseLanes lanesSub(NoiseLanes a, NoiseLanes b) { return vsubq_f32(a, b); }
+static inline NoiseLanes lanesMul(NoiseLanes a, NoiseLanes b) { return vmulq_f32(a, b); }
+#else
+struct NoiseLanes { F32 v[4]; };
+static inline NoiseLanes lanesLoad(const F32* p) { NoiseLanes r; for (U32 i = 0; i < 4; i++) r.v[i] = p[i]; return r; }
+static inline void lanesStore(F32* p, NoiseLanes a) { for (U32 i = 0; i < 4; i++) p[i] = a.v[i]; }
+static inline NoiseLanes lanesSet(F32 a) { NoiseLanes r; for (U32 i = 0; i < 4; i++) r.v[i] = a; return r; }
+static inline NoiseLanes lanesAdd(NoiseLanes a, NoiseLanes b) { for (U32 i = 0; i < 4; i++) a.v[i] += b.v[i]; return a; }
+static inline NoiseLanes lanesSub(NoiseLanes a, NoiseLanes b) { for (U32 i = 0; i < 4; i++) a.v[i] -= b.v[i]; return a; }
+static inline NoiseLanes lanesMul(NoiseLanes a, NoiseLanes b) { for (U32 i = 0; i < 4; i++) a.v[i] *= b.v[i]; return a; }
+#endif
+
+static inline NoiseLanes lanesFade(NoiseLanes t) {
+	// t * t * t * (t * (t * 6 - 15) + 10)
+	NoiseLanes r = lanesAdd(lanesMul(t, lanesSub(lanesMul(t, lanesSet(6.0f)), lanesSet(15.0f))), lanesSet(10.0f));
+	return lanesMul(lanesMul(lanesMul(t, t), t), r);
+}
+
+static inline NoiseLanes lanesLerp(NoiseLanes t, NoiseLanes a, NoiseLanes b) {
+	return lanesAdd(a, lanesMul(t, lanesSub(b, a)));
+}
+
+static inline NoiseLanes lanesGrad(const F32* gx, const F32* gy, const F32* gz, NoiseLanes x, NoiseLanes y, NoiseLanes z) {
+	return lanesAdd(lanesAdd(lanesMul(lanesLoad(gx), x), lanesMul(lanesLoad(gy), y)), lanesMul(lanesLoad(gz), z));
+}
+
+void PerlinNoise::noiseBatch(const F32* x, const F32* y, F32 z, U32 count, F32* out) const {
+	const S32* perm = p.data();
+
+	// The z cell is shared by every sample
+	const F32 zFloor = mFloor(z);
+	const S32 Z = (S32)zFloor & 255;
+	const F32 zf = z - zFloor;
+	const NoiseLanes zLanes = lanesSet(zf);
+	const NoiseLanes zLanes1 = lanesSet(zf - 1.0f);
+	const NoiseLanes wLanes = lanesSet(zf * zf * zf * (zf * (zf * 6.0f - 15.0f) + 10.0f));
+	const NoiseLanes one = lanesSet(1.0f);
+	const NoiseLanes half = lanesSet(0.5f);
+
+	// Per lane fractions and the gradients of the 8 cube corners
+	F32 xf[4], yf[4], result[4];
+	F32 gx[8][4], gy[8][4], gz[8][4];
+
+	for (U32 start = 0; start < count; start += 4) {
+		const U32 lanes = getMin(count - start, (U32)4);
+
+		// Hash the cube corners one lane at a time, repeating the last sample to fill a partial block
+		for (U32 lane = 0; lane < 4; lane++) {
+			const U32 index = start + getMin(lane, lanes - 1);
+			const F32 xFloor = mFloor(x[index]);
+			const F32 yFloor = mFloor(y[index]);
+			const S32 X = (S32)xFloor & 255;
+			const S32 Y = (S32)yFloor & 255;
+			xf[lane] = x[index] - xFloor;
+			yf[lane] = y[index] - yFloor;
+
+			const S32 A = perm[X] + Y;
+			const S32 AA = perm[A] + Z;
+			const S32 AB = perm[A + 1] + Z;
+			const S32 B = perm[X + 1] + Y;
+			const S32 BA = perm[B] + Z;
+			const S32 BB = perm[B + 1] + Z;
+
+			const S32 hash[8] = { perm[AA], perm[BA], perm[AB], perm[BB], perm[AA + 1], perm[BA + 1], perm[AB + 1], perm[BB + 1] };
+			for (U32 corner = 0; corner < 8; corner++) {
+				const S32 h = hash[corner] & 15;
+				gx[corner][lane] = sGradX[h];
+				gy[corner][lane] = sGradY[h];
+				gz[corner][lane] = sGradZ[h];
+			}
+		}
+
+		// Blend the corners four samples at a time
+		const NoiseLanes x0 = lanesLoad(xf);
+		const NoiseLanes y0 = lanesLoad(yf);
+		const NoiseLanes x1 = lanesSub(x0, one);
+		const NoiseLanes y1 = lanesSub(y0, one);
+		const NoiseLanes u = lanesFade(x0);
+		const NoiseLanes v = lanesFade(y0);
+
+		const NoiseLanes nAA = lanesGrad(gx[0], gy[0], gz[0], x0, y0, zLanes);
+		const NoiseLanes nBA = lanesGrad(gx[1], gy[1], gz[1], x1, y0, zLanes);
+		const NoiseLanes nAB = lanesGrad(gx[2], gy[2], gz[2], x0, y1, zLanes);
+		const NoiseLanes nBB = lanesGrad(gx[3], gy[3], gz[3], x1, y1, zLanes);
+		const NoiseLanes nAA1 = lanesGrad(gx[4], gy[4], gz[4], x0, y0, zLanes1);
+		const NoiseLanes nBA1 = lanesGrad(gx[5], gy[5], gz[5], x1, y0, zLanes1);
+		const NoiseLanes nAB1 = lanesGrad(gx[6], gy[6], gz[6], x0, y1, zLanes1);
+		const NoiseLanes nBB1 = lanesGrad(gx[7], gy[7], gz[7], x1, y1, zLanes1);
+
+		const NoiseLanes zNear = lanesLerp(v, lanesLerp(u, nAA, nBA), lanesLerp(u, nAB, nBB));
+		const NoiseLanes zFar = lanesLerp(v, lanesLerp(u, nAA1, nBA1), lanesLerp(u, nAB1, nBB1));
+		const NoiseLanes res = lanesMul(lanesAdd(lanesLerp(wLanes, zNear, zFar), one), half);
+
+		if (lanes == 4) {
+			lanesStore(out + start, res);
+		}
+		else {
+			lanesStore(result, res);
+			for (U32 lane = 0; lane < lanes; lane++)
+				out[start + lane] = result[lane];
+		}
+	}
+}
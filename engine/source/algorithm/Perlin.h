@@ -45,6 +45,8 @@ public:
 	PerlinNoise(U32 seed);
 	// Get a noise value, for 2D images z can have any value
 	F64 noise(F64 x, F64 y, F64 z);
+	// Get count noise values at (x[i], y[i], z) in single precision
+	void noiseBatch(const F32* x, const F32* y, F32 z, U32 count, F32* out) const;
 private:
 	F64 fade(F64 t);
 	F64 lerp(F64 t, F64 a, F64 b);
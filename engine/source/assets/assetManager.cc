@@ -95,6 +95,9 @@ bool AssetManager::onAdd()
 
 void AssetManager::onRemove()
 {
+    // Clear any prefetched assets.
+    clearPrefetchedAssets( NULL );
+
     // Do we have an asset tags manifest?
     if ( !mAssetTagsManifest.isNull() )
     {
@@ -173,26 +176,44 @@ bool AssetManager::addModuleDeclaredAssets( ModuleDefinition* pModuleDefinition
         return false;
     }
 
-    // Iterate the module definition children.
-    for( SimSet::iterator itr = pModuleDefinition->begin(); itr != pModuleDefinition->end(); ++itr )
+    typeDeclaredAssetsScanVector scans;
+
+    // Fetch any declared assets scanned ahead of the module loading.
     {
-        // Fetch the declared assets.
-        DeclaredAssets* pDeclaredAssets = dynamic_cast<DeclaredAssets*>( *itr );
+        MutexHandle mutexHandle;
+        mutexHandle.lock( &mPrefetchMutex, true );
 
-        // Skip if it's not a declared assets location.
-        if ( pDeclaredAssets == NULL )
-            continue;
+        typePrefetchedAssetsHash::iterator prefetchItr = mPrefetchedAssets.find( pModuleDefinition );
+        if ( prefetchItr != mPrefetchedAssets.end() )
+        {
+            scans = *prefetchItr->value;
+            delete prefetchItr->value;
+            mPrefetchedAssets.erase( prefetchItr );
+        }
+    }
 
-        // Expand asset manifest location.
-        char filePathBuffer[1024];
-        dSprintf( filePathBuffer, sizeof(filePathBuffer), "%s/%s", pModuleDefinition->getModulePath(), pDeclaredAssets->getPath() );
+    // Scan the declared assets now if they were not prefetched.
+    if ( scans.size() == 0 )
+        collectModuleDeclaredAssets( pModuleDefinition, scans );
 
-        // Scan declared assets at location.
-        if ( !scanDeclaredAssets( filePathBuffer, pDeclaredAssets->getExtension(), pDeclaredAssets->getRecurse(), pModuleDefinition ) )
+    // Iterate the declared assets locations.
+    for( typeDeclaredAssetsScanVector::iterator scanItr = scans.begin(); scanItr != scans.end(); ++scanItr )
+    {
+        // Fetch the scan.
+        DeclaredAssetsScan* pScan = *scanItr;
+
+        // Add the declared assets at location.
+        if ( pScan->mScanned )
+        {
+            commitDeclaredAssets( *pScan, pModuleDefinition );
+        }
+        else
         {
             // Warn.
-            Con::warnf( "AssetManager::addModuleDeclaredAssets() - Could not scan for declared assets at location '%s' with extension '%s'.", filePathBuffer, pDeclaredAssets->getExtension() );
+            Con::warnf( "AssetManager::addModuleDeclaredAssets() - Could not scan for declared assets at location '%s' with extension '%s'.", pScan->mLocation, pScan->mExtension );
         }
+
+        delete pScan;
     }  
 
     return true;
@@ -2311,6 +2332,25 @@ bool AssetManager::scanDeclaredAssets( const char* pPath, const char* pExtension
     // Debug Profiling.
     PROFILE_SCOPE(AssetManager_ScanDeclaredAssets);
 
+    DeclaredAssetsScan scan;
+
+    // Find the declared assets.
+    if ( !collectDeclaredAssets( pPath, pExtension, recurse, pModuleDefinition, scan ) )
+        return false;
+
+    // Add them.
+    commitDeclaredAssets( scan, pModuleDefinition );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool AssetManager::collectDeclaredAssets( const char* pPath, const char* pExtension, const bool recurse, ModuleDefinition* pModuleDefinition, DeclaredAssetsScan& scan )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(AssetManager_CollectDeclaredAssets);
+
     // Sanity!
     AssertFatal( pPath != NULL, "Cannot scan declared assets with NULL path." );
     AssertFatal( pExtension != NULL, "Cannot scan declared assets with NULL extension." );
@@ -2319,6 +2359,10 @@ bool AssetManager::scanDeclaredAssets( const char* pPath, const char* pExtension
     char pathBuffer[1024];
     Con::expandPath( pathBuffer, sizeof(pathBuffer), pPath );
 
+    scan.mPath = StringTable->insert( pathBuffer );
+    scan.mExtension = StringTable->insert( pExtension );
+    scan.mScanned = false;
+
     // Find files.
     Vector<Platform::FileInfo> files;
     if ( !Platform::dumpPath( pathBuffer, files, recurse ? -1 : 0 ) )
@@ -2338,20 +2382,11 @@ bool AssetManager::scanDeclaredAssets( const char* pPath, const char* pExtension
         return false;
     }
 
-    // Info.
-    if ( mEchoInfo )
-    {
-        Con::printSeparator();
-        Con::printf( "Asset Manager: Scanning for declared assets in path '%s' for files with extension '%s'...", pathBuffer, pExtension );
-    }
-
     // Fetch extension length.
     const U32 extensionLength = dStrlen( pExtension );
 
-    // Fetch module assets.
-    ModuleDefinition::typeModuleAssetsVector& moduleAssets = pModuleDefinition->getModuleAssets();
-
-    TamlAssetDeclaredVisitor assetDeclaredVisitor;
+    // Loose files are expanded when the assets are added as this may not be the main thread.
+    TamlAssetDeclaredVisitor assetDeclaredVisitor( false );
 
     // Iterate files.
     for ( Vector<Platform::FileInfo>::iterator fileItr = files.begin(); fileItr != files.end(); ++fileItr )
@@ -2399,34 +2434,107 @@ bool AssetManager::scanDeclaredAssets( const char* pPath, const char* pExtension
             continue;
         }
 
+        // Create new asset definition.
+        AssetDefinition* pAssetDefinition = new AssetDefinition( foundAssetDefinition );
+        pAssetDefinition->mAssetLooseFiles = assetDeclaredVisitor.getAssetLooseFiles();
+        scan.mAssetDefinitions.push_back( pAssetDefinition );
+
+        // Store asset dependencies.
+        TamlAssetDeclaredVisitor::typeAssetIdVector& assetDependencies = assetDeclaredVisitor.getAssetDependencies();
+        scan.mDependencyCounts.push_back( assetDependencies.size() );
+        scan.mDependencies.merge( assetDependencies );
+    }
+
+    scan.mScanned = true;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void AssetManager::collectModuleDeclaredAssets( ModuleDefinition* pModuleDefinition, typeDeclaredAssetsScanVector& scans )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(AssetManager_CollectModuleDeclaredAssets);
+
+    // Iterate the module definition children.
+    for( SimSet::iterator itr = pModuleDefinition->begin(); itr != pModuleDefinition->end(); ++itr )
+    {
+        // Fetch the declared assets.
+        DeclaredAssets* pDeclaredAssets = dynamic_cast<DeclaredAssets*>( *itr );
+
+        // Skip if it's not a declared assets location.
+        if ( pDeclaredAssets == NULL )
+            continue;
+
+        // Expand asset manifest location.
+        char filePathBuffer[1024];
+        dSprintf( filePathBuffer, sizeof(filePathBuffer), "%s/%s", pModuleDefinition->getModulePath(), pDeclaredAssets->getPath() );
+
+        // Scan declared assets at location.
+        DeclaredAssetsScan* pScan = new DeclaredAssetsScan;
+        pScan->mLocation = StringTable->insert( filePathBuffer );
+        collectDeclaredAssets( filePathBuffer, pDeclaredAssets->getExtension(), pDeclaredAssets->getRecurse(), pModuleDefinition, *pScan );
+        scans.push_back( pScan );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void AssetManager::commitDeclaredAssets( DeclaredAssetsScan& scan, ModuleDefinition* pModuleDefinition )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(AssetManager_CommitDeclaredAssets);
+
+    // Info.
+    if ( mEchoInfo )
+    {
+        Con::printSeparator();
+        Con::printf( "Asset Manager: Scanning for declared assets in path '%s' for files with extension '%s'...", scan.mPath, scan.mExtension );
+    }
+
+    // Fetch module assets.
+    ModuleDefinition::typeModuleAssetsVector& moduleAssets = pModuleDefinition->getModuleAssets();
+
+    // Iterate the assets found.
+    U32 dependencyIndex = 0;
+    for ( U32 assetIndex = 0; assetIndex < (U32)scan.mAssetDefinitions.size(); ++assetIndex )
+    {
+        // Fetch asset definition, taking ownership of it.
+        AssetDefinition* pAssetDefinition = scan.mAssetDefinitions[assetIndex];
+        scan.mAssetDefinitions[assetIndex] = NULL;
+
+        // Fetch asset dependencies.
+        const U32 dependencyStart = dependencyIndex;
+        const U32 dependencyCount = scan.mDependencyCounts[assetIndex];
+        dependencyIndex += dependencyCount;
+
         // Set module definition.
-        foundAssetDefinition.mpModuleDefinition = pModuleDefinition;
+        pAssetDefinition->mpModuleDefinition = pModuleDefinition;
 
         // Format asset Id.
         char assetIdBuffer[1024];
         dSprintf(assetIdBuffer, sizeof(assetIdBuffer), "%s%s%s",
             pModuleDefinition->getModuleId(),
             ASSET_SCOPE_TOKEN,
-            foundAssetDefinition.mAssetName );
+            pAssetDefinition->mAssetName );
 
         // Set asset Id.
-        foundAssetDefinition.mAssetId = StringTable->insert( assetIdBuffer );
+        pAssetDefinition->mAssetId = StringTable->insert( assetIdBuffer );
 
         // Does this asset already exist?
-        if ( mDeclaredAssets.contains( foundAssetDefinition.mAssetId ) )
+        if ( mDeclaredAssets.contains( pAssetDefinition->mAssetId ) )
         {
             // Yes, so warn.
             Con::warnf( "Asset Manager: Encountered asset Id '%s' in asset file '%s' but it conflicts with existing asset Id in asset file '%s'.",
-                foundAssetDefinition.mAssetId,
-                foundAssetDefinition.mAssetBaseFilePath,
-                mDeclaredAssets.find( foundAssetDefinition.mAssetId )->value->mAssetBaseFilePath );
+                pAssetDefinition->mAssetId,
+                pAssetDefinition->mAssetBaseFilePath,
+                mDeclaredAssets.find( pAssetDefinition->mAssetId )->value->mAssetBaseFilePath );
 
+            delete pAssetDefinition;
             continue;
         }
 
-        // Create new asset definition.
-        AssetDefinition* pAssetDefinition = new AssetDefinition( foundAssetDefinition );
-
         // Store in declared assets.
         mDeclaredAssets.insert( pAssetDefinition->mAssetId, pAssetDefinition );
 
@@ -2446,66 +2554,95 @@ bool AssetManager::scanDeclaredAssets( const char* pPath, const char* pExtension
         // Fetch asset Id.
         StringTableEntry assetId = pAssetDefinition->mAssetId;
 
-        // Fetch asset dependencies.
-        TamlAssetDeclaredVisitor::typeAssetIdVector& assetDependencies = assetDeclaredVisitor.getAssetDependencies();
-
-        // Are there any asset dependencies?
-        if ( assetDependencies.size() > 0 )
+        // Iterate dependencies.
+        for( U32 index = dependencyStart; index < dependencyStart + dependencyCount; ++index )
         {
-            // Yes, so iterate dependencies.
-            for( TamlAssetDeclaredVisitor::typeAssetIdVector::iterator assetDependencyItr = assetDependencies.begin(); assetDependencyItr != assetDependencies.end(); ++assetDependencyItr )
-            {
-                // Fetch asset Ids.
-                StringTableEntry dependencyAssetId = *assetDependencyItr;
+            // Fetch asset Ids.
+            StringTableEntry dependencyAssetId = scan.mDependencies[index];
 
-                // Insert depends-on.
-                mAssetDependsOn.insertEqual( assetId, dependencyAssetId );
+            // Insert depends-on.
+            mAssetDependsOn.insertEqual( assetId, dependencyAssetId );
 
-                // Insert is-depended-on.
-                mAssetIsDependedOn.insertEqual( dependencyAssetId, assetId );
+            // Insert is-depended-on.
+            mAssetIsDependedOn.insertEqual( dependencyAssetId, assetId );
 
-                // Info.
-                if ( mEchoInfo )
-                {
-                    Con::printf( "Asset Manager: Asset Id '%s' has dependency of Asset Id '%s'", assetId, dependencyAssetId );
-                }
+            // Info.
+            if ( mEchoInfo )
+            {
+                Con::printf( "Asset Manager: Asset Id '%s' has dependency of Asset Id '%s'", assetId, dependencyAssetId );
             }
         }
 
-        // Fetch asset loose files.
-        TamlAssetDeclaredVisitor::typeLooseFileVector& assetLooseFiles = assetDeclaredVisitor.getAssetLooseFiles();
-
-        // Are there any loose files?
-        if ( assetLooseFiles.size() > 0 )
+        // Iterate loose files.
+        for( Vector<StringTableEntry>::iterator assetLooseFileItr = pAssetDefinition->mAssetLooseFiles.begin(); assetLooseFileItr != pAssetDefinition->mAssetLooseFiles.end(); ++assetLooseFileItr )
         {
-            // Yes, so iterate loose files.
-            for( TamlAssetDeclaredVisitor::typeLooseFileVector::iterator assetLooseFileItr = assetLooseFiles.begin(); assetLooseFileItr != assetLooseFiles.end(); ++assetLooseFileItr )
-            {
-                // Fetch loose file.
-                StringTableEntry looseFile = *assetLooseFileItr;
+            // Expand loose file.
+            *assetLooseFileItr = TamlAssetDeclaredVisitor::expandLooseFile( pAssetDefinition->mAssetBaseFilePath, *assetLooseFileItr );
 
-                // Info.
-                if ( mEchoInfo )
-                {
-                    Con::printf( "Asset Manager: Asset Id '%s' has loose file '%s'.", assetId, looseFile );
-                }
-
-                // Store loose file.
-                pAssetDefinition->mAssetLooseFiles.push_back( looseFile );
+            // Info.
+            if ( mEchoInfo )
+            {
+                Con::printf( "Asset Manager: Asset Id '%s' has loose file '%s'.", assetId, *assetLooseFileItr );
             }
         }
     }
 
+    // All asset definitions have been taken.
+    scan.mAssetDefinitions.clear();
+
     // Info.
     if ( mEchoInfo )
     {
         Con::printSeparator();
-        Con::printf( "Asset Manager: ... Finished scanning for declared assets in path '%s' for files with extension '%s'.", pathBuffer, pExtension );
+        Con::printf( "Asset Manager: ... Finished scanning for declared assets in path '%s' for files with extension '%s'.", scan.mPath, scan.mExtension );
         Con::printSeparator();
         Con::printBlankLine();
     }
+}
 
-    return true;
+//-----------------------------------------------------------------------------
+
+void AssetManager::clearPrefetchedAssets( ModuleDefinition* pModuleDefinition )
+{
+    MutexHandle mutexHandle;
+    mutexHandle.lock( &mPrefetchMutex, true );
+
+    // Collect the prefetched scans for the module or all of them if no module is specified.
+    Vector<typeDeclaredAssetsScanVector*> prefetchedScans;
+    if ( pModuleDefinition == NULL )
+    {
+        for( typePrefetchedAssetsHash::iterator prefetchItr = mPrefetchedAssets.begin(); prefetchItr != mPrefetchedAssets.end(); ++prefetchItr )
+            prefetchedScans.push_back( prefetchItr->value );
+
+        mPrefetchedAssets.clear();
+    }
+    else
+    {
+        typePrefetchedAssetsHash::iterator prefetchItr = mPrefetchedAssets.find( pModuleDefinition );
+        if ( prefetchItr == mPrefetchedAssets.end() )
+            return;
+
+        prefetchedScans.push_back( prefetchItr->value );
+        mPrefetchedAssets.erase( prefetchItr );
+    }
+
+    // Delete the scans.
+    for( Vector<typeDeclaredAssetsScanVector*>::iterator prefetchItr = prefetchedScans.begin(); prefetchItr != prefetchedScans.end(); ++prefetchItr )
+    {
+        typeDeclaredAssetsScanVector* pScans = *prefetchItr;
+        for( typeDeclaredAssetsScanVector::iterator scanItr = pScans->begin(); scanItr != pScans->end(); ++scanItr )
+            delete *scanItr;
+        delete pScans;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+AssetManager::DeclaredAssetsScan::~DeclaredAssetsScan()
+{
+    // Delete any asset definitions that were not added.
+    for( Vector<AssetDefinition*>::iterator assetItr = mAssetDefinitions.begin(); assetItr != mAssetDefinitions.end(); ++assetItr )
+        delete *assetItr;
 }
 
 //-----------------------------------------------------------------------------
@@ -2962,6 +3099,22 @@ void AssetManager::unloadAsset( AssetDefinition* pAssetDefinition )
 
 //-----------------------------------------------------------------------------
 
+void AssetManager::onModulePrefetch( ModuleDefinition* pModuleDefinition )
+{
+    // Scan the module declared assets ready for when it is loaded.
+    typeDeclaredAssetsScanVector* pScans = new typeDeclaredAssetsScanVector;
+    collectModuleDeclaredAssets( pModuleDefinition, *pScans );
+
+    // Replace any existing scan.
+    clearPrefetchedAssets( pModuleDefinition );
+
+    MutexHandle mutexHandle;
+    mutexHandle.lock( &mPrefetchMutex, true );
+    mPrefetchedAssets.insert( pModuleDefinition, pScans );
+}
+
+//-----------------------------------------------------------------------------
+
 void AssetManager::onModulePreLoad( ModuleDefinition* pModuleDefinition )
 {
     // Debug Profiling.
@@ -3010,4 +3163,7 @@ void AssetManager::onModulePostUnload( ModuleDefinition* pModuleDefinition )
 
     // Remove declared assets.
     removeDeclaredAssets( pModuleDefinition );
+
+    // Discard anything prefetched for the module.
+    clearPrefetchedAssets( pModuleDefinition );
 }
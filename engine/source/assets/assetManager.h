@@ -59,6 +59,10 @@
 #include "assets/assetFieldTypes.h"
 #endif
 
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+#include "platform/threads/mutex.h"
+#endif
+
 // Debug Profiling.
 #include "debug/profiler.h"
 
@@ -82,6 +86,29 @@ private:
     typedef HashTable<typeAssetId, typeAssetId> typeAssetIsDependedOnHash;
     typedef HashMap<AssetPtrBase*, AssetPtrCallback*> typeAssetPtrRefreshHash;
 
+    /// Declared assets found at a location but not yet added.
+    struct DeclaredAssetsScan
+    {
+        DeclaredAssetsScan() :
+            mLocation( StringTable->EmptyString ),
+            mPath( StringTable->EmptyString ),
+            mExtension( StringTable->EmptyString ),
+            mScanned( false )
+        {
+        }
+        ~DeclaredAssetsScan();
+
+        StringTableEntry            mLocation;
+        StringTableEntry            mPath;
+        StringTableEntry            mExtension;
+        bool                        mScanned;
+        Vector<AssetDefinition*>    mAssetDefinitions;
+        Vector<U32>                 mDependencyCounts;
+        Vector<StringTableEntry>    mDependencies;
+    };
+    typedef Vector<DeclaredAssetsScan*> typeDeclaredAssetsScanVector;
+    typedef HashMap<ModuleDefinition*, typeDeclaredAssetsScanVector*> typePrefetchedAssetsHash;
+
     /// Declared assets.
     typeDeclaredAssetsHash              mDeclaredAssets;
 
@@ -99,6 +126,10 @@ private:
     /// Asset pointer refresh notifications.
     typeAssetPtrRefreshHash             mAssetPtrRefreshNotifications;
 
+    /// Declared assets scanned ahead of their module loading.
+    typePrefetchedAssetsHash            mPrefetchedAssets;
+    Mutex                               mPrefetchMutex;
+
     /// Miscellaneous.
     bool                                mEchoInfo;
     bool                                mIgnoreAutoUnload;
@@ -372,6 +403,10 @@ public:
 
 private:
     bool scanDeclaredAssets( const char* pPath, const char* pExtension, const bool recurse, ModuleDefinition* pModuleDefinition );
+    bool collectDeclaredAssets( const char* pPath, const char* pExtension, const bool recurse, ModuleDefinition* pModuleDefinition, DeclaredAssetsScan& scan );
+    void collectModuleDeclaredAssets( ModuleDefinition* pModuleDefinition, typeDeclaredAssetsScanVector& scans );
+    void commitDeclaredAssets( DeclaredAssetsScan& scan, ModuleDefinition* pModuleDefinition );
+    void clearPrefetchedAssets( ModuleDefinition* pModuleDefinition );
     bool scanReferencedAssets( const char* pPath, const char* pExtension, const bool recurse );
     AssetDefinition* findAsset( const char* pAssetId );
     void addReferencedAsset( StringTableEntry assetId, StringTableEntry referenceFilePath );
@@ -383,6 +418,7 @@ private:
     void unloadAsset( AssetDefinition* pAssetDefinition );
 
     /// Module callbacks.
+    virtual void onModulePrefetch( ModuleDefinition* pModuleDefinition );
     virtual void onModulePreLoad( ModuleDefinition* pModuleDefinition );
     virtual void onModulePreUnload( ModuleDefinition* pModuleDefinition );
     virtual void onModulePostUnload( ModuleDefinition* pModuleDefinition );
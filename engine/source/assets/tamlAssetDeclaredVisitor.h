@@ -59,9 +59,10 @@ private:
     AssetDefinition         mAssetDefinition;
     typeAssetIdVector       mAssetDependencies;
     typeLooseFileVector     mAssetLooseFiles;
+    bool                    mExpandLooseFiles;
 
 public:
-    TamlAssetDeclaredVisitor() { mAssetDefinition.reset(); }
+    TamlAssetDeclaredVisitor( const bool expandLooseFiles = true ) : mExpandLooseFiles( expandLooseFiles ) { mAssetDefinition.reset(); }
     virtual ~TamlAssetDeclaredVisitor() {}
 
 
@@ -71,6 +72,22 @@ public:
 
     void clear( void ) { mAssetDefinition.reset(); mAssetDependencies.clear(); mAssetLooseFiles.clear(); }
 
+    /// Expand a loose-file reference relative to the asset file that declared it.
+    static StringTableEntry expandLooseFile( StringTableEntry assetBaseFilePath, const char* pAssetLooseFile )
+    {
+        // Fetch asset path only.
+        char assetBasePathBuffer[1024];
+        dSprintf( assetBasePathBuffer, sizeof(assetBasePathBuffer), "%s", assetBaseFilePath );
+        char* pFinalSlash = dStrrchr( assetBasePathBuffer, '/' );
+        if ( pFinalSlash != NULL ) *pFinalSlash = 0;
+
+        // Expand the path in the usual way.
+        char assetFilePathBuffer[1024];
+        Con::expandPath( assetFilePathBuffer, sizeof(assetFilePathBuffer), pAssetLooseFile, assetBasePathBuffer );
+
+        return StringTable->insert( assetFilePathBuffer );
+    }
+
     virtual bool wantsPropertyChanges( void ) { return false; }
     virtual bool wantsRootOnly( void ) { return false; }
 
@@ -131,21 +148,20 @@ public:
             }
         }
 
-        // Fetch property word count.
-        const U32 propertyWordCount = StringUnit::getUnitCount( pPropertyValue, ASSET_ASSIGNMENT_TOKEN );
-
-        // Finish if there's not two words.
-        if ( propertyWordCount != 2 )
+        // Split the property into its signature and reference, finishing if there's not two words.
+        char signatureBuffer[1024];
+        char referenceBuffer[1024];
+        if ( !splitAssignment( pPropertyValue, signatureBuffer, referenceBuffer, sizeof(signatureBuffer) ) )
             return true;
 
         // Fetch the asset signature.
-        StringTableEntry assetSignature = StringTable->insert( StringUnit::getUnit( pPropertyValue, 0, ASSET_ASSIGNMENT_TOKEN ) );
+        StringTableEntry assetSignature = StringTable->insert( signatureBuffer );
 
         // Is this an asset Id signature?
         if ( assetSignature == assetLooseIdSignature )
         {
             // Yes, so get asset Id.
-            typeAssetId assetId = StringTable->insert( StringUnit::getUnit( pPropertyValue, 1, ASSET_ASSIGNMENT_TOKEN ) );
+            typeAssetId assetId = StringTable->insert( referenceBuffer );
 
             // Finish if the dependency is itself!
             if ( mAssetDefinition.mAssetId == assetId )
@@ -165,22 +181,47 @@ public:
         // Is this a loose-file signature?
         else if ( assetSignature == assetLooseFileSignature )
         {
-            // Yes, so get loose-file reference.
-            const char* pAssetLooseFile = StringUnit::getUnit( pPropertyValue, 1, ASSET_ASSIGNMENT_TOKEN );
+            // Yes, so insert asset loose-file, leaving it unexpanded if requested.
+            mAssetLooseFiles.push_back( mExpandLooseFiles ? expandLooseFile( mAssetDefinition.mAssetBaseFilePath, referenceBuffer ) : StringTable->insert( referenceBuffer ) );
+        }
 
-            // Fetch asset path only.
-            char assetBasePathBuffer[1024];
-            dSprintf( assetBasePathBuffer, sizeof(assetBasePathBuffer), "%s", mAssetDefinition.mAssetBaseFilePath );
-            char* pFinalSlash = dStrrchr( assetBasePathBuffer, '/' );
-            if ( pFinalSlash != NULL ) *pFinalSlash = 0;
+        return true;
+    }
 
-            // Expand the path in the usual way.
-            char assetFilePathBuffer[1024];
-            Con::expandPath( assetFilePathBuffer, sizeof(assetFilePathBuffer), pAssetLooseFile, assetBasePathBuffer );
+private:
+    /// Split a "signature=reference" property value in the same way as the "=" unit functions would
+    /// but without their shared return buffer so that asset files can be scanned off the main thread.
+    static bool splitAssignment( const char* pPropertyValue, char* pSignature, char* pReference, const U32 bufferSize )
+    {
+        const char assignmentToken = ASSET_ASSIGNMENT_TOKEN[0];
+
+        // Find the assignment.
+        const char* pAssignment = dStrchr( pPropertyValue, assignmentToken );
+        if ( pAssignment == NULL )
+            return false;
+
+        // Find the reference length.  Only a trailing second assignment still leaves two words.
+        const char* pReferenceStart = pAssignment + 1;
+        const char* pReferenceEnd = dStrchr( pReferenceStart, assignmentToken );
+        if ( pReferenceEnd == NULL )
+        {
+            if ( *pReferenceStart == 0 )
+                return false;
 
-            // Insert asset loose-file.
-            mAssetLooseFiles.push_back( StringTable->insert( assetFilePathBuffer ) );
+            pReferenceEnd = pReferenceStart + dStrlen( pReferenceStart );
         }
+        else if ( pReferenceEnd[1] != 0 )
+        {
+            return false;
+        }
+
+        const U32 signatureLength = getMin( (U32)(pAssignment - pPropertyValue), bufferSize - 1 );
+        dStrncpy( pSignature, pPropertyValue, signatureLength );
+        pSignature[signatureLength] = 0;
+
+        const U32 referenceLength = getMin( (U32)(pReferenceEnd - pReferenceStart), bufferSize - 1 );
+        dStrncpy( pReference, pReferenceStart, referenceLength );
+        pReference[referenceLength] = 0;
 
         return true;
     }
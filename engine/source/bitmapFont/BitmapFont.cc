@@ -29,16 +29,24 @@
 #endif
 
 #include <string>
+#include <algorithm>
 
 namespace font
 {
-   BitmapFont::BitmapFont()
+   BitmapFont::BitmapFont() : mKerningTableMask(0)
    {
-
+      // The default character is returned for any missing characters.
+      mChar.push_back(BitmapFontCharacter());
    }
 
    bool BitmapFont::parseFont(Stream& io_rStream)
    {
+      // Reset the characters and kerning.
+      mChar.resize(1);
+      mDenseCharIndex.clear();
+      mSparseCharIndex.clear();
+      mKerningPairs.clear();
+
       U32 numBytes = io_rStream.getStreamSize() - io_rStream.getPosition();
       while ((io_rStream.getStatus() != Stream::EOS) && numBytes > 0)
       {
@@ -188,7 +196,7 @@ namespace font
             }
             ci.mCharID = CharID;
             ci.ProcessCharacter(mWidth, mHeight);
-            mChar[CharID] = ci;
+            AddCharacter(ci);
          }
          else if (dStrcmp(Read, "kerning") == 0 && dStrcmp(Read, "kernings") != 0)
          {
@@ -227,9 +235,204 @@ namespace font
          }
       }
 
+      // Build the kerning lookup.
+      BuildKerningTable();
+
       return (io_rStream.getStatus() == Stream::EOS);
    }
 
+   void BitmapFont::AddCharacter(const BitmapFontCharacter& character)
+   {
+      const U16 charID = character.mCharID;
+
+      // Use the dense index for lower characters.
+      if (charID < DenseCharacterLimit)
+      {
+         if (charID >= mDenseCharIndex.size())
+            mDenseCharIndex.resize(charID + 1, 0);
+
+         // Replace any existing character.
+         if (mDenseCharIndex[charID] != 0)
+         {
+            mChar[mDenseCharIndex[charID]] = character;
+            return;
+         }
+
+         mDenseCharIndex[charID] = (U16)mChar.size();
+         mChar.push_back(character);
+         return;
+      }
+
+      // Binary search the sorted position in the sparse index.
+      U32 low = 0;
+      U32 high = (U32)mSparseCharIndex.size();
+      while (low < high)
+      {
+         const U32 middle = (low + high) >> 1;
+         if (mSparseCharIndex[middle].mCharID < charID)
+            low = middle + 1;
+         else
+            high = middle;
+      }
+      std::vector<SparseCharacter>::iterator itr = mSparseCharIndex.begin() + low;
+
+      // Replace any existing character.
+      if (itr != mSparseCharIndex.end() && itr->mCharID == charID)
+      {
+         mChar[itr->mIndex] = character;
+         return;
+      }
+
+      SparseCharacter sparseCharacter = { charID, (U16)mChar.size() };
+      mSparseCharIndex.insert(itr, sparseCharacter);
+      mChar.push_back(character);
+   }
+
+   U16 BitmapFont::findSparseCharacter(const U16 charID) const
+   {
+      // Binary search the sparse index.
+      S32 low = 0;
+      S32 high = (S32)mSparseCharIndex.size() - 1;
+      while (low <= high)
+      {
+         const S32 middle = (low + high) >> 1;
+         const SparseCharacter& sparseCharacter = mSparseCharIndex[middle];
+
+         if (sparseCharacter.mCharID == charID)
+            return sparseCharacter.mIndex;
+
+         if (sparseCharacter.mCharID < charID)
+            low = middle + 1;
+         else
+            high = middle - 1;
+      }
+
+      // Not found so use the default character.
+      return 0;
+   }
+
+   static bool kerningPairSort(const std::pair<U32, U32>& a, const std::pair<U32, U32>& b)
+   {
+      return a.first < b.first || (a.first == b.first && a.second < b.second);
+   }
+
+   void BitmapFont::BuildKerningTable()
+   {
+      // Debug Profiling.
+      PROFILE_SCOPE(BitmapFont_BuildKerningTable);
+
+      mKerningTable.clear();
+      mKerningDisplacement.clear();
+      mKerningTableMask = 0;
+
+      // Finish if there are no kerning pairs.
+      if (mKerningPairs.empty())
+         return;
+
+      // Sort the pairs by key then declaration order.
+      std::vector< std::pair<U32, U32> > sortedPairs;
+      sortedPairs.reserve(mKerningPairs.size());
+      for (U32 n = 0; n < (U32)mKerningPairs.size(); ++n)
+         sortedPairs.push_back(std::make_pair(mKerningPairs[n].mKey, n));
+      std::sort(sortedPairs.begin(), sortedPairs.end(), kerningPairSort);
+
+      // Keep the last declaration of each pair.
+      std::vector<KerningPair> pairs;
+      pairs.reserve(sortedPairs.size());
+      for (U32 n = 0; n < (U32)sortedPairs.size(); ++n)
+      {
+         if (n + 1 < (U32)sortedPairs.size() && sortedPairs[n + 1].first == sortedPairs[n].first)
+            continue;
+
+         pairs.push_back(mKerningPairs[sortedPairs[n].second]);
+      }
+
+      // The raw pairs are no longer needed.
+      std::vector<KerningPair>().swap(mKerningPairs);
+
+      const U32 pairCount = (U32)pairs.size();
+      const U32 bucketCount = getMax(pairCount / 4, (U32)1);
+
+      // Distribute the pairs into buckets.
+      std::vector< std::vector<U32> > buckets(bucketCount);
+      for (U32 n = 0; n < pairCount; ++n)
+         buckets[hashKerning(pairs[n].mKey, 0) % bucketCount].push_back(n);
+
+      // Place the largest buckets first.
+      std::vector< std::pair<U32, U32> > bucketOrder;
+      bucketOrder.reserve(bucketCount);
+      for (U32 n = 0; n < bucketCount; ++n)
+         bucketOrder.push_back(std::make_pair((U32)buckets[n].size(), n));
+      std::sort(bucketOrder.rbegin(), bucketOrder.rend());
+
+      // Start with a table at most half full.
+      U32 tableSize = 1;
+      while (tableSize < pairCount * 2)
+         tableSize <<= 1;
+
+      std::vector<U32> slots;
+      while (true)
+      {
+         const U32 tableMask = tableSize - 1;
+         std::vector<bool> occupied(tableSize, false);
+         mKerningDisplacement.assign(bucketCount, 0);
+         bool placed = true;
+
+         // Find a displacement for each bucket that places all its pairs in free slots.
+         for (U32 orderIndex = 0; orderIndex < bucketCount && placed; ++orderIndex)
+         {
+            const std::vector<U32>& bucket = buckets[bucketOrder[orderIndex].second];
+            if (bucket.empty())
+               break;
+
+            bool bucketPlaced = false;
+            for (U32 displacement = 1; displacement <= 0xFFFF && !bucketPlaced; ++displacement)
+            {
+               slots.clear();
+               bucketPlaced = true;
+               for (U32 n = 0; n < (U32)bucket.size(); ++n)
+               {
+                  const U32 slot = hashKerning(pairs[bucket[n]].mKey, displacement) & tableMask;
+                  if (occupied[slot] || std::find(slots.begin(), slots.end(), slot) != slots.end())
+                  {
+                     bucketPlaced = false;
+                     break;
+                  }
+                  slots.push_back(slot);
+               }
+
+               if (!bucketPlaced)
+                  continue;
+
+               for (U32 n = 0; n < (U32)slots.size(); ++n)
+                  occupied[slots[n]] = true;
+
+               mKerningDisplacement[bucketOrder[orderIndex].second] = (U16)displacement;
+            }
+
+            placed = bucketPlaced;
+         }
+
+         // Finish if all the pairs were placed otherwise grow the table and try again.
+         if (placed)
+         {
+            mKerningTableMask = tableMask;
+            break;
+         }
+
+         tableSize <<= 1;
+      }
+
+      // Populate the table.
+      const KerningPair emptyPair = { 0xFFFFFFFF, 0 };
+      mKerningTable.assign(tableSize, emptyPair);
+      for (U32 n = 0; n < pairCount; ++n)
+      {
+         const U32 displacement = mKerningDisplacement[hashKerning(pairs[n].mKey, 0) % bucketCount];
+         mKerningTable[hashKerning(pairs[n].mKey, displacement) & mKerningTableMask] = pairs[n];
+      }
+   }
+
    TextureHandle BitmapFont::LoadTexture(StringTableEntry fileName)
    {
       // Debug Profiling.
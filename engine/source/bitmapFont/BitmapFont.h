@@ -39,19 +39,40 @@ using namespace std;
 #include <map>
 #include <string>
 #include <vector>
-using KerningMap = map<pair<U16, U16>, S16>;
-using CharacterMap = map<U16, font::BitmapFontCharacter>;
 
 namespace font
 {
    class BitmapFont
    {
    private:
+      /// Characters below this ID are looked up directly, others by a binary search.
+      static const U32 DenseCharacterLimit = 0x3000;
+
+      struct SparseCharacter
+      {
+         U16 mCharID;
+         U16 mIndex;
+      };
+
+      struct KerningPair
+      {
+         U32 mKey;
+         S16 mAmount;
+      };
+
       U16 mWidth, mHeight;
       U16 mPages;
 
-      CharacterMap mChar;       
-      KerningMap mKerning;
+      /// Characters with the default (missing) character at index zero.
+      std::vector<BitmapFontCharacter> mChar;
+      std::vector<U16> mDenseCharIndex;
+      std::vector<SparseCharacter> mSparseCharIndex;
+
+      /// Kerning pairs in a perfect hash table.
+      std::vector<KerningPair> mKerningPairs;
+      std::vector<KerningPair> mKerningTable;
+      std::vector<U16> mKerningDisplacement;
+      U32 mKerningTableMask;
 
    public:
       U16 mLineHeight;
@@ -63,12 +84,41 @@ namespace font
       BitmapFont();
       bool parseFont(Stream& io_rStream);
       TextureHandle LoadTexture(StringTableEntry fileName);
-      const BitmapFontCharacter& getCharacter(const U16 charID) { return mChar[charID]; }
+      inline const BitmapFontCharacter& getCharacter(const U16 charID) const
+      {
+         if (charID < mDenseCharIndex.size())
+            return mChar[mDenseCharIndex[charID]];
+
+         return mChar[findSparseCharacter(charID)];
+      }
       inline const F32 getSizeRatio(const F32 size) { return size / mLineHeight; }
-      inline const S16 getKerning(U16 first, U16 second) { return (S16)mKerning[make_pair(first, second)]; }
+      inline const S16 getKerning(U16 first, U16 second) const
+      {
+         if (mKerningTable.empty())
+            return 0;
+
+         const U32 key = ((U32)first << 16) | second;
+         const U32 displacement = mKerningDisplacement[hashKerning(key, 0) % mKerningDisplacement.size()];
+         const KerningPair& pair = mKerningTable[hashKerning(key, displacement) & mKerningTableMask];
+         return pair.mKey == key ? pair.mAmount : 0;
+      }
 
    private:
-      inline void AddKerning(U16 first, U16 second, S16 amount) { mKerning[make_pair(first, second)] = amount; }
+      inline void AddKerning(U16 first, U16 second, S16 amount) { KerningPair pair = { ((U32)first << 16) | second, amount }; mKerningPairs.push_back(pair); }
+      void AddCharacter(const BitmapFontCharacter& character);
+      U16 findSparseCharacter(const U16 charID) const;
+      void BuildKerningTable();
+
+      static inline U32 hashKerning(U32 key, const U32 seed)
+      {
+         key ^= seed * 0x9E3779B9;
+         key ^= key >> 16;
+         key *= 0x85EBCA6B;
+         key ^= key >> 13;
+         key *= 0xC2B2AE35;
+         key ^= key >> 16;
+         return key;
+      }
    };
 }
 
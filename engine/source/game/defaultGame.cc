@@ -58,6 +58,7 @@
 #include "platform/nativeDialogs/msgBox.h"
 #include "platform/nativeDialogs/fileDialog.h"
 #include "memory/safeDelete.h"
+#include "messaging/dispatcher.h"
 
 #include <stdio.h>
 
@@ -618,6 +619,11 @@ AndroidProfilerStart("SERVER_PROC");
       GNet->processServer();
    PROFILE_END();
     
+   PROFILE_START(DispatcherPostedMessages);
+   // deliver messages posted from other threads
+   Dispatcher::processPostedMessages();
+   PROFILE_END();
+
    PROFILE_START(SimAdvanceTime);
 #ifdef TORQUE_OS_IOS_PROFILE
     iPhoneProfilerStart("SIM_TIME");
@@ -53,4 +53,16 @@ void DynamicTexture::setSize( const U32 texelWidth, const U32 texelHeight )
 
     // Set texture against bitmap.
     mTextureHandle.set( mTextureKey, mpBitmap, TextureHandle::BitmapKeepTexture );
-}
\ No newline at end of file
+}
+
+//-----------------------------------------------------------------------------
+
+void DynamicTexture::refresh( void )
+{
+    // Finish if no bitmap.
+    if ( mpBitmap == NULL )
+        return;
+
+    // Upload the modified bitmap.
+    mTextureHandle.refresh();
+}
@@ -55,6 +55,10 @@ public:
     {
     	return mTextureHandle;
     }
+
+    /// The bitmap can be written directly, i.e. by NoiseGenerator::generateBitmap(), followed by refresh().
+    inline GBitmap* getBitmap( void ) const { return mpBitmap; }
+    void refresh( void );
 };
 
 #endif // _DYNAMIC_TEXTURE_H_
@@ -0,0 +1,660 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "graphics/TextureAtlas.h"
+#include "graphics/TextureManager.h"
+#include "graphics/gBitmap.h"
+#include "console/console.h"
+#include "console/consoleTypes.h"
+#include "memory/safeDelete.h"
+#include "math/mMath.h"
+
+//-----------------------------------------------------------------------------
+
+TextureAtlas::typePageVector TextureAtlas::mPages;
+S32 TextureAtlas::mPageSize = 1024;
+bool TextureAtlas::mCreated = false;
+
+//-----------------------------------------------------------------------------
+
+static const S32 MinimumAtlasPageSize = 128;
+
+static Vector<U8> atlasUploadBuffer;
+
+//-----------------------------------------------------------------------------
+
+struct AtlasPackItem
+{
+    TextureAtlas::AtlasEntry*   mpEntry;
+    S32                         mWidth;
+    S32                         mHeight;
+    Point2I                     mPosition;
+};
+
+static S32 QSORT_CALLBACK sortPackItems( const void* a, const void* b )
+{
+    const AtlasPackItem* pItemA = (const AtlasPackItem*)a;
+    const AtlasPackItem* pItemB = (const AtlasPackItem*)b;
+
+    // Taller items first then wider items.
+    if ( pItemA->mHeight != pItemB->mHeight )
+        return pItemB->mHeight - pItemA->mHeight;
+
+    return pItemB->mWidth - pItemA->mWidth;
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureAtlas::create()
+{
+    AssertISV( !mCreated, "TextureAtlas::create() - already created!" );
+
+    Con::addVariable( "$pref::OpenGL::textureAtlasPageSize", TypeS32, &TextureAtlas::mPageSize );
+
+    mCreated = true;
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureAtlas::destroy()
+{
+    // Finish if not created.
+    if ( !mCreated )
+        return;
+
+    // Warn if any entries are still packed.
+    for ( S32 pageIndex = 0; pageIndex < mPages.size(); ++pageIndex )
+    {
+        if ( mPages[pageIndex]->mEntries.size() > 0 )
+        {
+            Con::warnf( "TextureAtlas::destroy() - %d entries are still packed.", mPages[pageIndex]->mEntries.size() );
+        }
+    }
+
+    // Destroy all the pages.
+    while ( mPages.size() > 0 )
+    {
+        destroyPage( mPages.last() );
+    }
+
+    mPages.compact();
+    atlasUploadBuffer.clear();
+    atlasUploadBuffer.compact();
+
+    mCreated = false;
+}
+
+//-----------------------------------------------------------------------------
+
+bool TextureAtlas::acquire( const char* pTextureKey, const GLuint filter, const S32 maximumEntrySize, TextureHandle& textureHandle, AtlasEntry*& pEntry, EntryRelocatedCallback pRelocatedCallback, void* pUserData )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TextureAtlas_Acquire);
+
+    // Reset the entry.
+    pEntry = NULL;
+
+    // Finish if not created or no texture key.
+    if ( !mCreated || pTextureKey == NULL || *pTextureKey == 0 )
+        return false;
+
+    // Fetch texture key.
+    StringTableEntry textureKey = StringTable->insert( pTextureKey );
+
+    // Finish if the texture is already resident.  It is shared as-is.
+    if ( TextureDictionary::find( textureKey ) != NULL )
+        return false;
+
+    // Load the bitmap.
+    GBitmap* pBitmap = TextureManager::loadBitmap( textureKey );
+
+    // Finish if the bitmap could not be loaded.
+    if ( pBitmap == NULL )
+        return false;
+
+    // Only change the page size when there are no pages.
+    if ( mPages.size() == 0 )
+    {
+        mPageSize = getMax( getNextPow2( (U32)getMax( mPageSize, MinimumAtlasPageSize ) ), (U32)MinimumAtlasPageSize );
+        mPageSize = getMin( mPageSize, (S32)MaximumProductSupportedTextureWidth );
+    }
+
+    // Fetch the bitmap dimensions.
+    const S32 bitmapWidth = pBitmap->getWidth();
+    const S32 bitmapHeight = pBitmap->getHeight();
+    const S32 entryMaximum = getMin( maximumEntrySize, getMaximumEntrySize() );
+
+    // Is the bitmap suitable for packing?
+    if ( bitmapWidth > entryMaximum || bitmapHeight > entryMaximum || !isFormatSupported( pBitmap ) )
+    {
+        // No, so register it as a standalone texture.
+        textureHandle = TextureHandle( TextureManager::registerTexture( textureKey, pBitmap, TextureHandle::BitmapTexture, true ) );
+        return !textureHandle.IsNull();
+    }
+
+    // Calculate the padded dimensions.
+    const S32 paddedWidth = bitmapWidth + (ENTRY_PADDING * 2);
+    const S32 paddedHeight = bitmapHeight + (ENTRY_PADDING * 2);
+
+    AtlasPage* pPage = NULL;
+    Point2I paddedOffset;
+
+    // Find a page with space available.
+    for ( S32 pageIndex = 0; pageIndex < mPages.size() && pPage == NULL; ++pageIndex )
+    {
+        if ( mPages[pageIndex]->mFilter == filter && insertIntoPage( mPages[pageIndex], paddedWidth, paddedHeight, paddedOffset ) )
+            pPage = mPages[pageIndex];
+    }
+
+    // Reclaim the space of released entries.
+    for ( S32 pageIndex = 0; pageIndex < mPages.size() && pPage == NULL; ++pageIndex )
+    {
+        if ( mPages[pageIndex]->mFilter == filter && repackPage( mPages[pageIndex], paddedWidth, paddedHeight, paddedOffset ) )
+            pPage = mPages[pageIndex];
+    }
+
+    // Create a new page if there is no space.
+    if ( pPage == NULL )
+    {
+        pPage = createPage( filter );
+
+        // Does the entry fit the empty page?
+        if ( !insertIntoPage( pPage, paddedWidth, paddedHeight, paddedOffset ) )
+        {
+            // No, so warn and register it as a standalone texture instead.
+            Con::warnf( "TextureAtlas::acquire() - Entry '%s' does not fit an empty page.", textureKey );
+            destroyPage( pPage );
+            textureHandle = TextureHandle( TextureManager::registerTexture( textureKey, pBitmap, TextureHandle::BitmapTexture, true ) );
+            return !textureHandle.IsNull();
+        }
+    }
+
+    // Create the entry.
+    pEntry = new AtlasEntry();
+    pEntry->mpPage = pPage;
+    pEntry->mTextureKey = textureKey;
+    pEntry->mFilter = filter;
+    pEntry->mOffset.set( paddedOffset.x + ENTRY_PADDING, paddedOffset.y + ENTRY_PADDING );
+    pEntry->mSize.set( bitmapWidth, bitmapHeight );
+    pEntry->mpRelocatedCallback = pRelocatedCallback;
+    pEntry->mpUserData = pUserData;
+    pPage->mEntries.push_back( pEntry );
+
+    // Copy and upload the bitmap.
+    copyBitmap( pPage->mpBitmap, pBitmap, pEntry->mOffset );
+    uploadRegion( pPage, paddedOffset, Point2I( paddedWidth, paddedHeight ) );
+
+    // The bitmap is no longer required.
+    delete pBitmap;
+
+    // Use the page texture.
+    textureHandle = pPage->mTexture;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureAtlas::release( AtlasEntry* pEntry )
+{
+    // Finish if not created or no entry.
+    if ( !mCreated || pEntry == NULL )
+        return;
+
+    AtlasPage* pPage = pEntry->mpPage;
+
+    // Remove the entry from its page.
+    for ( S32 entryIndex = 0; entryIndex < pPage->mEntries.size(); ++entryIndex )
+    {
+        if ( pPage->mEntries[entryIndex] == pEntry )
+        {
+            pPage->mEntries.erase_fast( entryIndex );
+            break;
+        }
+    }
+
+    // Reclaim the area.  The skyline is only compacted when the page is repacked.
+    pPage->mUsedArea -= (pEntry->mSize.x + (ENTRY_PADDING * 2)) * (pEntry->mSize.y + (ENTRY_PADDING * 2));
+
+    delete pEntry;
+
+    // Destroy the page if it is empty.
+    if ( pPage->mEntries.size() == 0 )
+        destroyPage( pPage );
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureAtlas::dumpMetrics( void )
+{
+    Con::printSeparator();
+    Con::printBlankLine();
+    Con::printf( "Dumping texture atlas metrics:" );
+
+    S32 entryCount = 0;
+    for ( S32 pageIndex = 0; pageIndex < mPages.size(); ++pageIndex )
+    {
+        const AtlasPage* pPage = mPages[pageIndex];
+        const F32 usage = (F32)pPage->mUsedArea / (F32)(mPageSize * mPageSize);
+
+        // Info.
+        Con::printf( "Page: %d, Size: (%d-%d), Filter: %s, Entries: %d, Usage: %.1f%%, Name=%s",
+            pageIndex, mPageSize, mPageSize,
+            pPage->mFilter == GL_NEAREST ? "NEAREST" : "LINEAR",
+            pPage->mEntries.size(),
+            usage * 100.0f,
+            pPage->mTexture.getTextureKey() );
+
+        entryCount += pPage->mEntries.size();
+    }
+
+    Con::printf( "Total Pages: %d, Total Entries: %d", mPages.size(), entryCount );
+
+    Con::printBlankLine();
+    Con::printSeparator();
+}
+
+//-----------------------------------------------------------------------------
+
+bool TextureAtlas::isFormatSupported( const GBitmap* pBitmap )
+{
+    // Forced 16-bit bitmaps are kept standalone.
+    if ( pBitmap->mForce16Bit )
+        return false;
+
+    switch( pBitmap->getFormat() )
+    {
+        case GBitmap::RGB:
+        case GBitmap::RGBA:
+        case GBitmap::Alpha:
+        case GBitmap::Luminance:
+        case GBitmap::LuminanceAlpha:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TextureAtlas::AtlasPage* TextureAtlas::createPage( const GLuint filter )
+{
+    // Create the page bitmap.
+    GBitmap* pBitmap = new GBitmap( mPageSize, mPageSize, false, GBitmap::RGBA );
+    dMemset( pBitmap->getWritableBits(), 0, pBitmap->byteSize );
+
+    // Create the page.
+    AtlasPage* pPage = new AtlasPage();
+    pPage->mpBitmap = pBitmap;
+    pPage->mFilter = filter;
+    pPage->mUsedArea = 0;
+
+    // Start with a flat skyline.
+    SkylineNode node;
+    node.mX = 0;
+    node.mY = 0;
+    node.mWidth = mPageSize;
+    pPage->mSkyline.push_back( node );
+
+    // Register the page texture.  The bitmap is kept so that entries can be added and the page can be repacked.
+    pPage->mTexture.set( TextureManager::getUniqueTextureKey(), pBitmap, TextureHandle::BitmapKeepTexture, true );
+    pPage->mTexture.setFilter( filter );
+
+    mPages.push_back( pPage );
+
+    return pPage;
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureAtlas::destroyPage( AtlasPage* pPage )
+{
+    // Remove the page.
+    for ( S32 pageIndex = 0; pageIndex < mPages.size(); ++pageIndex )
+    {
+        if ( mPages[pageIndex] == pPage )
+        {
+            mPages.erase( pageIndex );
+            break;
+        }
+    }
+
+    // Delete any remaining entries.
+    for ( S32 entryIndex = 0; entryIndex < pPage->mEntries.size(); ++entryIndex )
+    {
+        delete pPage->mEntries[entryIndex];
+    }
+
+    // Release the texture.  The texture manager owns the bitmap.
+    pPage->mTexture.clear();
+
+    delete pPage;
+}
+
+//-----------------------------------------------------------------------------
+
+bool TextureAtlas::findSkylinePosition( const Vector<SkylineNode>& skyline, const S32 width, const S32 height, S32& positionX, S32& positionY, S32& nodeIndex )
+{
+    S32 bestBottom = S32_MAX;
+    S32 bestWidth = S32_MAX;
+    nodeIndex = -1;
+
+    for ( S32 index = 0; index < skyline.size(); ++index )
+    {
+        const S32 x = skyline[index].mX;
+
+        // Skip if the area runs off the page.
+        if ( x + width > mPageSize )
+            break;
+
+        // Find the highest level under the area.
+        S32 y = 0;
+        S32 widthLeft = width;
+        S32 probe = index;
+        while ( widthLeft > 0 )
+        {
+            y = getMax( y, skyline[probe].mY );
+            widthLeft -= skyline[probe].mWidth;
+            probe++;
+        }
+
+        // Skip if the area runs off the page.
+        if ( y + height > mPageSize )
+            continue;
+
+        // Choose the lowest position then the tightest level.
+        const S32 bottom = y + height;
+        if ( bottom < bestBottom || (bottom == bestBottom && skyline[index].mWidth < bestWidth) )
+        {
+            bestBottom = bottom;
+            bestWidth = skyline[index].mWidth;
+            positionX = x;
+            positionY = y;
+            nodeIndex = index;
+        }
+    }
+
+    return nodeIndex != -1;
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureAtlas::addSkylineLevel( Vector<SkylineNode>& skyline, const S32 nodeIndex, const S32 positionX, const S32 positionY, const S32 width, const S32 height )
+{
+    // Insert the new level.
+    SkylineNode node;
+    node.mX = positionX;
+    node.mY = positionY + height;
+    node.mWidth = width;
+    skyline.insert( nodeIndex );
+    skyline[nodeIndex] = node;
+
+    // Trim the levels now covered by the new level.
+    for ( S32 index = nodeIndex + 1; index < skyline.size(); ++index )
+    {
+        const SkylineNode& previous = skyline[index-1];
+        SkylineNode& current = skyline[index];
+
+        // Finish if not covered.
+        if ( current.mX >= previous.mX + previous.mWidth )
+            break;
+
+        const S32 shrink = previous.mX + previous.mWidth - current.mX;
+        current.mX += shrink;
+        current.mWidth -= shrink;
+
+        // Stop if partially covered.
+        if ( current.mWidth > 0 )
+            break;
+
+        skyline.erase( index );
+        --index;
+    }
+
+    // Merge adjacent levels at the same height.
+    for ( S32 index = 0; index < skyline.size() - 1; ++index )
+    {
+        if ( skyline[index].mY == skyline[index+1].mY )
+        {
+            skyline[index].mWidth += skyline[index+1].mWidth;
+            skyline.erase( index+1 );
+            --index;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+bool TextureAtlas::insertIntoPage( AtlasPage* pPage, const S32 width, const S32 height, Point2I& offset )
+{
+    S32 positionX, positionY, nodeIndex;
+
+    // Finish if there is no space.
+    if ( !findSkylinePosition( pPage->mSkyline, width, height, positionX, positionY, nodeIndex ) )
+        return false;
+
+    addSkylineLevel( pPage->mSkyline, nodeIndex, positionX, positionY, width, height );
+
+    pPage->mUsedArea += width * height;
+    offset.set( positionX, positionY );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool TextureAtlas::repackPage( AtlasPage* pPage, const S32 width, const S32 height, Point2I& offset )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TextureAtlas_RepackPage);
+
+    // Finish if there is not enough free area.
+    if ( (mPageSize * mPageSize) - pPage->mUsedArea < width * height )
+        return false;
+
+    // Gather the live entries and the new area.
+    Vector<AtlasPackItem> packItems;
+    packItems.reserve( pPage->mEntries.size() + 1 );
+    for ( S32 entryIndex = 0; entryIndex < pPage->mEntries.size(); ++entryIndex )
+    {
+        AtlasEntry* pEntry = pPage->mEntries[entryIndex];
+
+        AtlasPackItem packItem;
+        packItem.mpEntry = pEntry;
+        packItem.mWidth = pEntry->mSize.x + (ENTRY_PADDING * 2);
+        packItem.mHeight = pEntry->mSize.y + (ENTRY_PADDING * 2);
+        packItems.push_back( packItem );
+    }
+
+    AtlasPackItem newItem;
+    newItem.mpEntry = NULL;
+    newItem.mWidth = width;
+    newItem.mHeight = height;
+    packItems.push_back( newItem );
+
+    // Pack the tallest areas first.
+    dQsort( packItems.address(), packItems.size(), sizeof(AtlasPackItem), sortPackItems );
+
+    Vector<SkylineNode> skyline;
+    SkylineNode node;
+    node.mX = 0;
+    node.mY = 0;
+    node.mWidth = mPageSize;
+    skyline.push_back( node );
+
+    for ( S32 itemIndex = 0; itemIndex < packItems.size(); ++itemIndex )
+    {
+        AtlasPackItem& packItem = packItems[itemIndex];
+
+        S32 positionX, positionY, nodeIndex;
+
+        // Finish if the page cannot hold everything.
+        if ( !findSkylinePosition( skyline, packItem.mWidth, packItem.mHeight, positionX, positionY, nodeIndex ) )
+            return false;
+
+        addSkylineLevel( skyline, nodeIndex, positionX, positionY, packItem.mWidth, packItem.mHeight );
+        packItem.mPosition.set( positionX, positionY );
+    }
+
+    // Move the live entries into a new page bitmap.
+    GBitmap* pSourceBitmap = pPage->mpBitmap;
+    GBitmap* pBitmap = new GBitmap( mPageSize, mPageSize, false, GBitmap::RGBA );
+    dMemset( pBitmap->getWritableBits(), 0, pBitmap->byteSize );
+
+    Vector<AtlasEntry*> relocatedEntries;
+    for ( S32 itemIndex = 0; itemIndex < packItems.size(); ++itemIndex )
+    {
+        const AtlasPackItem& packItem = packItems[itemIndex];
+
+        // Is this the new area?
+        if ( packItem.mpEntry == NULL )
+        {
+            // Yes, so return its position.
+            offset = packItem.mPosition;
+            continue;
+        }
+
+        AtlasEntry* pEntry = packItem.mpEntry;
+        const Point2I sourcePosition( pEntry->mOffset.x - ENTRY_PADDING, pEntry->mOffset.y - ENTRY_PADDING );
+        const S32 rowBytes = packItem.mWidth * pBitmap->bytesPerPixel;
+
+        for ( S32 row = 0; row < packItem.mHeight; ++row )
+        {
+            dMemcpy( pBitmap->getAddress( packItem.mPosition.x, packItem.mPosition.y + row ), pSourceBitmap->getAddress( sourcePosition.x, sourcePosition.y + row ), rowBytes );
+        }
+
+        // Note the entry if it has moved.
+        if ( sourcePosition != packItem.mPosition )
+        {
+            pEntry->mOffset.set( packItem.mPosition.x + ENTRY_PADDING, packItem.mPosition.y + ENTRY_PADDING );
+            relocatedEntries.push_back( pEntry );
+        }
+    }
+
+    // Update the page.
+    pPage->mSkyline = skyline;
+    pPage->mUsedArea += width * height;
+    pPage->mpBitmap = pBitmap;
+
+    // Replace the page bitmap.  This releases the previous bitmap and uploads the new one.
+    pPage->mTexture.set( pPage->mTexture.getTextureKey(), pBitmap, TextureHandle::BitmapKeepTexture, true );
+    pPage->mTexture.setFilter( pPage->mFilter );
+
+    // Notify the owners of any moved entries.
+    for ( S32 entryIndex = 0; entryIndex < relocatedEntries.size(); ++entryIndex )
+    {
+        AtlasEntry* pEntry = relocatedEntries[entryIndex];
+
+        if ( pEntry->mpRelocatedCallback != NULL )
+            pEntry->mpRelocatedCallback( pEntry->mpUserData );
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureAtlas::copyBitmap( GBitmap* pPageBitmap, const GBitmap* pBitmap, const Point2I& offset )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TextureAtlas_CopyBitmap);
+
+    const S32 width = pBitmap->getWidth();
+    const S32 height = pBitmap->getHeight();
+    const GBitmap::BitmapFormat format = pBitmap->getFormat();
+
+    // Copy the bitmap including the extruded border.
+    for ( S32 y = -ENTRY_PADDING; y < height + ENTRY_PADDING; ++y )
+    {
+        const S32 sourceY = mClamp( y, 0, height - 1 );
+        U8* pDest = pPageBitmap->getAddress( offset.x - ENTRY_PADDING, offset.y + y );
+
+        for ( S32 x = -ENTRY_PADDING; x < width + ENTRY_PADDING; ++x )
+        {
+            const S32 sourceX = mClamp( x, 0, width - 1 );
+            const U8* pSource = pBitmap->getAddress( sourceX, sourceY );
+
+            switch( format )
+            {
+                case GBitmap::RGBA:
+                    pDest[0] = pSource[0]; pDest[1] = pSource[1]; pDest[2] = pSource[2]; pDest[3] = pSource[3];
+                    break;
+
+                case GBitmap::RGB:
+                    pDest[0] = pSource[0]; pDest[1] = pSource[1]; pDest[2] = pSource[2]; pDest[3] = 255;
+                    break;
+
+                case GBitmap::Alpha:
+                    pDest[0] = 255; pDest[1] = 255; pDest[2] = 255; pDest[3] = pSource[0];
+                    break;
+
+                case GBitmap::Luminance:
+                    pDest[0] = pSource[0]; pDest[1] = pSource[0]; pDest[2] = pSource[0]; pDest[3] = 255;
+                    break;
+
+                case GBitmap::LuminanceAlpha:
+                    pDest[0] = pSource[0]; pDest[1] = pSource[0]; pDest[2] = pSource[0]; pDest[3] = pSource[1];
+                    break;
+
+                default:
+                    break;
+            }
+
+            pDest += 4;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureAtlas::uploadRegion( AtlasPage* pPage, const Point2I& offset, const Point2I& size )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TextureAtlas_UploadRegion);
+
+    // Finish if rendering is not available.
+    if ( !TextureManager::mDGLRender || pPage->mTexture.getGLName() == 0 )
+        return;
+
+    // Refresh the whole page if sub-image updates are disabled.
+    if ( TextureManager::mDisableTextureSubImageUpdates )
+    {
+        pPage->mTexture.refresh();
+        return;
+    }
+
+    // Gather the region rows.
+    const S32 rowBytes = size.x * 4;
+    atlasUploadBuffer.setSize( rowBytes * size.y );
+    for ( S32 row = 0; row < size.y; ++row )
+    {
+        dMemcpy( atlasUploadBuffer.address() + (row * rowBytes), pPage->mpBitmap->getAddress( offset.x, offset.y + row ), rowBytes );
+    }
+
+    // Upload the region.
+    glBindTexture( GL_TEXTURE_2D, pPage->mTexture.getGLName() );
+    glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+    glTexSubImage2D( GL_TEXTURE_2D, 0, offset.x, offset.y, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, atlasUploadBuffer.address() );
+    glPixelStorei( GL_UNPACK_ALIGNMENT, 4 );
+}
@@ -0,0 +1,157 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _TEXTURE_ATLAS_H_
+#define _TEXTURE_ATLAS_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+#ifndef _MPOINT_H_
+#include "math/mPoint.h"
+#endif
+
+#ifndef _TEXTURE_HANDLE_H_
+#include "graphics/TextureHandle.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+class GBitmap;
+
+//-----------------------------------------------------------------------------
+
+/// Runtime texture atlas.
+///
+/// Small bitmaps are packed into shared pages so that they can be rendered from a
+/// single texture.  Pages are keyed by their filter and use a skyline packer.  Each
+/// packed bitmap is surrounded by an extruded border so that filtering never samples
+/// a neighbour.  When a bitmap does not fit, a page with enough reclaimable space is
+/// repacked in place and the owners of any moved entries are notified.
+class TextureAtlas
+{
+public:
+    /// Called when an entry has been moved within its page.
+    typedef void (*EntryRelocatedCallback)( void* pUserData );
+
+    /// Extruded border around each packed bitmap.
+    static const S32 ENTRY_PADDING = 1;
+
+private:
+    class AtlasPage;
+
+public:
+    /// Packed bitmap.
+    class AtlasEntry
+    {
+        friend class TextureAtlas;
+
+    public:
+        inline StringTableEntry getTextureKey( void ) const     { return mTextureKey; }
+        inline GLuint getFilter( void ) const                   { return mFilter; }
+        inline TextureHandle& getTexture( void ) const;
+        inline const Point2I& getOffset( void ) const           { return mOffset; }
+        inline const Point2I& getSize( void ) const             { return mSize; }
+
+    private:
+        AtlasPage*              mpPage;
+        StringTableEntry        mTextureKey;
+        GLuint                  mFilter;
+        Point2I                 mOffset;
+        Point2I                 mSize;
+        EntryRelocatedCallback  mpRelocatedCallback;
+        void*                   mpUserData;
+    };
+
+private:
+    /// Skyline segment.
+    struct SkylineNode
+    {
+        S32 mX;
+        S32 mY;
+        S32 mWidth;
+    };
+
+    /// Atlas page.
+    class AtlasPage
+    {
+    public:
+        TextureHandle           mTexture;
+        GBitmap*                mpBitmap;
+        GLuint                  mFilter;
+        S32                     mUsedArea;
+        Vector<SkylineNode>     mSkyline;
+        Vector<AtlasEntry*>     mEntries;
+    };
+
+    typedef Vector<AtlasPage*> typePageVector;
+
+    static typePageVector   mPages;
+    static S32              mPageSize;
+    static bool             mCreated;
+
+public:
+    static void create();
+    static void destroy();
+
+    /// Acquire the texture for the specified key.
+    /// If the bitmap is no larger than the maximum entry size it is packed and the entry returned.
+    /// Otherwise the bitmap is registered as a standalone texture and NULL is returned.
+    /// Returns false if the texture is already resident or cannot be loaded, leaving the handle untouched.
+    static bool acquire( const char* pTextureKey, const GLuint filter, const S32 maximumEntrySize, TextureHandle& textureHandle, AtlasEntry*& pEntry, EntryRelocatedCallback pRelocatedCallback, void* pUserData );
+
+    /// Release a packed entry.
+    static void release( AtlasEntry* pEntry );
+
+    static inline S32 getPageSize( void ) { return mPageSize; }
+    static inline S32 getMaximumEntrySize( void ) { return (mPageSize / 2) - (ENTRY_PADDING * 2); }
+
+    static void dumpMetrics( void );
+
+private:
+    static bool isFormatSupported( const GBitmap* pBitmap );
+    static AtlasPage* createPage( const GLuint filter );
+    static void destroyPage( AtlasPage* pPage );
+
+    static bool findSkylinePosition( const Vector<SkylineNode>& skyline, const S32 width, const S32 height, S32& positionX, S32& positionY, S32& nodeIndex );
+    static void addSkylineLevel( Vector<SkylineNode>& skyline, const S32 nodeIndex, const S32 positionX, const S32 positionY, const S32 width, const S32 height );
+    static bool insertIntoPage( AtlasPage* pPage, const S32 width, const S32 height, Point2I& offset );
+    static bool repackPage( AtlasPage* pPage, const S32 width, const S32 height, Point2I& offset );
+
+    static void copyBitmap( GBitmap* pPageBitmap, const GBitmap* pBitmap, const Point2I& offset );
+    static void uploadRegion( AtlasPage* pPage, const Point2I& offset, const Point2I& size );
+};
+
+//-----------------------------------------------------------------------------
+
+inline TextureHandle& TextureAtlas::AtlasEntry::getTexture( void ) const
+{
+    return mpPage->mTexture;
+}
+
+#endif // _TEXTURE_ATLAS_H_
@@ -28,6 +28,8 @@
 #include "collection/vector.h"
 #include "io/resource/resourceManager.h"
 #include "graphics/gBitmap.h"
+#include "graphics/TextureAtlas.h"
+#include "graphics/dgl.h"
 #include "console/console.h"
 #include "console/consoleInternal.h"
 #include "console/consoleTypes.h"
@@ -152,6 +154,9 @@ void TextureManager::create()
 
     TextureDictionary::create();
 
+    // Create the texture atlas.
+    TextureAtlas::create();
+
     Con::addVariable("$pref::OpenGL::force16BitTexture", TypeBool, &TextureManager::mForce16BitTexture);
     Con::addVariable("$pref::OpenGL::allowTextureCompression", TypeBool, &TextureManager::mAllowTextureCompression);
     Con::addVariable("$pref::OpenGL::disableTextureSubImageUpdates", TypeBool, &TextureManager::mDisableTextureSubImageUpdates);
@@ -166,6 +171,9 @@ void TextureManager::destroy()
 {
     AssertISV(mManagerState != NotInitialized, "TextureManager::destroy - nothing to destroy!");
 
+    // Destroy the texture atlas.
+    TextureAtlas::destroy();
+
     // Destroy the texture dictionary.
     TextureDictionary::destroy();
 
@@ -216,6 +224,7 @@ void TextureManager::killManager()
     }
 
     // Delete all textures.
+    dglFlushBatch();
     glDeleteTextures(deleteNames.size(), deleteNames.address());
 }
 
@@ -354,6 +363,8 @@ void TextureManager::freeTexture( TextureObject* pTextureObject )
 {
     if((mDGLRender || mManagerState == Resurrecting) && pTextureObject->mGLTextureName)
     {
+        // Pending batched draws may still reference the texture.
+        dglFlushBatch();
         glDeleteTextures(1, (const GLuint*)&pTextureObject->mGLTextureName);
 
         // Adjust metrics.
@@ -802,6 +813,7 @@ TextureObject* TextureManager::registerTexture(const char* pTextureKey, GBitmap*
         // Remove any texture name.
         if ( pTextureObject->mGLTextureName != 0 )
         {
+            dglFlushBatch();
             glDeleteTextures(1, (const GLuint*)&pTextureObject->mGLTextureName);
             pTextureObject->mGLTextureName = 0;
 
@@ -49,6 +49,8 @@ class TextureManager
 {
    friend class TextureHandle;
    friend class TextureDictionary;
+   friend class TextureAtlas;
+   friend class GFont;
 
 public:
     /// Texture manager event codes.
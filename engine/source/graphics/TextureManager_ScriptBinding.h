@@ -72,4 +72,13 @@ ConsoleFunctionWithDocs( dumpTextureManagerMetrics, ConsoleVoid, 1, 1, ())
     return TextureManager::dumpMetrics();
 }
 
+//--------------------------------------------------------------------------------------------------------------------
+
+/*! Dump the texture atlas metrics.
+*/
+ConsoleFunctionWithDocs( dumpTextureAtlasMetrics, ConsoleVoid, 1, 1, ())
+{
+    TextureAtlas::dumpMetrics();
+}
+
 /*! @} */ // group TextureManagerFunctions
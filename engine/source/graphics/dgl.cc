@@ -32,6 +32,7 @@
 #include "memory/frameAllocator.h"
 #include "debug/profiler.h"
 #include "string/unicode.h"
+#include "collection/vector.h"
 
 #include "dglMac_ScriptBinding.h"
 #include "dgl_ScriptBinding.h"
@@ -45,8 +46,278 @@ ColorI sg_textAnchorColor(255, 255, 255, 255);
 ColorI sg_stackColor(255, 255, 255, 255);
 RectI sgCurrentClipRect;
 
+struct BatchVertex
+{
+   Point2F p;
+   Point2F t;
+   ColorI c;
+};
+
+/// Upper bound on pending vertices before the batch is drawn.
+const U32 BATCH_MAX_VERTICES = 4096 * 6;
+
+Vector<BatchVertex> sgBatchVertices;
+GLuint sgBatchTexture = 0;
+RectI sgBatchBounds;
+bool sgBatchActive = false;
+U32 sgBatchSuspendCount = 0;
+DGLBatchStats sgBatchStats = { 0, 0, 0 };
+DGLBatchStats sgLastBatchStats = { 0, 0, 0 };
+
+/// Sets up the orthographic projection and viewport for a clip rect.
+void applyClipRect(const RectI &clipRect)
+{
+   glMatrixMode(GL_PROJECTION);
+   glLoadIdentity();
+
+   U32 screenHeight = Platform::getWindowSize().y;
+
+#if defined(TORQUE_OS_IOS) || defined(TORQUE_OS_ANDROID)
+   glOrthof(clipRect.point.x, clipRect.point.x + clipRect.extent.x,
+           clipRect.extent.y, 0,
+           0, 1);
+#else
+   glOrtho(clipRect.point.x, clipRect.point.x + clipRect.extent.x,
+           clipRect.extent.y, 0,
+           0, 1);
+#endif
+
+   glTranslatef(0.0f, (F32)-clipRect.point.y, 0.0f);
+
+   glMatrixMode(GL_MODELVIEW);
+   glLoadIdentity();
+
+   glViewport(clipRect.point.x, screenHeight - (clipRect.point.y + clipRect.extent.y),
+              clipRect.extent.x, clipRect.extent.y);
+}
+
+inline bool isBatching()
+{
+   return sgBatchActive && sgBatchSuspendCount == 0;
+}
+
+/// Reserves vertices for a draw with the given texture, drawing the pending batch if the texture changes.
+BatchVertex* reserveBatchVertices(const GLuint texture, const U32 count)
+{
+   if (!sgBatchVertices.empty() && (texture != sgBatchTexture || sgBatchVertices.size() + count > BATCH_MAX_VERTICES))
+      dglFlushBatch();
+
+   if (sgBatchVertices.empty())
+   {
+      sgBatchTexture = texture;
+      sgBatchBounds = sgCurrentClipRect;
+   }
+   else if (!sgBatchBounds.contains(sgCurrentClipRect))
+   {
+      sgBatchBounds.unionRects(sgCurrentClipRect);
+   }
+
+   const U32 start = sgBatchVertices.size();
+   sgBatchVertices.setSize(start + count);
+   sgBatchStats.mQuads += count / 6;
+
+   return sgBatchVertices.address() + start;
+}
+
+/// Batches a quad given as top-left, top-right, bottom-left and bottom-right corners.
+void batchQuad(const GLuint texture, const Point2F* points, const Point2F* texels, const ColorI &color)
+{
+   static const U32 order[6] = { 0, 1, 2, 2, 1, 3 };
+
+   BatchVertex* pVertex = reserveBatchVertices(texture, 6);
+   for (U32 i = 0; i < 6; ++i, ++pVertex)
+   {
+      pVertex->p = points[order[i]];
+      pVertex->t = texels[order[i]];
+      pVertex->c = color;
+   }
+}
+
+/// Batches an axis-aligned rectangle clipped against the current clip rect.
+void batchRect(const GLuint texture, F32 left, F32 top, F32 right, F32 bottom,
+               F32 texLeft, F32 texTop, F32 texRight, F32 texBottom, const ColorI &color)
+{
+   const F32 clipLeft = (F32)sgCurrentClipRect.point.x;
+   const F32 clipTop = (F32)sgCurrentClipRect.point.y;
+   const F32 clipRight = (F32)(sgCurrentClipRect.point.x + sgCurrentClipRect.extent.x);
+   const F32 clipBottom = (F32)(sgCurrentClipRect.point.y + sgCurrentClipRect.extent.y);
+
+   if (right <= left || bottom <= top ||
+       left >= clipRight || right <= clipLeft || top >= clipBottom || bottom <= clipTop)
+      return;
+
+   // Clip the edges, interpolating the texture coordinates.
+   if (left < clipLeft)
+   {
+      texLeft += (texRight - texLeft) * (clipLeft - left) / (right - left);
+      left = clipLeft;
+   }
+   if (right > clipRight)
+   {
+      texRight -= (texRight - texLeft) * (right - clipRight) / (right - left);
+      right = clipRight;
+   }
+   if (top < clipTop)
+   {
+      texTop += (texBottom - texTop) * (clipTop - top) / (bottom - top);
+      top = clipTop;
+   }
+   if (bottom > clipBottom)
+   {
+      texBottom -= (texBottom - texTop) * (bottom - clipBottom) / (bottom - top);
+      bottom = clipBottom;
+   }
+
+   const Point2F points[4] = { Point2F(left, top), Point2F(right, top), Point2F(left, bottom), Point2F(right, bottom) };
+   const Point2F texels[4] = { Point2F(texLeft, texTop), Point2F(texRight, texTop), Point2F(texLeft, texBottom), Point2F(texRight, texBottom) };
+   batchQuad(texture, points, texels, color);
+}
+
+/// Batches a cached text run at the draw point and returns its advance.
+U32 batchTextRun(GFont* font, const Point2I &ptDraw, const GFont::TextRun* pRun)
+{
+   const F32 x = (F32)ptDraw.x;
+   const F32 y = (F32)ptDraw.y;
+
+   S32 sheet = -1;
+   GLuint texture = 0;
+   for (S32 i = 0; i < pRun->mGlyphs.size(); ++i)
+   {
+      const GFont::RunGlyph& glyph = pRun->mGlyphs[i];
+      if (glyph.mSheet != sheet)
+      {
+         sheet = glyph.mSheet;
+         texture = font->getTextureHandle(sheet).getGLName();
+      }
+
+      batchRect(texture, x + glyph.mLeft, y + glyph.mTop, x + glyph.mRight, y + glyph.mBottom,
+                glyph.mTexLeft, glyph.mTexTop, glyph.mTexRight, glyph.mTexBottom, sg_bitmapModulation);
+   }
+
+   return (U32)pRun->mAdvance;
+}
+
+/// Returns true if the points lie within the current clip rect and so need no clipping.
+bool isInsideClipRect(const Point2F* points, const U32 count)
+{
+   const F32 clipLeft = (F32)sgCurrentClipRect.point.x;
+   const F32 clipTop = (F32)sgCurrentClipRect.point.y;
+   const F32 clipRight = (F32)(sgCurrentClipRect.point.x + sgCurrentClipRect.extent.x);
+   const F32 clipBottom = (F32)(sgCurrentClipRect.point.y + sgCurrentClipRect.extent.y);
+
+   for (U32 i = 0; i < count; ++i)
+   {
+      if (points[i].x < clipLeft || points[i].x > clipRight || points[i].y < clipTop || points[i].y > clipBottom)
+         return false;
+   }
+
+   return true;
+}
+
+/// Draws anything pending before an immediate draw.
+inline void beginImmediateDraw()
+{
+   if (isBatching())
+   {
+      dglFlushBatch();
+      sgBatchStats.mImmediateDraws++;
+   }
+}
+
 } // namespace {}
 
+//--------------------------------------------------------------------------
+void dglBeginBatch()
+{
+   dglFlushBatch();
+
+   sgBatchActive = true;
+   sgBatchSuspendCount = 0;
+   sgBatchStats.mDrawCalls = 0;
+   sgBatchStats.mQuads = 0;
+   sgBatchStats.mImmediateDraws = 0;
+}
+
+void dglEndBatch()
+{
+   dglFlushBatch();
+
+   sgBatchActive = false;
+   sgLastBatchStats = sgBatchStats;
+}
+
+bool dglIsBatching()
+{
+   return isBatching();
+}
+
+void dglFlushBatch()
+{
+   if (sgBatchVertices.empty())
+      return;
+
+   PROFILE_SCOPE(dglFlushBatch);
+
+   // Everything was clipped on submission so the viewport only needs to cover the batch.
+   const bool widenViewport = !sgCurrentClipRect.contains(sgBatchBounds);
+   if (widenViewport)
+      applyClipRect(sgBatchBounds);
+
+   glDisable(GL_LIGHTING);
+   glEnable(GL_BLEND);
+   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+   glEnableClientState(GL_VERTEX_ARRAY);
+   glVertexPointer(2, GL_FLOAT, sizeof(BatchVertex), &sgBatchVertices[0].p);
+   glEnableClientState(GL_COLOR_ARRAY);
+   glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(BatchVertex), &sgBatchVertices[0].c);
+
+   if (sgBatchTexture != 0)
+   {
+      glEnable(GL_TEXTURE_2D);
+      glBindTexture(GL_TEXTURE_2D, sgBatchTexture);
+      glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+      glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+      glTexCoordPointer(2, GL_FLOAT, sizeof(BatchVertex), &sgBatchVertices[0].t);
+   }
+   else
+   {
+      glDisable(GL_TEXTURE_2D);
+   }
+
+   glDrawArrays(GL_TRIANGLES, 0, sgBatchVertices.size());
+
+   glDisableClientState(GL_VERTEX_ARRAY);
+   glDisableClientState(GL_COLOR_ARRAY);
+   glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+   glDisable(GL_BLEND);
+   glDisable(GL_TEXTURE_2D);
+
+   if (widenViewport)
+      applyClipRect(sgCurrentClipRect);
+
+   sgBatchVertices.clear();
+   sgBatchStats.mDrawCalls++;
+}
+
+void dglSuspendBatch()
+{
+   dglFlushBatch();
+   sgBatchSuspendCount++;
+}
+
+void dglResumeBatch()
+{
+   AssertFatal(sgBatchSuspendCount > 0, "dglResumeBatch: batching was not suspended.");
+   if (sgBatchSuspendCount > 0)
+      sgBatchSuspendCount--;
+}
+
+const DGLBatchStats& dglGetBatchStats()
+{
+   return sgLastBatchStats;
+}
+
 
 //--------------------------------------------------------------------------
 void dglSetBitmapModulation(const ColorF& in_rColor)
@@ -94,27 +365,6 @@ void dglDrawBitmapStretchSR(TextureObject* texture,
    AssertFatal(srcRect.isValidRect() == true,
                "GSurface::drawBitmapStretchSR: routines assume normal rects");
 
-   glDisable(GL_LIGHTING);
-
-   glEnable(GL_TEXTURE_2D);
-   glBindTexture(GL_TEXTURE_2D, texture->getGLTextureName());
-   //glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-
-   if (bSilhouette)
-   {
-      glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_BLEND);
-   
-      ColorF kModulationColor;
-      dglGetBitmapModulation(&kModulationColor);
-      glTexEnvfv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, kModulationColor.address());
-   }
-   else
-   {
-      glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-   }
-   glEnable(GL_BLEND);
-   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
    F32 texLeft   = F32(srcRect.point.x)                    / F32(texture->getTextureWidth());
    F32 texRight  = F32(srcRect.point.x + srcRect.extent.x) / F32(texture->getTextureWidth());
    F32 texTop    = F32(srcRect.point.y)                    / F32(texture->getTextureHeight());
@@ -172,6 +422,48 @@ void dglDrawBitmapStretchSR(TextureObject* texture,
       texBottom = temp;
    }
 
+   // Silhouettes need their own texture environment so are always drawn immediately.
+   if (isBatching() && !bSilhouette)
+   {
+      if (fSpin == 0.0f)
+      {
+         batchRect(texture->getGLTextureName(),
+                   scrPoints[0].x, scrPoints[0].y, scrPoints[3].x, scrPoints[3].y,
+                   texLeft, texTop, texRight, texBottom, sg_bitmapModulation);
+         return;
+      }
+
+      if (isInsideClipRect(scrPoints, 4))
+      {
+         const Point2F texels[4] = { Point2F(texLeft, texTop), Point2F(texRight, texTop), Point2F(texLeft, texBottom), Point2F(texRight, texBottom) };
+         batchQuad(texture->getGLTextureName(), scrPoints, texels, sg_bitmapModulation);
+         return;
+      }
+   }
+
+   beginImmediateDraw();
+
+   glDisable(GL_LIGHTING);
+
+   glEnable(GL_TEXTURE_2D);
+   glBindTexture(GL_TEXTURE_2D, texture->getGLTextureName());
+   //glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+
+   if (bSilhouette)
+   {
+      glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_BLEND);
+   
+      ColorF kModulationColor;
+      dglGetBitmapModulation(&kModulationColor);
+      glTexEnvfv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, kModulationColor.address());
+   }
+   else
+   {
+      glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+   }
+   glEnable(GL_BLEND);
+   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
    glColor4ub(sg_bitmapModulation.red,
              sg_bitmapModulation.green,
              sg_bitmapModulation.blue,
@@ -382,22 +674,38 @@ U32 dglDrawTextN(GFont*          font,
 
    currentColor      = sg_bitmapModulation;
 
-   FrameTemp<TextVertex> vert(4*n);
+   // Unrotated glyphs are clipped and appended to the batch.
+   const bool batching = isBatching() && rot == 0.0f;
 
-   glDisable(GL_LIGHTING);
+   // Plain strings reuse their cached layout.
+   if (batching)
+   {
+      const GFont::TextRun* pRun = font->getTextRun(in_string, n);
+      if (pRun != NULL)
+         return batchTextRun(font, ptDraw, pRun);
+   }
 
-   glEnable(GL_TEXTURE_2D);
-   glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-   glEnable(GL_BLEND);
+   FrameTemp<TextVertex> vert(batching ? 1 : 4*n);
+
+   if (!batching)
+   {
+      beginImmediateDraw();
 
-   //Luma: Optimise by setting states once before inner loop
-   glEnableClientState ( GL_VERTEX_ARRAY );
-   glEnableClientState ( GL_COLOR_ARRAY );
-   glEnableClientState ( GL_TEXTURE_COORD_ARRAY );
-   glVertexPointer     ( 2, GL_FLOAT, sizeof(TextVertex), &(vert[0].p) );
-   glColorPointer      ( 4, GL_UNSIGNED_BYTE, sizeof(TextVertex), &(vert[0].c) );
-   glTexCoordPointer   ( 2, GL_FLOAT, sizeof(TextVertex), &(vert[0].t) );
+      glDisable(GL_LIGHTING);
+
+      glEnable(GL_TEXTURE_2D);
+      glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+      glEnable(GL_BLEND);
+
+      //Luma: Optimise by setting states once before inner loop
+      glEnableClientState ( GL_VERTEX_ARRAY );
+      glEnableClientState ( GL_COLOR_ARRAY );
+      glEnableClientState ( GL_TEXTURE_COORD_ARRAY );
+      glVertexPointer     ( 2, GL_FLOAT, sizeof(TextVertex), &(vert[0].p) );
+      glColorPointer      ( 4, GL_UNSIGNED_BYTE, sizeof(TextVertex), &(vert[0].c) );
+      glTexCoordPointer   ( 2, GL_FLOAT, sizeof(TextVertex), &(vert[0].t) );
+   }
 
    // first build the point, color, and coord arrays
    U32 i;
@@ -520,6 +828,15 @@ U32 dglDrawTextN(GFont*          font,
          F32 screenTop    = pt.y;
          F32 screenBottom = pt.y + ci.height;
 
+         if (batching)
+         {
+            batchRect(lastTexture->getGLTextureName(),
+                      screenLeft + offset.x, screenTop + offset.y, screenRight + offset.x, screenBottom + offset.y,
+                      texLeft, texTop, texRight, texBottom, currentColor);
+            pt.x += ci.xIncrement - ci.xOrigin;
+            continue;
+         }
+
          points[0] = Point3F(screenLeft, screenTop, 0.0);
          points[1] = Point3F(screenRight,  screenTop, 0.0);
          points[2] = Point3F( screenLeft,  screenBottom, 0.0);
@@ -549,12 +866,15 @@ U32 dglDrawTextN(GFont*          font,
        }
    }
 
-   glDisableClientState ( GL_VERTEX_ARRAY );
-   glDisableClientState ( GL_COLOR_ARRAY );
-   glDisableClientState ( GL_TEXTURE_COORD_ARRAY );
+   if (!batching)
+   {
+      glDisableClientState ( GL_VERTEX_ARRAY );
+      glDisableClientState ( GL_COLOR_ARRAY );
+      glDisableClientState ( GL_TEXTURE_COORD_ARRAY );
 
-   glDisable(GL_BLEND);
-   glDisable(GL_TEXTURE_2D);
+      glDisable(GL_BLEND);
+      glDisable(GL_TEXTURE_2D);
+   }
 
    pt.x += ptDraw.x; // DAW: Account for the fact that we removed the drawing point from the text start at the beginning.
 
@@ -596,23 +916,42 @@ U32 dglDrawTextN(GFont*          font,
 
    currentColor      = sg_bitmapModulation;
 
-   FrameTemp<TextVertex> vert(4*n);
+   // Unrotated glyphs are clipped and appended to the batch.
+   const bool batching = isBatching() && rot == 0.0f;
 
-   glDisable(GL_LIGHTING);
+   // Plain strings reuse their cached layout.
+   if (batching)
+   {
+      const GFont::TextRun* pRun = font->getTextRun(in_string, n);
+      if (pRun != NULL)
+      {
+         PROFILE_END();
+         return batchTextRun(font, ptDraw, pRun);
+      }
+   }
 
-   glEnable(GL_TEXTURE_2D);
-   glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-   glEnable(GL_BLEND);
+   FrameTemp<TextVertex> vert(batching ? 1 : 4*n);
+
+   if (!batching)
+   {
+      beginImmediateDraw();
+
+      glDisable(GL_LIGHTING);
 
-   glEnableClientState ( GL_VERTEX_ARRAY );
-   glVertexPointer     ( 2, GL_FLOAT, sizeof(TextVertex), &(vert[0].p) );
+      glEnable(GL_TEXTURE_2D);
+      glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+      glEnable(GL_BLEND);
+
+      glEnableClientState ( GL_VERTEX_ARRAY );
+      glVertexPointer     ( 2, GL_FLOAT, sizeof(TextVertex), &(vert[0].p) );
 
-   glEnableClientState ( GL_COLOR_ARRAY );
-   glColorPointer      ( 4, GL_UNSIGNED_BYTE, sizeof(TextVertex), &(vert[0].c) );
+      glEnableClientState ( GL_COLOR_ARRAY );
+      glColorPointer      ( 4, GL_UNSIGNED_BYTE, sizeof(TextVertex), &(vert[0].c) );
 
-   glEnableClientState ( GL_TEXTURE_COORD_ARRAY );
-   glTexCoordPointer   ( 2, GL_FLOAT, sizeof(TextVertex), &(vert[0].t) );
+      glEnableClientState ( GL_TEXTURE_COORD_ARRAY );
+      glTexCoordPointer   ( 2, GL_FLOAT, sizeof(TextVertex), &(vert[0].t) );
+   }
 
    // first build the point, color, and coord arrays
    U32 i;
@@ -730,6 +1069,15 @@ U32 dglDrawTextN(GFont*          font,
          F32 screenTop    = (F32)pt.y;
          F32 screenBottom = (F32)(pt.y + ci.height);
 
+         if (batching)
+         {
+            batchRect(lastTexture->getGLTextureName(),
+                      screenLeft + offset.x, screenTop + offset.y, screenRight + offset.x, screenBottom + offset.y,
+                      texLeft, texTop, texRight, texBottom, currentColor);
+            pt.x += ci.xIncrement - ci.xOrigin;
+            continue;
+         }
+
          points[0] = Point3F(screenLeft, screenBottom, 0.0);
          points[1] = Point3F(screenRight,  screenBottom, 0.0);
          points[2] = Point3F( screenRight,  screenTop, 0.0);
@@ -756,12 +1104,15 @@ U32 dglDrawTextN(GFont*          font,
       glDrawArrays( GL_QUADS, 0, currentPt );
    }
 
-   glDisableClientState ( GL_VERTEX_ARRAY );
-   glDisableClientState ( GL_COLOR_ARRAY );
-   glDisableClientState ( GL_TEXTURE_COORD_ARRAY );
+   if (!batching)
+   {
+      glDisableClientState ( GL_VERTEX_ARRAY );
+      glDisableClientState ( GL_COLOR_ARRAY );
+      glDisableClientState ( GL_TEXTURE_COORD_ARRAY );
 
-   glDisable(GL_BLEND);
-   glDisable(GL_TEXTURE_2D);
+      glDisable(GL_BLEND);
+      glDisable(GL_TEXTURE_2D);
+   }
 
    pt.x += ptDraw.x; // DAW: Account for the fact that we removed the drawing point from the text start at the beginning.
 
@@ -777,6 +1128,8 @@ U32 dglDrawTextN(GFont*          font,
 
 void dglDrawLine(S32 x1, S32 y1, S32 x2, S32 y2, const ColorI &color)
 {
+   beginImmediateDraw();
+
    glEnable(GL_BLEND);
    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
    glDisable(GL_TEXTURE_2D);
@@ -809,6 +1162,21 @@ void dglDrawLine(const Point2I &startPt, const Point2I &endPt, const ColorI &col
 
 void dglDrawTriangleFill(const Point2I &pt1, const Point2I &pt2, const Point2I &pt3, const ColorI &color)
 {
+	if (isBatching())
+	{
+		const Point2F points[3] = { Point2F((F32)pt1.x, (F32)pt1.y), Point2F((F32)pt2.x, (F32)pt2.y), Point2F((F32)pt3.x, (F32)pt3.y) };
+		if (isInsideClipRect(points, 3))
+		{
+			// Submitted as a degenerate quad so the batch stays in whole quads.
+			const Point2F texels[4] = { Point2F(0.0f, 0.0f), Point2F(0.0f, 0.0f), Point2F(0.0f, 0.0f), Point2F(0.0f, 0.0f) };
+			const Point2F quad[4] = { points[0], points[1], points[2], points[2] };
+			batchQuad(0, quad, texels, color);
+			return;
+		}
+	}
+
+	beginImmediateDraw();
+
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	glDisable(GL_TEXTURE_2D);
@@ -836,6 +1204,8 @@ void dglDrawTriangleFill(const Point2I &pt1, const Point2I &pt2, const Point2I &
 
 void dglDrawRect(const Point2I &upperL, const Point2I &lowerR, const ColorI &color, const float &lineWidth)
 {
+   beginImmediateDraw();
+
    glEnable(GL_BLEND);
    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
    glDisable(GL_TEXTURE_2D);
@@ -877,6 +1247,13 @@ void dglDrawRect(const RectI &rect, const ColorI &color, const float &lineWidth)
 
 void dglDrawRectFill(const Point2I &upperL, const Point2I &lowerR, const ColorI &color)
 {
+   if (isBatching())
+   {
+      batchRect(0, (F32)getMin(upperL.x, lowerR.x), (F32)getMin(upperL.y, lowerR.y), (F32)getMax(upperL.x, lowerR.x), (F32)getMax(upperL.y, lowerR.y),
+                0.0f, 0.0f, 0.0f, 0.0f, color);
+      return;
+   }
+
    glEnable(GL_BLEND);
    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
    glDisable(GL_TEXTURE_2D);
@@ -907,6 +1284,20 @@ void dglDrawRectFill(const RectI &rect, const ColorI &color)
 //Start in the top left and move counter-clockwise around the quad.
 void dglDrawQuadFill(const Point2I &point1, const Point2I &point2, const Point2I &point3, const Point2I &point4, const ColorI &color)
 {
+	if (isBatching())
+	{
+		//Points 3 and 4 are switched by design.
+		const Point2F points[4] = { Point2F((F32)point1.x, (F32)point1.y), Point2F((F32)point2.x, (F32)point2.y), Point2F((F32)point4.x, (F32)point4.y), Point2F((F32)point3.x, (F32)point3.y) };
+		if (isInsideClipRect(points, 4))
+		{
+			const Point2F texels[4] = { Point2F(0.0f, 0.0f), Point2F(0.0f, 0.0f), Point2F(0.0f, 0.0f), Point2F(0.0f, 0.0f) };
+			batchQuad(0, points, texels, color);
+			return;
+		}
+	}
+
+	beginImmediateDraw();
+
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	glDisable(GL_TEXTURE_2D);
@@ -929,6 +1320,8 @@ void dglDrawQuadFill(const Point2I &point1, const Point2I &point2, const Point2I
 
 void dglDrawDot(const Point2F &screenPoint,const ColorI &color)
 {
+   beginImmediateDraw();
+
    glEnable(GL_BLEND);
    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
    glBegin(GL_POINTS);
@@ -940,6 +1333,8 @@ void dglDrawDot(const Point2F &screenPoint,const ColorI &color)
 
 void dglDraw2DSquare( const Point2F &screenPoint, F32 width, F32 spinAngle )
 {
+   beginImmediateDraw();
+
    width *= 0.5;
 
    MatrixF rotMatrix( EulerF( 0.0, 0.0, spinAngle ) );
@@ -1000,6 +1395,8 @@ void dglDraw2DSquare( const Point2F &screenPoint, F32 width, F32 spinAngle )
 
 void dglDrawBillboard( const Point3F &position, F32 width, F32 spinAngle )
 {
+   beginImmediateDraw();
+
    MatrixF modelview;
    dglGetModelview( &modelview );
    modelview.transpose();
@@ -1065,6 +1462,8 @@ void dglDrawBillboard( const Point3F &position, F32 width, F32 spinAngle )
 
 void dglWireCube(const Point3F & extent, const Point3F & center)
 {
+   beginImmediateDraw();
+
    static Point3F cubePoints[8] =
    {
       Point3F(-1, -1, -1), Point3F(-1, -1,  1), Point3F(-1,  1, -1), Point3F(-1,  1,  1),
@@ -1122,6 +1521,8 @@ void dglWireCube(const Point3F & extent, const Point3F & center)
 
 void dglSolidCube(const Point3F & extent, const Point3F & center)
 {
+   beginImmediateDraw();
+
    static Point3F cubePoints[8] =
    {
       Point3F(-1, -1, -1), Point3F(-1, -1,  1), Point3F(-1,  1, -1), Point3F(-1,  1,  1),
@@ -1179,6 +1580,8 @@ void dglSolidCube(const Point3F & extent, const Point3F & center)
 //http://slabode.exofire.net/circle_draw.shtml
 void dglDrawCircle(const Point2I &center, const F32 radius, const ColorI &color, const F32 &lineWidth)
 {
+	beginImmediateDraw();
+
 	F32 adjustedRadius = radius - (lineWidth/2);
 	const S32 num_segments = (const S32)round(10 * sqrtf(adjustedRadius));
 	F32 theta = 2 * 3.1415926f / F32(num_segments);
@@ -1219,6 +1622,8 @@ void dglDrawCircle(const Point2I &center, const F32 radius, const ColorI &color,
 
 void dglDrawCircleFill(const Point2I &center, const F32 radius, const ColorI &color)
 {
+	beginImmediateDraw();
+
 	const S32 num_segments = (const S32)round(10 * sqrtf(radius));
 	F32 theta = 2 * 3.1415926f / F32(num_segments);
 	F32 c = cosf(theta);//precalculate the sine and cosine
@@ -1258,28 +1663,8 @@ void dglDrawCircleFill(const Point2I &center, const F32 radius, const ColorI &co
 
 void dglSetClipRect(const RectI &clipRect)
 {
-   glMatrixMode(GL_PROJECTION);
-   glLoadIdentity();
-
-   U32 screenHeight = Platform::getWindowSize().y;
-
-#if defined(TORQUE_OS_IOS) || defined(TORQUE_OS_ANDROID)
-   glOrthof(clipRect.point.x, clipRect.point.x + clipRect.extent.x,
-           clipRect.extent.y, 0,
-           0, 1);
-#else
-   glOrtho(clipRect.point.x, clipRect.point.x + clipRect.extent.x,
-           clipRect.extent.y, 0,
-           0, 1);
-#endif
-
-   glTranslatef(0.0f, (F32)-clipRect.point.y, 0.0f);
-
-   glMatrixMode(GL_MODELVIEW);
-   glLoadIdentity();
-
-   glViewport(clipRect.point.x, screenHeight - (clipRect.point.y + clipRect.extent.y),
-              clipRect.extent.x, clipRect.extent.y);
+   // Batched draws are already clipped so changing the clip rect does not flush them.
+   applyClipRect(clipRect);
 
    sgCurrentClipRect = clipRect;
 }
@@ -1445,6 +1830,8 @@ bool dglIsInCanonicalState()
 
 void dglSetCanonicalState()
 {
+   dglFlushBatch();
+
 #if defined(TORQUE_OS_IOS) || defined(TORQUE_OS_ANDROID) || defined(TORQUE_OS_EMSCRIPTEN)
 // PUAP -Mat removed unsupported textureARB and Fog stuff
    glDisable(GL_BLEND);
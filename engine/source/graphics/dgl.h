@@ -272,6 +272,43 @@ void dglSetClipRect(const RectI &clipRect);
 const RectI& dglGetClipRect();
 /// @}
 
+// -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- //
+// Batching
+
+/// @defgroup dgl_batch Batching
+/// @ingroup dgl
+/// While batching, bitmaps, text and filled rectangles are clipped on the CPU and collected in
+/// submission order, then drawn together until the texture changes or another primitive needs the
+/// GL state.  Code issuing its own GL calls while batching must call dglFlushBatch() first.
+/// @{
+
+/// Batch counters for the last completed batch
+struct DGLBatchStats
+{
+   /// Draw calls issued for batched geometry
+   U32 mDrawCalls;
+   /// Quads and triangle pairs submitted to the batch
+   U32 mQuads;
+   /// Draws that could not be batched and were drawn immediately
+   U32 mImmediateDraws;
+};
+
+/// Starts collecting gui draws, usually once per frame by the canvas
+void dglBeginBatch();
+/// Draws anything pending and stops collecting
+void dglEndBatch();
+/// Returns true if draws are currently being collected
+bool dglIsBatching();
+/// Draws anything pending so the GL state can be used directly
+void dglFlushBatch();
+/// Draws anything pending and draws immediately until resumed, e.g. while rendering a scene in world coordinates
+void dglSuspendBatch();
+/// Resumes collecting after dglSuspendBatch()
+void dglResumeBatch();
+/// Returns the counters for the last completed batch
+const DGLBatchStats& dglGetBatchStats();
+/// @}
+
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- //
 // Misc
 /// Projects a point on the screen in 3d space into a point on the screen
@@ -42,6 +42,9 @@
 
 S32 GFont::smSheetIdCount = 0;
 const U32 GFont::csm_fileVersion = 3;
+Vector<GFont::GlyphSheet*> GFont::smSharedSheets;
+
+static Vector<U8> glyphUploadBuffer;
 
 static PlatformFont* createSafePlatformFont(const char *name, U32 size, U32 charset = TGE_ANSI_CHARSET)
 {
@@ -128,7 +131,6 @@ Resource<GFont> GFont::create(const char *faceName, U32 size, const char *cacheD
     
    GFont *resFont = new GFont;
    resFont->mPlatformFont = platFont;
-   resFont->addSheet();
    resFont->mGFTFile = StringTable->insert(buf);
    resFont->mFaceName = StringTable->insert(faceName);
    resFont->mSize = size;
@@ -149,9 +151,10 @@ GFont::GFont()
 {
    VECTOR_SET_ASSOCIATION(mCharInfoList);
    VECTOR_SET_ASSOCIATION(mTextureSheets);
+   VECTOR_SET_ASSOCIATION(mReferencedSheets);
 
-   for (U32 i = 0; i < (sizeof(mRemapTable) / sizeof(S32)); i++)
-      mRemapTable[i] = -1;
+   dMemset(mRemapPages, 0, sizeof(mRemapPages));
+   dMemset(mTextRuns, 0, sizeof(mTextRuns));
 
    mCurX = mCurY = mCurSheet = -1;
 
@@ -192,6 +195,10 @@ GFont::~GFont()
    {
        mTextureSheets[i] = 0;
    }
+
+   releaseSharedSheets();
+   clearRemap();
+   clearTextRuns();
    
    SAFE_DELETE(mPlatformFont);
    
@@ -201,10 +208,13 @@ GFont::~GFont()
 void GFont::dumpInfo()
 {
    // Number and extent of mapped characters?
-   U32 mapCount = 0, mapBegin=0xFFFF, mapEnd=0;
+   U32 mapCount = 0, mapBegin=0xFFFF, mapEnd=0, mapPages=0;
    for(U32 i=0; i<0x10000; i++)
    {
-      if(mRemapTable[i] != -1)
+      if(i % RemapPageSize == 0 && mRemapPages[i / RemapPageSize] != NULL)
+         mapPages++;
+
+      if(getRemap(i) != -1)
       {
          mapCount++;
          if(i<mapBegin) mapBegin = i;
@@ -215,7 +225,7 @@ void GFont::dumpInfo()
 
    // Let's write out all the info we can on this font.
    Con::printf("   '%s' %dpt", mFaceName, mSize);
-   Con::printf("      - %d texture sheets, %d mapped characters.", mTextureSheets.size(), mapCount);
+   Con::printf("      - %d texture sheets (%d shared), %d mapped characters in %d remap pages.", mTextureSheets.size(), mReferencedSheets.size(), mapCount, mapPages);
 
    if(mapCount)
       Con::printf("      - Codepoints range from 0x%x to 0x%x.", mapBegin, mapEnd);
@@ -228,7 +238,7 @@ void GFont::dumpInfo()
 
 bool GFont::loadCharInfo(const UTF16 ch)
 {
-    if(mRemapTable[ch] != -1)
+    if(getRemap(ch) != -1)
         return true;    // Not really an error
 
     if(mPlatformFont && mPlatformFont->isValidChar(ch))
@@ -239,7 +249,7 @@ bool GFont::loadCharInfo(const UTF16 ch)
             addBitmap(ci);
 
         mCharInfoList.push_back(ci);
-        mRemapTable[ch] = mCharInfoList.size() - 1;
+        setRemap(ch, mCharInfoList.size() - 1);
 //don't save UFTs on the iPhone or android device
 #if !defined(TORQUE_OS_IOS) && !defined(TORQUE_OS_ANDROID) && !defined(TORQUE_OS_EMSCRIPTEN)
         mNeedSave = true;
@@ -257,102 +267,260 @@ void GFont::addBitmap(PlatformFont::CharInfo &charInfo)
    // If this is called inside a glBegin - glEnd block, the texture will not be
    // updated properly.
 
-   U32 nextCurX = U32(mCurX + charInfo.width ); /*7) & ~0x3;*/
-   U32 nextCurY = U32(mCurY + mPlatformFont->getFontHeight()); // + 7) & ~0x3;
+   S32 offsetX, offsetY;
+   const S32 sheet = allocateSharedGlyph(charInfo.width, charInfo.height, offsetX, offsetY);
+
+   charInfo.bitmapIndex = sheet;
+   charInfo.xOffset = offsetX;
+   charInfo.yOffset = offsetY;
+
+   GBitmap *bmp = mTextureSheets[sheet].getBitmap();
+
+   AssertFatal(bmp, "GFont::addBitmap - null texture sheet bitmap!");
+   AssertFatal(bmp->getFormat() == GBitmap::Alpha, "GFont::addBitmap - cannot added characters to non-greyscale textures!");
+   
+   // [neo, 5/7/2007 - #3050]
+   // If we get large font sizes charInfo.height/width will be larger than the sheet
+   // and as GBitmap::getAddress() does no range checking the following will overrun memory! 
+   // Added checks against SharedSheetSize
+   const U32 copyWidth = getMin(charInfo.width, (U32)(SharedSheetSize - charInfo.xOffset));
+   const U32 copyHeight = getMin(charInfo.height, (U32)(SharedSheetSize - charInfo.yOffset));
+
+   for( U32 y = 0; y < copyHeight; y++ )
+      dMemcpy( bmp->getAddress( charInfo.xOffset, charInfo.yOffset + y ), charInfo.bitmapData + y * charInfo.width, copyWidth );
 
-   // These are here for postmortem debugging.
-   bool routeA = false, routeB = false;
+   if ( copyWidth == 0 || copyHeight == 0 )
+      return;
+
+   // Upload only the new glyph unless sub-image updates are disabled.
+   TextureHandle& texture = mTextureSheets[sheet];
+   if ( !TextureManager::mDGLRender || texture.getGLName() == 0 )
+      return;
 
-   if(mCurSheet == -1 || nextCurY >= TextureSheetSize)
+   if ( TextureManager::mDisableTextureSubImageUpdates )
    {
-      routeA = true;
-      addSheet();
+      texture.refresh();
+      return;
+   }
+
+   glyphUploadBuffer.setSize( copyWidth * copyHeight );
+   for( U32 y = 0; y < copyHeight; y++ )
+      dMemcpy( glyphUploadBuffer.address() + y * copyWidth, bmp->getAddress( charInfo.xOffset, charInfo.yOffset + y ), copyWidth );
+
+   glBindTexture( GL_TEXTURE_2D, texture.getGLName() );
+   glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+   glTexSubImage2D( GL_TEXTURE_2D, 0, charInfo.xOffset, charInfo.yOffset, copyWidth, copyHeight, GL_ALPHA, GL_UNSIGNED_BYTE, glyphUploadBuffer.address() );
+   glPixelStorei( GL_UNPACK_ALIGNMENT, 4 );
+}
 
-      // Recalc our nexts.
-      nextCurX = U32(mCurX + charInfo.width); // + 7) & ~0x3;
-      nextCurY = U32(mCurY + mPlatformFont->getFontHeight()); // + 7) & ~0x3;
+S32 GFont::allocateSharedGlyph(const U32 width, const U32 height, S32 &offsetX, S32 &offsetY)
+{
+   const S32 paddedWidth = getMin((S32)width + SharedSheetPadding, (S32)SharedSheetSize);
+   const S32 paddedHeight = getMin((S32)height + SharedSheetPadding, (S32)SharedSheetSize);
+
+   // Find a shelf no more than a quarter taller than the glyph, or room for a new shelf.
+   // Later sheets are tried first as they have the most space.
+   GlyphSheet* pSheet = NULL;
+   for(S32 i = smSharedSheets.size() - 1; i >= 0 && pSheet == NULL; i--)
+   {
+      GlyphSheet* pCandidate = smSharedSheets[i];
+
+      for(S32 j = 0; j < pCandidate->mShelves.size(); j++)
+      {
+         GlyphShelf& shelf = pCandidate->mShelves[j];
+         if(paddedHeight <= shelf.mHeight && shelf.mHeight <= paddedHeight + paddedHeight / 4 + 1 && shelf.mX + paddedWidth <= SharedSheetSize)
+         {
+            offsetX = shelf.mX;
+            offsetY = shelf.mY;
+            shelf.mX += paddedWidth;
+            pSheet = pCandidate;
+            break;
+         }
+      }
+
+      if(pSheet == NULL && pCandidate->mShelfBottom + paddedHeight <= SharedSheetSize)
+      {
+         GlyphShelf shelf;
+         shelf.mX = paddedWidth;
+         shelf.mY = pCandidate->mShelfBottom;
+         shelf.mHeight = paddedHeight;
+         pCandidate->mShelves.push_back(shelf);
+         pCandidate->mShelfBottom += paddedHeight;
+
+         offsetX = 0;
+         offsetY = shelf.mY;
+         pSheet = pCandidate;
+      }
    }
 
-   if( nextCurX >= TextureSheetSize)
+   // Start a new sheet if nothing had room.
+   if(pSheet == NULL)
    {
-      routeB = true;
-      mCurX = 0;
-      mCurY = nextCurY;
+      char buf[30];
+      dSprintf(buf, sizeof(buf), "fontsheet_%d", smSheetIdCount++);
+
+      GBitmap *bitmap = new GBitmap(SharedSheetSize, SharedSheetSize, false, GBitmap::Alpha);
+
+      // Set everything to transparent.
+      dMemset(bitmap->getWritableBits(), 0, sizeof(U8) * SharedSheetSize * SharedSheetSize);
+
+      pSheet = new GlyphSheet;
+      pSheet->mTexture = TextureHandle(buf, bitmap, TextureHandle::BitmapKeepTexture);
+      pSheet->mTexture.setFilter(GL_NEAREST);
+      pSheet->mReferences = 0;
+      pSheet->mShelfBottom = paddedHeight;
+
+      GlyphShelf shelf;
+      shelf.mX = paddedWidth;
+      shelf.mY = 0;
+      shelf.mHeight = paddedHeight;
+      pSheet->mShelves.push_back(shelf);
+
+      smSharedSheets.push_back(pSheet);
 
-      // Recalc our nexts.
-      nextCurX = U32(mCurX + charInfo.width); // + 7) & ~0x3;
-      nextCurY = U32(mCurY + mPlatformFont->getFontHeight()); // + 7) & ~0x3;
+      offsetX = 0;
+      offsetY = 0;
    }
 
-   // Check the Y once more - sometimes we advance to a new row and run off
-   // the end.
-   if(nextCurY >= TextureSheetSize)
+   // Fetch the sheet index for this font, referencing the sheet on first use.
+   TextureObject* pSheetTexture = pSheet->mTexture;
+   for(S32 i = mTextureSheets.size() - 1; i >= 0; i--)
    {
-      routeA = true;
-      addSheet();
+      if((TextureObject*)mTextureSheets[i] == pSheetTexture)
+         return i;
+   }
+
+   mTextureSheets.increment();
+   constructInPlace(&mTextureSheets.last());
+   mTextureSheets.last() = pSheet->mTexture;
+
+   pSheet->mReferences++;
+   mReferencedSheets.push_back(pSheet);
+
+   return mTextureSheets.size() - 1;
+}
+
+void GFont::releaseSharedSheets()
+{
+   for(S32 i = 0; i < mReferencedSheets.size(); i++)
+   {
+      GlyphSheet* pSheet = mReferencedSheets[i];
+      if(--pSheet->mReferences > 0)
+         continue;
+
+      for(S32 j = 0; j < smSharedSheets.size(); j++)
+      {
+         if(smSharedSheets[j] == pSheet)
+         {
+            smSharedSheets.erase(j);
+            break;
+         }
+      }
 
-      // Recalc our nexts.
-      nextCurX = U32(mCurX + charInfo.width); // + 7) & ~0x3;
-      nextCurY = U32(mCurY + mPlatformFont->getFontHeight()); // + 7) & ~0x3;
+      delete pSheet;
    }
 
-    charInfo.bitmapIndex = mCurSheet;
-    charInfo.xOffset = mCurX;
-    charInfo.yOffset = mCurY;
+   mReferencedSheets.clear();
+}
 
-   mCurX = nextCurX;
+void GFont::packGlyphSheets(Vector<PlatformFont::CharInfo> &charInfo, Vector<GBitmap*> &sheets)
+{
+   // Shared sheets also hold the glyphs of other fonts so only this font's glyphs are packed.
+   charInfo = mCharInfoList;
 
-   GBitmap *bmp = mTextureSheets[mCurSheet].getBitmap();
+   GBitmap *pSheet = NULL;
+   S32 curX = 0, curY = 0, rowHeight = 0;
 
-   AssertFatal(bmp, "GFont::addBitmap - null texture sheet bitmap!");
-   AssertFatal(bmp->getFormat() == GBitmap::Alpha, "GFont::addBitmap - cannot added characters to non-greyscale textures!");
-   
-   // [neo, 5/7/2007 - #3050]
-   // If we get large font sizes charInfo.height/width will be larger than TextureSheetSize
-   // and as GBitmap::getAddress() does no range checking the following will overrun memory! 
-   // Added checks against TextureSheetSize
-   for( U32 y = 0; y < charInfo.height; y++ )
+   for(S32 i = 0; i < charInfo.size(); i++)
    {
-      S32 dy = y + charInfo.yOffset;
+      PlatformFont::CharInfo &ci = charInfo[i];
+      if(ci.bitmapIndex == -1 || ci.width == 0 || ci.height == 0)
+         continue;
 
-      if( dy >= TextureSheetSize )
-         break;
+      GBitmap *pSource = mTextureSheets[ci.bitmapIndex].getBitmap();
+      AssertFatal(pSource && pSource->getFormat() == GBitmap::Alpha, "GFont::packGlyphSheets - glyph sheet is not greyscale!");
+
+      const S32 copyWidth = getMin((S32)ci.width, getMin((S32)pSource->getWidth() - (S32)ci.xOffset, (S32)SharedSheetSize));
+      const S32 copyHeight = getMin((S32)ci.height, getMin((S32)pSource->getHeight() - (S32)ci.yOffset, (S32)SharedSheetSize));
+      const S32 paddedWidth = getMin(copyWidth + SharedSheetPadding, (S32)SharedSheetSize);
+      const S32 paddedHeight = getMin(copyHeight + SharedSheetPadding, (S32)SharedSheetSize);
 
-      for( U32 x = 0; x < charInfo.width; x++ )
+      // Start a new row, then a new sheet, when out of room.
+      if(pSheet != NULL && curX + paddedWidth > SharedSheetSize)
       {
-         S32 dx = x + charInfo.xOffset;
-         
-         if( dx >= TextureSheetSize )
-            break;
+         curX = 0;
+         curY += rowHeight;
+         rowHeight = 0;
+      }
 
-         *bmp->getAddress( dx, dy ) = charInfo.bitmapData[ y * charInfo.width + x ];
+      if(pSheet == NULL || curY + paddedHeight > SharedSheetSize)
+      {
+         pSheet = new GBitmap(SharedSheetSize, SharedSheetSize, false, GBitmap::Alpha);
+         dMemset(pSheet->getWritableBits(), 0, sizeof(U8) * SharedSheetSize * SharedSheetSize);
+         sheets.push_back(pSheet);
+         curX = curY = rowHeight = 0;
       }
+
+      if(copyWidth > 0 && copyHeight > 0)
+         pSheet->copyRect(pSource, RectI(ci.xOffset, ci.yOffset, copyWidth, copyHeight), Point2I(curX, curY));
+
+      ci.bitmapIndex = sheets.size() - 1;
+      ci.xOffset = curX;
+      ci.yOffset = curY;
+
+      curX += paddedWidth;
+      rowHeight = getMax(rowHeight, paddedHeight);
    }
-   
-   mTextureSheets[mCurSheet].refresh();
 }
 
-void GFont::addSheet()
+void GFont::unpackGlyphSheets(Vector<GBitmap*> &sheets)
 {
-    char buf[30];
-    dSprintf(buf, sizeof(buf), "newfont_%d", smSheetIdCount++);
+   // Move the glyphs read from a file into the shared sheets.
+   for(S32 i = 0; i < mCharInfoList.size(); i++)
+   {
+      PlatformFont::CharInfo &ci = mCharInfoList[i];
+      if(ci.bitmapIndex < 0 || ci.bitmapIndex >= sheets.size() || ci.width == 0 || ci.height == 0)
+         continue;
 
-    GBitmap *bitmap = new GBitmap(TextureSheetSize, TextureSheetSize, false, GBitmap::Alpha);
+      GBitmap *pSource = sheets[ci.bitmapIndex];
+      const U32 copyWidth = getMin(ci.width, pSource->getWidth() > ci.xOffset ? pSource->getWidth() - ci.xOffset : 0);
+      const U32 copyHeight = getMin(ci.height, pSource->getHeight() > ci.yOffset ? pSource->getHeight() - ci.yOffset : 0);
 
-    // Set everything to transparent.
-    U8 *bits = bitmap->getWritableBits();
-    dMemset(bits, 0, sizeof(U8) *TextureSheetSize*TextureSheetSize);
+      FrameTemp<U8> glyphData(ci.width * ci.height);
+      dMemset(~glyphData, 0, ci.width * ci.height);
+      for(U32 y = 0; y < copyHeight; y++)
+         dMemcpy(~glyphData + y * ci.width, pSource->getAddress(ci.xOffset, ci.yOffset + y), copyWidth);
 
-    TextureHandle handle = TextureHandle(buf, bitmap, TextureHandle::BitmapKeepTexture);
-    handle.setFilter(GL_NEAREST);
+      ci.bitmapData = ~glyphData;
+      addBitmap(ci);
+      ci.bitmapData = NULL;
+   }
+}
 
-    mTextureSheets.increment();
-    constructInPlace(&mTextureSheets.last());
-    mTextureSheets.last() = handle;
+//////////////////////////////////////////////////////////////////////////
 
-    mCurX = 0;
-    mCurY = 0;
-    mCurSheet = mTextureSheets.size() - 1;
+void GFont::setRemap(const UTF16 ch, const S32 index)
+{
+   S32*& page = mRemapPages[ch / RemapPageSize];
+   if(page == NULL)
+   {
+      if(index == -1)
+         return;
+
+      page = new S32[RemapPageSize];
+      for(U32 i = 0; i < RemapPageSize; i++)
+         page[i] = -1;
+   }
+
+   page[ch % RemapPageSize] = index;
+}
+
+void GFont::clearRemap()
+{
+   for(U32 i = 0; i < RemapPageCount; i++)
+   {
+      SAFE_DELETE_ARRAY(mRemapPages[i]);
+   }
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -363,20 +531,22 @@ const PlatformFont::CharInfo &GFont::getCharInfo(const UTF16 in_charIndex)
 
    AssertFatal(in_charIndex, "GFont::getCharInfo - can't get info for char 0!");
 
-   if(mRemapTable[in_charIndex] == -1)
+   S32 index = getRemap(in_charIndex);
+   if(index == -1)
    {
       loadCharInfo(in_charIndex);
+      index = getRemap(in_charIndex);
    }
 
-   AssertFatal(mRemapTable[in_charIndex] != -1, "No remap info for this character");
+   AssertFatal(index != -1, "No remap info for this character");
 
    PROFILE_END();
 
    // if we still have no character info, return the default char info.
-   if(mRemapTable[in_charIndex] == -1)
+   if(index == -1)
       return getDefaultCharInfo();
    else
-      return mCharInfoList[mRemapTable[in_charIndex]];
+      return mCharInfoList[index];
 }
 
 const PlatformFont::CharInfo &GFont::getDefaultCharInfo()
@@ -388,6 +558,116 @@ const PlatformFont::CharInfo &GFont::getDefaultCharInfo()
 
 //////////////////////////////////////////////////////////////////////////
 
+const GFont::TextRun* GFont::getTextRun(const UTF16* string, U32 n)
+{
+   // Hash the string up to its terminator.
+   U32 hash = 2166136261u;
+   U32 length = 0;
+   while(length < n && string[length])
+   {
+      hash = (hash ^ string[length]) * 16777619u;
+      length++;
+   }
+
+   if(length == 0 || length > TextRunMaxLength)
+      return NULL;
+
+   TextRun*& pRun = mTextRuns[hash % TextRunCacheSize];
+   if(pRun && pRun->mHash == hash && pRun->mLength == length && dMemcmp(pRun->mpText, string, length * sizeof(UTF16)) == 0)
+      return pRun->mCacheable ? pRun : NULL;
+
+   PROFILE_SCOPE(GFont_BuildTextRun);
+
+   // Replace whatever run was in this slot.
+   if(pRun == NULL)
+      pRun = new TextRun;
+   else
+      delete [] pRun->mpText;
+
+   pRun->mHash = hash;
+   pRun->mLength = length;
+   pRun->mpText = new UTF16[length];
+   dMemcpy(pRun->mpText, string, length * sizeof(UTF16));
+   pRun->mCacheable = true;
+   pRun->mGlyphs.clear();
+
+   // Lay out the glyphs as dglDrawTextN does.
+   S32 x = 0;
+   for(U32 i = 0; i < length; i++)
+   {
+      const UTF16 c = string[i];
+
+      // Color codes and the color stack depend on the draw state.
+      if((c >= 1 && c <= 7) || (c >= 11 && c <= 12) || (c >= 14 && c <= 17))
+      {
+         pRun->mCacheable = false;
+         pRun->mGlyphs.clear();
+         return NULL;
+      }
+
+      if(c == dT('\t'))
+      {
+         x += getCharInfo(dT(' ')).xIncrement * TabWidthInSpaces;
+         continue;
+      }
+
+      if(!isValidChar(c))
+         continue;
+
+      const PlatformFont::CharInfo &ci = getCharInfo(c);
+
+      if(ci.bitmapIndex == -1)
+      {
+         x += ci.xOrigin + ci.xIncrement;
+         continue;
+      }
+
+      if(ci.width == 0 || ci.height == 0)
+      {
+         x += ci.xIncrement;
+         continue;
+      }
+
+      TextureObject* pTexture = mTextureSheets[ci.bitmapIndex];
+      const F32 textureWidth = F32(pTexture->getTextureWidth());
+      const F32 textureHeight = F32(pTexture->getTextureHeight());
+
+      const S32 top = (S32)getBaseline() - ci.yOrigin;
+      const S32 left = x + ci.xOrigin;
+
+      pRun->mGlyphs.increment();
+      RunGlyph& glyph = pRun->mGlyphs.last();
+      glyph.mSheet = ci.bitmapIndex;
+      glyph.mLeft = F32(left);
+      glyph.mTop = F32(top);
+      glyph.mRight = F32(left + (S32)ci.width);
+      glyph.mBottom = F32(top + (S32)ci.height);
+      glyph.mTexLeft = F32(ci.xOffset) / textureWidth;
+      glyph.mTexTop = F32(ci.yOffset) / textureHeight;
+      glyph.mTexRight = F32(ci.xOffset + ci.width) / textureWidth;
+      glyph.mTexBottom = F32(ci.yOffset + ci.height) / textureHeight;
+
+      x += ci.xIncrement;
+   }
+
+   pRun->mAdvance = x;
+   return pRun;
+}
+
+void GFont::clearTextRuns()
+{
+   for(U32 i = 0; i < TextRunCacheSize; i++)
+   {
+      if(mTextRuns[i] == NULL)
+         continue;
+
+      delete [] mTextRuns[i]->mpText;
+      SAFE_DELETE(mTextRuns[i]);
+   }
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 U32 GFont::getStrWidth(const UTF8* in_pString)
 {
    AssertFatal(in_pString != NULL, "GFont::getStrWidth: String is NULL, width is undefined");
@@ -650,23 +930,43 @@ bool GFont::read(Stream& io_rStream)
 
    U32 numSheets = 0;
    io_rStream.read(&numSheets);
-   
+
+   Vector<GBitmap*> sheets;
+   bool greyscale = true;
    for(i = 0; i < numSheets; i++)
    {
        GBitmap *bmp = new GBitmap;
        if(!bmp->readPNG(io_rStream))
        {
            delete bmp;
+           for(S32 j = 0; j < sheets.size(); j++)
+              delete sheets[j];
            return false;
        }
 
-       char buf[30];
-       dSprintf(buf, sizeof(buf), "font_%d", smSheetIdCount++);
+       greyscale &= bmp->getFormat() == GBitmap::Alpha;
+       sheets.push_back(bmp);
+   }
+
+   if(greyscale)
+   {
+       // Share the glyph sheets with the other fonts.
+       unpackGlyphSheets(sheets);
+       for(i = 0; i < (U32)sheets.size(); i++)
+          delete sheets[i];
+   }
+   else
+   {
+       for(i = 0; i < (U32)sheets.size(); i++)
+       {
+          char buf[30];
+          dSprintf(buf, sizeof(buf), "font_%d", smSheetIdCount++);
 
-       mTextureSheets.increment();
-       constructInPlace(&mTextureSheets.last());
-       mTextureSheets.last() = TextureHandle(buf, bmp, TextureHandle::BitmapKeepTexture);
-       mTextureSheets.last().setFilter(GL_NEAREST);
+          mTextureSheets.increment();
+          constructInPlace(&mTextureSheets.last());
+          mTextureSheets.last() = TextureHandle(buf, sheets[i], TextureHandle::BitmapKeepTexture);
+          mTextureSheets.last().setFilter(GL_NEAREST);
+       }
    }
    
    // Read last position info
@@ -690,17 +990,19 @@ bool GFont::read(Stream& io_rStream)
       io_rStream.read(buffLen, inBuff);
 
       // Decompress.
+      FrameTemp<S32> remap(maxGlyph-minGlyph+1);
       uLongf destLen = (maxGlyph-minGlyph+1)*sizeof(S32);
-      uncompress((Bytef*)&mRemapTable[minGlyph], &destLen, (Bytef*)(S32*)inBuff, buffLen);
+      uncompress((Bytef*)(S32*)remap, &destLen, (Bytef*)(S32*)inBuff, buffLen);
 
       AssertISV(destLen == (maxGlyph-minGlyph+1)*sizeof(S32), "GFont::read - invalid remap table data!");
 
       // Make sure we've got the right endianness.
       for(i = minGlyph; i <= maxGlyph; i++) {
-         mRemapTable[i] = convertBEndianToHost(mRemapTable[i]);
-         if( mRemapTable[i] == -1 ) {
-             Con::errorf( "bogus mRemapTable[i] value in %s %i", mFaceName, mSize );
+         const S32 index = convertBEndianToHost(remap[i - minGlyph]);
+         if( index == -1 ) {
+             Con::errorf( "bogus remap value in %s %i", mFaceName, mSize );
          }
+         setRemap(i, index);
       }
    }
    
@@ -729,7 +1031,14 @@ bool GFont::write(Stream& stream)
 
    for(i = 0; i < 65536; i++)
    {
-       if(mRemapTable[i] != -1)
+       // Skip unallocated remap pages.
+       if(mRemapPages[i / RemapPageSize] == NULL)
+       {
+           i += RemapPageSize - 1;
+           continue;
+       }
+
+       if(getRemap(i) != -1)
        {
            if(i > maxGlyph) maxGlyph = i;
            if(i < minGlyph) minGlyph = i;
@@ -738,20 +1047,25 @@ bool GFont::write(Stream& stream)
 
    //-Mat make sure all our character info is good before writing it
    for(i = minGlyph; i <= maxGlyph; i++) {
-       if( mRemapTable[i] == -1 ) {
+       if( getRemap(i) == -1 ) {
            //-Mat get info and try this again
            getCharInfo(i);
-           if( mRemapTable[i] == -1 ) {
+           if( getRemap(i) == -1 ) {
                Con::errorf( "GFont::write() couldn't get character info for char %i", i);
            }
        }
    }
 
+    // Pack this font's glyphs into sheets of its own.
+    Vector<PlatformFont::CharInfo> charInfo;
+    Vector<GBitmap*> sheets;
+    packGlyphSheets(charInfo, sheets);
+
     // Write char info list
-    stream.write(U32(mCharInfoList.size()));
-    for(i = 0; i < mCharInfoList.size(); i++)
+    stream.write(U32(charInfo.size()));
+    for(i = 0; i < charInfo.size(); i++)
     {
-        const PlatformFont::CharInfo *ci = &mCharInfoList[i];
+        const PlatformFont::CharInfo *ci = &charInfo[i];
         stream.write(ci->bitmapIndex);
         stream.write(ci->xOffset);
         stream.write(ci->yOffset);
@@ -762,9 +1076,10 @@ bool GFont::write(Stream& stream)
         stream.write(ci->xIncrement);
    }
 
-   stream.write(mTextureSheets.size());
-   for(i = 0; i < mTextureSheets.size(); i++) {
-       mTextureSheets[i].getBitmap()->writePNG(stream);
+   stream.write(sheets.size());
+   for(i = 0; i < sheets.size(); i++) {
+       sheets[i]->writePNG(stream);
+       delete sheets[i];
    }
 
    stream.write(mCurX);
@@ -778,30 +1093,27 @@ bool GFont::write(Stream& stream)
    // Skip it if we don't have any glyphs to do...
    if(maxGlyph >= minGlyph)
    {
-      // Put everything big endian, to be consistent. Do this inplace.
-      for(i = minGlyph; i <= maxGlyph; i++)
-         mRemapTable[i] = convertHostToBEndian(mRemapTable[i]);
+      // Put everything big endian, to be consistent.
+      FrameTemp<S32> remap(maxGlyph-minGlyph+1);
+      for(i = minGlyph; i <= maxGlyph; i++) {
+         const S32 index = getRemap(i);
+         if( index == -1 ) {
+             Con::errorf( "bogus remap value in %s %i", mFaceName, mSize );
+         }
+         remap[i - minGlyph] = convertHostToBEndian(index);
+      }
 
       {
          // Compress.
          const U32 buffSize = 128 * 1024;
          FrameTemp<S32> outBuff(buffSize);
          uLongf destLen = buffSize * sizeof(S32);
-         compress2((Bytef*)(S32*)outBuff, &destLen, (Bytef*)(S32*)&mRemapTable[minGlyph], (maxGlyph-minGlyph+1)*sizeof(S32), 9);
+         compress2((Bytef*)(S32*)outBuff, &destLen, (Bytef*)(S32*)remap, (maxGlyph-minGlyph+1)*sizeof(S32), 9);
 
          // Write out.
          stream.write((U32)destLen);
          stream.write((U32)destLen, outBuff);
       }
-
-      // Put us back to normal.
-      for(i = minGlyph; i <= maxGlyph; i++) {
-         mRemapTable[i] = convertBEndianToHost(mRemapTable[i]);
-
-         if( mRemapTable[i] == -1 ) {
-             Con::errorf( "bogus mRemapTable[i] value in %s %i", mFaceName, mSize );
-         }
-      }
    }
    
    return (stream.getStatus() == Stream::Ok);
@@ -887,6 +1199,8 @@ void GFont::importStrip(const char *fileName, U32 padding, U32 kerning)
    // Wipe our texture sheets.
    mCurSheet = mCurX = mCurY = 0;
    mTextureSheets.clear();
+   releaseSharedSheets();
+   clearTextRuns();
 
    //  Now, load the font strip.
    GBitmap *strip = GBitmap::load(fileName);
@@ -1041,8 +1355,7 @@ ResourceInstance* constructBMFont(Stream& stream)
 
 bool GFont::readBMFont(Stream& io_rStream)
 {
-    for (U32 i = 0; i < (sizeof(mRemapTable) / sizeof(S32)); i++)
-        mRemapTable[i] = -1;
+    clearRemap();
     
     U32 bmWidth = 0;
     U32 bmHeight = 0;
@@ -1206,7 +1519,7 @@ bool GFont::readBMFont(Stream& io_rStream)
                 currentWordCount++;
             }
             mCharInfoList.push_back(ci);
-            mRemapTable[ CharID ] = mCharInfoList.size()-1;
+            setRemap( CharID, mCharInfoList.size()-1 );
         }
     }
     
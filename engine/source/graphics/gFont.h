@@ -71,13 +71,67 @@ public:
    {
       TabWidthInSpaces = 3,
       TextureSheetSize = 256,
+      SharedSheetSize = 512,
+      SharedSheetPadding = 1,
+      RemapPageSize = 256,
+      RemapPageCount = 65536 / RemapPageSize,
+      TextRunCacheSize = 128,
+      TextRunMaxLength = 512,
    };
 
+   /// Glyph of a text run, positioned relative to the draw point.
+   struct RunGlyph
+   {
+      S32 mSheet;
+      F32 mLeft;
+      F32 mTop;
+      F32 mRight;
+      F32 mBottom;
+      F32 mTexLeft;
+      F32 mTexTop;
+      F32 mTexRight;
+      F32 mTexBottom;
+   };
+
+   /// String laid out once and reused while it is drawn unchanged.
+   /// Strings containing color codes depend on the draw state so are never laid out.
+   struct TextRun
+   {
+      U32 mHash;
+      U32 mLength;
+      UTF16* mpText;
+      bool mCacheable;
+      S32 mAdvance;
+      Vector<RunGlyph> mGlyphs;
+   };
+
+
 
    // Enumerations and structures available to derived classes
 private:
+   /// Shelf of glyphs in a shared sheet.
+   struct GlyphShelf
+   {
+      S32 mX;
+      S32 mY;
+      S32 mHeight;
+   };
+
+   /// Glyph sheet shared by every font generating glyphs from a platform font,
+   /// so text in different faces and sizes can be drawn from one texture.
+   struct GlyphSheet
+   {
+      TextureHandle mTexture;
+      U32 mReferences;
+      S32 mShelfBottom;
+      Vector<GlyphShelf> mShelves;
+   };
+
+   static Vector<GlyphSheet*> smSharedSheets;
+
    PlatformFont *mPlatformFont;
    Vector<TextureHandle>mTextureSheets;
+   Vector<GlyphSheet*> mReferencedSheets;
 
    S32 mCurX;
    S32 mCurY;
@@ -97,7 +151,9 @@ private:
    Vector<PlatformFont::CharInfo>  mCharInfoList;       // - List of character info structures, must
                                           //    be accessed through the getCharInfo(U32)
                                           //    function to account for remapping...
-   S32             mRemapTable[65536];    // - Index remapping
+   S32*            mRemapPages[RemapPageCount]; // - Index remapping, pages allocated on demand
+
+   TextRun*        mTextRuns[TextRunCacheSize];
 public:
    GFont();
    virtual ~GFont();
@@ -105,9 +161,23 @@ public:
 protected:
     bool loadCharInfo(const UTF16 ch);
     void addBitmap(PlatformFont::CharInfo &charInfo);
-    void addSheet(void);
     void assignSheet(S32 sheetNum, GBitmap *bmp);
 
+    inline S32 getRemap(const UTF16 ch) const
+    {
+       const S32* page = mRemapPages[ch / RemapPageSize];
+       return page ? page[ch % RemapPageSize] : -1;
+    }
+    void setRemap(const UTF16 ch, const S32 index);
+    void clearRemap(void);
+
+    S32 allocateSharedGlyph(const U32 width, const U32 height, S32 &offsetX, S32 &offsetY);
+    void releaseSharedSheets(void);
+    void packGlyphSheets(Vector<PlatformFont::CharInfo> &charInfo, Vector<GBitmap*> &sheets);
+    void unpackGlyphSheets(Vector<GBitmap*> &sheets);
+
+    void clearTextRuns(void);
+
     void *mMutex;
 
 public:
@@ -121,6 +191,10 @@ public:
    const PlatformFont::CharInfo& getCharInfo(const UTF16 in_charIndex);
    static const PlatformFont::CharInfo& getDefaultCharInfo();
 
+   /// Returns the cached layout of the first n characters of the string, or NULL if
+   /// the string contains color codes or is too long to cache.
+   const TextRun* getTextRun(const UTF16* string, U32 n);
+
    U32  getCharHeight(const UTF16 in_charIndex);
    U32  getCharWidth(const UTF16 in_charIndex);
    U32  getCharXIncrement(const UTF16 in_charIndex);
@@ -167,7 +241,7 @@ public:
    /// are treated as having 0 for RGB).
    bool isAlphaOnly()
    {
-      return mTextureSheets[0].getBitmap()->getFormat() == GBitmap::Alpha;
+      return mTextureSheets.empty() || mTextureSheets[0].getBitmap()->getFormat() == GBitmap::Alpha;
    }
 
    /// Get the filename for a cached font.
@@ -211,7 +285,7 @@ inline U32 GFont::getCharHeight(const UTF16 in_charIndex)
 
 inline bool GFont::isValidChar(const UTF16 in_charIndex) const
 {
-   if(mRemapTable[in_charIndex] != -1)
+   if(getRemap(in_charIndex) != -1)
       return true;
 
    if(mPlatformFont)
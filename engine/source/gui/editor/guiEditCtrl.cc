@@ -551,6 +551,7 @@ void GuiEditCtrl::onRender(Point2I offset, const RectI &updateRect)
       AssertFatal(ndot <= maxdot, "dot overflow");
       
       // draw the points.
+      dglFlushBatch();
       glEnableClientState(GL_VERTEX_ARRAY);
       glEnable( GL_BLEND );
       glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
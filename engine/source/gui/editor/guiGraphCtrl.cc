@@ -71,6 +71,9 @@ bool GuiGraphCtrl::onWake()
 
 void GuiGraphCtrl::onRender(Point2I offset, const RectI &updateRect)
 {
+	// The graph sets its own GL state around dgl calls so draws immediately.
+	dglSuspendBatch();
+
 	/*if (mProfile->mBorder)
 	{
 		RectI rect(offset.x, offset.y, mBounds.extent.x, mBounds.extent.y);
@@ -338,6 +341,8 @@ void GuiGraphCtrl::onRender(Point2I offset, const RectI &updateRect)
 
 	}
 #endif
+
+	dglResumeBatch();
 }
 
 void GuiGraphCtrl::addDatum(S32 plotID, F32 v)
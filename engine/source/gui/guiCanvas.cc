@@ -1351,6 +1351,11 @@ void GuiCanvas::renderFrame(bool preRenderOnly, bool bufferSwap /* = true */)
         glClear(GL_COLOR_BUFFER_BIT);	
     }
 
+      // Collect the gui draws into batches.
+      const bool batching = Con::getBoolVariable("$pref::T2D::guiBatching", true);
+      if (batching)
+         dglBeginBatch();
+
       //render the dialogs
       iterator i;
       for(i = begin(); i != end(); i++)
@@ -1402,6 +1407,7 @@ void GuiCanvas::renderFrame(bool preRenderOnly, bool bufferSwap /* = true */)
       //temp draw the mouse
       if (cursorON && mShowCursor && !mouseCursor && Canvas->getUseNativeCursor())
       {
+         dglFlushBatch();
 #if defined(TORQUE_OS_IOS) || defined(TORQUE_OS_ANDROID) || defined(TORQUE_OS_EMSCRIPTEN)
          glColor4ub(255, 0, 0, 255);
          GLfloat vertices[] = {
@@ -1434,6 +1440,9 @@ void GuiCanvas::renderFrame(bool preRenderOnly, bool bufferSwap /* = true */)
          pos -= spot;
          mouseCursor->render(pos);
       }
+
+      if (batching)
+         dglEndBatch();
    }
 
    PROFILE_END();
@@ -386,6 +386,22 @@ ConsoleMethodWithDocs(GuiCanvas, getUseBackgroundColor, ConsoleBool, 2, 2, (...)
     return object->getUseBackgroundColor();
 }
 
+//-----------------------------------------------------------------------------
+
+/*! Gets the gui batching counters for the last rendered frame.
+    Batching is controlled by $pref::T2D::guiBatching.
+    @return The batched draw calls, the batched quads and the draws that could not be batched formatted as "drawCalls quads immediateDraws".
+*/
+ConsoleMethodWithDocs(GuiCanvas, getBatchStats, ConsoleString, 2, 2, ())
+{
+    // Fetch the counters.
+    const DGLBatchStats& stats = dglGetBatchStats();
+
+    char* pBuffer = Con::getReturnBuffer(64);
+    dSprintf( pBuffer, 64, "%d %d %d", stats.mDrawCalls, stats.mQuads, stats.mImmediateDraws );
+    return pBuffer;
+}
+
 ConsoleMethodGroupEndWithDocs(GuiCanvas)
 
 /*! Use the createCanvas function to initialize the canvas.
@@ -563,6 +563,9 @@ void GuiColorPickerCtrl::drawSelector(RectI &bounds, Point2I &selectorPos, Selec
 
 void GuiColorPickerCtrl::onRender(Point2I offset, const RectI& updateRect)
 {
+   // The color box is drawn with GL directly and read back so draw immediately.
+   dglSuspendBatch();
+
    RectI boundsRect(offset, mBounds.extent); 
    renderColorBox(boundsRect);
 
@@ -605,6 +608,8 @@ void GuiColorPickerCtrl::onRender(Point2I offset, const RectI& updateRect)
             onAction();
       }
    }
+
+   dglResumeBatch();
    
    //render the children
    renderChildControls( offset, mBounds, updateRect);
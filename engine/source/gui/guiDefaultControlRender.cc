@@ -215,6 +215,18 @@ void renderSizableBorderedImageAsset(RectI &bounds, U8 frame, ImageAsset *imageA
 		RectI bottomleft  = RectI(pixelArea7.mPixelOffset, Point2I(pixelArea7.mPixelWidth, pixelArea7.mPixelHeight));
 		RectI bottom      = RectI(pixelArea8.mPixelOffset, Point2I(pixelArea8.mPixelWidth, pixelArea8.mPixelHeight));
 		RectI bottomright = RectI(pixelArea9.mPixelOffset, Point2I(pixelArea9.mPixelWidth, pixelArea9.mPixelHeight));
+
+		// Address the atlas page if the image is packed.
+		const Point2I atlasOffset = imageAsset->getAtlasOffset();
+		topleft.point += atlasOffset;
+		top.point += atlasOffset;
+		topright.point += atlasOffset;
+		left.point += atlasOffset;
+		fill.point += atlasOffset;
+		right.point += atlasOffset;
+		bottomleft.point += atlasOffset;
+		bottom.point += atlasOffset;
+		bottomright.point += atlasOffset;
 		renderSizableBorderedTexture(bounds, imageAsset->getImageTexture(), 
 			topleft,
 			top, 
@@ -349,7 +361,7 @@ void renderStretchedImageAsset(RectI &bounds, U8 frame, GuiControlProfile *profi
 	if (imageAsset != NULL && imageAsset->isAssetValid() && imageAsset->getFrameCount() > frame)
 	{
 		const ImageAsset::FrameArea::PixelArea& pixelArea = imageAsset->getImageFrameArea(frame).mPixelArea;
-		RectI srcRect(pixelArea.mPixelOffset, Point2I(pixelArea.mPixelWidth, pixelArea.mPixelHeight));
+		RectI srcRect(pixelArea.mPixelOffset + imageAsset->getAtlasOffset(), Point2I(pixelArea.mPixelWidth, pixelArea.mPixelHeight));
 
 		// Render image.
 		dglDrawBitmapStretchSR(imageAsset->getImageTexture(), bounds, srcRect);
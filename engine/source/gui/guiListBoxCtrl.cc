@@ -36,6 +36,9 @@ GuiListBoxCtrl::GuiListBoxCtrl()
    mFitParentWidth = true;
    mItemSize = Point2I(10,20);
    mLastClickItem = NULL;
+   mIndexDirty = false;
+   mMaxItemWidth = 1;
+   mMaxItemWidthDirty = false;
    mIsContainer = false;
    mActive = true;
    caller = this;
@@ -61,6 +64,8 @@ bool GuiListBoxCtrl::onWake()
    if( !Parent::onWake() )
       return false;
 
+   // The font may have changed while we slept.
+   mMaxItemWidthDirty = true;
    updateSize();
 
    return true;
@@ -76,12 +81,107 @@ void GuiListBoxCtrl::addObject(SimObject *obj)
 void GuiListBoxCtrl::clearItems()
 {
    // Free item list allocated memory
-   while( mItems.size() )
-      deleteItem( 0 );
+   for( S32 i = 0; i < mItems.size(); i++ )
+   {
+      destructInPlace( mItems[i] );
+      mItemPool.free( mItems[i] );
+   }
 
    // Free our vector lists
    mItems.clear();
    mSelectedItems.clear();
+   mLastClickItem = NULL;
+
+   // Reset the lookups
+   mTextIndex.clear();
+   mIDIndex.clear();
+   mIndexDirty = false;
+   mMaxItemWidth = 1;
+   mMaxItemWidthDirty = false;
+}
+
+GuiListBoxCtrl::LBItem* GuiListBoxCtrl::createItem( StringTableEntry text, void *itemData )
+{
+   LBItem *newItem = constructInPlace( mItemPool.alloc() );
+   if( !newItem )
+   {
+      Con::warnf("GuiListBoxCtrl::createItem - error allocating item memory!" );
+      return NULL;
+   }
+
+   // Assign item data
+   newItem->itemText = StringTable->insert(text, true);
+   newItem->isSelected = false;
+   newItem->isActive = true;
+   newItem->ID = 0;
+   newItem->itemData = itemData;
+   newItem->hasColor = false;
+   newItem->itemIndex = -1;
+
+   return newItem;
+}
+
+void GuiListBoxCtrl::appendItem( LBItem *item )
+{
+   mItems.push_back( item );
+
+   // Appending moves nothing, so a valid index just grows.
+   if( mIndexDirty )
+      return;
+
+   item->itemIndex = mItems.size() - 1;
+   mTextIndex.insertEqual( _StringTable::hashString( item->itemText ), item );
+   mIDIndex.insertEqual( item->ID, item );
+}
+
+void GuiListBoxCtrl::validateIndex()
+{
+   if( !mIndexDirty )
+      return;
+
+   mTextIndex.clear();
+   mIDIndex.clear();
+   mIndexDirty = false;
+
+   for( S32 i = 0; i < mItems.size(); i++ )
+   {
+      LBItem *item = mItems[i];
+      item->itemIndex = i;
+      mTextIndex.insertEqual( _StringTable::hashString( item->itemText ), item );
+      mIDIndex.insertEqual( item->ID, item );
+   }
+}
+
+void GuiListBoxCtrl::measureItem( LBItem *item )
+{
+   // Only a fixed width list needs the widest item, and once dirty it gets re-measured anyway.
+   if( mMaxItemWidthDirty || mFitParentWidth )
+   {
+      mMaxItemWidthDirty = true;
+      return;
+   }
+
+   GFont *font = mProfile ? mProfile->getFont(mFontSizeAdjust) : NULL;
+   if( !font )
+   {
+      mMaxItemWidthDirty = true;
+      return;
+   }
+
+   S32 width = font->getStrWidth( item->itemText );
+   if( width > mMaxItemWidth )
+      mMaxItemWidth = width;
+}
+
+void GuiListBoxCtrl::unmeasureItem( LBItem *item )
+{
+   if( mMaxItemWidthDirty )
+      return;
+
+   // Losing the widest item means measuring the rest again.
+   GFont *font = mProfile ? mProfile->getFont(mFontSizeAdjust) : NULL;
+   if( !font || (S32)font->getStrWidth( item->itemText ) >= mMaxItemWidth )
+      mMaxItemWidthDirty = true;
 }
 
 void GuiListBoxCtrl::clearSelection()
@@ -112,7 +212,7 @@ void GuiListBoxCtrl::removeSelection( LBItem *item, S32 index )
    if( !mSelectedItems.size() )
       return;
 
-   if( !item )
+   if( !item || !item->isSelected )
       return;
 
    for( S32 i = 0 ; i < mSelectedItems.size(); i++ )
@@ -153,14 +253,8 @@ void GuiListBoxCtrl::addSelection( LBItem *item, S32 index )
    }
    else
    {
-      if( !mSelectedItems.empty() )
-      {
-         for( S32 i = 0; i < mSelectedItems.size(); i++ )
-         {
-            if( mSelectedItems[ i ] == item )
-               return;
-         }
-      }
+      if( item->isSelected )
+         return;
    }
 
    item->isSelected = true;
@@ -175,13 +269,15 @@ void GuiListBoxCtrl::addSelection( LBItem *item, S32 index )
 
 S32 GuiListBoxCtrl::getItemIndex( LBItem *item )
 {
-   if( mItems.empty() )
+   if( mItems.empty() || !item )
       return -1;
 
    // Lookup the index of an item in our list, by the pointer to the item
-   for( S32 i = 0; i < mItems.size(); i++ )
-      if( mItems[i] == item )
-         return i;
+   validateIndex();
+
+   const S32 index = item->itemIndex;
+   if( index >= 0 && index < mItems.size() && mItems[index] == item )
+      return index;
 
    return -1;
 }
@@ -201,11 +297,15 @@ S32 GuiListBoxCtrl::getSelectedItem()
    if( mSelectedItems.empty() || mItems.empty() )
       return -1;
 
-   for( S32 i = 0 ; i < mItems.size(); i++ )
-      if( mItems[i]->isSelected )
-         return i;
+   // The first selected item in list order.
+   validateIndex();
 
-   return -1;
+   S32 index = mSelectedItems[0]->itemIndex;
+   for( S32 i = 1 ; i < mSelectedItems.size(); i++ )
+      if( mSelectedItems[i]->itemIndex < index )
+         index = mSelectedItems[i]->itemIndex;
+
+   return index;
 }
 
 void GuiListBoxCtrl::getSelectedItems( Vector<S32> &Items )
@@ -216,10 +316,14 @@ void GuiListBoxCtrl::getSelectedItems( Vector<S32> &Items )
    // If there are no selected items, return an empty vector
    if( mSelectedItems.empty() )
       return;
-   
-   for( S32 i = 0; i < mItems.size(); i++ )
-      if( mItems[i]->isSelected )
-         Items.push_back( i );
+
+   validateIndex();
+
+   for( S32 i = 0; i < mSelectedItems.size(); i++ )
+      Items.push_back( mSelectedItems[i]->itemIndex );
+
+   // In list order.
+   std::sort( Items.begin(), Items.end() );
 }
 
 S32 GuiListBoxCtrl::findItemText( StringTableEntry text, bool caseSensitive )
@@ -235,18 +339,25 @@ S32 GuiListBoxCtrl::findItemText( StringTableEntry text, bool caseSensitive )
    if( mItems.empty() )
       return -1;
 
-   // Lookup the index of an item in our list, by the pointer to the item
-   for( S32 i = 0; i < mItems.size(); i++ )
+   // The text hash ignores case, so walk the matches for the first one in list order.
+   validateIndex();
+
+   S32 index = -1;
+   const U32 key = _StringTable::hashString( text );
+   for( HashTable<U32, LBItem*>::iterator itr = mTextIndex.find( key ); itr != mTextIndex.end() && itr->key == key; ++itr )
    {
+      LBItem *item = itr->value;
+      if( index != -1 && item->itemIndex > index )
+         continue;
+
       // Case Sensitive Compare?
-      if( caseSensitive && ( dStrcmp( mItems[i]->itemText, text ) == 0 ) )
-         return i;
-      else if (!caseSensitive && ( dStricmp( mItems[i]->itemText, text ) == 0 ))
-         return i;
+      if( caseSensitive && ( dStrcmp( item->itemText, text ) == 0 ) )
+         index = item->itemIndex;
+      else if (!caseSensitive && ( dStricmp( item->itemText, text ) == 0 ))
+         index = item->itemIndex;
    }
 
-   // Not Found!
-   return -1;
+   return index;
 }
 
 void GuiListBoxCtrl::setSelectionInternal(StringTableEntry text)
@@ -254,7 +365,7 @@ void GuiListBoxCtrl::setSelectionInternal(StringTableEntry text)
 	S32 index = findItemText(text);
 	if (index != -1)
 	{
-		mSelectedItems.clear();
+		clearSelection();
 		LBItem *item = mItems[index];
 		item->isSelected = true;
 		mSelectedItems.push_front(item);
@@ -273,7 +384,7 @@ void GuiListBoxCtrl::setCurSel( S32 index )
    // If index -1 is specified, we clear the selection
    if( index == -1 )
    {
-      mSelectedItems.clear();
+      clearSelection();
       return;
    }
 
@@ -289,10 +400,16 @@ void GuiListBoxCtrl::setCurSelRange( S32 start, S32 stop )
    else if( start > mItems.size() )
       start = mItems.size();
 
+   if( mItems.empty() )
+      return;
+
+   if( start >= mItems.size() )
+      start = mItems.size() - 1;
+
    if( stop < 0 )
       stop = 0;
-   else if( stop > mItems.size() )
-      stop = mItems.size();
+   else if( stop >= mItems.size() )
+      stop = mItems.size() - 1;
 
    S32 iterStart = ( start < stop ) ? start : stop;
    S32 iterStop  = ( start < stop ) ? stop : start;
@@ -315,9 +432,43 @@ S32 GuiListBoxCtrl::addItemWithColor( StringTableEntry text, ColorF color, void
 
 S32	GuiListBoxCtrl::addItemWithID(StringTableEntry text, S32 ID, void *itemData)
 {
-	S32 index = insertItem( mItems.size(), text, itemData);
-	setItemID(index, ID);
-	return index;
+	if( !text )
+	{
+		Con::warnf("GuiListBoxCtrl::addItemWithID - cannot add NULL string" );
+		return -1;
+	}
+
+	// Set the ID before the item is indexed.
+	LBItem *newItem = createItem( text, itemData );
+	if( !newItem )
+		return -1;
+
+	newItem->ID = ID;
+	appendItem( newItem );
+	measureItem( newItem );
+	updateSize();
+
+	return mItems.size() - 1;
+}
+
+S32 GuiListBoxCtrl::addItems( const Vector<StringTableEntry> &texts )
+{
+   // Append everything, then size the list once.
+   mItems.reserve( mItems.size() + texts.size() );
+
+   for( S32 i = 0; i < texts.size(); i++ )
+   {
+      LBItem *newItem = createItem( texts[i], NULL );
+      if( !newItem )
+         continue;
+
+      appendItem( newItem );
+      measureItem( newItem );
+   }
+
+   updateSize();
+
+   return mItems.size() - 1;
 }
 
 void GuiListBoxCtrl::setItemColor( S32 index, ColorF color )
@@ -388,7 +539,11 @@ void GuiListBoxCtrl::setItemID(S32 index, S32 ID)
 	}
 
 	LBItem* item = mItems[index];
+	if (item->ID == ID)
+		return;
+
 	item->ID = ID;
+	mIndexDirty = true;
 }
 
 S32 GuiListBoxCtrl::getItemID(S32 index)
@@ -409,17 +564,17 @@ S32 GuiListBoxCtrl::findItemID(S32 ID)
 	if (mItems.empty())
 		return -1;
 
-	// Lookup the index of an item in our list, by the pointer to the item
-	for (S32 i = 0; i < mItems.size(); i++)
+	// Several items may share an ID, so take the first in list order.
+	validateIndex();
+
+	S32 index = -1;
+	for (HashTable<S32, LBItem*>::iterator itr = mIDIndex.find(ID); itr != mIDIndex.end() && itr->key == ID; ++itr)
 	{
-		if (mItems[i]->ID == ID)
-		{
-			return i;
-		}
+		if (index == -1 || itr->value->itemIndex < index)
+			index = itr->value->itemIndex;
 	}
 
-	// Not Found!
-	return -1;
+	return index;
 }
 
 void GuiListBoxCtrl::setItemActive(S32 index)
@@ -471,24 +626,21 @@ S32 GuiListBoxCtrl::insertItem( S32 index, StringTableEntry text, void *itemData
       return -1;
    }
 
-   LBItem *newItem = new LBItem;
+   LBItem *newItem = createItem( text, itemData );
    if( !newItem )
-   {
-      Con::warnf("GuiListBoxCtrl::insertItem - error allocating item memory!" );
       return -1;
-   }
 
-   // Assign item data
-   newItem->itemText = StringTable->insert(text, true);
-   newItem->isSelected = false;
-   newItem->isActive = true;
-   newItem->ID = 0;
-   newItem->itemData = itemData;
-   newItem->hasColor = false;
+   // Add to list.  Anything but an append shifts the items after it.
+   if( index == mItems.size() )
+      appendItem( newItem );
+   else
+   {
+      mItems.insert(index);
+      mItems[index] = newItem;
+      mIndexDirty = true;
+   }
 
-   // Add to list
-   mItems.insert(index);
-   mItems[index] = newItem;
+   measureItem( newItem );
 
    // Resize our list to fit our items
    updateSize();
@@ -546,11 +698,18 @@ void  GuiListBoxCtrl::deleteItem( S32 index )
       }
    }
 
+   if( item == mLastClickItem )
+      mLastClickItem = NULL;
+
+   unmeasureItem( item );
+
    // Remove it from the list
    mItems.erase( &mItems[ index ] );
+   mIndexDirty = true;
 
    // Free the memory associated with it
-   delete item;
+   destructInPlace( item );
+   mItemPool.free( item );
 }
 
 StringTableEntry GuiListBoxCtrl::getItemText( S32 index )
@@ -580,7 +739,10 @@ void GuiListBoxCtrl::setItemText( S32 index, StringTableEntry text )
       return;
    }
 
+   unmeasureItem( mItems[ index ] );
    mItems[ index ]->itemText = StringTable->insert( text );
+   measureItem( mItems[ index ] );
+   mIndexDirty = true;
 }
 #pragma endregion
 
@@ -595,15 +757,19 @@ void GuiListBoxCtrl::updateSize()
 
    if (!mFitParentWidth)
    {
-      // Find the maximum width cell:
-      S32 maxWidth = 1;
-      for ( U32 i = 0; i < (U32)mItems.size(); i++ )
+      // Find the maximum width cell, only measuring everything when the widest one went away:
+      if ( mMaxItemWidthDirty )
       {
-         S32 width = font->getStrWidth( mItems[i]->itemText );
-         if( width > maxWidth )
-            maxWidth = width;
+         mMaxItemWidth = 1;
+         for ( U32 i = 0; i < (U32)mItems.size(); i++ )
+         {
+            S32 width = font->getStrWidth( mItems[i]->itemText );
+            if( width > mMaxItemWidth )
+               mMaxItemWidth = width;
+         }
+         mMaxItemWidthDirty = false;
       }
-      contentSize.x = maxWidth + 6;
+      contentSize.x = mMaxItemWidth + 6;
    }
 
    mItemSize = this->getOuterExtent(contentSize, NormalState, mProfile);
@@ -637,7 +803,12 @@ void GuiListBoxCtrl::onRender( Point2I offset, const RectI &updateRect )
 	}
 
 
-	for ( S32 i = 0; i < mItems.size(); i++)
+	// Start at the row before the update region rather than walking every row above it
+	S32 first = 0;
+	if (mItemSize.y > 0 && updateRect.point.y > offset.y)
+		first = getMax((updateRect.point.y - offset.y) / mItemSize.y - 1, 0);
+
+	for ( S32 i = first; i < mItems.size(); i++)
 	{
 		// Only render visible items
 		if ((i + 1) * mItemSize.y + offset.y < updateRect.point.y)
@@ -885,6 +1056,7 @@ void GuiListBoxCtrl::sortByText(bool increasing)
 
 	LBItem::sIncreasing = increasing;
 	std::sort(mItems.begin(), mItems.end(), LBItem::compByText);
+	mIndexDirty = true;
 }
 
 void GuiListBoxCtrl::sortByID(bool increasing)
@@ -894,5 +1066,6 @@ void GuiListBoxCtrl::sortByID(bool increasing)
 
 	LBItem::sIncreasing = increasing;
 	std::sort(mItems.begin(), mItems.end(), LBItem::compByID);
+	mIndexDirty = true;
 }
 #pragma endregion
\ No newline at end of file
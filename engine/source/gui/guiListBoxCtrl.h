@@ -42,6 +42,14 @@
 #include "gui/containers/guiScrollCtrl.h"
 #endif
 
+#ifndef _DATACHUNKER_H_
+#include "memory/dataChunker.h"
+#endif
+
+#ifndef _HASHTABLE_H_
+#include "collection/hashTable.h"
+#endif
+
 
 class GuiListBoxCtrl : public GuiControl
 {
@@ -63,6 +71,7 @@ public:
       void*             itemData;
       ColorF            color;
       bool              hasColor;
+      S32               itemIndex;  ///< Position in mItems, valid while the index is.
 
 	  static bool sIncreasing;
 
@@ -114,6 +123,7 @@ public:
    S32               addItem( StringTableEntry text, void *itemData = NULL );
    S32               addItemWithColor( StringTableEntry text, ColorF color = ColorF(-1, -1, -1), void *itemData = NULL);
    S32				 addItemWithID(StringTableEntry text, S32 ID = 0, void *itemData = NULL);
+   S32               addItems( const Vector<StringTableEntry> &texts );
    S32               insertItem( S32 index, StringTableEntry text, void *itemData = NULL );
    S32               insertItemWithColor( S32 index, StringTableEntry text, ColorF color = ColorF(-1, -1, -1), void *itemData = NULL);
    S32               findItemText( StringTableEntry text, bool caseSensitive = false );
@@ -164,6 +174,23 @@ public:
 
 protected:
 	GuiControl		*caller;
+
+   /// Items are pooled.  The text and ID lookups and each item's index are
+   /// extended on append and rebuilt lazily after anything else reorders items.
+   FreeListChunker<LBItem>    mItemPool;
+   HashTable<U32, LBItem*>    mTextIndex;
+   HashTable<S32, LBItem*>    mIDIndex;
+   bool                       mIndexDirty;
+
+   /// Widest item text, kept as items come and go so sizing doesn't re-measure everything.
+   S32                        mMaxItemWidth;
+   bool                       mMaxItemWidthDirty;
+
+   LBItem*           createItem( StringTableEntry text, void *itemData );
+   void              appendItem( LBItem *item );
+   void              validateIndex();
+   void              measureItem( LBItem *item );
+   void              unmeasureItem( LBItem *item );
 };
 
 #endif
\ No newline at end of file
@@ -314,6 +314,33 @@ ConsoleMethodWithDocs(GuiListBoxCtrl, addItemWithID, ConsoleVoid, 4, 4, "(string
 	}
 }
 
+/*! Adds several items to the end of the list, sizing the list only once.
+	@param items The text of the new items, one item per line.
+	@return Returns the index of the last item added or -1 if no items were given.
+*/
+ConsoleMethodWithDocs(GuiListBoxCtrl, addItems, ConsoleInt, 3, 3, "(string items)")
+{
+	Vector<StringTableEntry> texts;
+
+	const char* pStart = argv[2];
+	while (*pStart)
+	{
+		const char* pEnd = dStrchr(pStart, '\n');
+		const U32 length = pEnd ? (U32)(pEnd - pStart) : dStrlen(pStart);
+		texts.push_back(StringTable->insertn(pStart, length, true));
+
+		if (!pEnd)
+			break;
+
+		pStart = pEnd + 1;
+	}
+
+	if (texts.empty())
+		return -1;
+
+	return object->addItems(texts);
+}
+
 /*! Sets the color of the color bullet at the given index.
 	@param index The zero-based index of the item that should have a color bullet.
 	@param color The color of a color bullet that will appear to the left of the text. Values range between 0 and 255.
@@ -240,6 +240,9 @@ void GuiSliderCtrl::updateThumb(F32 _value, bool snap, bool onWake)
 //----------------------------------------------------------------------------
 void GuiSliderCtrl::onRender(Point2I offset, const RectI &updateRect)
 {
+    // The ticks are drawn with GL directly so draw immediately.
+    dglSuspendBatch();
+
     Point2I pos(offset.x + mShiftPoint, offset.y);
     Point2I ext(mBounds.extent.x - mShiftExtent, mBounds.extent.y);
     RectI thumb = mThumb;
@@ -463,6 +466,9 @@ void GuiSliderCtrl::onRender(Point2I offset, const RectI &updateRect)
         dglSetBitmapModulation(getFontColor(mProfile));
         dglDrawText(mProfile->getFont(mFontSizeAdjust), textStart, buf, mProfile->mFontColors);
     }
+
+    dglResumeBatch();
+
     renderChildControls(offset, mBounds, updateRect);
 }
 
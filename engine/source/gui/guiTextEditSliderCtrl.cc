@@ -219,6 +219,9 @@ void GuiTextEditSliderCtrl::onRender(Point2I offset, const RectI &updateRect)
                Point2I(start.x+14,midPoint.y),
                mProfile->mFontColor);
 
+   // The arrows are drawn with GL directly so draw anything batched first.
+   dglFlushBatch();
+
 #if defined(TORQUE_OS_IOS) || defined(TORQUE_OS_ANDROID) || defined(TORQUE_OS_EMSCRIPTEN)
 
    glColor4f(0,0,0,255);
@@ -270,9 +273,11 @@ void GuiTextEditSliderCtrl::onRender(Point2I offset, const RectI &updateRect)
 		  verts[10] = (GLfloat)start.x+3;
 		  verts[11] = (GLfloat)midPoint.y+2; 
       }
+	glEnableClientState(GL_VERTEX_ARRAY);
 	glVertexPointer(2, GL_FLOAT, 0, verts);	
 
 	glDrawArrays(GL_TRIANGLES, 0, 6);	
+	glDisableClientState(GL_VERTEX_ARRAY);
 #else
    glColor3i(0,0,0);
 
@@ -40,6 +40,7 @@ GuiTreeViewCtrl::Item::Item( GuiControlProfile *pProfile )
    mState               = 0;
    mId                  = -1;
    mTabLevel            = 0;
+   mVisibleRow          = -1;
    mIcon                = 0;
    mDataRenderWidth     = 0;
    mScriptInfo.mText    = NULL;
@@ -355,11 +356,16 @@ GuiTreeViewCtrl::GuiTreeViewCtrl()
    VECTOR_SET_ASSOCIATION(mVisibleItems);
    VECTOR_SET_ASSOCIATION(mSelectedItems);
    VECTOR_SET_ASSOCIATION(mSelected);
+   VECTOR_SET_ASSOCIATION(mItemBlocks);
+   VECTOR_SET_ASSOCIATION(mVisibleScratch);
 
    mItemFreeList  =  NULL;
+   mItemBlockUsed =  0;
+   mInspectorItemCount = 0;
    mRoot          =  NULL;
    mInstantGroup  =  0;
    mItemCount     =  0;
+   mMaxWidth      =  0;
    mSelectedItem  =  0;
    mStart         =  0;
    mTicksPassed   =  0;
@@ -453,9 +459,18 @@ GuiTreeViewCtrl::Item * GuiTreeViewCtrl::createItem(S32 icon)
    }
    else
    {
-      pNewItem = new Item( mProfile );
+      // carve from the current pool block
+      if( mItemBlocks.empty() || mItemBlockUsed == ItemBlockSize )
+      {
+         Item* pBlock = (Item*)dMalloc( sizeof(Item) * ItemBlockSize );
+
+         AssertFatal( pBlock != NULL, "Fatal : unable to allocate tree item block!");
+
+         mItemBlocks.push_back( pBlock );
+         mItemBlockUsed = 0;
+      }
 
-      AssertFatal( pNewItem != NULL, "Fatal : unable to allocate tree item!");
+      pNewItem = new( mItemBlocks.last() + mItemBlockUsed++ ) Item( mProfile );
 
       mItems.push_back( pNewItem );
 
@@ -472,6 +487,7 @@ GuiTreeViewCtrl::Item * GuiTreeViewCtrl::createItem(S32 icon)
    pNewItem->mState.clear();
    pNewItem->mState = 0;
    pNewItem->mTabLevel = 0;
+   pNewItem->mVisibleRow = -1;
 
    // Null out item pointers
    pNewItem->mNext = 0;
@@ -516,6 +532,7 @@ void GuiTreeViewCtrl::destroyItem(Item * item)
          pObject->deleteObject();
 
       item->setObject( NULL );
+      mInspectorItemCount--;
    }
    else
    {
@@ -567,7 +584,7 @@ void GuiTreeViewCtrl::destroyTree()
    {
       Item *pFreeItem = mItems[ i ];
       if( pFreeItem != NULL )
-         delete pFreeItem;
+         destructInPlace( pFreeItem );
    }
 
    mItems.clear();
@@ -576,10 +593,17 @@ void GuiTreeViewCtrl::destroyTree()
    while(mItemFreeList)
    {
       Item *next = mItemFreeList->mNext;
-      delete mItemFreeList;
+      destructInPlace( mItemFreeList );
       mItemFreeList = next;
    }
 
+   // release the pool
+   for(U32 i = 0; i < (U32)mItemBlocks.size(); i++)
+      dFree( mItemBlocks[ i ] );
+
+   mItemBlocks.clear();
+   mItemBlockUsed = 0;
+
    mVisibleItems.clear();
    mSelectedItems.clear();
 
@@ -587,13 +611,14 @@ void GuiTreeViewCtrl::destroyTree()
    mRoot          = NULL;
    mItemFreeList  = NULL;
    mItemCount     = 0;
+   mInspectorItemCount = 0;
    mSelectedItem  = 0;
    mDraggedToItem = 0;
 }
 
 //------------------------------------------------------------------------------
 
-void GuiTreeViewCtrl::buildItem( Item* item, U32 tabLevel, bool bForceFullUpdate )
+void GuiTreeViewCtrl::buildItem( Item* item, U32 tabLevel, Vector<Item*>& rows, bool bForceFullUpdate )
 {
    if (!item || !mActive || !isVisible() || !mProfile  )
       return;
@@ -614,20 +639,8 @@ void GuiTreeViewCtrl::buildItem( Item* item, U32 tabLevel, bool bForceFullUpdate
    }
 
    item->mTabLevel = tabLevel;
-   mVisibleItems.push_back( item );
-
-   if ( mProfile != NULL && mProfile->getFont(mFontSizeAdjust) )
-   {
-      S32 width = ( tabLevel + 1 ) * mTabSize + item->getDisplayTextWidth(mProfile->getFont(mFontSizeAdjust));
-      if ( mProfile->mBitmapArrayRects.size() > 0 )
-         width += mProfile->mBitmapArrayRects[0].extent.x;
-      
-      width += (item->mTabLevel+1) * mItemHeight; // using mItemHeight for icon width, close enough
-                                                  // this will only fail if somebody starts using super wide icons.
-
-      if ( width > mMaxWidth )
-         mMaxWidth = width;
-   }
+   rows.push_back( item );
+   updateItemWidth( item );
 
    // if expanded, then add all the children items as well
   if ( item->isExpanded() || bForceFullUpdate)
@@ -640,7 +653,7 @@ void GuiTreeViewCtrl::buildItem( Item* item, U32 tabLevel, bool bForceFullUpdate
          Item *pChildTemp = child;
          child = child->mNext;
 
-         buildItem( pChildTemp, tabLevel + 1, bForceFullUpdate );
+         buildItem( pChildTemp, tabLevel + 1, rows, bForceFullUpdate );
       }
    }
 }
@@ -664,13 +677,15 @@ void GuiTreeViewCtrl::buildVisibleTree(bool bForceFullUpdate)
    Item *traverse = mRoot;
    while(traverse)
    {
-      buildItem(traverse, 0, bForceFullUpdate);
+      buildItem(traverse, 0, mVisibleItems, bForceFullUpdate);
       traverse = traverse->mNext;
    }
 
+   for(S32 i = 0; i < mVisibleItems.size(); i++)
+      mVisibleItems[i]->mVisibleRow = i;
+
    // adjust the GuiArrayCtrl
-   mCellSize.set(mMaxWidth+1, mItemHeight);
-   setSize(Point2I(1, mVisibleItems.size()));
+   updateVisibleSize();
    syncSelection();
 
    // Done Recursing.
@@ -679,6 +694,162 @@ void GuiTreeViewCtrl::buildVisibleTree(bool bForceFullUpdate)
 
 //------------------------------------------------------------------------------
 
+void GuiTreeViewCtrl::updateItemWidth( Item* item )
+{
+   if ( mProfile == NULL )
+      return;
+
+   // The text width is cached on the item and refreshed when the row renders,
+   // so rows that are never on screen are never formatted.
+   S32 width = ( item->mTabLevel + 1 ) * mTabSize + item->mDataRenderWidth;
+   if ( mProfile->mBitmapArrayRects.size() > 0 )
+      width += mProfile->mBitmapArrayRects[0].extent.x;
+
+   width += (item->mTabLevel+1) * mItemHeight; // using mItemHeight for icon width, close enough
+                                               // this will only fail if somebody starts using super wide icons.
+
+   if ( width > mMaxWidth )
+      mMaxWidth = width;
+}
+
+void GuiTreeViewCtrl::updateVisibleSize()
+{
+   mCellSize.set(mMaxWidth+1, mItemHeight);
+   setSize(Point2I(1, mVisibleItems.size()));
+}
+
+//------------------------------------------------------------------------------
+
+S32 GuiTreeViewCtrl::findVisibleRow( Item* item ) const
+{
+   const S32 row = item->mVisibleRow;
+   if ( row >= 0 && row < mVisibleItems.size() && mVisibleItems[row] == item )
+      return row;
+
+   return -1;
+}
+
+S32 GuiTreeViewCtrl::getVisibleSubtreeEnd( Item* item ) const
+{
+   // The subtree ends at the row of the next item in tree order.  That item is
+   // visible whenever this one is, so a miss means the list is stale.
+   for ( Item* pTraverse = item; pTraverse != NULL; pTraverse = pTraverse->mParent )
+   {
+      if ( pTraverse->mNext != NULL )
+         return findVisibleRow( pTraverse->mNext );
+   }
+
+   return mVisibleItems.size();
+}
+
+void GuiTreeViewCtrl::spliceVisibleItem( Item* item, S32 row, S32 end )
+{
+   // Build the subtree aside.  Removals and additions made while building are
+   // picked up by the build itself, exactly as in a full rebuild.
+   mVisibleScratch.clear();
+   if ( item != NULL )
+   {
+      mFlags.set( BuildingVisTree, true );
+      buildItem( item, item->mParent ? item->mParent->mTabLevel + 1 : 0, mVisibleScratch );
+      mFlags.clear( BuildingVisTree );
+   }
+
+   // Replace the old rows with the new ones.
+   const S32 oldSize = mVisibleItems.size();
+   const S32 count = mVisibleScratch.size();
+   const S32 delta = count - ( end - row );
+
+   if ( delta > 0 )
+      mVisibleItems.setSize( oldSize + delta );
+
+   if ( delta != 0 )
+      dMemmove( mVisibleItems.address() + end + delta, mVisibleItems.address() + end, ( oldSize - end ) * sizeof(Item*) );
+
+   if ( delta < 0 )
+      mVisibleItems.setSize( oldSize + delta );
+
+   if ( count > 0 )
+      dMemcpy( mVisibleItems.address() + row, mVisibleScratch.address(), count * sizeof(Item*) );
+
+   // Renumber what moved.
+   const S32 renumberEnd = ( delta == 0 ) ? row + count : mVisibleItems.size();
+   for ( S32 i = row; i < renumberEnd; i++ )
+      mVisibleItems[i]->mVisibleRow = i;
+
+   updateVisibleSize();
+
+   // Only the spliced rows can be newly visible.
+   syncSelection( row, row + count );
+}
+
+void GuiTreeViewCtrl::refreshVisibleItem( Item* item )
+{
+   if ( mFlags.test( BuildingVisTree ) )
+      return;
+
+   // No item means the root level changed.
+   if ( item == NULL )
+   {
+      buildVisibleTree();
+      return;
+   }
+
+   // Not visible means it sits inside a collapsed parent.
+   const S32 row = findVisibleRow( item );
+   if ( row < 0 )
+      return;
+
+   const S32 end = getVisibleSubtreeEnd( item );
+   if ( end < row )
+   {
+      buildVisibleTree();
+      return;
+   }
+
+   spliceVisibleItem( item, row, end );
+}
+
+void GuiTreeViewCtrl::insertVisibleItem( Item* item )
+{
+   if ( mFlags.test( BuildingVisTree ) )
+      return;
+
+   Item* pParent = item->mParent;
+   if ( pParent != NULL && ( !pParent->isExpanded() || findVisibleRow( pParent ) < 0 ) )
+      return;
+
+   const S32 row = getVisibleSubtreeEnd( item );
+   if ( row < 0 )
+   {
+      buildVisibleTree();
+      return;
+   }
+
+   spliceVisibleItem( item, row, row );
+}
+
+void GuiTreeViewCtrl::removeVisibleItem( Item* item )
+{
+   if ( mFlags.test( BuildingVisTree ) )
+      return;
+
+   const S32 row = findVisibleRow( item );
+   if ( row < 0 )
+      return;
+
+   // Rows go before the item is unlinked.  If they can't be found, rebuild once it's gone.
+   const S32 end = getVisibleSubtreeEnd( item );
+   if ( end < row )
+   {
+      mFlags.set( RebuildVisible );
+      return;
+   }
+
+   spliceVisibleItem( NULL, row, end );
+}
+
+//------------------------------------------------------------------------------
+
 bool GuiTreeViewCtrl::scrollVisible( S32 itemId )
 {
    Item* item = getItem(itemId);
@@ -691,12 +862,16 @@ bool GuiTreeViewCtrl::scrollVisible( Item *item )
 {
    // Now, make sure it's visible (ie, all parents expanded)
    Item *parent = item->mParent;
+   Item *pCollapsed = NULL;
 
    if( !item->isInspectorData() && item->mState.test(Item::VirtualParent) )
       onVirtualParentExpand(item);
 
    while(parent)
    {
+      if( !parent->isExpanded() )
+         pCollapsed = parent;
+
       parent->setExpanded(true);
 
       if( !parent->isInspectorData() && parent->mState.test(Item::VirtualParent) )
@@ -714,17 +889,24 @@ bool GuiTreeViewCtrl::scrollVisible( Item *item )
       return false;
    }
 
-   // And now, build the visible tree so we know where we have to scroll.
-   buildVisibleTree();
+   // And now, splice in whatever we opened so we know where we have to scroll.
+   if( pCollapsed != NULL )
+      refreshVisibleItem( pCollapsed );
+   else if( !item->isInspectorData() && item->mState.test(Item::VirtualParent) )
+      refreshVisibleItem( item );
+
+   S32 row = findVisibleRow( item );
+   if( row < 0 )
+   {
+      buildVisibleTree();
+      row = findVisibleRow( item );
+   }
 
    // All done, let's figure out where we have to scroll...
-   for(S32 i=0; i<mVisibleItems.size(); i++)
+   if( row >= 0 )
    {
-      if(mVisibleItems[i] == item)
-      {
-         pScrollParent->scrollRectVisible(RectI(0, i * mItemHeight, mMaxWidth, mItemHeight));
-         return true;
-      }
+      pScrollParent->scrollRectVisible(RectI(0, row * mItemHeight, mMaxWidth, mItemHeight));
+      return true;
    }
 
    // If we got here, it's probably bad...
@@ -790,8 +972,6 @@ S32 GuiTreeViewCtrl::insertItem(S32 parentId, const char * text, const char * va
       }
       else
          mRoot = pNewItem;
-
-      mFlags.set(RebuildVisible);
    }
    else if( mItems.size() >= ( parentId - 1 ) )
    {
@@ -811,14 +991,10 @@ S32 GuiTreeViewCtrl::insertItem(S32 parentId, const char * text, const char * va
          pParentItem->mChild = pNewItem;
 
       pNewItem->mParent = pParentItem;
-
-      if( pParentItem->isExpanded() )
-         mFlags.set(RebuildVisible);
    }
 
    //
-   if(mFlags.test(RebuildVisible))
-      buildVisibleTree();
+   insertVisibleItem( pNewItem );
 
    return pNewItem->mId;
 }
@@ -841,6 +1017,9 @@ bool GuiTreeViewCtrl::removeItem(S32 itemId)
       return false;
    }
 
+   // Drop its rows while it's still linked.
+   removeVisibleItem(item);
+
    // root?
    if(item == mRoot)
       mRoot = item->mNext;
@@ -852,8 +1031,9 @@ bool GuiTreeViewCtrl::removeItem(S32 itemId)
    // Kill the item...
    destroyItem(item);
 
-   // Update the rendered tree...
-   buildVisibleTree();
+   // Update the rendered tree if the rows couldn't be spliced out...
+   if(mFlags.test(RebuildVisible))
+      buildVisibleTree();
 
    return true;
 }
@@ -865,6 +1045,7 @@ void GuiTreeViewCtrl::removeAllChildren(S32 itemId)
    if(item)
    {
       destroyChildren(item->mChild, item);
+      refreshVisibleItem(item);
    }
 }
 //------------------------------------------------------------------------------
@@ -1006,7 +1187,7 @@ void GuiTreeViewCtrl::moveItemUp( S32 itemId )
          pParentSet->reOrder(pItem->getObject(), pTraverse->getObject());
    }
 
-   buildVisibleTree();
+   refreshVisibleItem( pParent );
 }
 void GuiTreeViewCtrl::moveItemDown( S32 itemId )
 {
@@ -1032,6 +1213,8 @@ void GuiTreeViewCtrl::moveItemDown( S32 itemId )
       item->mPrevious->mNext = nextItem;
    else if ( item->mParent )
       item->mParent->mChild = nextItem;
+   else if ( item == mRoot )
+      mRoot = nextItem;
 
    item->mNext = nextItem->mNext;
    nextItem->mPrevious = item->mPrevious;
@@ -1046,18 +1229,18 @@ void GuiTreeViewCtrl::moveItemDown( S32 itemId )
    SimSet *parentSet = NULL;
 
    // grab the current parentSet if there is any...
-   if(item->mParent->isInspectorData())
+   if(item->mParent && item->mParent->isInspectorData())
       parentSet = dynamic_cast<SimSet*>(item->mParent->getObject());
    else
    {
       // parent is probably script data so we search up the tree for a
       // set to put our object in
       Item * temp = item->mParent;
-      while (!temp->isInspectorData())
+      while (temp != NULL && !temp->isInspectorData())
          temp = temp->mParent;
 
       // found an ancestor who is an inspectorData?
-      parentSet = temp->isInspectorData() ? dynamic_cast<SimSet*>(temp->getObject()) : NULL;
+      parentSet = temp != NULL ? dynamic_cast<SimSet*>(temp->getObject()) : NULL;
    }
 
    // Reorder the item and make sure that the children of the item get updated
@@ -1078,7 +1261,7 @@ void GuiTreeViewCtrl::moveItemDown( S32 itemId )
          parentSet->reOrder(temp->getObject(), item->getObject());
    }
 
-     buildVisibleTree();
+   refreshVisibleItem( item->mParent );
 }
 
 
@@ -1188,13 +1371,20 @@ void GuiTreeViewCtrl::onPreRender()
 
    mTicksPassed++;
 
-   if( mTicksPassed > mTreeRefreshInterval ) 
+   // Inspector items mirror SimSets that change behind our back, so only
+   // those trees resync periodically.  Script items keep the list current.
+   if( mFlags.test( RebuildVisible ) || ( mInspectorItemCount > 0 && mTicksPassed > mTreeRefreshInterval ) )
    {
       // Update every render in case new objects are added
       buildVisibleTree();
 
       mTicksPassed = 0;
    }
+   else if( mCellSize.x != mMaxWidth + 1 )
+   {
+      // A row measured while rendering widened the tree.
+      updateVisibleSize();
+   }
 
 }
 
@@ -1284,10 +1474,15 @@ void GuiTreeViewCtrl::setInstantGroup(SimObject * obj)
 }
 
 void GuiTreeViewCtrl::syncSelection()
+{
+   syncSelection( 0, mVisibleItems.size() );
+}
+
+void GuiTreeViewCtrl::syncSelection( S32 start, S32 end )
 {
    // for each visible item check to see if it is on the mSelected list.
    // if it is then make sure that it is on the mSelectedItems list as well.
-   for (S32 i = 0; i < mVisibleItems.size(); i++) 
+   for (S32 i = start; i < end; i++) 
    {
       for (S32 j = 0; j < mSelected.size(); j++) 
       {
@@ -1625,8 +1820,7 @@ bool GuiTreeViewCtrl::setItemSelected(S32 itemId, bool select)
                else
                {
                   // It's a zombie, blast it.
-                  mItems.erase(i);
-                  i--;
+                  removeItem(mItems[i]->mId);
                }
             }
          }
@@ -1694,14 +1888,21 @@ bool GuiTreeViewCtrl::setItemExpanded(S32 itemId, bool expand)
    // expand parents
    if(expand)
    {
+      Item * pCollapsed = NULL;
       while(item)
       {
          if(item->mState.test(Item::VirtualParent))
             onVirtualParentExpand(item);
 
+         if(!item->isExpanded())
+            pCollapsed = item;
+
          item->setExpanded(true);
          item = item->mParent;
       }
+
+      if(pCollapsed)
+         refreshVisibleItem(pCollapsed);
    }
    else
    {
@@ -1709,6 +1910,7 @@ bool GuiTreeViewCtrl::setItemExpanded(S32 itemId, bool expand)
          onVirtualParentCollapse(item);
 
       item->setExpanded(false);
+      refreshVisibleItem(item);
    }
    return(true);
 }
@@ -1785,7 +1987,8 @@ bool GuiTreeViewCtrl::editItem( S32 itemId, const char* newText, const char* new
    dStrcpy( item->getValue(), newValue );
 
    // Update the widths and such:
-   buildVisibleTree();
+   updateItemWidth( item );
+   updateVisibleSize();
    return true;
 }
 
@@ -2871,6 +3074,7 @@ void GuiTreeViewCtrl::onTouchDown(const GuiEvent & event)
       item->setExpanded(!item->isExpanded());
       if( !item->isInspectorData() && item->mState.test(Item::VirtualParent) )
          onVirtualParentExpand(item);
+      refreshVisibleItem(item);
       scrollVisible(item);
    }
 }
@@ -3192,8 +3396,16 @@ void GuiTreeViewCtrl::onRenderCell(Point2I offset, Point2I cell, bool, bool )
    displayText[bufLen-1] = 0;
    item->getDisplayText(bufLen, displayText);
 
+   // Rows are measured as they come on screen; widen the tree if this one grew.
+   const S32 textWidth = mProfile->getFont(mFontSizeAdjust)->getStrWidth( displayText );
+   if ( textWidth != item->mDataRenderWidth )
+   {
+      item->mDataRenderWidth = textWidth;
+      updateItemWidth( item );
+   }
+
    // Draw the rollover/selected bitmap, if one was specified.
-   drawRect.extent.x = mProfile->getFont(mFontSizeAdjust)->getStrWidth( displayText ) + ( 2 * mTextOffset );
+   drawRect.extent.x = textWidth + ( 2 * mTextOffset );
    if ( item->mState.test( Item::Selected ) && mTexSelected )
       dglDrawBitmapStretch( mTexSelected, drawRect );
    else if ( item->mState.test( Item::MouseOverText ) && mTexRollover )
@@ -3298,6 +3510,7 @@ void GuiTreeViewCtrl::addInspectorDataItem(Item *parent, SimObject *obj)
 
    // Actually store the data!
    item->setObject(obj);
+   mInspectorItemCount++;
 
    // Now add us to the data structure...
    if(parent)
@@ -3325,10 +3538,7 @@ void GuiTreeViewCtrl::addInspectorDataItem(Item *parent, SimObject *obj)
       item->mParent = NULL;
    }
 
-   if(!parent || parent->isExpanded())
-      mFlags.set(RebuildVisible);
-
-   buildVisibleTree();
+   insertVisibleItem(item);
 
 }
 
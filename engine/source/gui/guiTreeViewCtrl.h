@@ -63,8 +63,10 @@ class GuiTreeViewCtrl : public GuiArrayCtrl
 
          BitSet32                mState;
          SimObjectPtr<GuiControlProfile> mProfile;
-         S16                     mId;
+         S32                     mId;
          U16                     mTabLevel;
+         S32                     mVisibleRow; ///< Row in the visible list, only trusted
+                                              ///  if that row still holds this item.
          Item *                  mParent;
          Item *                  mChild;
          Item *                  mNext;
@@ -99,7 +101,7 @@ class GuiTreeViewCtrl : public GuiArrayCtrl
          const S8 getExpandedImage() const;
          char *getText();
          char *getValue();
-         inline const S16 getID() const { return mId; };
+         inline const S32 getID() const { return mId; };
          SimObject *getObject();
          const U32 getDisplayTextLength();
          const S32 getDisplayTextWidth(GFont *font);
@@ -175,6 +177,7 @@ protected:
   		enum
 		{
          MaxIcons = 32,
+         ItemBlockSize = 256, ///< Items allocated per pool block.
 		};
 
       enum Icons
@@ -243,6 +246,9 @@ public:
                                              ///  we want to be able to recycle
                                              ///  item ids and do some other clever
                                              ///  things.
+      Vector<Item*>           mItemBlocks;   ///< Pool blocks the items are carved from.
+      U32                     mItemBlockUsed;
+      S32                     mInspectorItemCount;
       Item *                  mRoot;
       S32                     mInstantGroup;
       S32                     mMaxWidth;
@@ -258,6 +264,9 @@ protected:
       // for debugging
       bool mDebug;
 
+      /// Rows built for a single subtree splice.
+      Vector<Item*> mVisibleScratch;
+
       S32               mTabSize;
       S32               mTextOffset;
       bool              mFullRowSelect;
@@ -294,7 +303,21 @@ protected:
 
       void deleteItem(Item *item);
 
-      void buildItem(Item * item, U32 tabLevel, bool bForceFullUpdate = false);
+      void buildItem(Item * item, U32 tabLevel, Vector<Item*>& rows, bool bForceFullUpdate = false);
+
+      /// @name Visible List Maintenance
+      /// These splice single subtrees into the visible list rather than rebuilding it.
+      /// @{
+
+      S32 findVisibleRow(Item * item) const;
+      S32 getVisibleSubtreeEnd(Item * item) const;
+      void spliceVisibleItem(Item * item, S32 row, S32 end);
+      void refreshVisibleItem(Item * item);
+      void insertVisibleItem(Item * item);
+      void removeVisibleItem(Item * item);
+      void updateItemWidth(Item * item);
+      void updateVisibleSize();
+      /// @}
 
       bool hitTest(const Point2I & pnt, Item* & item, BitSet32 & flags);
 
@@ -312,6 +335,9 @@ protected:
       /// Used for syncing the mSelected and mSelectedItems lists.
       void syncSelection();
 
+      /// Syncs the selection for the visible rows [start, end) only.
+      void syncSelection( S32 start, S32 end );
+
       void lockSelection(bool lock);
       void hideSelection(bool hide);
       void addSelection(S32 itemId);
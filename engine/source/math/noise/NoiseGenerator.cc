@@ -24,6 +24,21 @@
 #include "NoiseGenerator.h"
 #endif
 
+#ifndef _GBITMAP_H_
+#include "graphics/gBitmap.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+#ifndef _FILESTREAM_H_
+#include "io/fileStream.h"
+#endif
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
 // Script bindings.
 #include "NoiseGenerator_ScriptBinding.h"
 
@@ -33,10 +48,30 @@ IMPLEMENT_CONOBJECT(NoiseGenerator);
 
 //------------------------------------------------------------------------------
 
+// Fewest rows worth handing to a worker thread.
+static const U32 k_minBandRows = 16;
+
+// Most samples a script generated field may hold (64MB of samples).
+static const U32 k_maxFieldSamples = 4096 * 4096;
+
+struct NoiseFieldBand
+{
+	const NoiseGenerator*			mpGenerator;
+	const NoiseGenerator::FieldDesc*	mpDesc;
+	U32								mWidth;
+	U32								mRowStart;
+	U32								mRowEnd;
+	F32*							mpField;
+};
+
+//------------------------------------------------------------------------------
+
 NoiseGenerator::NoiseGenerator() :
-	mSeed(0)
+	mSeed(0),
+	mFieldWidth(0),
+	mFieldHeight(0)
 {
-	
+	VECTOR_SET_ASSOCIATION(mField);
 }
 
 //------------------------------------------------------------------------------
@@ -77,4 +112,281 @@ F64 NoiseGenerator::getComplexNoise(F64 x, F64 y, S32 octaves, F64 persistence)
     }
 
     return total / maxValue;
-}
\ No newline at end of file
+}
+
+//------------------------------------------------------------------------------
+
+void NoiseGenerator::generateField(const FieldDesc& desc, const U32 width, const U32 height, F32* pField) const
+{
+	// Debug Profiling.
+	PROFILE_SCOPE(NoiseGenerator_GenerateField);
+
+	if (width == 0 || height == 0)
+		return;
+
+#if defined(TORQUE_OS_EMSCRIPTEN)
+	// No threads so generate everything here.
+	const U32 workerCount = 0;
+#else
+	const U32 workerCount = (U32)mClamp(Con::getIntVariable("$pref::T2D::noiseWorkerThreads", 4), 0, 8);
+#endif
+
+	// Split the rows into bands, keeping small fields on this thread.
+	const U32 bandCount = getMax(getMin(workerCount + 1, height / k_minBandRows), (U32)1);
+	const U32 bandRows = (height + bandCount - 1) / bandCount;
+
+	Vector<NoiseFieldBand> bands;
+	bands.setSize(bandCount);
+	for (U32 i = 0; i < bandCount; i++)
+	{
+		NoiseFieldBand& band = bands[i];
+		band.mpGenerator = this;
+		band.mpDesc = &desc;
+		band.mWidth = width;
+		band.mRowStart = getMin(i * bandRows, height);
+		band.mRowEnd = getMin(band.mRowStart + bandRows, height);
+		band.mpField = pField;
+	}
+
+	// Hand every band but the first to a worker.
+	Vector<Thread*> workers;
+	for (U32 i = 1; i < bandCount; i++)
+		workers.push_back(new Thread(&NoiseGenerator::generateBand, &bands[i], true));
+
+	generateBand(&bands[0]);
+
+	for (S32 i = 0; i < workers.size(); i++)
+	{
+		workers[i]->join();
+		delete workers[i];
+	}
+}
+
+//------------------------------------------------------------------------------
+
+void NoiseGenerator::generateBand(void* pBand)
+{
+	const NoiseFieldBand* pFieldBand = static_cast<const NoiseFieldBand*>(pBand);
+	pFieldBand->mpGenerator->generateRows(*pFieldBand->mpDesc, pFieldBand->mWidth, pFieldBand->mRowStart, pFieldBand->mRowEnd, pFieldBand->mpField);
+}
+
+//------------------------------------------------------------------------------
+
+void NoiseGenerator::generateRows(const FieldDesc& desc, const U32 width, const U32 rowStart, const U32 rowEnd, F32* pField) const
+{
+	// Same limits as getComplexNoise().
+	const S32 octaves = mClamp(desc.mOctaves, 1, 8);
+	const F32 persistence = mClampF(desc.mPersistence, 0.05f, 0.95f);
+	const bool warp = mNotZero(desc.mWarpStrength);
+
+	// Row scratch.
+	Vector<F32> positionX;
+	Vector<F32> positionY;
+	Vector<F32> sampleX;
+	Vector<F32> sampleY;
+	Vector<F32> noise;
+	Vector<F32> warpX;
+	positionX.setSize(width);
+	positionY.setSize(width);
+	sampleX.setSize(width);
+	sampleY.setSize(width);
+	noise.setSize(width);
+	warpX.setSize(width);
+
+	F32* pX = positionX.address();
+	F32* pY = positionY.address();
+	F32* pSampleX = sampleX.address();
+	F32* pSampleY = sampleY.address();
+	F32* pNoise = noise.address();
+
+	for (U32 row = rowStart; row < rowEnd; row++)
+	{
+		F32* pRow = pField + row * width;
+
+		const F32 y = desc.mOriginY + row * desc.mStepY;
+		for (U32 i = 0; i < width; i++)
+		{
+			pX[i] = desc.mOriginX + i * desc.mStepX;
+			pY[i] = y;
+		}
+
+		// Domain warp with two decorrelated samples.
+		if (warp)
+		{
+			for (U32 i = 0; i < width; i++)
+			{
+				pSampleX[i] = pX[i] * desc.mWarpFrequency;
+				pSampleY[i] = pY[i] * desc.mWarpFrequency;
+			}
+			mPerlin.noiseBatch(pSampleX, pSampleY, 0.2f, width, warpX.address());
+
+			for (U32 i = 0; i < width; i++)
+			{
+				pSampleX[i] += 5.2f;
+				pSampleY[i] += 1.3f;
+			}
+			mPerlin.noiseBatch(pSampleX, pSampleY, 0.2f, width, pNoise);
+
+			for (U32 i = 0; i < width; i++)
+			{
+				pX[i] += desc.mWarpStrength * (warpX[i] * 2.0f - 1.0f);
+				pY[i] += desc.mWarpStrength * (pNoise[i] * 2.0f - 1.0f);
+			}
+		}
+
+		// Octaves.
+		F32 frequency = 1.0f;
+		F32 amplitude = 1.0f;
+		F32 maxValue = 0.0f;
+		for (S32 octave = 0; octave < octaves; octave++)
+		{
+			for (U32 i = 0; i < width; i++)
+			{
+				pSampleX[i] = pX[i] * frequency;
+				pSampleY[i] = pY[i] * frequency;
+			}
+			mPerlin.noiseBatch(pSampleX, pSampleY, 0.2f * frequency, width, pNoise);
+
+			if (octave == 0)
+			{
+				for (U32 i = 0; i < width; i++)
+					pRow[i] = pNoise[i] * amplitude;
+			}
+			else
+			{
+				for (U32 i = 0; i < width; i++)
+					pRow[i] += pNoise[i] * amplitude;
+			}
+
+			maxValue += amplitude;
+			amplitude *= persistence;
+			frequency *= 2.0f;
+		}
+
+		// Normalize to 0.0 - 1.0.
+		const F32 scale = 1.0f / maxValue;
+		for (U32 i = 0; i < width; i++)
+			pRow[i] *= scale;
+	}
+}
+
+//------------------------------------------------------------------------------
+
+bool NoiseGenerator::generateBitmap(const FieldDesc& desc, GBitmap* pBitmap) const
+{
+	// Debug Profiling.
+	PROFILE_SCOPE(NoiseGenerator_GenerateBitmap);
+
+	if (pBitmap == NULL)
+		return false;
+
+	const GBitmap::BitmapFormat format = pBitmap->getFormat();
+	if (format != GBitmap::RGB && format != GBitmap::RGBA && format != GBitmap::Alpha && format != GBitmap::Luminance && format != GBitmap::Intensity)
+	{
+		Con::warnf("NoiseGenerator::generateBitmap() - Unsupported bitmap format '%d'.", format);
+		return false;
+	}
+
+	const U32 width = pBitmap->getWidth();
+	const U32 height = pBitmap->getHeight();
+
+	Vector<F32> field;
+	field.setSize(width * height);
+	generateField(desc, width, height, field.address());
+
+	// Write the samples as grey levels.
+	const U32 bytesPerPixel = pBitmap->bytesPerPixel;
+	const F32* pSample = field.address();
+	for (U32 y = 0; y < height; y++)
+	{
+		U8* pTexel = pBitmap->getAddress(0, y);
+		for (U32 x = 0; x < width; x++)
+		{
+			const U8 level = (U8)mClamp((S32)(*pSample++ * 255.0f + 0.5f), 0, 255);
+
+			if (bytesPerPixel == 1)
+			{
+				*pTexel++ = level;
+			}
+			else
+			{
+				pTexel[0] = level;
+				pTexel[1] = level;
+				pTexel[2] = level;
+				if (bytesPerPixel == 4)
+					pTexel[3] = 255;
+				pTexel += bytesPerPixel;
+			}
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------
+
+bool NoiseGenerator::createField(const FieldDesc& desc, const U32 width, const U32 height)
+{
+	// Check the size before it can overflow the sample count.
+	if (width == 0 || height == 0 || (U64)width * (U64)height > (U64)k_maxFieldSamples)
+	{
+		Con::warnf("NoiseGenerator::createField() - Invalid field size of %dx%d, the field can hold at most %d samples.", width, height, k_maxFieldSamples);
+		return false;
+	}
+
+	mFieldWidth = width;
+	mFieldHeight = height;
+	mField.setSize(width * height);
+
+	generateField(desc, width, height, mField.address());
+
+	return true;
+}
+
+//------------------------------------------------------------------------------
+
+F32 NoiseGenerator::getFieldValue(const U32 x, const U32 y) const
+{
+	if (x >= mFieldWidth || y >= mFieldHeight)
+	{
+		Con::warnf("NoiseGenerator::getFieldValue() - Position (%d,%d) is outside the %dx%d field.", x, y, mFieldWidth, mFieldHeight);
+		return 0.0f;
+	}
+
+	return mField[y * mFieldWidth + x];
+}
+
+//------------------------------------------------------------------------------
+
+bool NoiseGenerator::saveFieldImage(const char* pFileName) const
+{
+	if (mField.size() == 0)
+	{
+		Con::warnf("NoiseGenerator::saveFieldImage() - No field has been generated.");
+		return false;
+	}
+
+	// Write the samples as grey levels.
+	GBitmap bitmap(mFieldWidth, mFieldHeight, false, GBitmap::RGB);
+	const F32* pSample = mField.address();
+	for (U32 y = 0; y < mFieldHeight; y++)
+	{
+		U8* pTexel = bitmap.getAddress(0, y);
+		for (U32 x = 0; x < mFieldWidth; x++)
+		{
+			const U8 level = (U8)mClamp((S32)(*pSample++ * 255.0f + 0.5f), 0, 255);
+			*pTexel++ = level;
+			*pTexel++ = level;
+			*pTexel++ = level;
+		}
+	}
+
+	FileStream stream;
+	if (!ResourceManager->openFileForWrite(stream, pFileName))
+	{
+		Con::warnf("NoiseGenerator::saveFieldImage() - Failed to open '%s' for writing.", pFileName);
+		return false;
+	}
+
+	return bitmap.writePNG(stream);
+}
@@ -37,14 +37,49 @@
 
 //-----------------------------------------------------------------------------
 
+class GBitmap;
+
+//-----------------------------------------------------------------------------
+
 class NoiseGenerator : public ScriptObject
 {
 	typedef ScriptObject			Parent;
 
+public:
+	/// A rectangular grid of samples with optional octaves and domain warp.
+	struct FieldDesc
+	{
+		FieldDesc() :
+			mOriginX(0.0f),
+			mOriginY(0.0f),
+			mStepX(1.0f),
+			mStepY(1.0f),
+			mOctaves(1),
+			mPersistence(0.5f),
+			mWarpStrength(0.0f),
+			mWarpFrequency(1.0f)
+		{
+		}
+
+		F32							mOriginX;
+		F32							mOriginY;
+		F32							mStepX;
+		F32							mStepY;
+		S32							mOctaves;
+		F32							mPersistence;
+		F32							mWarpStrength;
+		F32							mWarpFrequency;
+	};
+
 private:
 	PerlinNoise					mPerlin;
 	U32							mSeed;
 
+	/// Field generated from script.
+	Vector<F32>					mField;
+	U32							mFieldWidth;
+	U32							mFieldHeight;
+
 public:
 	NoiseGenerator();
 	virtual ~NoiseGenerator();
@@ -53,10 +88,23 @@ public:
 	F64 getNoise(F64 x, F64 y);
 	F64 getComplexNoise(F64 x, F64 y, S32 octaves, F64 persistence);
 
+	/// Bulk generation.  Rows are split across worker threads.
+	void generateField(const FieldDesc& desc, const U32 width, const U32 height, F32* pField) const;
+	bool generateBitmap(const FieldDesc& desc, GBitmap* pBitmap) const;
+
+	/// Script field.
+	bool createField(const FieldDesc& desc, const U32 width, const U32 height);
+	F32 getFieldValue(const U32 x, const U32 y) const;
+	inline U32 getFieldWidth(void) const { return mFieldWidth; }
+	inline U32 getFieldHeight(void) const { return mFieldHeight; }
+	bool saveFieldImage(const char* pFileName) const;
+
 	/// Declare Console Object.
 	DECLARE_CONOBJECT(NoiseGenerator);
 
 private:
+	void generateRows(const FieldDesc& desc, const U32 width, const U32 rowStart, const U32 rowEnd, F32* pField) const;
+	static void generateBand(void* pBand);
 
 protected:
 };
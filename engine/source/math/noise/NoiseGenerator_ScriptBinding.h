@@ -80,4 +80,97 @@ ConsoleMethodWithDocs(NoiseGenerator, getComplexNoise, ConsoleFloat, 6, 6, (floa
 	}
 }
 
+//------------------------------------------------------------------------------
+
+/*! Generates a field of noise in one call, replacing any previous field.
+* @param width The number of samples across the field.
+* @param height The number of samples down the field.
+* @param originX The x position of the first sample.
+* @param originY The y position of the first sample.
+* @param stepX The x distance between samples.
+* @param stepY The y distance between samples.
+* @param octaves An optional integer value between 1 and 8.  Defaults to 1.
+* @param persistence An optional decimal value between 0.05 and 0.95.  Defaults to 0.5.
+* @param warpStrength An optional distance each sample is displaced by a warp noise before sampling.  Defaults to 0 (no warp).
+* @param warpFrequency An optional frequency of the warp noise.  Defaults to 1.
+@return No return value.
+*/
+ConsoleMethodWithDocs(NoiseGenerator, generateField, ConsoleVoid, 8, 12, (int width, int height, float originX, float originY, float stepX, float stepY, [int octaves], [float persistence], [float warpStrength], [float warpFrequency]))
+{
+	const S32 width = dAtoi(argv[2]);
+	const S32 height = dAtoi(argv[3]);
+
+	if (width <= 0 || height <= 0)
+	{
+		Con::warnf("NoiseGenerator::generateField() - Invalid field size of %dx%d.", width, height);
+		return;
+	}
+
+	NoiseGenerator::FieldDesc desc;
+	desc.mOriginX = dAtof(argv[4]);
+	desc.mOriginY = dAtof(argv[5]);
+	desc.mStepX = dAtof(argv[6]);
+	desc.mStepY = dAtof(argv[7]);
+
+	if (argc > 8)
+		desc.mOctaves = dAtoi(argv[8]);
+
+	if (argc > 9)
+		desc.mPersistence = dAtof(argv[9]);
+
+	if (argc > 10)
+		desc.mWarpStrength = dAtof(argv[10]);
+
+	if (argc > 11)
+		desc.mWarpFrequency = dAtof(argv[11]);
+
+	object->createField(desc, (U32)width, (U32)height);
+}
+
+//------------------------------------------------------------------------------
+
+/*! Returns a sample from the generated field.
+* @param x The column of the sample.
+* @param y The row of the sample.
+@return A decimal value between 0 and 1.
+*/
+ConsoleMethodWithDocs(NoiseGenerator, getFieldValue, ConsoleFloat, 4, 4, (int x, int y))
+{
+	return object->getFieldValue((U32)dAtoi(argv[2]), (U32)dAtoi(argv[3]));
+}
+
+//------------------------------------------------------------------------------
+
+/*! Gets the width of the generated field.
+@return The number of samples across the field.
+*/
+ConsoleMethodWithDocs(NoiseGenerator, getFieldWidth, ConsoleInt, 2, 2, ())
+{
+	return object->getFieldWidth();
+}
+
+//------------------------------------------------------------------------------
+
+/*! Gets the height of the generated field.
+@return The number of samples down the field.
+*/
+ConsoleMethodWithDocs(NoiseGenerator, getFieldHeight, ConsoleInt, 2, 2, ())
+{
+	return object->getFieldHeight();
+}
+
+//------------------------------------------------------------------------------
+
+/*! Saves the generated field as a greyscale PNG image.
+* @param file The image file to write.
+@return Whether the image was saved or not.
+*/
+ConsoleMethodWithDocs(NoiseGenerator, saveFieldImage, ConsoleBool, 3, 3, (string file))
+{
+	char buffer[1024];
+	Con::expandPath(buffer, sizeof(buffer), argv[2]);
+
+	return object->saveFieldImage(buffer);
+}
+
 ConsoleMethodGroupEndWithDocs(NoiseGenerator)
\ No newline at end of file
@@ -37,6 +37,9 @@
 #include "platform/threads/mutex.h"
 #include "collection/simpleHashTable.h"
 #include "memory/safeDelete.h"
+#include "debug/profiler.h"
+
+#include <atomic>
 
 #include "dispatcher_ScriptBinding.h"
 
@@ -63,6 +66,11 @@ void IMessageListener::onAddToQueue(StringTableEntry queue)
    mQueues.push_back(queue);
 }
 
+bool IMessageListener::onPostedMessageReceived(StringTableEntry queue, const PostedMessage *msg)
+{
+   return onMessageReceived(queue, msg->mMessage, msg->formatData());
+}
+
 void IMessageListener::onRemoveFromQueue(StringTableEntry queue)
 {
    for(S32 i = 0;i < mQueues.size();i++)
@@ -75,10 +83,72 @@ void IMessageListener::onRemoveFromQueue(StringTableEntry queue)
    }
 }
 
+//////////////////////////////////////////////////////////////////////////
+// PostedMessage Methods
+//////////////////////////////////////////////////////////////////////////
+
+const char *PostedMessage::formatData() const
+{
+   switch(mType)
+   {
+      case PayloadInteger:
+      case PayloadFloat:
+      {
+         const U32 count = mSize / sizeof(U32);
+         char *buffer = Con::getReturnBuffer(count * 16 + 1);
+         char *write = buffer;
+         *write = 0;
+
+         for(U32 i = 0;i < count;i++)
+         {
+            const char *separator = i ? " " : "";
+            if(mType == PayloadInteger)
+               write += dSprintf(write, 16, "%s%d", separator, ((const S32 *)getData())[i]);
+            else
+               write += dSprintf(write, 16, "%s%g", separator, ((const F32 *)getData())[i]);
+         }
+         return buffer;
+      }
+
+      case PayloadString:
+         return (const char *)getData();
+
+      case PayloadBinary:
+      {
+         static const char hexDigits[] = "0123456789ABCDEF";
+         const U8 *bytes = (const U8 *)getData();
+         char *buffer = Con::getReturnBuffer(mSize * 2 + 1);
+         for(U32 i = 0;i < mSize;i++)
+         {
+            buffer[i * 2] = hexDigits[bytes[i] >> 4];
+            buffer[i * 2 + 1] = hexDigits[bytes[i] & 0xF];
+         }
+         buffer[mSize * 2] = 0;
+         return buffer;
+      }
+
+      default:
+         return "";
+   }
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Global State
 //////////////////////////////////////////////////////////////////////////
 
+/// Messages posted since the last processPostedMessages(), newest first.
+static std::atomic<PostedMessage *> gPostedMessages(NULL);
+
+static void freePostedMessages(PostedMessage *list)
+{
+   while(list)
+   {
+      PostedMessage *next = list->mNext;
+      dRealFree(list);
+      list = next;
+   }
+}
+
 //////////////////////////////////////////////////////////////////////////
 /// @brief Internal class used by the dispatcher
 //////////////////////////////////////////////////////////////////////////
@@ -94,6 +164,8 @@ static struct _DispatchData
 
    ~_DispatchData()
    {
+      freePostedMessages(gPostedMessages.exchange(NULL));
+
       if(Mutex::lockMutex( mMutex ) )
       {
          mQueues.clearTables();
@@ -280,6 +352,77 @@ bool dispatchMessageObject(const char *queue, Message *msg)
    return bResult;
 }
 
+//////////////////////////////////////////////////////////////////////////
+// Posted Messages
+//////////////////////////////////////////////////////////////////////////
+
+void postMessage(StringTableEntry queue, StringTableEntry msg, PostedMessage::PayloadType type, const void *data, U32 size)
+{
+   // Strings keep a terminator so they can be delivered in place
+   const U32 storedSize = type == PostedMessage::PayloadString ? size + 1 : size;
+
+   // The raw allocator is used as this can be called from any thread
+   PostedMessage *node = (PostedMessage *)dRealMalloc(sizeof(PostedMessage) + storedSize);
+   node->mQueue = queue;
+   node->mMessage = msg;
+   node->mType = type;
+   node->mSize = size;
+
+   U8 *payload = (U8 *)(node + 1);
+   if(size)
+      dMemcpy(payload, data, size);
+   if(type == PostedMessage::PayloadString)
+      payload[size] = 0;
+
+   // Push onto the list without locking
+   PostedMessage *head = gPostedMessages.load(std::memory_order_relaxed);
+   do
+   {
+      node->mNext = head;
+   } while(! gPostedMessages.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+}
+
+U32 processPostedMessages()
+{
+   // Take everything posted so far in one go
+   PostedMessage *list = gPostedMessages.exchange(NULL, std::memory_order_acquire);
+   if(list == NULL)
+      return 0;
+
+   PROFILE_SCOPE(Dispatcher_ProcessPostedMessages);
+
+   // The list is newest first so reverse it into posting order
+   PostedMessage *ordered = NULL;
+   while(list)
+   {
+      PostedMessage *next = list->mNext;
+      list->mNext = ordered;
+      ordered = list;
+      list = next;
+   }
+
+   U32 count = 0;
+   MutexHandle mh;
+   if(mh.lock(gDispatchData.mMutex, true))
+   {
+      for(PostedMessage *msg = ordered;msg;msg = msg->mNext)
+      {
+         MessageQueue *q = gDispatchData.mQueues.retrieve(msg->mQueue);
+         if(q == NULL)
+         {
+            Con::errorf("Dispatcher::processPostedMessages - Message '%s' was posted to unknown queue '%s'", msg->mMessage, msg->mQueue);
+            continue;
+         }
+
+         q->dispatchPostedMessage(msg);
+         count++;
+      }
+   }
+
+   freePostedMessages(ordered);
+   return count;
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Internal Functions
 //////////////////////////////////////////////////////////////////////////
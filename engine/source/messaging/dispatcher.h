@@ -55,6 +55,44 @@ namespace Dispatcher
 /// @addtogroup msgsys Message System
 // @{
 
+//////////////////////////////////////////////////////////////////////////
+/// @brief A typed message posted from any thread
+///
+/// The payload is stored directly after the header. Posted messages are
+/// delivered on the main thread by processPostedMessages().
+///
+/// @see postMessage()
+//////////////////////////////////////////////////////////////////////////
+struct PostedMessage
+{
+   enum PayloadType
+   {
+      PayloadNone,      ///< No payload
+      PayloadInteger,   ///< Array of S32
+      PayloadFloat,     ///< Array of F32
+      PayloadString,    ///< Terminated string
+      PayloadBinary     ///< Raw bytes
+   };
+
+   StringTableEntry mQueue;
+   StringTableEntry mMessage;
+   PayloadType mType;
+   U32 mSize;
+   PostedMessage *mNext;
+
+   const void *getData() const   { return this + 1; }
+
+   //////////////////////////////////////////////////////////////////////////
+   /// @brief Format the payload as a string for string based listeners
+   ///
+   /// Integers and floats are space separated, strings are returned as is
+   /// and binary payloads are hex encoded.
+   ///
+   /// @return Formatted payload in a console return buffer
+   //////////////////////////////////////////////////////////////////////////
+   const char *formatData() const;
+};
+
 //////////////////////////////////////////////////////////////////////////
 // Interface for objects that receive messages
 //////////////////////////////////////////////////////////////////////////
@@ -94,6 +132,20 @@ public:
    //////////////////////////////////////////////////////////////////////////
    virtual bool onMessageObjectReceived(StringTableEntry queue, Message *msg ) = 0;
 
+   //////////////////////////////////////////////////////////////////////////
+   /// @brief Callback for when posted messages are delivered
+   ///
+   /// The default implementation formats the payload and passes it to
+   /// onMessageReceived(). Listeners that understand the payload type can
+   /// override this to read it directly.
+   ///
+   /// @param queue The name of the queue the message was posted to
+   /// @param msg The posted message
+   /// @return false to prevent other listeners receiving this message, true otherwise
+   /// @see postMessage()
+   //////////////////////////////////////////////////////////////////////////
+   virtual bool onPostedMessageReceived(StringTableEntry queue, const PostedMessage *msg);
+
 
    //////////////////////////////////////////////////////////////////////////
    /// @brief Callback for when the listener is added to a queue
@@ -155,6 +207,16 @@ struct MessageQueue
       }
       return true;
    }
+
+   bool dispatchPostedMessage(const PostedMessage *msg)
+   {
+      for(VectorPtr<IMessageListener *>::iterator i = mListeners.begin();i != mListeners.end();i++)
+      {
+         if( !(*i)->onPostedMessageReceived(mQueueName, msg) )
+            return false;
+      }
+      return true;
+   }
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -234,6 +296,35 @@ extern bool dispatchMessage(const char *queue, const char *msg, const char *data
 //////////////////////////////////////////////////////////////////////////
 extern bool dispatchMessageObject(const char *queue, Message *msg);
 
+//////////////////////////////////////////////////////////////////////////
+/// @brief Post a typed message to a queue from any thread
+///
+/// The message is copied into a lock-free queue without taking the
+/// dispatcher mutex and is delivered on the main thread by
+/// processPostedMessages(). The queue and message names may be interned
+/// on any thread since the string table locks its own mutex, but that
+/// lock is shared with every other caller, so producers that post often
+/// should intern them once when they are set up rather than per message.
+///
+/// @param queue Interned name of the queue to post the message to
+/// @param msg Interned message name
+/// @param type Type of the payload
+/// @param data Payload, copied
+/// @param size Size of the payload in bytes
+/// @see processPostedMessages()
+//////////////////////////////////////////////////////////////////////////
+extern void postMessage(StringTableEntry queue, StringTableEntry msg, PostedMessage::PayloadType type, const void *data, U32 size);
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Deliver all posted messages. Main thread only.
+///
+/// Messages are delivered in the order they were posted by each thread.
+///
+/// @return Number of messages delivered
+/// @see postMessage()
+//////////////////////////////////////////////////////////////////////////
+extern U32 processPostedMessages();
+
 // @}
 
 //////////////////////////////////////////////////////////////////////////
@@ -46,11 +46,44 @@ Vector<EventManager*> EventManager::smEventManagers;
 // problems if more then one listener is registered with the queue.
 bool EventManagerListener::onMessageReceived( StringTableEntry queue, const char* event, const char* data )
 {
-   Vector<Subscriber>* subscribers = mSubscribers.retrieve( event );
-   if( subscribers == NULL )
+   // Events are interned when registered so an event that isn't in the string table can't be registered.
+   StringTableEntry eventName = StringTable->lookup( event );
+   if( eventName == NULL )
       return true;
 
-   for( Vector<Subscriber>::const_iterator iter = subscribers->begin(); iter != subscribers->end(); iter++ )
+   return dispatchEvent( getEvent( findEvent( eventName ) ), data );
+}
+
+//-----------------------------------------------------------------------------
+/// Delivers a posted event to its subscribers, formatting the payload once.
+//-----------------------------------------------------------------------------
+bool EventManagerListener::onPostedMessageReceived( StringTableEntry queue, const Dispatcher::PostedMessage* msg )
+{
+   const Event* event = getEvent( findEvent( msg->mMessage ) );
+   if( event == NULL || event->subscribers.size() == 0 )
+      return true;
+
+   return dispatchEvent( event, msg->formatData() );
+}
+
+//-----------------------------------------------------------------------------
+/// Finds the handle of a registered event.
+//-----------------------------------------------------------------------------
+S32 EventManagerListener::findEvent( StringTableEntry event ) const
+{
+   typeEventHandleHash::const_iterator itr = mEventHandles.find( event );
+   return itr != mEventHandles.end() ? itr->value : -1;
+}
+
+//-----------------------------------------------------------------------------
+/// Executes the callback on each subscriber to an event.
+//-----------------------------------------------------------------------------
+bool EventManagerListener::dispatchEvent( const Event* event, const char* data )
+{
+   if( event == NULL )
+      return true;
+
+   for( Vector<Subscriber>::const_iterator iter = event->subscribers.begin(); iter != event->subscribers.end(); iter++ )
    {
       // If we returned a string that is not "", try to convert it to true/false
       const char* conResult = Con::executef( iter->listener, 2, iter->callback, data );
@@ -117,17 +150,34 @@ void EventManager::setMessageQueue( const char* queue )
 //-----------------------------------------------------------------------------
 bool EventManager::isRegisteredEvent( const char* event )
 {
-   // Iterate over the event list.
-   StringTableEntry eventName = StringTable->insert( event );
-   for( Vector<StringTableEntry>::const_iterator iter = mEvents.begin(); iter != mEvents.end(); iter++ )
-   {
-      // Found.
-      if( *iter == eventName )
-         return true;
-   }
+   return getEventHandle( event ) != -1;
+}
+
+//-----------------------------------------------------------------------------
+/// Resolves an event to a handle.
+/// 
+/// @param event The event to resolve.
+/// @return The event handle or -1 if the event is not registered.
+//-----------------------------------------------------------------------------
+S32 EventManager::getEventHandle( const char* event )
+{
+   StringTableEntry eventName = StringTable->lookup( event );
+   if( eventName == NULL )
+      return -1;
 
-   // Not found.
-   return false;
+   return mListener.findEvent( eventName );
+}
+
+//-----------------------------------------------------------------------------
+/// Gets the name of an event from its handle.
+/// 
+/// @param handle The event handle.
+/// @return The interned event name or NULL if the handle is not valid.
+//-----------------------------------------------------------------------------
+StringTableEntry EventManager::getEventName( S32 handle )
+{
+   EventManagerListener::Event* event = mListener.getEvent( handle );
+   return event ? event->name : NULL;
 }
 
 //-----------------------------------------------------------------------------
@@ -145,11 +195,25 @@ bool EventManager::registerEvent( const char* event )
       return false;
    }
 
-   // Add to the event list.
-   mEvents.push_back( StringTable->insert( event ) );
+   // Create the event and its list of subscribers.
+   EventManagerListener::Event* newEvent = new EventManagerListener::Event;
+   newEvent->name = StringTable->insert( event );
+
+   // Reuse an empty slot if there is one.
+   S32 handle;
+   if( mListener.mFreeEvents.size() > 0 )
+   {
+      handle = mListener.mFreeEvents.last();
+      mListener.mFreeEvents.pop_back();
+      mListener.mEvents[handle] = newEvent;
+   }
+   else
+   {
+      handle = mListener.mEvents.size();
+      mListener.mEvents.push_back( newEvent );
+   }
 
-   // Create a list of subscribers for this event.
-   mListener.mSubscribers.insert( new Vector<EventManagerListener::Subscriber>, event );
+   mListener.mEventHandles.insert( newEvent->name, handle );
 
    return true;
 }
@@ -159,17 +223,14 @@ bool EventManager::registerEvent( const char* event )
 //-----------------------------------------------------------------------------
 void EventManager::unregisterAllEvents()
 {
-   // Iterate over all events.
-   for( Vector<StringTableEntry>::const_iterator iter = mEvents.begin(); iter != mEvents.end(); iter++ )
-   {
-      // Delete the subscriber list.
-      Vector<EventManagerListener::Subscriber>* subscribers = mListener.mSubscribers.remove( *iter );
-      if( subscribers )
-         delete subscribers;
-   }
+   // Delete all events and their subscriber lists.
+   for( Vector<EventManagerListener::Event*>::iterator iter = mListener.mEvents.begin(); iter != mListener.mEvents.end(); iter++ )
+      delete *iter;
 
    // Clear the event list.
-   mEvents.clear();
+   mListener.mEvents.clear();
+   mListener.mEventHandles.clear();
+   mListener.mFreeEvents.clear();
 }
 
 //-----------------------------------------------------------------------------
@@ -180,25 +241,15 @@ void EventManager::unregisterAllEvents()
 void EventManager::unregisterEvent( const char* event )
 {
    // If the event doesn't exist, we have succeeded in removing it!
-   if( !isRegisteredEvent( event ) )
+   const S32 handle = getEventHandle( event );
+   if( handle == -1 )
       return;
 
-   // Iterate over all events.
-   StringTableEntry eventName = StringTable->insert( event );
-   for( Vector<StringTableEntry>::iterator iter = mEvents.begin(); iter != mEvents.end(); iter++ )
-   {
-      // Erase the event.
-      if( *iter == eventName )
-      {
-         mEvents.erase_fast( iter );
-         break;
-      }
-   }
-
-   // Delete the subscriber list.
-   Vector<EventManagerListener::Subscriber>* subscribers = mListener.mSubscribers.remove( event );
-   if( subscribers )
-      delete subscribers;
+   // Delete the event and its subscriber list, leaving the slot empty so other handles stay valid.
+   mListener.mEventHandles.erase( mListener.mEvents[handle]->name );
+   delete mListener.mEvents[handle];
+   mListener.mEvents[handle] = NULL;
+   mListener.mFreeEvents.push_back( handle );
 }
 
 //-----------------------------------------------------------------------------
@@ -213,6 +264,18 @@ bool EventManager::postEvent( const char* event, const char* data )
    return Dispatcher::dispatchMessage( mQueue, event, data );
 }
 
+//-----------------------------------------------------------------------------
+/// Post an event directly to its subscribers.
+/// 
+/// @param handle The handle of the event to post.
+/// @param data Various data associated with the event.
+/// @return Whether or not all subscribers received the event.
+//-----------------------------------------------------------------------------
+bool EventManager::postEvent( S32 handle, const char* data )
+{
+   return mListener.dispatchEvent( mListener.getEvent( handle ), data );
+}
+
 //-----------------------------------------------------------------------------
 /// Subscribe a listener to an event.
 /// 
@@ -257,14 +320,14 @@ bool EventManager::subscribe(SimObject *callbackObj, const char* event, const ch
 
    delete [] cb;
 
-   // Grab the subscriber list.
-   Vector<EventManagerListener::Subscriber>* subscribers = mListener.mSubscribers.retrieve( event );
+   // Grab the event.
+   EventManagerListener::Event* registeredEvent = mListener.getEvent( getEventHandle( event ) );
 
    // If the event exists, there should always be a valid subscriber list.
-   AssertFatal( subscribers, "Invalid event subscriber list." );
+   AssertFatal( registeredEvent, "Invalid event subscriber list." );
 
    // Add the subscriber.
-   subscribers->push_back( subscriber );
+   registeredEvent->subscribers.push_back( subscriber );
 
    return true;
 }
@@ -282,12 +345,11 @@ bool EventManager::subscribe(SimObject *callbackObj, const char* event, const ch
 void EventManager::remove(SimObject *cbObj, const char* event)
 {
    // If the event doesn't exist, we have succeeded in removing it!
-   if( !isRegisteredEvent( event ) )
+   EventManagerListener::Event* registeredEvent = mListener.getEvent( getEventHandle( event ) );
+   if( !registeredEvent )
       return;
 
-   Vector<EventManagerListener::Subscriber>* subscribers = mListener.mSubscribers.retrieve( event );
-   if( !subscribers )
-      return;
+   Vector<EventManagerListener::Subscriber>* subscribers = &registeredEvent->subscribers;
 
    for( Vector<EventManagerListener::Subscriber>::iterator iter = subscribers->begin(); iter != subscribers->end(); iter++ )
    {
@@ -305,8 +367,11 @@ void EventManager::remove(SimObject *cbObj, const char* event)
 void EventManager::dumpEvents()
 {
    Con::printf( "%s Events", mQueue );
-   for( Vector<StringTableEntry>::const_iterator iter = mEvents.begin(); iter != mEvents.end(); iter++ )
-      Con::printf( "   %s", *iter );
+   for( Vector<EventManagerListener::Event*>::const_iterator iter = mListener.mEvents.begin(); iter != mListener.mEvents.end(); iter++ )
+   {
+      if( *iter )
+         Con::printf( "   %s", ( *iter )->name );
+   }
 }
 
 //-----------------------------------------------------------------------------
@@ -316,13 +381,15 @@ void EventManager::dumpEvents()
 //-----------------------------------------------------------------------------
 void EventManager::dumpSubscribers( const char* event )
 {
-   Vector<EventManagerListener::Subscriber>* subscribers = mListener.mSubscribers.retrieve( event );
-   if( !subscribers )
+   EventManagerListener::Event* registeredEvent = mListener.getEvent( getEventHandle( event ) );
+   if( !registeredEvent )
    {
       Con::warnf( "EventManager::dumpSubscriber - %s is not a valid event.", event );
       return;
    }
 
+   Vector<EventManagerListener::Subscriber>* subscribers = &registeredEvent->subscribers;
+
    Con::printf( "%s Subscribers", event );
    for( Vector<EventManagerListener::Subscriber>::const_iterator iter = subscribers->begin(); iter != subscribers->end(); iter++ )
    {
@@ -339,6 +406,9 @@ void EventManager::dumpSubscribers( const char* event )
 void EventManager::dumpSubscribers()
 {
    Con::printf( "%s Events", mQueue );
-   for( Vector<StringTableEntry>::const_iterator iter = mEvents.begin(); iter != mEvents.end(); iter++ )
-      dumpSubscribers( *iter );
+   for( Vector<EventManagerListener::Event*>::const_iterator iter = mListener.mEvents.begin(); iter != mListener.mEvents.end(); iter++ )
+   {
+      if( *iter )
+         dumpSubscribers( ( *iter )->name );
+   }
 }
@@ -22,7 +22,7 @@
 
 #include "console/console.h"
 #include "messaging/dispatcher.h"
-#include "collection/simpleHashTable.h"
+#include "collection/hashTable.h"
 
 #ifndef _EVENTMANAGER_H_
 #define _EVENTMANAGER_H_
@@ -43,12 +43,37 @@ class EventManagerListener : public Dispatcher::IMessageListener
       StringTableEntry event;    ///< The event being listened for.
    };
 
-   /// Subscriber table hashed by event name.
-   SimpleHashTable< Vector<Subscriber> > mSubscribers;
+   /// Stores the subscribers to a registered event.
+   struct Event
+   {
+      StringTableEntry name;          ///< The event name.
+      Vector<Subscriber> subscribers; ///< The subscribers to the event.
+   };
+
+   /// Registered events indexed by handle. Unregistering an event leaves an empty slot so other handles stay valid.
+   Vector<Event*> mEvents;
+
+   /// Handles of the registered events keyed by their interned name.
+   typedef HashMap<StringTableEntry, S32> typeEventHandleHash;
+   typeEventHandleHash mEventHandles;
+
+   /// Empty slots in the event list, reused by the next registered event.
+   Vector<S32> mFreeEvents;
+
+   /// Finds the handle of a registered event, or -1.
+   S32 findEvent( StringTableEntry event ) const;
+
+   /// Gets a registered event from its handle, or NULL.
+   Event* getEvent( S32 handle ) const { return handle >= 0 && handle < mEvents.size() ? mEvents[handle] : NULL; }
+
+   /// Calls the subscribers to an event.
+   bool dispatchEvent( const Event* event, const char* data );
 
 public:
    /// Called by the EventManager queue when an event is triggered. Calls all listeners subscribed to the triggered event.
    virtual bool onMessageReceived( StringTableEntry queue, const char* event, const char* data );
+   /// Called when a posted event is delivered. The event name is already interned so no lookup by string is needed.
+   virtual bool onPostedMessageReceived( StringTableEntry queue, const Dispatcher::PostedMessage* msg );
    virtual bool onMessageObjectReceived( StringTableEntry queue, Message *msg ) { return true; };
 };
 
@@ -92,8 +117,6 @@ class EventManager : public SimObject
 private:
    /// The name of the message queue.
    StringTableEntry mQueue;
-   /// Registered events.
-   Vector<StringTableEntry> mEvents;
 
    /// The event listener. Listens for all events and dispatches them to the appropriate subscribers.
    EventManagerListener mListener;
@@ -137,6 +160,15 @@ public:
 
    /// Triggers an event.
    bool postEvent( const char* eventName, const char* data );
+
+   /// Resolves an event to a handle, or -1 if it is not registered. Handles stay valid until the event is unregistered, after which they may be reused.
+   S32 getEventHandle( const char* eventName );
+   /// Gets the interned name of an event from its handle.
+   StringTableEntry getEventName( S32 handle );
+   /// Gets the interned name of the message queue.
+   StringTableEntry getMessageQueue() const { return mQueue; }
+   /// Triggers an event from its handle. This calls the subscribers directly rather than going through the message queue.
+   bool postEvent( S32 handle, const char* data );
    /// Adds a subscription to an event.
    bool subscribe( SimObject *callbackObj, const char* event, const char* callback = NULL );
    /// Remove a subscriber from an event.
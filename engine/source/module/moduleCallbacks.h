@@ -36,6 +36,11 @@ class ModuleCallbacks
     friend class ModuleManager;
 
 private:
+    // Called on a worker thread some time before a module is loaded so that it can be prepared
+    // alongside other modules.  The main thread waits meanwhile but script and the simulation
+    // must not be used.
+    virtual void onModulePrefetch( ModuleDefinition* pModuleDefinition ) {}
+
     // Called when a module is about to be loaded.
     virtual void onModulePreLoad( ModuleDefinition* pModuleDefinition ) {}
 
@@ -38,6 +38,14 @@
 #include "console/consoleTypes.h"
 #endif
 
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+#include "platform/threads/mutex.h"
+#endif
+
 // Script bindings.
 #include "moduleManager_ScriptBinding.h"
 
@@ -70,6 +78,7 @@ S32 QSORT_CALLBACK moduleDefinitionVersionIdSort( const void* a, const void* b )
 ModuleManager::ModuleManager() :
     mEnforceDependencies(true),
     mEchoInfo(true),
+    mEchoLoadTimes(false),
     mDatabaseLocks( 0 )
 {
     // Set module extension.
@@ -112,6 +121,7 @@ void ModuleManager::initPersistFields()
 
     addField( "EnforceDependencies", TypeBool, Offset(mEnforceDependencies, ModuleManager), "Whether the module manager enforces any dependencies on module definitions it discovers or not." );
     addField( "EchoInfo", TypeBool, Offset(mEchoInfo, ModuleManager), "Whether the module manager echos extra information to the console or not." );
+    addField( "EchoLoadTimes", TypeBool, Offset(mEchoLoadTimes, ModuleManager), "Whether the module manager echos how long each module took to load or not." );
 }
 
 //-----------------------------------------------------------------------------
@@ -352,6 +362,12 @@ bool ModuleManager::loadModuleGroup( const char* pModuleGroup )
         }
     }
 
+    // Prepare the modules in parallel ahead of loading them.
+    const U32 groupStartTime = Platform::getRealMilliseconds();
+    Vector<U32> prefetchTimes;
+    prefetchModules( moduleReadyQueue, prefetchTimes );
+    const U32 prefetchTime = Platform::getRealMilliseconds() - groupStartTime;
+
     // Add module group.
     mGroupsLoaded.push_back( moduleGroup );
 
@@ -380,6 +396,9 @@ bool ModuleManager::loadModuleGroup( const char* pModuleGroup )
             continue;
         }
 
+        // Note when the module started loading.
+        const U32 moduleStartTime = Platform::getRealMilliseconds();
+
         // No, so info.
         if ( mEchoInfo )
         {
@@ -442,6 +461,10 @@ bool ModuleManager::loadModuleGroup( const char* pModuleGroup )
 
         // Raise notifications.
         raiseModulePostLoadNotifications( pLoadReadyModuleDefinition );
+
+        // Echo the load time.
+        if ( mEchoLoadTimes )
+            echoLoadTime( pLoadReadyModuleDefinition, Platform::getRealMilliseconds() - moduleStartTime, prefetchTimes[(U32)(moduleReadyItr - moduleReadyQueue.begin())] );
     }
 
     // Info.
@@ -452,6 +475,13 @@ bool ModuleManager::loadModuleGroup( const char* pModuleGroup )
         Con::printSeparator();
     }
 
+    // Echo the group load time.
+    if ( mEchoLoadTimes )
+    {
+        Con::printf( "Module Manager: Group '%s' took %dms to load '%d' module(s) including %dms preparing them.",
+            moduleGroup, Platform::getRealMilliseconds() - groupStartTime, modulesLoadedCount, prefetchTime );
+    }
+
     return true;
 }
 
@@ -718,6 +748,12 @@ bool ModuleManager::loadModuleExplicit( const char* pModuleId, const U32 version
         }
     }
 
+    // Prepare the modules in parallel ahead of loading them.
+    const U32 explicitStartTime = Platform::getRealMilliseconds();
+    Vector<U32> prefetchTimes;
+    prefetchModules( moduleReadyQueue, prefetchTimes );
+    const U32 prefetchTime = Platform::getRealMilliseconds() - explicitStartTime;
+
     // Reset modules loaded count.
     U32 modulesLoadedCount = 0;
 
@@ -743,6 +779,9 @@ bool ModuleManager::loadModuleExplicit( const char* pModuleId, const U32 version
             continue;
         }
 
+        // Note when the module started loading.
+        const U32 moduleStartTime = Platform::getRealMilliseconds();
+
         // No, so info.
         if ( mEchoInfo )
         {
@@ -805,6 +844,10 @@ bool ModuleManager::loadModuleExplicit( const char* pModuleId, const U32 version
 
         // Raise notifications.
         raiseModulePostLoadNotifications( pLoadReadyModuleDefinition );
+
+        // Echo the load time.
+        if ( mEchoLoadTimes )
+            echoLoadTime( pLoadReadyModuleDefinition, Platform::getRealMilliseconds() - moduleStartTime, prefetchTimes[(U32)(moduleReadyItr - moduleReadyQueue.begin())] );
     }
 
     // Info.
@@ -815,6 +858,13 @@ bool ModuleManager::loadModuleExplicit( const char* pModuleId, const U32 version
         Con::printSeparator();
     }
 
+    // Echo the explicit load time.
+    if ( mEchoLoadTimes )
+    {
+        Con::printf( "Module Manager: Explicit module Id '%s' took %dms to load '%d' module(s) including %dms preparing them.",
+            moduleId, Platform::getRealMilliseconds() - explicitStartTime, modulesLoadedCount, prefetchTime );
+    }
+
     return true;
 }
 
@@ -2246,6 +2296,128 @@ ModuleManager::ModuleDefinitionEntry::iterator ModuleManager::findModuleDefiniti
 
 //-----------------------------------------------------------------------------
 
+/// Modules being prepared ahead of loading.
+struct ModulePrefetch
+{
+    Vector<ModuleDefinition*>   mModules;
+    Vector<U32>                 mQueueIndices;
+    Vector<U32>                 mTimes;
+    Vector<ModuleCallbacks*>    mCallbacks;
+    Mutex                       mMutex;
+    U32                         mNextModule;
+};
+
+//-----------------------------------------------------------------------------
+
+void ModuleManager::prefetchModules( const typeModuleLoadEntryVector& moduleReadyQueue, Vector<U32>& prefetchTimes )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(ModuleManager_PrefetchModules);
+
+    // Reset prefetch times.
+    prefetchTimes.setSize( moduleReadyQueue.size() );
+    for ( S32 index = 0; index < prefetchTimes.size(); ++index )
+        prefetchTimes[index] = 0;
+
+#if defined(TORQUE_OS_EMSCRIPTEN)
+    // No threads so modules are prepared as they load.
+    const U32 workerCount = 0;
+#else
+    const U32 workerCount = (U32)mClamp( Con::getIntVariable( "$pref::T2D::moduleWorkerThreads", 4 ), 0, 8 );
+#endif
+
+    // Finish if there are no workers.
+    if ( workerCount == 0 )
+        return;
+
+    ModulePrefetch prefetch;
+    prefetch.mNextModule = 0;
+
+    // Fetch the modules that are not already loaded.  Only script execution depends on the load
+    // order so these can be prepared in any order.
+    for ( S32 index = 0; index < moduleReadyQueue.size(); ++index )
+    {
+        // Fetch load ready module definition.
+        ModuleDefinition* pLoadReadyModuleDefinition = moduleReadyQueue[index].mpModuleDefinition;
+
+        // Skip if the module is already loaded.
+        if ( findModuleLoaded( pLoadReadyModuleDefinition->getModuleId() ) != NULL )
+            continue;
+
+        prefetch.mModules.push_back( pLoadReadyModuleDefinition );
+        prefetch.mQueueIndices.push_back( index );
+    }
+
+    // Fetch the listener callbacks.
+    for( SimSet::iterator notifyItr = mNotificationListeners.begin(); notifyItr != mNotificationListeners.end(); ++notifyItr )
+    {
+        ModuleCallbacks* pCallbacks = dynamic_cast<ModuleCallbacks*>( *notifyItr );
+        if ( pCallbacks != NULL )
+            prefetch.mCallbacks.push_back( pCallbacks );
+    }
+
+    // Finish if there's nothing worth sharing out.  The modules are prepared as they load instead.
+    if ( prefetch.mModules.size() < 2 || prefetch.mCallbacks.size() == 0 )
+        return;
+
+    prefetch.mTimes.setSize( prefetch.mModules.size() );
+
+    // Start the workers and help them out on this thread.
+    const U32 threadCount = getMin( workerCount, (U32)prefetch.mModules.size() - 1 );
+    Vector<Thread*> workers;
+    for ( U32 index = 0; index < threadCount; ++index )
+        workers.push_back( new Thread( &ModuleManager::prefetchModulesWorker, &prefetch, true ) );
+
+    prefetchModulesWorker( &prefetch );
+
+    for ( S32 index = 0; index < workers.size(); ++index )
+    {
+        workers[index]->join();
+        delete workers[index];
+    }
+
+    // Fetch the prefetch times in load order.
+    for ( S32 index = 0; index < prefetch.mModules.size(); ++index )
+        prefetchTimes[prefetch.mQueueIndices[index]] = prefetch.mTimes[index];
+}
+
+//-----------------------------------------------------------------------------
+
+void ModuleManager::prefetchModulesWorker( void* pPrefetch )
+{
+    ModulePrefetch* pModulePrefetch = static_cast<ModulePrefetch*>( pPrefetch );
+
+    while( true )
+    {
+        // Claim the next module.
+        pModulePrefetch->mMutex.lock();
+        const U32 moduleIndex = pModulePrefetch->mNextModule++;
+        pModulePrefetch->mMutex.unlock();
+
+        // Finish when all the modules have been claimed.
+        if ( moduleIndex >= (U32)pModulePrefetch->mModules.size() )
+            return;
+
+        const U32 startTime = Platform::getRealMilliseconds();
+
+        // Perform object callbacks.
+        for( Vector<ModuleCallbacks*>::iterator callbackItr = pModulePrefetch->mCallbacks.begin(); callbackItr != pModulePrefetch->mCallbacks.end(); ++callbackItr )
+            (*callbackItr)->onModulePrefetch( pModulePrefetch->mModules[moduleIndex] );
+
+        pModulePrefetch->mTimes[moduleIndex] = Platform::getRealMilliseconds() - startTime;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void ModuleManager::echoLoadTime( ModuleDefinition* pModuleDefinition, const U32 loadTime, const U32 prefetchTime ) const
+{
+    Con::printf( "Module Manager: Module Id '%s' at version Id '%d' took %dms to load after %dms preparing it.",
+        pModuleDefinition->getModuleId(), pModuleDefinition->getVersionId(), loadTime, prefetchTime );
+}
+
+//-----------------------------------------------------------------------------
+
 bool ModuleManager::resolveModuleDependencies( StringTableEntry moduleId, const U32 versionId, StringTableEntry moduleGroup, bool synchronizedOnly, typeModuleLoadEntryVector& moduleResolvingQueue, typeModuleLoadEntryVector& moduleReadyQueue )
 {
     // Fetch the module Id ready entry.
@@ -110,6 +110,7 @@ private:
     /// Miscellaneous.
     bool                        mEnforceDependencies;
     bool                        mEchoInfo;
+    bool                        mEchoLoadTimes;
     S32                         mDatabaseLocks;
     char                        mModuleExtension[256];
     Taml                        mTaml;
@@ -195,6 +196,9 @@ private:
 
     ModuleDefinitionEntry* findModuleId( StringTableEntry moduleId );
     ModuleDefinitionEntry::iterator findModuleDefinition( StringTableEntry moduleId, const U32 versionId );
+    void prefetchModules( const typeModuleLoadEntryVector& moduleReadyQueue, Vector<U32>& prefetchTimes );
+    static void prefetchModulesWorker( void* pPrefetch );
+    void echoLoadTime( ModuleDefinition* pModuleDefinition, const U32 loadTime, const U32 prefetchTime ) const;
     bool resolveModuleDependencies( StringTableEntry moduleId, const U32 versionId, StringTableEntry moduleGroup, bool synchronizedOnly, typeModuleLoadEntryVector& moduleResolvingQueue, typeModuleLoadEntryVector& moduleReadyQueue );
     ModuleLoadEntry* findModuleResolving( StringTableEntry moduleId, typeModuleLoadEntryVector& moduleResolvingQueue );
     ModuleLoadEntry* findModuleReady( StringTableEntry moduleId, typeModuleLoadEntryVector& moduleReadyQueue );
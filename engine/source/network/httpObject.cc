@@ -41,6 +41,8 @@ HTTPObject::HTTPObject()
    mQuery = 0;
    mPost = 0;
    mBufferSave = 0;
+   mBufferSaveSize = 0;
+   mBufferSaveCapacity = 0;
 }
 
 HTTPObject::~HTTPObject()
@@ -194,6 +196,7 @@ void HTTPObject::onConnected()
    send((U8*)buffer, dStrlen(buffer));
    mParseState = ParsingStatusLine;
    mChunkedEncoding = false;
+   mContentLength = 0;
 }
 
 void HTTPObject::onConnectFailed()
@@ -229,12 +232,17 @@ bool HTTPObject::processLine(U8 *line)
    {
       if(!dStricmp((char *) line, "transfer-encoding: chunked"))
          mChunkedEncoding = true;
+      else if(!dStrnicmp((char *) line, "content-length:", 15))
+         mContentLength = dAtoi((char *) line + 15);
       if(line[0] == 0)
       {
          if(mChunkedEncoding)
             mParseState = ParsingChunkHeader;
          else
+         {
             mParseState = ProcessingBody;
+            mBytesRemaining = mContentLength;
+         }
          return true;
       }
    }
@@ -251,8 +259,10 @@ bool HTTPObject::processLine(U8 *line)
          }
          if(mBufferSave)
          {
+            dFree(mBuffer);
             mBuffer = mBufferSave;
             mBufferSize = mBufferSaveSize;
+            mBufferCapacity = mBufferSaveCapacity;
             mBufferSave = 0;
          }
          if(mChunkSize)
@@ -261,6 +271,7 @@ bool HTTPObject::processLine(U8 *line)
          {
             mParseState = ProcessingDone;
             finishLastLine();
+            closeReceiveFile(true);
          }
       }
    }
@@ -273,6 +284,26 @@ bool HTTPObject::processLine(U8 *line)
 
 U32 HTTPObject::onDataReceive(U8 *buffer, U32 bufferLen)
 {
+   // the body goes straight to the receive file
+   if(isReceivingFile())
+   {
+      if(!mChunkedEncoding && mContentLength)
+      {
+         // stop at the content length
+         U32 len = getMin(bufferLen, mBytesRemaining);
+         writeReceiveFile(buffer, len);
+         mBytesRemaining -= len;
+         if(mBytesRemaining == 0)
+         {
+            mParseState = ProcessingDone;
+            closeReceiveFile(true);
+         }
+      }
+      else
+         writeReceiveFile(buffer, bufferLen);
+      return bufferLen;
+   }
+
    U32 start = 0;
    parseLine(buffer, &start, bufferLen);
    return start;
@@ -289,12 +320,15 @@ U32 HTTPObject::onReceive(U8 *buffer, U32 bufferLen)
          mChunkSize -= ret;
          if(mChunkSize == 0)
          {
-            if(mBuffer)
+            if(mBufferSize)
             {
+               dFree(mBufferSave);
                mBufferSaveSize = mBufferSize;
+               mBufferSaveCapacity = mBufferCapacity;
                mBufferSave = mBuffer;
                mBuffer = 0;
                mBufferSize = 0;
+               mBufferCapacity = 0;
             }
             mParseState = ParsingChunkHeader;
          }
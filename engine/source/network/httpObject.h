@@ -58,6 +58,7 @@ protected:
    char *mPost;
    U8 *mBufferSave;
    U32 mBufferSaveSize;
+   U32 mBufferSaveCapacity;
 public:
    static void expandPath(char *dest, const char *path, U32 destSize);
    void get(const char *hostName, const char *urlName, const char *query);
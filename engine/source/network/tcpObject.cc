@@ -29,6 +29,8 @@
 #include "console/consoleInternal.h"
 #include "game/defaultGame.h"
 #include "collection/vector.h"
+#include "io/fileStream.h"
+#include "io/resource/resourceManager.h"
 
 #ifdef TORQUE_OS_IOS
 #include "platformiOS/iOSUtil.h"
@@ -72,15 +74,23 @@ TCPObject::TCPObject()
 {
    mBuffer = NULL;
    mBufferSize = 0;
+   mBufferCapacity = 0;
    mPort = 0;
    mTag = NetSocket::INVALID;
    mNext = NULL;
    mState = Disconnected;
+   mReceiveFile = NULL;
+   mReceiveFileName = StringTable->EmptyString;
+   mReceiveFileBytes = 0;
+   mBatchLines = false;
+   mLineBatchCount = 0;
+   VECTOR_SET_ASSOCIATION(mLineBatch);
 }
 
 TCPObject::~TCPObject()
 {
    disconnect();
+   closeReceiveFile(false);
    dFree(mBuffer);
 }
 
@@ -118,6 +128,13 @@ bool TCPObject::onAdd()
 
 U32 TCPObject::onReceive(U8 *buffer, U32 bufferLen)
 {
+   // raw data goes straight to the receive file
+   if(mReceiveFile)
+   {
+      writeReceiveFile(buffer, bufferLen);
+      return bufferLen;
+   }
+
    // we got a raw buffer event
    // default action is to split the buffer into lines of text
    // and call processLine on each
@@ -127,37 +144,85 @@ U32 TCPObject::onReceive(U8 *buffer, U32 bufferLen)
    return start;
 }
 
-void TCPObject::parseLine(U8 *buffer, U32 *start, U32 bufferLen)
+U32 TCPObject::findLineEnd(const U8 *buffer, U32 start, U32 bufferLen)
 {
-   // find the first \n in buffer
-   U32 i;
-   U8 *line = buffer + *start;
+   // test eight bytes at a time for a \n or a terminator
+   const U64 ones = 0x0101010101010101ULL;
+   const U64 highBits = 0x8080808080808080ULL;
+   const U64 newlines = ones * U64('\n');
+
+   U32 i = start;
+   for(; i + 8 <= bufferLen; i += 8)
+   {
+      U64 word;
+      dMemcpy(&word, buffer + i, sizeof(word));
+      const U64 newlineWord = word ^ newlines;
+      if(((word - ones) & ~word & highBits) || ((newlineWord - ones) & ~newlineWord & highBits))
+         break;
+   }
 
-   for(i = *start; i < bufferLen; i++)
+   // find the exact byte
+   for(; i < bufferLen; i++)
       if(buffer[i] == '\n' || buffer[i] == 0)
          break;
+   return i;
+}
+
+void TCPObject::appendBuffer(const U8 *data, U32 len)
+{
+   // grow geometrically, leaving room for the terminator
+   const U32 required = mBufferSize + len + 1;
+   if(required > mBufferCapacity)
+   {
+      mBufferCapacity = getMax(getMax(mBufferCapacity * 2, required), U32(256));
+      mBuffer = (U8 *) dRealloc(mBuffer, mBufferCapacity);
+   }
+   dMemcpy(mBuffer + mBufferSize, data, len);
+   mBufferSize += len;
+}
+
+void TCPObject::processBufferedLine()
+{
+   mBuffer[mBufferSize] = 0;
+
+   // detach the line in case processLine swaps the buffer
+   U8 *line = mBuffer;
+   U32 capacity = mBufferCapacity;
+   mBuffer = 0;
+   mBufferSize = 0;
+   mBufferCapacity = 0;
+
+   processLine(line);
+
+   // keep the storage for the next partial line
+   if(mBuffer == 0)
+   {
+      mBuffer = line;
+      mBufferCapacity = capacity;
+   }
+   else
+      dFree(line);
+}
+
+void TCPObject::parseLine(U8 *buffer, U32 *start, U32 bufferLen)
+{
+   // find the first \n in buffer
+   U32 i = findLineEnd(buffer, *start, bufferLen);
+   U8 *line = buffer + *start;
    U32 len = i - *start;
 
-   if(i == bufferLen || mBuffer)
+   if(i == bufferLen || mBufferSize)
    {
       // we've hit the end with no newline
-      mBuffer = (U8 *) dRealloc(mBuffer, mBufferSize + len + 1);
-      dMemcpy(mBuffer + mBufferSize, line, len);
-      mBufferSize += len;
+      appendBuffer(line, len);
       *start = i;
 
       // process the line
       if(i != bufferLen)
       {
-         mBuffer[mBufferSize] = 0;
          if(mBufferSize && mBuffer[mBufferSize-1] == '\r')
-            mBuffer[mBufferSize - 1] = 0;
-         U8 *temp = mBuffer;
-         mBuffer = 0;
-         mBufferSize = 0;
-
-         processLine(temp);
-         dFree(temp);
+            mBufferSize--;
+         processBufferedLine();
       }
    }
    else if(i != bufferLen)
@@ -182,10 +247,103 @@ void TCPObject::onConnectionRequest(const NetAddress *addr, U32 connectId)
 
 bool TCPObject::processLine(U8 *line)
 {
+   if(mBatchLines)
+   {
+      // collect the line for flushLineBatch()
+      const U32 len = dStrlen((const char *) line);
+      const U32 offset = mLineBatch.size();
+      if(offset + len + 1 > mLineBatch.capacity())
+         mLineBatch.reserve(getMax(mLineBatch.capacity() * 2, offset + len + 1));
+      mLineBatch.setSize(offset + len + 1);
+      dMemcpy(mLineBatch.address() + offset, line, len);
+      mLineBatch[offset + len] = '\n';
+      mLineBatchCount++;
+      return true;
+   }
+
    Con::executef(this, 2, "onLine", line);
    return true;
 }
 
+void TCPObject::setLineBatching(bool batch)
+{
+   if(!batch)
+      flushLineBatch();
+   mBatchLines = batch;
+}
+
+void TCPObject::flushLineBatch()
+{
+   if(mLineBatchCount == 0)
+      return;
+
+   // replace the last \n with the terminator
+   mLineBatch.last() = 0;
+
+   char countBuf[16];
+   dSprintf(countBuf, sizeof(countBuf), "%d", mLineBatchCount);
+   mLineBatchCount = 0;
+
+   Con::executef(this, 3, "onLines", (const char *) mLineBatch.address(), countBuf);
+
+   // the storage is kept for the next batch
+   mLineBatch.clear();
+}
+
+bool TCPObject::openReceiveFile(const char *fileName)
+{
+   closeReceiveFile(false);
+
+   FileStream *stream = new FileStream;
+   if(!ResourceManager->openFileForWrite(*stream, fileName))
+   {
+      Con::errorf("TCPObject::openReceiveFile - failed to open '%s' for writing.", fileName);
+      delete stream;
+      return false;
+   }
+
+   mReceiveFile = stream;
+   mReceiveFileName = StringTable->insert(fileName);
+   mReceiveFileBytes = 0;
+   return true;
+}
+
+void TCPObject::writeReceiveFile(const U8 *buffer, U32 bufferLen)
+{
+   if(!mReceiveFile || bufferLen == 0)
+      return;
+
+   mReceiveFile->write(bufferLen, buffer);
+   mReceiveFileBytes += bufferLen;
+}
+
+void TCPObject::closeReceiveFile(bool complete)
+{
+   if(!mReceiveFile)
+      return;
+
+   mReceiveFile->close();
+   delete mReceiveFile;
+   mReceiveFile = NULL;
+
+   if(complete)
+   {
+      char bytesBuf[16];
+      dSprintf(bytesBuf, sizeof(bytesBuf), "%d", mReceiveFileBytes);
+      Con::executef(this, 3, "onReceiveFileComplete", mReceiveFileName, bytesBuf);
+   }
+}
+
+void TCPObject::onReceiveProgress()
+{
+   if(!mReceiveFile)
+      return;
+
+   char bytesBuf[16];
+   dSprintf(bytesBuf, sizeof(bytesBuf), "%d", mReceiveFileBytes);
+   Con::executef(this, 2, "onReceiveFileProgress", bytesBuf);
+}
+
 void TCPObject::onDNSResolved()
 {
    mState = DNSResolved;
@@ -213,13 +371,7 @@ void TCPObject::onConnectFailed()
 void TCPObject::finishLastLine()
 {
    if(mBufferSize)
-   {
-      mBuffer[mBufferSize] = 0;
-      processLine(mBuffer);
-      dFree(mBuffer);
-      mBuffer = 0;
-      mBufferSize = 0;
-   }
+      processBufferedLine();
 }
 
 bool TCPObject::isBufferEmpty()
@@ -229,17 +381,15 @@ bool TCPObject::isBufferEmpty()
 
 void TCPObject::emptyBuffer()
 {
-   if(mBufferSize)
-   {
-      dFree(mBuffer);
-      mBuffer = 0;
-      mBufferSize = 0;
-   }
+   // the storage is kept for the next partial line
+   mBufferSize = 0;
 }
 
 void TCPObject::onDisconnect()
 {
    finishLastLine();
+   flushLineBatch();
+   closeReceiveFile(true);
    mState = Disconnected;
    Con::executef(this, 1, "onDisconnect");
 }
@@ -362,6 +512,10 @@ void DefaultGame::processConnectedReceiveEvent(ConnectedReceiveEvent* event )
       buffer += ret;
    }
 
+   // deliver the lines collected from this receive
+   tcpo->flushLineBatch();
+   tcpo->onReceiveProgress();
+
    //If our buffer now has something in it then it's probably a web socket packet and lets handle it
    if(!tcpo->isBufferEmpty())
    {
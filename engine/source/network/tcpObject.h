@@ -27,6 +27,8 @@
 #include "sim/simBase.h"
 #endif
 
+class FileStream;
+
 class TCPObject : public SimObject
 {
 public:
@@ -41,10 +43,27 @@ private:
 
 protected:
    typedef SimObject Parent;
+
+   /// Partial line carried between receives.  The storage is kept and reused.
    U8 *mBuffer;
    U32 mBufferSize;
+   U32 mBufferCapacity;
    U16 mPort;
 
+   /// Received data written straight to a file instead of being split into lines.
+   FileStream *mReceiveFile;
+   StringTableEntry mReceiveFileName;
+   U32 mReceiveFileBytes;
+
+   /// Lines collected for a single onLines() callback per receive.
+   bool mBatchLines;
+   Vector<U8> mLineBatch;
+   U32 mLineBatchCount;
+
+   void appendBuffer(const U8 *data, U32 len);
+   void processBufferedLine();
+   static U32 findLineEnd(const U8 *buffer, U32 start, U32 bufferLen);
+
 public:
    TCPObject();
    virtual ~TCPObject();
@@ -54,6 +73,18 @@ public:
 	bool isBufferEmpty();
 	void emptyBuffer();
 
+   /// Receive to file.
+   bool openReceiveFile(const char *fileName);
+   void writeReceiveFile(const U8 *buffer, U32 bufferLen);
+   void closeReceiveFile(bool complete);
+   bool isReceivingFile() const { return mReceiveFile != NULL; }
+   void onReceiveProgress();
+
+   /// Line batching.
+   void setLineBatching(bool batch);
+   bool getLineBatching() const { return mBatchLines; }
+   void flushLineBatch();
+
    static TCPObject *find(NetSocket tag);
 
    // onReceive gets called continuously until all bytes are processed
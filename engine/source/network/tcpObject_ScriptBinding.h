@@ -93,4 +93,44 @@ ConsoleMethodWithDocs(TCPObject, URLEncodeString, ConsoleString, 3, 3, (string d
     return pcReturnBuffer;
 }
 
+/*! Use the setLineBatching method to deliver the lines from each receive in one onLines(%lines, %count) callback instead of one onLine callback per line.
+    The lines are separated by newlines so they can be read with getRecord().
+    @param batch Whether to batch lines or not.
+    @return No return value.
+*/
+ConsoleMethodWithDocs( TCPObject, setLineBatching, ConsoleVoid, 3, 3, (bool batch))
+{
+   object->setLineBatching(dAtob(argv[2]));
+}
+
+/*! Gets whether lines are delivered in batches.
+    @return Whether lines are batched or not.
+*/
+ConsoleMethodWithDocs( TCPObject, getLineBatching, ConsoleBool, 2, 2, ())
+{
+   return object->getLineBatching();
+}
+
+/*! Use the setReceiveFile method to write received data straight to a file instead of splitting it into lines.
+    For an HTTPObject only the body is written.  onReceiveFileProgress(%bytes) is called after each receive and onReceiveFileComplete(%file, %bytes) when the transfer ends.
+    @param file The file to write.
+    @return Whether the file was opened or not.
+    @sa closeReceiveFile
+*/
+ConsoleMethodWithDocs( TCPObject, setReceiveFile, ConsoleBool, 3, 3, (string file))
+{
+   char buffer[1024];
+   Con::expandPath(buffer, sizeof(buffer), argv[2]);
+   return object->openReceiveFile(buffer);
+}
+
+/*! Closes any receive file without calling onReceiveFileComplete.  Received data goes back to being split into lines.
+    @return No return value.
+    @sa setReceiveFile
+*/
+ConsoleMethodWithDocs( TCPObject, closeReceiveFile, ConsoleVoid, 2, 2, ())
+{
+   object->closeReceiveFile(false);
+}
+
 ConsoleMethodGroupEndWithDocs(TCPObject)
@@ -30,6 +30,124 @@ namespace StringUnit
 {
    static char _returnBuffer[4096];
 
+   //-----------------------------------------------------------------------------
+   // Tokenisation cache.
+   //
+   // Walking a list with getWord( %list, %i ) rescans the string from the start on
+   // every call.  The most recent tokenisations of long strings are kept as unit
+   // offsets so that a repeat lookup only has to confirm that the string is unchanged
+   // up to the end of the requested unit.
+   //-----------------------------------------------------------------------------
+
+   static const U32 k_unitCacheEntries = 4;
+   static const U32 k_minCachedLength = 64;
+
+   struct UnitCache
+   {
+      char* mString;          ///< Copy of the tokenised string including its terminator.
+      U32 mLength;
+      U32 mStringCapacity;
+      char* mSet;
+      U32 mSetCapacity;
+      U32* mUnitEnd;          ///< Offset of the delimiter or terminator closing each unit.
+      U32 mUnitCount;         ///< Includes the (possibly empty) unit closed by the terminator.
+      U32 mUnitCapacity;
+      U32 mLastUse;
+      bool mDelimiter[256];
+   };
+
+   static UnitCache _unitCache[k_unitCacheEntries];
+   static U32 _unitCacheTick = 0;
+   static bool _unitCacheEnabled = true;
+
+   static inline U32 getCachedUnitStart(const UnitCache& cache, const U32 index)
+   {
+      return index == 0 ? 0 : cache.mUnitEnd[index-1] + 1;
+   }
+
+   static void buildUnitCache(UnitCache& cache, const char* string, const char* set)
+   {
+      const U32 length = dStrlen(string);
+      if (length + 1 > cache.mStringCapacity)
+      {
+         cache.mStringCapacity = getMax(length + 1, cache.mStringCapacity * 2);
+         cache.mString = (char*)dRealloc(cache.mString, cache.mStringCapacity);
+      }
+      dMemcpy(cache.mString, string, length + 1);
+      cache.mLength = length;
+
+      const U32 setLength = dStrlen(set);
+      if (setLength + 1 > cache.mSetCapacity)
+      {
+         cache.mSetCapacity = setLength + 1;
+         cache.mSet = (char*)dRealloc(cache.mSet, cache.mSetCapacity);
+      }
+      dMemcpy(cache.mSet, set, setLength + 1);
+
+      dMemset(cache.mDelimiter, 0, sizeof(cache.mDelimiter));
+      for (const char* pSet = set; *pSet; pSet++)
+         cache.mDelimiter[(U8)*pSet] = true;
+
+      cache.mUnitCount = 0;
+      for (U32 i = 0; i <= length; i++)
+      {
+         if (i < length && !cache.mDelimiter[(U8)cache.mString[i]])
+            continue;
+
+         if (cache.mUnitCount == cache.mUnitCapacity)
+         {
+            cache.mUnitCapacity = getMax(cache.mUnitCapacity * 2, (U32)64);
+            cache.mUnitEnd = (U32*)dRealloc(cache.mUnitEnd, cache.mUnitCapacity * sizeof(U32));
+         }
+         cache.mUnitEnd[cache.mUnitCount++] = i;
+      }
+   }
+
+   /// Returns the tokenisation of a long string, valid at least up to the end of unit
+   /// 'index' (or all of it when the index is past the last unit), or NULL for short
+   /// strings which are cheaper to scan directly.
+   static const UnitCache* findUnitCache(const char* string, U32 index, const char* set)
+   {
+      if (!_unitCacheEnabled)
+         return NULL;
+
+      for (U32 i = 0; i < k_minCachedLength; i++)
+      {
+         if (!string[i])
+            return NULL;
+      }
+
+      UnitCache* pOldest = &_unitCache[0];
+      for (U32 i = 0; i < k_unitCacheEntries; i++)
+      {
+         UnitCache& cache = _unitCache[i];
+         if (cache.mString != NULL && dStrcmp(cache.mSet, set) == 0)
+         {
+            // Only the prefix that determines the requested unit needs to match.
+            const U32 checkLength = (index < cache.mUnitCount ? cache.mUnitEnd[index] : cache.mLength) + 1;
+            if (dStrncmp(string, cache.mString, checkLength) == 0)
+            {
+               cache.mLastUse = ++_unitCacheTick;
+               return &cache;
+            }
+         }
+
+         if (cache.mLastUse < pOldest->mLastUse)
+            pOldest = &cache;
+      }
+
+      buildUnitCache(*pOldest, string, set);
+      pOldest->mLastUse = ++_unitCacheTick;
+      return pOldest;
+   }
+
+   void setUnitCacheEnabled(const bool enabled)
+   {
+      _unitCacheEnabled = enabled;
+   }
+
+   //-----------------------------------------------------------------------------
+
    StringTableEntry getStringTableUnit(const char* string, U32 index, const char* set)
    {
        return StringTable->insert( getUnit( string, index, set ) );
@@ -38,16 +156,28 @@ namespace StringUnit
    const char* getUnit(const char* string, U32 index, const char* set)
    {
       U32 sz;
-      while(index--)
+      const UnitCache* pCache = findUnitCache(string, index, set);
+      if (pCache != NULL)
       {
-         if(!*string)
+         if (index >= pCache->mUnitCount)
             return "";
+         const U32 start = getCachedUnitStart(*pCache, index);
+         string += start;
+         sz = pCache->mUnitEnd[index] - start;
+      }
+      else
+      {
+         while(index--)
+         {
+            if(!*string)
+               return "";
+            sz = dStrcspn(string, set);
+            if (string[sz] == 0)
+               return "";
+            string += (sz + 1);
+         }
          sz = dStrcspn(string, set);
-         if (string[sz] == 0)
-            return "";
-         string += (sz + 1);
       }
-      sz = dStrcspn(string, set);
       if (sz == 0)
          return "";
 
@@ -67,15 +197,25 @@ namespace StringUnit
          return "";
 
       S32 sz;
-      S32 index = startIndex;
-      while(index--)
+      const UnitCache* pCache = startIndex >= 0 ? findUnitCache(string, startIndex, set) : NULL;
+      if (pCache != NULL)
       {
-         if(!*string)
+         if ((U32)startIndex >= pCache->mUnitCount)
             return "";
-         sz = dStrcspn(string, set);
-         if (string[sz] == 0)
-            return "";
-         string += (sz + 1);
+         string += getCachedUnitStart(*pCache, startIndex);
+      }
+      else
+      {
+         S32 index = startIndex;
+         while(index--)
+         {
+            if(!*string)
+               return "";
+            sz = dStrcspn(string, set);
+            if (string[sz] == 0)
+               return "";
+            string += (sz + 1);
+         }
       }
       const char *startString = string;
       while(startIndex <= endIndex--)
@@ -111,6 +251,14 @@ namespace StringUnit
 
    U32 getUnitCount(const char *string, const char *set)
    {
+      const UnitCache* pCache = findUnitCache(string, U32_MAX, set);
+      if (pCache != NULL)
+      {
+         // A trailing empty unit is not counted.
+         const U32 last = pCache->mUnitCount - 1;
+         return getCachedUnitStart(*pCache, last) == pCache->mUnitEnd[last] ? last : pCache->mUnitCount;
+      }
+
       U32 count = 0;
       U8 last = 0;
       while(*string)
@@ -144,17 +292,33 @@ namespace StringUnit
       ret[0] = '\0';
       U32 padCount = 0;
 
-      while(index--)
+      const UnitCache* pCache = findUnitCache(string, index, set);
+      if (pCache != NULL)
       {
-         sz = dStrcspn(string, set);
-         if(string[sz] == 0)
+         if (index < pCache->mUnitCount)
          {
-            string += sz;
-            padCount = index + 1;
-            break;
+            string += getCachedUnitStart(*pCache, index);
          }
          else
-            string += (sz + 1);
+         {
+            string += pCache->mLength;
+            padCount = index - pCache->mUnitCount + 1;
+         }
+      }
+      else
+      {
+         while(index--)
+         {
+            sz = dStrcspn(string, set);
+            if(string[sz] == 0)
+            {
+               string += sz;
+               padCount = index + 1;
+               break;
+            }
+            else
+               string += (sz + 1);
+         }
       }
       // copy first chunk
       sz = (U32)(string-start);
@@ -186,14 +350,25 @@ namespace StringUnit
       char *ret = &_returnBuffer[0];
       ret[0] = '\0';
 
-      while(index--)
+      const UnitCache* pCache = findUnitCache(string, index, set);
+      if (pCache != NULL)
       {
-         sz = dStrcspn(string, set);
          // if there was no unit out there... return the original string
-         if(string[sz] == 0)
+         if (index >= pCache->mUnitCount)
             return start;
-         else
-            string += (sz + 1);
+         string += getCachedUnitStart(*pCache, index);
+      }
+      else
+      {
+         while(index--)
+         {
+            sz = dStrcspn(string, set);
+            // if there was no unit out there... return the original string
+            if(string[sz] == 0)
+               return start;
+            else
+               string += (sz + 1);
+         }
       }
       // copy first chunk
       sz = (U32)(string-start);
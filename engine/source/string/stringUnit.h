@@ -33,6 +33,9 @@ namespace StringUnit
     U32 getUnitCount(const char* string, const char* set);
     const char* setUnit(const char* string, U32 index, const char *replace, const char* set);
     const char* removeUnit(const char* string, U32 index, const char* set);
+
+    /// Enables the tokenisation cache for long strings (on by default).  Results are the same either way.
+    void setUnitCacheEnabled(const bool enabled);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,123 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef PERLINNOISE_H
+#include "algorithm/Perlin.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define PERLIN_UNITTEST_MAXIMUM_COUNT   67
+#define PERLIN_UNITTEST_TOLERANCE       0.0001
+
+//-----------------------------------------------------------------------------
+
+// Checks noiseBatch() against noise() for samples spread around an origin.
+static void compareNoiseBatch( PerlinNoise& perlin, const F32 originX, const F32 originY, const F32 spread, const F32 z )
+{
+    F32 x[PERLIN_UNITTEST_MAXIMUM_COUNT];
+    F32 y[PERLIN_UNITTEST_MAXIMUM_COUNT];
+    F32 out[PERLIN_UNITTEST_MAXIMUM_COUNT + 1];
+
+    for ( U32 index = 0; index < PERLIN_UNITTEST_MAXIMUM_COUNT; ++index )
+    {
+        x[index] = originX + spread * (F32)index * 0.37f;
+        y[index] = originY - spread * (F32)index * 0.61f;
+    }
+
+    // Cover full blocks of four and every partial block size.
+    for ( U32 count = 1; count <= PERLIN_UNITTEST_MAXIMUM_COUNT; ++count )
+    {
+        // Guard the sample after the last to catch a partial block writing past the end.
+        out[count] = -1.0f;
+
+        perlin.noiseBatch( x, y, z, count, out );
+
+        ASSERT_EQ( -1.0f, out[count] ) << "noiseBatch wrote past " << count << " samples.";
+
+        for ( U32 index = 0; index < count; ++index )
+        {
+            const F64 expected = perlin.noise( (F64)x[index], (F64)y[index], (F64)z );
+            ASSERT_NEAR( expected, (F64)out[index], PERLIN_UNITTEST_TOLERANCE ) << "Sample (" << x[index] << "," << y[index] << "," << z << ") of " << count << " differs.";
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( PerlinNoiseTests, NoiseBatchTest )
+{
+    PerlinNoise perlin;
+
+    // Positive, negative and mixed coordinates.
+    compareNoiseBatch( perlin, 0.0f, 0.0f, 0.5f, 0.0f );
+    compareNoiseBatch( perlin, 0.25f, 3.75f, 0.13f, 0.5f );
+    compareNoiseBatch( perlin, -10.3f, -7.9f, 0.29f, -2.25f );
+    compareNoiseBatch( perlin, -0.5f, 12.5f, 1.0f, 7.0f );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( PerlinNoiseTests, NoiseBatchLargeCoordinatesTest )
+{
+    PerlinNoise perlin;
+
+    // Coordinates far past the 256 cell repeat in both directions.
+    compareNoiseBatch( perlin, 1000.25f, -2000.75f, 0.9f, 300.5f );
+    compareNoiseBatch( perlin, -65536.5f, 65536.25f, 3.3f, -1024.125f );
+    compareNoiseBatch( perlin, 123456.0f, -98765.0f, 17.0f, 4097.75f );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( PerlinNoiseTests, NoiseBatchSeededTest )
+{
+    // Seeded permutations take the same path.
+    for ( U32 seed = 1; seed <= 4; ++seed )
+    {
+        PerlinNoise perlin( seed * 7919 );
+        compareNoiseBatch( perlin, -3.1f * (F32)seed, 5.7f * (F32)seed, 0.77f, (F32)seed * -0.3f );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( PerlinNoiseTests, NoiseBatchEmptyTest )
+{
+    PerlinNoise perlin;
+    F32 x = 1.5f;
+    F32 y = 2.5f;
+    F32 out = -1.0f;
+
+    // Nothing is written for no samples.
+    perlin.noiseBatch( &x, &y, 0.0f, 0, &out );
+    ASSERT_EQ( -1.0f, out );
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,377 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SCENE_NAVIGATION_H_
+#include "2d/scene/SceneNavigation.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define SCENE_NAVIGATION_UNITTEST_UNREACHABLE   1.0e30f
+
+// Neighbor offsets in flow-code order.
+static const S32 sTestNeighborX[8] = { 1, 1, 0, -1, -1, -1,  0,  1 };
+static const S32 sTestNeighborY[8] = { 0, 1, 1,  1,  0, -1, -1, -1 };
+
+//-----------------------------------------------------------------------------
+
+static void buildGrid( SceneNavigation::Grid& grid, const char** pRows, const S32 width, const S32 height )
+{
+    grid.mOrigin.Set( 0.0f, 0.0f );
+    grid.mCellSize = 1.0f;
+    grid.mWidth = width;
+    grid.mHeight = height;
+    grid.mBlocked.setSize( width * height );
+
+    // Row zero is the bottom of the grid.
+    for ( S32 y = 0; y < height; ++y )
+    {
+        for ( S32 x = 0; x < width; ++x )
+        {
+            grid.mBlocked[ grid.getCellIndex( x, y ) ] = pRows[height - 1 - y][x] == '#' ? 1 : 0;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+static void buildRandomGrid( SceneNavigation::Grid& grid, const S32 width, const S32 height, const U32 blockedPercent, U32& seed )
+{
+    grid.mOrigin.Set( 0.0f, 0.0f );
+    grid.mCellSize = 1.0f;
+    grid.mWidth = width;
+    grid.mHeight = height;
+    grid.mBlocked.setSize( width * height );
+
+    for ( S32 index = 0; index < width * height; ++index )
+    {
+        seed = seed * 1664525 + 1013904223;
+        grid.mBlocked[index] = ((seed >> 16) % 100) < blockedPercent ? 1 : 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+static S32 getRandomWalkableCell( const SceneNavigation::Grid& grid, U32& seed )
+{
+    for ( ;; )
+    {
+        seed = seed * 1664525 + 1013904223;
+        const S32 cell = (S32)((seed >> 8) % (U32)(grid.mWidth * grid.mHeight));
+        if ( grid.mBlocked[cell] == 0 )
+            return cell;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+// Plain Dijkstra over the 8-connected grid without corner cutting, the reference for both searches.
+static void buildReferenceCosts( const SceneNavigation::Grid& grid, const S32 goalCell, Vector<F32>& costs )
+{
+    const S32 cellCount = grid.mWidth * grid.mHeight;
+    costs.setSize( cellCount );
+    for ( S32 index = 0; index < cellCount; ++index )
+        costs[index] = SCENE_NAVIGATION_UNITTEST_UNREACHABLE;
+
+    Vector<bool> closed;
+    closed.setSize( cellCount );
+    for ( S32 index = 0; index < cellCount; ++index )
+        closed[index] = false;
+
+    costs[goalCell] = 0.0f;
+
+    for ( ;; )
+    {
+        // Take the cheapest open cell.
+        S32 cell = -1;
+        for ( S32 index = 0; index < cellCount; ++index )
+        {
+            if ( !closed[index] && costs[index] < SCENE_NAVIGATION_UNITTEST_UNREACHABLE && (cell == -1 || costs[index] < costs[cell]) )
+                cell = index;
+        }
+
+        if ( cell == -1 )
+            return;
+
+        closed[cell] = true;
+
+        const S32 x = cell % grid.mWidth;
+        const S32 y = cell / grid.mWidth;
+
+        for ( S32 n = 0; n < 8; ++n )
+        {
+            const S32 neighborX = x + sTestNeighborX[n];
+            const S32 neighborY = y + sTestNeighborY[n];
+
+            if ( !grid.getWalkable( neighborX, neighborY ) )
+                continue;
+
+            if ( (n & 1) != 0 && (!grid.getWalkable( neighborX, y ) || !grid.getWalkable( x, neighborY )) )
+                continue;
+
+            const S32 neighborCell = grid.getCellIndex( neighborX, neighborY );
+            const F32 cost = costs[cell] + ((n & 1) != 0 ? M_SQRT2_F : 1.0f);
+            if ( cost < costs[neighborCell] )
+                costs[neighborCell] = cost;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+static F32 getPathLength( const Vector<Vector2>& path )
+{
+    F32 length = 0.0f;
+    for ( S32 index = 1; index < path.size(); ++index )
+        length += (path[index] - path[index-1]).Length();
+
+    return length;
+}
+
+//-----------------------------------------------------------------------------
+
+// Checks every path segment only crosses walkable cells.
+static bool getPathWalkable( const SceneNavigation::Grid& grid, const Vector<Vector2>& path )
+{
+    for ( S32 index = 1; index < path.size(); ++index )
+    {
+        const Vector2 from = path[index-1];
+        const Vector2 to = path[index];
+        const S32 samples = (S32)((to - from).Length() * 64.0f) + 1;
+
+        for ( S32 sample = 0; sample <= samples; ++sample )
+        {
+            const Vector2 position = from + (to - from) * ((F32)sample / (F32)samples);
+
+            S32 x, y;
+            if ( !grid.getCell( position, x, y ) || !grid.getWalkable( x, y ) )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SceneNavigationTests, SearchPathMazeTest )
+{
+    const char* rows[] =
+    {
+        "..........",
+        ".########.",
+        ".#......#.",
+        ".#.####.#.",
+        ".#.#..#.#.",
+        ".#.#.##.#.",
+        ".#.#....#.",
+        ".#.######.",
+        ".#........",
+        ".#########",
+    };
+
+    SceneNavigation::Grid grid;
+    buildGrid( grid, rows, 10, 10 );
+
+    SceneNavigation::SearchScratch scratch;
+    Vector<Vector2> path;
+
+    // Search from the bottom left into the middle of the maze.
+    const Vector2 start = grid.getCellCenter( 0, 0 );
+    const Vector2 goal = grid.getCellCenter( 4, 5 );
+    ASSERT_TRUE( SceneNavigation::searchPath( grid, start, goal, scratch, path ) ) << "Path not found.";
+
+    // Check the end points.
+    ASSERT_GE( path.size(), 2 );
+    ASSERT_EQ( start, path.first() ) << "Path does not begin at the start.";
+    ASSERT_EQ( goal, path.last() ) << "Path does not end at the goal.";
+
+    // Check the path is walkable and no longer than the grid route.
+    Vector<F32> costs;
+    buildReferenceCosts( grid, grid.getCellIndex( 4, 5 ), costs );
+    ASSERT_TRUE( getPathWalkable( grid, path ) ) << "Path crosses a blocked cell.";
+    ASSERT_LE( getPathLength( path ), costs[ grid.getCellIndex( 0, 0 ) ] + 0.001f ) << "Path is longer than the shortest grid route.";
+
+    // A walled off goal cannot be reached.
+    const Vector2 blockedGoal = grid.getCellCenter( 1, 5 );
+    ASSERT_FALSE( SceneNavigation::searchPath( grid, start, blockedGoal, scratch, path ) ) << "Path found to a blocked cell.";
+    ASSERT_EQ( 0, path.size() );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SceneNavigationTests, SearchPathNoCornerCuttingTest )
+{
+    const char* rows[] =
+    {
+        "...",
+        ".#.",
+        "#..",
+    };
+
+    SceneNavigation::Grid grid;
+    buildGrid( grid, rows, 3, 3 );
+
+    SceneNavigation::SearchScratch scratch;
+    Vector<Vector2> path;
+
+    // The diagonal from (1,0) to (0,1) squeezes between two blocked cells so must go around.
+    ASSERT_TRUE( SceneNavigation::searchPath( grid, grid.getCellCenter( 1, 0 ), grid.getCellCenter( 0, 2 ), scratch, path ) ) << "Path not found.";
+    ASSERT_TRUE( getPathWalkable( grid, path ) ) << "Path cuts a corner.";
+    ASSERT_GT( path.size(), 2 ) << "Path went straight through a blocked corner.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SceneNavigationTests, SearchPathRandomGridTest )
+{
+    U32 seed = 12345;
+    SceneNavigation::SearchScratch scratch;
+    Vector<Vector2> path;
+    Vector<F32> costs;
+
+    // Compare the jump point search against Dijkstra on random grids.
+    for ( U32 gridIndex = 0; gridIndex < 20; ++gridIndex )
+    {
+        SceneNavigation::Grid grid;
+        buildRandomGrid( grid, 24 + gridIndex, 20 + gridIndex / 2, 10 + gridIndex * 2, seed );
+
+        const S32 goalCell = getRandomWalkableCell( grid, seed );
+        const Vector2 goal = grid.getCellCenter( goalCell % grid.mWidth, goalCell / grid.mWidth );
+        buildReferenceCosts( grid, goalCell, costs );
+
+        for ( U32 query = 0; query < 10; ++query )
+        {
+            const S32 startCell = getRandomWalkableCell( grid, seed );
+            const Vector2 start = grid.getCellCenter( startCell % grid.mWidth, startCell / grid.mWidth );
+            const bool reachable = costs[startCell] < SCENE_NAVIGATION_UNITTEST_UNREACHABLE;
+
+            ASSERT_EQ( reachable, SceneNavigation::searchPath( grid, start, goal, scratch, path ) ) << "Reachability differs from Dijkstra on grid " << gridIndex << ".";
+
+            if ( !reachable )
+                continue;
+
+            ASSERT_TRUE( getPathWalkable( grid, path ) ) << "Path crosses a blocked cell on grid " << gridIndex << ".";
+            ASSERT_LE( getPathLength( path ), costs[startCell] + 0.001f ) << "Path is longer than the shortest grid route on grid " << gridIndex << ".";
+            ASSERT_GE( getPathLength( path ), (goal - start).Length() - 0.001f );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SceneNavigationTests, BuildFlowFieldTest )
+{
+    U32 seed = 54321;
+    SceneNavigation::SearchScratch scratch;
+    Vector<U8> flowCodes;
+    Vector<F32> costs;
+
+    for ( U32 gridIndex = 0; gridIndex < 10; ++gridIndex )
+    {
+        SceneNavigation::Grid grid;
+        buildRandomGrid( grid, 20 + gridIndex, 16 + gridIndex, 15 + gridIndex * 2, seed );
+
+        const S32 goalCell = getRandomWalkableCell( grid, seed );
+        const Vector2 goal = grid.getCellCenter( goalCell % grid.mWidth, goalCell / grid.mWidth );
+        buildReferenceCosts( grid, goalCell, costs );
+
+        SceneNavigation::buildFlowField( grid, goal, scratch, flowCodes );
+        ASSERT_EQ( grid.mWidth * grid.mHeight, flowCodes.size() );
+        ASSERT_EQ( (U8)SceneNavigation::FLOW_GOAL, flowCodes[goalCell] ) << "Goal cell is not marked.";
+
+        for ( S32 cell = 0; cell < flowCodes.size(); ++cell )
+        {
+            // Blocked and unreachable cells have no direction.
+            if ( costs[cell] >= SCENE_NAVIGATION_UNITTEST_UNREACHABLE )
+            {
+                ASSERT_EQ( (U8)SceneNavigation::FLOW_UNREACHABLE, flowCodes[cell] ) << "Unreachable cell has a direction on grid " << gridIndex << ".";
+                continue;
+            }
+
+            if ( cell == goalCell )
+                continue;
+
+            // Each step must be walkable, must not cut a corner and must descend the cheapest route.
+            const U8 flowCode = flowCodes[cell];
+            ASSERT_LT( flowCode, (U8)SceneNavigation::FLOW_GOAL ) << "Reachable cell has no direction on grid " << gridIndex << ".";
+
+            const S32 x = cell % grid.mWidth;
+            const S32 y = cell / grid.mWidth;
+            const S32 nextX = x + sTestNeighborX[flowCode];
+            const S32 nextY = y + sTestNeighborY[flowCode];
+            ASSERT_TRUE( grid.getWalkable( nextX, nextY ) ) << "Flow points into a blocked cell.";
+
+            if ( (flowCode & 1) != 0 )
+            {
+                ASSERT_TRUE( grid.getWalkable( nextX, y ) && grid.getWalkable( x, nextY ) ) << "Flow cuts a corner.";
+            }
+
+            const F32 stepCost = (flowCode & 1) != 0 ? M_SQRT2_F : 1.0f;
+            ASSERT_NEAR( costs[cell], costs[ grid.getCellIndex( nextX, nextY ) ] + stepCost, 0.001f ) << "Flow does not follow the cheapest route on grid " << gridIndex << ".";
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SceneNavigationTests, SearchPathThroughputTest )
+{
+    U32 seed = 777;
+    SceneNavigation::Grid grid;
+    buildRandomGrid( grid, 256, 256, 25, seed );
+
+    SceneNavigation::SearchScratch scratch;
+    Vector<Vector2> path;
+
+    const U32 queryCount = 500;
+    U32 foundCount = 0;
+
+    // Time path queries between random cells on a large grid.
+    const U32 startTime = Platform::getRealMilliseconds();
+    for ( U32 query = 0; query < queryCount; ++query )
+    {
+        const S32 startCell = getRandomWalkableCell( grid, seed );
+        const S32 goalCell = getRandomWalkableCell( grid, seed );
+        const Vector2 start = grid.getCellCenter( startCell % grid.mWidth, startCell / grid.mWidth );
+        const Vector2 goal = grid.getCellCenter( goalCell % grid.mWidth, goalCell / grid.mWidth );
+
+        if ( SceneNavigation::searchPath( grid, start, goal, scratch, path ) )
+            foundCount++;
+    }
+    const U32 elapsedTime = getMax( Platform::getRealMilliseconds() - startTime, (U32)1 );
+
+    // Report the throughput.
+    RecordProperty( "PathQueriesPerSecond", (int)((queryCount * 1000) / elapsedTime) );
+    Con::printf( "SceneNavigationTests - %d path queries (%d found) in %dms, %d queries per second.", queryCount, foundCount, elapsedTime, (queryCount * 1000) / elapsedTime );
+
+    ASSERT_GT( foundCount, 0U );
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,205 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _STRINGUNIT_H_
+#include "string/stringUnit.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define STRINGUNIT_UNITTEST_BUFFERSIZE      1024
+
+static const char* sTestSets[] = { " \t\n", " ", "\t\n", ",;" };
+
+//-----------------------------------------------------------------------------
+
+// Fills a string of at least 64 characters, long enough to be cached, with
+// runs of delimiters so that it has empty units and leading or trailing delimiters.
+static void buildTestString( char* pBuffer, const U32 length, const char* set, U32& seed )
+{
+    const U32 setLength = dStrlen( set );
+
+    for ( U32 index = 0; index < length; ++index )
+    {
+        seed = seed * 1664525 + 1013904223;
+        const U32 pick = (seed >> 16) % 8;
+        pBuffer[index] = pick < 3 ? set[ (seed >> 8) % setLength ] : (char)('a' + pick);
+    }
+
+    pBuffer[length] = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+// Compares every unit operation with and without the tokenisation cache.
+static void compareUnitOperations( const char* string, const char* set )
+{
+    char cached[STRINGUNIT_UNITTEST_BUFFERSIZE];
+    char uncached[STRINGUNIT_UNITTEST_BUFFERSIZE];
+
+    StringUnit::setUnitCacheEnabled( false );
+    const U32 unitCount = StringUnit::getUnitCount( string, set );
+    StringUnit::setUnitCacheEnabled( true );
+    ASSERT_EQ( unitCount, StringUnit::getUnitCount( string, set ) ) << "Unit count differs for '" << string << "'.";
+
+    // Walk past the last unit to cover out of range indices.
+    for ( U32 index = 0; index < unitCount + 3; ++index )
+    {
+        StringUnit::setUnitCacheEnabled( false );
+        dStrcpy( uncached, StringUnit::getUnit( string, index, set ) );
+        StringUnit::setUnitCacheEnabled( true );
+        dStrcpy( cached, StringUnit::getUnit( string, index, set ) );
+        ASSERT_STREQ( uncached, cached ) << "getUnit differs at " << index << " for '" << string << "'.";
+
+        for ( S32 endIndex = (S32)index - 1; endIndex <= (S32)index + 2; ++endIndex )
+        {
+            StringUnit::setUnitCacheEnabled( false );
+            dStrcpy( uncached, StringUnit::getUnits( string, index, endIndex, set ) );
+            StringUnit::setUnitCacheEnabled( true );
+            dStrcpy( cached, StringUnit::getUnits( string, index, endIndex, set ) );
+            ASSERT_STREQ( uncached, cached ) << "getUnits differs at " << index << "-" << endIndex << " for '" << string << "'.";
+        }
+
+        StringUnit::setUnitCacheEnabled( false );
+        dStrcpy( uncached, StringUnit::setUnit( string, index, "GG", set ) );
+        StringUnit::setUnitCacheEnabled( true );
+        dStrcpy( cached, StringUnit::setUnit( string, index, "GG", set ) );
+        ASSERT_STREQ( uncached, cached ) << "setUnit differs at " << index << " for '" << string << "'.";
+
+        StringUnit::setUnitCacheEnabled( false );
+        dStrcpy( uncached, StringUnit::removeUnit( string, index, set ) );
+        StringUnit::setUnitCacheEnabled( true );
+        dStrcpy( cached, StringUnit::removeUnit( string, index, set ) );
+        ASSERT_STREQ( uncached, cached ) << "removeUnit differs at " << index << " for '" << string << "'.";
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( StringUnitTests, CachedUnitsTest )
+{
+    const char* source =
+        "alpha beta  gamma\tdelta\n\nepsilon zeta eta theta iota kappa lambda mu nu xi omicron pi ";
+
+    // Check against known results.
+    ASSERT_GE( dStrlen( source ), 64 );
+    ASSERT_EQ( 18, (S32)StringUnit::getUnitCount( source, " \t\n" ) );
+    ASSERT_STREQ( "beta", StringUnit::getUnit( source, 1, " \t\n" ) );
+    ASSERT_STREQ( "", StringUnit::getUnit( source, 2, " \t\n" ) ) << "Empty unit not returned.";
+    ASSERT_STREQ( "gamma", StringUnit::getUnit( source, 3, " \t\n" ) );
+    ASSERT_STREQ( "", StringUnit::getUnit( source, 5, " \t\n" ) ) << "Empty unit not returned.";
+    ASSERT_STREQ( "epsilon", StringUnit::getUnit( source, 6, " \t\n" ) );
+    ASSERT_STREQ( "pi", StringUnit::getUnit( source, 17, " \t\n" ) );
+    ASSERT_STREQ( "", StringUnit::getUnit( source, 18, " \t\n" ) ) << "Trailing unit not empty.";
+    ASSERT_STREQ( "", StringUnit::getUnit( source, 100, " \t\n" ) ) << "Out of range unit not empty.";
+    ASSERT_STREQ( "gamma\tdelta", StringUnit::getUnits( source, 3, 4, " \t\n" ) );
+
+    compareUnitOperations( source, " \t\n" );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( StringUnitTests, CachedUnitsRandomTest )
+{
+    char source[STRINGUNIT_UNITTEST_BUFFERSIZE];
+    U32 seed = 2013;
+
+    for ( U32 iteration = 0; iteration < 200; ++iteration )
+    {
+        const char* set = sTestSets[iteration % (sizeof(sTestSets) / sizeof(sTestSets[0]))];
+        buildTestString( source, 64 + iteration % 128, set, seed );
+
+        compareUnitOperations( source, set );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( StringUnitTests, CachedUnitsChangedSuffixTest )
+{
+    char source[STRINGUNIT_UNITTEST_BUFFERSIZE];
+    char cached[STRINGUNIT_UNITTEST_BUFFERSIZE];
+    char uncached[STRINGUNIT_UNITTEST_BUFFERSIZE];
+    U32 seed = 42;
+
+    for ( U32 iteration = 0; iteration < 200; ++iteration )
+    {
+        const char* set = sTestSets[iteration % (sizeof(sTestSets) / sizeof(sTestSets[0]))];
+        const U32 length = 64 + iteration % 96;
+        buildTestString( source, length, set, seed );
+
+        // Cache the string by looking up an early unit.
+        StringUnit::setUnitCacheEnabled( true );
+        StringUnit::getUnit( source, 1, set );
+
+        // Change the string after the cached prefix, sometimes to a delimiter, sometimes shortening it.
+        seed = seed * 1664525 + 1013904223;
+        const U32 position = length / 2 + (seed >> 16) % (length / 2);
+        if ( iteration % 3 == 0 )
+            source[position] = 0;
+        else
+            source[position] = iteration % 3 == 1 ? set[0] : 'z';
+
+        // Lookups covered by the unchanged prefix and lookups past it must both match the scanning code.
+        StringUnit::setUnitCacheEnabled( false );
+        dStrcpy( uncached, StringUnit::getUnit( source, 1, set ) );
+        StringUnit::setUnitCacheEnabled( true );
+        dStrcpy( cached, StringUnit::getUnit( source, 1, set ) );
+        ASSERT_STREQ( uncached, cached ) << "getUnit differs after a suffix change for '" << source << "'.";
+
+        compareUnitOperations( source, set );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( StringUnitTests, CachedUnitsPaddingTest )
+{
+    const char* source = "one two three four five six seven eight nine ten eleven twelve thirteen";
+    char cached[STRINGUNIT_UNITTEST_BUFFERSIZE];
+
+    // Setting a unit past the end pads with the first delimiter.
+    dStrcpy( cached, StringUnit::setUnit( source, 15, "x", " \t\n" ) );
+    StringUnit::setUnitCacheEnabled( false );
+    ASSERT_STREQ( StringUnit::setUnit( source, 15, "x", " \t\n" ), cached ) << "setUnit padding differs.";
+    StringUnit::setUnitCacheEnabled( true );
+
+    const U32 length = dStrlen( source );
+    ASSERT_EQ( length + 3 + 1, dStrlen( cached ) );
+    ASSERT_STREQ( "   x", cached + length ) << "setUnit padding incorrect.";
+
+    // Removing a unit past the end returns the string unchanged.
+    ASSERT_STREQ( source, StringUnit::removeUnit( source, 20, " \t\n" ) );
+}
+
+#endif // TORQUE_SHIPPING